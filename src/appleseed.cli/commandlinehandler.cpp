@@ -108,6 +108,13 @@ CommandLineHandler::CommandLineHandler()
             .set_syntax("n")
             .set_exact_value_count(1));
 
+    parser().add_option_handler(
+        &m_frames
+            .add_name("--frames")
+            .set_description("render a range of animation frames; frame n covers the time interval [n, n+1] of the transform sequences")
+            .set_syntax("first last")
+            .set_exact_value_count(2));
+
     parser().add_option_handler(
         &m_override_shading
             .add_name("--override-shading")
@@ -129,6 +136,23 @@ CommandLineHandler::CommandLineHandler()
             .set_syntax("filename")
             .set_exact_value_count(1));
 
+    parser().add_option_handler(
+        &m_stream_output
+            .add_name("--stream-output")
+            .set_description("write tiles to the output file as they are rendered; the output file must be an OpenEXR file"));
+
+    parser().add_option_handler(
+        &m_checkpoint
+            .add_name("--checkpoint")
+            .set_description("periodically save the progress of the render to a checkpoint file")
+            .set_syntax("filename")
+            .set_exact_value_count(1));
+
+    parser().add_option_handler(
+        &m_resume
+            .add_name("--resume")
+            .set_description("resume the render from the checkpoint file specified with --checkpoint"));
+
 #if defined __APPLE__ || defined _WIN32
     parser().add_option_handler(
         &m_display_output
@@ -158,6 +182,13 @@ CommandLineHandler::CommandLineHandler()
             .add_name("--disable-autosave")
             .set_description("disable automatic saving of rendered images"));
 
+    parser().add_option_handler(
+        &m_server
+            .add_name("--server")
+            .set_description("keep running and render the requests received on a local socket (a port number on Windows); the optional project is loaded ahead of the first request")
+            .set_syntax("socket")
+            .set_exact_value_count(1));
+
     parser().add_option_handler(
         &m_run_unit_tests
             .add_name("--run-unit-tests")
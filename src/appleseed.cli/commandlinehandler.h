@@ -66,11 +66,15 @@ class CommandLineHandler
     foundation::ValueOptionHandler<int>             m_window;
     foundation::ValueOptionHandler<int>             m_samples;
     foundation::ValueOptionHandler<int>             m_passes;
+    foundation::ValueOptionHandler<int>             m_frames;
     foundation::ValueOptionHandler<std::string>     m_override_shading;
     foundation::ValueOptionHandler<std::string>     m_select_object_instances;
 
     // Output options.
     foundation::ValueOptionHandler<std::string>     m_output;
+    foundation::FlagOptionHandler                   m_stream_output;
+    foundation::ValueOptionHandler<std::string>     m_checkpoint;
+    foundation::FlagOptionHandler                   m_resume;
 #if defined __APPLE__ || defined _WIN32
     foundation::FlagOptionHandler                   m_display_output;
 #endif
@@ -79,6 +83,9 @@ class CommandLineHandler
     foundation::ValueOptionHandler<int>             m_send_to_hrmanpipe;
     foundation::FlagOptionHandler                   m_disable_autosave;
 
+    // Server options.
+    foundation::ValueOptionHandler<std::string>     m_server;
+
     // Developer-oriented options.
     foundation::ValueOptionHandler<std::string>     m_run_unit_tests;
     foundation::ValueOptionHandler<std::string>     m_run_unit_benchmarks;
@@ -31,6 +31,7 @@
 #include "commandlinehandler.h"
 #include "houdinitilecallbacks.h"
 #include "progresstilecallback.h"
+#include "renderserver.h"
 #include "stdouttilecallback.h"
 
 // appleseed.shared headers.
@@ -38,6 +39,7 @@
 #include "application/superlogger.h"
 
 // appleseed.renderer headers.
+#include "renderer/api/camera.h"
 #include "renderer/api/color.h"
 #include "renderer/api/frame.h"
 #include "renderer/api/log.h"
@@ -68,10 +70,12 @@
 // Boost headers.
 #include "boost/filesystem/operations.hpp"
 #include "boost/filesystem/path.hpp"
+#include "boost/system/error_code.hpp"
 
 // Standard headers.
 #include <cstddef>
 #include <cstdlib>
+#include <ctime>
 #include <memory>
 #include <string>
 
@@ -316,6 +320,23 @@ namespace
         }
     }
 
+    void apply_checkpoint_command_line_options(ParamArray& params)
+    {
+        if (g_cl.m_checkpoint.is_set())
+        {
+            params.insert_path("generic_frame_renderer.checkpoint_path", g_cl.m_checkpoint.value());
+            params.insert_path("progressive_frame_renderer.checkpoint_path", g_cl.m_checkpoint.value());
+
+            if (g_cl.m_resume.is_set())
+            {
+                params.insert_path("generic_frame_renderer.checkpoint_resume", true);
+                params.insert_path("progressive_frame_renderer.checkpoint_resume", true);
+            }
+        }
+        else if (g_cl.m_resume.is_set())
+            LOG_WARNING(g_logger, "--resume has no effect without --checkpoint.");
+    }
+
     void apply_select_object_instances_command_line_option(Assembly& assembly, const RegExFilter& filter)
     {
         static const char* ColorName = "opaque_black-75AB13E8-D5A2-4D27-A64E-4FC41B55A272";
@@ -417,6 +438,9 @@ namespace
         // Apply --passes option.
         apply_passes_command_line_option(params);
 
+        // Apply --checkpoint and --resume options.
+        apply_checkpoint_command_line_options(params);
+
         // Apply --override-shading option.
         if (g_cl.m_override_shading.is_set())
         {
@@ -513,21 +537,51 @@ namespace
         return value == "progressive";
     }
 
-    bool render(const string& project_filename)
+    bool can_stream_output(const ParamArray& params, const string& output_path)
     {
-        // Load the project.
-        auto_release_ptr<Project> project = load_project(project_filename);
-        if (project.get() == 0)
+        if (output_path.empty())
+        {
+            LOG_WARNING(g_logger, "cannot stream output when no output is specified.");
             return false;
+        }
 
-        // Retrieve the rendering parameters.
-        ParamArray params;
-        if (!configure_project(project.ref(), params))
+        if (lower_case(bf::path(output_path).extension().string()) != ".exr")
+        {
+            LOG_WARNING(g_logger, "cannot stream output to a file that is not an OpenEXR file.");
             return false;
+        }
 
+        // Tiles are only final once rendered if there is a single tile-based pass.
+        if (is_progressive_render(params) ||
+            params.get_path_optional<size_t>("generic_frame_renderer.passes", 1) > 1)
+        {
+            LOG_WARNING(g_logger, "cannot stream output when rendering progressively or with multiple passes.");
+            return false;
+        }
+
+        return true;
+    }
+
+    // Render a loaded and configured project and write the frame to disk.
+    // If 'output_path' is empty, the output filenames of the frame and AOVs are used.
+    bool render_frame(
+        Project&            project,
+        const ParamArray&   params,
+        const string&       project_filename,
+        const string&       output_path)
+    {
         // Create the tile callback factory.
         auto_ptr<ITileCallbackFactory> tile_callback_factory;
-        if (g_cl.m_send_to_mplay.is_set())
+        EXRTileCallbackFactory* exr_tile_callback_factory = nullptr;
+        if (g_cl.m_stream_output.is_set() && can_stream_output(params, output_path))
+        {
+            exr_tile_callback_factory =
+                new EXRTileCallbackFactory(
+                    *project.get_frame(),
+                    output_path.c_str());
+            tile_callback_factory.reset(exr_tile_callback_factory);
+        }
+        else if (g_cl.m_send_to_mplay.is_set())
         {
             tile_callback_factory.reset(
                 new MPlayTileCallbackFactory(
@@ -547,7 +601,7 @@ namespace
         {
             tile_callback_factory.reset(new StdOutTileCallbackFactory());
         }
-        else if (project->get_display() == nullptr)
+        else if (project.get_display() == nullptr)
         {
             // Create a default tile callback if needed.
             if (params.get_optional<string>("frame_renderer", "") != "progressive")
@@ -560,7 +614,7 @@ namespace
         // Create the master renderer.
         DefaultRendererController renderer_controller;
         MasterRenderer renderer(
-            project.ref(),
+            project,
             params,
             &renderer_controller,
             tile_callback_factory.get());
@@ -602,21 +656,26 @@ namespace
 
             // Archive the frame to disk.
             LOG_INFO(g_logger, "archiving frame to disk...");
-            project->get_frame()->archive(
+            project.get_frame()->archive(
                 autosave_path.string().c_str(),
                 &archive_path);
         }
 
         // Write the frame to disk.
-        if (g_cl.m_output.is_set())
+        if (exr_tile_callback_factory)
+        {
+            LOG_INFO(g_logger, "writing remaining tiles to disk...");
+            exr_tile_callback_factory->close();
+        }
+        else if (!output_path.empty())
         {
             LOG_INFO(g_logger, "writing frame to disk...");
-            project->get_frame()->write_main_image(g_cl.m_output.value().c_str());
-            project->get_frame()->write_aov_images(g_cl.m_output.value().c_str());
+            project.get_frame()->write_main_image(output_path.c_str());
+            project.get_frame()->write_aov_images(output_path.c_str());
         }
         else
         {
-            const Frame* frame = project->get_frame();
+            const Frame* frame = project.get_frame();
 
             // Write the main image.
             const string output_filename =
@@ -648,8 +707,8 @@ namespace
         // Display the output image.
         if (g_cl.m_display_output.is_set())
         {
-            if (g_cl.m_output.is_set())
-                display_frame(g_cl.m_output.value().c_str());
+            if (!output_path.empty())
+                display_frame(output_path);
             else if (archive_path)
                 display_frame(archive_path);
             else LOG_WARNING(g_logger, "cannot display output when no output is specified and autosave is disabled.");
@@ -663,6 +722,245 @@ namespace
         return true;
     }
 
+    bool render(const string& project_filename)
+    {
+        // Load the project.
+        auto_release_ptr<Project> project = load_project(project_filename);
+        if (project.get() == 0)
+            return false;
+
+        // Retrieve the rendering parameters.
+        ParamArray params;
+        if (!configure_project(project.ref(), params))
+            return false;
+
+        return
+            render_frame(
+                project.ref(),
+                params,
+                project_filename,
+                g_cl.m_output.is_set() ? g_cl.m_output.value() : string());
+    }
+
+    // Return the output path of a frame of an animation: consecutive '#' characters are replaced
+    // by the frame number, or, if there are none, the frame number is inserted before the extension.
+    string make_frame_output_path(const string& output_path, const size_t frame)
+    {
+        if (output_path.find_first_of('#') != string::npos)
+            return get_numbered_string(output_path, frame);
+
+        const bf::path path(output_path);
+        const bf::path pattern =
+            path.parent_path() / (path.stem().string() + ".####" + path.extension().string());
+
+        return get_numbered_string(pattern.string(), frame);
+    }
+
+    bool render_animation(const string& project_filename)
+    {
+        const int first_frame = g_cl.m_frames.values()[0];
+        const int last_frame = g_cl.m_frames.values()[1];
+
+        if (first_frame < 0 || last_frame < first_frame)
+        {
+            LOG_ERROR(g_logger, "invalid frame range %d to %d.", first_frame, last_frame);
+            return false;
+        }
+
+        // Load the project.
+        auto_release_ptr<Project> project = load_project(project_filename);
+        if (project.get() == 0)
+            return false;
+
+        // Retrieve the rendering parameters.
+        ParamArray params;
+        if (!configure_project(project.ref(), params))
+            return false;
+
+        // Retrieve the output path pattern.
+        const string output_path =
+            g_cl.m_output.is_set()
+                ? g_cl.m_output.value()
+                : project->get_frame()->get_parameters().get_optional<string>("output_filename");
+        if (output_path.empty())
+        {
+            LOG_ERROR(g_logger, "cannot render an animation when no output is specified.");
+            return false;
+        }
+
+        Camera* camera = project->get_uncached_active_camera();
+        if (camera == nullptr)
+        {
+            LOG_ERROR(g_logger, "cannot render an animation without an active camera.");
+            return false;
+        }
+
+        const float shutter_open_time = camera->get_parameters().get_optional<float>("shutter_open_time", 0.0f);
+        const float shutter_close_time = camera->get_parameters().get_optional<float>("shutter_close_time", 1.0f);
+
+        Stopwatch<DefaultWallclockTimer> stopwatch;
+        stopwatch.start();
+
+        for (int frame = first_frame; frame <= last_frame; ++frame)
+        {
+            LOG_INFO(g_logger, "rendering animation frame %d (frames %d to %d)...", frame, first_frame, last_frame);
+
+            // Frame n of the animation covers the time interval [n, n + 1] of the transform
+            // sequences. Only the shutter of the camera moves from one frame to the next:
+            // the project stays loaded and the scene is only updated where it changed.
+            camera->get_parameters().insert("shutter_open_time", frame + shutter_open_time);
+            camera->get_parameters().insert("shutter_close_time", frame + shutter_close_time);
+            camera->bump_version_id();
+
+            // Each frame has its own checkpoint file.
+            ParamArray frame_params = params;
+            if (g_cl.m_checkpoint.is_set())
+            {
+                const string checkpoint_path =
+                    make_frame_output_path(g_cl.m_checkpoint.value(), static_cast<size_t>(frame));
+                frame_params.insert_path("generic_frame_renderer.checkpoint_path", checkpoint_path);
+                frame_params.insert_path("progressive_frame_renderer.checkpoint_path", checkpoint_path);
+            }
+
+            if (!render_frame(
+                    project.ref(),
+                    frame_params,
+                    project_filename,
+                    make_frame_output_path(output_path, static_cast<size_t>(frame))))
+                return false;
+        }
+
+        stopwatch.measure();
+
+        LOG_INFO(
+            g_logger,
+            "animation rendering finished in %s.",
+            pretty_time(stopwatch.get_seconds(), 3).c_str());
+
+        return true;
+    }
+
+    //
+    // Render request handler of the render server.
+    //
+    // The project of the last request is kept in memory, along with its trace context:
+    // subsequent requests for the same, unmodified project only update the parts of the
+    // scene that changed instead of loading the project and building the scene again.
+    //
+
+    class RenderRequestHandler
+      : public IRenderRequestHandler
+    {
+      public:
+        RenderRequestHandler()
+          : m_project_timestamp(0)
+          , m_shutter_open_time(0.0f)
+          , m_shutter_close_time(1.0f)
+        {
+        }
+
+        virtual bool handle(const RenderRequest& request) override
+        {
+            const string project_filename =
+                request.m_project_path.empty() ? m_project_filename : request.m_project_path;
+
+            if (project_filename.empty())
+            {
+                LOG_ERROR(g_logger, "render server: no project specified.");
+                return false;
+            }
+
+            if (!load(project_filename))
+                return false;
+
+            // Move the shutter of the camera to the requested frame, as render_animation() does.
+            Camera* camera = m_project->get_uncached_active_camera();
+            if (camera)
+            {
+                const float frame = static_cast<float>(request.m_frame);
+                camera->get_parameters().insert("shutter_open_time", frame + m_shutter_open_time);
+                camera->get_parameters().insert("shutter_close_time", frame + m_shutter_close_time);
+                camera->bump_version_id();
+            }
+
+            // Apply the parameter overrides of the request.
+            ParamArray params = m_params;
+            params.merge(request.m_params);
+
+            // Substitute the frame number in the output path.
+            string output_path = request.m_output_path;
+            if (output_path.empty() && g_cl.m_output.is_set())
+                output_path = g_cl.m_output.value();
+            if (output_path.find_first_of('#') != string::npos)
+                output_path = get_numbered_string(output_path, request.m_frame);
+
+            return render_frame(m_project.ref(), params, m_project_filename, output_path);
+        }
+
+        // Load and configure a project, unless it is already resident and its file didn't change.
+        bool load(const string& project_filename)
+        {
+            boost::system::error_code error;
+            const time_t timestamp = bf::last_write_time(project_filename, error);
+
+            // Keep the resident project if the project file didn't change.
+            if (m_project.get() &&
+                project_filename == m_project_filename &&
+                !error &&
+                timestamp == m_project_timestamp)
+                return true;
+
+            m_project.reset();
+            m_project_filename.clear();
+
+            auto_release_ptr<Project> project = load_project(project_filename);
+            if (project.get() == 0)
+                return false;
+
+            ParamArray params;
+            if (!configure_project(project.ref(), params))
+                return false;
+
+            // Remember the shutter interval of the camera, requests offset it by their frame number.
+            const Camera* camera = project->get_uncached_active_camera();
+            m_shutter_open_time =
+                camera ? camera->get_parameters().get_optional<float>("shutter_open_time", 0.0f) : 0.0f;
+            m_shutter_close_time =
+                camera ? camera->get_parameters().get_optional<float>("shutter_close_time", 1.0f) : 1.0f;
+
+            m_project = project;
+            m_project_filename = project_filename;
+            m_project_timestamp = error ? 0 : timestamp;
+            m_params = params;
+
+            return true;
+        }
+
+      private:
+        auto_release_ptr<Project>   m_project;
+        string                      m_project_filename;
+        time_t                      m_project_timestamp;
+        ParamArray                  m_params;
+        float                       m_shutter_open_time;
+        float                       m_shutter_close_time;
+    };
+
+    bool run_render_server()
+    {
+        RenderRequestHandler handler;
+
+        // Load the project specified on the command line ahead of the first request.
+        if (!g_cl.m_filename.values().empty())
+        {
+            LOG_INFO(g_logger, "render server: preloading project...");
+            if (!handler.load(g_cl.m_filename.value()))
+                return false;
+        }
+
+        RenderServer server(g_cl.m_server.value(), g_logger);
+        return server.run(handler);
+    }
+
     bool benchmark_render(const string& project_filename)
     {
         // Configure our logger.
@@ -774,13 +1072,17 @@ int main(int argc, const char* argv[])
     if (g_cl.m_run_unit_benchmarks.is_set())
         run_unit_benchmarks();
 
-    // Render the specified project.
-    if (!g_cl.m_filename.values().empty())
+    // Run the render server, or render the specified project.
+    if (g_cl.m_server.is_set())
+        success = success && run_render_server();
+    else if (!g_cl.m_filename.values().empty())
     {
         const string project_filename = g_cl.m_filename.value();
 
         if (g_cl.m_benchmark_mode.is_set())
             success = success && benchmark_render(project_filename);
+        else if (g_cl.m_frames.is_set())
+            success = success && render_animation(project_filename);
         else success = success && render(project_filename);
     }
 
@@ -0,0 +1,280 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "renderserver.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/log.h"
+#include "foundation/utility/string.h"
+
+// Boost headers.
+#include "boost/asio.hpp"
+#include "boost/filesystem.hpp"
+#include "boost/system/error_code.hpp"
+
+// Platform headers.
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+#include <sys/stat.h>
+#endif
+
+// Standard headers.
+#include <istream>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+namespace asio = boost::asio;
+namespace bf = boost::filesystem;
+
+namespace appleseed {
+namespace cli {
+
+//
+// RenderRequest class implementation.
+//
+
+RenderRequest::RenderRequest()
+  : m_frame(0)
+{
+}
+
+
+//
+// RenderServer class implementation.
+//
+
+namespace
+{
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+    typedef asio::local::stream_protocol Protocol;
+#else
+    typedef asio::ip::tcp Protocol;
+#endif
+
+    // Serve the requests of a single client until it disconnects or asks the server
+    // to shut down. Return true if the server must shut down.
+    bool serve_client(
+        Protocol::socket&       socket,
+        IRenderRequestHandler&  handler,
+        Logger&                 logger)
+    {
+        asio::streambuf input;
+        istream input_stream(&input);
+
+        RenderRequest request;
+
+        while (true)
+        {
+            boost::system::error_code error;
+            asio::read_until(socket, input, '\n', error);
+
+            // Stop serving this client once it has disconnected.
+            if (error && input.size() == 0)
+                return false;
+
+            string line;
+            getline(input_stream, line);
+            line = trim_both(line);
+
+            if (line.empty())
+                continue;
+
+            const string::size_type space_pos = line.find_first_of(' ');
+            const string command = line.substr(0, space_pos);
+            const string argument =
+                space_pos == string::npos ? string() : trim_both(line.substr(space_pos + 1));
+
+            string reply;
+
+            if (command == "project")
+                request.m_project_path = argument;
+            else if (command == "output")
+                request.m_output_path = argument;
+            else if (command == "frame")
+            {
+                try
+                {
+                    request.m_frame = from_string<size_t>(argument);
+                }
+                catch (const ExceptionStringConversionError&)
+                {
+                    reply = "error invalid frame number: " + argument;
+                }
+            }
+            else if (command == "parameter")
+            {
+                const string::size_type equal_pos = argument.find_first_of('=');
+                if (equal_pos == string::npos)
+                    reply = "error invalid parameter assignment: " + argument;
+                else
+                {
+                    request.m_params.insert_path(
+                        argument.substr(0, equal_pos),
+                        argument.substr(equal_pos + 1));
+                }
+            }
+            else if (command == "render")
+            {
+                LOG_INFO(logger, "render server: rendering request...");
+                reply = handler.handle(request) ? "ok" : "error rendering failed";
+                request = RenderRequest();
+            }
+            else if (command == "shutdown")
+                reply = "ok";
+            else
+            {
+                // Whatever sent this line doesn't speak our protocol: drop the connection
+                // rather than executing the commands that may follow.
+                LOG_WARNING(logger, "render server: unknown command \"%s\", closing connection.", command.c_str());
+                reply = "error unknown command: " + command + '\n';
+                asio::write(socket, asio::buffer(reply), error);
+                return false;
+            }
+
+            if (!reply.empty())
+            {
+                reply += '\n';
+                asio::write(socket, asio::buffer(reply), error);
+            }
+
+            if (command == "shutdown")
+                return true;
+
+            if (error)
+                return false;
+        }
+    }
+}
+
+RenderServer::RenderServer(
+    const string&           endpoint,
+    Logger&                 logger)
+  : m_endpoint(endpoint)
+  , m_logger(logger)
+{
+}
+
+bool RenderServer::run(IRenderRequestHandler& handler)
+{
+    asio::io_service io_service;
+    Protocol::acceptor acceptor(io_service);
+    boost::system::error_code error;
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+
+    // Remove the socket left behind by a previous run of the server, but nothing else.
+    if (bf::status(m_endpoint, error).type() == bf::socket_file)
+        bf::remove(m_endpoint, error);
+
+    const Protocol::endpoint endpoint(m_endpoint);
+
+    // Only the owner of the server may connect to the socket.
+    const mode_t previous_umask = umask(S_IRWXG | S_IRWXO);
+
+    error.clear();
+    acceptor.open(endpoint.protocol(), error);
+    if (!error)
+        acceptor.bind(endpoint, error);
+
+    umask(previous_umask);
+
+#else
+
+    // Only listen on the loopback interface: the server is not meant to be reachable from other machines.
+    unsigned short port = 0;
+    try
+    {
+        port = from_string<unsigned short>(m_endpoint);
+    }
+    catch (const ExceptionStringConversionError&)
+    {
+        LOG_ERROR(m_logger, "render server: invalid port %s.", m_endpoint.c_str());
+        return false;
+    }
+
+    const Protocol::endpoint endpoint(asio::ip::address_v4::loopback(), port);
+
+    acceptor.open(endpoint.protocol(), error);
+    if (!error)
+        acceptor.set_option(Protocol::acceptor::reuse_address(true), error);
+    if (!error)
+        acceptor.bind(endpoint, error);
+
+#endif
+
+    if (!error)
+        acceptor.listen(asio::socket_base::max_connections, error);
+
+    if (error)
+    {
+        LOG_ERROR(
+            m_logger,
+            "render server: could not listen on %s: %s.",
+            m_endpoint.c_str(),
+            error.message().c_str());
+        return false;
+    }
+
+    LOG_INFO(m_logger, "render server: listening on %s...", m_endpoint.c_str());
+
+    while (true)
+    {
+        Protocol::socket socket(io_service);
+        acceptor.accept(socket, error);
+
+        if (error)
+        {
+            LOG_WARNING(
+                m_logger,
+                "render server: could not accept connection: %s.",
+                error.message().c_str());
+            continue;
+        }
+
+        LOG_DEBUG(m_logger, "render server: client connected.");
+
+        if (serve_client(socket, handler, m_logger))
+            break;
+
+        LOG_DEBUG(m_logger, "render server: client disconnected.");
+    }
+
+    LOG_INFO(m_logger, "render server: shutting down.");
+
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+    acceptor.close(error);
+    bf::remove(m_endpoint, error);
+#endif
+
+    return true;
+}
+
+}   // namespace cli
+}   // namespace appleseed
@@ -0,0 +1,122 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_CLI_RENDERSERVER_H
+#define APPLESEED_CLI_RENDERSERVER_H
+
+// appleseed.renderer headers.
+#include "renderer/api/utility.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+
+// Standard headers.
+#include <cstddef>
+#include <string>
+
+// Forward declarations.
+namespace foundation    { class Logger; }
+
+namespace appleseed {
+namespace cli {
+
+//
+// A render request received by the render server.
+//
+
+struct RenderRequest
+{
+    std::string             m_project_path;     // project to render, empty to render the last project again
+    std::string             m_output_path;      // output file, '#' characters are replaced by the frame number
+    size_t                  m_frame;            // frame number
+    renderer::ParamArray    m_params;           // overrides of the rendering parameters
+
+    RenderRequest();
+};
+
+
+//
+// Interface of the object that carries out the requests of the render server.
+//
+
+class IRenderRequestHandler
+{
+  public:
+    // Destructor.
+    virtual ~IRenderRequestHandler() {}
+
+    // Render a request. Return true on success, false otherwise.
+    virtual bool handle(const RenderRequest& request) = 0;
+};
+
+
+//
+// A server that keeps running and renders the requests it receives from local clients.
+//
+// On POSIX systems the server listens on a Unix domain socket that only the user
+// running the server may connect to; elsewhere it listens on a TCP port of the
+// loopback interface and accepts connections from any user of the local machine.
+// Requests are made of lines of text:
+//
+//   project <path>             project file to render
+//   output <path>              output file
+//   frame <n>                  frame number
+//   parameter <path>=<value>   override a rendering parameter, can be repeated
+//   render                     render the request made of the preceding lines
+//   shutdown                   stop the server
+//
+// The server answers each render or shutdown command with a single line:
+// either "ok" or "error <message>". A client may send any number of requests
+// on the same connection; clients are served one at a time. The connection is
+// closed on the first unknown command.
+//
+
+class RenderServer
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor. 'endpoint' is the path of the socket on POSIX systems,
+    // and the port number elsewhere.
+    RenderServer(
+        const std::string&          endpoint,
+        foundation::Logger&         logger);
+
+    // Serve requests until a client asks the server to shut down.
+    // Return false if the server could not be started.
+    bool run(IRenderRequestHandler& handler);
+
+  private:
+    const std::string               m_endpoint;
+    foundation::Logger&             m_logger;
+};
+
+}       // namespace cli
+}       // namespace appleseed
+
+#endif  // !APPLESEED_CLI_RENDERSERVER_H
@@ -424,6 +424,7 @@ namespace
             color_pipeline_combobox->setToolTip(m_params_metadata.get_path("spectrum_mode.help"));
             color_pipeline_combobox->addItem("RGB", "rgb");
             color_pipeline_combobox->addItem("Spectral", "spectral");
+            color_pipeline_combobox->addItem("Hero Wavelength", "hero_wavelength");
             layout->addRow("Color Pipeline:", color_pipeline_combobox);
 
             create_direct_link("spectrum_mode", "spectrum_mode", "rgb");
@@ -30,6 +30,9 @@
 // Interface header.
 #include "colorspace.h"
 
+// appleseed.foundation headers.
+#include "foundation/platform/cpudispatch.h"
+
 namespace foundation
 {
 
@@ -1477,10 +1480,206 @@ LightingConditions::LightingConditions(
 }
 
 
+//
+// Runtime-dispatched kernels for 31-channel spectra.
+//
+
+namespace
+{
+    Color3f spectrum_to_ciexyz_baseline(
+        const LightingConditions&   lighting,
+        const RegularSpectrum31f&   spectrum)
+    {
+#ifdef APPLESEED_USE_SSE
+        __m128 xyz1 = _mm_setzero_ps();
+        __m128 xyz2 = _mm_setzero_ps();
+        __m128 xyz3 = _mm_setzero_ps();
+        __m128 xyz4 = _mm_setzero_ps();
+
+        for (size_t w = 0; w < 8; ++w)
+        {
+            xyz1 = _mm_add_ps(xyz1, _mm_mul_ps(_mm_set1_ps(spectrum[4 * w + 0]), _mm_load_ps(&lighting.m_cmf[4 * w + 0][0])));
+            xyz2 = _mm_add_ps(xyz2, _mm_mul_ps(_mm_set1_ps(spectrum[4 * w + 1]), _mm_load_ps(&lighting.m_cmf[4 * w + 1][0])));
+            xyz3 = _mm_add_ps(xyz3, _mm_mul_ps(_mm_set1_ps(spectrum[4 * w + 2]), _mm_load_ps(&lighting.m_cmf[4 * w + 2][0])));
+            xyz4 = _mm_add_ps(xyz4, _mm_mul_ps(_mm_set1_ps(spectrum[4 * w + 3]), _mm_load_ps(&lighting.m_cmf[4 * w + 3][0])));
+        }
+
+        xyz1 = _mm_add_ps(xyz1, xyz2);
+        xyz3 = _mm_add_ps(xyz3, xyz4);
+        xyz1 = _mm_add_ps(xyz1, xyz3);
+
+        APPLESEED_SIMD4_ALIGN float transfer[4];
+        _mm_store_ps(transfer, xyz1);
+
+        return Color3f(transfer[0], transfer[1], transfer[2]);
+#else
+        Color3f xyz(0.0f);
+
+        for (size_t w = 0; w < 31; ++w)
+        {
+            const float val = spectrum[w];
+            xyz[0] += lighting.m_cmf[w][0] * val;
+            xyz[1] += lighting.m_cmf[w][1] * val;
+            xyz[2] += lighting.m_cmf[w][2] * val;
+        }
+
+        return xyz;
+#endif
+    }
+
+    // Compute result = a * sa + b * sb + c * sc.
+    void weighted_sum_baseline(
+        const float                 a,
+        const RegularSpectrum31f&   sa,
+        const float                 b,
+        const RegularSpectrum31f&   sb,
+        const float                 c,
+        const RegularSpectrum31f&   sc,
+        RegularSpectrum31f&         result)
+    {
+        RegularSpectrum31f tmp;
+
+        result = sa;
+        result *= a;
+
+        tmp = sb;
+        tmp *= b;
+        result += tmp;
+
+        tmp = sc;
+        tmp *= c;
+        result += tmp;
+    }
+
+    // The AVX kernels are compiled with the AVX qualifier when the compiler supports it,
+    // and only in builds targeting AVX otherwise.
+#if defined APPLESEED_USE_SSE && defined APPLESEED_CPU_DISPATCH
+    #define SPECTRUM_KERNEL_AVX APPLESEED_TARGET_AVX
+#elif defined APPLESEED_USE_AVX
+    #define SPECTRUM_KERNEL_AVX
+#endif
+
+#ifdef SPECTRUM_KERNEL_AVX
+
+    SPECTRUM_KERNEL_AVX Color3f spectrum_to_ciexyz_avx(
+        const LightingConditions&   lighting,
+        const RegularSpectrum31f&   spectrum)
+    {
+        // Process two wavelengths per register: the low half holds the weighted
+        // color matching functions of wavelength 2w, the high half those of 2w + 1.
+        __m256 xyz1 = _mm256_setzero_ps();
+        __m256 xyz2 = _mm256_setzero_ps();
+        __m256 xyz3 = _mm256_setzero_ps();
+        __m256 xyz4 = _mm256_setzero_ps();
+
+        for (size_t w = 0; w < 4; ++w)
+        {
+            const float* s = &spectrum[8 * w];
+            const Color4f* cmf = &lighting.m_cmf[8 * w];
+            xyz1 = _mm256_add_ps(xyz1, _mm256_mul_ps(_mm256_set_ps(s[1], s[1], s[1], s[1], s[0], s[0], s[0], s[0]), _mm256_loadu_ps(&cmf[0][0])));
+            xyz2 = _mm256_add_ps(xyz2, _mm256_mul_ps(_mm256_set_ps(s[3], s[3], s[3], s[3], s[2], s[2], s[2], s[2]), _mm256_loadu_ps(&cmf[2][0])));
+            xyz3 = _mm256_add_ps(xyz3, _mm256_mul_ps(_mm256_set_ps(s[5], s[5], s[5], s[5], s[4], s[4], s[4], s[4]), _mm256_loadu_ps(&cmf[4][0])));
+            xyz4 = _mm256_add_ps(xyz4, _mm256_mul_ps(_mm256_set_ps(s[7], s[7], s[7], s[7], s[6], s[6], s[6], s[6]), _mm256_loadu_ps(&cmf[6][0])));
+        }
+
+        xyz1 = _mm256_add_ps(xyz1, xyz2);
+        xyz3 = _mm256_add_ps(xyz3, xyz4);
+        xyz1 = _mm256_add_ps(xyz1, xyz3);
+
+        const __m128 xyz = _mm_add_ps(_mm256_castps256_ps128(xyz1), _mm256_extractf128_ps(xyz1, 1));
+
+        APPLESEED_SIMD4_ALIGN float transfer[4];
+        _mm_store_ps(transfer, xyz);
+
+        return Color3f(transfer[0], transfer[1], transfer[2]);
+    }
+
+    SPECTRUM_KERNEL_AVX void weighted_sum_avx(
+        const float                 a,
+        const RegularSpectrum31f&   sa,
+        const float                 b,
+        const RegularSpectrum31f&   sb,
+        const float                 c,
+        const RegularSpectrum31f&   sc,
+        RegularSpectrum31f&         result)
+    {
+        const __m256 va = _mm256_set1_ps(a);
+        const __m256 vb = _mm256_set1_ps(b);
+        const __m256 vc = _mm256_set1_ps(c);
+
+        // Same operation order as the baseline kernel, so that both produce the same results.
+        for (size_t i = 0; i < 32; i += 8)
+        {
+            __m256 r = _mm256_mul_ps(_mm256_loadu_ps(&sa[i]), va);
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_loadu_ps(&sb[i]), vb));
+            r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_loadu_ps(&sc[i]), vc));
+            _mm256_storeu_ps(&result[i], r);
+        }
+    }
+
+#endif  // SPECTRUM_KERNEL_AVX
+
+    typedef Color3f (*SpectrumToCIEXYZFunction)(
+        const LightingConditions&   lighting,
+        const RegularSpectrum31f&   spectrum);
+
+    typedef void (*WeightedSumFunction)(
+        const float                 a,
+        const RegularSpectrum31f&   sa,
+        const float                 b,
+        const RegularSpectrum31f&   sb,
+        const float                 c,
+        const RegularSpectrum31f&   sc,
+        RegularSpectrum31f&         result);
+
+    bool use_avx_spectrum_kernels()
+    {
+#ifdef SPECTRUM_KERNEL_AVX
+        return get_dispatch_instruction_set() >= InstructionSetAVX;
+#else
+        return false;
+#endif
+    }
+
+    // The kernels are selected on first use rather than at load time, since spectra
+    // may be converted from the static initializers of other translation units.
+
+    SpectrumToCIEXYZFunction get_spectrum_to_ciexyz_kernel()
+    {
+        static const SpectrumToCIEXYZFunction kernel =
+#ifdef SPECTRUM_KERNEL_AVX
+            use_avx_spectrum_kernels() ? &spectrum_to_ciexyz_avx :
+#endif
+            &spectrum_to_ciexyz_baseline;
+        return kernel;
+    }
+
+    WeightedSumFunction get_weighted_sum_kernel()
+    {
+        static const WeightedSumFunction kernel =
+#ifdef SPECTRUM_KERNEL_AVX
+            use_avx_spectrum_kernels() ? &weighted_sum_avx :
+#endif
+            &weighted_sum_baseline;
+        return kernel;
+    }
+
+#undef SPECTRUM_KERNEL_AVX
+}
+
+
 //
 // Spectrum <-> CIE XYZ transformations implementation.
 //
 
+template <>
+Color3f spectrum_to_ciexyz<float, RegularSpectrum31f>(
+    const LightingConditions&   lighting,
+    const RegularSpectrum31f&   spectrum)
+{
+    return get_spectrum_to_ciexyz_kernel()(lighting, spectrum);
+}
+
 void spectrum_to_ciexyz_standard(
     const float                 spectrum[],
     float                       ciexyz[3])
@@ -1497,4 +1696,49 @@ void spectrum_to_ciexyz_standard(
     ciexyz[2] = c[2];
 }
 
+
+//
+// Linear RGB to spectrum transformation implementation.
+//
+
+namespace impl
+{
+    template <>
+    void linear_rgb_to_spectrum<float, RegularSpectrum31f>(
+        const Color3f&              linear_rgb,
+        const RegularSpectrum31f&   white,
+        const RegularSpectrum31f&   cyan,
+        const RegularSpectrum31f&   magenta,
+        const RegularSpectrum31f&   yellow,
+        const RegularSpectrum31f&   red,
+        const RegularSpectrum31f&   green,
+        const RegularSpectrum31f&   blue,
+        RegularSpectrum31f&         spectrum)
+    {
+        const float r = linear_rgb[0];
+        const float g = linear_rgb[1];
+        const float b = linear_rgb[2];
+        const WeightedSumFunction weighted_sum = get_weighted_sum_kernel();
+
+        if (r <= g && r <= b)
+        {
+            if (g <= b)
+                weighted_sum(r, white, g - r, cyan, b - g, blue, spectrum);
+            else weighted_sum(r, white, b - r, cyan, g - b, green, spectrum);
+        }
+        else if (g <= r && g <= b)
+        {
+            if (r <= b)
+                weighted_sum(g, white, r - g, magenta, b - r, blue, spectrum);
+            else weighted_sum(g, white, b - g, magenta, r - b, red, spectrum);
+        }
+        else
+        {
+            if (r <= g)
+                weighted_sum(b, white, r - b, yellow, g - r, green, spectrum);
+            else weighted_sum(b, white, g - b, yellow, r - g, red, spectrum);
+        }
+    }
+}
+
 }   // namespace foundation
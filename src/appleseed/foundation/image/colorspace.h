@@ -233,6 +233,10 @@ Color<T, 3> linear_rgb_to_hsl(const Color<T, 3>& linear_rgb);
 //   http://graphics.stanford.edu/courses/cs148-10-summer/docs/2010--kerr--cie_xyz.pdf
 //
 
+// Convert a color from the CIE XYZ color space to the linear RGB color space, without any clamping.
+template <typename T>
+Color<T, 3> ciexyz_to_linear_rgb_unclamped(const Color<T, 3>& xyz);
+
 // Convert a color from the CIE XYZ color space to the linear RGB color space.
 template <typename T>
 Color<T, 3> ciexyz_to_linear_rgb(const Color<T, 3>& xyz);
@@ -595,15 +599,19 @@ inline Color<T, 3> linear_rgb_to_hsl(const Color<T, 3>& linear_rgb)
 //
 
 template <typename T>
-inline Color<T, 3> ciexyz_to_linear_rgb(const Color<T, 3>& xyz)
+inline Color<T, 3> ciexyz_to_linear_rgb_unclamped(const Color<T, 3>& xyz)
 {
     return
-        clamp_low(
-            Color<T, 3>(
-                T( 3.240479) * xyz[0] + T(-1.537150) * xyz[1] + T(-0.498535) * xyz[2],
-                T(-0.969256) * xyz[0] + T( 1.875991) * xyz[1] + T( 0.041556) * xyz[2],
-                T( 0.055648) * xyz[0] + T(-0.204043) * xyz[1] + T( 1.057311) * xyz[2]),
-            T(0.0));
+        Color<T, 3>(
+            T( 3.240479) * xyz[0] + T(-1.537150) * xyz[1] + T(-0.498535) * xyz[2],
+            T(-0.969256) * xyz[0] + T( 1.875991) * xyz[1] + T( 0.041556) * xyz[2],
+            T( 0.055648) * xyz[0] + T(-0.204043) * xyz[1] + T( 1.057311) * xyz[2]);
+}
+
+template <typename T>
+inline Color<T, 3> ciexyz_to_linear_rgb(const Color<T, 3>& xyz)
+{
+    return clamp_low(ciexyz_to_linear_rgb_unclamped(xyz), T(0.0));
 }
 
 template <typename T>
@@ -864,37 +872,12 @@ Color<T, 3> spectrum_to_ciexyz(
     return Color<T, 3>(x, y, z);
 }
 
-#ifdef APPLESEED_USE_SSE
-
+// The conversion of 31-channel spectra is dispatched at runtime to a kernel
+// compiled for the host instruction set (see foundation/platform/cpudispatch.h).
 template <>
-inline Color3f spectrum_to_ciexyz<float, RegularSpectrum31f>(
+APPLESEED_DLLSYMBOL Color3f spectrum_to_ciexyz<float, RegularSpectrum31f>(
     const LightingConditions&   lighting,
-    const RegularSpectrum31f&   spectrum)
-{
-    __m128 xyz1 = _mm_setzero_ps();
-    __m128 xyz2 = _mm_setzero_ps();
-    __m128 xyz3 = _mm_setzero_ps();
-    __m128 xyz4 = _mm_setzero_ps();
-
-    for (size_t w = 0; w < 8; ++w)
-    {
-        xyz1 = _mm_add_ps(xyz1, _mm_mul_ps(_mm_set1_ps(spectrum[4 * w + 0]), _mm_load_ps(&lighting.m_cmf[4 * w + 0][0])));
-        xyz2 = _mm_add_ps(xyz2, _mm_mul_ps(_mm_set1_ps(spectrum[4 * w + 1]), _mm_load_ps(&lighting.m_cmf[4 * w + 1][0])));
-        xyz3 = _mm_add_ps(xyz3, _mm_mul_ps(_mm_set1_ps(spectrum[4 * w + 2]), _mm_load_ps(&lighting.m_cmf[4 * w + 2][0])));
-        xyz4 = _mm_add_ps(xyz4, _mm_mul_ps(_mm_set1_ps(spectrum[4 * w + 3]), _mm_load_ps(&lighting.m_cmf[4 * w + 3][0])));
-    }
-
-    xyz1 = _mm_add_ps(xyz1, xyz2);
-    xyz3 = _mm_add_ps(xyz3, xyz4);
-    xyz1 = _mm_add_ps(xyz1, xyz3);
-
-    APPLESEED_SIMD4_ALIGN float transfer[4];
-    _mm_store_ps(transfer, xyz1);
-
-    return Color3f(transfer[0], transfer[1], transfer[2]);
-}
-
-#endif  // APPLESEED_USE_SSE
+    const RegularSpectrum31f&   spectrum);
 
 template <typename T, typename SpectrumType>
 void ciexyz_reflectance_to_spectrum(
@@ -1060,6 +1043,19 @@ namespace impl
             }
         }
     }
+
+    // Same conversion for 31-channel spectra, dispatched at runtime.
+    template <>
+    APPLESEED_DLLSYMBOL void linear_rgb_to_spectrum<float, RegularSpectrum31f>(
+        const Color3f&              linear_rgb,
+        const RegularSpectrum31f&   white,
+        const RegularSpectrum31f&   cyan,
+        const RegularSpectrum31f&   magenta,
+        const RegularSpectrum31f&   yellow,
+        const RegularSpectrum31f&   red,
+        const RegularSpectrum31f&   green,
+        const RegularSpectrum31f&   blue,
+        RegularSpectrum31f&         spectrum);
 }
 
 template <typename T, typename SpectrumType>
@@ -33,8 +33,10 @@
 // appleseed.foundation headers.
 #include "foundation/image/tile.h"
 #include "foundation/platform/types.h"
+#include "foundation/utility/job/parallelfor.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -121,38 +123,54 @@ Image::Image(
     {
         for (size_t tx = 0; tx < m_props.m_tile_count_x; ++tx)
         {
-            const size_t tile_width = m_props.get_tile_width(tx);
-            const size_t tile_height = m_props.get_tile_height(ty);
-
-            Tile* tile =
+            m_tiles[ty * m_props.m_tile_count_x + tx] =
                 new Tile(
-                    tile_width,
-                    tile_height,
+                    m_props.get_tile_width(tx),
+                    m_props.get_tile_height(ty),
                     m_props.m_channel_count,
                     m_props.m_pixel_format);
+        }
+    }
 
-            m_tiles[ty * m_props.m_tile_count_x + tx] = tile;
+    // Convert destination tiles in parallel. Each row of a destination tile is split
+    // into runs of pixels that are contiguous in a single source tile, and each run
+    // is converted with a single call.
+    parallel_for(
+        m_props.m_tile_count,
+        [&](const size_t tile_index)
+        {
+            const size_t tx = tile_index % m_props.m_tile_count_x;
+            const size_t ty = tile_index / m_props.m_tile_count_x;
+            Tile* tile = m_tiles[tile_index];
 
-            for (size_t py = 0; py < tile_height; ++py)
+            for (size_t py = 0; py < tile->get_height(); ++py)
             {
-                for (size_t px = 0; px < tile_width; ++px)
+                const size_t iy = ty * m_props.m_tile_height + py;
+
+                for (size_t px = 0; px < tile->get_width(); )
                 {
                     const size_t ix = tx * m_props.m_tile_width + px;
-                    const size_t iy = ty * m_props.m_tile_height + py;
+                    const size_t source_tile_x = ix / source_props.m_tile_width;
+                    const size_t source_run_end =
+                        source_tile_x * source_props.m_tile_width +
+                        source_props.get_tile_width(source_tile_x);
+                    const size_t run_length =
+                        min(tile->get_width() - px, source_run_end - ix);
                     const uint8* source_pixel = source.pixel(ix, iy);
 
                     Pixel::convert(
                         source_props.m_pixel_format,
                         source_pixel,
-                        source_pixel + source_props.m_pixel_size,
+                        source_pixel + run_length * source_props.m_pixel_size,
                         1,
                         m_props.m_pixel_format,
                         tile->pixel(px, py),
                         1);
+
+                    px += run_length;
                 }
             }
-        }
-    }
+        });
 }
 
 Image::~Image()
@@ -0,0 +1,380 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "progressiveexrimagefilewriter.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/exceptions/exceptionioerror.h"
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/exceptionunsupportedimageformat.h"
+#include "foundation/image/exrutils.h"
+#include "foundation/image/tile.h"
+#include "foundation/platform/types.h"
+
+// OpenEXR headers.
+#include "foundation/platform/_beginexrheaders.h"
+#include "OpenEXR/IexBaseExc.h"
+#include "OpenEXR/ImathBox.h"
+#include "OpenEXR/ImfChannelList.h"
+#include "OpenEXR/ImfFrameBuffer.h"
+#include "OpenEXR/ImfHeader.h"
+#include "OpenEXR/ImfLineOrder.h"
+#include "OpenEXR/ImfMultiPartOutputFile.h"
+#include "OpenEXR/ImfPixelType.h"
+#include "OpenEXR/ImfTileDescription.h"
+#include "OpenEXR/ImfTiledOutputPart.h"
+#include "foundation/platform/_endexrheaders.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Iex;
+using namespace Imath;
+using namespace Imf;
+using namespace std;
+
+namespace foundation
+{
+
+//
+// ProgressiveEXRImageFileWriter class implementation.
+//
+
+namespace
+{
+    enum TileState
+    {
+        TileNotWritten,
+        TileStaged,
+        TileWritten
+    };
+
+    PixelType get_imf_pixel_type(const PixelFormat pixel_format)
+    {
+        switch (pixel_format)
+        {
+          case PixelFormatUInt32: return UINT;
+          case PixelFormatHalf: return HALF;
+          case PixelFormatFloat: return FLOAT;
+          default: throw ExceptionUnsupportedImageFormat();
+        }
+    }
+}
+
+struct ProgressiveEXRImageFileWriter::Impl
+{
+    struct Part
+    {
+        CanvasProperties        m_props;
+        PixelFormat             m_pixel_format;
+        vector<string>          m_channel_names;
+        vector<uint8>           m_tile_states;          // one TileState per tile
+        vector<size_t>          m_staged_tile_counts;   // number of staged tiles per tile row
+        vector<vector<uint8>>   m_row_buffers;          // staged pixels per tile row, allocated on demand
+
+        explicit Part(const CanvasProperties& props)
+          : m_props(props)
+        {
+        }
+
+        size_t get_row_height(const size_t tile_y) const
+        {
+            return min(m_props.m_tile_height, m_props.m_canvas_height - tile_y * m_props.m_tile_height);
+        }
+
+        size_t get_pixel_size() const
+        {
+            return Pixel::size(m_pixel_format) * m_props.m_channel_count;
+        }
+    };
+
+    vector<Part>                    m_parts;
+    vector<Header>                  m_headers;
+    auto_ptr<MultiPartOutputFile>   m_file;
+
+    void set_frame_buffer(
+        TiledOutputPart&    file,
+        const Part&         part,
+        const size_t        tile_y)
+    {
+        const size_t channel_size = Pixel::size(part.m_pixel_format);
+        const size_t stride_x = part.get_pixel_size();
+        const size_t stride_y = stride_x * part.m_props.m_canvas_width;
+        const size_t row_origin = tile_y * part.m_props.m_tile_height * stride_y;
+        const char* row_base =
+            reinterpret_cast<const char*>(&part.m_row_buffers[tile_y][0]) - row_origin;
+
+        const PixelType pixel_type = get_imf_pixel_type(part.m_pixel_format);
+
+        FrameBuffer framebuffer;
+        for (size_t c = 0, e = part.m_channel_names.size(); c < e; ++c)
+        {
+            framebuffer.insert(
+                part.m_channel_names[c].c_str(),
+                Slice(
+                    pixel_type,
+                    const_cast<char*>(row_base + c * channel_size),
+                    stride_x,
+                    stride_y));
+        }
+
+        file.setFrameBuffer(framebuffer);
+    }
+
+    void flush_row(const size_t part_index, const size_t tile_y)
+    {
+        Part& part = m_parts[part_index];
+        const size_t tile_count_x = part.m_props.m_tile_count_x;
+
+        TiledOutputPart file(*m_file, static_cast<int>(part_index));
+        set_frame_buffer(file, part, tile_y);
+
+        // Write the whole row at once so that OpenEXR compresses its tiles in parallel.
+        const int iy = static_cast<int>(tile_y);
+        file.writeTiles(0, static_cast<int>(tile_count_x) - 1, iy, iy);
+
+        fill_n(&part.m_tile_states[tile_y * tile_count_x], tile_count_x, static_cast<uint8>(TileWritten));
+        part.m_staged_tile_counts[tile_y] = 0;
+        vector<uint8>().swap(part.m_row_buffers[tile_y]);
+    }
+
+    void flush_incomplete_row(const size_t part_index, const size_t tile_y)
+    {
+        Part& part = m_parts[part_index];
+        const size_t tile_count_x = part.m_props.m_tile_count_x;
+
+        TiledOutputPart file(*m_file, static_cast<int>(part_index));
+        set_frame_buffer(file, part, tile_y);
+
+        for (size_t tile_x = 0; tile_x < tile_count_x; ++tile_x)
+        {
+            uint8& state = part.m_tile_states[tile_y * tile_count_x + tile_x];
+            if (state == TileStaged)
+            {
+                file.writeTile(static_cast<int>(tile_x), static_cast<int>(tile_y));
+                state = TileWritten;
+            }
+        }
+
+        part.m_staged_tile_counts[tile_y] = 0;
+        vector<uint8>().swap(part.m_row_buffers[tile_y]);
+    }
+};
+
+ProgressiveEXRImageFileWriter::ProgressiveEXRImageFileWriter()
+  : impl(new Impl())
+{
+}
+
+ProgressiveEXRImageFileWriter::~ProgressiveEXRImageFileWriter()
+{
+    if (is_open())
+    {
+        try
+        {
+            close();
+        }
+        catch (const ExceptionIOError&)
+        {
+        }
+    }
+
+    delete impl;
+}
+
+size_t ProgressiveEXRImageFileWriter::append_part(
+    const char*             part_name,
+    const CanvasProperties& props,
+    const ImageAttributes&  image_attributes,
+    const PixelFormat       pixel_format,
+    const size_t            channel_count,
+    const char**            channel_names)
+{
+    assert(!is_open());
+    assert(part_name);
+    assert(channel_count <= props.m_channel_count);
+    assert(channel_names);
+
+    // Construct the Header object.
+    Header header(
+        static_cast<int>(props.m_canvas_width),
+        static_cast<int>(props.m_canvas_height));
+
+    header.setTileDescription(
+        TileDescription(
+            static_cast<unsigned int>(props.m_tile_width),
+            static_cast<unsigned int>(props.m_tile_height),
+            ONE_LEVEL));
+
+    // Tiles are written in the order in which they are rendered.
+    header.lineOrder() = RANDOM_Y;
+
+    const PixelType pixel_type = get_imf_pixel_type(pixel_format);
+    ChannelList channels;
+    for (size_t c = 0; c < channel_count; ++c)
+        channels.insert(channel_names[c], Channel(pixel_type));
+    header.channels() = channels;
+
+    add_attributes(image_attributes, header);
+    header.setName(part_name);
+
+    impl->m_headers.push_back(header);
+
+    // Prepare the bookkeeping of tiles.
+    Impl::Part part(props);
+    part.m_pixel_format = pixel_format;
+    part.m_channel_names.assign(channel_names, channel_names + channel_count);
+    part.m_tile_states.assign(props.m_tile_count, static_cast<uint8>(TileNotWritten));
+    part.m_staged_tile_counts.assign(props.m_tile_count_y, 0);
+    part.m_row_buffers.resize(props.m_tile_count_y);
+
+    impl->m_parts.push_back(part);
+
+    return impl->m_parts.size() - 1;
+}
+
+void ProgressiveEXRImageFileWriter::open(const char* filename)
+{
+    assert(!is_open());
+    assert(!impl->m_headers.empty());
+
+    initialize_openexr();
+
+    try
+    {
+        impl->m_file.reset(
+            new MultiPartOutputFile(
+                filename,
+                &impl->m_headers[0],
+                static_cast<int>(impl->m_headers.size())));
+    }
+    catch (const BaseExc& e)
+    {
+        throw ExceptionIOError(e.what());
+    }
+}
+
+void ProgressiveEXRImageFileWriter::close()
+{
+    assert(is_open());
+
+    try
+    {
+        for (size_t i = 0, e = impl->m_parts.size(); i < e; ++i)
+        {
+            const Impl::Part& part = impl->m_parts[i];
+
+            for (size_t tile_y = 0; tile_y < part.m_props.m_tile_count_y; ++tile_y)
+            {
+                if (part.m_staged_tile_counts[tile_y] > 0)
+                    impl->flush_incomplete_row(i, tile_y);
+            }
+        }
+
+        impl->m_file.reset();
+    }
+    catch (const BaseExc& e)
+    {
+        impl->m_file.reset();
+        throw ExceptionIOError(e.what());
+    }
+}
+
+bool ProgressiveEXRImageFileWriter::is_open() const
+{
+    return impl->m_file.get() != nullptr;
+}
+
+void ProgressiveEXRImageFileWriter::write_tile(
+    const size_t            part_index,
+    const Tile&             tile,
+    const size_t            tile_x,
+    const size_t            tile_y)
+{
+    assert(is_open());
+    assert(part_index < impl->m_parts.size());
+
+    Impl::Part& part = impl->m_parts[part_index];
+    const CanvasProperties& props = part.m_props;
+
+    assert(tile_x < props.m_tile_count_x);
+    assert(tile_y < props.m_tile_count_y);
+    assert(tile.get_channel_count() == props.m_channel_count);
+
+    uint8& state = part.m_tile_states[tile_y * props.m_tile_count_x + tile_x];
+    if (state == TileWritten)
+        return;
+
+    // Allocate the staging buffer of this tile row.
+    vector<uint8>& row_buffer = part.m_row_buffers[tile_y];
+    const size_t pixel_size = part.get_pixel_size();
+    if (row_buffer.empty())
+        row_buffer.resize(props.m_canvas_width * part.get_row_height(tile_y) * pixel_size);
+
+    // Convert the pixels of the tile to the pixel format of the part.
+    const size_t value_count = tile.get_width() * props.m_channel_count;
+    for (size_t y = 0, h = tile.get_height(); y < h; ++y)
+    {
+        const uint8* src = tile.pixel(0, y);
+        uint8* dest =
+            &row_buffer[(y * props.m_canvas_width + tile_x * props.m_tile_width) * pixel_size];
+
+        Pixel::convert(
+            tile.get_pixel_format(),
+            src,
+            src + value_count * Pixel::size(tile.get_pixel_format()),
+            1,
+            part.m_pixel_format,
+            dest,
+            1);
+    }
+
+    if (state == TileStaged)
+        return;
+
+    state = TileStaged;
+
+    // Write the row once all its tiles have been received.
+    try
+    {
+        if (++part.m_staged_tile_counts[tile_y] == props.m_tile_count_x)
+            impl->flush_row(part_index, tile_y);
+    }
+    catch (const BaseExc& e)
+    {
+        throw ExceptionIOError(e.what());
+    }
+}
+
+}   // namespace foundation
@@ -0,0 +1,105 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_FOUNDATION_IMAGE_PROGRESSIVEEXRIMAGEFILEWRITER_H
+#define APPLESEED_FOUNDATION_IMAGE_PROGRESSIVEEXRIMAGEFILEWRITER_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/image/pixel.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Standard headers.
+#include <cstddef>
+
+// Forward declarations.
+namespace foundation    { class CanvasProperties; }
+namespace foundation    { class ImageAttributes; }
+namespace foundation    { class Tile; }
+
+namespace foundation
+{
+
+//
+// An OpenEXR image file writer that receives tiles as they become available.
+//
+// All parts must be declared before the file is opened. Tiles can then be
+// written in any order. Tiles are staged per tile row; once all the tiles of
+// a row have been received, the row is compressed by OpenEXR's thread pool
+// and written to disk, so that at most the incomplete rows are held in memory.
+//
+// This class is not thread-safe.
+//
+
+class APPLESEED_DLLSYMBOL ProgressiveEXRImageFileWriter
+  : public NonCopyable
+{
+  public:
+    // Constructor.
+    ProgressiveEXRImageFileWriter();
+
+    // Destructor. Closes the file if it is still open.
+    ~ProgressiveEXRImageFileWriter();
+
+    // Declare a part of the file. Tiles of this part will be stored in the given pixel format.
+    // Return the index of the part.
+    size_t append_part(
+        const char*             part_name,
+        const CanvasProperties& props,
+        const ImageAttributes&  image_attributes,
+        const PixelFormat       pixel_format,
+        const size_t            channel_count,
+        const char**            channel_names);
+
+    // Create the image file.
+    void open(const char* filename);
+
+    // Write the staged tiles of incomplete rows and close the image file.
+    void close();
+
+    // Return true if an image file is currently open.
+    bool is_open() const;
+
+    // Write a tile of a given part. Tiles that were already written to disk are ignored.
+    void write_tile(
+        const size_t            part_index,
+        const Tile&             tile,
+        const size_t            tile_x,
+        const size_t            tile_y);
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_IMAGE_PROGRESSIVEEXRIMAGEFILEWRITER_H
@@ -236,6 +236,14 @@ inline void RegularSpectrum<T, N>::set(const ValueType val)
 template <>
 APPLESEED_FORCE_INLINE void RegularSpectrum<float, 31>::set(const float val)
 {
+#ifdef APPLESEED_USE_AVX
+    const __m256 mval = _mm256_set1_ps(val);
+
+    _mm256_storeu_ps(&m_samples[ 0], mval);
+    _mm256_storeu_ps(&m_samples[ 8], mval);
+    _mm256_storeu_ps(&m_samples[16], mval);
+    _mm256_storeu_ps(&m_samples[24], mval);
+#else
     const __m128 mval = _mm_set1_ps(val);
 
     _mm_store_ps(&m_samples[ 0], mval);
@@ -246,6 +254,7 @@ APPLESEED_FORCE_INLINE void RegularSpectrum<float, 31>::set(const float val)
     _mm_store_ps(&m_samples[20], mval);
     _mm_store_ps(&m_samples[24], mval);
     _mm_store_ps(&m_samples[28], mval);
+#endif
 }
 
 #endif  // APPLESEED_USE_SSE
@@ -457,6 +466,12 @@ inline RegularSpectrum<T, N>& operator+=(RegularSpectrum<T, N>& lhs, const Regul
 template <>
 APPLESEED_FORCE_INLINE RegularSpectrum<float, 31>& operator+=(RegularSpectrum<float, 31>& lhs, const RegularSpectrum<float, 31>& rhs)
 {
+#ifdef APPLESEED_USE_AVX
+    _mm256_storeu_ps(&lhs[ 0], _mm256_add_ps(_mm256_loadu_ps(&lhs[ 0]), _mm256_loadu_ps(&rhs[ 0])));
+    _mm256_storeu_ps(&lhs[ 8], _mm256_add_ps(_mm256_loadu_ps(&lhs[ 8]), _mm256_loadu_ps(&rhs[ 8])));
+    _mm256_storeu_ps(&lhs[16], _mm256_add_ps(_mm256_loadu_ps(&lhs[16]), _mm256_loadu_ps(&rhs[16])));
+    _mm256_storeu_ps(&lhs[24], _mm256_add_ps(_mm256_loadu_ps(&lhs[24]), _mm256_loadu_ps(&rhs[24])));
+#else
     _mm_store_ps(&lhs[ 0], _mm_add_ps(_mm_load_ps(&lhs[ 0]), _mm_load_ps(&rhs[ 0])));
     _mm_store_ps(&lhs[ 4], _mm_add_ps(_mm_load_ps(&lhs[ 4]), _mm_load_ps(&rhs[ 4])));
     _mm_store_ps(&lhs[ 8], _mm_add_ps(_mm_load_ps(&lhs[ 8]), _mm_load_ps(&rhs[ 8])));
@@ -465,6 +480,7 @@ APPLESEED_FORCE_INLINE RegularSpectrum<float, 31>& operator+=(RegularSpectrum<fl
     _mm_store_ps(&lhs[20], _mm_add_ps(_mm_load_ps(&lhs[20]), _mm_load_ps(&rhs[20])));
     _mm_store_ps(&lhs[24], _mm_add_ps(_mm_load_ps(&lhs[24]), _mm_load_ps(&rhs[24])));
     _mm_store_ps(&lhs[28], _mm_add_ps(_mm_load_ps(&lhs[28]), _mm_load_ps(&rhs[28])));
+#endif
 
     return lhs;
 }
@@ -480,6 +496,32 @@ inline RegularSpectrum<T, N>& operator-=(RegularSpectrum<T, N>& lhs, const Regul
     return lhs;
 }
 
+#ifdef APPLESEED_USE_SSE
+
+template <>
+APPLESEED_FORCE_INLINE RegularSpectrum<float, 31>& operator-=(RegularSpectrum<float, 31>& lhs, const RegularSpectrum<float, 31>& rhs)
+{
+#ifdef APPLESEED_USE_AVX
+    _mm256_storeu_ps(&lhs[ 0], _mm256_sub_ps(_mm256_loadu_ps(&lhs[ 0]), _mm256_loadu_ps(&rhs[ 0])));
+    _mm256_storeu_ps(&lhs[ 8], _mm256_sub_ps(_mm256_loadu_ps(&lhs[ 8]), _mm256_loadu_ps(&rhs[ 8])));
+    _mm256_storeu_ps(&lhs[16], _mm256_sub_ps(_mm256_loadu_ps(&lhs[16]), _mm256_loadu_ps(&rhs[16])));
+    _mm256_storeu_ps(&lhs[24], _mm256_sub_ps(_mm256_loadu_ps(&lhs[24]), _mm256_loadu_ps(&rhs[24])));
+#else
+    _mm_store_ps(&lhs[ 0], _mm_sub_ps(_mm_load_ps(&lhs[ 0]), _mm_load_ps(&rhs[ 0])));
+    _mm_store_ps(&lhs[ 4], _mm_sub_ps(_mm_load_ps(&lhs[ 4]), _mm_load_ps(&rhs[ 4])));
+    _mm_store_ps(&lhs[ 8], _mm_sub_ps(_mm_load_ps(&lhs[ 8]), _mm_load_ps(&rhs[ 8])));
+    _mm_store_ps(&lhs[12], _mm_sub_ps(_mm_load_ps(&lhs[12]), _mm_load_ps(&rhs[12])));
+    _mm_store_ps(&lhs[16], _mm_sub_ps(_mm_load_ps(&lhs[16]), _mm_load_ps(&rhs[16])));
+    _mm_store_ps(&lhs[20], _mm_sub_ps(_mm_load_ps(&lhs[20]), _mm_load_ps(&rhs[20])));
+    _mm_store_ps(&lhs[24], _mm_sub_ps(_mm_load_ps(&lhs[24]), _mm_load_ps(&rhs[24])));
+    _mm_store_ps(&lhs[28], _mm_sub_ps(_mm_load_ps(&lhs[28]), _mm_load_ps(&rhs[28])));
+#endif
+
+    return lhs;
+}
+
+#endif  // APPLESEED_USE_SSE
+
 template <typename T, size_t N>
 inline RegularSpectrum<T, N>& operator*=(RegularSpectrum<T, N>& lhs, const T rhs)
 {
@@ -494,6 +536,14 @@ inline RegularSpectrum<T, N>& operator*=(RegularSpectrum<T, N>& lhs, const T rhs
 template <>
 APPLESEED_FORCE_INLINE RegularSpectrum<float, 31>& operator*=(RegularSpectrum<float, 31>& lhs, const float rhs)
 {
+#ifdef APPLESEED_USE_AVX
+    const __m256 mrhs = _mm256_set1_ps(rhs);
+
+    _mm256_storeu_ps(&lhs[ 0], _mm256_mul_ps(_mm256_loadu_ps(&lhs[ 0]), mrhs));
+    _mm256_storeu_ps(&lhs[ 8], _mm256_mul_ps(_mm256_loadu_ps(&lhs[ 8]), mrhs));
+    _mm256_storeu_ps(&lhs[16], _mm256_mul_ps(_mm256_loadu_ps(&lhs[16]), mrhs));
+    _mm256_storeu_ps(&lhs[24], _mm256_mul_ps(_mm256_loadu_ps(&lhs[24]), mrhs));
+#else
     const __m128 mrhs = _mm_set1_ps(rhs);
 
     _mm_store_ps(&lhs[ 0], _mm_mul_ps(_mm_load_ps(&lhs[ 0]), mrhs));
@@ -504,6 +554,7 @@ APPLESEED_FORCE_INLINE RegularSpectrum<float, 31>& operator*=(RegularSpectrum<fl
     _mm_store_ps(&lhs[20], _mm_mul_ps(_mm_load_ps(&lhs[20]), mrhs));
     _mm_store_ps(&lhs[24], _mm_mul_ps(_mm_load_ps(&lhs[24]), mrhs));
     _mm_store_ps(&lhs[28], _mm_mul_ps(_mm_load_ps(&lhs[28]), mrhs));
+#endif
 
     return lhs;
 }
@@ -524,6 +575,12 @@ inline RegularSpectrum<T, N>& operator*=(RegularSpectrum<T, N>& lhs, const Regul
 template <>
 APPLESEED_FORCE_INLINE RegularSpectrum<float, 31>& operator*=(RegularSpectrum<float, 31>& lhs, const RegularSpectrum<float, 31>& rhs)
 {
+#ifdef APPLESEED_USE_AVX
+    _mm256_storeu_ps(&lhs[ 0], _mm256_mul_ps(_mm256_loadu_ps(&lhs[ 0]), _mm256_loadu_ps(&rhs[ 0])));
+    _mm256_storeu_ps(&lhs[ 8], _mm256_mul_ps(_mm256_loadu_ps(&lhs[ 8]), _mm256_loadu_ps(&rhs[ 8])));
+    _mm256_storeu_ps(&lhs[16], _mm256_mul_ps(_mm256_loadu_ps(&lhs[16]), _mm256_loadu_ps(&rhs[16])));
+    _mm256_storeu_ps(&lhs[24], _mm256_mul_ps(_mm256_loadu_ps(&lhs[24]), _mm256_loadu_ps(&rhs[24])));
+#else
     _mm_store_ps(&lhs[ 0], _mm_mul_ps(_mm_load_ps(&lhs[ 0]), _mm_load_ps(&rhs[ 0])));
     _mm_store_ps(&lhs[ 4], _mm_mul_ps(_mm_load_ps(&lhs[ 4]), _mm_load_ps(&rhs[ 4])));
     _mm_store_ps(&lhs[ 8], _mm_mul_ps(_mm_load_ps(&lhs[ 8]), _mm_load_ps(&rhs[ 8])));
@@ -532,6 +589,7 @@ APPLESEED_FORCE_INLINE RegularSpectrum<float, 31>& operator*=(RegularSpectrum<fl
     _mm_store_ps(&lhs[20], _mm_mul_ps(_mm_load_ps(&lhs[20]), _mm_load_ps(&rhs[20])));
     _mm_store_ps(&lhs[24], _mm_mul_ps(_mm_load_ps(&lhs[24]), _mm_load_ps(&rhs[24])));
     _mm_store_ps(&lhs[28], _mm_mul_ps(_mm_load_ps(&lhs[28]), _mm_load_ps(&rhs[28])));
+#endif
 
     return lhs;
 }
@@ -574,6 +632,35 @@ inline RegularSpectrum<T, N>& operator/=(RegularSpectrum<T, N>& lhs, const Regul
     return lhs;
 }
 
+#ifdef APPLESEED_USE_SSE
+
+template <>
+APPLESEED_FORCE_INLINE RegularSpectrum<float, 31>& operator/=(RegularSpectrum<float, 31>& lhs, const RegularSpectrum<float, 31>& rhs)
+{
+#ifdef APPLESEED_USE_AVX
+    _mm256_storeu_ps(&lhs[ 0], _mm256_div_ps(_mm256_loadu_ps(&lhs[ 0]), _mm256_loadu_ps(&rhs[ 0])));
+    _mm256_storeu_ps(&lhs[ 8], _mm256_div_ps(_mm256_loadu_ps(&lhs[ 8]), _mm256_loadu_ps(&rhs[ 8])));
+    _mm256_storeu_ps(&lhs[16], _mm256_div_ps(_mm256_loadu_ps(&lhs[16]), _mm256_loadu_ps(&rhs[16])));
+    _mm256_storeu_ps(&lhs[24], _mm256_div_ps(_mm256_loadu_ps(&lhs[24]), _mm256_loadu_ps(&rhs[24])));
+#else
+    _mm_store_ps(&lhs[ 0], _mm_div_ps(_mm_load_ps(&lhs[ 0]), _mm_load_ps(&rhs[ 0])));
+    _mm_store_ps(&lhs[ 4], _mm_div_ps(_mm_load_ps(&lhs[ 4]), _mm_load_ps(&rhs[ 4])));
+    _mm_store_ps(&lhs[ 8], _mm_div_ps(_mm_load_ps(&lhs[ 8]), _mm_load_ps(&rhs[ 8])));
+    _mm_store_ps(&lhs[12], _mm_div_ps(_mm_load_ps(&lhs[12]), _mm_load_ps(&rhs[12])));
+    _mm_store_ps(&lhs[16], _mm_div_ps(_mm_load_ps(&lhs[16]), _mm_load_ps(&rhs[16])));
+    _mm_store_ps(&lhs[20], _mm_div_ps(_mm_load_ps(&lhs[20]), _mm_load_ps(&rhs[20])));
+    _mm_store_ps(&lhs[24], _mm_div_ps(_mm_load_ps(&lhs[24]), _mm_load_ps(&rhs[24])));
+    _mm_store_ps(&lhs[28], _mm_div_ps(_mm_load_ps(&lhs[28]), _mm_load_ps(&rhs[28])));
+#endif
+
+    // The padding sample is 0 / 0; bring it back to zero.
+    lhs[31] = 0.0f;
+
+    return lhs;
+}
+
+#endif  // APPLESEED_USE_SSE
+
 template <typename T, size_t N>
 inline RegularSpectrum<T, N> rcp(const RegularSpectrum<T, N>& s)
 {
@@ -638,6 +725,38 @@ inline void clamp_in_place(RegularSpectrum<T, N>& s, const T min, const T max)
     }
 }
 
+#ifdef APPLESEED_USE_SSE
+
+template <>
+inline void clamp_in_place(RegularSpectrum<float, 31>& s, const float min, const float max)
+{
+#ifdef APPLESEED_USE_AVX
+    const __m256 mmin = _mm256_set1_ps(min);
+    const __m256 mmax = _mm256_set1_ps(max);
+
+    _mm256_storeu_ps(&s[ 0], _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&s[ 0]), mmin), mmax));
+    _mm256_storeu_ps(&s[ 8], _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&s[ 8]), mmin), mmax));
+    _mm256_storeu_ps(&s[16], _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&s[16]), mmin), mmax));
+    _mm256_storeu_ps(&s[24], _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&s[24]), mmin), mmax));
+#else
+    const __m128 mmin = _mm_set1_ps(min);
+    const __m128 mmax = _mm_set1_ps(max);
+
+    _mm_store_ps(&s[ 0], _mm_min_ps(_mm_max_ps(_mm_load_ps(&s[ 0]), mmin), mmax));
+    _mm_store_ps(&s[ 4], _mm_min_ps(_mm_max_ps(_mm_load_ps(&s[ 4]), mmin), mmax));
+    _mm_store_ps(&s[ 8], _mm_min_ps(_mm_max_ps(_mm_load_ps(&s[ 8]), mmin), mmax));
+    _mm_store_ps(&s[12], _mm_min_ps(_mm_max_ps(_mm_load_ps(&s[12]), mmin), mmax));
+    _mm_store_ps(&s[16], _mm_min_ps(_mm_max_ps(_mm_load_ps(&s[16]), mmin), mmax));
+    _mm_store_ps(&s[20], _mm_min_ps(_mm_max_ps(_mm_load_ps(&s[20]), mmin), mmax));
+    _mm_store_ps(&s[24], _mm_min_ps(_mm_max_ps(_mm_load_ps(&s[24]), mmin), mmax));
+    _mm_store_ps(&s[28], _mm_min_ps(_mm_max_ps(_mm_load_ps(&s[28]), mmin), mmax));
+#endif
+
+    s[31] = 0.0f;
+}
+
+#endif  // APPLESEED_USE_SSE
+
 template <typename T, size_t N>
 inline RegularSpectrum<T, N> clamp_low(const RegularSpectrum<T, N>& s, const T min)
 {
@@ -659,6 +778,36 @@ inline void clamp_low_in_place(RegularSpectrum<T, N>& s, const T min)
     }
 }
 
+#ifdef APPLESEED_USE_SSE
+
+template <>
+inline void clamp_low_in_place(RegularSpectrum<float, 31>& s, const float min)
+{
+#ifdef APPLESEED_USE_AVX
+    const __m256 mmin = _mm256_set1_ps(min);
+
+    _mm256_storeu_ps(&s[ 0], _mm256_max_ps(_mm256_loadu_ps(&s[ 0]), mmin));
+    _mm256_storeu_ps(&s[ 8], _mm256_max_ps(_mm256_loadu_ps(&s[ 8]), mmin));
+    _mm256_storeu_ps(&s[16], _mm256_max_ps(_mm256_loadu_ps(&s[16]), mmin));
+    _mm256_storeu_ps(&s[24], _mm256_max_ps(_mm256_loadu_ps(&s[24]), mmin));
+#else
+    const __m128 mmin = _mm_set1_ps(min);
+
+    _mm_store_ps(&s[ 0], _mm_max_ps(_mm_load_ps(&s[ 0]), mmin));
+    _mm_store_ps(&s[ 4], _mm_max_ps(_mm_load_ps(&s[ 4]), mmin));
+    _mm_store_ps(&s[ 8], _mm_max_ps(_mm_load_ps(&s[ 8]), mmin));
+    _mm_store_ps(&s[12], _mm_max_ps(_mm_load_ps(&s[12]), mmin));
+    _mm_store_ps(&s[16], _mm_max_ps(_mm_load_ps(&s[16]), mmin));
+    _mm_store_ps(&s[20], _mm_max_ps(_mm_load_ps(&s[20]), mmin));
+    _mm_store_ps(&s[24], _mm_max_ps(_mm_load_ps(&s[24]), mmin));
+    _mm_store_ps(&s[28], _mm_max_ps(_mm_load_ps(&s[28]), mmin));
+#endif
+
+    s[31] = 0.0f;
+}
+
+#endif  // APPLESEED_USE_SSE
+
 template <typename T, size_t N>
 inline RegularSpectrum<T, N> clamp_high(const RegularSpectrum<T, N>& s, const T max)
 {
@@ -699,6 +848,14 @@ inline T min_value(const RegularSpectrum<T, N>& s)
 template <>
 inline float min_value(const RegularSpectrum<float, 31>& s)
 {
+#ifdef APPLESEED_USE_AVX
+    // Replace the padding sample by a duplicate of the last sample.
+    const __m256 s24 = _mm256_loadu_ps(&s[24]);
+    const __m256 m1 = _mm256_min_ps(_mm256_loadu_ps(&s[ 0]), _mm256_loadu_ps(&s[ 8]));
+    const __m256 m2 = _mm256_min_ps(_mm256_loadu_ps(&s[16]), _mm256_blend_ps(s24, _mm256_permute_ps(s24, _MM_SHUFFLE(2, 2, 1, 0)), 0x80));
+    const __m256 m3 = _mm256_min_ps(m1, m2);
+          __m128 m  = _mm_min_ps(_mm256_castps256_ps128(m3), _mm256_extractf128_ps(m3, 1));
+#else
     const __m128 m1 = _mm_min_ps(_mm_load_ps(&s[ 0]), _mm_load_ps(&s[ 4]));
     const __m128 m2 = _mm_min_ps(_mm_load_ps(&s[ 8]), _mm_load_ps(&s[12]));
     const __m128 m3 = _mm_min_ps(_mm_load_ps(&s[16]), _mm_load_ps(&s[20]));
@@ -707,6 +864,7 @@ inline float min_value(const RegularSpectrum<float, 31>& s)
     const __m128 m5 = _mm_min_ps(m1, m2);
     const __m128 m6 = _mm_min_ps(m3, m4);
           __m128 m  = _mm_min_ps(m5, m6);
+#endif
 
     m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
     m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
@@ -735,6 +893,14 @@ inline T max_value(const RegularSpectrum<T, N>& s)
 template <>
 inline float max_value(const RegularSpectrum<float, 31>& s)
 {
+#ifdef APPLESEED_USE_AVX
+    // Replace the padding sample by a duplicate of the last sample.
+    const __m256 s24 = _mm256_loadu_ps(&s[24]);
+    const __m256 m1 = _mm256_max_ps(_mm256_loadu_ps(&s[ 0]), _mm256_loadu_ps(&s[ 8]));
+    const __m256 m2 = _mm256_max_ps(_mm256_loadu_ps(&s[16]), _mm256_blend_ps(s24, _mm256_permute_ps(s24, _MM_SHUFFLE(2, 2, 1, 0)), 0x80));
+    const __m256 m3 = _mm256_max_ps(m1, m2);
+          __m128 m  = _mm_max_ps(_mm256_castps256_ps128(m3), _mm256_extractf128_ps(m3, 1));
+#else
     const __m128 m1 = _mm_max_ps(_mm_load_ps(&s[ 0]), _mm_load_ps(&s[ 4]));
     const __m128 m2 = _mm_max_ps(_mm_load_ps(&s[ 8]), _mm_load_ps(&s[12]));
     const __m128 m3 = _mm_max_ps(_mm_load_ps(&s[16]), _mm_load_ps(&s[20]));
@@ -743,6 +909,7 @@ inline float max_value(const RegularSpectrum<float, 31>& s)
     const __m128 m5 = _mm_max_ps(m1, m2);
     const __m128 m6 = _mm_max_ps(m3, m4);
           __m128 m  = _mm_max_ps(m5, m6);
+#endif
 
     m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
     m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
@@ -865,6 +1032,38 @@ inline T sum_value(const RegularSpectrum<T, N>& s)
     return sum;
 }
 
+#ifdef APPLESEED_USE_SSE
+
+template <>
+inline float sum_value(const RegularSpectrum<float, 31>& s)
+{
+#ifdef APPLESEED_USE_AVX
+    // Mask out the padding sample.
+    const __m256 s24 = _mm256_blend_ps(_mm256_loadu_ps(&s[24]), _mm256_setzero_ps(), 0x80);
+    const __m256 m1 = _mm256_add_ps(_mm256_loadu_ps(&s[ 0]), _mm256_loadu_ps(&s[ 8]));
+    const __m256 m2 = _mm256_add_ps(_mm256_loadu_ps(&s[16]), s24);
+    const __m256 m3 = _mm256_add_ps(m1, m2);
+          __m128 m  = _mm_add_ps(_mm256_castps256_ps128(m3), _mm256_extractf128_ps(m3, 1));
+#else
+    // Mask out the padding sample.
+    const __m128 s28 = _mm_and_ps(_mm_load_ps(&s[28]), _mm_castsi128_ps(_mm_set_epi32(0, ~0, ~0, ~0)));
+    const __m128 m1 = _mm_add_ps(_mm_load_ps(&s[ 0]), _mm_load_ps(&s[ 4]));
+    const __m128 m2 = _mm_add_ps(_mm_load_ps(&s[ 8]), _mm_load_ps(&s[12]));
+    const __m128 m3 = _mm_add_ps(_mm_load_ps(&s[16]), _mm_load_ps(&s[20]));
+    const __m128 m4 = _mm_add_ps(_mm_load_ps(&s[24]), s28);
+    const __m128 m5 = _mm_add_ps(m1, m2);
+    const __m128 m6 = _mm_add_ps(m3, m4);
+          __m128 m  = _mm_add_ps(m5, m6);
+#endif
+
+    m = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    m = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+
+    return _mm_cvtss_f32(m);
+}
+
+#endif  // APPLESEED_USE_SSE
+
 template <typename T, size_t N>
 inline T average_value(const RegularSpectrum<T, N>& s)
 {
@@ -32,10 +32,14 @@
 // appleseed.foundation headers.
 #include "foundation/math/scalar.h"
 #include "foundation/math/specialfunctions.h"
+#ifdef APPLESEED_USE_SSE
+#include "foundation/platform/sse.h"
+#endif
 
 // Standard headers.
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 
 using namespace std;
 
@@ -192,6 +196,22 @@ MDF::~MDF()
 {
 }
 
+void MDF::evaluate(
+    const Vector3f&     incoming,
+    const Vector3f&     outgoing,
+    const Vector3f&     m,
+    const float         alpha_x,
+    const float         alpha_y,
+    const float         gamma,
+    float&              d,
+    float&              g,
+    float&              pdf) const
+{
+    d = D(m, alpha_x, alpha_y, gamma);
+    g = G(incoming, outgoing, m, alpha_x, alpha_y, gamma);
+    pdf = this->pdf(outgoing, m, alpha_x, alpha_y, gamma);
+}
+
 
 //
 // BlinnMDF class implementation.
@@ -596,6 +616,76 @@ float GGXMDF::pdf(
     return pdf_visible_normals(*this, v, h, alpha_x, alpha_y, gamma);
 }
 
+void GGXMDF::evaluate(
+    const Vector3f&     incoming,
+    const Vector3f&     outgoing,
+    const Vector3f&     m,
+    const float         alpha_x,
+    const float         alpha_y,
+    const float         gamma,
+    float&              d,
+    float&              g,
+    float&              pdf) const
+{
+    // Grazing configurations are handled by the special cases of D(), lambda() and pdf().
+    if (m.y == 0.0f || incoming.y == 0.0f || outgoing.y == 0.0f)
+    {
+        MDF::evaluate(incoming, outgoing, m, alpha_x, alpha_y, gamma, d, g, pdf);
+        return;
+    }
+
+    //
+    // D() and lambda() both depend on the quantity
+    //
+    //   t = (v.x^2 * sx + v.z^2 * sz) / v.y^2
+    //
+    // with (sx, sz) = (1 / alpha_x^2, 1 / alpha_y^2) for D() and (alpha_x^2, alpha_y^2)
+    // for lambda(). We compute it for m, incoming and outgoing in lanes 0, 1 and 2.
+    //
+
+    const float alpha_x_2 = square(alpha_x);
+    const float alpha_y_2 = square(alpha_y);
+
+    float u[4], r[4];
+
+#ifdef APPLESEED_USE_SSE
+
+    const __m128 x = _mm_set_ps(0.0f, outgoing.x, incoming.x, m.x);
+    const __m128 y = _mm_set_ps(1.0f, outgoing.y, incoming.y, m.y);
+    const __m128 z = _mm_set_ps(0.0f, outgoing.z, incoming.z, m.z);
+    const __m128 sx = _mm_set_ps(0.0f, alpha_x_2, alpha_x_2, 1.0f / alpha_x_2);
+    const __m128 sz = _mm_set_ps(0.0f, alpha_y_2, alpha_y_2, 1.0f / alpha_y_2);
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 num = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(x, x), sx), _mm_mul_ps(_mm_mul_ps(z, z), sz));
+    const __m128 t = _mm_div_ps(num, _mm_mul_ps(y, y));
+    const __m128 vu = _mm_add_ps(one, t);
+
+    _mm_storeu_ps(u, vu);
+    _mm_storeu_ps(r, _mm_sqrt_ps(vu));
+
+#else
+
+    const Vector3f* v[3] = { &m, &incoming, &outgoing };
+    const float sx[3] = { 1.0f / alpha_x_2, alpha_x_2, alpha_x_2 };
+    const float sz[3] = { 1.0f / alpha_y_2, alpha_y_2, alpha_y_2 };
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        u[i] = 1.0f + (square(v[i]->x) * sx[i] + square(v[i]->z) * sz[i]) / square(v[i]->y);
+        r[i] = sqrt(u[i]);
+    }
+
+#endif
+
+    const float lambda_i = (r[1] - 1.0f) * 0.5f;
+    const float lambda_o = (r[2] - 1.0f) * 0.5f;
+
+    d = 1.0f / (Pi<float>() * alpha_x * alpha_y * square(square(m.y)) * square(u[0]));
+    g = 1.0f / (1.0f + lambda_i + lambda_o);
+    pdf = abs(dot(outgoing, m)) * d / ((1.0f + lambda_o) * abs(outgoing.y));
+}
+
 
 //
 // WardMDF class implementation.
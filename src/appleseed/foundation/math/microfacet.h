@@ -84,6 +84,19 @@ class MDF
         const float         alpha_x,
         const float         alpha_y,
         const float         gamma) const = 0;
+
+    // Compute D(m), G(incoming, outgoing, m) and pdf(outgoing, m) in one call.
+    // Distributions may override this method to share work between the three terms.
+    virtual void evaluate(
+        const Vector3f&     incoming,
+        const Vector3f&     outgoing,
+        const Vector3f&     m,
+        const float         alpha_x,
+        const float         alpha_y,
+        const float         gamma,
+        float&              d,
+        float&              g,
+        float&              pdf) const;
 };
 
 
@@ -287,6 +300,19 @@ class GGXMDF
         const float         alpha_x,
         const float         alpha_y,
         const float         gamma) const;
+
+    // The distribution term and the two masking terms are evaluated together,
+    // one per SIMD lane, and the terms shared by D, G and pdf are computed once.
+    virtual void evaluate(
+        const Vector3f&     incoming,
+        const Vector3f&     outgoing,
+        const Vector3f&     m,
+        const float         alpha_x,
+        const float         alpha_y,
+        const float         gamma,
+        float&              d,
+        float&              g,
+        float&              pdf) const override;
 };
 
 
@@ -297,4 +297,38 @@ const double PrecomputedHaltonSequence[4 * PrecomputedHaltonSequenceSize] =
     0.9960937500000000, 0.1495198902606310, 0.0432000000000000, 0.4635568513119533
 };
 
+
+//
+// Generator matrices of the first dimensions of the Sobol sequence, using the
+// direction numbers of Joe and Kuo (new-joe-kuo-6.21201).
+//
+
+const uint32 SobolMatrices[SobolMatrixCount][32] =
+{
+    {
+        0x80000000UL, 0x40000000UL, 0x20000000UL, 0x10000000UL, 0x08000000UL, 0x04000000UL, 0x02000000UL, 0x01000000UL,
+        0x00800000UL, 0x00400000UL, 0x00200000UL, 0x00100000UL, 0x00080000UL, 0x00040000UL, 0x00020000UL, 0x00010000UL,
+        0x00008000UL, 0x00004000UL, 0x00002000UL, 0x00001000UL, 0x00000800UL, 0x00000400UL, 0x00000200UL, 0x00000100UL,
+        0x00000080UL, 0x00000040UL, 0x00000020UL, 0x00000010UL, 0x00000008UL, 0x00000004UL, 0x00000002UL, 0x00000001UL
+    },
+    {
+        0x80000000UL, 0xC0000000UL, 0xA0000000UL, 0xF0000000UL, 0x88000000UL, 0xCC000000UL, 0xAA000000UL, 0xFF000000UL,
+        0x80800000UL, 0xC0C00000UL, 0xA0A00000UL, 0xF0F00000UL, 0x88880000UL, 0xCCCC0000UL, 0xAAAA0000UL, 0xFFFF0000UL,
+        0x80008000UL, 0xC000C000UL, 0xA000A000UL, 0xF000F000UL, 0x88008800UL, 0xCC00CC00UL, 0xAA00AA00UL, 0xFF00FF00UL,
+        0x80808080UL, 0xC0C0C0C0UL, 0xA0A0A0A0UL, 0xF0F0F0F0UL, 0x88888888UL, 0xCCCCCCCCUL, 0xAAAAAAAAUL, 0xFFFFFFFFUL
+    },
+    {
+        0x80000000UL, 0xC0000000UL, 0x60000000UL, 0x90000000UL, 0xE8000000UL, 0x5C000000UL, 0x8E000000UL, 0xC5000000UL,
+        0x68800000UL, 0x9CC00000UL, 0xEE600000UL, 0x55900000UL, 0x80680000UL, 0xC09C0000UL, 0x60EE0000UL, 0x90550000UL,
+        0xE8808000UL, 0x5CC0C000UL, 0x8E606000UL, 0xC5909000UL, 0x6868E800UL, 0x9C9C5C00UL, 0xEEEE8E00UL, 0x5555C500UL,
+        0x8000E880UL, 0xC0005CC0UL, 0x60008E60UL, 0x9000C590UL, 0xE8006868UL, 0x5C009C9CUL, 0x8E00EEEEUL, 0xC5005555UL
+    },
+    {
+        0x80000000UL, 0xC0000000UL, 0x20000000UL, 0x50000000UL, 0xF8000000UL, 0x74000000UL, 0xA2000000UL, 0x93000000UL,
+        0xD8800000UL, 0x25400000UL, 0x59E00000UL, 0xE6D00000UL, 0x78080000UL, 0xB40C0000UL, 0x82020000UL, 0xC3050000UL,
+        0x208F8000UL, 0x51474000UL, 0xFBEA2000UL, 0x75D93000UL, 0xA0858800UL, 0x914E5400UL, 0xDBE79E00UL, 0x25DB6D00UL,
+        0x58800080UL, 0xE54000C0UL, 0x79E00020UL, 0xB6D00050UL, 0x800800F8UL, 0xC00C0074UL, 0x200200A2UL, 0x50050093UL
+    }
+};
+
 }   // namespace foundation
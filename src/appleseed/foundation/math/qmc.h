@@ -31,6 +31,7 @@
 #define APPLESEED_FOUNDATION_MATH_QMC_H
 
 // appleseed.foundation headers.
+#include "foundation/math/hash.h"
 #include "foundation/math/vector.h"
 #include "foundation/platform/arch.h"
 #include "foundation/platform/types.h"
@@ -53,7 +54,6 @@ namespace foundation
 //   implement specializations of Halton and Hammersley sequences generators for bases (2,3).
 //   implement incremental radical inverse (for successive input values).
 //   implement vectorized radical inverse functions with SSE2.
-//   implement Sobol sequence generator.
 //
 
 
@@ -200,6 +200,47 @@ Vector<T, Dim> hammersley_zaremba_sequence(
     const size_t        i);             // sample number
 
 
+//
+// Owen-scrambled Sobol sequences.
+//
+// Only the first SobolMatrixCount dimensions of the Sobol sequence are available.
+// Higher-dimensional sampling is achieved by padding: independent low-dimensional
+// sequences are decorrelated by shuffling their sample numbers with distinct seeds.
+//
+// References:
+//
+//   Joe and Kuo, Constructing Sobol sequences with better two-dimensional projections
+//   https://web.maths.unsw.edu.au/~fkuo/sobol/joe-kuo-notes.pdf
+//
+//   Burley, Practical Hash-based Owen Scrambling
+//   http://www.jcgt.org/published/0009/04/01/
+//
+
+// Generator matrices of the first dimensions of the Sobol sequence.
+const size_t SobolMatrixCount = 4;
+extern const uint32 SobolMatrices[SobolMatrixCount][32];
+
+// Reverse the order of the bits of a 32-bit integer.
+uint32 reverse_bits(
+    uint32              value);
+
+// Return the i'th sample of a given dimension of the Sobol sequence, in 0.32 fixed point.
+uint32 sobol_uint32(
+    const size_t        dimension,      // dimension, must be lower than SobolMatrixCount
+    uint32              i);             // sample number
+
+// Apply a hash-based approximation of a random base-2 Owen scrambling to a value in 0.32 fixed point.
+uint32 owen_scramble_uint32(
+    const uint32        value,          // input value
+    const uint32        seed);          // scrambling seed
+
+// Return the i'th sample of an Owen-scrambled and shuffled Sobol sequence.
+template <typename T, size_t Dim>
+Vector<T, Dim> owen_scrambled_sobol_sequence(
+    const uint32        seed,           // scrambling seed
+    const uint32        i);             // sample number
+
+
 //
 // Base-2 radical inverse functions implementation.
 //
@@ -2522,6 +2563,83 @@ inline Vector<T, Dim> halton_zaremba_sequence(
 }
 
 
+//
+// Owen-scrambled Sobol sequences implementation.
+//
+
+inline uint32 reverse_bits(
+    uint32              value)
+{
+    value = (value >> 16) | (value << 16);                                                      // 16-bit swap
+    value = ((value & 0xFF00FF00UL) >> 8) | ((value & 0x00FF00FFUL) << 8);                      // 8-bit swap
+    value = ((value & 0xF0F0F0F0UL) >> 4) | ((value & 0x0F0F0F0FUL) << 4);                      // 4-bit swap
+    value = ((value & 0xCCCCCCCCUL) >> 2) | ((value & 0x33333333UL) << 2);                      // 2-bit swap
+    value = ((value & 0xAAAAAAAAUL) >> 1) | ((value & 0x55555555UL) << 1);                      // 1-bit swap
+    return value;
+}
+
+inline uint32 sobol_uint32(
+    const size_t        dimension,
+    uint32              i)
+{
+    assert(dimension < SobolMatrixCount);
+
+    const uint32* matrix = SobolMatrices[dimension];
+    uint32 result = 0;
+
+    for (; i != 0; i >>= 1, ++matrix)
+    {
+        if (i & 1)
+            result ^= *matrix;
+    }
+
+    return result;
+}
+
+inline uint32 owen_scramble_uint32(
+    const uint32        value,
+    const uint32        seed)
+{
+    // The Laine-Karras permutation only propagates changes from low to high bits.
+    // Applying it to the reversed value makes each bit depend on all the bits above
+    // it, which is the structure of a base-2 Owen scrambling.
+    uint32 x = reverse_bits(value);
+    x += seed;
+    x ^= x * 0x6C50B47CUL;
+    x ^= x * 0xB82F1E52UL;
+    x ^= x * 0xC7AFE638UL;
+    x ^= x * 0x8D22F6E6UL;
+    return reverse_bits(x);
+}
+
+template <typename T, size_t Dim>
+inline Vector<T, Dim> owen_scrambled_sobol_sequence(
+    const uint32        seed,
+    const uint32        i)
+{
+    static_assert(Dim <= SobolMatrixCount, "Not enough Sobol generator matrices");
+
+    // Shuffle the sample number. This preserves the stratification of blocks of
+    // consecutive samples aligned on powers of two.
+    const uint32 index = owen_scramble_uint32(i, seed);
+
+    Vector<T, Dim> p;
+
+    for (size_t d = 0; d < Dim; ++d)
+    {
+        const uint32 x =
+            owen_scramble_uint32(
+                sobol_uint32(d, index),
+                mix_uint32(seed, static_cast<uint32>(d)));
+
+        // Keep 24 bits so that the result is strictly lower than 1 in single precision.
+        p[d] = static_cast<T>(x >> 8) * T(1.0 / 16777216.0);
+    }
+
+    return p;
+}
+
+
 //
 // Hammersley sequences implementation.
 //
@@ -0,0 +1,226 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_FOUNDATION_MATH_RNG_SIMDXOROSHIRO128PLUS_H
+#define APPLESEED_FOUNDATION_MATH_RNG_SIMDXOROSHIRO128PLUS_H
+
+// appleseed.foundation headers.
+#include "foundation/math/scalar.h"
+#include "foundation/platform/compiler.h"
+#ifdef APPLESEED_USE_SSE
+#include "foundation/platform/sse.h"
+#endif
+#include "foundation/platform/types.h"
+
+// Standard headers.
+#include <cassert>
+#include <cstddef>
+
+namespace foundation
+{
+
+//
+// Four interleaved Xoroshiro128+ random number generators, advanced together with
+// SSE2 and buffered: random numbers are produced in batches of BufferSize values
+// and then handed out one at a time.
+//
+// The four streams are seeded from a single 128-bit seed using SplitMix64.
+// Seeding is deferred until the first batch is generated, so that reseeding
+// a generator (or constructing one) is cheap even if it ends up unused.
+// The sequence of numbers is identical with and without SSE.
+//
+// References:
+//
+//   http://xoroshiro.di.unimi.it/
+//   http://xoroshiro.di.unimi.it/splitmix64.c
+//
+
+class SimdXoroshiro128plus
+{
+  public:
+    // Number of interleaved generators.
+    static const size_t LaneCount = 4;
+
+    // Number of random numbers generated per batch.
+    static const size_t BufferSize = 4 * LaneCount;
+
+    // Constructors, seed the generator.
+    SimdXoroshiro128plus();
+    explicit SimdXoroshiro128plus(const uint64 s0, const uint64 s1);
+
+    // Reseed the generator. Equivalent to constructing a new one with this seed.
+    void reseed(const uint64 s0, const uint64 s1);
+
+    // Generate a 32-bit random number.
+    uint32 rand_uint32();
+
+  private:
+    APPLESEED_SIMD4_ALIGN uint64 m_s0[LaneCount];
+    APPLESEED_SIMD4_ALIGN uint64 m_s1[LaneCount];
+    APPLESEED_SIMD4_ALIGN uint32 m_buffer[BufferSize];
+    size_t m_index;
+    uint64 m_seed[2];
+    bool m_seed_pending;
+
+    static uint64 splitmix64(uint64& x);
+
+    // Derive the state of the four streams from the pending seed.
+    void seed();
+
+    // Generate a new batch of random numbers.
+    void refill();
+};
+
+
+//
+// SimdXoroshiro128plus class implementation.
+//
+
+inline SimdXoroshiro128plus::SimdXoroshiro128plus()
+{
+    reseed(0x46961B5E381BCE6EULL, 0x55897310023CAE21ULL);
+}
+
+inline SimdXoroshiro128plus::SimdXoroshiro128plus(const uint64 s0, const uint64 s1)
+{
+    reseed(s0, s1);
+}
+
+inline void SimdXoroshiro128plus::reseed(const uint64 s0, const uint64 s1)
+{
+    m_seed[0] = s0;
+    m_seed[1] = s1;
+    m_seed_pending = true;
+    m_index = BufferSize;
+}
+
+inline uint32 SimdXoroshiro128plus::rand_uint32()
+{
+    if (m_index == BufferSize)
+        refill();
+
+    return m_buffer[m_index++];
+}
+
+inline uint64 SimdXoroshiro128plus::splitmix64(uint64& x)
+{
+    uint64 z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+inline void SimdXoroshiro128plus::seed()
+{
+    uint64 x = m_seed[0] ^ rotl64(m_seed[1], 32);
+
+    for (size_t i = 0; i < LaneCount; ++i)
+    {
+        m_s0[i] = splitmix64(x);
+        m_s1[i] = splitmix64(x);
+
+        if (m_s0[i] == 0 && m_s1[i] == 0)
+            m_s0[i] = 1;
+    }
+
+    m_seed_pending = false;
+}
+
+inline void SimdXoroshiro128plus::refill()
+{
+    if (m_seed_pending)
+        seed();
+
+#ifdef APPLESEED_USE_SSE
+
+    // Lanes 0 and 1 are in the first register, lanes 2 and 3 in the second one.
+    // Use unaligned accesses: generators may be members of heap-allocated objects.
+    __m128i s0a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_s0));
+    __m128i s0b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_s0 + 2));
+    __m128i s1a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_s1));
+    __m128i s1b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_s1 + 2));
+
+    #define APPLESEED_XOROSHIRO128PLUS_STEP(s0, s1)                                         \
+        s1 = _mm_xor_si128(s1, s0);                                                         \
+        s0 = _mm_xor_si128(                                                                 \
+                _mm_xor_si128(                                                              \
+                    _mm_or_si128(_mm_slli_epi64(s0, 55), _mm_srli_epi64(s0, 9)),            \
+                    s1),                                                                    \
+                _mm_slli_epi64(s1, 14));                                                    \
+        s1 = _mm_or_si128(_mm_slli_epi64(s1, 36), _mm_srli_epi64(s1, 28))
+
+    for (size_t i = 0; i < BufferSize; i += LaneCount)
+    {
+        // Keep the high 32 bits of each sum.
+        const __m128i ra = _mm_add_epi64(s0a, s1a);
+        const __m128i rb = _mm_add_epi64(s0b, s1b);
+        const __m128i r =
+            _mm_castps_si128(
+                _mm_shuffle_ps(
+                    _mm_castsi128_ps(ra),
+                    _mm_castsi128_ps(rb),
+                    _MM_SHUFFLE(3, 1, 3, 1)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(m_buffer + i), r);
+
+        APPLESEED_XOROSHIRO128PLUS_STEP(s0a, s1a);
+        APPLESEED_XOROSHIRO128PLUS_STEP(s0b, s1b);
+    }
+
+    #undef APPLESEED_XOROSHIRO128PLUS_STEP
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(m_s0), s0a);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(m_s0 + 2), s0b);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(m_s1), s1a);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(m_s1 + 2), s1b);
+
+#else
+
+    for (size_t i = 0; i < BufferSize; i += LaneCount)
+    {
+        for (size_t j = 0; j < LaneCount; ++j)
+        {
+            const uint64 s0 = m_s0[j];
+            uint64 s1 = m_s1[j];
+
+            m_buffer[i + j] = static_cast<uint32>((s0 + s1) >> 32);
+
+            s1 ^= s0;
+            m_s0[j] = rotl64(s0, 55) ^ s1 ^ (s1 << 14);     // a, b
+            m_s1[j] = rotl64(s1, 36);                       // c
+        }
+    }
+
+#endif
+
+    m_index = 0;
+}
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_MATH_RNG_SIMDXOROSHIRO128PLUS_H
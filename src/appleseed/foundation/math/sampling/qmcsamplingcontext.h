@@ -31,11 +31,13 @@
 #define APPLESEED_FOUNDATION_MATH_SAMPLING_QMCSAMPLINGCONTEXT_H
 
 // appleseed.foundation headers.
+#include "foundation/math/hash.h"
 #include "foundation/math/permutation.h"
 #include "foundation/math/primes.h"
 #include "foundation/math/qmc.h"
 #include "foundation/math/rng/distribution.h"
 #include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
 #include "foundation/utility/test/helpers.h"
 
 // Standard headers.
@@ -59,11 +61,19 @@ namespace foundation
 //   - Cranley-Patterson rotation
 //   - Monte Carlo padding
 //
-// Reference:
+// or alternatively:
+//
+//   - deterministic sampling based on Owen-scrambled Sobol sequences
+//   - padding by sample number shuffling
+//
+// References:
 //
 //   Kollig and Keller, Efficient Multidimensional Sampling
 //   www.uni-kl.de/AG-Heinrich/EMS.pdf
 //
+//   Burley, Practical Hash-based Owen Scrambling
+//   http://www.jcgt.org/published/0009/04/01/
+//
 
 template <typename RNG>
 class QMCSamplingContext
@@ -72,10 +82,14 @@ class QMCSamplingContext
     // Random number generator type.
     typedef RNG RNGType;
 
-    // This sampler can operate in two modes:
+    // This sampler can operate in the following modes:
     //   1. In QMC mode, it uses possibly patent-encumbered techniques.
     //   2. In RNG mode, it works like RNGSamplingContext and sticks to random sampling.
-    enum Mode { QMCMode, RNGMode };
+    //   3. In Sobol mode, it uses Owen-scrambled Sobol sequences. Each split gets its own
+    //      sequence, decorrelated from the others by shuffling its sample numbers.
+    //   4. Blue noise Sobol mode behaves like Sobol mode. It tells pixel renderers to
+    //      assign sample numbers to pixels such that the error is distributed as blue noise.
+    enum Mode { QMCMode, RNGMode, SobolMode, BlueNoiseSobolMode };
 
     // Construct a sampling context of dimension 0. It cannot be used
     // directly; only child contexts obtained by splitting can.
@@ -370,6 +384,14 @@ inline Vector<T, N> QMCSamplingContext<RNG>::next2(Tag<Vector<T, N>>)
             }
         }
     }
+    else if (m_mode == SobolMode || m_mode == BlueNoiseSobolMode)
+    {
+        // The sample number of the parent path selects the point of the sequence,
+        // the dimension allocated to this split selects the scrambling.
+        v = owen_scrambled_sobol_sequence<T, N>(
+                hash_uint32(static_cast<uint32>(m_base_dimension)),
+                static_cast<uint32>(m_base_instance + m_instance));
+    }
     else
     {
         for (size_t i = 0; i < N; ++i)
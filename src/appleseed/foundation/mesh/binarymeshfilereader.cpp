@@ -34,14 +34,23 @@
 #include "foundation/core/exceptions/exception.h"
 #include "foundation/core/exceptions/exceptionioerror.h"
 #include "foundation/math/vector.h"
+#include "foundation/mesh/binarymeshformat.h"
 #include "foundation/mesh/imeshbuilder.h"
+#include "foundation/platform/memorymappedfile.h"
+#include "foundation/platform/system.h"
+#include "foundation/platform/thread.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/bufferedfile.h"
 #include "foundation/utility/memory.h"
 
+// lz4 headers.
+#include "lz4.h"
+
 // Standard headers.
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 using namespace std;
 
@@ -76,6 +85,118 @@ namespace
     {
         checked_read(file, &object, sizeof(T));
     }
+
+    // Sequential reader over a memory buffer, with bounds checking.
+    class BoundedMemoryReader
+    {
+      public:
+        BoundedMemoryReader(const uint8* data, const size_t size)
+          : m_data(data)
+          , m_size(size)
+          , m_offset(0)
+        {
+        }
+
+        size_t read(void* outbuf, const size_t size)
+        {
+            const size_t bytes_read = min(size, m_size - m_offset);
+
+            if (bytes_read > 0)
+            {
+                memcpy(outbuf, m_data + m_offset, bytes_read);
+                m_offset += bytes_read;
+            }
+
+            return bytes_read;
+        }
+
+        void seek(const size_t offset)
+        {
+            m_offset = min(offset, m_size);
+        }
+
+      private:
+        const uint8*    m_data;
+        const size_t    m_size;
+        size_t          m_offset;
+    };
+
+    // Copy or decompress a data block to its final location.
+    struct BlockDecodingTask
+    {
+        const uint8*    m_source;
+        size_t          m_source_size;
+        uint8*          m_dest;
+        size_t          m_dest_size;
+        bool            m_compressed;
+        bool            m_success;
+
+        void execute()
+        {
+            if (m_compressed)
+            {
+                const int decompressed_size =
+                    LZ4_decompress_safe(
+                        reinterpret_cast<const char*>(m_source),
+                        reinterpret_cast<char*>(m_dest),
+                        static_cast<int>(m_source_size),
+                        static_cast<int>(m_dest_size));
+
+                m_success = decompressed_size == static_cast<int>(m_dest_size);
+            }
+            else
+            {
+                memcpy(m_dest, m_source, m_dest_size);
+                m_success = true;
+            }
+        }
+    };
+
+    // Execute every step-th task of a list of tasks, starting with a given one.
+    struct BlockDecodingWorker
+    {
+        vector<BlockDecodingTask>*  m_tasks;
+        size_t                      m_first;
+        size_t                      m_step;
+
+        void operator()()
+        {
+            for (size_t i = m_first; i < m_tasks->size(); i += m_step)
+                (*m_tasks)[i].execute();
+        }
+    };
+
+    void execute_block_decoding_tasks(vector<BlockDecodingTask>& tasks)
+    {
+        // Only spawn threads if there is enough work to amortize their creation.
+        size_t total_size = 0;
+        for (size_t i = 0; i < tasks.size(); ++i)
+            total_size += tasks[i].m_dest_size;
+
+        const size_t thread_count =
+            total_size >= 2 * BinaryMeshMaxBlockSize
+                ? min(tasks.size(), System::get_logical_cpu_core_count())
+                : 1;
+
+        boost::thread_group threads;
+
+        for (size_t i = 1; i < thread_count; ++i)
+        {
+            BlockDecodingWorker worker = { &tasks, i, thread_count };
+            threads.create_thread(worker);
+        }
+
+        BlockDecodingWorker worker = { &tasks, 0, thread_count };
+        worker();
+
+        threads.join_all();
+
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            if (!tasks[i].m_success)
+                throw ExceptionIOError("corrupted binarymesh data block");
+        }
+    }
 }
 
 BinaryMeshFileReader::BinaryMeshFileReader(const string& filename)
@@ -98,6 +219,15 @@ void BinaryMeshFileReader::read(IMeshBuilder& builder)
     uint16 version;
     checked_read(file, version);
 
+    // Version 4 files are memory-mapped rather than streamed.
+    if (version == 4)
+    {
+        const int64 data_offset = file.tell();
+        file.close();
+        read_memory_mapped_meshes(static_cast<size_t>(data_offset), builder);
+        return;
+    }
+
     auto_ptr<ReaderAdapter> reader;
 
     switch (version)
@@ -280,4 +410,237 @@ void BinaryMeshFileReader::read_face(ReaderAdapter& reader, IMeshBuilder& builde
     builder.end_face();
 }
 
+void BinaryMeshFileReader::read_memory_mapped_meshes(const size_t data_offset, IMeshBuilder& builder)
+{
+    const MemoryMappedFile file(m_filename.c_str());
+    BoundedMemoryReader reader(file.get_data(), file.get_size());
+    reader.seek(data_offset);
+
+    try
+    {
+        while (true)
+        {
+            // Read the name of the next mesh.
+            string mesh_name;
+            try
+            {
+                uint16 length;
+                checked_read(reader, length);
+                mesh_name.resize(length);
+                checked_read(reader, &mesh_name[0], length);
+            }
+            catch (const ExceptionEOF&)
+            {
+                // Expected EOF.
+                break;
+            }
+
+            // Read the block index.
+            uint32 block_count;
+            checked_read(reader, block_count);
+
+            vector<BinaryMeshBlockInfo> blocks(block_count);
+            uint64 next_mesh_offset = 0;
+
+            for (uint32 i = 0; i < block_count; ++i)
+            {
+                BinaryMeshBlockInfo& info = blocks[i];
+                checked_read(reader, info.m_type);
+                checked_read(reader, info.m_flags);
+                checked_read(reader, info.m_offset);
+                checked_read(reader, info.m_stored_size);
+                checked_read(reader, info.m_size);
+
+                if (info.m_type >= BinaryMeshBlockTypeCount ||
+                    info.m_offset > file.get_size() ||
+                    info.m_stored_size > file.get_size() - info.m_offset)
+                    throw ExceptionIOError("invalid binarymesh block index");
+
+                next_mesh_offset = max(next_mesh_offset, info.m_offset + info.m_stored_size);
+            }
+
+            read_memory_mapped_mesh(file, mesh_name, blocks, builder);
+
+            reader.seek(static_cast<size_t>(next_mesh_offset));
+        }
+    }
+    catch (const ExceptionEOF&)
+    {
+        // Unexpected EOF.
+        throw ExceptionIOError();
+    }
+}
+
+void BinaryMeshFileReader::read_memory_mapped_mesh(
+    const MemoryMappedFile&             file,
+    const string&                       mesh_name,
+    const vector<BinaryMeshBlockInfo>&  blocks,
+    IMeshBuilder&                       builder)
+{
+    // Compute the size of each array.
+    size_t array_sizes[BinaryMeshBlockTypeCount] = { 0 };
+    size_t array_block_counts[BinaryMeshBlockTypeCount] = { 0 };
+
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        array_sizes[blocks[i].m_type] += static_cast<size_t>(blocks[i].m_size);
+        ++array_block_counts[blocks[i].m_type];
+    }
+
+    // Arrays stored in a single uncompressed block are used in place; the other ones
+    // are assembled from their blocks, decompressing them in parallel if necessary.
+    const uint8* arrays[BinaryMeshBlockTypeCount] = { 0 };
+    vector<uint8> array_storage[BinaryMeshBlockTypeCount];
+    size_t array_offsets[BinaryMeshBlockTypeCount] = { 0 };
+    vector<BlockDecodingTask> tasks;
+
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        const BinaryMeshBlockInfo& info = blocks[i];
+        const bool compressed = (info.m_flags & BinaryMeshBlockLZ4Compressed) != 0;
+        const uint8* source = file.get_data() + info.m_offset;
+
+        if (!compressed && info.m_stored_size != info.m_size)
+            throw ExceptionIOError("invalid binarymesh block index");
+
+        if (array_block_counts[info.m_type] == 1 && !compressed)
+        {
+            arrays[info.m_type] = source;
+            continue;
+        }
+
+        vector<uint8>& storage = array_storage[info.m_type];
+        if (storage.empty())
+        {
+            storage.resize(array_sizes[info.m_type]);
+            arrays[info.m_type] = &storage[0];
+        }
+
+        BlockDecodingTask task;
+        task.m_source = source;
+        task.m_source_size = static_cast<size_t>(info.m_stored_size);
+        task.m_dest = &storage[0] + array_offsets[info.m_type];
+        task.m_dest_size = static_cast<size_t>(info.m_size);
+        task.m_compressed = compressed;
+        task.m_success = false;
+        tasks.push_back(task);
+
+        array_offsets[info.m_type] += task.m_dest_size;
+    }
+
+    execute_block_decoding_tasks(tasks);
+
+    // Check the consistency of the arrays.
+    const size_t vertex_count = array_sizes[BinaryMeshVertexBlock] / sizeof(Vector3f);
+    const size_t vertex_normal_count = array_sizes[BinaryMeshVertexNormalBlock] / sizeof(Vector3f);
+    const size_t tex_coords_count = array_sizes[BinaryMeshTexCoordsBlock] / sizeof(Vector2f);
+    const size_t face_count = array_sizes[BinaryMeshFaceVertexCountBlock] / sizeof(uint16);
+    const size_t face_vertex_count = array_sizes[BinaryMeshFaceVertexBlock] / sizeof(uint32);
+
+    const uint16* face_vertex_counts = reinterpret_cast<const uint16*>(arrays[BinaryMeshFaceVertexCountBlock]);
+    const uint32* face_vertices = reinterpret_cast<const uint32*>(arrays[BinaryMeshFaceVertexBlock]);
+    const uint32* face_vertex_normals = reinterpret_cast<const uint32*>(arrays[BinaryMeshFaceVertexNormalBlock]);
+    const uint32* face_tex_coords = reinterpret_cast<const uint32*>(arrays[BinaryMeshFaceTexCoordsBlock]);
+    const uint16* face_materials = reinterpret_cast<const uint16*>(arrays[BinaryMeshFaceMaterialBlock]);
+
+    size_t expected_face_vertex_count = 0;
+    bool degenerate_face = false;
+    for (size_t i = 0; i < face_count; ++i)
+    {
+        expected_face_vertex_count += face_vertex_counts[i];
+        degenerate_face = degenerate_face || face_vertex_counts[i] < 3;
+    }
+
+    if (array_sizes[BinaryMeshVertexBlock] % sizeof(Vector3f) != 0 ||
+        array_sizes[BinaryMeshVertexNormalBlock] % sizeof(Vector3f) != 0 ||
+        array_sizes[BinaryMeshTexCoordsBlock] % sizeof(Vector2f) != 0 ||
+        array_sizes[BinaryMeshFaceVertexCountBlock] % sizeof(uint16) != 0 ||
+        face_vertex_count != expected_face_vertex_count ||
+        array_sizes[BinaryMeshFaceVertexBlock] != face_vertex_count * sizeof(uint32) ||
+        (face_vertex_normals && array_sizes[BinaryMeshFaceVertexNormalBlock] != face_vertex_count * sizeof(uint32)) ||
+        (face_tex_coords && array_sizes[BinaryMeshFaceTexCoordsBlock] != face_vertex_count * sizeof(uint32)) ||
+        (face_materials && array_sizes[BinaryMeshFaceMaterialBlock] != face_count * sizeof(uint16)))
+        throw ExceptionIOError("inconsistent binarymesh data blocks");
+
+    if (degenerate_face)
+        throw ExceptionIOError("binarymesh face with fewer than 3 vertices");
+
+    builder.begin_mesh(mesh_name.c_str());
+
+    builder.push_vertex_array(reinterpret_cast<const Vector3f*>(arrays[BinaryMeshVertexBlock]), vertex_count);
+    builder.push_vertex_normal_array(reinterpret_cast<const Vector3f*>(arrays[BinaryMeshVertexNormalBlock]), vertex_normal_count);
+    builder.push_tex_coords_array(reinterpret_cast<const Vector2f*>(arrays[BinaryMeshTexCoordsBlock]), tex_coords_count);
+
+    read_memory_mapped_material_slots(
+        arrays[BinaryMeshMaterialSlotBlock],
+        array_sizes[BinaryMeshMaterialSlotBlock],
+        builder);
+
+    builder.reserve_faces(face_count);
+
+    for (size_t i = 0, offset = 0; i < face_count; ++i)
+    {
+        const size_t count = face_vertex_counts[i];
+
+        ensure_minimum_size(m_vertices, count);
+        ensure_minimum_size(m_vertex_normals, count);
+        ensure_minimum_size(m_tex_coords, count);
+
+        builder.begin_face(count);
+
+        for (size_t j = 0; j < count; ++j)
+            m_vertices[j] = face_vertices[offset + j];
+        builder.set_face_vertices(&m_vertices[0]);
+
+        if (face_vertex_normals)
+        {
+            for (size_t j = 0; j < count; ++j)
+                m_vertex_normals[j] = face_vertex_normals[offset + j];
+            builder.set_face_vertex_normals(&m_vertex_normals[0]);
+        }
+
+        if (face_tex_coords)
+        {
+            for (size_t j = 0; j < count; ++j)
+                m_tex_coords[j] = face_tex_coords[offset + j];
+            builder.set_face_vertex_tex_coords(&m_tex_coords[0]);
+        }
+
+        if (face_materials)
+            builder.set_face_material(face_materials[i]);
+
+        builder.end_face();
+
+        offset += count;
+    }
+
+    builder.end_mesh();
+}
+
+void BinaryMeshFileReader::read_memory_mapped_material_slots(
+    const uint8*                        data,
+    const size_t                        size,
+    IMeshBuilder&                       builder)
+{
+    if (size == 0)
+        return;
+
+    BoundedMemoryReader reader(data, size);
+
+    uint16 count;
+    checked_read(reader, count);
+
+    for (uint16 i = 0; i < count; ++i)
+    {
+        uint16 length;
+        checked_read(reader, length);
+
+        string material_slot;
+        material_slot.resize(length);
+        checked_read(reader, &material_slot[0], length);
+
+        builder.push_material_slot(material_slot.c_str());
+    }
+}
+
 }   // namespace foundation
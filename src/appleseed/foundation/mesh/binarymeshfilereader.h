@@ -33,6 +33,7 @@
 // appleseed.foundation headers.
 #include "foundation/mesh/imeshfilereader.h"
 #include "foundation/platform/compiler.h"
+#include "foundation/platform/types.h"
 
 // Standard headers.
 #include <cstddef>
@@ -42,7 +43,9 @@
 // Forward declarations.
 namespace foundation    { class BufferedFile; }
 namespace foundation    { class IMeshBuilder; }
+namespace foundation    { class MemoryMappedFile; }
 namespace foundation    { class ReaderAdapter; }
+namespace foundation    { struct BinaryMeshBlockInfo; }
 
 namespace foundation
 {
@@ -77,6 +80,17 @@ class BinaryMeshFileReader
     void read_material_slots(ReaderAdapter& reader, IMeshBuilder& builder);
     void read_faces(ReaderAdapter& reader, IMeshBuilder& builder);
     void read_face(ReaderAdapter& reader, IMeshBuilder& builder);
+
+    void read_memory_mapped_meshes(const size_t data_offset, IMeshBuilder& builder);
+    void read_memory_mapped_mesh(
+        const MemoryMappedFile&                     file,
+        const std::string&                          mesh_name,
+        const std::vector<BinaryMeshBlockInfo>&     blocks,
+        IMeshBuilder&                               builder);
+    static void read_memory_mapped_material_slots(
+        const uint8*                                data,
+        const size_t                                size,
+        IMeshBuilder&                               builder);
 };
 
 }       // namespace foundation
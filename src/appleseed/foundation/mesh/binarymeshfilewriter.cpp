@@ -35,9 +35,16 @@
 #include "foundation/math/vector.h"
 #include "foundation/mesh/imeshwalker.h"
 #include "foundation/platform/types.h"
+#include "foundation/utility/memory.h"
+
+// lz4 headers.
+#include "lz4.h"
 
 // Standard headers.
+#include <algorithm>
+#include <cassert>
 #include <cstring>
+#include <vector>
 
 using namespace std;
 
@@ -68,7 +75,6 @@ namespace
 
 BinaryMeshFileWriter::BinaryMeshFileWriter(const string& filename)
   : m_filename(filename)
-  , m_writer(m_file, 256 * 1024)
 {
 }
 
@@ -100,7 +106,7 @@ void BinaryMeshFileWriter::write_signature()
 
 void BinaryMeshFileWriter::write_version()
 {
-    const uint16 Version = 3;
+    const uint16 Version = 4;
 
     checked_write(m_file, Version);
 }
@@ -109,78 +115,194 @@ void BinaryMeshFileWriter::write_string(const char* s)
 {
     const uint16 length = static_cast<uint16>(strlen(s));
 
-    checked_write(m_writer, length);
-    checked_write(m_writer, s, length);
+    checked_write(m_file, length);
+    checked_write(m_file, s, length);
 }
 
-void BinaryMeshFileWriter::write_mesh(const IMeshWalker& walker)
+void BinaryMeshFileWriter::write_padding(const uint64 offset)
 {
-    write_string(walker.get_name());
-    write_vertices(walker);
-    write_vertex_normals(walker);
-    write_texture_coordinates(walker);
-    write_material_slots(walker);
-    write_faces(walker);
-}
+    static const uint8 Zeros[BinaryMeshBlockAlignment] = { 0 };
 
-void BinaryMeshFileWriter::write_vertices(const IMeshWalker& walker)
-{
-    const uint32 count = static_cast<uint32>(walker.get_vertex_count());
-    checked_write(m_writer, count);
+    const uint64 current_offset = static_cast<uint64>(m_file.tell());
+    assert(current_offset <= offset);
+    assert(offset - current_offset < BinaryMeshBlockAlignment);
 
-    for (uint32 i = 0; i < count; ++i)
-        checked_write(m_writer, walker.get_vertex(i));
+    checked_write(m_file, Zeros, static_cast<size_t>(offset - current_offset));
 }
 
-void BinaryMeshFileWriter::write_vertex_normals(const IMeshWalker& walker)
+void BinaryMeshFileWriter::write_mesh(const IMeshWalker& walker)
 {
-    const uint32 count = static_cast<uint32>(walker.get_vertex_normal_count());
-    checked_write(m_writer, count);
+    // Gather vertices, vertex normals and texture coordinates into single precision arrays.
+    vector<Vector3f> vertices(walker.get_vertex_count());
+    for (size_t i = 0, e = vertices.size(); i < e; ++i)
+        vertices[i] = Vector3f(walker.get_vertex(i));
+
+    vector<Vector3f> vertex_normals(walker.get_vertex_normal_count());
+    for (size_t i = 0, e = vertex_normals.size(); i < e; ++i)
+        vertex_normals[i] = Vector3f(walker.get_vertex_normal(i));
+
+    vector<Vector2f> tex_coords(walker.get_tex_coords_count());
+    for (size_t i = 0, e = tex_coords.size(); i < e; ++i)
+        tex_coords[i] = Vector2f(walker.get_tex_coords(i));
+
+    // Serialize material slot names.
+    vector<uint8> material_slots;
+    const uint16 material_slot_count = static_cast<uint16>(walker.get_material_slot_count());
+    if (material_slot_count > 0)
+    {
+        material_slots.insert(
+            material_slots.end(),
+            reinterpret_cast<const uint8*>(&material_slot_count),
+            reinterpret_cast<const uint8*>(&material_slot_count + 1));
+
+        for (uint16 i = 0; i < material_slot_count; ++i)
+        {
+            const char* name = walker.get_material_slot(i);
+            const uint16 length = static_cast<uint16>(strlen(name));
+
+            material_slots.insert(
+                material_slots.end(),
+                reinterpret_cast<const uint8*>(&length),
+                reinterpret_cast<const uint8*>(&length + 1));
+            material_slots.insert(
+                material_slots.end(),
+                reinterpret_cast<const uint8*>(name),
+                reinterpret_cast<const uint8*>(name + length));
+        }
+    }
 
-    for (uint32 i = 0; i < count; ++i)
-        checked_write(m_writer, walker.get_vertex_normal(i));
-}
+    // Gather faces into one array per attribute. Face vertex normals and
+    // texture coordinates are only stored if the mesh has any.
+    const size_t face_count = walker.get_face_count();
+    const bool has_vertex_normals = !vertex_normals.empty();
+    const bool has_tex_coords = !tex_coords.empty();
+    vector<uint16> face_vertex_counts(face_count);
+    vector<uint32> face_vertices;
+    vector<uint32> face_vertex_normals;
+    vector<uint32> face_tex_coords;
+    vector<uint16> face_materials(face_count);
+
+    for (size_t i = 0; i < face_count; ++i)
+    {
+        const size_t count = walker.get_face_vertex_count(i);
+        face_vertex_counts[i] = static_cast<uint16>(count);
 
-void BinaryMeshFileWriter::write_texture_coordinates(const IMeshWalker& walker)
-{
-    const uint32 count = static_cast<uint32>(walker.get_tex_coords_count());
-    checked_write(m_writer, count);
+        for (size_t j = 0; j < count; ++j)
+        {
+            face_vertices.push_back(static_cast<uint32>(walker.get_face_vertex(i, j)));
 
-    for (uint32 i = 0; i < count; ++i)
-        checked_write(m_writer, walker.get_tex_coords(i));
-}
+            if (has_vertex_normals)
+                face_vertex_normals.push_back(static_cast<uint32>(walker.get_face_vertex_normal(i, j)));
 
-void BinaryMeshFileWriter::write_material_slots(const IMeshWalker& walker)
-{
-    const uint16 count = static_cast<uint16>(walker.get_material_slot_count());
-    checked_write(m_writer, count);
+            if (has_tex_coords)
+                face_tex_coords.push_back(static_cast<uint32>(walker.get_face_tex_coords(i, j)));
+        }
 
-    for (uint16 i = 0; i < count; ++i)
-        write_string(walker.get_material_slot(i));
-}
+        face_materials[i] = static_cast<uint16>(walker.get_face_material(i));
+    }
 
-void BinaryMeshFileWriter::write_faces(const IMeshWalker& walker)
-{
-    const uint32 count = static_cast<uint32>(walker.get_face_count());
-    checked_write(m_writer, count);
+    // Split the arrays into blocks and compress them.
+    m_blocks.clear();
+    add_blocks(BinaryMeshVertexBlock, vertices.data(), vertices.size() * sizeof(Vector3f), sizeof(Vector3f));
+    add_blocks(BinaryMeshVertexNormalBlock, vertex_normals.data(), vertex_normals.size() * sizeof(Vector3f), sizeof(Vector3f));
+    add_blocks(BinaryMeshTexCoordsBlock, tex_coords.data(), tex_coords.size() * sizeof(Vector2f), sizeof(Vector2f));
+    add_blocks(BinaryMeshMaterialSlotBlock, material_slots.data(), material_slots.size(), material_slots.size());
+    add_blocks(BinaryMeshFaceVertexCountBlock, face_vertex_counts.data(), face_vertex_counts.size() * sizeof(uint16), sizeof(uint16));
+    add_blocks(BinaryMeshFaceVertexBlock, face_vertices.data(), face_vertices.size() * sizeof(uint32), sizeof(uint32));
+    add_blocks(BinaryMeshFaceVertexNormalBlock, face_vertex_normals.data(), face_vertex_normals.size() * sizeof(uint32), sizeof(uint32));
+    add_blocks(BinaryMeshFaceTexCoordsBlock, face_tex_coords.data(), face_tex_coords.size() * sizeof(uint32), sizeof(uint32));
+    add_blocks(BinaryMeshFaceMaterialBlock, face_materials.data(), face_materials.size() * sizeof(uint16), sizeof(uint16));
+
+    // Lay out the blocks after the mesh header and the block index.
+    const uint32 block_count = static_cast<uint32>(m_blocks.size());
+    const size_t BlockInfoSize = 2 * sizeof(uint32) + 3 * sizeof(uint64);
+    uint64 offset =
+        static_cast<uint64>(m_file.tell())
+            + sizeof(uint16) + strlen(walker.get_name())
+            + sizeof(uint32)
+            + block_count * BlockInfoSize;
+
+    for (size_t i = 0; i < m_blocks.size(); ++i)
+    {
+        BinaryMeshBlockInfo& info = m_blocks[i].m_info;
+        offset = align(offset, BinaryMeshBlockAlignment);
+        info.m_offset = offset;
+        offset += info.m_stored_size;
+    }
 
-    for (uint32 i = 0; i < count; ++i)
-        write_face(walker, i);
+    // Write the mesh header and the block index.
+    write_string(walker.get_name());
+    checked_write(m_file, block_count);
+
+    for (size_t i = 0; i < m_blocks.size(); ++i)
+    {
+        const BinaryMeshBlockInfo& info = m_blocks[i].m_info;
+        checked_write(m_file, info.m_type);
+        checked_write(m_file, info.m_flags);
+        checked_write(m_file, info.m_offset);
+        checked_write(m_file, info.m_stored_size);
+        checked_write(m_file, info.m_size);
+    }
+
+    // Write the blocks.
+    for (size_t i = 0; i < m_blocks.size(); ++i)
+    {
+        const Block& block = m_blocks[i];
+        const uint8* data =
+            block.m_info.m_flags & BinaryMeshBlockLZ4Compressed
+                ? &block.m_compressed_data[0]
+                : block.m_data;
+        write_padding(block.m_info.m_offset);
+        checked_write(m_file, data, static_cast<size_t>(block.m_info.m_stored_size));
+    }
+
+    m_blocks.clear();
 }
 
-void BinaryMeshFileWriter::write_face(const IMeshWalker& walker, const size_t face_index)
+void BinaryMeshFileWriter::add_blocks(
+    const BinaryMeshBlockType   type,
+    const void*                 data,
+    const size_t                size,
+    const size_t                element_size)
 {
-    const uint16 count = static_cast<uint16>(walker.get_face_vertex_count(face_index));
-    checked_write(m_writer, count);
+    // Split the array on element boundaries.
+    const size_t elements_per_block = max<size_t>(BinaryMeshMaxBlockSize / max<size_t>(element_size, 1), 1);
+    const size_t max_block_size = elements_per_block * element_size;
 
-    for (uint16 i = 0; i < count; ++i)
+    for (size_t begin = 0; begin < size; begin += max_block_size)
     {
-        checked_write(m_writer, static_cast<uint32>(walker.get_face_vertex(face_index, i)));
-        checked_write(m_writer, static_cast<uint32>(walker.get_face_vertex_normal(face_index, i)));
-        checked_write(m_writer, static_cast<uint32>(walker.get_face_tex_coords(face_index, i)));
+        Block block;
+        block.m_info.m_type = static_cast<uint32>(type);
+        block.m_info.m_flags = 0;
+        block.m_info.m_offset = 0;
+        block.m_info.m_size = min(max_block_size, size - begin);
+        block.m_info.m_stored_size = block.m_info.m_size;
+        block.m_data = static_cast<const uint8*>(data) + begin;
+
+        // Compress the block, but keep it uncompressed if that does not save at least
+        // 10% of space: uncompressed blocks can be used in place by the reader.
+        const int input_size = static_cast<int>(block.m_info.m_size);
+        block.m_compressed_data.resize(static_cast<size_t>(LZ4_compressBound(input_size)));
+        const size_t compressed_size =
+            static_cast<size_t>(
+                LZ4_compress(
+                    reinterpret_cast<const char*>(block.m_data),
+                    reinterpret_cast<char*>(&block.m_compressed_data[0]),
+                    input_size));
+
+        if (compressed_size > 0 && compressed_size * 10 < block.m_info.m_size * 9)
+        {
+            block.m_compressed_data.resize(compressed_size);
+            block.m_info.m_flags |= BinaryMeshBlockLZ4Compressed;
+            block.m_info.m_stored_size = compressed_size;
+        }
+        else
+        {
+            clear_release_memory(block.m_compressed_data);
+        }
+
+        m_blocks.push_back(block);
     }
-
-    checked_write(m_writer, static_cast<uint16>(walker.get_face_material(face_index)));
 }
 
 }   // namespace foundation
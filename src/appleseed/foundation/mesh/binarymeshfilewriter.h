@@ -31,13 +31,16 @@
 #define APPLESEED_FOUNDATION_MESH_BINARYMESHFILEWRITER_H
 
 // appleseed.foundation headers.
+#include "foundation/mesh/binarymeshformat.h"
 #include "foundation/mesh/imeshfilewriter.h"
 #include "foundation/platform/compiler.h"
+#include "foundation/platform/types.h"
 #include "foundation/utility/bufferedfile.h"
 
 // Standard headers.
 #include <cstddef>
 #include <string>
+#include <vector>
 
 // Forward declarations.
 namespace foundation    { class IMeshWalker; }
@@ -60,21 +63,28 @@ class BinaryMeshFileWriter
     virtual void write(const IMeshWalker& walker) override;
 
   private:
+    struct Block
+    {
+        BinaryMeshBlockInfo     m_info;
+        const uint8*            m_data;
+        std::vector<uint8>      m_compressed_data;
+    };
+
     const std::string           m_filename;
     BufferedFile                m_file;
-    LZ4CompressedWriterAdapter  m_writer;
+    std::vector<Block>          m_blocks;
 
     void write_signature();
     void write_version();
 
     void write_string(const char* s);
+    void write_padding(const uint64 offset);
     void write_mesh(const IMeshWalker& walker);
-    void write_vertices(const IMeshWalker& walker);
-    void write_vertex_normals(const IMeshWalker& walker);
-    void write_texture_coordinates(const IMeshWalker& walker);
-    void write_material_slots(const IMeshWalker& walker);
-    void write_faces(const IMeshWalker& walker);
-    void write_face(const IMeshWalker& walker, const size_t face_index);
+    void add_blocks(
+        const BinaryMeshBlockType   type,
+        const void*                 data,
+        const size_t                size,
+        const size_t                element_size);
 };
 
 }       // namespace foundation
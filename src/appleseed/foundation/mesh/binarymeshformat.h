@@ -0,0 +1,84 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_FOUNDATION_MESH_BINARYMESHFORMAT_H
+#define APPLESEED_FOUNDATION_MESH_BINARYMESHFORMAT_H
+
+// appleseed.foundation headers.
+#include "foundation/platform/types.h"
+
+// Standard headers.
+#include <cstddef>
+
+namespace foundation
+{
+
+//
+// Definitions shared by the reader and the writer of version 4 of the BinaryMesh
+// file format. Refer to binarymeshspecs.txt for a description of the format.
+//
+
+// Types of data blocks.
+enum BinaryMeshBlockType
+{
+    BinaryMeshVertexBlock = 0,          // Vector3f per vertex
+    BinaryMeshVertexNormalBlock,        // Vector3f per vertex normal
+    BinaryMeshTexCoordsBlock,           // Vector2f per texture coordinate
+    BinaryMeshMaterialSlotBlock,        // serialized material slot names
+    BinaryMeshFaceVertexCountBlock,     // uint16 per face
+    BinaryMeshFaceVertexBlock,          // uint32 per face vertex
+    BinaryMeshFaceVertexNormalBlock,    // uint32 per face vertex
+    BinaryMeshFaceTexCoordsBlock,       // uint32 per face vertex
+    BinaryMeshFaceMaterialBlock,        // uint16 per face
+    BinaryMeshBlockTypeCount
+};
+
+// Block flags.
+const uint32 BinaryMeshBlockLZ4Compressed = 1UL << 0;
+
+// Alignment of data blocks, relative to the beginning of the file.
+const size_t BinaryMeshBlockAlignment = 16;
+
+// Maximum size of an uncompressed data block.
+// Large arrays are split into several blocks that can be decompressed in parallel.
+const size_t BinaryMeshMaxBlockSize = 1024 * 1024;
+
+// Entry of the block index of a mesh.
+struct BinaryMeshBlockInfo
+{
+    uint32  m_type;                     // one of the BinaryMeshBlockType values
+    uint32  m_flags;                    // combination of block flags
+    uint64  m_offset;                   // offset of the block from the beginning of the file
+    uint64  m_stored_size;              // size of the block in the file
+    uint64  m_size;                     // size of the block once decompressed
+};
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_MESH_BINARYMESHFORMAT_H
@@ -69,6 +69,16 @@ class APPLESEED_DLLSYMBOL IMeshBuilder
     // Return the index of the vector within the mesh.
     virtual size_t push_tex_coords(const Vector2d& v) = 0;
 
+    // Append arrays of vertices, vertex normals or texture coordinates to the mesh.
+    // The default implementations push elements one by one; builders that store
+    // single precision geometry can override them to ingest the arrays in bulk.
+    virtual void push_vertex_array(const Vector3f vertices[], const size_t count);
+    virtual void push_vertex_normal_array(const Vector3f vertex_normals[], const size_t count);
+    virtual void push_tex_coords_array(const Vector2f tex_coords[], const size_t count);
+
+    // Hint the builder about the number of faces that are about to be defined.
+    virtual void reserve_faces(const size_t count);
+
     // Append a material slot to the mesh.
     virtual size_t push_material_slot(const char* name) = 0;
 
@@ -94,6 +104,33 @@ class APPLESEED_DLLSYMBOL IMeshBuilder
     virtual void end_mesh() = 0;
 };
 
+
+//
+// IMeshBuilder class implementation.
+//
+
+inline void IMeshBuilder::push_vertex_array(const Vector3f vertices[], const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        push_vertex(Vector3d(vertices[i]));
+}
+
+inline void IMeshBuilder::push_vertex_normal_array(const Vector3f vertex_normals[], const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        push_vertex_normal(Vector3d(vertex_normals[i]));
+}
+
+inline void IMeshBuilder::push_tex_coords_array(const Vector2f tex_coords[], const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        push_tex_coords(Vector2d(tex_coords[i]));
+}
+
+inline void IMeshBuilder::reserve_faces(const size_t count)
+{
+}
+
 }       // namespace foundation
 
 #endif  // !APPLESEED_FOUNDATION_MESH_IMESHBUILDER_H
@@ -33,15 +33,16 @@
 // appleseed.foundation headers.
 #include "foundation/mesh/objmeshfilereader.h"
 #include "foundation/platform/compiler.h"
-#include "foundation/utility/bufferedfile.h"
+#include "foundation/platform/types.h"
 #include "foundation/utility/string.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cassert>
 #include <cctype>
 #include <cstddef>
 #include <cstdlib>
-#include <string>
+#include <cstring>
 #include <vector>
 
 namespace foundation
@@ -50,6 +51,11 @@ namespace foundation
 //
 // A lexical analyzer for the OBJ file format.
 //
+// The lexer operates on a range of characters in memory, typically a line-aligned
+// chunk of a memory-mapped file. Line numbers are relative to the beginning of the
+// range. Lines are copied one at a time into a zero-terminated buffer so that number
+// parsing never reads past the end of the range.
+//
 
 class OBJMeshFileLexer
 {
@@ -63,6 +69,9 @@ class OBJMeshFileLexer
     // Constructor.
     explicit OBJMeshFileLexer(const ParsingMode parsing_mode = Precise)
       : m_parsing_mode(parsing_mode)
+      , m_is_open(false)
+      , m_cursor(0)
+      , m_end(0)
       , m_eof(false)
       , m_line_number(0)
       , m_line(4096)
@@ -74,38 +83,30 @@ class OBJMeshFileLexer
             m_is_space[i] = std::isspace(i) != 0;
     }
 
-    // Open an input file.
-    // Return true on success, false on error.
-    bool open(const std::string& filename)
+    // Start reading a range of characters.
+    void open(const char* begin, const char* end)
     {
+        m_is_open = true;
+        m_cursor = begin;
+        m_end = end;
         m_eof = false;
         m_line_number = 0;
         m_line_size = 0;
         m_line_index = 0;
 
-        m_file.open(
-            filename.c_str(),
-            BufferedFile::TextType,
-            BufferedFile::ReadMode);
-
-        if (!m_file.is_open())
-            return false;
-
         read_next_line();
-
-        return true;
     }
 
-    // Close the input file.
+    // Stop reading.
     void close()
     {
-        m_file.close();
+        m_is_open = false;
     }
 
-    // Return the position of the current line in the file.
+    // Return the position of the current line in the range.
     size_t get_line_number() const
     {
-        assert(m_file.is_open());
+        assert(m_is_open);
 
         return m_line_number;
     }
@@ -113,7 +114,7 @@ class OBJMeshFileLexer
     // Return the current character in the line.
     APPLESEED_FORCE_INLINE unsigned char get_char() const
     {
-        assert(m_file.is_open());
+        assert(m_is_open);
 
         return m_line_index == m_line_size ? '\n' : m_line[m_line_index];
     }
@@ -121,7 +122,7 @@ class OBJMeshFileLexer
     // Advance to the next character in the line.
     APPLESEED_FORCE_INLINE void next_char()
     {
-        assert(m_file.is_open());
+        assert(m_is_open);
 
         if (m_line_index < m_line_size)
             ++m_line_index;
@@ -141,15 +142,15 @@ class OBJMeshFileLexer
     // Return true if the end of the line has been reached.
     APPLESEED_FORCE_INLINE bool is_eol() const
     {
-        assert(m_file.is_open());
+        assert(m_is_open);
 
         return m_line_index == m_line_size;
     }
 
-    // Return true if the end of the file has been reached.
+    // Return true if the end of the range has been reached.
     APPLESEED_FORCE_INLINE bool is_eof() const
     {
-        assert(m_file.is_open());
+        assert(m_is_open);
 
         return m_eof && is_eol();
     }
@@ -157,7 +158,7 @@ class OBJMeshFileLexer
     // Eat blank characters and comments.
     void eat_blanks()
     {
-        assert(m_file.is_open());
+        assert(m_is_open);
 
         while (true)
         {
@@ -192,7 +193,7 @@ class OBJMeshFileLexer
     // Accept a end-of-line character, or generate a parse error.
     void accept_newline()
     {
-        assert(m_file.is_open());
+        assert(m_is_open);
 
         if (!is_eol())
             parse_error();
@@ -203,7 +204,7 @@ class OBJMeshFileLexer
     // Accept a string of non-blank characters, or generate a parse error.
     void accept_string(const char** begin, size_t* length)
     {
-        assert(m_file.is_open());
+        assert(m_is_open);
 
         if (is_eof())
             parse_error();
@@ -236,7 +237,7 @@ class OBJMeshFileLexer
     // Accept a long integer, or generate a parse error.
     APPLESEED_FORCE_INLINE long accept_long()
     {
-        assert(m_file.is_open());
+        assert(m_is_open);
 
         // Read an integer value at the current position in the line.
         const char* base_ptr = &m_line[0];
@@ -255,7 +256,7 @@ class OBJMeshFileLexer
     // Accept a double-precision floating point number, or generate a parse error.
     APPLESEED_FORCE_INLINE double accept_double()
     {
-        assert(m_file.is_open());
+        assert(m_is_open);
 
         // Read a floating-point value at the current position in the line.
         char* base_ptr = &m_line[0];
@@ -265,7 +266,7 @@ class OBJMeshFileLexer
                 ? fast_strtod(
                     base_ptr + m_line_index,
                     &end_ptr)
-                : std::strtod(
+                : precise_strtod(
                     base_ptr + m_line_index,
                     &end_ptr);
 
@@ -278,24 +279,26 @@ class OBJMeshFileLexer
   private:
     const ParsingMode   m_parsing_mode;     // parsing mode for floating-point values
     bool                m_is_space[256];    // precomputed values of std::isspace(c) for all c
-    BufferedFile        m_file;
-    bool                m_eof;              // has the end of the file been reached?
-    size_t              m_line_number;      // position of the current line in the file
+    bool                m_is_open;
+    const char*         m_cursor;           // beginning of the next line in the range
+    const char*         m_end;              // end of the range
+    bool                m_eof;              // has the end of the range been reached?
+    size_t              m_line_number;      // position of the current line in the range
     std::vector<char>   m_line;             // current line
     size_t              m_line_size;        // size of the current line (not counting the zero terminator)
     size_t              m_line_index;       // position of the cursor in the current line
 
-    // Close the input file and throw an ExceptionParseError exception.
+    // Throw an ExceptionParseError exception.
     void parse_error()
     {
-        m_file.close();
         throw OBJMeshFileReader::ExceptionParseError(m_line_number);
     }
 
-    // Read the next line from the input file.
+    // Read the next line from the range.
+    // Lines longer than the line buffer are split into multiple lines.
     void read_next_line()
     {
-        assert(m_file.is_open());
+        assert(m_is_open);
 
         m_line_size = 0;
 
@@ -303,29 +306,88 @@ class OBJMeshFileLexer
         {
             ++m_line_number;
 
-            while (m_line_size < m_line.size() - 1)
+            const size_t max_line_size = m_line.size() - 1;
+            const size_t remaining = static_cast<size_t>(m_end - m_cursor);
+            const char* eol =
+                remaining > 0
+                    ? static_cast<const char*>(std::memchr(m_cursor, '\n', remaining))
+                    : 0;
+            const size_t line_size = eol ? static_cast<size_t>(eol - m_cursor) : remaining;
+
+            // Copy the line, or as much of it as fits in the line buffer.
+            m_line_size = std::min(line_size, max_line_size);
+            std::memcpy(&m_line[0], m_cursor, m_line_size);
+            m_cursor += m_line_size;
+
+            if (line_size < max_line_size)
             {
-                // Read one character from the file.
-                char c;
-                if (m_file.read(&c) < 1)
-                {
-                    // Reached the end of the file.
-                    m_eof = true;
-                    break;
-                }
-
-                // Stop as soon as the end of the line is reached.
-                if (c == '\n')
-                    break;
-
-                // Append the character to the line.
-                m_line[m_line_size++] = c;
+                // Skip the end-of-line character, or detect the end of the range.
+                if (eol)
+                    ++m_cursor;
+                else m_eof = true;
             }
         }
 
         // Append a null terminator.
         m_line[m_line_size] = 0;
     }
+
+    static bool is_digit(const char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    // Equivalent to std::strtod() in the "C" locale, with a fast path for decimal
+    // numbers with at most 15 significant digits and no exponent. Such numbers are
+    // exactly representable as an integer mantissa divided by an exact power of ten,
+    // hence a single IEEE division yields the correctly rounded result.
+    static double precise_strtod(char* str, char** end_ptr)
+    {
+        static const double PowersOfTen[16] =
+        {
+            1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7,
+            1.0e8, 1.0e9, 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15
+        };
+
+        const char* p = str;
+
+        const bool negative = *p == '-';
+        if (*p == '-' || *p == '+')
+            ++p;
+
+        uint64 mantissa = 0;
+        size_t digit_count = 0;
+        size_t fraction_digit_count = 0;
+
+        while (is_digit(*p))
+        {
+            mantissa = mantissa * 10 + static_cast<uint64>(*p++ - '0');
+            ++digit_count;
+        }
+
+        if (*p == '.')
+        {
+            ++p;
+
+            while (is_digit(*p))
+            {
+                mantissa = mantissa * 10 + static_cast<uint64>(*p++ - '0');
+                ++digit_count;
+                ++fraction_digit_count;
+            }
+        }
+
+        // Fall back to std::strtod() for anything but plain decimal numbers
+        // (exponents, hexadecimal numbers, infinities, NaNs, too many digits).
+        if (digit_count == 0 || digit_count > 15 || std::isalnum(static_cast<unsigned char>(*p)) || *p == '.')
+            return std::strtod(str, end_ptr);
+
+        const double value = static_cast<double>(mantissa) / PowersOfTen[fraction_digit_count];
+
+        *end_ptr = const_cast<char*>(p);
+
+        return negative ? -value : value;
+    }
 };
 
 }       // namespace foundation
@@ -35,10 +35,16 @@
 #include "foundation/math/vector.h"
 #include "foundation/mesh/imeshbuilder.h"
 #include "foundation/mesh/objmeshfilelexer.h"
+#include "foundation/platform/memorymappedfile.h"
+#include "foundation/platform/system.h"
+#include "foundation/platform/thread.h"
+#include "foundation/platform/types.h"
 #include "foundation/utility/memory.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cstring>
+#include <exception>
 #include <map>
 #include <utility>
 #include <vector>
@@ -51,19 +57,408 @@ namespace foundation
 //
 // OBJMeshFileReader class implementation.
 //
+// The file is memory-mapped and split into line-aligned chunks that are parsed
+// concurrently. Parsing a chunk collects its vertices, texture coordinates and
+// normals, and records the statements that affect the structure of the meshes
+// (faces, objects, groups, materials) with their raw indices. The recorded
+// statements are then replayed in file order on a single thread, which resolves
+// relative indices, reports errors and drives the mesh builder exactly as a
+// sequential parse would.
+//
 
 namespace
 {
     const size_t Undefined = ~0;
+
+    // Minimum size of a chunk of the file.
+    const size_t MinChunkSize = 1024 * 1024;
+
+    // Maximum size of a chunk of the file, such that chunk-relative values fit in 32 bits.
+    const size_t MaxChunkSize = 1024 * 1024 * 1024;
+
+    // A statement recorded while parsing a chunk.
+    struct Statement
+    {
+        enum Type
+        {
+            Face,
+            ObjectOrGroup,
+            UseMaterial,
+            ParseError
+        };
+
+        uint32  m_type;
+        uint32  m_line;                 // line number, relative to the beginning of the chunk
+        uint32  m_data_index;           // index of the first raw face index, or of the name
+        uint32  m_face_vertex_count;    // number of vertex indices of the face
+        uint32  m_face_tex_coord_count; // number of texture coordinate indices of the face
+        uint32  m_face_normal_count;    // number of normal indices of the face
+        uint32  m_vertex_count;         // number of vertices defined so far in the chunk
+        uint32  m_tex_coord_count;      // number of texture coordinates defined so far in the chunk
+        uint32  m_normal_count;         // number of normals defined so far in the chunk
+    };
+
+    // Parser for a line-aligned chunk of an OBJ file.
+    class ChunkParser
+      : public NonCopyable
+    {
+      public:
+        // Features defined in the chunk.
+        vector<Vector3d>        m_vertices;
+        vector<Vector2d>        m_tex_coords;
+        vector<Vector3d>        m_normals;
+
+        // Recorded statements and their data.
+        vector<Statement>       m_statements;
+        vector<long>            m_face_indices;
+        vector<string>          m_names;
+
+        // Number of lines in the chunk, valid if parsing succeeded.
+        size_t                  m_line_count;
+
+        // Unexpected exception thrown while parsing the chunk, if any.
+        exception_ptr           m_exception;
+
+        explicit ChunkParser(const int options)
+          : m_lexer(
+                (options & OBJMeshFileReader::FavorSpeedOverPrecision)
+                    ? OBJMeshFileLexer::Fast
+                    : OBJMeshFileLexer::Precise)
+          , m_line_count(0)
+        {
+        }
+
+        void parse(const char* begin, const char* end)
+        {
+            try
+            {
+                m_lexer.open(begin, end);
+                parse_chunk();
+
+                // The lexer counts an empty line past the last end-of-line character.
+                m_line_count = m_lexer.get_line_number() - 1;
+            }
+            catch (const OBJMeshFileReader::ExceptionParseError& e)
+            {
+                Statement statement = make_statement(Statement::ParseError);
+                statement.m_line = static_cast<uint32>(e.m_line);
+                m_statements.push_back(statement);
+            }
+            catch (...)
+            {
+                m_exception = current_exception();
+            }
+
+            m_lexer.close();
+        }
+
+      private:
+        OBJMeshFileLexer        m_lexer;
+
+        // Temporary vectors for collecting indices while parsing face statements.
+        vector<long>            m_face_vertex_indices;
+        vector<long>            m_face_tex_coord_indices;
+        vector<long>            m_face_normal_indices;
+
+        // Throw an ExceptionParseError exception.
+        void parse_error()
+        {
+            throw OBJMeshFileReader::ExceptionParseError(m_lexer.get_line_number());
+        }
+
+        Statement make_statement(const Statement::Type type) const
+        {
+            Statement statement;
+            statement.m_type = static_cast<uint32>(type);
+            statement.m_line = static_cast<uint32>(m_lexer.get_line_number());
+            statement.m_data_index = 0;
+            statement.m_face_vertex_count = 0;
+            statement.m_face_tex_coord_count = 0;
+            statement.m_face_normal_count = 0;
+            statement.m_vertex_count = static_cast<uint32>(m_vertices.size());
+            statement.m_tex_coord_count = static_cast<uint32>(m_tex_coords.size());
+            statement.m_normal_count = static_cast<uint32>(m_normals.size());
+            return statement;
+        }
+
+        void parse_chunk()
+        {
+            while (true)
+            {
+                m_lexer.eat_blanks();
+
+                // Handle end of chunk.
+                if (m_lexer.is_eof())
+                    break;
+
+                // Handle empty lines.
+                if (m_lexer.is_eol())
+                {
+                    m_lexer.accept_newline();
+                    continue;
+                }
+
+                const char* keyword;
+                size_t keyword_length;
+
+                m_lexer.accept_string(&keyword, &keyword_length);
+
+                if (keyword_length == 1)
+                {
+                    switch (keyword[0])
+                    {
+                      case 'f':
+                        parse_f_statement();
+                        break;
+
+                      case 'g':
+                      case 'o':
+                        parse_named_statement(Statement::ObjectOrGroup);
+                        break;
+
+                      case 'v':
+                        parse_v_statement();
+                        break;
+
+                      default:
+                        // Ignore unknown or unhandled statements.
+                        m_lexer.eat_line();
+                        continue;
+                    }
+                }
+                else if (keyword_length == 2)
+                {
+                    switch (keyword[0] * 256 + keyword[1])
+                    {
+                      case 'v' * 256 + 'n':
+                        parse_vn_statement();
+                        break;
+
+                      case 'v' * 256 + 't':
+                        parse_vt_statement();
+                        break;
+
+                      default:
+                        // Ignore unknown or unhandled statements.
+                        m_lexer.eat_line();
+                        continue;
+                    }
+                }
+                else if (strncmp(keyword, "usemtl", keyword_length) == 0)
+                {
+                    parse_named_statement(Statement::UseMaterial);
+                }
+                else
+                {
+                    // Ignore unknown or unhandled statements.
+                    m_lexer.eat_line();
+                    continue;
+                }
+
+                m_lexer.eat_blanks();
+                m_lexer.accept_newline();
+            }
+        }
+
+        void parse_f_statement()
+        {
+            clear_keep_memory(m_face_vertex_indices);
+            clear_keep_memory(m_face_tex_coord_indices);
+            clear_keep_memory(m_face_normal_indices);
+
+            while (true)
+            {
+                m_lexer.eat_blanks();
+
+                if (m_lexer.is_eol())
+                    break;
+
+                //
+                // Recognized (epsilon)
+                // Accept n
+                //
+
+                m_face_vertex_indices.push_back(m_lexer.accept_long());
+
+                //
+                // Recognized n
+                // Accept (epsilon), /
+                //
+
+                {
+                    const unsigned char c = m_lexer.get_char();
+                    if (m_lexer.is_space(c))
+                        continue;
+                    else if (c == '/')
+                        m_lexer.next_char();
+                    else parse_error();
+                }
+
+                //
+                // Recognized n/
+                // Accept /, n
+                //
+
+                {
+                    const unsigned char c = m_lexer.get_char();
+                    if (c == '/')
+                    {
+                        m_lexer.next_char();
+                        goto skip;
+                    }
+                    else m_face_tex_coord_indices.push_back(m_lexer.accept_long());
+                }
+
+                //
+                // Recognized n/n
+                // Accept (epsilon), /
+                //
+
+                {
+                    const unsigned char c = m_lexer.get_char();
+                    if (m_lexer.is_space(c))
+                        continue;
+                    else if (c == '/')
+                        m_lexer.next_char();
+                    else parse_error();
+                }
+
+              skip:
+
+                //
+                // Recognized n//, n/n/
+                // Accept (epsilon), n
+                //
+
+                {
+                    const unsigned char c = m_lexer.get_char();
+                    if (m_lexer.is_space(c))
+                        continue;
+                    else m_face_normal_indices.push_back(m_lexer.accept_long());
+                }
+            }
+
+            Statement statement = make_statement(Statement::Face);
+            statement.m_data_index = static_cast<uint32>(m_face_indices.size());
+            statement.m_face_vertex_count = static_cast<uint32>(m_face_vertex_indices.size());
+            statement.m_face_tex_coord_count = static_cast<uint32>(m_face_tex_coord_indices.size());
+            statement.m_face_normal_count = static_cast<uint32>(m_face_normal_indices.size());
+            m_statements.push_back(statement);
+
+            m_face_indices.insert(m_face_indices.end(), m_face_vertex_indices.begin(), m_face_vertex_indices.end());
+            m_face_indices.insert(m_face_indices.end(), m_face_tex_coord_indices.begin(), m_face_tex_coord_indices.end());
+            m_face_indices.insert(m_face_indices.end(), m_face_normal_indices.begin(), m_face_normal_indices.end());
+        }
+
+        void parse_named_statement(const Statement::Type type)
+        {
+            Statement statement = make_statement(type);
+            statement.m_data_index = static_cast<uint32>(m_names.size());
+            m_statements.push_back(statement);
+
+            m_names.push_back(parse_compound_identifier());
+        }
+
+        string parse_compound_identifier()
+        {
+            string identifier;
+
+            m_lexer.eat_blanks();
+
+            while (!m_lexer.is_eol())
+            {
+                const char* token;
+                size_t token_length;
+
+                m_lexer.accept_string(&token, &token_length);
+                m_lexer.eat_blanks();
+
+                if (!identifier.empty())
+                    identifier += ' ';
+
+                identifier.append(token, token_length);
+            }
+
+            return identifier;
+        }
+
+        void parse_v_statement()
+        {
+            Vector3d v;
+
+            m_lexer.eat_blanks();
+            v.x = m_lexer.accept_double();
+
+            m_lexer.eat_blanks();
+            v.y = m_lexer.accept_double();
+
+            m_lexer.eat_blanks();
+            v.z = m_lexer.accept_double();
+
+            m_lexer.eat_blanks();
+
+            if (!m_lexer.is_eol())
+                m_lexer.accept_double();
+
+            m_vertices.push_back(v);
+        }
+
+        void parse_vt_statement()
+        {
+            Vector2d v;
+
+            m_lexer.eat_blanks();
+            v.x = m_lexer.accept_double();
+
+            m_lexer.eat_blanks();
+            v.y = m_lexer.accept_double();
+
+            m_lexer.eat_blanks();
+
+            if (!m_lexer.is_eol())
+                m_lexer.accept_double();
+
+            m_tex_coords.push_back(v);
+        }
+
+        void parse_vn_statement()
+        {
+            Vector3d n;
+
+            m_lexer.eat_blanks();
+            n.x = m_lexer.accept_double();
+
+            m_lexer.eat_blanks();
+            n.y = m_lexer.accept_double();
+
+            m_lexer.eat_blanks();
+            n.z = m_lexer.accept_double();
+
+            m_normals.push_back(n);
+        }
+    };
+
+    // Parse a chunk of the file.
+    struct ChunkParsingWorker
+    {
+        ChunkParser*    m_parser;
+        const char*     m_begin;
+        const char*     m_end;
+
+        void operator()()
+        {
+            m_parser->parse(m_begin, m_end);
+        }
+    };
 }
 
 struct OBJMeshFileReader::Impl
 {
     const int               m_options;
     IMeshBuilder&           m_builder;
-    OBJMeshFileLexer        m_lexer;
 
     // Current state.
+    size_t                  m_line_number;                  // line number of the current statement
     bool                    m_inside_mesh_def;              // currently inside a mesh definition?
     string                  m_current_mesh_name;            // name of the current mesh
     map<string, size_t>     m_material_slots;               // material slots for the current mesh
@@ -79,7 +474,7 @@ struct OBJMeshFileReader::Impl
     vector<size_t>          m_tex_coord_index_mapping;
     vector<size_t>          m_normal_index_mapping;
 
-    // Temporary vectors for collecting indices while parsing face statements.
+    // Temporary vectors for collecting indices of face statements.
     vector<size_t>          m_face_vertex_indices;
     vector<size_t>          m_face_tex_coord_indices;
     vector<size_t>          m_face_normal_indices;
@@ -90,101 +485,105 @@ struct OBJMeshFileReader::Impl
         IMeshBuilder&       builder)
       : m_options(options)
       , m_builder(builder)
-      , m_lexer(
-            (options & FavorSpeedOverPrecision)
-                ? OBJMeshFileLexer::Fast
-                : OBJMeshFileLexer::Precise)
+      , m_line_number(0)
       , m_inside_mesh_def(false)
       , m_current_material_slot_index(0)
     {
     }
 
-    // Close the input file and throw an ExceptionParseError exception.
+    // Throw an ExceptionParseError exception.
     void parse_error()
     {
-        const size_t line_number = m_lexer.get_line_number();
-
-        m_lexer.close();
-
-        throw ExceptionParseError(line_number);
+        throw ExceptionParseError(m_line_number);
     }
 
-    void parse_file()
+    void parse_file(
+        const char*         begin,
+        const char*         end,
+        const size_t        chunk_size)
     {
-        while (true)
-        {
-            m_lexer.eat_blanks();
+        // Split the file into line-aligned chunks.
+        const size_t size = static_cast<size_t>(end - begin);
+        size_t chunk_count;
 
-            // Handle end of file.
-            if (m_lexer.is_eof())
-                break;
+        if (chunk_size > 0)
+        {
+            // Forced chunk size.
+            const size_t clamped_chunk_size = min(chunk_size, MaxChunkSize);
+            chunk_count = max<size_t>((size + clamped_chunk_size - 1) / clamped_chunk_size, 1);
+        }
+        else if (m_options & OBJMeshFileReader::SingleThreaded)
+        {
+            // As few chunks as possible.
+            chunk_count = max<size_t>((size + MaxChunkSize - 1) / MaxChunkSize, 1);
+        }
+        else
+        {
+            // One chunk per core, unless the file is too small or too large.
+            chunk_count =
+                max<size_t>(
+                    min(System::get_logical_cpu_core_count(), size / MinChunkSize),
+                    max<size_t>((size + MaxChunkSize - 1) / MaxChunkSize, 1));
+        }
 
-            // Handle empty lines.
-            if (m_lexer.is_eol())
-            {
-                m_lexer.accept_newline();
-                continue;
-            }
+        vector<const char*> boundaries(1, begin);
 
-            const char* keyword;
-            size_t keyword_length;
+        for (size_t i = 1; i < chunk_count; ++i)
+        {
+            const char* boundary = max(begin + i * (size / chunk_count), boundaries.back());
+            const char* eol = static_cast<const char*>(memchr(boundary, '\n', end - boundary));
+            boundaries.push_back(eol ? eol + 1 : end);
+        }
 
-            m_lexer.accept_string(&keyword, &keyword_length);
+        boundaries.push_back(end);
 
-            if (keyword_length == 1)
-            {
-                switch (keyword[0])
-                {
-                  case 'f':
-                    parse_f_statement();
-                    break;
+        // Parse the chunks concurrently.
+        vector<ChunkParser*> parsers;
+        for (size_t i = 0; i < chunk_count; ++i)
+            parsers.push_back(new ChunkParser(m_options));
 
-                  case 'g':
-                  case 'o':
-                    parse_o_g_statement();
-                    break;
+        try
+        {
+            boost::thread_group threads;
 
-                  case 'v':
-                    parse_v_statement();
-                    break;
+            for (size_t i = 1; i < chunk_count; ++i)
+            {
+                ChunkParsingWorker worker = { parsers[i], boundaries[i], boundaries[i + 1] };
 
-                  default:
-                    // Ignore unknown or unhandled statements.
-                    m_lexer.eat_line();
-                    continue;
-                }
+                if (m_options & OBJMeshFileReader::SingleThreaded)
+                    worker();
+                else threads.create_thread(worker);
             }
-            else if (keyword_length == 2)
-            {
-                switch (keyword[0] * 256 + keyword[1])
-                {
-                  case 'v' * 256 + 'n':
-                    parse_vn_statement();
-                    break;
 
-                  case 'v' * 256 + 't':
-                    parse_vt_statement();
-                    break;
+            ChunkParsingWorker worker = { parsers[0], boundaries[0], boundaries[1] };
+            worker();
 
-                  default:
-                    // Ignore unknown or unhandled statements.
-                    m_lexer.eat_line();
-                    continue;
-                }
-            }
-            else if (strncmp(keyword, "usemtl", keyword_length) == 0)
+            threads.join_all();
+
+            for (size_t i = 0; i < chunk_count; ++i)
             {
-                parse_usemtl_statement();
+                if (parsers[i]->m_exception)
+                    rethrow_exception(parsers[i]->m_exception);
             }
-            else
+
+            // Replay the statements of the chunks in order.
+            size_t line_base = 0;
+
+            for (size_t i = 0; i < chunk_count; ++i)
             {
-                // Ignore unknown or unhandled statements.
-                m_lexer.eat_line();
-                continue;
+                replay_chunk(*parsers[i], line_base);
+                line_base += parsers[i]->m_line_count;
+
+                delete parsers[i];
+                parsers[i] = 0;
             }
+        }
+        catch (...)
+        {
+            for (size_t i = 0; i < chunk_count; ++i)
+                delete parsers[i];
 
-            m_lexer.eat_blanks();
-            m_lexer.accept_newline();
+            throw;
         }
 
         // End the definition of the last object.
@@ -192,102 +591,80 @@ struct OBJMeshFileReader::Impl
             m_builder.end_mesh();
     }
 
-    void parse_f_statement()
+    void replay_chunk(ChunkParser& parser, const size_t line_base)
     {
-        clear_keep_memory(m_face_vertex_indices);
-        clear_keep_memory(m_face_tex_coord_indices);
-        clear_keep_memory(m_face_normal_indices);
+        const size_t vertex_base = m_vertices.size();
+        const size_t tex_coord_base = m_tex_coords.size();
+        const size_t normal_base = m_normals.size();
 
-        while (true)
-        {
-            m_lexer.eat_blanks();
+        m_vertices.insert(m_vertices.end(), parser.m_vertices.begin(), parser.m_vertices.end());
+        m_tex_coords.insert(m_tex_coords.end(), parser.m_tex_coords.begin(), parser.m_tex_coords.end());
+        m_normals.insert(m_normals.end(), parser.m_normals.begin(), parser.m_normals.end());
 
-            if (m_lexer.is_eol())
-                break;
+        clear_release_memory(parser.m_vertices);
+        clear_release_memory(parser.m_tex_coords);
+        clear_release_memory(parser.m_normals);
 
-            //
-            // Recognized (epsilon)
-            // Accept n
-            //
+        const size_t statement_count = parser.m_statements.size();
 
-            {
-                const long n = m_lexer.accept_long();
-                const size_t v = fix_index(n, m_vertices.size());
-                m_face_vertex_indices.push_back(v);
-            }
+        for (size_t i = 0; i < statement_count; ++i)
+        {
+            const Statement& statement = parser.m_statements[i];
 
-            //
-            // Recognized n
-            // Accept (epsilon), /
-            //
+            m_line_number = line_base + statement.m_line;
 
+            switch (statement.m_type)
             {
-                const unsigned char c = m_lexer.get_char();
-                if (m_lexer.is_space(c))
-                    continue;
-                else if (c == '/')
-                    m_lexer.next_char();
-                else parse_error();
-            }
+              case Statement::Face:
+                replay_f_statement(
+                    statement,
+                    parser.m_face_indices.data() + statement.m_data_index,
+                    vertex_base + statement.m_vertex_count,
+                    tex_coord_base + statement.m_tex_coord_count,
+                    normal_base + statement.m_normal_count);
+                break;
 
-            //
-            // Recognized n/
-            // Accept /, n
-            //
+              case Statement::ObjectOrGroup:
+                replay_o_g_statement(parser.m_names[statement.m_data_index]);
+                break;
 
-            {
-                const unsigned char c = m_lexer.get_char();
-                if (c == '/')
-                {
-                    m_lexer.next_char();
-                    goto skip;
-                }
-                else
-                {
-                    const long n = m_lexer.accept_long();
-                    const size_t vt = fix_index(n, m_tex_coords.size());
-                    m_face_tex_coord_indices.push_back(vt);
-                }
+              case Statement::UseMaterial:
+                replay_usemtl_statement(parser.m_names[statement.m_data_index]);
+                break;
+
+              case Statement::ParseError:
+                parse_error();
+                break;
             }
+        }
+    }
 
-            //
-            // Recognized n/n
-            // Accept (epsilon), /
-            //
+    void replay_f_statement(
+        const Statement&    statement,
+        const long*         indices,
+        const size_t        vertex_count,
+        const size_t        tex_coord_count,
+        const size_t        normal_count)
+    {
+        clear_keep_memory(m_face_vertex_indices);
+        clear_keep_memory(m_face_tex_coord_indices);
+        clear_keep_memory(m_face_normal_indices);
 
-            {
-                const unsigned char c = m_lexer.get_char();
-                if (m_lexer.is_space(c))
-                    continue;
-                else if (c == '/')
-                    m_lexer.next_char();
-                else parse_error();
-            }
+        // Resolve indices.
+        const size_t vc = statement.m_face_vertex_count;
+        const size_t tc = statement.m_face_tex_coord_count;
+        const size_t nc = statement.m_face_normal_count;
 
-          skip:
+        for (size_t i = 0; i < vc; ++i)
+            m_face_vertex_indices.push_back(fix_index(*indices++, vertex_count));
 
-            //
-            // Recognized n//, n/n/
-            // Accept (epsilon), n
-            //
+        for (size_t i = 0; i < tc; ++i)
+            m_face_tex_coord_indices.push_back(fix_index(*indices++, tex_coord_count));
 
-            {
-                const unsigned char c = m_lexer.get_char();
-                if (m_lexer.is_space(c))
-                    continue;
-                else
-                {
-                    const long n = m_lexer.accept_long();
-                    const size_t vn = fix_index(n, m_normals.size());
-                    m_face_normal_indices.push_back(vn);
-                }
-            }
-        }
+        for (size_t i = 0; i < nc; ++i)
+            m_face_normal_indices.push_back(fix_index(*indices++, normal_count));
 
         // Check whether the face is well-formed.
-        const size_t vc = m_face_vertex_indices.size();
-        const size_t tc = m_face_tex_coord_indices.size();
-        const size_t nc = m_face_normal_indices.size();
         const bool well_formed =
                 vc >= 3
             && (tc == 0 || tc == vc)
@@ -302,7 +679,7 @@ struct OBJMeshFileReader::Impl
         {
             // The face is ill-formed, ignore it or abort parsing.
             if (m_options & StopOnInvalidFaceDef)
-                throw ExceptionInvalidFaceDef(m_lexer.get_line_number());
+                throw ExceptionInvalidFaceDef(m_line_number);
         }
     }
 
@@ -417,11 +794,8 @@ struct OBJMeshFileReader::Impl
             indices[i] = mapping[indices[i]];
     }
 
-    void parse_o_g_statement()
+    void replay_o_g_statement(const string& upcoming_mesh_name)
     {
-        // Retrieve the name of the upcoming mesh.
-        const string upcoming_mesh_name = parse_compound_identifier();
-
         // Start a new mesh only if the name of the object or group actually changes.
         if (upcoming_mesh_name != m_current_mesh_name)
         {
@@ -440,92 +814,11 @@ struct OBJMeshFileReader::Impl
         }
     }
 
-    string parse_compound_identifier()
-    {
-        string identifier;
-
-        m_lexer.eat_blanks();
-
-        while (!m_lexer.is_eol())
-        {
-            const char* token;
-            size_t token_length;
-
-            m_lexer.accept_string(&token, &token_length);
-            m_lexer.eat_blanks();
-
-            if (!identifier.empty())
-                identifier += ' ';
-
-            identifier.append(token, token_length);
-        }
-
-        return identifier;
-    }
-
-    void parse_v_statement()
-    {
-        Vector3d v;
-
-        m_lexer.eat_blanks();
-        v.x = m_lexer.accept_double();
-
-        m_lexer.eat_blanks();
-        v.y = m_lexer.accept_double();
-
-        m_lexer.eat_blanks();
-        v.z = m_lexer.accept_double();
-
-        m_lexer.eat_blanks();
-
-        if (!m_lexer.is_eol())
-            m_lexer.accept_double();
-
-        m_vertices.push_back(v);
-    }
-
-    void parse_vt_statement()
-    {
-        Vector2d v;
-
-        m_lexer.eat_blanks();
-        v.x = m_lexer.accept_double();
-
-        m_lexer.eat_blanks();
-        v.y = m_lexer.accept_double();
-
-        m_lexer.eat_blanks();
-
-        if (!m_lexer.is_eol())
-            m_lexer.accept_double();
-
-        m_tex_coords.push_back(v);
-    }
-
-    void parse_vn_statement()
-    {
-        Vector3d n;
-
-        m_lexer.eat_blanks();
-        n.x = m_lexer.accept_double();
-
-        m_lexer.eat_blanks();
-        n.y = m_lexer.accept_double();
-
-        m_lexer.eat_blanks();
-        n.z = m_lexer.accept_double();
-
-        m_normals.push_back(n);
-    }
-
-    void parse_usemtl_statement()
+    void replay_usemtl_statement(const string& material_slot_name)
     {
         // Begin a mesh definition if we're not already inside one.
         ensure_mesh_def();
 
-        // Retrieve the name of the material slot.
-        const string material_slot_name = parse_compound_identifier();
-
         // Check whether this material slot has already been defined for this mesh.
         const map<string, size_t>::const_iterator& it =
             m_material_slots.find(material_slot_name);
@@ -563,22 +856,24 @@ OBJMeshFileReader::OBJMeshFileReader(
     const int       options)
   : m_filename(filename)
   , m_options(options)
+  , m_chunk_size(0)
 {
 }
 
-void OBJMeshFileReader::read(IMeshBuilder& builder)
+void OBJMeshFileReader::set_chunk_size(const size_t chunk_size)
 {
-    Impl impl(m_options, builder);
+    m_chunk_size = chunk_size;
+}
 
-    // Open the input file.
-    if (!impl.m_lexer.open(m_filename))
-        throw ExceptionIOError();
+void OBJMeshFileReader::read(IMeshBuilder& builder)
+{
+    // Map the input file into memory.
+    const MemoryMappedFile file(m_filename.c_str());
+    const char* begin = reinterpret_cast<const char*>(file.get_data());
 
     // Parse the file.
-    impl.parse_file();
-
-    // Close the input file.
-    impl.m_lexer.close();
+    Impl impl(m_options, builder);
+    impl.parse_file(begin, begin + file.get_size(), m_chunk_size);
 }
 
 }   // namespace foundation
@@ -83,7 +83,8 @@ class OBJMeshFileReader
     {
         Default                 = 0,            // none of the flags below
         FavorSpeedOverPrecision = 1 << 0,       // use approximate algorithm for parsing floating-point values
-        StopOnInvalidFaceDef    = 1 << 1        // stop parsing on invalid face definitions
+        StopOnInvalidFaceDef    = 1 << 1,       // stop parsing on invalid face definitions
+        SingleThreaded          = 1 << 2        // parse the file on the calling thread only
     };
 
     // Constructor.
@@ -91,6 +92,10 @@ class OBJMeshFileReader
         const std::string&  filename,
         const int           options = Default);
 
+    // Split the file into chunks of approximately a given size, regardless of the
+    // number of CPU cores. 0 restores the default splitting. Exposed for tests.
+    void set_chunk_size(const size_t chunk_size);
+
     // Read a mesh.
     virtual void read(IMeshBuilder& builder) override;
 
@@ -99,6 +104,7 @@ class OBJMeshFileReader
 
     const std::string       m_filename;
     const int               m_options;
+    size_t                  m_chunk_size;
 };
 
 }       // namespace foundation
@@ -99,4 +99,9 @@ BENCHMARK_SUITE(Foundation_Image_ColorSpace)
     {
         linear_rgb_illuminance_to_spectrum(m_input, m_output);
     }
+
+    BENCHMARK_CASE_F(LinearRGBReflectanceToSpectrum, LinearRGBToSpectrumFixture)
+    {
+        linear_rgb_reflectance_to_spectrum(m_input, m_output);
+    }
 }
@@ -69,6 +69,19 @@ BENCHMARK_SUITE(Foundation_Math_Microfacet)
                     0.0f);
         }
 
+        void evaluate_lobe(const float alpha_x, const float alpha_y)
+        {
+            // Evaluate D, G and pdf as a microfacet BRDF lobe does.
+            const Vector3f incoming = normalize(Vector3f(rand_float2(m_rng), 0.5f, rand_float2(m_rng)));
+            const Vector3f m = normalize(incoming + m_outgoing);
+            const MDFType mdf;
+
+            m_dummy +=
+                mdf.D(m, alpha_x, alpha_y, 0.0f) *
+                mdf.G(incoming, m_outgoing, m, alpha_x, alpha_y, 0.0f) +
+                mdf.pdf(m_outgoing, m, alpha_x, alpha_y, 0.0f);
+        }
+
         void evaluate(const float alpha_x, const float alpha_y)
         {
             Vector2f s;
@@ -139,4 +152,20 @@ BENCHMARK_SUITE(Foundation_Math_Microfacet)
     {
         evaluate(0.5f, 0.5f);
     }
+
+    BENCHMARK_CASE_F(GGXMDF_EvaluateLobe_SeparateTerms, FixtureBase<GGXMDF>)
+    {
+        evaluate_lobe(0.25f, 0.5f);
+    }
+
+    BENCHMARK_CASE_F(GGXMDF_EvaluateLobe_FusedTerms, FixtureBase<GGXMDF>)
+    {
+        const Vector3f incoming = normalize(Vector3f(rand_float2(m_rng), 0.5f, rand_float2(m_rng)));
+        const Vector3f m = normalize(incoming + m_outgoing);
+
+        float d, g, pdf;
+        GGXMDF().evaluate(incoming, m_outgoing, m, 0.25f, 0.5f, 0.0f, d, g, pdf);
+
+        m_dummy += d * g + pdf;
+    }
 }
@@ -57,6 +57,11 @@ BENCHMARK_SUITE(Foundation_Image_RegularSpectrum31f)
         m_spectrum1 += m_spectrum2;
     }
 
+    BENCHMARK_CASE_F(InPlaceSubtraction, Fixture)
+    {
+        m_spectrum1 -= m_spectrum2;
+    }
+
     BENCHMARK_CASE_F(InPlaceMultiplicationByScalar, Fixture)
     {
         m_spectrum1 *= 1.1f;
@@ -66,4 +71,24 @@ BENCHMARK_SUITE(Foundation_Image_RegularSpectrum31f)
     {
         m_spectrum1 *= m_spectrum2;
     }
+
+    BENCHMARK_CASE_F(InPlaceDivisionBySpectrum, Fixture)
+    {
+        m_spectrum1 /= m_spectrum2;
+    }
+
+    BENCHMARK_CASE_F(ClampLowInPlace, Fixture)
+    {
+        clamp_low_in_place(m_spectrum1, 0.0f);
+    }
+
+    BENCHMARK_CASE_F(MaxValue, Fixture)
+    {
+        m_spectrum1[0] = max_value(m_spectrum2);
+    }
+
+    BENCHMARK_CASE_F(SumValue, Fixture)
+    {
+        m_spectrum1[0] = sum_value(m_spectrum2);
+    }
 }
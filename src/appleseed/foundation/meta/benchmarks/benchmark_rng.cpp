@@ -33,6 +33,7 @@
 #ifdef APPLESEED_USE_SSE
 #include "foundation/math/rng/simdmersennetwister.h"
 #endif
+#include "foundation/math/rng/simdxoroshiro128plus.h"
 #include "foundation/math/rng/xoroshiro128plus.h"
 #include "foundation/math/rng/xorshift32.h"
 #include "foundation/math/rng/xorshift64.h"
@@ -117,6 +118,55 @@ BENCHMARK_SUITE(Foundation_Math_RNG)
         }
     }
 
+    BENCHMARK_CASE_F(SimdXoroshiro128plus_RandUint32, Fixture<SimdXoroshiro128plus>)
+    {
+        for (size_t i = 0; i < 250000; ++i)
+        {
+            m_dummy ^= m_rng.rand_uint32();
+            m_dummy ^= m_rng.rand_uint32();
+            m_dummy ^= m_rng.rand_uint32();
+            m_dummy ^= m_rng.rand_uint32();
+        }
+    }
+
+    // Per-pixel usage: seed a generator, then draw a few numbers from it.
+
+    BENCHMARK_CASE_F(Xoroshiro128plus_ConstructAndRandUint32, Fixture<Xoroshiro128plus>)
+    {
+        for (uint64 i = 1; i <= 250000; ++i)
+        {
+            Xoroshiro128plus rng(i, m_dummy);
+            m_dummy ^= rng.rand_uint32();
+            m_dummy ^= rng.rand_uint32();
+            m_dummy ^= rng.rand_uint32();
+            m_dummy ^= rng.rand_uint32();
+        }
+    }
+
+    BENCHMARK_CASE_F(SimdXoroshiro128plus_ConstructAndRandUint32, Fixture<SimdXoroshiro128plus>)
+    {
+        for (uint64 i = 1; i <= 250000; ++i)
+        {
+            SimdXoroshiro128plus rng(i, m_dummy);
+            m_dummy ^= rng.rand_uint32();
+            m_dummy ^= rng.rand_uint32();
+            m_dummy ^= rng.rand_uint32();
+            m_dummy ^= rng.rand_uint32();
+        }
+    }
+
+    BENCHMARK_CASE_F(SimdXoroshiro128plus_ReseedAndRandUint32, Fixture<SimdXoroshiro128plus>)
+    {
+        for (uint64 i = 1; i <= 250000; ++i)
+        {
+            m_rng.reseed(i, m_dummy);
+            m_dummy ^= m_rng.rand_uint32();
+            m_dummy ^= m_rng.rand_uint32();
+            m_dummy ^= m_rng.rand_uint32();
+            m_dummy ^= m_rng.rand_uint32();
+        }
+    }
+
     BENCHMARK_CASE_F(Xorshift32_RandUint32, Fixture<Xorshift32>)
     {
         for (size_t i = 0; i < 250000; ++i)
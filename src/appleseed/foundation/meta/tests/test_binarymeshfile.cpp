@@ -0,0 +1,359 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.foundation headers.
+#include "foundation/core/exceptions/exceptionioerror.h"
+#include "foundation/math/vector.h"
+#include "foundation/mesh/binarymeshfilereader.h"
+#include "foundation/mesh/binarymeshfilewriter.h"
+#include "foundation/mesh/imeshwalker.h"
+#include "foundation/mesh/meshbuilderbase.h"
+#include "foundation/platform/compiler.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace foundation;
+using namespace std;
+
+TEST_SUITE(Foundation_Mesh_BinaryMeshFile)
+{
+    struct Face
+    {
+        vector<size_t>      m_vertices;
+        vector<size_t>      m_vertex_normals;
+        vector<size_t>      m_tex_coords;
+        size_t              m_material;
+    };
+
+    struct Mesh
+    {
+        string              m_name;
+        vector<Vector3d>    m_vertices;
+        vector<Vector3d>    m_vertex_normals;
+        vector<Vector2d>    m_tex_coords;
+        vector<string>      m_material_slots;
+        vector<Face>        m_faces;
+    };
+
+    struct MeshBuilder
+      : public MeshBuilderBase
+    {
+        vector<Mesh>        m_meshes;
+        size_t              m_vertex_count;
+
+        virtual void begin_mesh(const char* name) override
+        {
+            m_meshes.push_back(Mesh());
+            m_meshes.back().m_name = name;
+        }
+
+        virtual size_t push_vertex(const Vector3d& v) override
+        {
+            m_meshes.back().m_vertices.push_back(v);
+            return m_meshes.back().m_vertices.size() - 1;
+        }
+
+        virtual size_t push_vertex_normal(const Vector3d& v) override
+        {
+            m_meshes.back().m_vertex_normals.push_back(v);
+            return m_meshes.back().m_vertex_normals.size() - 1;
+        }
+
+        virtual size_t push_tex_coords(const Vector2d& v) override
+        {
+            m_meshes.back().m_tex_coords.push_back(v);
+            return m_meshes.back().m_tex_coords.size() - 1;
+        }
+
+        virtual size_t push_material_slot(const char* name) override
+        {
+            m_meshes.back().m_material_slots.push_back(name);
+            return m_meshes.back().m_material_slots.size() - 1;
+        }
+
+        virtual void begin_face(const size_t vertex_count) override
+        {
+            m_meshes.back().m_faces.push_back(Face());
+            m_vertex_count = vertex_count;
+        }
+
+        virtual void set_face_vertices(const size_t vertices[]) override
+        {
+            m_meshes.back().m_faces.back().m_vertices.assign(vertices, vertices + m_vertex_count);
+        }
+
+        virtual void set_face_vertex_normals(const size_t vertex_normals[]) override
+        {
+            m_meshes.back().m_faces.back().m_vertex_normals.assign(vertex_normals, vertex_normals + m_vertex_count);
+        }
+
+        virtual void set_face_vertex_tex_coords(const size_t tex_coords[]) override
+        {
+            m_meshes.back().m_faces.back().m_tex_coords.assign(tex_coords, tex_coords + m_vertex_count);
+        }
+
+        virtual void set_face_material(const size_t material) override
+        {
+            m_meshes.back().m_faces.back().m_material = material;
+        }
+    };
+
+    struct MeshWalker
+      : public IMeshWalker
+    {
+        const Mesh& m_mesh;
+
+        explicit MeshWalker(const Mesh& mesh)
+          : m_mesh(mesh)
+        {
+        }
+
+        virtual const char* get_name() const override
+        {
+            return m_mesh.m_name.c_str();
+        }
+
+        virtual size_t get_vertex_count() const override
+        {
+            return m_mesh.m_vertices.size();
+        }
+
+        virtual Vector3d get_vertex(const size_t i) const override
+        {
+            return m_mesh.m_vertices[i];
+        }
+
+        virtual size_t get_vertex_normal_count() const override
+        {
+            return m_mesh.m_vertex_normals.size();
+        }
+
+        virtual Vector3d get_vertex_normal(const size_t i) const override
+        {
+            return m_mesh.m_vertex_normals[i];
+        }
+
+        virtual size_t get_tex_coords_count() const override
+        {
+            return m_mesh.m_tex_coords.size();
+        }
+
+        virtual Vector2d get_tex_coords(const size_t i) const override
+        {
+            return m_mesh.m_tex_coords[i];
+        }
+
+        virtual size_t get_material_slot_count() const override
+        {
+            return m_mesh.m_material_slots.size();
+        }
+
+        virtual const char* get_material_slot(const size_t i) const override
+        {
+            return m_mesh.m_material_slots[i].c_str();
+        }
+
+        virtual size_t get_face_count() const override
+        {
+            return m_mesh.m_faces.size();
+        }
+
+        virtual size_t get_face_vertex_count(const size_t face_index) const override
+        {
+            return m_mesh.m_faces[face_index].m_vertices.size();
+        }
+
+        virtual size_t get_face_vertex(const size_t face_index, const size_t vertex_index) const override
+        {
+            return m_mesh.m_faces[face_index].m_vertices[vertex_index];
+        }
+
+        virtual size_t get_face_vertex_normal(const size_t face_index, const size_t vertex_index) const override
+        {
+            return m_mesh.m_faces[face_index].m_vertex_normals[vertex_index];
+        }
+
+        virtual size_t get_face_tex_coords(const size_t face_index, const size_t vertex_index) const override
+        {
+            return m_mesh.m_faces[face_index].m_tex_coords[vertex_index];
+        }
+
+        virtual size_t get_face_material(const size_t face_index) const override
+        {
+            return m_mesh.m_faces[face_index].m_material;
+        }
+    };
+
+    Mesh create_quad_mesh()
+    {
+        Mesh mesh;
+        mesh.m_name = "quad";
+
+        mesh.m_vertices.push_back(Vector3d(0.0, 0.0, 0.0));
+        mesh.m_vertices.push_back(Vector3d(1.0, 0.0, 0.0));
+        mesh.m_vertices.push_back(Vector3d(1.0, 1.0, 0.0));
+        mesh.m_vertices.push_back(Vector3d(0.0, 1.0, 0.0));
+
+        mesh.m_vertex_normals.push_back(Vector3d(0.0, 0.0, 1.0));
+
+        mesh.m_tex_coords.push_back(Vector2d(0.0, 0.0));
+        mesh.m_tex_coords.push_back(Vector2d(1.0, 0.0));
+        mesh.m_tex_coords.push_back(Vector2d(1.0, 1.0));
+        mesh.m_tex_coords.push_back(Vector2d(0.0, 1.0));
+
+        mesh.m_material_slots.push_back("front");
+        mesh.m_material_slots.push_back("back");
+
+        Face face;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            face.m_vertices.push_back(i);
+            face.m_vertex_normals.push_back(0);
+            face.m_tex_coords.push_back(i);
+        }
+        face.m_material = 1;
+        mesh.m_faces.push_back(face);
+
+        return mesh;
+    }
+
+    // A mesh large enough to be split into multiple blocks.
+    Mesh create_grid_mesh(const size_t resolution)
+    {
+        Mesh mesh;
+        mesh.m_name = "grid";
+
+        for (size_t y = 0; y <= resolution; ++y)
+        {
+            for (size_t x = 0; x <= resolution; ++x)
+                mesh.m_vertices.push_back(Vector3d(static_cast<double>(x), static_cast<double>(y), 0.0));
+        }
+
+        for (size_t y = 0; y < resolution; ++y)
+        {
+            for (size_t x = 0; x < resolution; ++x)
+            {
+                const size_t v0 = y * (resolution + 1) + x;
+
+                Face face;
+                face.m_vertices.push_back(v0);
+                face.m_vertices.push_back(v0 + 1);
+                face.m_vertices.push_back(v0 + resolution + 2);
+                face.m_material = 0;
+                mesh.m_faces.push_back(face);
+            }
+        }
+
+        return mesh;
+    }
+
+    TEST_CASE(ReadWrittenMeshes)
+    {
+        const char* Filename = "unit tests/outputs/test_binarymeshfile.binarymesh";
+
+        const Mesh quad = create_quad_mesh();
+        const Mesh grid = create_grid_mesh(400);
+
+        {
+            BinaryMeshFileWriter writer(Filename);
+            writer.write(MeshWalker(quad));
+            writer.write(MeshWalker(grid));
+        }
+
+        BinaryMeshFileReader reader(Filename);
+        MeshBuilder builder;
+        reader.read(builder);
+
+        ASSERT_EQ(2, builder.m_meshes.size());
+
+        const Mesh& read_quad = builder.m_meshes[0];
+        EXPECT_EQ("quad", read_quad.m_name);
+        ASSERT_EQ(4, read_quad.m_vertices.size());
+        EXPECT_SEQUENCE_EQ(4, &quad.m_vertices[0], &read_quad.m_vertices[0]);
+        ASSERT_EQ(1, read_quad.m_vertex_normals.size());
+        EXPECT_EQ(quad.m_vertex_normals[0], read_quad.m_vertex_normals[0]);
+        ASSERT_EQ(4, read_quad.m_tex_coords.size());
+        EXPECT_SEQUENCE_EQ(4, &quad.m_tex_coords[0], &read_quad.m_tex_coords[0]);
+        ASSERT_EQ(2, read_quad.m_material_slots.size());
+        EXPECT_EQ("front", read_quad.m_material_slots[0]);
+        EXPECT_EQ("back", read_quad.m_material_slots[1]);
+        ASSERT_EQ(1, read_quad.m_faces.size());
+        ASSERT_EQ(4, read_quad.m_faces[0].m_vertices.size());
+        EXPECT_SEQUENCE_EQ(4, &quad.m_faces[0].m_vertices[0], &read_quad.m_faces[0].m_vertices[0]);
+        ASSERT_EQ(4, read_quad.m_faces[0].m_vertex_normals.size());
+        EXPECT_SEQUENCE_EQ(4, &quad.m_faces[0].m_vertex_normals[0], &read_quad.m_faces[0].m_vertex_normals[0]);
+        ASSERT_EQ(4, read_quad.m_faces[0].m_tex_coords.size());
+        EXPECT_SEQUENCE_EQ(4, &quad.m_faces[0].m_tex_coords[0], &read_quad.m_faces[0].m_tex_coords[0]);
+        EXPECT_EQ(1, read_quad.m_faces[0].m_material);
+
+        const Mesh& read_grid = builder.m_meshes[1];
+        EXPECT_EQ("grid", read_grid.m_name);
+        ASSERT_EQ(grid.m_vertices.size(), read_grid.m_vertices.size());
+        EXPECT_SEQUENCE_EQ(grid.m_vertices.size(), &grid.m_vertices[0], &read_grid.m_vertices[0]);
+        EXPECT_TRUE(read_grid.m_vertex_normals.empty());
+        EXPECT_TRUE(read_grid.m_tex_coords.empty());
+        ASSERT_EQ(grid.m_faces.size(), read_grid.m_faces.size());
+        ASSERT_EQ(3, read_grid.m_faces.back().m_vertices.size());
+        EXPECT_SEQUENCE_EQ(3, &grid.m_faces.back().m_vertices[0], &read_grid.m_faces.back().m_vertices[0]);
+        EXPECT_TRUE(read_grid.m_faces.back().m_vertex_normals.empty());
+        EXPECT_EQ(0, read_grid.m_faces.back().m_material);
+    }
+
+    TEST_CASE(Read_GivenFaceWithFewerThanThreeVertices_ThrowsExceptionIOError)
+    {
+        const char* Filename = "unit tests/outputs/test_binarymeshfile_degenerateface.binarymesh";
+
+        Mesh mesh = create_quad_mesh();
+
+        Face face;
+        face.m_vertices.push_back(0);
+        face.m_vertices.push_back(1);
+        face.m_vertex_normals.push_back(0);
+        face.m_vertex_normals.push_back(0);
+        face.m_tex_coords.push_back(0);
+        face.m_tex_coords.push_back(1);
+        face.m_material = 0;
+        mesh.m_faces.push_back(face);
+
+        {
+            BinaryMeshFileWriter writer(Filename);
+            writer.write(MeshWalker(mesh));
+        }
+
+        BinaryMeshFileReader reader(Filename);
+        MeshBuilder builder;
+
+        EXPECT_EXCEPTION(ExceptionIOError, reader.read(builder));
+    }
+}
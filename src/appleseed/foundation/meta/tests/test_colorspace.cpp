@@ -512,6 +512,39 @@ TEST_SUITE(Foundation_Image_ColorSpace)
             1.0e-6f);
     }
 
+    TEST_CASE(TestLinearRGBReflectanceToSpectrumConversion)
+    {
+        // One color per ordering of the RGB channels, with the combination
+        // of basis spectra it must be converted to.
+        const Color3f Colors[6] =
+        {
+            Color3f(0.1f, 0.3f, 0.6f),
+            Color3f(0.1f, 0.6f, 0.3f),
+            Color3f(0.3f, 0.1f, 0.6f),
+            Color3f(0.6f, 0.1f, 0.3f),
+            Color3f(0.3f, 0.6f, 0.1f),
+            Color3f(0.6f, 0.3f, 0.1f)
+        };
+
+        const RegularSpectrum31f Expected[6] =
+        {
+            RGBToSpectrumWhiteReflectance * 0.1f + RGBToSpectrumCyanReflectance * 0.2f + RGBToSpectrumBlueReflectance * 0.3f,
+            RGBToSpectrumWhiteReflectance * 0.1f + RGBToSpectrumCyanReflectance * 0.2f + RGBToSpectrumGreenReflectance * 0.3f,
+            RGBToSpectrumWhiteReflectance * 0.1f + RGBToSpectrumMagentaReflectance * 0.2f + RGBToSpectrumBlueReflectance * 0.3f,
+            RGBToSpectrumWhiteReflectance * 0.1f + RGBToSpectrumMagentaReflectance * 0.2f + RGBToSpectrumRedReflectance * 0.3f,
+            RGBToSpectrumWhiteReflectance * 0.1f + RGBToSpectrumYellowReflectance * 0.2f + RGBToSpectrumGreenReflectance * 0.3f,
+            RGBToSpectrumWhiteReflectance * 0.1f + RGBToSpectrumYellowReflectance * 0.2f + RGBToSpectrumRedReflectance * 0.3f
+        };
+
+        for (size_t i = 0; i < 6; ++i)
+        {
+            RegularSpectrum31f spectrum;
+            linear_rgb_reflectance_to_spectrum_unclamped(Colors[i], spectrum);
+
+            EXPECT_FEQ_EPS(Expected[i], spectrum, 1.0e-6f);
+        }
+    }
+
     TEST_CASE(TestSpectrumToSpectrumConversion)
     {
         static const float InputWavelength[RegularSpectrum31f::Samples] =
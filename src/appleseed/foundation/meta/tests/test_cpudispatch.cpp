@@ -0,0 +1,67 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.foundation headers.
+#include "foundation/platform/cpudispatch.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+
+TEST_SUITE(Foundation_Platform_CPUDispatch)
+{
+    TEST_CASE(GetDispatchInstructionSet_ReturnsInstructionSetAtLeastAsWideAsCompiledInstructionSet)
+    {
+        EXPECT_TRUE(get_dispatch_instruction_set() >= get_compiled_instruction_set());
+    }
+
+    TEST_CASE(ParseInstructionSetName_GivenNameOfInstructionSet_ReturnsInstructionSet)
+    {
+        InstructionSet isa;
+        const bool success = parse_instruction_set_name(get_instruction_set_name(InstructionSetAVX2), isa);
+
+        ASSERT_TRUE(success);
+        EXPECT_EQ(InstructionSetAVX2, isa);
+    }
+
+    TEST_CASE(ParseInstructionSetName_IsCaseInsensitive)
+    {
+        InstructionSet isa;
+        const bool success = parse_instruction_set_name("avx-512", isa);
+
+        ASSERT_TRUE(success);
+        EXPECT_EQ(InstructionSetAVX512, isa);
+    }
+
+    TEST_CASE(ParseInstructionSetName_GivenUnknownName_ReturnsFalse)
+    {
+        InstructionSet isa;
+
+        EXPECT_FALSE(parse_instruction_set_name("mmx", isa));
+    }
+}
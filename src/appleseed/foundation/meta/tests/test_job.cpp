@@ -36,6 +36,7 @@
 #include "foundation/utility/job/ijob.h"
 #include "foundation/utility/job/jobmanager.h"
 #include "foundation/utility/job/jobqueue.h"
+#include "foundation/utility/job/parallelfor.h"
 #include "foundation/utility/job/workerthread.h"
 #include "foundation/utility/log.h"
 #include "foundation/utility/test.h"
@@ -44,6 +45,7 @@
 #include <cstddef>
 #include <exception>
 #include <utility>
+#include <vector>
 
 using namespace foundation;
 using namespace std;
@@ -484,3 +486,48 @@ TEST_SUITE(Foundation_Utility_Job_WorkerThread)
         EXPECT_EQ(1, execution_count);
     }
 }
+
+TEST_SUITE(Foundation_Utility_Job_ParallelFor)
+{
+    struct IncrementSlot
+    {
+        vector<uint32>* m_slots;
+
+        void operator()(const size_t i)
+        {
+            ++(*m_slots)[i];
+        }
+    };
+
+    TEST_CASE(ParallelFor_GivenZeroCount_DoesNothing)
+    {
+        vector<uint32> slots;
+        IncrementSlot func = { &slots };
+
+        parallel_for(0, func, 4);
+
+        EXPECT_TRUE(slots.empty());
+    }
+
+    TEST_CASE(ParallelFor_GivenMoreIndicesThanThreads_CallsFunctionOnceForEveryIndex)
+    {
+        vector<uint32> slots(1000, 0);
+        IncrementSlot func = { &slots };
+
+        parallel_for(slots.size(), func, 4);
+
+        for (size_t i = 0; i < slots.size(); ++i)
+            EXPECT_EQ(1, slots[i]);
+    }
+
+    TEST_CASE(ParallelFor_GivenMoreThreadsThanIndices_CallsFunctionOnceForEveryIndex)
+    {
+        vector<uint32> slots(3, 0);
+        IncrementSlot func = { &slots };
+
+        parallel_for(slots.size(), func, 16);
+
+        for (size_t i = 0; i < slots.size(); ++i)
+            EXPECT_EQ(1, slots[i]);
+    }
+}
@@ -36,6 +36,7 @@
 #include "foundation/utility/test.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 
@@ -337,6 +338,34 @@ TEST_SUITE(Foundation_Math_Microfacet)
         EXPECT_WEAK_WHITE_FURNACE_PASS(result)
     }
 
+    TEST_CASE(GGXMDF_Evaluate_MatchesSeparateEvaluations)
+    {
+        const GGXMDF mdf;
+        const float AlphaX = 0.25f;
+        const float AlphaY = 0.5f;
+
+        const size_t SampleCount = 64;
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            static const size_t Bases[] = { 2, 3 };
+            const Vector3f s = hammersley_sequence<float, 3>(Bases, SampleCount, i);
+            const Vector3f outgoing = sample_hemisphere_uniform(Vector2f(s[0], s[1]));
+            const Vector3f incoming = sample_hemisphere_cosine(Vector2f(s[2], s[1]));
+            const Vector3f m = normalize(incoming + outgoing);
+
+            float d, g, pdf;
+            mdf.evaluate(incoming, outgoing, m, AlphaX, AlphaY, 0.0f, d, g, pdf);
+
+            const float expected_d = mdf.D(m, AlphaX, AlphaY, 0.0f);
+            const float expected_g = mdf.G(incoming, outgoing, m, AlphaX, AlphaY, 0.0f);
+            const float expected_pdf = mdf.pdf(outgoing, m, AlphaX, AlphaY, 0.0f);
+
+            EXPECT_FEQ_EPS(expected_d, d, 1.0e-3f * max(expected_d, 1.0f));
+            EXPECT_FEQ_EPS(expected_g, g, 1.0e-4f);
+            EXPECT_FEQ_EPS(expected_pdf, pdf, 1.0e-3f * max(expected_pdf, 1.0f));
+        }
+    }
+
 
     //
     // Ward MDF.
@@ -32,6 +32,9 @@
 #include "foundation/mesh/meshbuilderbase.h"
 #include "foundation/mesh/objmeshfilereader.h"
 #include "foundation/platform/compiler.h"
+#include "foundation/utility/countof.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/string.h"
 #include "foundation/utility/test.h"
 
 // Standard headers.
@@ -121,4 +124,156 @@ TEST_SUITE(Foundation_Mesh_OBJMeshFileReader)
         EXPECT_EQ(4, mesh.m_tex_coords.size());
         EXPECT_EQ(1, mesh.m_faces.size());
     }
+
+    // A mesh builder that records all the calls it receives.
+    struct RecordingMeshBuilder
+      : public MeshBuilderBase
+    {
+        vector<string>      m_calls;
+        size_t              m_vertex_count;
+        size_t              m_vertex_normal_count;
+        size_t              m_tex_coords_count;
+        size_t              m_material_slot_count;
+        size_t              m_face_vertex_count;
+
+        virtual void begin_mesh(const char* name) override
+        {
+            m_calls.push_back(string("begin_mesh ") + name);
+            m_vertex_count = 0;
+            m_vertex_normal_count = 0;
+            m_tex_coords_count = 0;
+            m_material_slot_count = 0;
+        }
+
+        virtual size_t push_vertex(const Vector3d& v) override
+        {
+            m_calls.push_back("push_vertex " + to_string(v));
+            return m_vertex_count++;
+        }
+
+        virtual size_t push_vertex_normal(const Vector3d& v) override
+        {
+            m_calls.push_back("push_vertex_normal " + to_string(v));
+            return m_vertex_normal_count++;
+        }
+
+        virtual size_t push_tex_coords(const Vector2d& v) override
+        {
+            m_calls.push_back("push_tex_coords " + to_string(v));
+            return m_tex_coords_count++;
+        }
+
+        virtual size_t push_material_slot(const char* name) override
+        {
+            m_calls.push_back(string("push_material_slot ") + name);
+            return m_material_slot_count++;
+        }
+
+        virtual void begin_face(const size_t vertex_count) override
+        {
+            m_calls.push_back("begin_face " + to_string(vertex_count));
+            m_face_vertex_count = vertex_count;
+        }
+
+        virtual void set_face_vertices(const size_t vertices[]) override
+        {
+            m_calls.push_back("set_face_vertices " + to_string(vertices, m_face_vertex_count));
+        }
+
+        virtual void set_face_vertex_normals(const size_t vertex_normals[]) override
+        {
+            m_calls.push_back("set_face_vertex_normals " + to_string(vertex_normals, m_face_vertex_count));
+        }
+
+        virtual void set_face_vertex_tex_coords(const size_t tex_coords[]) override
+        {
+            m_calls.push_back("set_face_vertex_tex_coords " + to_string(tex_coords, m_face_vertex_count));
+        }
+
+        virtual void set_face_material(const size_t material) override
+        {
+            m_calls.push_back("set_face_material " + to_string(material));
+        }
+
+        virtual void end_mesh() override
+        {
+            m_calls.push_back("end_mesh");
+        }
+    };
+
+    vector<string> read_calls(
+        const char*     filename,
+        const size_t    chunk_size,
+        const int       options = OBJMeshFileReader::Default)
+    {
+        OBJMeshFileReader reader(filename, options);
+        reader.set_chunk_size(chunk_size);
+
+        RecordingMeshBuilder builder;
+        reader.read(builder);
+
+        return builder.m_calls;
+    }
+
+    size_t read_parse_error_line(const char* filename, const size_t chunk_size)
+    {
+        try
+        {
+            read_calls(filename, chunk_size);
+        }
+        catch (const OBJMeshFileReader::ExceptionParseError& e)
+        {
+            return e.m_line;
+        }
+
+        return 0;
+    }
+
+    const size_t ChunkSizes[] = { 16, 50, 128 };
+
+    TEST_CASE(Read_GivenSmallChunks_MatchesSequentialRead)
+    {
+        const char* Filename = "unit tests/inputs/test_objmeshfilereader_chunks.obj";
+
+        const vector<string> expected = read_calls(Filename, 0);
+        ASSERT_FALSE(expected.empty());
+
+        for (size_t i = 0; i < countof(ChunkSizes); ++i)
+        {
+            const vector<string> calls = read_calls(Filename, ChunkSizes[i]);
+            EXPECT_SEQUENCE_EQ(expected.size(), &expected[0], &calls[0]);
+        }
+    }
+
+    TEST_CASE(Read_GivenSmallChunksOnSingleThread_MatchesSequentialRead)
+    {
+        const char* Filename = "unit tests/inputs/test_objmeshfilereader_chunks.obj";
+
+        const vector<string> expected = read_calls(Filename, 0);
+        ASSERT_FALSE(expected.empty());
+
+        const vector<string> calls = read_calls(Filename, 16, OBJMeshFileReader::SingleThreaded);
+        ASSERT_EQ(expected.size(), calls.size());
+        EXPECT_SEQUENCE_EQ(expected.size(), &expected[0], &calls[0]);
+    }
+
+    TEST_CASE(Read_GivenSmallChunksAndLexicalErrorInLaterChunk_ReportsLineOfError)
+    {
+        const char* Filename = "unit tests/inputs/test_objmeshfilereader_chunks_lexicalerror.obj";
+
+        EXPECT_EQ(33, read_parse_error_line(Filename, 0));
+
+        for (size_t i = 0; i < countof(ChunkSizes); ++i)
+            EXPECT_EQ(33, read_parse_error_line(Filename, ChunkSizes[i]));
+    }
+
+    TEST_CASE(Read_GivenSmallChunksAndInvalidIndexInLaterChunk_ReportsLineOfError)
+    {
+        const char* Filename = "unit tests/inputs/test_objmeshfilereader_chunks_indexerror.obj";
+
+        EXPECT_EQ(36, read_parse_error_line(Filename, 0));
+
+        for (size_t i = 0; i < countof(ChunkSizes); ++i)
+            EXPECT_EQ(36, read_parse_error_line(Filename, ChunkSizes[i]));
+    }
 }
@@ -0,0 +1,113 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/color.h"
+#include "foundation/image/genericprogressiveimagefilereader.h"
+#include "foundation/image/image.h"
+#include "foundation/image/imageattributes.h"
+#include "foundation/image/pixel.h"
+#include "foundation/image/progressiveexrimagefilewriter.h"
+#include "foundation/image/tile.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <memory>
+
+using namespace foundation;
+using namespace std;
+
+TEST_SUITE(Foundation_Image_ProgressiveEXRImageFileWriter)
+{
+    static const char* Filename = "unit tests/outputs/test_progressiveexrimagefilewriter.exr";
+
+    Color4f get_tile_color(const size_t tile_x, const size_t tile_y)
+    {
+        return Color4f(0.25f * tile_x, 0.5f * tile_y, 0.5f, 1.0f);
+    }
+
+    TEST_CASE(WriteTilesInReverseOrder_ReadBackTiles)
+    {
+        // 3x2 tiles, the last column and the last row are partial.
+        Image image(5, 3, 2, 2, 4, PixelFormatFloat);
+        const CanvasProperties& props = image.properties();
+
+        for (size_t ty = 0; ty < props.m_tile_count_y; ++ty)
+        {
+            for (size_t tx = 0; tx < props.m_tile_count_x; ++tx)
+                image.tile(tx, ty).clear(get_tile_color(tx, ty));
+        }
+
+        {
+            static const char* ChannelNames[] = {"R", "G", "B", "A"};
+
+            ProgressiveEXRImageFileWriter writer;
+            writer.append_part(
+                "beauty",
+                props,
+                ImageAttributes::create_default_attributes(),
+                PixelFormatHalf,
+                4,
+                ChannelNames);
+            writer.open(Filename);
+
+            for (size_t i = props.m_tile_count; i > 0; --i)
+            {
+                const size_t tx = (i - 1) % props.m_tile_count_x;
+                const size_t ty = (i - 1) / props.m_tile_count_x;
+                writer.write_tile(0, image.tile(tx, ty), tx, ty);
+            }
+
+            writer.close();
+        }
+
+        GenericProgressiveImageFileReader reader;
+        reader.open(Filename);
+
+        CanvasProperties read_props;
+        reader.read_canvas_properties(read_props);
+        ASSERT_EQ(props.m_canvas_width, read_props.m_canvas_width);
+        ASSERT_EQ(props.m_canvas_height, read_props.m_canvas_height);
+
+        for (size_t ty = 0; ty < props.m_tile_count_y; ++ty)
+        {
+            for (size_t tx = 0; tx < props.m_tile_count_x; ++tx)
+            {
+                auto_ptr<Tile> tile(reader.read_tile(tx, ty));
+
+                Color4f c;
+                tile->get_pixel(tile->get_pixel_count() - 1, c);
+                EXPECT_EQ(get_tile_color(tx, ty), c);
+            }
+        }
+    }
+}
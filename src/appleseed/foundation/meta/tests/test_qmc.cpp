@@ -40,6 +40,7 @@
 #include "foundation/math/scalar.h"
 #include "foundation/math/vector.h"
 #include "foundation/platform/arch.h"
+#include "foundation/platform/types.h"
 #include "foundation/utility/gnuplotfile.h"
 #include "foundation/utility/string.h"
 #include "foundation/utility/test.h"
@@ -482,6 +483,74 @@ TEST_SUITE(Foundation_Math_QMC)
 
 #endif
 
+    TEST_CASE(ReverseBits)
+    {
+        EXPECT_EQ(0x00000000UL, reverse_bits(0x00000000UL));
+        EXPECT_EQ(0x80000000UL, reverse_bits(0x00000001UL));
+        EXPECT_EQ(0x0000000FUL, reverse_bits(0xF0000000UL));
+        EXPECT_EQ(0x1E6A2C48UL, reverse_bits(0x12345678UL));
+    }
+
+    TEST_CASE(SobolUInt32_FirstDimension_MatchesRadicalInverseBase2)
+    {
+        for (uint32 i = 0; i < 64; ++i)
+            EXPECT_EQ(reverse_bits(i), sobol_uint32(0, i));
+    }
+
+    TEST_CASE(SobolUInt32_SecondDimension)
+    {
+        EXPECT_EQ(0x00000000UL, sobol_uint32(1, 0));
+        EXPECT_EQ(0x80000000UL, sobol_uint32(1, 1));
+        EXPECT_EQ(0xC0000000UL, sobol_uint32(1, 2));
+        EXPECT_EQ(0x40000000UL, sobol_uint32(1, 3));
+    }
+
+    TEST_CASE(OwenScrambledSobolSequence_FirstPowerOfTwoPoints_FormNet)
+    {
+        const size_t GridSize = 8;
+        const size_t SampleCount = GridSize * GridSize;
+
+        for (uint32 seed = 0; seed < 4; ++seed)
+        {
+            size_t strata_x[SampleCount] = { 0 };
+            size_t strata_y[SampleCount] = { 0 };
+            size_t strata_xy[SampleCount] = { 0 };
+
+            for (uint32 i = 0; i < SampleCount; ++i)
+            {
+                const Vector2f p = owen_scrambled_sobol_sequence<float, 2>(seed, i);
+
+                ASSERT_TRUE(p.x >= 0.0f && p.x < 1.0f);
+                ASSERT_TRUE(p.y >= 0.0f && p.y < 1.0f);
+
+                const size_t x = truncate<size_t>(p.x * SampleCount);
+                const size_t y = truncate<size_t>(p.y * SampleCount);
+
+                ++strata_x[x];
+                ++strata_y[y];
+                ++strata_xy[(y / GridSize) * GridSize + x / GridSize];
+            }
+
+            // Every elementary interval of the (0, 6, 2)-net must contain exactly one point.
+            for (size_t i = 0; i < SampleCount; ++i)
+            {
+                EXPECT_EQ(1, strata_x[i]);
+                EXPECT_EQ(1, strata_y[i]);
+                EXPECT_EQ(1, strata_xy[i]);
+            }
+        }
+    }
+
+    TEST_CASE(Generate2DOwenScrambledSobolSequenceImage)
+    {
+        vector<Vector2d> points;
+
+        for (size_t i = 0; i < PointCount; ++i)
+            points.push_back(owen_scrambled_sobol_sequence<double, 2>(0, static_cast<uint32>(i)));
+
+        write_point_cloud_image("unit tests/outputs/test_qmc_owen_scrambled_sobol.png", points);
+    }
+
     TEST_CASE(Integrate1DFunction)
     {
         const double ExactArea = 2.0;
@@ -39,6 +39,14 @@ using namespace foundation;
 
 TEST_SUITE(Foundation_Image_RegularSpectrum31f)
 {
+    const float InputValues[31] =
+    {
+         1.0f,  2.0f,  3.0f,  4.0f,  5.0f,  6.0f,  7.0f,  8.0f,
+         9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f,
+        17.0f, 18.0f, 19.0f, 20.0f, 21.0f, 22.0f, 23.0f, 24.0f,
+        25.0f, 26.0f, 27.0f, 28.0f, 29.0f, 30.0f, 31.0f
+    };
+
     TEST_CASE(Set)
     {
         static const float ExpectedValues[31] =
@@ -59,14 +67,6 @@ TEST_SUITE(Foundation_Image_RegularSpectrum31f)
 
     TEST_CASE(InPlaceAddition)
     {
-        static const float InputValues[31] =
-        {
-             1.0f,  2.0f,  3.0f,  4.0f,  5.0f,  6.0f,  7.0f,  8.0f,
-             9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f,
-            17.0f, 18.0f, 19.0f, 20.0f, 21.0f, 22.0f, 23.0f, 24.0f,
-            25.0f, 26.0f, 27.0f, 28.0f, 29.0f, 30.0f, 31.0f
-        };
-
         static const float RhsValues[31] =
         {
             31.0f, 30.0f, 29.0f, 28.0f, 27.0f, 26.0f, 25.0f, 24.0f,
@@ -86,14 +86,6 @@ TEST_SUITE(Foundation_Image_RegularSpectrum31f)
 
     TEST_CASE(InPlaceMultiplicationByScalar)
     {
-        static const float InputValues[31] =
-        {
-             1.0f,  2.0f,  3.0f,  4.0f,  5.0f,  6.0f,  7.0f,  8.0f,
-             9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f,
-            17.0f, 18.0f, 19.0f, 20.0f, 21.0f, 22.0f, 23.0f, 24.0f,
-            25.0f, 26.0f, 27.0f, 28.0f, 29.0f, 30.0f, 31.0f
-        };
-
         static const float ExpectedValues[31] =
         {
              2.0f,  4.0f,  6.0f,  8.0f, 10.0f, 12.0f, 14.0f, 16.0f,
@@ -112,14 +104,6 @@ TEST_SUITE(Foundation_Image_RegularSpectrum31f)
 
     TEST_CASE(InPlaceMultiplicationBySpectrum)
     {
-        static const float InputValues[31] =
-        {
-              1.0f,   2.0f,   3.0f,   4.0f,   5.0f,   6.0f,   7.0f,   8.0f,
-              9.0f,  10.0f,  11.0f,  12.0f,  13.0f,  14.0f,  15.0f,  16.0f,
-             17.0f,  18.0f,  19.0f,  20.0f,  21.0f,  22.0f,  23.0f,  24.0f,
-             25.0f,  26.0f,  27.0f,  28.0f,  29.0f,  30.0f,  31.0f
-        };
-
         static const float RhsValues[31] =
         {
              31.0f,  30.0f,  29.0f,  28.0f,  27.0f,  26.0f,  25.0f,  24.0f,
@@ -145,16 +129,67 @@ TEST_SUITE(Foundation_Image_RegularSpectrum31f)
         EXPECT_FEQ(Expected, s);
     }
 
-    TEST_CASE(Rcp)
+    TEST_CASE(InPlaceSubtraction)
+    {
+        const RegularSpectrum31f Expected(-1.0f);
+        const auto Rhs(RegularSpectrum31f::from_array(InputValues));
+        auto s(RegularSpectrum31f::from_array(InputValues));
+
+        s -= Rhs;
+        s -= RegularSpectrum31f(1.0f);
+
+        EXPECT_FEQ(Expected, s);
+    }
+
+    TEST_CASE(InPlaceDivisionBySpectrum)
+    {
+        const RegularSpectrum31f Expected(1.0f);
+        const auto Rhs(RegularSpectrum31f::from_array(InputValues));
+        auto s(RegularSpectrum31f::from_array(InputValues));
+
+        s /= Rhs;
+
+        EXPECT_FEQ(Expected, s);
+    }
+
+    TEST_CASE(ClampLowInPlace)
     {
-        static const float InputValues[31] =
+        static const float ExpectedValues[31] =
         {
-              1.0f,   2.0f,   3.0f,   4.0f,   5.0f,   6.0f,   7.0f,   8.0f,
-              9.0f,  10.0f,  11.0f,  12.0f,  13.0f,  14.0f,  15.0f,  16.0f,
+             16.0f,  16.0f,  16.0f,  16.0f,  16.0f,  16.0f,  16.0f,  16.0f,
+             16.0f,  16.0f,  16.0f,  16.0f,  16.0f,  16.0f,  16.0f,  16.0f,
              17.0f,  18.0f,  19.0f,  20.0f,  21.0f,  22.0f,  23.0f,  24.0f,
              25.0f,  26.0f,  27.0f,  28.0f,  29.0f,  30.0f,  31.0f
         };
 
+        const auto Expected(RegularSpectrum31f::from_array(ExpectedValues));
+        auto s(RegularSpectrum31f::from_array(InputValues));
+
+        clamp_low_in_place(s, 16.0f);
+
+        EXPECT_FEQ(Expected, s);
+    }
+
+    TEST_CASE(SumValue_IgnoresPaddingValue)
+    {
+        auto s(RegularSpectrum31f::from_array(InputValues));
+        s[31] = 1000.0f;
+
+        EXPECT_FEQ(496.0f, sum_value(s));
+    }
+
+    TEST_CASE(MinAndMaxValues_IgnorePaddingValue)
+    {
+        auto s(RegularSpectrum31f::from_array(InputValues));
+        s[31] = 1000.0f;
+        EXPECT_EQ(31.0f, max_value(s));
+
+        s[31] = -1000.0f;
+        EXPECT_EQ(1.0f, min_value(s));
+    }
+
+    TEST_CASE(Rcp)
+    {
         static const float ExpectedValues[31] =
         {
              1.0f / 1.0f,  1.0f / 2.0f,  1.0f / 3.0f,  1.0f / 4.0f,  1.0f / 5.0f,  1.0f / 6.0f,  1.0f / 7.0f,  1.0f / 8.0f,
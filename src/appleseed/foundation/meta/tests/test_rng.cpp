@@ -34,6 +34,9 @@
 #ifdef APPLESEED_USE_SSE
 #include "foundation/math/rng/simdmersennetwister.h"
 #endif
+#include "foundation/math/rng/simdxoroshiro128plus.h"
+#include "foundation/math/rng/xoroshiro128plus.h"
+#include "foundation/math/scalar.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/countof.h"
 #include "foundation/utility/test.h"
@@ -997,3 +1000,50 @@ TEST_SUITE(Foundation_Math_RNG_SimdMersenneTwister)
 }
 
 #endif
+
+TEST_SUITE(Foundation_Math_RNG_SimdXoroshiro128plus)
+{
+    uint64 splitmix64(uint64& x)
+    {
+        uint64 z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    TEST_CASE(RandUint32_MatchesInterleavedXoroshiro128plus)
+    {
+        const uint64 S0 = 0x0123456789ABCDEFULL;
+        const uint64 S1 = 0xFEDCBA9876543210ULL;
+
+        SimdXoroshiro128plus rng(S0, S1);
+
+        // Reproduce the seeding of the four interleaved generators.
+        Xoroshiro128plus lanes[SimdXoroshiro128plus::LaneCount];
+        uint64 x = S0 ^ rotl64(S1, 32);
+        for (size_t i = 0; i < SimdXoroshiro128plus::LaneCount; ++i)
+        {
+            const uint64 s0 = splitmix64(x);
+            const uint64 s1 = splitmix64(x);
+            lanes[i] = Xoroshiro128plus(s0, s1);
+        }
+
+        for (size_t i = 0; i < 1000; ++i)
+            EXPECT_EQ(lanes[i % SimdXoroshiro128plus::LaneCount].rand_uint32(), rng.rand_uint32());
+    }
+
+    TEST_CASE(Reseed_PartiallyConsumedGenerator_MatchesNewlyConstructedGenerator)
+    {
+        SimdXoroshiro128plus rng(1, 2);
+
+        for (size_t i = 0; i < 7; ++i)
+            rng.rand_uint32();
+
+        rng.reseed(3, 4);
+
+        SimdXoroshiro128plus expected(3, 4);
+
+        for (size_t i = 0; i < 100; ++i)
+            EXPECT_EQ(expected.rand_uint32(), rng.rand_uint32());
+    }
+}
@@ -0,0 +1,147 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "cpudispatch.h"
+
+// appleseed.foundation headers.
+#include "foundation/platform/system.h"
+#include "foundation/utility/countof.h"
+#include "foundation/utility/string.h"
+
+// Standard headers.
+#include <cstdlib>
+#include <string>
+
+using namespace std;
+
+namespace foundation
+{
+
+namespace
+{
+    const char* InstructionSetNames[] =
+    {
+#ifdef APPLESEED_X86
+        "SSE2",
+#else
+        "none",
+#endif
+        "SSE4.2",
+        "AVX",
+        "AVX2",
+        "AVX-512"
+    };
+
+    InstructionSet detect_dispatch_instruction_set()
+    {
+        InstructionSet isa = get_host_instruction_set();
+
+        // Honor the user-defined cap, if any.
+        if (const char* value = getenv("APPLESEED_MAX_INSTRUCTION_SET"))
+        {
+            InstructionSet max_isa;
+            if (parse_instruction_set_name(value, max_isa) && max_isa < isa)
+                isa = max_isa;
+        }
+
+        // The binary cannot run on a CPU that doesn't support the compiled instruction set anyway.
+        const InstructionSet compiled_isa = get_compiled_instruction_set();
+        return isa < compiled_isa ? compiled_isa : isa;
+    }
+}
+
+InstructionSet get_compiled_instruction_set()
+{
+#if defined APPLESEED_USE_AVX2
+    return InstructionSetAVX2;
+#elif defined APPLESEED_USE_AVX
+    return InstructionSetAVX;
+#elif defined APPLESEED_USE_SSE42
+    return InstructionSetSSE42;
+#else
+    return InstructionSetBaseline;
+#endif
+}
+
+InstructionSet get_host_instruction_set()
+{
+#ifdef APPLESEED_X86
+    System::X86CpuFeatures features;
+    System::detect_x86_cpu_features(features);
+
+    if (features.m_os_avx512 &&
+        features.m_hw_avx512_f &&
+        features.m_hw_avx512_cd &&
+        features.m_hw_avx512_bw &&
+        features.m_hw_avx512_dq &&
+        features.m_hw_avx512_vl)
+        return InstructionSetAVX512;
+
+    if (features.m_os_avx && features.m_hw_avx2)
+        return InstructionSetAVX2;
+
+    if (features.m_os_avx && features.m_hw_avx)
+        return InstructionSetAVX;
+
+    if (features.m_hw_sse42)
+        return InstructionSetSSE42;
+#endif
+
+    return InstructionSetBaseline;
+}
+
+InstructionSet get_dispatch_instruction_set()
+{
+    static const InstructionSet isa = detect_dispatch_instruction_set();
+    return isa;
+}
+
+const char* get_instruction_set_name(const InstructionSet isa)
+{
+    return InstructionSetNames[isa];
+}
+
+bool parse_instruction_set_name(const char* name, InstructionSet& isa)
+{
+    const string lower_name = lower_case(name);
+
+    for (size_t i = 0; i < countof(InstructionSetNames); ++i)
+    {
+        if (lower_name == lower_case(InstructionSetNames[i]))
+        {
+            isa = static_cast<InstructionSet>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}   // namespace foundation
@@ -0,0 +1,107 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_FOUNDATION_PLATFORM_CPUDISPATCH_H
+#define APPLESEED_FOUNDATION_PLATFORM_CPUDISPATCH_H
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+namespace foundation
+{
+
+//
+// Runtime selection of SIMD code paths.
+//
+// The binary is compiled for a conservative instruction set (the one selected by the
+// USE_SSE, USE_SSE42, USE_AVX and USE_AVX2 CMake options). A few hot kernels are also
+// compiled for wider instruction sets using the APPLESEED_TARGET_* qualifiers below;
+// get_dispatch_instruction_set() tells which of these versions should run on the host.
+//
+// The APPLESEED_MAX_INSTRUCTION_SET environment variable (e.g. "sse2" or "avx2") can be
+// used to cap the instruction set used by dispatched kernels.
+//
+
+enum InstructionSet
+{
+    InstructionSetBaseline,     // SSE2 on x86, no SIMD on other architectures
+    InstructionSetSSE42,
+    InstructionSetAVX,
+    InstructionSetAVX2,
+    InstructionSetAVX512        // AVX-512 F, CD, BW, DQ and VL
+};
+
+// Return the instruction set the binary was compiled for.
+APPLESEED_DLLSYMBOL InstructionSet get_compiled_instruction_set();
+
+// Return the widest instruction set supported by both the CPU and the operating system.
+APPLESEED_DLLSYMBOL InstructionSet get_host_instruction_set();
+
+// Return the instruction set dispatched kernels should target. This is never narrower
+// than the compiled instruction set. The result is computed once and cached.
+APPLESEED_DLLSYMBOL InstructionSet get_dispatch_instruction_set();
+
+// Return the name of an instruction set, e.g. "AVX2".
+APPLESEED_DLLSYMBOL const char* get_instruction_set_name(const InstructionSet isa);
+
+// Parse the name of an instruction set (case-insensitive). Return false if the name is unknown.
+APPLESEED_DLLSYMBOL bool parse_instruction_set_name(const char* name, InstructionSet& isa);
+
+
+//
+// Qualifiers to compile a function for a given instruction set, regardless of the
+// instruction set selected for the rest of the build. Such functions must only be
+// called if get_dispatch_instruction_set() returns a compatible instruction set.
+//
+// FMA is deliberately not enabled: the compiler would contract multiplications and additions,
+// and a frame rendered on different machines would no longer be bit-identical.
+//
+// APPLESEED_FLATTEN inlines all calls made by a function into its body, so that the
+// whole call tree of a dispatched kernel is compiled for the target instruction set.
+// Calls made from functions inlined with APPLESEED_FORCE_INLINE are not flattened.
+//
+// APPLESEED_CPU_DISPATCH is only defined when these qualifiers are supported.
+//
+
+// gcc and clang on x86.
+#if defined APPLESEED_X86 && defined __GNUC__
+    #define APPLESEED_CPU_DISPATCH
+    #define APPLESEED_TARGET_AVX    __attribute__((target("avx")))
+    #define APPLESEED_TARGET_AVX2   __attribute__((target("avx2")))
+    #define APPLESEED_TARGET_AVX512 __attribute__((target("avx512f,avx512cd,avx512bw,avx512dq,avx512vl")))
+    #define APPLESEED_FLATTEN       __attribute__((flatten))
+
+// Other compilers: only the baseline version of dispatched kernels is available.
+#else
+    #define APPLESEED_FLATTEN
+#endif
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_PLATFORM_CPUDISPATCH_H
@@ -0,0 +1,160 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "memorymappedfile.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/exceptions/exceptionioerror.h"
+
+// Platform headers.
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace foundation
+{
+
+//
+// MemoryMappedFile class implementation.
+//
+
+#ifdef _WIN32
+
+MemoryMappedFile::MemoryMappedFile(const char* path)
+  : m_file(INVALID_HANDLE_VALUE)
+  , m_mapping(0)
+  , m_data(0)
+  , m_size(0)
+{
+    m_file =
+        CreateFileA(
+            path,
+            GENERIC_READ,
+            FILE_SHARE_READ,
+            0,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            0);
+
+    if (m_file == INVALID_HANDLE_VALUE)
+        throw ExceptionIOError("cannot open file", path);
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size))
+    {
+        CloseHandle(m_file);
+        throw ExceptionIOError("cannot query size of file", path);
+    }
+
+    m_size = static_cast<size_t>(size.QuadPart);
+
+    // Mapping an empty file is an error on Windows.
+    if (m_size == 0)
+        return;
+
+    m_mapping = CreateFileMappingA(m_file, 0, PAGE_READONLY, 0, 0, 0);
+
+    if (m_mapping == 0)
+    {
+        CloseHandle(m_file);
+        throw ExceptionIOError("cannot map file", path);
+    }
+
+    m_data = static_cast<const uint8*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+
+    if (m_data == 0)
+    {
+        CloseHandle(m_mapping);
+        CloseHandle(m_file);
+        throw ExceptionIOError("cannot map file", path);
+    }
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+
+    if (m_mapping)
+        CloseHandle(m_mapping);
+
+    CloseHandle(m_file);
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const char* path)
+  : m_data(0)
+  , m_size(0)
+{
+    const int fd = open(path, O_RDONLY);
+
+    if (fd == -1)
+        throw ExceptionIOError("cannot open file", path);
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == -1)
+    {
+        close(fd);
+        throw ExceptionIOError("cannot query size of file", path);
+    }
+
+    m_size = static_cast<size_t>(file_stat.st_size);
+
+    // Mapping an empty file is an error on POSIX systems.
+    if (m_size > 0)
+    {
+        void* data = mmap(0, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data == MAP_FAILED)
+        {
+            close(fd);
+            throw ExceptionIOError("cannot map file", path);
+        }
+
+        m_data = static_cast<const uint8*>(data);
+    }
+
+    // The mapping keeps its own reference to the file.
+    close(fd);
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (m_data)
+        munmap(const_cast<uint8*>(m_data), m_size);
+}
+
+#endif
+
+}   // namespace foundation
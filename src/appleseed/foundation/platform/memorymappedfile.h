@@ -0,0 +1,98 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_FOUNDATION_PLATFORM_MEMORYMAPPEDFILE_H
+#define APPLESEED_FOUNDATION_PLATFORM_MEMORYMAPPEDFILE_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/platform/types.h"
+#ifdef _WIN32
+#include "foundation/platform/windows.h"
+#endif
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Standard headers.
+#include <cstddef>
+
+namespace foundation
+{
+
+//
+// A read-only view of the entire content of a file, mapped into memory.
+//
+// The mapping is private to the process and remains valid for the lifetime
+// of the MemoryMappedFile object. Pages are loaded on demand by the OS.
+//
+
+class APPLESEED_DLLSYMBOL MemoryMappedFile
+  : public NonCopyable
+{
+  public:
+    // Constructor. Throws a foundation::ExceptionIOError on failure.
+    explicit MemoryMappedFile(const char* path);
+
+    // Destructor.
+    ~MemoryMappedFile();
+
+    // Return a pointer to the first byte of the file, or 0 if the file is empty.
+    const uint8* get_data() const;
+
+    // Return the size of the file in bytes.
+    size_t get_size() const;
+
+  private:
+#ifdef _WIN32
+    HANDLE          m_file;
+    HANDLE          m_mapping;
+#endif
+    const uint8*    m_data;
+    size_t          m_size;
+};
+
+
+//
+// MemoryMappedFile class implementation.
+//
+
+inline const uint8* MemoryMappedFile::get_data() const
+{
+    return m_data;
+}
+
+inline size_t MemoryMappedFile::get_size() const
+{
+    return m_size;
+}
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_PLATFORM_MEMORYMAPPEDFILE_H
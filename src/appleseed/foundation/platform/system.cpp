@@ -836,6 +836,7 @@ void System::print_information(Logger& logger)
     if (features.m_hw_avx) isabuilder << "avx ";
     if (features.m_hw_avx2) isabuilder << "avx2 ";
     if (features.m_hw_fma3) isabuilder << "fma3 ";
+    if (features.m_hw_avx512_f) isabuilder << "avx512f ";
 
     string isa = isabuilder.str();
     isa = isa.empty() ? "none" : trim_right(isa);
@@ -0,0 +1,112 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_FOUNDATION_UTILITY_JOB_PARALLELFOR_H
+#define APPLESEED_FOUNDATION_UTILITY_JOB_PARALLELFOR_H
+
+// appleseed.foundation headers.
+#include "foundation/platform/atomic.h"
+#include "foundation/platform/system.h"
+#include "foundation/platform/thread.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cstddef>
+
+namespace foundation
+{
+
+//
+// Call func(i) for every i in [0, count), spreading the calls over several threads.
+//
+// The calling thread takes part in the work and the function returns once all calls
+// have completed. Indices are handed out one at a time, so calls of uneven durations
+// are balanced between threads; each call should therefore do a substantial amount of
+// work, such as processing a whole tile. 'func' must be safe to call concurrently and
+// must not throw.
+//
+// If thread_count is 0, one thread per logical CPU core is used.
+//
+
+template <typename Func>
+void parallel_for(
+    const size_t    count,
+    Func            func,
+    size_t          thread_count = 0);
+
+
+//
+// Implementation.
+//
+
+namespace impl
+{
+    template <typename Func>
+    struct ParallelForWorker
+    {
+        boost::atomic<size_t>*  m_next;
+        size_t                  m_count;
+        Func*                   m_func;
+
+        void operator()()
+        {
+            size_t i;
+            while ((i = m_next->fetch_add(1)) < m_count)
+                (*m_func)(i);
+        }
+    };
+}
+
+template <typename Func>
+void parallel_for(
+    const size_t    count,
+    Func            func,
+    size_t          thread_count)
+{
+    if (thread_count == 0)
+        thread_count = System::get_logical_cpu_core_count();
+
+    thread_count = std::min(thread_count, count);
+
+    boost::atomic<size_t> next(0);
+    impl::ParallelForWorker<Func> worker = { &next, count, &func };
+
+    boost::thread_group threads;
+
+    for (size_t i = 1; i < thread_count; ++i)
+        threads.create_thread(worker);
+
+    worker();
+
+    threads.join_all();
+}
+
+}       // namespace foundation
+
+#endif  // !APPLESEED_FOUNDATION_UTILITY_JOB_PARALLELFOR_H
@@ -33,6 +33,8 @@
 // API headers.
 #include "renderer/modeling/project-builtin/cornellboxproject.h"
 #include "renderer/modeling/project-builtin/defaultproject.h"
+#include "renderer/modeling/project/binaryprojectfilereader.h"
+#include "renderer/modeling/project/binaryprojectfilewriter.h"
 #include "renderer/modeling/project/configuration.h"
 #include "renderer/modeling/project/configurationcontainer.h"
 #include "renderer/modeling/project/project.h"
@@ -699,33 +699,17 @@ bool AssemblyLeafVisitor::visit(
             if (triangle_tree)
             {
                 // Check the intersection between the ray and the triangle tree.
-                TriangleTreeIntersector intersector;
                 TriangleLeafVisitor visitor(*triangle_tree, local_shading_point);
-                if (triangle_tree->get_moving_triangle_count() > 0)
-                {
-                    intersector.intersect_motion(
-                        *triangle_tree,
-                        local_shading_point.m_ray,
-                        local_ray_info,
-                        local_shading_point.m_ray.m_time.m_normalized,
-                        visitor
-#ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
-                        , m_triangle_tree_stats
-#endif
-                        );
-                }
-                else
-                {
-                    intersector.intersect_no_motion(
-                        *triangle_tree,
-                        local_shading_point.m_ray,
-                        local_ray_info,
-                        visitor
+                intersect_triangle_tree(
+                    *triangle_tree,
+                    local_shading_point.m_ray,
+                    local_ray_info,
+                    local_shading_point.m_ray.m_time.m_normalized,
+                    visitor
 #ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
-                        , m_triangle_tree_stats
+                    , m_triangle_tree_stats
 #endif
-                        );
-                }
+                    );
                 visitor.read_hit_triangle_data();
             }
         }
@@ -769,6 +753,15 @@ bool AssemblyLeafVisitor::visit(
             m_shading_point.m_region_index = local_shading_point.m_region_index;
             m_shading_point.m_primitive_index = local_shading_point.m_primitive_index;
             m_shading_point.m_triangle_support_plane = local_shading_point.m_triangle_support_plane;
+
+            // Forward the alpha value if it's already known.
+            if (local_shading_point.m_primitive_type == ShadingPoint::PrimitiveTriangle &&
+                (local_shading_point.m_members & ShadingPoint::HasAlpha))
+            {
+                m_shading_point.m_alpha = local_shading_point.m_alpha;
+                m_shading_point.m_members |= ShadingPoint::HasAlpha;
+            }
+            else m_shading_point.m_members &= ~ShadingPoint::HasAlpha;
         }
     }
 
@@ -866,33 +859,17 @@ bool AssemblyLeafProbeVisitor::visit(
             if (triangle_tree)
             {
                 // Check the intersection between the ray and the triangle tree.
-                TriangleTreeProbeIntersector intersector;
                 TriangleLeafProbeVisitor visitor(*triangle_tree, local_ray.m_time.m_normalized, local_ray.m_flags);
-                if (triangle_tree->get_moving_triangle_count() > 0)
-                {
-                    intersector.intersect_motion(
-                        *triangle_tree,
-                        local_ray,
-                        local_ray_info,
-                        local_ray.m_time.m_normalized,
-                        visitor
+                intersect_triangle_tree(
+                    *triangle_tree,
+                    local_ray,
+                    local_ray_info,
+                    local_ray.m_time.m_normalized,
+                    visitor
 #ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
-                        , m_triangle_tree_stats
+                    , m_triangle_tree_stats
 #endif
-                        );
-                }
-                else
-                {
-                    intersector.intersect_no_motion(
-                        *triangle_tree,
-                        local_ray,
-                        local_ray_info,
-                        visitor
-#ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
-                        , m_triangle_tree_stats
-#endif
-                        );
-                }
+                    );
 
                 // Terminate traversal if there was a hit.
                 if (visitor.hit())
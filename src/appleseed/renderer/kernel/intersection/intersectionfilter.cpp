@@ -49,6 +49,7 @@
 #include "foundation/utility/lazy.h"
 
 // Standard headers.
+#include <algorithm>
 #include <memory>
 
 using namespace foundation;
@@ -117,12 +118,14 @@ IntersectionFilter::IntersectionFilter(
     Object&                 object,
     const MaterialArray&    materials,
     TextureCache&           texture_cache)
-  : m_obj_alpha_mask(0)
-  , m_obj_alpha_map_signature(0)
+  : m_obj_alpha_map_signature(0)
+  , m_obj_alpha_mask(0)
+  , m_obj_has_alpha_map(false)
 {
     // Initialize the material -> alpha mask mapping.
     m_material_alpha_map_signatures.assign(materials.size(), 0);
     m_material_alpha_masks.assign(materials.size(), 0);
+    m_material_has_alpha_maps.assign(materials.size(), false);
 
     // Create alpha masks.
     update(object, materials, texture_cache);
@@ -132,6 +135,9 @@ IntersectionFilter::IntersectionFilter(
         // Make a local copy of the object's UV coordinates.
         m_uv.reserve(get_triangle_count(object) * 3);
         copy_uv_coordinates(object, m_uv);
+
+        // Classify triangles now that UV coordinates are available.
+        classify_triangles(object);
     }
 }
 
@@ -158,18 +164,15 @@ void IntersectionFilter::do_update(
     const EntityType&               entity,
     TextureCache&                   texture_cache,
     IntersectionFilter::AlphaMask*& mask,
-    uint64&                         signature)
+    uint64&                         signature,
+    bool&                           has_alpha_map)
 {
-    // Intersection filters would prevent shading fully transparent shading points,
-    // so don't create one if shading fully transparent shading points is enabled.
-    if (entity.shade_alpha_cutouts())
-        delete_and_clear(mask);
-
     // Use the uncached version of get_alpha_map() since at this point
     // on_frame_begin() hasn't been called on the materials, when
     // intersection filters are updated on existing triangle trees
     // prior to rendering.
     const Source* alpha_map = entity.get_uncached_alpha_map();
+    has_alpha_map = alpha_map != 0;
 
     if (alpha_map == 0)
     {
@@ -177,6 +180,14 @@ void IntersectionFilter::do_update(
         return;
     }
 
+    // Intersection filters would prevent shading fully transparent shading points,
+    // so don't create one if shading fully transparent shading points is enabled.
+    if (entity.shade_alpha_cutouts())
+    {
+        delete_and_clear(mask);
+        return;
+    }
+
     // Don't do anything if there is already an alpha mask and it is up-to-date.
     const uint64 alpha_map_sig = alpha_map->compute_signature();
     if (mask != 0 && alpha_map_sig == signature)
@@ -204,28 +215,108 @@ void IntersectionFilter::do_update(
 }
 
 void IntersectionFilter::update(
-    const Object&           object,
+    Object&                 object,
     const MaterialArray&    materials,
     TextureCache&           texture_cache)
 {
     assert(m_material_alpha_map_signatures.size() == materials.size());
     assert(m_material_alpha_masks.size() == materials.size());
 
-    do_update(object, texture_cache, m_obj_alpha_mask, m_obj_alpha_map_signature);
+    do_update(
+        object,
+        texture_cache,
+        m_obj_alpha_mask,
+        m_obj_alpha_map_signature,
+        m_obj_has_alpha_map);
 
     for (size_t i = 0; i < materials.size(); ++i)
     {
         if (const Material* material = materials[i])
         {
+            bool has_alpha_map;
             do_update(
                 *material,
                 texture_cache,
                 m_material_alpha_masks[i],
-                m_material_alpha_map_signatures[i]);
+                m_material_alpha_map_signatures[i],
+                has_alpha_map);
+            m_material_has_alpha_maps[i] = has_alpha_map;
         }
         else
+        {
             delete_and_clear(m_material_alpha_masks[i]);
+            m_material_has_alpha_maps[i] = false;
+        }
     }
+
+    // Reclassify triangles if UV coordinates were already copied.
+    if (!m_uv.empty())
+        classify_triangles(object);
+}
+
+void IntersectionFilter::classify_triangles(Object& object)
+{
+    m_triangle_opacities.clear();
+    m_triangle_opacities.reserve(m_uv.size() / 3);
+
+    Access<RegionKit> region_kit(&object.get_region_kit());
+
+    for (const_each<RegionKit> i = *region_kit; i; ++i)
+    {
+        const IRegion* region = *i;
+        Access<StaticTriangleTess> tess(&region->get_static_triangle_tess());
+
+        for (const_each<StaticTriangleTess::PrimitiveArray> j = tess->m_primitives; j; ++j)
+        {
+            const size_t triangle_index = m_triangle_opacities.size();
+
+            // Compute the UV bounding box of the triangle.
+            const Vector2f& uv0 = m_uv[triangle_index * 3 + 0];
+            const Vector2f& uv1 = m_uv[triangle_index * 3 + 1];
+            const Vector2f& uv2 = m_uv[triangle_index * 3 + 2];
+            const Vector2f uv_min = component_wise_min(component_wise_min(uv0, uv1), uv2);
+            const Vector2f uv_max = component_wise_max(component_wise_max(uv0, uv1), uv2);
+
+            // Combine the classifications of the object and material alpha masks.
+            const bool has_material = j->m_pa < m_material_alpha_masks.size();
+            const Opacity opacity =
+                classify_triangle(
+                    m_obj_alpha_mask,
+                    m_obj_has_alpha_map,
+                    has_material ? m_material_alpha_masks[j->m_pa] : 0,
+                    has_material && m_material_has_alpha_maps[j->m_pa],
+                    uv_min,
+                    uv_max);
+
+            m_triangle_opacities.push_back(static_cast<uint8>(opacity));
+        }
+    }
+
+    assert(m_triangle_opacities.size() * 3 == m_uv.size());
+}
+
+IntersectionFilter::Opacity IntersectionFilter::classify_triangle(
+    const AlphaMask*        obj_alpha_mask,
+    const bool              obj_has_alpha_map,
+    const AlphaMask*        mtl_alpha_mask,
+    const bool              mtl_has_alpha_map,
+    const Vector2f&         uv_min,
+    const Vector2f&         uv_max)
+{
+    const Opacity obj_opacity =
+        obj_alpha_mask ? obj_alpha_mask->classify(uv_min, uv_max) :
+        obj_has_alpha_map ? Mixed : Opaque;
+    const Opacity mtl_opacity =
+        mtl_alpha_mask ? mtl_alpha_mask->classify(uv_min, uv_max) :
+        mtl_has_alpha_map ? Mixed : Opaque;
+
+    if (obj_opacity == Transparent || mtl_opacity == Transparent)
+        return Transparent;
+
+    if (obj_opacity == Opaque && mtl_opacity == Opaque)
+        return Opaque;
+
+    return Mixed;
 }
 
 bool IntersectionFilter::has_alpha_masks() const
@@ -260,7 +351,9 @@ size_t IntersectionFilter::get_masks_memory_size() const
 
 size_t IntersectionFilter::get_uv_memory_size() const
 {
-    return m_uv.capacity() * sizeof(Vector2f);
+    return
+          m_uv.capacity() * sizeof(Vector2f)
+        + m_triangle_opacities.capacity() * sizeof(uint8);
 }
 
 IntersectionFilter::AlphaMask* IntersectionFilter::create_alpha_mask(
@@ -288,6 +381,12 @@ IntersectionFilter::AlphaMask* IntersectionFilter::create_alpha_mask(
     // Create and initialize the alpha mask.
     AlphaMask* alpha_mask = new AlphaMask(width, height);
 
+    // Tiles are fully opaque (resp. fully transparent) until a texel proves otherwise.
+    const size_t tile_count_x = alpha_mask->get_tile_count_x();
+    const size_t tile_count = tile_count_x * alpha_mask->get_tile_count_y();
+    vector<bool> full_tiles(tile_count, true);
+    vector<bool> empty_tiles(tile_count, true);
+
     const float rcp_width = 1.0f / width;
     const float rcp_height = 1.0f / height;
     size_t transparent_texel_count = 0;
@@ -310,13 +409,113 @@ IntersectionFilter::AlphaMask* IntersectionFilter::create_alpha_mask(
 
             // Keep track of the number of transparent texels.
             transparent_texel_count += opaque ? 0 : 1;
+
+            // Update the opacity flags of the tile containing this texel.
+            const size_t tile_index =
+                (y / AlphaMask::TileSize) * tile_count_x + x / AlphaMask::TileSize;
+            if (alpha[0] < 1.0f)
+                full_tiles[tile_index] = false;
+            if (opaque)
+                empty_tiles[tile_index] = false;
         }
     }
 
+    alpha_mask->set_tile_opacities(full_tiles, empty_tiles);
+
     // Compute the ratio of transparent texels to the total number of texels.
     transparency = static_cast<double>(transparent_texel_count) / (width * height);
 
     return alpha_mask;
 }
 
+
+//
+// IntersectionFilter::AlphaMask class implementation.
+//
+
+namespace
+{
+    void build_summed_area_table(
+        const vector<bool>&     flags,
+        const size_t            width,
+        const size_t            height,
+        vector<uint32>&         sat)
+    {
+        // The table has an extra row and column of zeros to simplify lookups.
+        sat.assign((width + 1) * (height + 1), 0);
+
+        for (size_t y = 0; y < height; ++y)
+        {
+            uint32 row_sum = 0;
+
+            for (size_t x = 0; x < width; ++x)
+            {
+                row_sum += flags[y * width + x] ? 1 : 0;
+                sat[(y + 1) * (width + 1) + x + 1] = sat[y * (width + 1) + x + 1] + row_sum;
+            }
+        }
+    }
+}
+
+void IntersectionFilter::AlphaMask::set_tile_opacities(
+    const vector<bool>&     full_tiles,
+    const vector<bool>&     empty_tiles)
+{
+    assert(full_tiles.size() == m_tile_count_x * m_tile_count_y);
+    assert(empty_tiles.size() == m_tile_count_x * m_tile_count_y);
+
+    build_summed_area_table(full_tiles, m_tile_count_x, m_tile_count_y, m_full_tile_sat);
+    build_summed_area_table(empty_tiles, m_tile_count_x, m_tile_count_y, m_empty_tile_sat);
+}
+
+uint32 IntersectionFilter::AlphaMask::sum(
+    const vector<uint32>&   sat,
+    const size_t            x0,
+    const size_t            y0,
+    const size_t            x1,
+    const size_t            y1) const
+{
+    const size_t stride = m_tile_count_x + 1;
+
+    return
+          sat[(y1 + 1) * stride + x1 + 1]
+        - sat[y0 * stride + x1 + 1]
+        - sat[(y1 + 1) * stride + x0]
+        + sat[y0 * stride + x0];
+}
+
+IntersectionFilter::Opacity IntersectionFilter::AlphaMask::classify(
+    const Vector2f&         uv_min,
+    const Vector2f&         uv_max) const
+{
+    // Texture lookups outside of [0, 1]^2 may wrap around: don't try to classify.
+    if (!(uv_min[0] >= 0.0f && uv_min[1] >= 0.0f && uv_max[0] <= 1.0f && uv_max[1] <= 1.0f))
+        return Mixed;
+
+    const float fx0 = clamp(uv_min[0] * m_bitmask.get_width(), 0.0f, m_max_x);
+    const float fy0 = clamp(uv_min[1] * m_bitmask.get_height(), 0.0f, m_max_y);
+    const float fx1 = clamp(uv_max[0] * m_bitmask.get_width(), 0.0f, m_max_x);
+    const float fy1 = clamp(uv_max[1] * m_bitmask.get_height(), 0.0f, m_max_y);
+
+    // Expand the texel footprint by one texel to account for texture filtering.
+    const size_t x0 = truncate<size_t>(fx0) > 0 ? truncate<size_t>(fx0) - 1 : 0;
+    const size_t y0 = truncate<size_t>(fy0) > 0 ? truncate<size_t>(fy0) - 1 : 0;
+    const size_t x1 = min(truncate<size_t>(fx1) + 1, m_bitmask.get_width() - 1);
+    const size_t y1 = min(truncate<size_t>(fy1) + 1, m_bitmask.get_height() - 1);
+
+    const size_t tx0 = x0 / TileSize;
+    const size_t ty0 = y0 / TileSize;
+    const size_t tx1 = x1 / TileSize;
+    const size_t ty1 = y1 / TileSize;
+    const uint32 tile_count = static_cast<uint32>((tx1 - tx0 + 1) * (ty1 - ty0 + 1));
+
+    if (sum(m_full_tile_sat, tx0, ty0, tx1, ty1) == tile_count)
+        return Opaque;
+
+    if (sum(m_empty_tile_sat, tx0, ty0, tx1, ty1) == tile_count)
+        return Transparent;
+
+    return Mixed;
+}
+
 }   // namespace renderer
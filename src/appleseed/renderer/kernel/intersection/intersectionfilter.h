@@ -39,6 +39,7 @@
 #include "foundation/math/vector.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/bitmask.h"
+#include "foundation/utility/test.h"
 
 // Standard headers.
 #include <cassert>
@@ -51,6 +52,13 @@ namespace renderer  { class Object; }
 namespace renderer  { class Source; }
 namespace renderer  { class TextureCache; }
 
+DECLARE_TEST_CASE(Renderer_Kernel_Intersection_IntersectionFilter, ClassifyTriangle_GivenOpaqueMasks_ReturnsOpaque);
+DECLARE_TEST_CASE(Renderer_Kernel_Intersection_IntersectionFilter, ClassifyTriangle_GivenTransparentMask_ReturnsTransparent);
+DECLARE_TEST_CASE(Renderer_Kernel_Intersection_IntersectionFilter, ClassifyTriangle_GivenPartiallyTransparentMask_ReturnsMixed);
+DECLARE_TEST_CASE(Renderer_Kernel_Intersection_IntersectionFilter, ClassifyTriangle_GivenTriangleOverOpaqueTileOfPartialMask_ReturnsOpaque);
+DECLARE_TEST_CASE(Renderer_Kernel_Intersection_IntersectionFilter, ClassifyTriangle_GivenAlphaMapWithoutMask_ReturnsMixed);
+DECLARE_TEST_CASE(Renderer_Kernel_Intersection_IntersectionFilter, ClassifyTriangle_GivenNoAlphaMap_ReturnsOpaque);
+
 namespace renderer
 {
 
@@ -66,7 +74,7 @@ class IntersectionFilter
     ~IntersectionFilter();
 
     void update(
-        const Object&           object,
+        Object&                 object,
         const MaterialArray&    materials,
         TextureCache&           texture_cache);
 
@@ -80,17 +88,41 @@ class IntersectionFilter
         const double            u,
         const double            v) const;
 
+    // Return true if the surface is known to be fully opaque everywhere on a given triangle,
+    // in which case alpha maps don't need to be evaluated at intersection points.
+    bool is_opaque(const TriangleKey& triangle_key) const;
+
   private:
+    GRANT_ACCESS_TO_TEST_CASE(Renderer_Kernel_Intersection_IntersectionFilter, ClassifyTriangle_GivenOpaqueMasks_ReturnsOpaque);
+    GRANT_ACCESS_TO_TEST_CASE(Renderer_Kernel_Intersection_IntersectionFilter, ClassifyTriangle_GivenTransparentMask_ReturnsTransparent);
+    GRANT_ACCESS_TO_TEST_CASE(Renderer_Kernel_Intersection_IntersectionFilter, ClassifyTriangle_GivenPartiallyTransparentMask_ReturnsMixed);
+    GRANT_ACCESS_TO_TEST_CASE(Renderer_Kernel_Intersection_IntersectionFilter, ClassifyTriangle_GivenTriangleOverOpaqueTileOfPartialMask_ReturnsOpaque);
+    GRANT_ACCESS_TO_TEST_CASE(Renderer_Kernel_Intersection_IntersectionFilter, ClassifyTriangle_GivenAlphaMapWithoutMask_ReturnsMixed);
+    GRANT_ACCESS_TO_TEST_CASE(Renderer_Kernel_Intersection_IntersectionFilter, ClassifyTriangle_GivenNoAlphaMap_ReturnsOpaque);
+
+    // Opacity classification of a region of an alpha mask or of a triangle.
+    enum Opacity
+    {
+        Opaque,                 // alpha is 1 everywhere
+        Transparent,            // alpha is 0 everywhere
+        Mixed                   // alpha must be evaluated
+    };
+
     class AlphaMask
       : public foundation::NonCopyable
     {
       public:
+        // Size in texels of the tiles used to classify regions of the mask.
+        static const size_t TileSize = 8;
+
         AlphaMask(
             const size_t        width,
             const size_t        height)
           : m_max_x(static_cast<float>(width) - 1.0f)
           , m_max_y(static_cast<float>(height) - 1.0f)
           , m_bitmask(width, height)
+          , m_tile_count_x((width + TileSize - 1) / TileSize)
+          , m_tile_count_y((height + TileSize - 1) / TileSize)
         {
         }
 
@@ -118,29 +150,83 @@ class IntersectionFilter
             return !is_opaque(uv);
         }
 
+        // Build the tile classification from per-tile opacity flags.
+        // 'full_tiles' and 'empty_tiles' are indexed by tile_y * tile_count_x + tile_x.
+        void set_tile_opacities(
+            const std::vector<bool>&    full_tiles,
+            const std::vector<bool>&    empty_tiles);
+
+        // Classify the region of the mask covered by a given UV bounding box.
+        Opacity classify(
+            const foundation::Vector2f& uv_min,
+            const foundation::Vector2f& uv_max) const;
+
+        size_t get_tile_count_x() const
+        {
+            return m_tile_count_x;
+        }
+
+        size_t get_tile_count_y() const
+        {
+            return m_tile_count_y;
+        }
+
         size_t get_memory_size() const
         {
-            return m_bitmask.get_memory_size();
+            return
+                  m_bitmask.get_memory_size()
+                + m_full_tile_sat.capacity() * sizeof(foundation::uint32)
+                + m_empty_tile_sat.capacity() * sizeof(foundation::uint32);
         }
 
       private:
-        const float             m_max_x;
-        const float             m_max_y;
-        foundation::BitMask2    m_bitmask;
+        const float                         m_max_x;
+        const float                         m_max_y;
+        foundation::BitMask2                m_bitmask;
+        const size_t                        m_tile_count_x;
+        const size_t                        m_tile_count_y;
+
+        // Summed-area tables of fully opaque and fully transparent tiles.
+        std::vector<foundation::uint32>     m_full_tile_sat;
+        std::vector<foundation::uint32>     m_empty_tile_sat;
+
+        foundation::uint32 sum(
+            const std::vector<foundation::uint32>&  sat,
+            const size_t                            x0,
+            const size_t                            y0,
+            const size_t                            x1,
+            const size_t                            y1) const;
     };
 
     foundation::uint64                  m_obj_alpha_map_signature;
     AlphaMask*                          m_obj_alpha_mask;
+    bool                                m_obj_has_alpha_map;
     std::vector<foundation::uint64>     m_material_alpha_map_signatures;
     std::vector<AlphaMask*>             m_material_alpha_masks;
+    std::vector<bool>                   m_material_has_alpha_maps;
     std::vector<foundation::Vector2f>   m_uv;
+    std::vector<foundation::uint8>      m_triangle_opacities;
 
     template <typename EntityType>
     static void do_update(
         const EntityType&               entity,
         TextureCache&                   texture_cache,
         IntersectionFilter::AlphaMask*& mask,
-        foundation::uint64&             signature);
+        foundation::uint64&             signature,
+        bool&                           has_alpha_map);
+
+    void classify_triangles(Object& object);
+
+    // Classify a triangle given its UV bounding box and the alpha masks of its object and material.
+    // An entity with an alpha map but no alpha mask (because the mask was discarded) makes the
+    // triangle mixed: its alpha map must then be evaluated at intersection points.
+    static Opacity classify_triangle(
+        const AlphaMask*                obj_alpha_mask,
+        const bool                      obj_has_alpha_map,
+        const AlphaMask*                mtl_alpha_mask,
+        const bool                      mtl_has_alpha_map,
+        const foundation::Vector2f&     uv_min,
+        const foundation::Vector2f&     uv_max);
 
     static AlphaMask* create_alpha_mask(
         const Source*           alpha_map,
@@ -169,12 +255,19 @@ inline bool IntersectionFilter::accept(
     if (u != u || v != v)
         return true;
 
+    const size_t triangle_index = triangle_key.get_triangle_index();
+
+    // Only look up the alpha masks if the triangle overlaps both opaque and transparent texels.
+    switch (m_triangle_opacities[triangle_index])
+    {
+      case Opaque: return true;
+      case Transparent: return false;
+    }
+
     const AlphaMask* mtl_alpha_mask = m_material_alpha_masks[triangle_key.get_triangle_pa()];
 
     if (m_obj_alpha_mask || mtl_alpha_mask)
     {
-        const size_t triangle_index = triangle_key.get_triangle_index();
-
         const float fu = static_cast<float>(u);
         const float fv = static_cast<float>(v);
 
@@ -193,6 +286,13 @@ inline bool IntersectionFilter::accept(
     return true;
 }
 
+inline bool IntersectionFilter::is_opaque(const TriangleKey& triangle_key) const
+{
+    assert(triangle_key.get_region_index() == 0);
+
+    return m_triangle_opacities[triangle_key.get_triangle_index()] == Opaque;
+}
+
 }       // namespace renderer
 
 #endif  // !APPLESEED_RENDERER_KERNEL_INTERSECTION_INTERSECTIONFILTER_H
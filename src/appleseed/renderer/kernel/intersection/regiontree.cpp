@@ -519,33 +519,17 @@ double RegionLeafVisitor::visit(
     if (triangle_tree)
     {
         // Check the intersection between the ray and the triangle tree.
-        TriangleTreeIntersector intersector;
         TriangleLeafVisitor visitor(*triangle_tree, m_shading_point);
-        if (triangle_tree->get_moving_triangle_count() > 0)
-        {
-            intersector.intersect_motion(
-                *triangle_tree,
-                ray,
-                ray_info,
-                ray.m_time.m_normalized,
-                visitor
-#ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
-                , m_triangle_tree_stats
-#endif
-                );
-        }
-        else
-        {
-            intersector.intersect_no_motion(
-                *triangle_tree,
-                ray,
-                ray_info,
-                visitor
+        intersect_triangle_tree(
+            *triangle_tree,
+            ray,
+            ray_info,
+            ray.m_time.m_normalized,
+            visitor
 #ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
-                , m_triangle_tree_stats
+            , m_triangle_tree_stats
 #endif
-                );
-        }
+            );
         visitor.read_hit_triangle_data();
     }
 
@@ -574,33 +558,17 @@ double RegionLeafProbeVisitor::visit(
     if (triangle_tree)
     {
         // Check the intersection between the ray and the triangle tree.
-        TriangleTreeProbeIntersector intersector;
         TriangleLeafProbeVisitor visitor(*triangle_tree, ray.m_time.m_normalized, ray.m_flags);
-        if (triangle_tree->get_moving_triangle_count() > 0)
-        {
-            intersector.intersect_motion(
-                *triangle_tree,
-                ray,
-                ray_info,
-                ray.m_time.m_normalized,
-                visitor
-#ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
-                , m_triangle_tree_stats
-#endif
-                );
-        }
-        else
-        {
-            intersector.intersect_no_motion(
-                *triangle_tree,
-                ray,
-                ray_info,
-                visitor
+        intersect_triangle_tree(
+            *triangle_tree,
+            ray,
+            ray_info,
+            ray.m_time.m_normalized,
+            visitor
 #ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
-                , m_triangle_tree_stats
+            , m_triangle_tree_stats
 #endif
-                );
-        }
+            );
 
         // Terminate traversal if there was a hit.
         if (visitor.hit())
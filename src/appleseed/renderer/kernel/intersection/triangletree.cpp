@@ -61,6 +61,8 @@
 #include "foundation/math/transform.h"
 #include "foundation/math/treeoptimizer.h"
 #include "foundation/math/vector.h"
+#include "foundation/platform/compiler.h"
+#include "foundation/platform/cpudispatch.h"
 #include "foundation/platform/system.h"
 #include "foundation/platform/timers.h"
 #include "foundation/utility/alignedallocator.h"
@@ -1406,17 +1408,23 @@ bool TriangleLeafVisitor::visit(
             if (triangle_reader.m_triangle.intersect(ray, t, u, v))
             {
                 // Optionally filter intersections.
+                bool opaque = false;
                 if (m_has_intersection_filters)
                 {
                     const TriangleKey& triangle_key = m_tree.m_triangle_keys[triangle_index];
                     const IntersectionFilter* filter =
                         m_tree.m_intersection_filters[triangle_key.get_object_instance_index()];
-                    if (filter && !filter->accept(triangle_key, u, v))
-                        continue;
+                    if (filter)
+                    {
+                        if (!filter->accept(triangle_key, u, v))
+                            continue;
+                        opaque = filter->is_opaque(triangle_key);
+                    }
                 }
 
                 m_hit_triangle = &triangle;
                 m_hit_triangle_index = triangle_index;
+                m_hit_triangle_opaque = opaque;
                 m_shading_point.m_ray.m_tmax = t;
                 m_shading_point.m_bary[0] = static_cast<float>(u);
                 m_shading_point.m_bary[1] = static_cast<float>(v);
@@ -1461,18 +1469,24 @@ bool TriangleLeafVisitor::visit(
             if (reader.m_triangle.intersect(ray, t, u, v))
             {
                 // Optionally filter intersections.
+                bool opaque = false;
                 if (m_has_intersection_filters)
                 {
                     const TriangleKey& triangle_key = m_tree.m_triangle_keys[triangle_index];
                     const IntersectionFilter* filter =
                         m_tree.m_intersection_filters[triangle_key.get_object_instance_index()];
-                    if (filter && !filter->accept(triangle_key, u, v))
-                        continue;
+                    if (filter)
+                    {
+                        if (!filter->accept(triangle_key, u, v))
+                            continue;
+                        opaque = filter->is_opaque(triangle_key);
+                    }
                 }
 
                 m_interpolated_triangle = triangle;
                 m_hit_triangle = &m_interpolated_triangle;
                 m_hit_triangle_index = triangle_index;
+                m_hit_triangle_opaque = opaque;
                 m_shading_point.m_ray.m_tmax = t;
                 m_shading_point.m_bary[0] = static_cast<float>(u);
                 m_shading_point.m_bary[1] = static_cast<float>(v);
@@ -1501,6 +1515,14 @@ void TriangleLeafVisitor::read_hit_triangle_data() const
         // Compute and store the support plane of the hit triangle.
         const TriangleReader reader(*m_hit_triangle);
         m_shading_point.m_triangle_support_plane.initialize(reader.m_triangle);
+
+        // Skip alpha map evaluation if the intersection filter found the triangle fully opaque.
+        if (m_hit_triangle_opaque)
+        {
+            m_shading_point.m_alpha.set(1.0f);
+            m_shading_point.m_members |= ShadingPoint::HasAlpha;
+        }
+        else m_shading_point.m_members &= ~ShadingPoint::HasAlpha;
     }
 }
 
@@ -1608,4 +1630,162 @@ bool TriangleLeafProbeVisitor::visit(
     return true;
 }
 
+
+//
+// Runtime-dispatched triangle tree intersection.
+//
+
+namespace
+{
+#ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
+    #define TRAVERSAL_STATS_PARAM   , bvh::TraversalStatistics& stats
+    #define TRAVERSAL_STATS_ARG     , stats
+#else
+    #define TRAVERSAL_STATS_PARAM
+    #define TRAVERSAL_STATS_ARG
+#endif
+
+    // The body of the intersection function is repeated in each variant, rather than
+    // factored into a helper function, so that the whole call tree gets flattened into
+    // code compiled for the variant's instruction set.
+    #define TRIANGLE_TREE_INTERSECTION_VARIANT(name, qualifiers)                    \
+        static qualifiers void name(                                                \
+            const TriangleTree&     tree,                                           \
+            const Ray3d&            ray,                                            \
+            const RayInfo3d&        ray_info,                                       \
+            const double            ray_time,                                       \
+            Visitor&                visitor                                         \
+            TRAVERSAL_STATS_PARAM)                                                  \
+        {                                                                           \
+            Intersector intersector;                                                \
+            if (tree.get_moving_triangle_count() > 0)                               \
+            {                                                                       \
+                intersector.intersect_motion(                                       \
+                    tree, ray, ray_info, ray_time, visitor TRAVERSAL_STATS_ARG);    \
+            }                                                                       \
+            else                                                                    \
+            {                                                                       \
+                intersector.intersect_no_motion(                                    \
+                    tree, ray, ray_info, visitor TRAVERSAL_STATS_ARG);              \
+            }                                                                       \
+        }
+
+    template <typename Intersector, typename Visitor>
+    struct TriangleTreeIntersection
+    {
+        typedef void (*FunctionType)(
+            const TriangleTree&     tree,
+            const Ray3d&            ray,
+            const RayInfo3d&        ray_info,
+            const double            ray_time,
+            Visitor&                visitor
+            TRAVERSAL_STATS_PARAM);
+
+        TRIANGLE_TREE_INTERSECTION_VARIANT(intersect_baseline, )
+
+#ifdef APPLESEED_CPU_DISPATCH
+        TRIANGLE_TREE_INTERSECTION_VARIANT(intersect_avx, APPLESEED_FLATTEN APPLESEED_TARGET_AVX)
+        TRIANGLE_TREE_INTERSECTION_VARIANT(intersect_avx2, APPLESEED_FLATTEN APPLESEED_TARGET_AVX2)
+#endif
+
+        // Pick the variant to run on the host and return the instruction set it was compiled for.
+        static FunctionType select(InstructionSet& isa)
+        {
+#ifdef APPLESEED_CPU_DISPATCH
+            // Tree traversal does not benefit from AVX-512, which may lower the clock frequency
+            // of the CPU: use the AVX2 variant on CPUs supporting AVX-512.
+            switch (get_dispatch_instruction_set())
+            {
+              case InstructionSetAVX512:
+              case InstructionSetAVX2:
+                isa = InstructionSetAVX2;
+                return &intersect_avx2;
+
+              case InstructionSetAVX:
+                isa = InstructionSetAVX;
+                return &intersect_avx;
+
+              default:
+                break;
+            }
+#endif
+
+            isa = get_compiled_instruction_set();
+            return &intersect_baseline;
+        }
+
+        static FunctionType select()
+        {
+            InstructionSet isa;
+            return select(isa);
+        }
+    };
+
+    #undef TRIANGLE_TREE_INTERSECTION_VARIANT
+    #undef TRAVERSAL_STATS_ARG
+    #undef TRAVERSAL_STATS_PARAM
+
+    typedef TriangleTreeIntersection<TriangleTreeIntersector, TriangleLeafVisitor> TriangleTreeIntersectionImpl;
+    typedef TriangleTreeIntersection<TriangleTreeProbeIntersector, TriangleLeafProbeVisitor> TriangleTreeProbeIntersectionImpl;
+
+    const TriangleTreeIntersectionImpl::FunctionType g_intersect_triangle_tree =
+        TriangleTreeIntersectionImpl::select();
+
+    const TriangleTreeProbeIntersectionImpl::FunctionType g_probe_triangle_tree =
+        TriangleTreeProbeIntersectionImpl::select();
+}
+
+const char* get_triangle_tree_intersection_instruction_set_name()
+{
+    InstructionSet isa;
+    TriangleTreeIntersectionImpl::select(isa);
+    return get_instruction_set_name(isa);
+}
+
+void intersect_triangle_tree(
+    const TriangleTree&                 tree,
+    const Ray3d&                        ray,
+    const RayInfo3d&                    ray_info,
+    const double                        ray_time,
+    TriangleLeafVisitor&                visitor
+#ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
+    , bvh::TraversalStatistics&         stats
+#endif
+    )
+{
+    g_intersect_triangle_tree(
+        tree,
+        ray,
+        ray_info,
+        ray_time,
+        visitor
+#ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
+        , stats
+#endif
+        );
+}
+
+void intersect_triangle_tree(
+    const TriangleTree&                 tree,
+    const Ray3d&                        ray,
+    const RayInfo3d&                    ray_info,
+    const double                        ray_time,
+    TriangleLeafProbeVisitor&           visitor
+#ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
+    , bvh::TraversalStatistics&         stats
+#endif
+    )
+{
+    g_probe_triangle_tree(
+        tree,
+        ray,
+        ray_info,
+        ray_time,
+        visitor
+#ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
+        , stats
+#endif
+        );
+}
+
 }   // namespace renderer
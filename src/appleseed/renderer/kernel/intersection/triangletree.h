@@ -236,6 +236,7 @@ class TriangleLeafVisitor
     GTriangleType           m_interpolated_triangle;
     const GTriangleType*    m_hit_triangle;
     size_t                  m_hit_triangle_index;
+    bool                    m_hit_triangle_opaque;
 };
 
 
@@ -292,6 +293,38 @@ typedef foundation::bvh::Intersector<
 > TriangleTreeProbeIntersector;
 
 
+//
+// Intersect a ray with a triangle tree, taking motion into account if the tree contains
+// moving triangles. Tree traversal and ray-triangle intersection are compiled for several
+// instruction sets and the widest one supported by the host CPU is used.
+//
+
+// Return the name of the instruction set of the intersection code path used on this host.
+const char* get_triangle_tree_intersection_instruction_set_name();
+
+void intersect_triangle_tree(
+    const TriangleTree&                         tree,
+    const foundation::Ray3d&                    ray,
+    const foundation::RayInfo3d&                ray_info,
+    const double                                ray_time,
+    TriangleLeafVisitor&                        visitor
+#ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
+    , foundation::bvh::TraversalStatistics&     stats
+#endif
+    );
+
+void intersect_triangle_tree(
+    const TriangleTree&                         tree,
+    const foundation::Ray3d&                    ray,
+    const foundation::RayInfo3d&                ray_info,
+    const double                                ray_time,
+    TriangleLeafProbeVisitor&                   visitor
+#ifdef FOUNDATION_BVH_ENABLE_TRAVERSAL_STATS
+    , foundation::bvh::TraversalStatistics&     stats
+#endif
+    );
+
+
 //
 // TriangleTree class implementation.
 //
@@ -318,6 +351,7 @@ inline TriangleLeafVisitor::TriangleLeafVisitor(
   , m_has_intersection_filters(!tree.m_intersection_filters.empty())
   , m_shading_point(shading_point)
   , m_hit_triangle(0)
+  , m_hit_triangle_opaque(false)
 {
 }
 
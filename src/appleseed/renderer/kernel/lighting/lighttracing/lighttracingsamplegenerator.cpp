@@ -69,6 +69,7 @@
 #include "foundation/image/color.h"
 #include "foundation/image/image.h"
 #include "foundation/math/basis.h"
+#include "foundation/math/hash.h"
 #include "foundation/math/population.h"
 #include "foundation/math/sampling/mappings.h"
 #include "foundation/math/scalar.h"
@@ -225,6 +226,14 @@ namespace
             m_rng = SamplingContext::RNGType();
         }
 
+        virtual void skip_sequence(const size_t bound) override
+        {
+            SampleGeneratorBase::skip_sequence(bound);
+
+            // Don't replay the random numbers that were consumed before the bound.
+            m_rng.reseed(hash_uint64(bound), hash_uint64(~static_cast<uint64>(bound)));
+        }
+
         virtual void generate_samples(
             const size_t                sample_count,
             SampleAccumulationBuffer&   buffer,
@@ -546,6 +555,13 @@ namespace
                 sequence_index,
                 sequence_index);
 
+            // Select the wavelengths carried by the light paths.
+            if (Spectrum::get_mode() == Spectrum::HeroWavelength)
+            {
+                sampling_context.split_in_place(1, 1);
+                Spectrum::set_hero_wavelengths(sampling_context.next2<float>());
+            }
+
             size_t stored_sample_count = 0;
 
             if (m_light_sampler.has_lights())
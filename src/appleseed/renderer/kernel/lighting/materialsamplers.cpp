@@ -30,6 +30,7 @@
 #include "materialsamplers.h"
 
 // appleseed.renderer headers.
+#include "renderer/kernel/lighting/sdtree.h"
 #include "renderer/kernel/lighting/tracer.h"
 #include "renderer/kernel/shading/shadingcomponents.h"
 #include "renderer/kernel/shading/shadingcontext.h"
@@ -171,6 +172,73 @@ bool BSDFSampler::cull_incoming_direction(const Vector3d& incoming) const
 }
 
 
+//
+// GuidedBSDFSampler class implementation.
+//
+
+GuidedBSDFSampler::GuidedBSDFSampler(
+    const BSDF&             bsdf,
+    const void*             bsdf_data,
+    const int               bsdf_sampling_modes,
+    const ShadingPoint&     shading_point,
+    const DTreeWrapper&     dtree,
+    const float             bsdf_sampling_fraction)
+  : BSDFSampler(bsdf, bsdf_data, bsdf_sampling_modes, shading_point)
+  , m_dtree(dtree)
+  , m_bsdf_sampling_fraction(bsdf_sampling_fraction)
+{
+}
+
+bool GuidedBSDFSampler::sample(
+    SamplingContext&        sampling_context,
+    const Dual3d&           outgoing,
+    Dual3f&                 incoming,
+    ShadingComponents&      value,
+    float&                  pdf) const
+{
+    BSDFSample sample(&m_shading_point, Dual3f(outgoing));
+    sample_guided_bsdf(
+        sampling_context,
+        m_dtree,
+        m_bsdf_sampling_fraction,
+        m_bsdf,
+        m_bsdf_data,
+        m_bsdf_sampling_modes,
+        sample);
+
+    // Filter scattering modes.
+    if (!(m_bsdf_sampling_modes & sample.m_mode))
+        return false;
+
+    incoming = sample.m_incoming;
+    value = sample.m_value;
+    pdf = sample.m_probability;
+    return true;
+}
+
+float GuidedBSDFSampler::evaluate(
+    const int               light_sampling_modes,
+    const Vector3f&         outgoing,
+    const Vector3f&         incoming,
+    ShadingComponents&      value) const
+{
+    const float bsdf_pdf =
+        BSDFSampler::evaluate(
+            light_sampling_modes,
+            outgoing,
+            incoming,
+            value);
+
+    // The MIS weights of light samples must account for the guided sampling mixture.
+    return
+        mix_guided_pdf(
+            m_dtree,
+            m_bsdf_sampling_fraction,
+            incoming,
+            bsdf_pdf);
+}
+
+
 //
 // VolumeSampler class implementation.
 //
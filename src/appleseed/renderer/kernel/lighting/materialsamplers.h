@@ -40,6 +40,7 @@
 
 // Forward declarations.
 namespace renderer  { class BSDF; }
+namespace renderer  { class DTreeWrapper; }
 namespace renderer  { class ShadingComponents; }
 namespace renderer  { class ShadingContext; }
 namespace renderer  { class ShadingPoint; }
@@ -127,7 +128,7 @@ class BSDFSampler
     virtual bool cull_incoming_direction(
         const foundation::Vector3d&  incoming) const override;
 
-  private:
+  protected:
     const BSDF&                         m_bsdf;
     const void*                         m_bsdf_data;
     const int                           m_bsdf_sampling_modes;
@@ -136,6 +137,36 @@ class BSDFSampler
     const ShadingPoint&                 m_shading_point;
 };
 
+class GuidedBSDFSampler
+  : public BSDFSampler
+{
+  public:
+    GuidedBSDFSampler(
+        const BSDF&                     bsdf,
+        const void*                     bsdf_data,
+        const int                       bsdf_sampling_modes,
+        const ShadingPoint&             shading_point,
+        const DTreeWrapper&             dtree,
+        const float                     bsdf_sampling_fraction);
+
+    virtual bool sample(
+        SamplingContext&                sampling_context,
+        const foundation::Dual3d&       outgoing,
+        foundation::Dual3f&             incoming,
+        ShadingComponents&              value,
+        float&                          pdf) const override;
+
+    virtual float evaluate(
+        const int                       light_sampling_modes,
+        const foundation::Vector3f&     outgoing,
+        const foundation::Vector3f&     incoming,
+        ShadingComponents&              value) const override;
+
+  private:
+    const DTreeWrapper&                 m_dtree;
+    const float                         m_bsdf_sampling_fraction;
+};
+
 class VolumeSampler
   : public IMaterialSampler
 {
@@ -36,6 +36,7 @@
 #include "renderer/kernel/intersection/intersector.h"
 #include "renderer/kernel/lighting/pathvertex.h"
 #include "renderer/kernel/lighting/scatteringmode.h"
+#include "renderer/kernel/lighting/sdtree.h"
 #include "renderer/kernel/shading/shadingcontext.h"
 #include "renderer/kernel/shading/shadingpoint.h"
 #include "renderer/kernel/shading/shadingray.h"
@@ -646,13 +647,28 @@ bool PathTracer<PathVisitor, VolumeVisitor, Adjoint>::process_bounce(
     // Above-surface scattering.
     if (vertex.m_bssrdf == nullptr)
     {
-        vertex.m_bsdf->sample(
-            sampling_context,
-            vertex.m_bsdf_data,
-            Adjoint,
-            true,       // multiply by |cos(incoming, normal)|
-            vertex.m_scattering_modes,
-            sample);
+        if (!Adjoint && vertex.m_guiding_dtree != nullptr)
+        {
+            // Mix BSDF sampling with sampling of the learned radiance distribution.
+            sample_guided_bsdf(
+                sampling_context,
+                *vertex.m_guiding_dtree,
+                vertex.m_bsdf_sampling_fraction,
+                *vertex.m_bsdf,
+                vertex.m_bsdf_data,
+                vertex.m_scattering_modes,
+                sample);
+        }
+        else
+        {
+            vertex.m_bsdf->sample(
+                sampling_context,
+                vertex.m_bsdf_data,
+                Adjoint,
+                true,       // multiply by |cos(incoming, normal)|
+                vertex.m_scattering_modes,
+                sample);
+        }
     }
 
     // Terminate the path if it gets absorbed.
@@ -768,95 +784,130 @@ bool PathTracer<PathVisitor, VolumeVisitor, Adjoint>::march(
             break;
         }
 
-        // Retrieve extinction spectrum.
-        const Spectrum& extinction_coef =
-            volume->extinction_coefficient(vertex.m_volume_data, volume_ray);
+        float distance_sample;
+
+        if (volume->is_homogeneous())
+        {
+            // Retrieve extinction spectrum.
+            const Spectrum& extinction_coef =
+                volume->extinction_coefficient(vertex.m_volume_data, volume_ray);
         
-        sampling_context.split_in_place(1, 2);
+            sampling_context.split_in_place(1, 2);
 
-        // Sample channel uniformly at random.
-        const float s = sampling_context.next2<float>();
-        const size_t channel = foundation::truncate<size_t>(s * Spectrum::size());
-        const bool extinction_is_null = extinction_coef[channel] < 1.0e-6f;
+            // Sample channel uniformly at random.
+            const float s = sampling_context.next2<float>();
+            const size_t channel = foundation::truncate<size_t>(s * Spectrum::size());
+            const bool extinction_is_null = extinction_coef[channel] < 1.0e-6f;
 
-        // Sample distance.
-        float distance_sample, distance_pdf;
-        if (extinction_is_null)
-        {
-            distance_sample = 0.0f;
-            distance_pdf = 0.0f;
-        }
-        else
-        {
-            distance_sample =
-                foundation::sample_exponential_distribution(
-                    sampling_context.next2<float>(),
-                    extinction_coef[channel]);
-            distance_pdf =
-                foundation::exponential_distribution_pdf(
-                    distance_sample,
-                    extinction_coef[channel]);
-        }
+            // Sample distance.
+            float distance_pdf;
+            if (extinction_is_null)
+            {
+                distance_sample = 0.0f;
+                distance_pdf = 0.0f;
+            }
+            else
+            {
+                distance_sample =
+                    foundation::sample_exponential_distribution(
+                        sampling_context.next2<float>(),
+                        extinction_coef[channel]);
+                distance_pdf =
+                    foundation::exponential_distribution_pdf(
+                        distance_sample,
+                        extinction_coef[channel]);
+            }
 
-        // Continue path tracing if sampled distance exceeds total length of the ray,
-        // otherwise process the scattering event.
-        if (extinction_is_null || volume_ray.m_tmax < distance_sample)
-        {
+            // Continue path tracing if sampled distance exceeds total length of the ray,
+            // otherwise process the scattering event.
+            if (extinction_is_null || volume_ray.m_tmax < distance_sample)
+            {
+                Spectrum transmission;
+                volume->evaluate_transmission(
+                    vertex.m_volume_data,
+                    volume_ray,
+                    transmission);
+                vertex.m_throughput *= transmission;
+                vertex.m_throughput /=                       // equivalent to multiplying by MIS weight
+                    foundation::average_value(transmission); // and then dividing by transmission[channel]
+                break;
+            }
+
+            //
+            // Bounce.
+            //
+
+            // Terminate the path if this scattering event is not accepted.
+            if (!m_volume_visitor.accept_scattering(vertex.m_prev_mode))
+                return false;
+
+            // Let the volume visitor handle the scattering event.
+            m_volume_visitor.on_scatter(vertex);
+
+            // Retrieve scattering spectrum.
+            const Spectrum& scattering_coef =
+                volume->scattering_coefficient(vertex.m_volume_data, volume_ray);
+
+            // Evaluate transmission between the origin and the sampled distance.
             Spectrum transmission;
             volume->evaluate_transmission(
                 vertex.m_volume_data,
                 volume_ray,
+                distance_sample,
                 transmission);
+        
+            // Compute MIS weight.
+            // MIS terms are:
+            //  - scattering albedo,
+            //  - throughput of the entire path up to the sampled point.
+            // Reference: "Practical and Controllable Subsurface Scattering
+            // for Production Path Tracing", p. 1 [ACM 2016 Article].
+            float mis_weights_sum = 0.0f;
+            for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
+            {
+                if (extinction_coef[i] > 1.0e-6f)
+                    mis_weights_sum += transmission[i] * scattering_coef[i] / extinction_coef[i];
+            }
+            if (mis_weights_sum < 1.0e-6f)
+                return false;  // no scattering
+            const float current_mis_weight =
+                (Spectrum::size() * transmission[channel] * scattering_coef[channel]) /
+                (extinction_coef[channel] * mis_weights_sum);
+
+            vertex.m_throughput *= scattering_coef;
             vertex.m_throughput *= transmission;
-            vertex.m_throughput /=                       // equivalent to multiplying by MIS weight
-                foundation::average_value(transmission); // and then dividing by transmission[channel]
-            break;
+            vertex.m_throughput *= current_mis_weight / distance_pdf;
         }
+        else
+        {
+            // Sample the distance to the next scattering event by tracking through the volume.
+            // The returned weight accounts for transmission, for the scattering coefficient
+            // at the sampled point and for the probability of sampling it.
+            Spectrum weight;
+            const bool scattered =
+                volume->sample_distance(
+                    sampling_context,
+                    vertex.m_volume_data,
+                    volume_ray,
+                    distance_sample,
+                    weight);
+            // Terminate the path if it gets absorbed.
+            if (!scattered && foundation::is_zero(weight))
+                return false;
 
-        //
-        // Bounce.
-        //
-
-        // Terminate the path if this scattering event is not accepted.
-        if (!m_volume_visitor.accept_scattering(vertex.m_prev_mode))
-            return false;
+            vertex.m_throughput *= weight;
 
-        // Let the volume visitor handle the scattering event.
-        m_volume_visitor.on_scatter(vertex);
+            // Continue path tracing if the ray left the volume segment without scattering.
+            if (!scattered)
+                break;
 
-        // Retrieve scattering spectrum.
-        const Spectrum& scattering_coef =
-            volume->scattering_coefficient(vertex.m_volume_data, volume_ray);
+            // Terminate the path if this scattering event is not accepted.
+            if (!m_volume_visitor.accept_scattering(vertex.m_prev_mode))
+                return false;
 
-        // Evaluate transmission between the origin and the sampled distance.
-        Spectrum transmission;
-        volume->evaluate_transmission(
-            vertex.m_volume_data,
-            volume_ray,
-            distance_sample,
-            transmission);
-        
-        // Compute MIS weight.
-        // MIS terms are:
-        //  - scattering albedo,
-        //  - throughput of the entire path up to the sampled point.
-        // Reference: "Practical and Controllable Subsurface Scattering
-        // for Production Path Tracing", p. 1 [ACM 2016 Article].
-        float mis_weights_sum = 0.0f;
-        for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
-        {
-            if (extinction_coef[i] > 1.0e-6f)
-                mis_weights_sum += transmission[i] * scattering_coef[i] / extinction_coef[i];
+            // Let the volume visitor handle the scattering event.
+            m_volume_visitor.on_scatter(vertex);
         }
-        if (mis_weights_sum < 1.0e-6f)
-            return false;  // no scattering
-        const float current_mis_weight =
-            (Spectrum::size() * transmission[channel] * scattering_coef[channel]) /
-            (extinction_coef[channel] * mis_weights_sum);
-
-        vertex.m_throughput *= scattering_coef;
-        vertex.m_throughput *= transmission;
-        vertex.m_throughput *= current_mis_weight / distance_pdf;
 
         // Sample phase function.
         foundation::Vector3f incoming;
@@ -50,6 +50,7 @@
 // Forward declarations.
 namespace renderer  { class BSDF; }
 namespace renderer  { class BSSRDF; }
+namespace renderer  { class DTreeWrapper; }
 namespace renderer  { class EDF; }
 namespace renderer  { class Material; }
 namespace renderer  { class ShadingContext; }
@@ -92,6 +93,10 @@ class PathVertex
     // AOV properties.
     ScatteringMode::Mode        m_aov_mode;
 
+    // Path guiding properties, set by path visitors to guide the sampling of the next direction.
+    const DTreeWrapper*         m_guiding_dtree;
+    float                       m_bsdf_sampling_fraction;
+
     // Constructor.
     explicit PathVertex(SamplingContext& sampling_context);
 
@@ -124,6 +129,7 @@ class PathVertex
 
 inline PathVertex::PathVertex(SamplingContext& sampling_context)
   : m_sampling_context(sampling_context)
+  , m_guiding_dtree(nullptr)
 {
 }
 
@@ -36,8 +36,11 @@
 #include "renderer/kernel/lighting/directlightingintegrator.h"
 #include "renderer/kernel/lighting/imagebasedlighting.h"
 #include "renderer/kernel/lighting/pathtracer.h"
+#include "renderer/kernel/lighting/materialsamplers.h"
 #include "renderer/kernel/lighting/pathvertex.h"
+#include "renderer/kernel/lighting/radiancecache.h"
 #include "renderer/kernel/lighting/scatteringmode.h"
+#include "renderer/kernel/lighting/sdtree.h"
 #include "renderer/kernel/shading/shadingcomponents.h"
 #include "renderer/kernel/shading/shadingcontext.h"
 #include "renderer/kernel/shading/shadingpoint.h"
@@ -118,6 +121,18 @@ namespace
 
             const size_t    m_distance_sample_count;        // number of distance samples until the ray is completely extincted
 
+            const bool      m_enable_path_guiding;          // is path guiding enabled?
+            const size_t    m_guiding_training_iterations;  // number of path guiding training iterations
+            const size_t    m_guiding_initial_paths;        // number of paths traced during the first training iteration
+            const size_t    m_guiding_spatial_threshold;    // number of samples above which a spatial cell is split
+            const float     m_guiding_directional_threshold;// fraction of the cell's radiance above which a directional cell is split
+            const float     m_guiding_bsdf_fraction;        // probability of sampling the BSDF rather than the guiding distribution
+
+            const bool      m_enable_radiance_cache;        // is the radiance cache enabled?
+            const float     m_radiance_cache_cell_size;     // size of radiance cache cells, relative to the scene diameter
+            const size_t    m_radiance_cache_min_samples;   // number of samples a radiance cache cell needs before it can be used
+            const size_t    m_radiance_cache_max_entries;   // maximum number of radiance cache cells
+
             float           m_rcp_dl_light_sample_count;
             float           m_rcp_ibl_env_sample_count;
 
@@ -138,6 +153,16 @@ namespace
               , m_has_max_ray_intensity(params.strings().exist("max_ray_intensity"))
               , m_distance_sample_count(params.get_optional<size_t>("volume_distance_samples", 4))
               , m_max_ray_intensity(params.get_optional<float>("max_ray_intensity", 0.0f))
+              , m_enable_path_guiding(params.get_optional<bool>("enable_path_guiding", false))
+              , m_guiding_training_iterations(params.get_optional<size_t>("guiding_training_iterations", 8))
+              , m_guiding_initial_paths(params.get_optional<size_t>("guiding_initial_paths", 256 * 1024))
+              , m_guiding_spatial_threshold(params.get_optional<size_t>("guiding_spatial_threshold", 12000))
+              , m_guiding_directional_threshold(params.get_optional<float>("guiding_directional_threshold", 0.01f))
+              , m_guiding_bsdf_fraction(clamp(params.get_optional<float>("guiding_bsdf_fraction", 0.5f), 0.0f, 1.0f))
+              , m_enable_radiance_cache(params.get_optional<bool>("enable_radiance_cache", false))
+              , m_radiance_cache_cell_size(params.get_optional<float>("radiance_cache_cell_size", 0.005f))
+              , m_radiance_cache_min_samples(params.get_optional<size_t>("radiance_cache_min_samples", 16))
+              , m_radiance_cache_max_entries(params.get_optional<size_t>("radiance_cache_max_entries", 256 * 1024))
             {
                 // Precompute the reciprocal of the number of light samples.
                 m_rcp_dl_light_sample_count =
@@ -180,7 +205,14 @@ namespace
                     "  dl light threshold            %s\n"
                     "  ibl env samples               %s\n"
                     "  max ray intensity             %s\n"
-                    "  volume distance samples       %s",
+                    "  volume distance samples       %s\n"
+                    "  path guiding                  %s\n"
+                    "  guiding training iterations   %s\n"
+                    "  guiding initial paths         %s\n"
+                    "  guiding bsdf fraction         %s\n"
+                    "  radiance cache                %s\n"
+                    "  radiance cache cell size      %s\n"
+                    "  radiance cache min samples    %s",
                     m_enable_dl ? "on" : "off",
                     m_enable_ibl ? "on" : "off",
                     m_enable_caustics ? "on" : "off",
@@ -195,16 +227,29 @@ namespace
                     pretty_scalar(m_dl_low_light_threshold, 3).c_str(),
                     pretty_scalar(m_ibl_env_sample_count).c_str(),
                     m_has_max_ray_intensity ? pretty_scalar(m_max_ray_intensity).c_str() : "infinite",
-                    pretty_int(m_distance_sample_count).c_str());
+                    pretty_int(m_distance_sample_count).c_str(),
+                    m_enable_path_guiding ? "on" : "off",
+                    pretty_uint(m_guiding_training_iterations).c_str(),
+                    pretty_uint(m_guiding_initial_paths).c_str(),
+                    pretty_scalar(m_guiding_bsdf_fraction, 2).c_str(),
+                    m_enable_radiance_cache ? "on" : "off",
+                    pretty_scalar(m_radiance_cache_cell_size, 4).c_str(),
+                    pretty_uint(m_radiance_cache_min_samples).c_str());
             }
         };
 
         PTLightingEngine(
             const BackwardLightSampler&     light_sampler,
+            SDTree*                         sd_tree,
+            RadianceCache*                  radiance_cache,
             const ParamArray&               params)
           : m_params(params)
           , m_light_sampler(light_sampler)
+          , m_sd_tree(sd_tree)
+          , m_radiance_cache(radiance_cache)
           , m_path_count(0)
+          , m_radiance_cache_lookup_count(0)
+          , m_radiance_cache_hit_count(0)
           , m_inf_volume_ray_warnings(0)
         {
         }
@@ -249,6 +294,8 @@ namespace
             PathVisitor path_visitor(
                 m_params,
                 m_light_sampler,
+                m_sd_tree,
+                m_radiance_cache,
                 sampling_context,
                 shading_context,
                 shading_point.get_scene(),
@@ -280,6 +327,21 @@ namespace
                     shading_context,
                     shading_point);
 
+            // Feed the radiance collected along the path to the path guiding cache.
+            if (m_sd_tree && m_sd_tree->is_training())
+            {
+                path_visitor.record_guiding_samples();
+                m_sd_tree->on_path_end();
+            }
+
+            // Feed the radiance collected along the path to the radiance cache.
+            if (m_radiance_cache)
+            {
+                path_visitor.record_radiance_cache_samples();
+                m_radiance_cache_lookup_count += path_visitor.m_radiance_cache_lookup_count;
+                m_radiance_cache_hit_count += path_visitor.m_radiance_cache_hit_count;
+            }
+
             // Update statistics.
             ++m_path_count;
             m_path_length.insert(path_length);
@@ -291,15 +353,28 @@ namespace
             stats.insert("path count", m_path_count);
             stats.insert("path length", m_path_length);
 
+            if (m_radiance_cache)
+            {
+                stats.insert_percent(
+                    "radiance cache hit rate",
+                    m_radiance_cache_hit_count,
+                    m_radiance_cache_lookup_count);
+                stats.insert<uint64>("radiance cache cells", m_radiance_cache->get_entry_count());
+            }
+
             return StatisticsVector::make("path tracing statistics", stats);
         }
 
       private:
         const Parameters                m_params;
         const BackwardLightSampler&     m_light_sampler;
+        SDTree*                         m_sd_tree;
+        RadianceCache*                  m_radiance_cache;
 
         uint64                          m_path_count;
         Population<uint64>              m_path_length;
+        uint64                          m_radiance_cache_lookup_count;
+        uint64                          m_radiance_cache_hit_count;
 
         size_t                          m_inf_volume_ray_warnings;
         static const size_t             MaxInfVolumeRayWarnings = 5;
@@ -310,6 +385,28 @@ namespace
 
         struct PathVisitorBase
         {
+            // A path vertex whose sampled direction feeds the path guiding cache.
+            struct GuidingVertex
+            {
+                DTreeWrapper*               m_dtree;
+                Vector3f                    m_direction;
+                float                       m_throughput;           // average path throughput after scattering at this vertex
+                float                       m_pdf;                  // probability density of the sampled direction
+                float                       m_radiance_before;      // average path radiance before scattering at this vertex
+            };
+
+            static const size_t MaxGuidingVertices = 32;
+
+            // A path vertex whose outgoing radiance feeds the radiance cache.
+            struct CacheVertex
+            {
+                uint64                      m_key;
+                Spectrum                    m_throughput;           // path throughput at this vertex
+                Spectrum                    m_radiance_before;      // path radiance before scattering at this vertex
+            };
+
+            static const size_t MaxCacheVertices = 16;
+
             const Parameters&               m_params;
             const BackwardLightSampler&     m_light_sampler;
             SamplingContext&                m_sampling_context;
@@ -318,9 +415,23 @@ namespace
             ShadingComponents&              m_path_radiance;
             bool                            m_omit_emitted_light;
 
+            STree*                          m_stree;
+            DTreeWrapper*                   m_guiding_dtree;        // guiding distribution of the current vertex, if any
+            GuidingVertex                   m_guiding_vertices[MaxGuidingVertices];
+            size_t                          m_guiding_vertex_count;
+
+            RadianceCache*                  m_radiance_cache;
+            float                           m_rcp_radiance_cache_cell_size;
+            CacheVertex                     m_cache_vertices[MaxCacheVertices];
+            size_t                          m_cache_vertex_count;
+            uint64                          m_radiance_cache_lookup_count;
+            uint64                          m_radiance_cache_hit_count;
+
             PathVisitorBase(
                 const Parameters&               params,
                 const BackwardLightSampler&     light_sampler,
+                SDTree*                         sd_tree,
+                RadianceCache*                  radiance_cache,
                 SamplingContext&                sampling_context,
                 const ShadingContext&           shading_context,
                 const Scene&                    scene,
@@ -332,7 +443,153 @@ namespace
               , m_env_edf(scene.get_environment()->get_environment_edf())
               , m_path_radiance(path_radiance)
               , m_omit_emitted_light(false)
+              , m_stree(sd_tree ? sd_tree->get_stree(scene.get_render_data().m_bbox) : nullptr)
+              , m_guiding_dtree(nullptr)
+              , m_guiding_vertex_count(0)
+              , m_radiance_cache(radiance_cache)
+              , m_rcp_radiance_cache_cell_size(0.0f)
+              , m_cache_vertex_count(0)
+              , m_radiance_cache_lookup_count(0)
+              , m_radiance_cache_hit_count(0)
+            {
+                if (m_radiance_cache)
+                {
+                    const float cell_size =
+                        params.m_radiance_cache_cell_size * scene.get_render_data().m_safe_diameter;
+                    m_rcp_radiance_cache_cell_size = cell_size > 0.0f ? 1.0f / cell_size : 1.0f;
+                }
+            }
+
+            // Terminate the path into the radiance cache if possible. Return true if the path was terminated.
+            bool terminate_into_radiance_cache(PathVertex& vertex)
+            {
+                if (m_radiance_cache == nullptr)
+                    return false;
+
+                // Only use the cache after a diffuse bounce and at vertices that scatter light diffusely,
+                // where the cached radiance does not depend on the outgoing direction.
+                if (vertex.m_prev_mode != ScatteringMode::Diffuse ||
+                    vertex.m_bsdf == nullptr ||
+                    !vertex.m_bsdf->is_purely_diffuse() ||
+                    vertex.m_bssrdf != nullptr)
+                    return false;
+
+                const uint64 key =
+                    RadianceCache::make_key(
+                        Vector3f(vertex.get_point()),
+                        Vector3f(vertex.get_geometric_normal()),
+                        m_rcp_radiance_cache_cell_size);
+
+                ++m_radiance_cache_lookup_count;
+
+                Spectrum cached_radiance;
+                if (m_radiance_cache->lookup(key, cached_radiance))
+                {
+                    ++m_radiance_cache_hit_count;
+
+                    // Update the path radiance.
+                    cached_radiance *= vertex.m_throughput;
+                    m_path_radiance.add_to_component(vertex.m_aov_mode, cached_radiance);
+
+                    // Terminate the path.
+                    vertex.m_scattering_modes = ScatteringMode::None;
+                    return true;
+                }
+
+                // Remember this vertex such that it can fill the cache once the path is complete.
+                if (m_cache_vertex_count < MaxCacheVertices)
+                {
+                    CacheVertex& cache_vertex = m_cache_vertices[m_cache_vertex_count++];
+                    cache_vertex.m_key = key;
+                    cache_vertex.m_throughput = vertex.m_throughput;
+                    cache_vertex.m_radiance_before = m_path_radiance.m_beauty;
+                }
+
+                return false;
+            }
+
+            void record_radiance_cache_samples() const
             {
+                const size_t size = Spectrum::size();
+
+                for (size_t i = 0; i < m_cache_vertex_count; ++i)
+                {
+                    const CacheVertex& cache_vertex = m_cache_vertices[i];
+
+                    // Radiance leaving the vertex toward the previous vertex of the path.
+                    Spectrum outgoing_radiance;
+                    for (size_t j = 0; j < size; ++j)
+                    {
+                        const float throughput = cache_vertex.m_throughput[j];
+                        outgoing_radiance[j] =
+                            throughput > 0.0f
+                                ? max((m_path_radiance.m_beauty[j] - cache_vertex.m_radiance_before[j]) / throughput, 0.0f)
+                                : 0.0f;
+                    }
+
+                    m_radiance_cache->record(cache_vertex.m_key, outgoing_radiance);
+                }
+            }
+
+            void guide_scattering(PathVertex& vertex)
+            {
+                m_guiding_dtree = nullptr;
+                vertex.m_guiding_dtree = nullptr;
+
+                if (m_stree == nullptr || vertex.m_bsdf == nullptr || vertex.m_bssrdf != nullptr)
+                    return;
+
+                m_guiding_dtree = m_stree->get_dtree_wrapper(Vector3f(vertex.get_point()));
+
+                // Let the path tracer sample the next direction from the guiding distribution.
+                vertex.m_guiding_dtree = m_guiding_dtree;
+                vertex.m_bsdf_sampling_fraction = m_params.m_guiding_bsdf_fraction;
+            }
+
+            void add_guiding_vertex(const PathVertex& vertex)
+            {
+                if (m_guiding_dtree == nullptr)
+                    return;
+
+                DTreeWrapper* dtree = m_guiding_dtree;
+                m_guiding_dtree = nullptr;
+
+                // Only directions sampled from continuous distributions can be guided.
+                if (vertex.m_prev_mode != ScatteringMode::Diffuse &&
+                    vertex.m_prev_mode != ScatteringMode::Glossy)
+                    return;
+
+                if (m_guiding_vertex_count == MaxGuidingVertices)
+                    return;
+
+                const float throughput = average_value(vertex.m_throughput);
+                if (throughput <= 0.0f || vertex.m_prev_prob <= 0.0f)
+                    return;
+
+                GuidingVertex& guiding_vertex = m_guiding_vertices[m_guiding_vertex_count++];
+                guiding_vertex.m_dtree = dtree;
+                guiding_vertex.m_direction = normalize(-Vector3f(vertex.m_outgoing.get_value()));
+                guiding_vertex.m_throughput = throughput;
+                guiding_vertex.m_pdf = vertex.m_prev_prob;
+                guiding_vertex.m_radiance_before = average_value(m_path_radiance.m_beauty);
+            }
+
+            void record_guiding_samples() const
+            {
+                const float path_radiance = average_value(m_path_radiance.m_beauty);
+
+                for (size_t i = 0; i < m_guiding_vertex_count; ++i)
+                {
+                    const GuidingVertex& guiding_vertex = m_guiding_vertices[i];
+
+                    // Radiance arriving at the vertex from the sampled direction.
+                    const float incoming_radiance =
+                        (path_radiance - guiding_vertex.m_radiance_before) / guiding_vertex.m_throughput;
+
+                    guiding_vertex.m_dtree->record(
+                        guiding_vertex.m_direction,
+                        max(incoming_radiance, 0.0f) / guiding_vertex.m_pdf);
+                }
             }
 
             bool accept_scattering(
@@ -368,6 +625,8 @@ namespace
             PathVisitorSimple(
                 const Parameters&               params,
                 const BackwardLightSampler&     light_sampler,
+                SDTree*                         sd_tree,
+                RadianceCache*                  radiance_cache,
                 SamplingContext&                sampling_context,
                 const ShadingContext&           shading_context,
                 const Scene&                    scene,
@@ -375,6 +634,8 @@ namespace
               : PathVisitorBase(
                     params,
                     light_sampler,
+                    sd_tree,
+                    radiance_cache,
                     sampling_context,
                     shading_context,
                     scene,
@@ -386,6 +647,8 @@ namespace
             {
                 assert(vertex.m_prev_mode != ScatteringMode::None);
 
+                add_guiding_vertex(vertex);
+
                 // Can't look up the environment if there's no environment EDF.
                 if (m_env_edf == 0)
                     return;
@@ -413,6 +676,8 @@ namespace
 
             void on_hit(const PathVertex& vertex)
             {
+                add_guiding_vertex(vertex);
+
                 // Emitted light contribution.
                 if ((!m_omit_emitted_light || m_params.m_enable_caustics) &&
                     vertex.m_edf &&
@@ -446,6 +711,12 @@ namespace
                 // Terminate the path if all scattering modes are disabled.
                 if (vertex.m_scattering_modes == ScatteringMode::None)
                     return;
+
+                // Terminate the path if the radiance leaving this vertex is already known.
+                if (terminate_into_radiance_cache(vertex))
+                    return;
+
+                guide_scattering(vertex);
             }
         };
 
@@ -461,6 +732,8 @@ namespace
             PathVisitorNextEventEstimation(
                 const Parameters&               params,
                 const BackwardLightSampler&     light_sampler,
+                SDTree*                         sd_tree,
+                RadianceCache*                  radiance_cache,
                 SamplingContext&                sampling_context,
                 const ShadingContext&           shading_context,
                 const Scene&                    scene,
@@ -468,6 +741,8 @@ namespace
               : PathVisitorBase(
                     params,
                     light_sampler,
+                    sd_tree,
+                    radiance_cache,
                     sampling_context,
                     shading_context,
                     scene,
@@ -480,6 +755,8 @@ namespace
             {
                 assert(vertex.m_prev_mode != ScatteringMode::None);
 
+                add_guiding_vertex(vertex);
+
                 // Can't look up the environment if there's no environment EDF.
                 if (m_env_edf == 0)
                     return;
@@ -530,6 +807,8 @@ namespace
 
             void on_hit(const PathVertex& vertex)
             {
+                add_guiding_vertex(vertex);
+
                 // Emitted light contribution.
                 if ((!m_omit_emitted_light || m_params.m_enable_caustics) &&
                     vertex.m_edf &&
@@ -569,6 +848,12 @@ namespace
                 if (vertex.m_scattering_modes == ScatteringMode::None)
                     return;
 
+                // Terminate the path if the radiance leaving this vertex is already known.
+                if (terminate_into_radiance_cache(vertex))
+                    return;
+
+                guide_scattering(vertex);
+
                 ShadingComponents vertex_radiance;
 
                 if (vertex.m_bssrdf == 0)
@@ -590,33 +875,31 @@ namespace
                     }
                 }
 
-                // Direct lighting contribution.
-                if (m_params.m_enable_dl || vertex.m_path_length > 1)
+                if (vertex.m_bsdf)
                 {
-                    if (vertex.m_bsdf)
+                    // When the next direction is guided, light samples must be weighted
+                    // against the probability density of the guided sampling mixture.
+                    if (m_guiding_dtree)
                     {
-                        add_direct_lighting_contribution_bsdf(
-                            *vertex.m_shading_point,
-                            vertex.m_outgoing,
+                        const GuidedBSDFSampler bsdf_sampler(
                             *vertex.m_bsdf,
                             vertex.m_bsdf_data,
-                            vertex.m_scattering_modes,
-                            vertex_radiance);
-                    }
-                }
+                            vertex.m_scattering_modes,  // bsdf_sampling_modes (unused)
+                            *vertex.m_shading_point,
+                            *m_guiding_dtree,
+                            m_params.m_guiding_bsdf_fraction);
 
-                // Image-based lighting contribution.
-                if (m_params.m_enable_ibl && m_env_edf)
-                {
-                    if (vertex.m_bsdf)
+                        add_light_contributions_bsdf(vertex, bsdf_sampler, vertex_radiance);
+                    }
+                    else
                     {
-                        add_image_based_lighting_contribution_bsdf(
-                            *vertex.m_shading_point,
-                            vertex.m_outgoing,
+                        const BSDFSampler bsdf_sampler(
                             *vertex.m_bsdf,
                             vertex.m_bsdf_data,
-                            vertex.m_scattering_modes,
-                            vertex_radiance);
+                            vertex.m_scattering_modes,  // bsdf_sampling_modes (unused)
+                            *vertex.m_shading_point);
+
+                        add_light_contributions_bsdf(vertex, bsdf_sampler, vertex_radiance);
                     }
                 }
 
@@ -657,11 +940,38 @@ namespace
                 vertex_radiance += emitted_radiance;
             }
 
+            void add_light_contributions_bsdf(
+                const PathVertex&       vertex,
+                const BSDFSampler&      bsdf_sampler,
+                ShadingComponents&      vertex_radiance)
+            {
+                // Direct lighting contribution.
+                if (m_params.m_enable_dl || vertex.m_path_length > 1)
+                {
+                    add_direct_lighting_contribution_bsdf(
+                        *vertex.m_shading_point,
+                        vertex.m_outgoing,
+                        bsdf_sampler,
+                        vertex.m_scattering_modes,
+                        vertex_radiance);
+                }
+
+                // Image-based lighting contribution.
+                if (m_params.m_enable_ibl && m_env_edf)
+                {
+                    add_image_based_lighting_contribution_bsdf(
+                        *vertex.m_shading_point,
+                        vertex.m_outgoing,
+                        bsdf_sampler,
+                        vertex.m_scattering_modes,
+                        vertex_radiance);
+                }
+            }
+
             void add_direct_lighting_contribution_bsdf(
                 const ShadingPoint&     shading_point,
                 const Dual3d&           outgoing,
-                const BSDF&             bsdf,
-                const void*             bsdf_data,
+                const BSDFSampler&      bsdf_sampler,
                 const int               scattering_modes,
                 ShadingComponents&      vertex_radiance)
             {
@@ -675,12 +985,6 @@ namespace
                 if (light_sample_count == 0)
                     return;
 
-                const BSDFSampler bsdf_sampler(
-                    bsdf,
-                    bsdf_data,
-                    scattering_modes,   // bsdf_sampling_modes (unused)
-                    shading_point);
-
                 // This path will be extended via BSDF sampling: sample the lights only.
                 const DirectLightingIntegrator integrator(
                     m_shading_context,
@@ -710,8 +1014,7 @@ namespace
             void add_image_based_lighting_contribution_bsdf(
                 const ShadingPoint&     shading_point,
                 const Dual3d&           outgoing,
-                const BSDF&             bsdf,
-                const void*             bsdf_data,
+                const BSDFSampler&      bsdf_sampler,
                 const int               scattering_modes,
                 ShadingComponents&      vertex_radiance)
             {
@@ -722,12 +1025,6 @@ namespace
                         m_sampling_context,
                         m_params.m_ibl_env_sample_count);
 
-                const BSDFSampler bsdf_sampler(
-                    bsdf,
-                    bsdf_data,
-                    scattering_modes,   // bsdf_sampling_modes (unused)
-                    shading_point);
-
                 // This path will be extended via BSDF sampling: sample the environment only.
                 compute_ibl_environment_sampling(
                     m_sampling_context,
@@ -1024,6 +1321,12 @@ namespace
                 const Volume* volume = medium->get_volume();
                 assert(volume != nullptr);
 
+                if (!volume->is_homogeneous())
+                {
+                    visit_heterogeneous_ray(vertex, volume_ray, *volume);
+                    return;
+                }
+
                 // Get full ray transmission.
                 Spectrum ray_transmission;
                 volume->evaluate_transmission(
@@ -1119,6 +1422,65 @@ namespace
                     madd(m_path_radiance, radiance, scalar_weight);
                 }
             }
+
+            void visit_heterogeneous_ray(
+                PathVertex&             vertex,
+                const ShadingRay&       volume_ray,
+                const Volume&           volume)
+            {
+                const size_t distance_sample_count = m_params.m_distance_sample_count;
+                if (distance_sample_count == 0)
+                    return;
+
+                for (size_t i = 0; i < distance_sample_count; ++i)
+                {
+                    // Sample a real collision using the volume's own tracking estimator.
+                    float distance_sample;
+                    Spectrum weight;
+                    if (!volume.sample_distance(
+                            m_sampling_context,
+                            vertex.m_volume_data,
+                            volume_ray,
+                            distance_sample,
+                            weight))
+                        continue;
+
+                    // The tracking weight already accounts for the scattering coefficient
+                    // at the collision point, and so does the in-scattered radiance: remove it once.
+                    Spectrum scattering_coef;
+                    volume.scattering_coefficient(
+                        vertex.m_volume_data, volume_ray, distance_sample, scattering_coef);
+                    for (size_t c = 0, e = Spectrum::size(); c < e; ++c)
+                        weight[c] = scattering_coef[c] > 0.0f ? weight[c] / scattering_coef[c] : 0.0f;
+
+                    // Calculate in-scattered radiance for this distance sample.
+                    ShadingComponents radiance;
+                    if (m_params.m_enable_dl || vertex.m_path_length > 1)
+                    {
+                        add_direct_lighting_contribution(
+                            *vertex.m_shading_point,
+                            volume_ray,
+                            volume,
+                            vertex.m_volume_data,
+                            distance_sample,
+                            vertex.m_scattering_modes,
+                            radiance);
+                    }
+                    if (m_params.m_enable_ibl && m_env_edf)
+                    {
+                        add_image_based_lighting_contribution(
+                            volume_ray,
+                            volume,
+                            vertex.m_volume_data,
+                            distance_sample,
+                            radiance);
+                    }
+
+                    radiance *= vertex.m_throughput;
+                    radiance *= weight;
+                    madd(m_path_radiance, radiance, 1.0f / distance_sample_count);
+                }
+            }
         };
     };
 }
@@ -1134,7 +1496,30 @@ PTLightingEngineFactory::PTLightingEngineFactory(
   : m_light_sampler(light_sampler)
   , m_params(params)
 {
-    PTLightingEngine::Parameters(params).print();
+    const PTLightingEngine::Parameters parameters(params);
+    parameters.print();
+
+    if (parameters.m_enable_path_guiding)
+    {
+        m_sd_tree.reset(
+            new SDTree(
+                parameters.m_guiding_training_iterations,
+                parameters.m_guiding_initial_paths,
+                parameters.m_guiding_spatial_threshold,
+                parameters.m_guiding_directional_threshold));
+    }
+
+    if (parameters.m_enable_radiance_cache)
+    {
+        m_radiance_cache.reset(
+            new RadianceCache(
+                parameters.m_radiance_cache_max_entries,
+                parameters.m_radiance_cache_min_samples));
+    }
+}
+
+PTLightingEngineFactory::~PTLightingEngineFactory()
+{
 }
 
 void PTLightingEngineFactory::release()
@@ -1144,7 +1529,17 @@ void PTLightingEngineFactory::release()
 
 ILightingEngine* PTLightingEngineFactory::create()
 {
-    return new PTLightingEngine(m_light_sampler, m_params);
+    return
+        new PTLightingEngine(
+            m_light_sampler,
+            m_sd_tree.get(),
+            m_radiance_cache.get(),
+            m_params);
+}
+
+const RadianceCache* PTLightingEngineFactory::get_radiance_cache() const
+{
+    return m_radiance_cache.get();
 }
 
 Dictionary PTLightingEngineFactory::get_params_metadata()
@@ -1255,6 +1650,97 @@ Dictionary PTLightingEngineFactory::get_params_metadata()
             .insert("label", "Distance Samples")
             .insert("help", "Number of distance samples per ray for volume rendering"));
 
+    metadata.dictionaries().insert(
+        "enable_path_guiding",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "false")
+            .insert("label", "Enable Path Guiding")
+            .insert("help", "Learn the distribution of incoming light during rendering and use it to guide diffuse and glossy bounces"));
+
+    metadata.dictionaries().insert(
+        "guiding_training_iterations",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "8")
+            .insert("min", "0")
+            .insert("label", "Guiding Training Iterations")
+            .insert("help", "Number of training iterations of the path guiding cache, each tracing twice as many paths as the previous one"));
+
+    metadata.dictionaries().insert(
+        "guiding_initial_paths",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "262144")
+            .insert("min", "1")
+            .insert("label", "Guiding Initial Paths")
+            .insert("help", "Number of paths traced during the first training iteration of the path guiding cache"));
+
+    metadata.dictionaries().insert(
+        "guiding_spatial_threshold",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "12000")
+            .insert("min", "1")
+            .insert("label", "Guiding Spatial Threshold")
+            .insert("help", "Number of recorded samples above which a spatial cell of the path guiding cache is subdivided"));
+
+    metadata.dictionaries().insert(
+        "guiding_directional_threshold",
+        Dictionary()
+            .insert("type", "float")
+            .insert("default", "0.01")
+            .insert("min", "0.0")
+            .insert("max", "1.0")
+            .insert("label", "Guiding Directional Threshold")
+            .insert("help", "Fraction of the recorded radiance above which a directional cell of the path guiding cache is subdivided"));
+
+    metadata.dictionaries().insert(
+        "guiding_bsdf_fraction",
+        Dictionary()
+            .insert("type", "float")
+            .insert("default", "0.5")
+            .insert("min", "0.0")
+            .insert("max", "1.0")
+            .insert("label", "Guiding BSDF Fraction")
+            .insert("help", "Probability of sampling the BSDF rather than the learned distribution at guided bounces"));
+
+    metadata.dictionaries().insert(
+        "enable_radiance_cache",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "false")
+            .insert("label", "Enable Radiance Cache")
+            .insert("help", "Terminate paths after the first diffuse bounce into a cache of diffuse radiance (biased)"));
+
+    metadata.dictionaries().insert(
+        "radiance_cache_cell_size",
+        Dictionary()
+            .insert("type", "float")
+            .insert("default", "0.005")
+            .insert("min", "0.0001")
+            .insert("max", "1.0")
+            .insert("label", "Radiance Cache Cell Size")
+            .insert("help", "Size of radiance cache cells, relative to the scene diameter"));
+
+    metadata.dictionaries().insert(
+        "radiance_cache_min_samples",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "16")
+            .insert("min", "1")
+            .insert("label", "Radiance Cache Min Samples")
+            .insert("help", "Number of samples a radiance cache cell must receive before it is used"));
+
+    metadata.dictionaries().insert(
+        "radiance_cache_max_entries",
+        Dictionary()
+            .insert("type", "int")
+            .insert("default", "262144")
+            .insert("min", "16")
+            .insert("label", "Radiance Cache Max Entries")
+            .insert("help", "Maximum number of radiance cache cells"));
+
     return metadata;
 }
 
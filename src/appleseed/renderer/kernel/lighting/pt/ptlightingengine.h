@@ -37,9 +37,14 @@
 // appleseed.foundation headers.
 #include "foundation/platform/compiler.h"
 
+// Standard headers.
+#include <memory>
+
 // Forward declarations.
 namespace foundation    { class Dictionary; }
 namespace renderer      { class BackwardLightSampler; }
+namespace renderer      { class RadianceCache; }
+namespace renderer      { class SDTree; }
 
 namespace renderer
 {
@@ -57,18 +62,26 @@ class PTLightingEngineFactory
         const BackwardLightSampler&     light_sampler,
         const ParamArray&               params);
 
+    // Destructor.
+    ~PTLightingEngineFactory();
+
     // Delete this instance.
     virtual void release() override;
 
     // Return a new path tracing lighting engine instance.
     virtual ILightingEngine* create() override;
 
+    // Return the radiance cache shared by all engines, or nullptr if it is disabled.
+    const RadianceCache* get_radiance_cache() const;
+
     // Return the metadata of the PT lighting engine parameters.
     static foundation::Dictionary get_params_metadata();
 
   private:
     const BackwardLightSampler&     m_light_sampler;
     ParamArray                      m_params;
+    std::auto_ptr<SDTree>           m_sd_tree;          // path guiding cache shared by all engines, if enabled
+    std::auto_ptr<RadianceCache>    m_radiance_cache;   // radiance cache shared by all engines, if enabled
 };
 
 }       // namespace renderer
@@ -0,0 +1,217 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "radiancecache.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/hash.h"
+#include "foundation/math/scalar.h"
+#include "foundation/platform/atomic.h"
+
+// Standard headers.
+#include <cassert>
+#include <cmath>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+namespace
+{
+    // Number of bits used to encode each cell coordinate in cell keys.
+    const size_t CoordinateBits = 20;
+    const int32 CoordinateBias = 1 << (CoordinateBits - 1);
+    const uint64 CoordinateMask = (uint64(1) << CoordinateBits) - 1;
+
+    // Maximum number of entries visited when looking for a cell.
+    const size_t MaxProbeCount = 16;
+
+    uint64 encode_coordinate(const float x)
+    {
+        return static_cast<uint64>(static_cast<int32>(floor(x)) + CoordinateBias) & CoordinateMask;
+    }
+
+    // Return the index in [0, 6) of the dominant axis and direction of a vector.
+    uint64 encode_normal(const Vector3f& n)
+    {
+        const size_t axis = max_abs_index(n);
+        return 2 * axis + (n[axis] < 0.0f ? 1 : 0);
+    }
+}
+
+
+//
+// RadianceCache class implementation.
+//
+
+RadianceCache::Entry::Entry()
+  : m_key(0)
+  , m_sample_count(0)
+{
+    for (size_t i = 0; i < Spectrum::StoredSamples; ++i)
+        m_sums[i] = 0.0f;
+}
+
+RadianceCache::RadianceCache(
+    const size_t            max_entry_count,
+    const size_t            min_sample_count)
+  : m_min_sample_count(max<size_t>(min_sample_count, 1))
+  , m_mask(next_pow2(max<size_t>(max_entry_count, MaxProbeCount)) - 1)
+  , m_entries(m_mask + 1)
+  , m_entry_count(0)
+  , m_hit_count(0)
+{
+}
+
+uint64 RadianceCache::make_key(
+    const Vector3f&         point,
+    const Vector3f&         normal,
+    const float             rcp_cell_size)
+{
+    const Vector3f p = point * rcp_cell_size;
+
+    // The most significant bit is always set such that 0 is never a valid key.
+    return
+          (uint64(1) << 63)
+        | (encode_coordinate(p.x) << (2 * CoordinateBits + 3))
+        | (encode_coordinate(p.y) << (CoordinateBits + 3))
+        | (encode_coordinate(p.z) << 3)
+        | encode_normal(normal);
+}
+
+bool RadianceCache::lookup(
+    const uint64            key,
+    Spectrum&               radiance) const
+{
+    const Entry* entry = find_entry(key);
+
+    if (entry == nullptr)
+        return false;
+
+    const uint32 sample_count = entry->m_sample_count.load(boost::memory_order_acquire);
+
+    if (sample_count < m_min_sample_count)
+        return false;
+
+    const float rcp_sample_count = 1.0f / sample_count;
+    const size_t size = Spectrum::size();
+
+    for (size_t i = 0; i < size; ++i)
+        radiance[i] = entry->m_sums[i] * rcp_sample_count;
+
+    m_hit_count.fetch_add(1, boost::memory_order_relaxed);
+
+    return true;
+}
+
+void RadianceCache::record(
+    const uint64            key,
+    const Spectrum&         radiance)
+{
+    Entry* entry = find_or_insert_entry(key);
+
+    // The table is full around this key: drop the sample.
+    if (entry == nullptr)
+        return;
+
+    const size_t size = Spectrum::size();
+
+    for (size_t i = 0; i < size; ++i)
+        atomic_add(&entry->m_sums[i], radiance[i]);
+
+    entry->m_sample_count.fetch_add(1, boost::memory_order_release);
+}
+
+size_t RadianceCache::get_entry_count() const
+{
+    return m_entry_count.load(boost::memory_order_relaxed);
+}
+
+uint64 RadianceCache::get_hit_count() const
+{
+    return m_hit_count.load(boost::memory_order_relaxed);
+}
+
+const RadianceCache::Entry* RadianceCache::find_entry(const uint64 key) const
+{
+    assert(key != 0);
+
+    size_t index = static_cast<size_t>(hash_uint64(key)) & m_mask;
+
+    for (size_t i = 0; i < MaxProbeCount; ++i)
+    {
+        const Entry& entry = m_entries[index];
+        const uint64 entry_key = entry.m_key.load(boost::memory_order_acquire);
+
+        if (entry_key == key)
+            return &entry;
+
+        if (entry_key == 0)
+            break;
+
+        index = (index + 1) & m_mask;
+    }
+
+    return nullptr;
+}
+
+RadianceCache::Entry* RadianceCache::find_or_insert_entry(const uint64 key)
+{
+    assert(key != 0);
+
+    size_t index = static_cast<size_t>(hash_uint64(key)) & m_mask;
+
+    for (size_t i = 0; i < MaxProbeCount; ++i)
+    {
+        Entry& entry = m_entries[index];
+        uint64 entry_key = entry.m_key.load(boost::memory_order_acquire);
+
+        if (entry_key == 0)
+        {
+            // Try to claim this entry; another thread may beat us to it.
+            if (entry.m_key.compare_exchange_strong(entry_key, key, boost::memory_order_acq_rel))
+            {
+                ++m_entry_count;
+                return &entry;
+            }
+        }
+
+        if (entry_key == key)
+            return &entry;
+
+        index = (index + 1) & m_mask;
+    }
+
+    return nullptr;
+}
+
+}   // namespace renderer
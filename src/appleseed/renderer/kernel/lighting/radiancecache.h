@@ -0,0 +1,118 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_RENDERER_KERNEL_LIGHTING_RADIANCECACHE_H
+#define APPLESEED_RENDERER_KERNEL_LIGHTING_RADIANCECACHE_H
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
+
+// Boost headers.
+#include "boost/atomic/atomic.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+namespace renderer
+{
+
+//
+// A world-space cache of outgoing radiance at diffuse path vertices.
+//
+// The scene is partitioned into cubic cells further split by the dominant axis of the
+// surface normal. Cells are stored in a fixed-size hash table with open addressing;
+// they are created lazily and filled concurrently by all rendering threads, without locks.
+// A cell only answers queries once it has accumulated enough samples.
+//
+// The cached radiance is assumed to be independent of the viewing direction, which only
+// holds for diffuse surfaces, and is constant over each cell: using the cache introduces
+// bias in exchange for much shorter paths.
+//
+
+class RadianceCache
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    RadianceCache(
+        const size_t                    max_entry_count,
+        const size_t                    min_sample_count);
+
+    // Return the key of the cell containing a given surface point.
+    static foundation::uint64 make_key(
+        const foundation::Vector3f&     point,
+        const foundation::Vector3f&     normal,
+        const float                     rcp_cell_size);
+
+    // Retrieve the average radiance recorded in a cell. Return false if the cell
+    // doesn't exist or hasn't received enough samples yet. Thread-safe.
+    bool lookup(
+        const foundation::uint64        key,
+        Spectrum&                       radiance) const;
+
+    // Record a radiance sample in a cell, creating it if necessary. Thread-safe.
+    void record(
+        const foundation::uint64        key,
+        const Spectrum&                 radiance);
+
+    // Return the number of cells created so far.
+    size_t get_entry_count() const;
+
+    // Return the number of successful lookups so far.
+    foundation::uint64 get_hit_count() const;
+
+  private:
+    struct Entry
+    {
+        boost::atomic<foundation::uint64>   m_key;      // 0 for empty entries
+        boost::atomic<foundation::uint32>   m_sample_count;
+        float                               m_sums[Spectrum::StoredSamples];
+
+        Entry();
+    };
+
+    const size_t                        m_min_sample_count;
+    const size_t                        m_mask;
+    std::vector<Entry>                  m_entries;
+    boost::atomic<size_t>               m_entry_count;
+    mutable boost::atomic<foundation::uint64> m_hit_count;
+
+    const Entry* find_entry(const foundation::uint64 key) const;
+    Entry* find_or_insert_entry(const foundation::uint64 key);
+};
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_LIGHTING_RADIANCECACHE_H
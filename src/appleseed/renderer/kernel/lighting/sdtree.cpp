@@ -0,0 +1,673 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "sdtree.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/kernel/lighting/scatteringmode.h"
+#include "renderer/modeling/bsdf/bsdf.h"
+#include "renderer/modeling/bsdf/bsdfsample.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/minmax.h"
+#include "foundation/math/scalar.h"
+#include "foundation/utility/string.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+namespace
+{
+    // Map a unit direction to the unit square using the equal-area cylindrical mapping.
+    Vector2f direction_to_canonical(const Vector3f& direction)
+    {
+        const float cos_theta = clamp(direction.y, -1.0f, 1.0f);
+
+        float phi = atan2(direction.z, direction.x);
+        if (phi < 0.0f)
+            phi += TwoPi<float>();
+
+        return
+            Vector2f(
+                clamp((cos_theta + 1.0f) * 0.5f, 0.0f, 0.99999994f),
+                clamp(phi * RcpTwoPi<float>(), 0.0f, 0.99999994f));
+    }
+
+    // Map a point of the unit square to a unit direction. Inverse of direction_to_canonical().
+    Vector3f canonical_to_direction(const Vector2f& p)
+    {
+        const float cos_theta = 2.0f * p.x - 1.0f;
+        const float sin_theta = sqrt(max(1.0f - cos_theta * cos_theta, 0.0f));
+        const float phi = TwoPi<float>() * p.y;
+
+        return Vector3f(sin_theta * cos(phi), cos_theta, sin_theta * sin(phi));
+    }
+
+    // Return the quadrant of the unit square containing a given point and
+    // remap the point to the unit square of that quadrant.
+    size_t select_quadrant(Vector2f& p)
+    {
+        size_t quadrant = 0;
+
+        if (p.x >= 0.5f)
+        {
+            quadrant |= 1;
+            p.x -= 0.5f;
+        }
+
+        if (p.y >= 0.5f)
+        {
+            quadrant |= 2;
+            p.y -= 0.5f;
+        }
+
+        p *= 2.0f;
+
+        return quadrant;
+    }
+
+    // Maximum depth of directional quadtrees.
+    const size_t MaxDTreeDepth = 20;
+
+    // Maximum depth of the spatial tree.
+    const size_t MaxSTreeDepth = 48;
+}
+
+
+//
+// DTree class implementation.
+//
+
+DTree::DTree()
+  : m_nodes(1)
+  , m_sample_count(0)
+{
+}
+
+void DTree::record(
+    const Vector3f&         direction,
+    const float             radiance)
+{
+    if (!(radiance > 0.0f) || radiance == numeric_limits<float>::infinity())
+        return;
+
+    Vector2f p = direction_to_canonical(direction);
+    uint32 node_index = 0;
+
+    while (true)
+    {
+        Node& node = m_nodes[node_index];
+        const size_t quadrant = select_quadrant(p);
+
+        atomic_add(&node.m_sums[quadrant], radiance);
+
+        node_index = node.m_children[quadrant];
+        if (node_index == 0)
+            break;
+    }
+
+    atomic_inc(&m_sample_count);
+}
+
+float DTree::pdf(const Vector3f& direction) const
+{
+    Vector2f p = direction_to_canonical(direction);
+    uint32 node_index = 0;
+    float pdf = 1.0f;
+
+    while (true)
+    {
+        const Node& node = m_nodes[node_index];
+        const float sum = node.m_sums[0] + node.m_sums[1] + node.m_sums[2] + node.m_sums[3];
+
+        if (sum <= 0.0f)
+            return 0.0f;
+
+        const size_t quadrant = select_quadrant(p);
+        pdf *= 4.0f * node.m_sums[quadrant] / sum;
+
+        node_index = node.m_children[quadrant];
+        if (node_index == 0)
+            break;
+    }
+
+    // Change of measure from the unit square to solid angle.
+    return pdf * RcpFourPi<float>();
+}
+
+Vector3f DTree::sample(
+    const Vector2f&         s,
+    float&                  pdf) const
+{
+    Vector2f u(
+        min(s.x, 0.99999994f),
+        min(s.y, 0.99999994f));
+    Vector2f origin(0.0f);
+    float size = 1.0f;
+    uint32 node_index = 0;
+
+    pdf = 1.0f;
+
+    while (true)
+    {
+        const Node& node = m_nodes[node_index];
+        const float sum = node.m_sums[0] + node.m_sums[1] + node.m_sums[2] + node.m_sums[3];
+
+        if (sum <= 0.0f)
+        {
+            // Nothing was recorded in this subtree: sample it uniformly.
+            break;
+        }
+
+        // Choose the horizontal half.
+        const float left = node.m_sums[0] + node.m_sums[2];
+        size_t quadrant;
+        if (u.x * sum < left)
+        {
+            u.x = min(u.x * sum / left, 0.99999994f);
+            quadrant = 0;
+        }
+        else
+        {
+            u.x = min((u.x * sum - left) / (sum - left), 0.99999994f);
+            quadrant = 1;
+        }
+
+        // Choose the vertical half.
+        const float bottom = node.m_sums[quadrant];
+        const float half_sum = bottom + node.m_sums[quadrant + 2];
+        if (u.y * half_sum < bottom)
+            u.y = min(u.y * half_sum / bottom, 0.99999994f);
+        else
+        {
+            u.y = min((u.y * half_sum - bottom) / (half_sum - bottom), 0.99999994f);
+            quadrant += 2;
+        }
+
+        pdf *= 4.0f * node.m_sums[quadrant] / sum;
+
+        size *= 0.5f;
+        if (quadrant & 1)
+            origin.x += size;
+        if (quadrant & 2)
+            origin.y += size;
+
+        node_index = node.m_children[quadrant];
+        if (node_index == 0)
+            break;
+    }
+
+    // Change of measure from the unit square to solid angle.
+    pdf *= RcpFourPi<float>();
+
+    return canonical_to_direction(origin + u * size);
+}
+
+void DTree::build_refined(
+    DTree&                  result,
+    const float             subdivision_threshold,
+    const size_t            max_depth) const
+{
+    struct Entry
+    {
+        float   m_sums[4];
+        uint32  m_children[4];
+        uint32  m_result_index;
+        size_t  m_depth;
+    };
+
+    result.m_nodes.clear();
+    result.m_nodes.push_back(Node());
+    result.m_sample_count = 0;
+
+    const float total = get_sum();
+    if (total <= 0.0f)
+        return;
+
+    vector<Entry> stack;
+
+    Entry root;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        root.m_sums[i] = m_nodes[0].m_sums[i];
+        root.m_children[i] = m_nodes[0].m_children[i];
+    }
+    root.m_result_index = 0;
+    root.m_depth = 1;
+    stack.push_back(root);
+
+    while (!stack.empty())
+    {
+        const Entry entry = stack.back();
+        stack.pop_back();
+
+        if (entry.m_depth >= max_depth)
+            continue;
+
+        for (size_t i = 0; i < 4; ++i)
+        {
+            // Only subdivide quadrants holding a large enough fraction of the total radiance.
+            if (entry.m_sums[i] / total <= subdivision_threshold)
+                continue;
+
+            const uint32 child_index = static_cast<uint32>(result.m_nodes.size());
+            result.m_nodes.push_back(Node());
+            result.m_nodes[entry.m_result_index].m_children[i] = child_index;
+
+            Entry child;
+            child.m_result_index = child_index;
+            child.m_depth = entry.m_depth + 1;
+
+            if (entry.m_children[i] != 0)
+            {
+                const Node& node = m_nodes[entry.m_children[i]];
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    child.m_sums[j] = node.m_sums[j];
+                    child.m_children[j] = node.m_children[j];
+                }
+            }
+            else
+            {
+                // This quadrant was a leaf: assume the radiance was evenly distributed.
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    child.m_sums[j] = 0.25f * entry.m_sums[i];
+                    child.m_children[j] = 0;
+                }
+            }
+
+            stack.push_back(child);
+        }
+    }
+}
+
+
+//
+// STree class implementation.
+//
+
+STree::STree(const AABB3f& bbox)
+  : m_bbox(bbox)
+  , m_nodes(1)
+  , m_dtrees(1)
+{
+    Node& root = m_nodes[0];
+    root.m_children[0] = root.m_children[1] = 0;
+    root.m_axis = 0;
+    root.m_dtree_index = 0;
+}
+
+DTreeWrapper* STree::get_dtree_wrapper(const Vector3f& point)
+{
+    // Express the point in the unit cube of the tree.
+    Vector3f p;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const float extent = m_bbox.max[i] - m_bbox.min[i];
+        p[i] = extent > 0.0f ? clamp((point[i] - m_bbox.min[i]) / extent, 0.0f, 1.0f) : 0.0f;
+    }
+
+    uint32 node_index = 0;
+
+    while (true)
+    {
+        const Node& node = m_nodes[node_index];
+
+        if (node.m_children[0] == 0)
+            return &m_dtrees[node.m_dtree_index];
+
+        float& x = p[node.m_axis];
+        if (x < 0.5f)
+        {
+            x *= 2.0f;
+            node_index = node.m_children[0];
+        }
+        else
+        {
+            x = 2.0f * x - 1.0f;
+            node_index = node.m_children[1];
+        }
+    }
+}
+
+STree* STree::build_refined(
+    const size_t            spatial_threshold,
+    const float             directional_threshold,
+    const size_t            max_depth) const
+{
+    STree* result = new STree(m_bbox);
+    result->m_dtrees.clear();
+
+    refine_node(
+        *result,
+        0,
+        0,
+        1,
+        spatial_threshold,
+        directional_threshold,
+        max_depth);
+
+    return result;
+}
+
+void STree::refine_node(
+    STree&                  result,
+    const uint32            node_index,
+    const uint32            result_node_index,
+    const size_t            depth,
+    const size_t            spatial_threshold,
+    const float             directional_threshold,
+    const size_t            max_depth) const
+{
+    const Node& node = m_nodes[node_index];
+
+    if (node.m_children[0] != 0)
+    {
+        // Interior node: copy it and recurse.
+        const uint32 child_index = static_cast<uint32>(result.m_nodes.size());
+        result.m_nodes.resize(result.m_nodes.size() + 2);
+
+        Node& result_node = result.m_nodes[result_node_index];
+        result_node.m_children[0] = child_index;
+        result_node.m_children[1] = child_index + 1;
+        result_node.m_axis = node.m_axis;
+        result_node.m_dtree_index = 0;
+
+        for (uint32 i = 0; i < 2; ++i)
+        {
+            refine_node(
+                result,
+                node.m_children[i],
+                child_index + i,
+                depth + 1,
+                spatial_threshold,
+                directional_threshold,
+                max_depth);
+        }
+
+        return;
+    }
+
+    // Leaf node: the radiance recorded during this iteration becomes the sampling
+    // distribution, unless nothing was recorded, in which case we keep the old one.
+    const DTreeWrapper& dtree = m_dtrees[node.m_dtree_index];
+    const DTree& sampling =
+        dtree.m_recording.get_sum() > 0.0f ? dtree.m_recording : dtree.m_sampling;
+
+    DTreeWrapper refined;
+    refined.m_sampling = sampling;
+    sampling.build_refined(refined.m_recording, directional_threshold, MaxDTreeDepth);
+
+    if (depth < max_depth && dtree.m_recording.get_sample_count() > spatial_threshold)
+    {
+        // Split the leaf in two along the next axis; both children inherit the distributions.
+        const uint32 child_index = static_cast<uint32>(result.m_nodes.size());
+        result.m_nodes.resize(result.m_nodes.size() + 2);
+
+        Node& result_node = result.m_nodes[result_node_index];
+        result_node.m_children[0] = child_index;
+        result_node.m_children[1] = child_index + 1;
+        result_node.m_axis = node.m_axis;
+        result_node.m_dtree_index = 0;
+
+        for (uint32 i = 0; i < 2; ++i)
+        {
+            Node& child = result.m_nodes[child_index + i];
+            child.m_children[0] = child.m_children[1] = 0;
+            child.m_axis = (node.m_axis + 1) % 3;
+            child.m_dtree_index = static_cast<uint32>(result.m_dtrees.size());
+            result.m_dtrees.push_back(refined);
+        }
+    }
+    else
+    {
+        Node& result_node = result.m_nodes[result_node_index];
+        result_node.m_children[0] = result_node.m_children[1] = 0;
+        result_node.m_axis = node.m_axis;
+        result_node.m_dtree_index = static_cast<uint32>(result.m_dtrees.size());
+        result.m_dtrees.push_back(refined);
+    }
+}
+
+
+//
+// SDTree class implementation.
+//
+
+SDTree::SDTree(
+    const size_t            training_iterations,
+    const size_t            initial_path_count,
+    const size_t            spatial_threshold,
+    const float             directional_threshold)
+  : m_training_iterations(training_iterations)
+  , m_initial_path_count(initial_path_count)
+  , m_spatial_threshold(spatial_threshold)
+  , m_directional_threshold(directional_threshold)
+  , m_stree(nullptr)
+  , m_iteration(0)
+  , m_path_count(0)
+{
+}
+
+SDTree::~SDTree()
+{
+    delete m_stree.load();
+
+    for (size_t i = 0, e = m_retired_strees.size(); i < e; ++i)
+        delete m_retired_strees[i];
+}
+
+STree* SDTree::get_stree(const GAABB3& scene_bbox)
+{
+    STree* stree = m_stree.load(boost::memory_order_acquire);
+
+    if (stree == nullptr)
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+
+        stree = m_stree.load(boost::memory_order_acquire);
+
+        if (stree == nullptr)
+        {
+            // Use a slightly enlarged cube so that all axes are subdivided at the same rate.
+            const Vector3f center(scene_bbox.center());
+            const float half_size = 0.5f * 1.01f * max_value(Vector3f(scene_bbox.extent()));
+            stree = new STree(AABB3f(center - Vector3f(half_size), center + Vector3f(half_size)));
+            m_stree.store(stree, boost::memory_order_release);
+        }
+    }
+
+    return stree;
+}
+
+void SDTree::on_path_end()
+{
+    const uint64 path_count = ++m_path_count;
+    const uint32 iteration = m_iteration.load(boost::memory_order_relaxed);
+
+    if (iteration >= m_training_iterations)
+        return;
+
+    // The budget of each iteration is twice the one of the previous iteration.
+    const uint64 budget = m_initial_path_count * ((uint64(2) << iteration) - 1);
+    if (path_count < budget)
+        return;
+
+    // Only one thread refines the tree, others keep rendering with the current one.
+    boost::mutex::scoped_try_lock lock(m_mutex);
+    if (lock.owns_lock() && m_iteration.load() == iteration)
+        end_iteration(iteration);
+}
+
+void SDTree::end_iteration(const uint32 iteration)
+{
+    STree* stree = m_stree.load(boost::memory_order_acquire);
+
+    if (stree != nullptr)
+    {
+        const size_t spatial_threshold =
+            static_cast<size_t>(m_spatial_threshold * sqrt(static_cast<double>(uint64(1) << iteration)));
+
+        STree* refined =
+            stree->build_refined(
+                spatial_threshold,
+                m_directional_threshold,
+                MaxSTreeDepth);
+
+        m_retired_strees.push_back(stree);
+        m_stree.store(refined, boost::memory_order_release);
+
+        RENDERER_LOG_DEBUG(
+            "path guiding: completed training iteration %s/%s, spatial tree has %s.",
+            pretty_uint(iteration + 1).c_str(),
+            pretty_uint(m_training_iterations).c_str(),
+            plural(refined->get_leaf_count(), "leaf", "leaves").c_str());
+    }
+
+    m_iteration.store(iteration + 1);
+}
+
+
+//
+// Guided BSDF sampling implementation.
+//
+
+void sample_guided_bsdf(
+    SamplingContext&        sampling_context,
+    const DTreeWrapper&     dtree,
+    const float             bsdf_sampling_fraction,
+    const BSDF&             bsdf,
+    const void*             bsdf_data,
+    const int               modes,
+    BSDFSample&             sample)
+{
+    const int guided_modes = modes & (ScatteringMode::Diffuse | ScatteringMode::Glossy);
+
+    // Fall back to plain BSDF sampling if there is nothing to guide.
+    if (guided_modes == ScatteringMode::None || !dtree.is_trained())
+    {
+        bsdf.sample(sampling_context, bsdf_data, false, true, modes, sample);
+        return;
+    }
+
+    sampling_context.split_in_place(3, 1);
+    const Vector3f s = sampling_context.next2<Vector3f>();
+
+    if (s[0] < bsdf_sampling_fraction)
+    {
+        // Sample the BSDF.
+        bsdf.sample(sampling_context, bsdf_data, false, true, modes, sample);
+
+        if (sample.m_mode == ScatteringMode::None)
+            return;
+
+        if (sample.m_probability == BSDF::DiracDelta)
+        {
+            // Account for the probability of having chosen BSDF sampling.
+            sample.m_value *= 1.0f / bsdf_sampling_fraction;
+            return;
+        }
+
+        sample.m_probability =
+            mix_guided_pdf(
+                dtree,
+                bsdf_sampling_fraction,
+                sample.m_incoming.get_value(),
+                sample.m_probability);
+    }
+    else
+    {
+        // Sample the guiding distribution.
+        float guide_pdf;
+        const Vector3f incoming = dtree.sample(Vector2f(s[1], s[2]), guide_pdf);
+
+        if (guide_pdf <= 0.0f)
+        {
+            sample.m_mode = ScatteringMode::None;
+            return;
+        }
+
+        const float bsdf_pdf =
+            bsdf.evaluate(
+                bsdf_data,
+                false,          // not adjoint
+                true,           // multiply by |cos(incoming, normal)|
+                sample.m_geometric_normal,
+                sample.m_shading_basis,
+                sample.m_outgoing.get_value(),
+                incoming,
+                guided_modes,
+                sample.m_value);
+
+        if (bsdf_pdf <= 0.0f)
+        {
+            sample.m_mode = ScatteringMode::None;
+            return;
+        }
+
+        // BSDF::evaluate() does not report which lobe was hit; when both are present,
+        // treat the sample as diffuse for the purpose of path termination.
+        sample.m_mode =
+            ScatteringMode::has_diffuse(guided_modes)
+                ? ScatteringMode::Diffuse
+                : ScatteringMode::Glossy;
+        sample.m_incoming = Dual3f(incoming);
+        sample.m_probability =
+            bsdf_sampling_fraction * bsdf_pdf +
+            (1.0f - bsdf_sampling_fraction) * guide_pdf;
+    }
+}
+
+float mix_guided_pdf(
+    const DTreeWrapper&     dtree,
+    const float             bsdf_sampling_fraction,
+    const Vector3f&         incoming,
+    const float             bsdf_pdf)
+{
+    if (bsdf_pdf <= 0.0f || !dtree.is_trained())
+        return bsdf_pdf;
+
+    return
+        bsdf_sampling_fraction * bsdf_pdf +
+        (1.0f - bsdf_sampling_fraction) * dtree.pdf(incoming);
+}
+
+}   // namespace renderer
@@ -0,0 +1,358 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_RENDERER_KERNEL_LIGHTING_SDTREE_H
+#define APPLESEED_RENDERER_KERNEL_LIGHTING_SDTREE_H
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/aabb.h"
+#include "foundation/math/vector.h"
+#include "foundation/platform/atomic.h"
+#include "foundation/platform/types.h"
+
+// Boost headers.
+#include "boost/thread/mutex.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+// Forward declarations.
+namespace renderer  { class BSDF; }
+namespace renderer  { class BSDFSample; }
+
+//
+// An online-trained spatial-directional radiance cache used to guide path sampling.
+//
+// The spatial component is a binary tree over the scene bounding box (STree) whose
+// leaves each own a pair of directional quadtrees (DTree) over the sphere of directions:
+// one that is read-only and used for sampling, and one that accumulates the radiance
+// recorded by the render threads during the current training iteration.
+//
+// Reference:
+//
+//   Practical Path Guiding for Efficient Light-Transport Simulation
+//   Thomas Müller, Markus Gross, Jan Novák
+//   https://tom94.net/data/publications/mueller17practical/mueller17practical.pdf
+//
+
+namespace renderer
+{
+
+//
+// Directional quadtree over the cylindrical (equal-area) parameterization of the sphere.
+//
+
+class DTree
+{
+  public:
+    // Constructor. The tree is made of a single node with four leaf quadrants.
+    DTree();
+
+    // Record a radiance sample. Thread-safe.
+    void record(
+        const foundation::Vector3f&     direction,
+        const float                     radiance);
+
+    // Return the probability density (with respect to solid angle) of sampling a given direction.
+    float pdf(const foundation::Vector3f& direction) const;
+
+    // Sample a direction proportionally to the recorded radiance.
+    foundation::Vector3f sample(
+        const foundation::Vector2f&     s,
+        float&                          pdf) const;
+
+    // Return the total recorded radiance.
+    float get_sum() const;
+
+    // Return the number of recorded samples.
+    foundation::uint32 get_sample_count() const;
+
+    // Return the number of nodes of this tree.
+    size_t get_node_count() const;
+
+    // Build an empty tree subdivided such that no leaf holds more than a given fraction
+    // of the radiance recorded in this tree, up to a maximum depth.
+    void build_refined(
+        DTree&                          result,
+        const float                     subdivision_threshold,
+        const size_t                    max_depth) const;
+
+  private:
+    struct Node
+    {
+        float                           m_sums[4];
+        foundation::uint32              m_children[4];  // 0 for leaf quadrants (the root is never a child)
+
+        Node();
+    };
+
+    std::vector<Node>                   m_nodes;
+    foundation::uint32                  m_sample_count;
+};
+
+
+//
+// A pair of directional quadtrees attached to a leaf of the spatial tree.
+//
+
+class DTreeWrapper
+{
+  public:
+    // Record a radiance sample into the recording tree. Thread-safe.
+    void record(
+        const foundation::Vector3f&     direction,
+        const float                     radiance);
+
+    // Return true if the sampling tree has received any radiance.
+    bool is_trained() const;
+
+    // Return the probability density of sampling a given direction from the sampling tree.
+    float pdf(const foundation::Vector3f& direction) const;
+
+    // Sample a direction from the sampling tree.
+    foundation::Vector3f sample(
+        const foundation::Vector2f&     s,
+        float&                          pdf) const;
+
+  private:
+    friend class STree;
+
+    DTree                               m_sampling;
+    DTree                               m_recording;
+};
+
+
+//
+// Spatial binary tree over the scene bounding box.
+//
+
+class STree
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor. The tree is made of a single leaf covering a given bounding box.
+    explicit STree(const foundation::AABB3f& bbox);
+
+    // Return the DTree wrapper of the leaf containing a given point.
+    DTreeWrapper* get_dtree_wrapper(const foundation::Vector3f& point);
+
+    // Return the number of leaves of this tree.
+    size_t get_leaf_count() const;
+
+    // Build the tree used for the next training iteration: leaves that received more than
+    // a given number of samples are split, the recording trees become the sampling trees
+    // and new, empty recording trees are refined from the recorded radiance distribution.
+    STree* build_refined(
+        const size_t                    spatial_threshold,
+        const float                     directional_threshold,
+        const size_t                    max_depth) const;
+
+  private:
+    struct Node
+    {
+        foundation::uint32              m_children[2];  // 0 for leaves (the root is never a child)
+        foundation::uint32              m_axis;
+        foundation::uint32              m_dtree_index;  // only defined for leaves
+    };
+
+    const foundation::AABB3f            m_bbox;
+    std::vector<Node>                   m_nodes;
+    std::vector<DTreeWrapper>           m_dtrees;
+
+    void refine_node(
+        STree&                          result,
+        const foundation::uint32        node_index,
+        const foundation::uint32        result_node_index,
+        const size_t                    depth,
+        const size_t                    spatial_threshold,
+        const float                     directional_threshold,
+        const size_t                    max_depth) const;
+};
+
+
+//
+// Path guiding cache shared by all rendering threads.
+//
+// Training proceeds in iterations of exponentially growing numbers of paths. The thread
+// that completes an iteration builds the refined tree and publishes it; trees of past
+// iterations are kept alive until the cache is destroyed since other threads may still
+// be using them. Once the last training iteration is complete, the cache is frozen.
+//
+
+class SDTree
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    SDTree(
+        const size_t                    training_iterations,
+        const size_t                    initial_path_count,
+        const size_t                    spatial_threshold,
+        const float                     directional_threshold);
+
+    // Destructor.
+    ~SDTree();
+
+    // Return the current spatial tree, creating it on first use.
+    STree* get_stree(const GAABB3& scene_bbox);
+
+    // Return true if radiance samples should still be recorded.
+    bool is_training() const;
+
+    // Notify the cache that a path was completed. Thread-safe.
+    void on_path_end();
+
+  private:
+    const size_t                        m_training_iterations;
+    const size_t                        m_initial_path_count;
+    const size_t                        m_spatial_threshold;
+    const float                         m_directional_threshold;
+
+    boost::mutex                        m_mutex;
+    boost::atomic<STree*>               m_stree;
+    boost::atomic<foundation::uint32>   m_iteration;
+    boost::atomic<foundation::uint64>   m_path_count;
+    std::vector<STree*>                 m_retired_strees;
+
+    void end_iteration(const foundation::uint32 iteration);
+};
+
+
+//
+// Guided BSDF sampling.
+//
+// A direction is drawn either from the BSDF, with probability bsdf_sampling_fraction,
+// or from the guiding distribution; the returned probability density is the one of
+// the resulting mixture (one-sample MIS with the balance heuristic). Specular
+// scattering events are left untouched, save for the selection probability.
+//
+
+void sample_guided_bsdf(
+    SamplingContext&                    sampling_context,
+    const DTreeWrapper&                 dtree,
+    const float                         bsdf_sampling_fraction,
+    const BSDF&                         bsdf,
+    const void*                         bsdf_data,
+    const int                           modes,
+    BSDFSample&                         sample);
+
+// Return the probability density of the guided sampling mixture.
+float mix_guided_pdf(
+    const DTreeWrapper&                 dtree,
+    const float                         bsdf_sampling_fraction,
+    const foundation::Vector3f&         incoming,
+    const float                         bsdf_pdf);
+
+
+//
+// DTree class implementation.
+//
+
+inline DTree::Node::Node()
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        m_sums[i] = 0.0f;
+        m_children[i] = 0;
+    }
+}
+
+inline float DTree::get_sum() const
+{
+    const Node& root = m_nodes[0];
+    return root.m_sums[0] + root.m_sums[1] + root.m_sums[2] + root.m_sums[3];
+}
+
+inline foundation::uint32 DTree::get_sample_count() const
+{
+    return m_sample_count;
+}
+
+inline size_t DTree::get_node_count() const
+{
+    return m_nodes.size();
+}
+
+
+//
+// DTreeWrapper class implementation.
+//
+
+inline void DTreeWrapper::record(
+    const foundation::Vector3f&         direction,
+    const float                         radiance)
+{
+    m_recording.record(direction, radiance);
+}
+
+inline bool DTreeWrapper::is_trained() const
+{
+    return m_sampling.get_sum() > 0.0f;
+}
+
+inline float DTreeWrapper::pdf(const foundation::Vector3f& direction) const
+{
+    return m_sampling.pdf(direction);
+}
+
+inline foundation::Vector3f DTreeWrapper::sample(
+    const foundation::Vector2f&         s,
+    float&                              pdf) const
+{
+    return m_sampling.sample(s, pdf);
+}
+
+
+//
+// STree class implementation.
+//
+
+inline size_t STree::get_leaf_count() const
+{
+    return m_dtrees.size();
+}
+
+
+//
+// SDTree class implementation.
+//
+
+inline bool SDTree::is_training() const
+{
+    return m_iteration.load(boost::memory_order_relaxed) < m_training_iterations;
+}
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_LIGHTING_SDTREE_H
@@ -0,0 +1,232 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "checkpoint.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/platform/types.h"
+#include "foundation/utility/containers/dictionary.h"
+
+// Boost headers.
+#include "boost/filesystem.hpp"
+#include "boost/system/error_code.hpp"
+
+// Standard headers.
+#include <cstring>
+
+using namespace foundation;
+using namespace std;
+namespace bf = boost::filesystem;
+
+namespace renderer
+{
+
+namespace
+{
+    const char CheckpointSignature[] = { 'A', 'S', 'C', 'H', 'E', 'C', 'K', 'P' };
+    const uint16 CheckpointFormatVersion = 1;
+}
+
+
+//
+// CheckpointParameters class implementation.
+//
+
+CheckpointParameters::CheckpointParameters(const ParamArray& params)
+  : m_path(params.get_optional<string>("checkpoint_path", ""))
+  , m_resume(params.get_optional<bool>("checkpoint_resume", false))
+  , m_interval(params.get_optional<double>("checkpoint_interval", 300.0))
+{
+}
+
+Dictionary CheckpointParameters::get_params_metadata()
+{
+    Dictionary metadata;
+
+    metadata.dictionaries().insert(
+        "checkpoint_path",
+        Dictionary()
+            .insert("type", "text")
+            .insert("default", "")
+            .insert("label", "Checkpoint File")
+            .insert("help", "Path to the checkpoint file; leave empty to disable checkpointing"));
+
+    metadata.dictionaries().insert(
+        "checkpoint_resume",
+        Dictionary()
+            .insert("type", "bool")
+            .insert("default", "false")
+            .insert("label", "Resume From Checkpoint")
+            .insert("help", "Resume the render from the checkpoint file if it exists"));
+
+    metadata.dictionaries().insert(
+        "checkpoint_interval",
+        Dictionary()
+            .insert("type", "float")
+            .insert("default", "300.0")
+            .insert("label", "Checkpoint Interval")
+            .insert("help", "Minimum time in seconds between two checkpoints"));
+
+    return metadata;
+}
+
+
+//
+// CheckpointFileWriter class implementation.
+//
+
+CheckpointFileWriter::CheckpointFileWriter(
+    const char*     path,
+    const char*     kind)
+  : m_path(path)
+  , m_temp_path(m_path + ".tmp")
+  , m_failed(false)
+{
+    if (!m_file.open(
+            m_temp_path.c_str(),
+            BufferedFile::BinaryType,
+            BufferedFile::WriteMode))
+    {
+        RENDERER_LOG_ERROR("failed to write checkpoint file %s: i/o error.", m_temp_path.c_str());
+        return;
+    }
+
+    const uint16 kind_length = static_cast<uint16>(strlen(kind));
+
+    if (m_file.write(CheckpointSignature, sizeof(CheckpointSignature)) != sizeof(CheckpointSignature) ||
+        m_file.write(CheckpointFormatVersion) != sizeof(CheckpointFormatVersion) ||
+        m_file.write(kind_length) != sizeof(kind_length) ||
+        m_file.write(kind, kind_length) != kind_length)
+        m_failed = true;
+}
+
+bool CheckpointFileWriter::is_open() const
+{
+    return m_file.is_open();
+}
+
+BufferedFile& CheckpointFileWriter::file()
+{
+    return m_file;
+}
+
+void CheckpointFileWriter::set_failed()
+{
+    m_failed = true;
+}
+
+bool CheckpointFileWriter::commit()
+{
+    if (!m_file.is_open())
+        return false;
+
+    if (!m_file.close())
+        m_failed = true;
+
+    boost::system::error_code ec;
+
+    if (m_failed)
+    {
+        RENDERER_LOG_ERROR("failed to write checkpoint file %s: i/o error.", m_temp_path.c_str());
+        bf::remove(m_temp_path, ec);
+        return false;
+    }
+
+    bf::rename(m_temp_path, m_path, ec);
+
+    if (ec)
+    {
+        RENDERER_LOG_ERROR(
+            "failed to write checkpoint file %s: %s.",
+            m_path.c_str(),
+            ec.message().c_str());
+        return false;
+    }
+
+    return true;
+}
+
+
+//
+// CheckpointFileReader class implementation.
+//
+
+CheckpointFileReader::CheckpointFileReader(
+    const char*     path,
+    const char*     kind)
+{
+    if (!m_file.open(
+            path,
+            BufferedFile::BinaryType,
+            BufferedFile::ReadMode))
+        return;
+
+    char signature[sizeof(CheckpointSignature)];
+    uint16 version;
+    uint16 kind_length;
+    string file_kind;
+
+    bool valid =
+        m_file.read(signature, sizeof(signature)) == sizeof(signature) &&
+        memcmp(signature, CheckpointSignature, sizeof(signature)) == 0 &&
+        m_file.read(version) == sizeof(version) &&
+        version == CheckpointFormatVersion &&
+        m_file.read(kind_length) == sizeof(kind_length);
+
+    if (valid)
+    {
+        file_kind.resize(kind_length);
+        valid =
+            (kind_length == 0 || m_file.read(&file_kind[0], kind_length) == kind_length) &&
+            file_kind == kind;
+    }
+
+    if (!valid)
+    {
+        RENDERER_LOG_WARNING("ignoring checkpoint file %s: not a valid %s checkpoint.", path, kind);
+        m_file.close();
+    }
+}
+
+bool CheckpointFileReader::is_open() const
+{
+    return m_file.is_open();
+}
+
+BufferedFile& CheckpointFileReader::file()
+{
+    return m_file;
+}
+
+}   // namespace renderer
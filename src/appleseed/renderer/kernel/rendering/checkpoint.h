@@ -0,0 +1,134 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_RENDERER_KERNEL_RENDERING_CHECKPOINT_H
+#define APPLESEED_RENDERER_KERNEL_RENDERING_CHECKPOINT_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/utility/bufferedfile.h"
+
+// Standard headers.
+#include <cstddef>
+#include <string>
+
+// Forward declarations.
+namespace foundation    { class Dictionary; }
+namespace renderer      { class ParamArray; }
+
+namespace renderer
+{
+
+//
+// Checkpoint files.
+//
+// A checkpoint file captures the progress of a render so that the render can
+// be resumed after the process was interrupted. Checkpoints are written to a
+// temporary file which then replaces the previous checkpoint: a process killed
+// while writing a checkpoint leaves the previous checkpoint intact.
+//
+// Checkpoint files use the native byte order and are only meant to be read
+// back on the machine architecture that wrote them.
+//
+
+struct CheckpointParameters
+{
+    std::string     m_path;         // path to the checkpoint file, empty if checkpointing is disabled
+    bool            m_resume;       // resume the render from the checkpoint file if it exists?
+    double          m_interval;     // minimum time in seconds between two checkpoints
+
+    explicit CheckpointParameters(const ParamArray& params);
+
+    bool is_enabled() const;
+
+    // Return the metadata of the checkpoint parameters.
+    static foundation::Dictionary get_params_metadata();
+};
+
+class CheckpointFileWriter
+  : public foundation::NonCopyable
+{
+  public:
+    // Start writing a checkpoint of a given kind to a temporary file.
+    CheckpointFileWriter(
+        const char*     path,
+        const char*     kind);
+
+    // Return true if the temporary file could be created.
+    bool is_open() const;
+
+    // Access the temporary file.
+    foundation::BufferedFile& file();
+
+    // Mark the checkpoint as unusable, e.g. following a write error.
+    void set_failed();
+
+    // Close the temporary file and move it over the checkpoint file.
+    // Return true if successful, false otherwise.
+    bool commit();
+
+  private:
+    const std::string           m_path;
+    const std::string           m_temp_path;
+    foundation::BufferedFile    m_file;
+    bool                        m_failed;
+};
+
+class CheckpointFileReader
+  : public foundation::NonCopyable
+{
+  public:
+    // Open an existing checkpoint file of a given kind.
+    CheckpointFileReader(
+        const char*     path,
+        const char*     kind);
+
+    // Return true if the file exists and is a checkpoint of the expected kind.
+    bool is_open() const;
+
+    // Access the checkpoint file.
+    foundation::BufferedFile& file();
+
+  private:
+    foundation::BufferedFile    m_file;
+};
+
+
+//
+// CheckpointParameters class implementation.
+//
+
+inline bool CheckpointParameters::is_enabled() const
+{
+    return !m_path.empty();
+}
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_RENDERING_CHECKPOINT_H
@@ -0,0 +1,298 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "exrtilecallback.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/kernel/aov/imagestack.h"
+#include "renderer/kernel/rendering/tilecallbackbase.h"
+#include "renderer/modeling/aov/aov.h"
+#include "renderer/modeling/aov/aovcontainer.h"
+#include "renderer/modeling/frame/frame.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/core/exceptions/exceptionioerror.h"
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/image.h"
+#include "foundation/image/imageattributes.h"
+#include "foundation/image/pixel.h"
+#include "foundation/image/progressiveexrimagefilewriter.h"
+#include "foundation/platform/thread.h"
+#include "foundation/utility/stopwatch.h"
+#include "foundation/utility/string.h"
+
+// Standard headers.
+#include <cstddef>
+#include <string>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+namespace
+{
+    //
+    // Writes the tiles of a frame, main image and AOVs, to a multipart OpenEXR file.
+    //
+
+    class FrameTileWriter
+      : public NonCopyable
+    {
+      public:
+        FrameTileWriter(
+            const Frame&    frame,
+            const char*     file_path)
+          : m_frame(frame)
+          , m_file_path(file_path)
+        {
+            const ImageAttributes image_attributes = ImageAttributes::create_default_attributes();
+
+            // Always save the main image as half floats.
+            static const char* ChannelNames[] = {"R", "G", "B", "A"};
+            m_writer.append_part(
+                "beauty",
+                frame.image().properties(),
+                image_attributes,
+                PixelFormatHalf,
+                4,
+                ChannelNames);
+
+            for (size_t i = 0, e = frame.aovs().size(); i < e; ++i)
+            {
+                const AOV* aov = frame.aovs().get_by_index(i);
+                const CanvasProperties& props = frame.aov_images().get_image(i).properties();
+
+                // If the AOV has color data, assume we can save it as half floats.
+                m_writer.append_part(
+                    frame.aov_images().get_name(i),
+                    props,
+                    image_attributes,
+                    aov->has_color_data() ? PixelFormatHalf : props.m_pixel_format,
+                    aov->get_channel_count(),
+                    aov->get_channel_names());
+            }
+
+            try
+            {
+                m_writer.open(file_path);
+            }
+            catch (const ExceptionIOError&)
+            {
+                RENDERER_LOG_ERROR(
+                    "failed to write image file %s: i/o error.",
+                    file_path);
+                return;
+            }
+
+            m_stopwatch.start();
+
+            RENDERER_LOG_INFO(
+                "streaming tiles to image file %s...",
+                file_path);
+        }
+
+        void write_tile(
+            const size_t    tile_x,
+            const size_t    tile_y)
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            if (!m_writer.is_open())
+                return;
+
+            try
+            {
+                write_frame_tile(tile_x, tile_y);
+            }
+            catch (const ExceptionIOError&)
+            {
+                abort();
+            }
+        }
+
+        bool close()
+        {
+            boost::mutex::scoped_lock lock(m_mutex);
+
+            if (!m_writer.is_open())
+                return false;
+
+            try
+            {
+                const CanvasProperties& props = m_frame.image().properties();
+
+                // Tiles that were already written to disk are skipped by the writer.
+                for (size_t ty = 0; ty < props.m_tile_count_y; ++ty)
+                {
+                    for (size_t tx = 0; tx < props.m_tile_count_x; ++tx)
+                        write_frame_tile(tx, ty);
+                }
+
+                m_writer.close();
+            }
+            catch (const ExceptionIOError&)
+            {
+                abort();
+                return false;
+            }
+
+            m_stopwatch.measure();
+
+            RENDERER_LOG_INFO(
+                "wrote image file %s, %s after streaming started.",
+                m_file_path.c_str(),
+                pretty_time(m_stopwatch.get_seconds()).c_str());
+
+            return true;
+        }
+
+      private:
+        const Frame&                        m_frame;
+        const string                        m_file_path;
+        boost::mutex                        m_mutex;
+        ProgressiveEXRImageFileWriter       m_writer;
+        Stopwatch<DefaultWallclockTimer>    m_stopwatch;
+
+        void write_frame_tile(
+            const size_t    tile_x,
+            const size_t    tile_y)
+        {
+            m_writer.write_tile(0, m_frame.image().tile(tile_x, tile_y), tile_x, tile_y);
+
+            for (size_t i = 0, e = m_frame.aovs().size(); i < e; ++i)
+            {
+                m_writer.write_tile(
+                    i + 1,
+                    m_frame.aov_images().get_image(i).tile(tile_x, tile_y),
+                    tile_x,
+                    tile_y);
+            }
+        }
+
+        void abort()
+        {
+            RENDERER_LOG_ERROR(
+                "failed to write image file %s: i/o error.",
+                m_file_path.c_str());
+
+            try
+            {
+                m_writer.close();
+            }
+            catch (const ExceptionIOError&)
+            {
+            }
+        }
+    };
+
+
+    //
+    // EXRTileCallback class implementation.
+    //
+
+    class EXRTileCallback
+      : public TileCallbackBase
+    {
+      public:
+        explicit EXRTileCallback(FrameTileWriter& writer)
+          : m_writer(writer)
+        {
+        }
+
+        virtual void release() override
+        {
+            // The factory always return the same tile callback instance.
+            // Prevent this instance from being destroyed by doing nothing here.
+        }
+
+        virtual void on_tile_end(
+            const Frame*    frame,
+            const size_t    tile_x,
+            const size_t    tile_y) override
+        {
+            m_writer.write_tile(tile_x, tile_y);
+        }
+
+      private:
+        FrameTileWriter& m_writer;
+    };
+}
+
+
+//
+// EXRTileCallbackFactory class implementation.
+//
+
+struct EXRTileCallbackFactory::Impl
+{
+    FrameTileWriter     m_writer;
+    EXRTileCallback     m_callback;
+
+    Impl(
+        const Frame&    frame,
+        const char*     file_path)
+      : m_writer(frame, file_path)
+      , m_callback(m_writer)
+    {
+    }
+};
+
+EXRTileCallbackFactory::EXRTileCallbackFactory(
+    const Frame&        frame,
+    const char*         file_path)
+  : impl(new Impl(frame, file_path))
+{
+}
+
+EXRTileCallbackFactory::~EXRTileCallbackFactory()
+{
+    delete impl;
+}
+
+void EXRTileCallbackFactory::release()
+{
+    delete this;
+}
+
+ITileCallback* EXRTileCallbackFactory::create()
+{
+    return &impl->m_callback;
+}
+
+bool EXRTileCallbackFactory::close()
+{
+    return impl->m_writer.close();
+}
+
+}   // namespace renderer
@@ -0,0 +1,88 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_RENDERER_KERNEL_RENDERING_EXRTILECALLBACK_H
+#define APPLESEED_RENDERER_KERNEL_RENDERING_EXRTILECALLBACK_H
+
+// appleseed.renderer headers.
+#include "renderer/kernel/rendering/itilecallback.h"
+
+// appleseed.foundation headers.
+#include "foundation/platform/compiler.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Forward declarations.
+namespace renderer  { class Frame; }
+
+namespace renderer
+{
+
+//
+// A tile callback factory whose tile callbacks write rendered tiles to a
+// multipart OpenEXR file as soon as they are complete.
+//
+// The file contains a "beauty" part for the main image followed by one part
+// per AOV, like Frame::write_image_and_aovs_to_multipart_exr(). The main image
+// and AOVs with color data are stored as half floats.
+//
+// Only tiles that are final when on_tile_end() is called should be streamed,
+// i.e. this is meant for single-pass tile-based rendering.
+//
+
+class APPLESEED_DLLSYMBOL EXRTileCallbackFactory
+  : public ITileCallbackFactory
+{
+  public:
+    // Constructor. Creates the image file. The frame's AOVs must already be set up.
+    EXRTileCallbackFactory(
+        const Frame&        frame,
+        const char*         file_path);
+
+    // Destructor.
+    ~EXRTileCallbackFactory();
+
+    virtual void release() override;
+
+    virtual ITileCallback* create() override;
+
+    // Write the tiles of the frame that were not received by the tile callbacks
+    // (for instance tiles that were restored from a checkpoint) and close the file.
+    // Return true if successful, false otherwise.
+    bool close();
+
+  private:
+    struct Impl;
+    Impl* impl;
+};
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_RENDERING_EXRTILECALLBACK_H
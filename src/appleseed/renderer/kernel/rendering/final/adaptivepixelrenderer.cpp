@@ -171,12 +171,16 @@ namespace
             m_scratch_fb->clear();
 
             // Create a sampling context.
-            const size_t frame_width = frame.image().properties().m_canvas_width;
-            const size_t pixel_index = pi.y * frame_width + pi.x;
-            const size_t instance = hash_uint32(static_cast<uint32>(pass_hash + pixel_index));
-            SamplingContext::RNGType rng(pass_hash, instance);
+            const size_t instance =
+                compute_pixel_instance(
+                    frame,
+                    pass_hash,
+                    pi,
+                    m_params.m_sampling_mode,
+                    m_params.m_max_samples);
+            m_rng.reseed(pass_hash, instance);
             SamplingContext sampling_context(
-                rng,
+                m_rng,
                 m_params.m_sampling_mode,
                 2,                          // number of dimensions
                 0,                          // number of samples -- unknown
@@ -326,6 +330,7 @@ namespace
         int                                 m_scratch_fb_half_height;
         auto_ptr<ShadingResultFrameBuffer>  m_scratch_fb;
         auto_ptr<Tile>                      m_diagnostics;
+        SamplingContext::RNGType            m_rng;          // reseeded for each pixel
 
         static Color4f scalar_to_color(const float value)
         {
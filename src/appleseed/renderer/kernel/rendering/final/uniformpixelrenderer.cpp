@@ -127,12 +127,16 @@ namespace
             if (m_params.m_decorrelate)
             {
                 // Create a sampling context.
-                const size_t frame_width = frame.image().properties().m_canvas_width;
-                const size_t pixel_index = pi.y * frame_width + pi.x;
-                const size_t instance = hash_uint32(static_cast<uint32>(pass_hash + pixel_index));
-                SamplingContext::RNGType rng(pass_hash, instance);
+                const size_t instance =
+                    compute_pixel_instance(
+                        frame,
+                        pass_hash,
+                        pi,
+                        m_params.m_sampling_mode,
+                        m_sample_count);
+                m_rng.reseed(pass_hash, instance);
                 SamplingContext sampling_context(
-                    rng,
+                    m_rng,
                     m_params.m_sampling_mode,
                     2,                          // number of dimensions
                     0,                          // number of samples -- unknown
@@ -180,7 +184,7 @@ namespace
                 const size_t frame_width = frame.image().properties().m_canvas_width;
                 const size_t pixel_index = pi.y * frame_width + pi.x;
                 const size_t instance = hash_uint32(static_cast<uint32>(pass_hash + pixel_index));
-                SamplingContext::RNGType rng(pass_hash, instance);
+                m_rng.reseed(pass_hash, instance);
 
                 const int base_sx = pi.x * m_sqrt_sample_count;
                 const int base_sy = pi.y * m_sqrt_sample_count;
@@ -204,7 +208,7 @@ namespace
                         // as this seems to give less correlation artifacts than when the
                         // initial dimension is set to 0 or 2.
                         SamplingContext sampling_context(
-                            rng,
+                            m_rng,
                             m_params.m_sampling_mode,
                             1,                          // number of dimensions
                             instance,                   // number of samples
@@ -272,6 +276,7 @@ namespace
         const int                           m_sqrt_sample_count;
         PixelSampler                        m_pixel_sampler;
         Population<uint64>                  m_total_sampling_dim;
+        SamplingContext::RNGType            m_rng;          // reseeded for each pixel
     };
 }
 
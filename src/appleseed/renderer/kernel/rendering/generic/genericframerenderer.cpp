@@ -33,6 +33,8 @@
 // appleseed.renderer headers.
 #include "renderer/global/globallogger.h"
 #include "renderer/global/globaltypes.h"
+#include "renderer/kernel/rendering/checkpoint.h"
+#include "renderer/kernel/rendering/generic/tilecheckpoint.h"
 #include "renderer/kernel/rendering/generic/tilejob.h"
 #include "renderer/kernel/rendering/generic/tilejobfactory.h"
 #include "renderer/kernel/rendering/iframerenderer.h"
@@ -111,6 +113,14 @@ namespace
                     m_tile_callbacks.push_back(tile_callback_factory->create());
             }
 
+            // Create the checkpoint if checkpointing is enabled.
+            if (m_params.m_checkpoint_params.is_enabled())
+            {
+                if (m_params.m_pass_count > 1)
+                    RENDERER_LOG_WARNING("checkpointing is only supported for single-pass renders, disabling it.");
+                else m_checkpoint.reset(new TileCheckpoint(frame, m_params.m_checkpoint_params));
+            }
+
             RENDERER_LOG_INFO(
                 "rendering settings:\n"
                 "  spectrum mode                 %s\n"
@@ -162,6 +172,10 @@ namespace
 
             m_abort_switch.clear();
 
+            // Restore complete tiles from the checkpoint file if resuming.
+            if (m_checkpoint.get())
+                m_checkpoint->on_render_begin();
+
             // Start job execution.
             m_job_manager->start();
 
@@ -175,6 +189,7 @@ namespace
                     m_params.m_spectrum_mode,
                     m_tile_renderers,
                     m_tile_callbacks,
+                    m_checkpoint.get(),
                     m_pass_callback,
                     m_job_queue,
                     m_abort_switch,
@@ -222,12 +237,14 @@ namespace
             const size_t                        m_thread_count;     // number of rendering threads
             const TileJobFactory::TileOrdering  m_tile_ordering;    // tile rendering order
             const size_t                        m_pass_count;       // number of rendering passes
+            const CheckpointParameters          m_checkpoint_params;
 
             explicit Parameters(const ParamArray& params)
               : m_spectrum_mode(get_spectrum_mode(params))
               , m_thread_count(get_rendering_thread_count(params))
               , m_tile_ordering(get_tile_ordering(params))
               , m_pass_count(params.get_optional<size_t>("passes", 1))
+              , m_checkpoint_params(params)
             {
             }
 
@@ -276,6 +293,7 @@ namespace
                 const Spectrum::Mode                spectrum_mode,
                 vector<ITileRenderer*>&             tile_renderers,
                 vector<ITileCallback*>&             tile_callbacks,
+                TileCheckpoint*                     checkpoint,
                 IPassCallback*                      pass_callback,
                 JobQueue&                           job_queue,
                 IAbortSwitch&                       abort_switch,
@@ -286,6 +304,7 @@ namespace
               , m_spectrum_mode(spectrum_mode)
               , m_tile_renderers(tile_renderers)
               , m_tile_callbacks(tile_callbacks)
+              , m_checkpoint(checkpoint)
               , m_pass_callback(pass_callback)
               , m_job_queue(job_queue)
               , m_abort_switch(abort_switch)
@@ -318,6 +337,7 @@ namespace
                         m_tile_ordering,
                         m_tile_renderers,
                         m_tile_callbacks,
+                        m_checkpoint,
                         pass_hash,
                         m_spectrum_mode,
                         tile_jobs,
@@ -339,6 +359,10 @@ namespace
                     }
                 }
 
+                // Save the final state of the render, including when it was aborted.
+                if (m_checkpoint)
+                    m_checkpoint->save();
+
                 m_is_rendering = false;
             }
 
@@ -347,6 +371,7 @@ namespace
             const TileJobFactory::TileOrdering      m_tile_ordering;
             vector<ITileRenderer*>&                 m_tile_renderers;
             vector<ITileCallback*>&                 m_tile_callbacks;
+            TileCheckpoint*                         m_checkpoint;
             IPassCallback*                          m_pass_callback;
             const size_t                            m_pass_count;
             const Spectrum::Mode                    m_spectrum_mode;
@@ -366,6 +391,7 @@ namespace
         vector<ITileRenderer*>      m_tile_renderers;   // tile renderers, one per thread
         vector<ITileCallback*>      m_tile_callbacks;   // tile callbacks, none or one per thread
         IPassCallback*              m_pass_callback;
+        auto_ptr<TileCheckpoint>    m_checkpoint;       // only set if checkpointing is enabled
 
         TileJobFactory              m_tile_job_factory;
 
@@ -482,6 +508,8 @@ Dictionary GenericFrameRendererFactory::get_params_metadata()
                             .insert("label", "Random")
                             .insert("help", "Random tile ordering"))));
 
+    metadata.merge(CheckpointParameters::get_params_metadata());
+
     return metadata;
 }
 
@@ -44,6 +44,7 @@
 // appleseed.foundation headers.
 #include "foundation/image/canvasproperties.h"
 #include "foundation/image/image.h"
+#include "foundation/math/hash.h"
 #include "foundation/math/population.h"
 #include "foundation/math/qmc.h"
 #include "foundation/math/scalar.h"
@@ -100,6 +101,14 @@ namespace
             m_rng = SamplingContext::RNGType();
         }
 
+        virtual void skip_sequence(const size_t bound) override
+        {
+            SampleGeneratorBase::skip_sequence(bound);
+
+            // Don't replay the random numbers that were consumed before the bound.
+            m_rng.reseed(hash_uint64(bound), hash_uint64(~static_cast<uint64>(bound)));
+        }
+
         virtual StatisticsVector get_statistics() const override
         {
             Statistics stats;
@@ -163,6 +163,13 @@ namespace
 
 #endif
 
+            // Select the wavelengths carried by this sample.
+            if (Spectrum::get_mode() == Spectrum::HeroWavelength)
+            {
+                sampling_context.split_in_place(1, 1);
+                Spectrum::set_hero_wavelengths(sampling_context.next2<float>());
+            }
+
             // Construct a primary ray.
             ShadingRay primary_ray;
             m_scene.get_active_camera()->spawn_ray(
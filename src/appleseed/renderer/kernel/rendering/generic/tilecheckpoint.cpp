@@ -0,0 +1,323 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "tilecheckpoint.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/kernel/aov/imagestack.h"
+#include "renderer/modeling/frame/frame.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/image.h"
+#include "foundation/image/tile.h"
+#include "foundation/utility/bufferedfile.h"
+#include "foundation/utility/string.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+namespace
+{
+    const char* CheckpointKind = "tiles";
+
+    bool write_uint32(BufferedFile& file, const size_t value)
+    {
+        const uint32 x = static_cast<uint32>(value);
+        return file.write(x) == sizeof(x);
+    }
+
+    bool read_uint32(BufferedFile& file, size_t& value)
+    {
+        uint32 x;
+        if (file.read(x) != sizeof(x))
+            return false;
+        value = x;
+        return true;
+    }
+
+    size_t get_image_count(const Frame& frame)
+    {
+        return 1 + frame.aov_images().size();
+    }
+
+    Image& get_image(const Frame& frame, const size_t image_index)
+    {
+        return
+            image_index == 0
+                ? frame.image()
+                : frame.aov_images().get_image(image_index - 1);
+    }
+
+    // Write the properties that a checkpoint must match in order to be restored into a frame.
+    bool write_frame_layout(BufferedFile& file, const Frame& frame)
+    {
+        const CanvasProperties& props = frame.image().properties();
+
+        bool success =
+            write_uint32(file, props.m_canvas_width) &&
+            write_uint32(file, props.m_canvas_height) &&
+            write_uint32(file, props.m_tile_width) &&
+            write_uint32(file, props.m_tile_height) &&
+            write_uint32(file, get_image_count(frame));
+
+        for (size_t i = 0, e = get_image_count(frame); success && i < e; ++i)
+        {
+            const CanvasProperties& image_props = get_image(frame, i).properties();
+            success =
+                write_uint32(file, image_props.m_channel_count) &&
+                write_uint32(file, image_props.m_pixel_format);
+        }
+
+        return success;
+    }
+
+    bool check_frame_layout(BufferedFile& file, const Frame& frame)
+    {
+        const CanvasProperties& props = frame.image().properties();
+        size_t canvas_width, canvas_height, tile_width, tile_height, image_count;
+
+        if (!read_uint32(file, canvas_width) ||
+            !read_uint32(file, canvas_height) ||
+            !read_uint32(file, tile_width) ||
+            !read_uint32(file, tile_height) ||
+            !read_uint32(file, image_count))
+            return false;
+
+        if (canvas_width != props.m_canvas_width ||
+            canvas_height != props.m_canvas_height ||
+            tile_width != props.m_tile_width ||
+            tile_height != props.m_tile_height ||
+            image_count != get_image_count(frame))
+            return false;
+
+        for (size_t i = 0; i < image_count; ++i)
+        {
+            const CanvasProperties& image_props = get_image(frame, i).properties();
+            size_t channel_count, pixel_format;
+
+            if (!read_uint32(file, channel_count) ||
+                !read_uint32(file, pixel_format) ||
+                channel_count != image_props.m_channel_count ||
+                pixel_format != static_cast<size_t>(image_props.m_pixel_format))
+                return false;
+        }
+
+        return true;
+    }
+}
+
+
+//
+// TileCheckpoint class implementation.
+//
+
+TileCheckpoint::TileCheckpoint(
+    const Frame&                    frame,
+    const CheckpointParameters&     params)
+  : m_frame(frame)
+  , m_params(params)
+  , m_complete(frame.image().properties().m_tile_count, 0)
+  , m_stopwatch(0)
+  , m_resumed(false)
+{
+    assert(m_params.is_enabled());
+}
+
+void TileCheckpoint::on_render_begin()
+{
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        fill(m_complete.begin(), m_complete.end(), static_cast<uint8>(0));
+        m_stopwatch.start();
+    }
+
+    if (m_params.m_resume && !m_resumed)
+    {
+        m_resumed = true;
+        restore();
+    }
+}
+
+bool TileCheckpoint::is_tile_complete(
+    const size_t                    tile_x,
+    const size_t                    tile_y) const
+{
+    const size_t tile_count_x = m_frame.image().properties().m_tile_count_x;
+
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_complete[tile_y * tile_count_x + tile_x] != 0;
+}
+
+void TileCheckpoint::on_tile_complete(
+    const size_t                    tile_x,
+    const size_t                    tile_y)
+{
+    const size_t tile_count_x = m_frame.image().properties().m_tile_count_x;
+
+    bool save_needed;
+
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+
+        m_complete[tile_y * tile_count_x + tile_x] = 1;
+
+        // Only the thread that restarts the stopwatch saves the checkpoint.
+        save_needed = m_stopwatch.measure().get_seconds() >= m_params.m_interval;
+        if (save_needed)
+            m_stopwatch.start();
+    }
+
+    if (save_needed)
+        save();
+}
+
+void TileCheckpoint::save()
+{
+    boost::mutex::scoped_lock save_lock(m_save_mutex);
+
+    // Pixels of complete tiles don't change anymore, only the tile flags need to be locked.
+    vector<uint8> complete;
+    {
+        boost::mutex::scoped_lock lock(m_mutex);
+        complete = m_complete;
+    }
+
+    const CanvasProperties& props = m_frame.image().properties();
+    const size_t complete_count = count(complete.begin(), complete.end(), static_cast<uint8>(1));
+
+    CheckpointFileWriter writer(m_params.m_path.c_str(), CheckpointKind);
+    if (!writer.is_open())
+        return;
+
+    BufferedFile& file = writer.file();
+
+    bool success =
+        write_frame_layout(file, m_frame) &&
+        write_uint32(file, complete_count);
+
+    for (size_t i = 0, e = complete.size(); success && i < e; ++i)
+    {
+        if (complete[i] == 0)
+            continue;
+
+        const size_t tile_x = i % props.m_tile_count_x;
+        const size_t tile_y = i / props.m_tile_count_x;
+
+        success = write_uint32(file, tile_x) && write_uint32(file, tile_y);
+
+        for (size_t j = 0, je = get_image_count(m_frame); success && j < je; ++j)
+        {
+            const Tile& tile = get_image(m_frame, j).tile(tile_x, tile_y);
+            success = file.write(tile.get_storage(), tile.get_size()) == tile.get_size();
+        }
+    }
+
+    if (!success)
+        writer.set_failed();
+
+    if (writer.commit())
+    {
+        RENDERER_LOG_INFO(
+            "wrote checkpoint file %s (%s of %s tiles complete).",
+            m_params.m_path.c_str(),
+            pretty_uint(complete_count).c_str(),
+            pretty_uint(props.m_tile_count).c_str());
+    }
+}
+
+void TileCheckpoint::restore()
+{
+    CheckpointFileReader reader(m_params.m_path.c_str(), CheckpointKind);
+    if (!reader.is_open())
+    {
+        RENDERER_LOG_WARNING(
+            "could not resume from checkpoint file %s, rendering from scratch.",
+            m_params.m_path.c_str());
+        return;
+    }
+
+    BufferedFile& file = reader.file();
+
+    size_t complete_count;
+    if (!check_frame_layout(file, m_frame) || !read_uint32(file, complete_count))
+    {
+        RENDERER_LOG_WARNING(
+            "checkpoint file %s does not match the frame, rendering from scratch.",
+            m_params.m_path.c_str());
+        return;
+    }
+
+    const CanvasProperties& props = m_frame.image().properties();
+    size_t restored_count = 0;
+
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    for (size_t i = 0; i < complete_count; ++i)
+    {
+        size_t tile_x, tile_y;
+        if (!read_uint32(file, tile_x) ||
+            !read_uint32(file, tile_y) ||
+            tile_x >= props.m_tile_count_x ||
+            tile_y >= props.m_tile_count_y)
+            break;
+
+        bool success = true;
+
+        for (size_t j = 0, je = get_image_count(m_frame); success && j < je; ++j)
+        {
+            Tile& tile = get_image(m_frame, j).tile(tile_x, tile_y);
+            success = file.read(tile.get_storage(), tile.get_size()) == tile.get_size();
+        }
+
+        // A truncated tile is simply rendered again.
+        if (!success)
+            break;
+
+        m_complete[tile_y * props.m_tile_count_x + tile_x] = 1;
+        ++restored_count;
+    }
+
+    RENDERER_LOG_INFO(
+        "resuming render from checkpoint file %s (%s of %s tiles complete).",
+        m_params.m_path.c_str(),
+        pretty_uint(restored_count).c_str(),
+        pretty_uint(props.m_tile_count).c_str());
+}
+
+}   // namespace renderer
@@ -0,0 +1,102 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_RENDERER_KERNEL_RENDERING_GENERIC_TILECHECKPOINT_H
+#define APPLESEED_RENDERER_KERNEL_RENDERING_GENERIC_TILECHECKPOINT_H
+
+// appleseed.renderer headers.
+#include "renderer/kernel/rendering/checkpoint.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/platform/thread.h"
+#include "foundation/platform/timers.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/stopwatch.h"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+// Forward declarations.
+namespace renderer  { class Frame; }
+
+namespace renderer
+{
+
+//
+// Keeps track of the tiles of a frame that have been completely rendered, and
+// periodically saves these tiles (main image and AOV images) to a checkpoint file.
+//
+// Only single-pass renders can be checkpointed this way since the pixels of a
+// tile must not change once the tile is complete.
+//
+
+class TileCheckpoint
+  : public foundation::NonCopyable
+{
+  public:
+    // Constructor.
+    TileCheckpoint(
+        const Frame&                    frame,
+        const CheckpointParameters&     params);
+
+    // Prepare for rendering the frame. When resuming, the tiles saved in the
+    // checkpoint file are restored into the frame; this only happens once.
+    void on_render_begin();
+
+    // Return true if a given tile is complete. Thread-safe.
+    bool is_tile_complete(
+        const size_t                    tile_x,
+        const size_t                    tile_y) const;
+
+    // Mark a tile as complete and save a checkpoint if enough time has passed
+    // since the last one. Thread-safe.
+    void on_tile_complete(
+        const size_t                    tile_x,
+        const size_t                    tile_y);
+
+    // Save a checkpoint. Thread-safe.
+    void save();
+
+  private:
+    const Frame&                        m_frame;
+    const CheckpointParameters          m_params;
+    mutable boost::mutex                m_mutex;        // protects m_complete and m_stopwatch
+    boost::mutex                        m_save_mutex;
+    std::vector<foundation::uint8>      m_complete;
+    foundation::Stopwatch<foundation::DefaultWallclockTimer> m_stopwatch;
+    bool                                m_resumed;
+
+    void restore();
+};
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_RENDERING_GENERIC_TILECHECKPOINT_H
@@ -31,6 +31,7 @@
 #include "tilejob.h"
 
 // appleseed.renderer headers.
+#include "renderer/kernel/rendering/generic/tilecheckpoint.h"
 #include "renderer/kernel/rendering/itilecallback.h"
 #include "renderer/kernel/rendering/itilerenderer.h"
 #include "renderer/modeling/frame/frame.h"
@@ -39,6 +40,7 @@
 #include "foundation/image/canvasproperties.h"
 #include "foundation/image/image.h"
 #include "foundation/image/tile.h"
+#include "foundation/utility/job/iabortswitch.h"
 
 // Standard headers.
 #include <cassert>
@@ -57,6 +59,7 @@ namespace renderer
 TileJob::TileJob(
     const TileRendererVector&   tile_renderers,
     const TileCallbackVector&   tile_callbacks,
+    TileCheckpoint*             checkpoint,
     const Frame&                frame,
     const size_t                tile_x,
     const size_t                tile_y,
@@ -65,6 +68,7 @@ TileJob::TileJob(
     IAbortSwitch&               abort_switch)
   : m_tile_renderers(tile_renderers)
   , m_tile_callbacks(tile_callbacks)
+  , m_checkpoint(checkpoint)
   , m_frame(frame)
   , m_tile_x(tile_x)
   , m_tile_y(tile_y)
@@ -115,6 +119,10 @@ void TileJob::execute(const size_t thread_index)
         throw;
     }
 
+    // Record the tile in the checkpoint unless its rendering was interrupted.
+    if (m_checkpoint && !m_abort_switch.is_aborted())
+        m_checkpoint->on_tile_complete(m_tile_x, m_tile_y);
+
     // Call the post-render tile callback.
     if (tile_callback)
         tile_callback->on_tile_end(&m_frame, m_tile_x, m_tile_y);
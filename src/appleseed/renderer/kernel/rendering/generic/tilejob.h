@@ -44,6 +44,7 @@
 namespace renderer  { class Frame; }
 namespace renderer  { class ITileCallback; }
 namespace renderer  { class ITileRenderer; }
+namespace renderer  { class TileCheckpoint; }
 
 namespace renderer
 {
@@ -63,6 +64,7 @@ class TileJob
     TileJob(
         const TileRendererVector&   tile_renderers,
         const TileCallbackVector&   tile_callbacks,
+        TileCheckpoint*             checkpoint,
         const Frame&                frame,
         const size_t                tile_x,
         const size_t                tile_y,
@@ -76,6 +78,7 @@ class TileJob
   private:
     const TileRendererVector&       m_tile_renderers;
     const TileCallbackVector&       m_tile_callbacks;
+    TileCheckpoint*                 m_checkpoint;
     const Frame&                    m_frame;
     const size_t                    m_tile_x;
     const size_t                    m_tile_y;
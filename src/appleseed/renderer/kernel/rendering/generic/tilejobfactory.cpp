@@ -31,6 +31,7 @@
 #include "tilejobfactory.h"
 
 // appleseed.renderer headers.
+#include "renderer/kernel/rendering/generic/tilecheckpoint.h"
 #include "renderer/modeling/frame/frame.h"
 
 // appleseed.foundation headers.
@@ -57,6 +58,7 @@ void TileJobFactory::create(
     const TileOrdering                  tile_ordering,
     const TileJob::TileRendererVector&  tile_renderers,
     const TileJob::TileCallbackVector&  tile_callbacks,
+    TileCheckpoint*                     checkpoint,
     const size_t                        pass_hash,
     const Spectrum::Mode                spectrum_mode,
     TileJobVector&                      tile_jobs,
@@ -82,11 +84,16 @@ void TileJobFactory::create(
         assert(tile_x < props.m_tile_count_x);
         assert(tile_y < props.m_tile_count_y);
 
+        // Skip tiles restored from a checkpoint.
+        if (checkpoint && checkpoint->is_tile_complete(tile_x, tile_y))
+            continue;
+
         // Create the tile job.
         tile_jobs.push_back(
             new TileJob(
                 tile_renderers,
                 tile_callbacks,
+                checkpoint,
                 frame,
                 tile_x,
                 tile_y,
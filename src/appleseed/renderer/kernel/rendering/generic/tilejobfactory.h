@@ -45,6 +45,7 @@
 namespace foundation    { class CanvasProperties; }
 namespace foundation    { class IAbortSwitch; }
 namespace renderer      { class Frame; }
+namespace renderer      { class TileCheckpoint; }
 namespace renderer      { class TileJob; }
 
 namespace renderer
@@ -68,12 +69,14 @@ class TileJobFactory
         RandomOrdering
     };
 
-    // Create tile jobs for a given frame.
+    // Create tile jobs for a given frame. Tiles that are complete according
+    // to the checkpoint, if there is one, are skipped.
     void create(
         const Frame&                        frame,
         const TileOrdering                  tile_ordering,
         const TileJob::TileRendererVector&  tile_renderers,
         const TileJob::TileCallbackVector&  tile_callbacks,
+        TileCheckpoint*                     checkpoint,
         const size_t                        pass_hash,
         const Spectrum::Mode                spectrum_mode,
         TileJobVector&                      tile_jobs,
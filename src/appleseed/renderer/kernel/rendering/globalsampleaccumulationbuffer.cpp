@@ -40,7 +40,9 @@
 #include "foundation/image/image.h"
 #include "foundation/image/pixel.h"
 #include "foundation/image/tile.h"
+#include "foundation/utility/bufferedfile.h"
 #include "foundation/utility/job/iabortswitch.h"
+#include "foundation/utility/job/parallelfor.h"
 
 // Boost headers.
 #include "boost/chrono/duration.hpp"
@@ -128,21 +130,64 @@ void GlobalSampleAccumulationBuffer::develop_to_frame(
 
     const float scale = 1.0f / m_sample_count;
 
-    for (size_t ty = 0; ty < frame_props.m_tile_count_y; ++ty)
-    {
-        for (size_t tx = 0; tx < frame_props.m_tile_count_x; ++tx)
+    // Develop tiles in parallel. The lock is held by this thread for the whole duration.
+    parallel_for(
+        frame_props.m_tile_count,
+        [&](const size_t tile_index)
         {
             if (abort_switch.is_aborted())
                 return;
 
+            const size_t tx = tile_index % frame_props.m_tile_count_x;
+            const size_t ty = tile_index / frame_props.m_tile_count_x;
+
             Tile& tile = image.tile(tx, ty);
 
             const size_t x = tx * frame_props.m_tile_width;
             const size_t y = ty * frame_props.m_tile_height;
 
             develop_to_tile(tile, x, y, tx, ty, scale);
-        }
-    }
+        });
+}
+
+bool GlobalSampleAccumulationBuffer::write_checkpoint(BufferedFile& file)
+{
+    // Request exclusive access.
+    boost::unique_lock<boost::shared_mutex> lock(m_mutex);
+
+    const uint32 width = static_cast<uint32>(m_fb.get_width());
+    const uint32 height = static_cast<uint32>(m_fb.get_height());
+    const uint64 sample_count = m_sample_count;
+
+    return
+        file.write(width) == sizeof(width) &&
+        file.write(height) == sizeof(height) &&
+        file.write(sample_count) == sizeof(sample_count) &&
+        file.write(m_fb.get_storage(), m_fb.get_size()) == m_fb.get_size();
+}
+
+bool GlobalSampleAccumulationBuffer::read_checkpoint(BufferedFile& file)
+{
+    // Request exclusive access.
+    boost::unique_lock<boost::shared_mutex> lock(m_mutex);
+
+    uint32 width, height;
+    uint64 sample_count;
+
+    if (file.read(width) != sizeof(width) ||
+        file.read(height) != sizeof(height) ||
+        file.read(sample_count) != sizeof(sample_count))
+        return false;
+
+    if (width != m_fb.get_width() || height != m_fb.get_height())
+        return false;
+
+    if (file.read(m_fb.get_storage(), m_fb.get_size()) != m_fb.get_size())
+        return false;
+
+    m_sample_count = sample_count;
+
+    return true;
 }
 
 void GlobalSampleAccumulationBuffer::increment_sample_count(const uint64 delta_sample_count)
@@ -44,6 +44,7 @@
 #include <cstddef>
 
 // Forward declarations.
+namespace foundation    { class BufferedFile; }
 namespace foundation    { class IAbortSwitch; }
 namespace foundation    { class Tile; }
 namespace renderer      { class Frame; }
@@ -76,6 +77,12 @@ class GlobalSampleAccumulationBuffer
         Frame&                      frame,
         foundation::IAbortSwitch&   abort_switch) override;
 
+    // Write the content of the buffer to a checkpoint file. Thread-safe.
+    virtual bool write_checkpoint(foundation::BufferedFile& file) override;
+
+    // Restore the content of the buffer from a checkpoint file. Thread-safe.
+    virtual bool read_checkpoint(foundation::BufferedFile& file) override;
+
     // Increment the number of samples used for pixel values renormalization. Thread-safe.
     void increment_sample_count(const foundation::uint64 delta_sample_count);
 
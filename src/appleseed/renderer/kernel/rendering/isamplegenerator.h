@@ -61,6 +61,14 @@ class ISampleGenerator
         SampleAccumulationBuffer&   buffer,
         foundation::IAbortSwitch&   abort_switch) = 0;
 
+    // Return a bound such that all sequence indices used so far are strictly
+    // below it. Thread-safe, can be called while samples are being generated.
+    virtual size_t get_sequence_bound() const = 0;
+
+    // Continue sample generation past a given sequence index bound, such that
+    // none of the sequence indices below this bound are used again.
+    virtual void skip_sequence(const size_t bound) = 0;
+
     // Retrieve performance statistics.
     virtual foundation::StatisticsVector get_statistics() const = 0;
 };
@@ -46,7 +46,9 @@
 #include "foundation/math/scalar.h"
 #include "foundation/platform/atomic.h"
 #include "foundation/platform/timers.h"
+#include "foundation/utility/bufferedfile.h"
 #include "foundation/utility/job/iabortswitch.h"
+#include "foundation/utility/job/parallelfor.h"
 #include "foundation/utility/stopwatch.h"
 
 // Standard headers.
@@ -259,15 +261,16 @@ void LocalSampleAccumulationBuffer::develop_to_frame(
 
     const FilteredTile& level = *m_levels[m_active_level];
 
-    for (size_t ty = 0; ty < frame_props.m_tile_count_y; ++ty)
-    {
-        for (size_t tx = 0; tx < frame_props.m_tile_count_x; ++tx)
+    // Develop tiles in parallel. The lock is held by this thread for the whole duration.
+    parallel_for(
+        frame_props.m_tile_count,
+        [&](const size_t tile_index)
         {
             if (abort_switch.is_aborted())
-            {
-                m_lock.unlock_write();
                 return;
-            }
+
+            const size_t tx = tile_index % frame_props.m_tile_count_x;
+            const size_t ty = tile_index / frame_props.m_tile_count_x;
 
             const size_t origin_x = tx * frame_props.m_tile_width;
             const size_t origin_y = ty * frame_props.m_tile_height;
@@ -287,7 +290,12 @@ void LocalSampleAccumulationBuffer::develop_to_frame(
                 origin_x,
                 origin_y,
                 rect);
-        }
+        });
+
+    if (abort_switch.is_aborted())
+    {
+        m_lock.unlock_write();
+        return;
     }
 
     m_lock.unlock_write();
@@ -299,6 +307,79 @@ void LocalSampleAccumulationBuffer::develop_to_frame(
 #endif
 }
 
+bool LocalSampleAccumulationBuffer::write_checkpoint(BufferedFile& file)
+{
+    // Request exclusive access.
+    LockType::ScopedWriteLock lock(m_lock);
+
+    const uint32 level_count = static_cast<uint32>(m_levels.size());
+    const uint32 active_level = m_active_level;
+    const uint64 sample_count = m_sample_count;
+
+    bool success =
+        file.write(level_count) == sizeof(level_count) &&
+        file.write(active_level) == sizeof(active_level) &&
+        file.write(sample_count) == sizeof(sample_count);
+
+    for (size_t i = 0, e = m_levels.size(); success && i < e; ++i)
+    {
+        const FilteredTile& level = *m_levels[i];
+        const uint32 width = static_cast<uint32>(level.get_width());
+        const uint32 height = static_cast<uint32>(level.get_height());
+        const int32 remaining_pixels = m_remaining_pixels[i];
+
+        success =
+            file.write(width) == sizeof(width) &&
+            file.write(height) == sizeof(height) &&
+            file.write(remaining_pixels) == sizeof(remaining_pixels) &&
+            file.write(level.get_storage(), level.get_size()) == level.get_size();
+    }
+
+    return success;
+}
+
+bool LocalSampleAccumulationBuffer::read_checkpoint(BufferedFile& file)
+{
+    // Request exclusive access.
+    LockType::ScopedWriteLock lock(m_lock);
+
+    uint32 level_count, active_level;
+    uint64 sample_count;
+
+    if (file.read(level_count) != sizeof(level_count) ||
+        file.read(active_level) != sizeof(active_level) ||
+        file.read(sample_count) != sizeof(sample_count))
+        return false;
+
+    if (level_count != m_levels.size() || active_level >= level_count)
+        return false;
+
+    for (size_t i = 0, e = m_levels.size(); i < e; ++i)
+    {
+        FilteredTile& level = *m_levels[i];
+        uint32 width, height;
+        int32 remaining_pixels;
+
+        if (file.read(width) != sizeof(width) ||
+            file.read(height) != sizeof(height) ||
+            file.read(remaining_pixels) != sizeof(remaining_pixels))
+            return false;
+
+        if (width != level.get_width() || height != level.get_height())
+            return false;
+
+        if (file.read(level.get_storage(), level.get_size()) != level.get_size())
+            return false;
+
+        m_remaining_pixels[i] = remaining_pixels;
+    }
+
+    m_active_level = active_level;
+    m_sample_count = sample_count;
+
+    return true;
+}
+
 void LocalSampleAccumulationBuffer::develop_to_tile(
     Tile&               color_tile,
     const size_t        image_width,
@@ -46,6 +46,7 @@
 #include <vector>
 
 // Forward declarations.
+namespace foundation    { class BufferedFile; }
 namespace foundation    { class FilteredTile; }
 namespace foundation    { class IAbortSwitch; }
 namespace foundation    { class Tile; }
@@ -82,6 +83,12 @@ class LocalSampleAccumulationBuffer
         Frame&                              frame,
         foundation::IAbortSwitch&           abort_switch) override;
 
+    // Write the content of the buffer to a checkpoint file. Thread-safe.
+    virtual bool write_checkpoint(foundation::BufferedFile& file) override;
+
+    // Restore the content of the buffer from a checkpoint file. Thread-safe.
+    virtual bool read_checkpoint(foundation::BufferedFile& file) override;
+
     // Exposed for tests and benchmarks.
     static void develop_to_tile(
         foundation::Tile&                   color_tile,
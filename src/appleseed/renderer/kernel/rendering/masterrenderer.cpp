@@ -32,6 +32,7 @@
 
 // appleseed.renderer headers.
 #include "renderer/global/globallogger.h"
+#include "renderer/kernel/intersection/triangletree.h"
 #include "renderer/kernel/rendering/iframerenderer.h"
 #include "renderer/kernel/rendering/renderercomponents.h"
 #include "renderer/kernel/rendering/serialrenderercontroller.h"
@@ -47,6 +48,7 @@
 
 // appleseed.foundation headers.
 #include "foundation/platform/compiler.h"
+#include "foundation/platform/cpudispatch.h"
 #include "foundation/platform/thread.h"
 #include "foundation/utility/job/iabortswitch.h"
 #include "foundation/utility/otherwise.h"
@@ -117,8 +119,27 @@ MasterRenderer::~MasterRenderer()
 
 bool MasterRenderer::render()
 {
-    // Initialize thread-local variables.
-    Spectrum::set_mode(get_spectrum_mode(m_params));
+    // Photons and camera paths would carry different wavelengths in hero wavelength mode.
+    if (get_spectrum_mode(m_params) == Spectrum::HeroWavelength &&
+        m_params.get_optional<string>("lighting_engine", "pt") == "sppm")
+    {
+        RENDERER_LOG_WARNING("the sppm lighting engine does not support hero wavelength sampling, using spectral mode instead.");
+        m_params.insert("spectrum_mode", "spectral");
+    }
+
+    // Radiance cached by paths carrying different wavelengths cannot be averaged.
+    if (get_spectrum_mode(m_params) == Spectrum::HeroWavelength &&
+        m_params.get_optional<string>("lighting_engine", "pt") == "pt" &&
+        m_params.child("pt").get_optional<bool>("enable_radiance_cache", false))
+    {
+        RENDERER_LOG_WARNING("the radiance cache does not support hero wavelength sampling, disabling it.");
+        m_params.push("pt").insert("enable_radiance_cache", false);
+    }
+
+    // Initialize thread-local variables. In hero wavelength mode, entities precompute
+    // their values as full spectra and rendering threads sample them along each path.
+    const Spectrum::Mode spectrum_mode = get_spectrum_mode(m_params);
+    Spectrum::set_mode(spectrum_mode == Spectrum::HeroWavelength ? Spectrum::Spectral : spectrum_mode);
 
     if (m_project.get_scene() == 0)
     {
@@ -232,6 +253,12 @@ IRendererController::Status MasterRenderer::initialize_and_render_frame_sequence
     m_project.update_trace_context();
     m_project.get_frame()->print_settings();
 
+    RENDERER_LOG_INFO(
+        "using %s ray tracing code paths (binary compiled for %s, host supports %s).",
+        get_triangle_tree_intersection_instruction_set_name(),
+        get_instruction_set_name(get_compiled_instruction_set()),
+        get_instruction_set_name(get_host_instruction_set()));
+
     // Create the texture store.
     TextureStore texture_store(
         *m_project.get_scene(),
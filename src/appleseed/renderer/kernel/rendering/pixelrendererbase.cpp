@@ -32,15 +32,62 @@
 
 // appleseed.renderer headers.
 #include "renderer/global/globallogger.h"
+#include "renderer/modeling/frame/frame.h"
 
 // appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/image.h"
+#include "foundation/math/hash.h"
+#include "foundation/math/qmc.h"
+#include "foundation/math/scalar.h"
 #include "foundation/platform/types.h"
 
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+
 using namespace foundation;
+using namespace std;
 
 namespace renderer
 {
 
+namespace
+{
+    // Spread the lower 16 bits of an integer to the even bits of the result.
+    inline uint32 spread_bits(uint32 x)
+    {
+        x &= 0x0000FFFFUL;
+        x = (x | (x << 8)) & 0x00FF00FFUL;
+        x = (x | (x << 4)) & 0x0F0F0F0FUL;
+        x = (x | (x << 2)) & 0x33333333UL;
+        x = (x | (x << 1)) & 0x55555555UL;
+        return x;
+    }
+
+    // Return the position of a pixel along the Z-order curve.
+    inline uint32 morton_code(const Vector2i& pi)
+    {
+        return
+              (spread_bits(static_cast<uint32>(pi.y)) << 1)
+            | spread_bits(static_cast<uint32>(pi.x));
+    }
+
+    // Owen-scramble the value formed by the 'bits' lowest bits of an integer.
+    // The result is a permutation of [0, 2^bits).
+    inline uint32 scramble_low_bits(const uint32 x, const uint32 bits, const uint32 seed)
+    {
+        if (bits == 0)
+            return 0;
+
+        // Each bit of a scrambled value only depends on itself and on the bits above it:
+        // move the value to the high bits such that its scrambling ignores the bits below.
+        const uint32 shift = 32 - bits;
+        return owen_scramble_uint32(x << shift, seed) >> shift;
+    }
+}
+
+
 //
 // PixelRendererBase class implementation.
 //
@@ -99,4 +146,58 @@ void PixelRendererBase::signal_invalid_sample()
     ++m_invalid_sample_count;
 }
 
+size_t PixelRendererBase::compute_pixel_instance(
+    const Frame&                frame,
+    const size_t                pass_hash,
+    const Vector2i&             pi,
+    const SamplingContext::Mode sampling_mode,
+    const size_t                max_sample_count)
+{
+    const CanvasProperties& props = frame.image().properties();
+    const size_t pixel_index = pi.y * props.m_canvas_width + pi.x;
+
+    if (sampling_mode == SamplingContext::SobolMode ||
+        sampling_mode == SamplingContext::BlueNoiseSobolMode)
+    {
+        // Owen-scrambled Sobol points are only stratified over blocks of consecutive
+        // sample numbers aligned on powers of two. Give each pixel such a block, within
+        // the 2^32 sample numbers of the sequence.
+        const uint64 block_size = next_pow2<uint64>(max<uint64>(max_sample_count, 1));
+        assert(block_size <= (uint64(1) << 32));
+        const uint64 block_count = (uint64(1) << 32) / block_size;
+
+        if (sampling_mode == SamplingContext::BlueNoiseSobolMode)
+        {
+            // Give each pixel a block of sample numbers following a randomly scrambled
+            // Z-order curve. Neighboring pixels then receive samples from the same
+            // stratified blocks of the sequence, which distributes the error as blue noise.
+            //
+            // Reference:
+            //
+            //   Ahmed and Wonka, Screen-Space Blue-Noise Diffusion of Monte Carlo Sampling Error
+            //   via Hierarchical Ordering of Pixels
+            //   https://doi.org/10.1145/3414685.3417881
+            //
+            const uint64 frame_size =
+                next_pow2<uint64>(max<uint64>(props.m_canvas_width, props.m_canvas_height));
+            const uint32 morton_bits = 2 * static_cast<uint32>(log2_int(frame_size));
+
+            // When the blocks of all pixels don't fit in the sequence, fall back to
+            // randomly placed blocks as in Sobol mode.
+            if ((uint64(1) << morton_bits) <= block_count)
+            {
+                const uint64 block = scramble_low_bits(morton_code(pi), morton_bits, static_cast<uint32>(pass_hash));
+                return static_cast<size_t>(block * block_size);
+            }
+        }
+
+        // Decorrelate pixels by hashing their index.
+        const uint64 block = hash_uint32(static_cast<uint32>(pass_hash + pixel_index)) % block_count;
+        return static_cast<size_t>(block * block_size);
+    }
+
+    // Decorrelate pixels by hashing their index.
+    return hash_uint32(static_cast<uint32>(pass_hash + pixel_index));
+}
+
 }   // namespace renderer
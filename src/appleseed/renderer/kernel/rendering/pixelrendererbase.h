@@ -31,6 +31,7 @@
 #define APPLESEED_RENDERER_KERNEL_RENDERING_PIXELRENDERERBASE_H
 
 // appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
 #include "renderer/kernel/rendering/ipixelrenderer.h"
 
 // appleseed.foundation headers.
@@ -77,6 +78,14 @@ class PixelRendererBase
 
     void signal_invalid_sample();
 
+    // Return the initial instance number of the sampling context of a given pixel.
+    static size_t compute_pixel_instance(
+        const Frame&                frame,
+        const size_t                pass_hash,
+        const foundation::Vector2i& pi,
+        const SamplingContext::Mode sampling_mode,
+        const size_t                max_sample_count);
+
   private:
     size_t                          m_invalid_sample_count;
     size_t                          m_invalid_pixel_count;
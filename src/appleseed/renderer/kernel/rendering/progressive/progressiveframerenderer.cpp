@@ -32,6 +32,7 @@
 
 // appleseed.renderer headers.
 #include "renderer/global/globallogger.h"
+#include "renderer/kernel/rendering/checkpoint.h"
 #include "renderer/kernel/rendering/iframerenderer.h"
 #include "renderer/kernel/rendering/isamplegenerator.h"
 #include "renderer/kernel/rendering/itilecallback.h"
@@ -57,6 +58,7 @@
 #include "foundation/platform/timers.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/api/apistring.h"
+#include "foundation/utility/bufferedfile.h"
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/foreach.h"
 #include "foundation/utility/gnuplotfile.h"
@@ -70,6 +72,7 @@
 #include "boost/filesystem.hpp"
 
 // Standard headers.
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -87,6 +90,8 @@ namespace renderer
 
 namespace
 {
+    const char* CheckpointKind = "progressive";
+
     //
     // Progressive frame renderer.
     //
@@ -106,6 +111,7 @@ namespace
           , m_params(params)
           , m_sample_counter(m_params.m_max_sample_count)
           , m_ref_image_avg_lum(0.0)
+          , m_resumed(false)
         {
             // We must have a generator factory, but it's OK not to have a callback factory.
             assert(generator_factory);
@@ -190,10 +196,12 @@ namespace
 
         virtual ~ProgressiveFrameRenderer()
         {
-            // Stop the statistics thread.
+            // Stop the statistics and checkpoint threads.
             m_abort_switch.abort();
             if (m_statistics_thread.get() && m_statistics_thread->joinable())
                 m_statistics_thread->join();
+            if (m_checkpoint_thread.get() && m_checkpoint_thread->joinable())
+                m_checkpoint_thread->join();
 
             // Stop the display thread.
             m_display_thread_abort_switch.abort();
@@ -242,6 +250,15 @@ namespace
             for (size_t i = 0, e = m_sample_generators.size(); i < e; ++i)
                 m_sample_generators[i]->reset();
 
+            // Restore the accumulation buffer from the checkpoint file if resuming.
+            if (m_params.m_checkpoint_params.is_enabled() &&
+                m_params.m_checkpoint_params.m_resume &&
+                !m_resumed)
+            {
+                m_resumed = true;
+                restore_checkpoint();
+            }
+
             // Schedule rendering jobs.
             for (size_t i = 0, e = m_sample_generator_jobs.size(); i < e; ++i)
             {
@@ -267,6 +284,19 @@ namespace
                 new boost::thread(
                     ThreadFunctionWrapper<StatisticsFunc>(m_statistics_func.get())));
 
+            // Create and start the checkpoint thread.
+            if (m_params.m_checkpoint_params.is_enabled())
+            {
+                m_checkpoint_func.reset(
+                    new CheckpointFunc(
+                        *this,
+                        m_params.m_checkpoint_params.m_interval,
+                        m_abort_switch));
+                m_checkpoint_thread.reset(
+                    new boost::thread(
+                        ThreadFunctionWrapper<CheckpointFunc>(m_checkpoint_func.get())));
+            }
+
             // Create and start the display thread.
             if (m_tile_callback.get() != 0 && m_display_thread.get() == 0)
             {
@@ -300,6 +330,10 @@ namespace
 
             // Wait until the statistics thread has stopped.
             m_statistics_thread->join();
+
+            // Wait until the checkpoint thread has stopped.
+            if (m_checkpoint_thread.get())
+                m_checkpoint_thread->join();
         }
 
         virtual void pause_rendering() override
@@ -310,10 +344,16 @@ namespace
                 m_display_func->pause();
 
             m_statistics_func->pause();
+
+            if (m_checkpoint_func.get())
+                m_checkpoint_func->pause();
         }
 
         virtual void resume_rendering() override
         {
+            if (m_checkpoint_func.get())
+                m_checkpoint_func->resume();
+
             m_statistics_func->resume();
 
             if (m_display_func.get())
@@ -332,6 +372,14 @@ namespace
             m_statistics_thread.reset();
             m_statistics_func.reset();
 
+            // The checkpoint thread has already been joined in stop_rendering().
+            m_checkpoint_thread.reset();
+            m_checkpoint_func.reset();
+
+            // Save the final state of the render, including when it was aborted.
+            if (m_params.m_checkpoint_params.is_enabled())
+                save_checkpoint();
+
             // Join and delete the display thread.
             if (m_display_thread.get())
             {
@@ -374,6 +422,7 @@ namespace
             const bool              m_perf_stats;           // collect and print performance statistics?
             const bool              m_luminance_stats;      // collect and print luminance statistics?
             const string            m_ref_image_path;       // path to the reference image
+            const CheckpointParameters m_checkpoint_params;
 
             explicit Parameters(const ParamArray& params)
               : m_spectrum_mode(get_spectrum_mode(params))
@@ -383,6 +432,7 @@ namespace
               , m_perf_stats(params.get_optional<bool>("performance_statistics", false))
               , m_luminance_stats(params.get_optional<bool>("luminance_statistics", false))
               , m_ref_image_path(params.get_optional<string>("reference_image", ""))
+              , m_checkpoint_params(params)
             {
             }
         };
@@ -678,6 +728,62 @@ namespace
             }
         };
 
+        //
+        // Checkpoint writing thread.
+        //
+
+        class CheckpointFunc
+          : public NonCopyable
+        {
+          public:
+            CheckpointFunc(
+                ProgressiveFrameRenderer&   renderer,
+                const double                interval,
+                IAbortSwitch&               abort_switch)
+              : m_renderer(renderer)
+              , m_interval(interval)
+              , m_abort_switch(abort_switch)
+              , m_stopwatch(0)
+            {
+            }
+
+            void pause()
+            {
+                m_pause_flag.set();
+            }
+
+            void resume()
+            {
+                m_pause_flag.clear();
+            }
+
+            void operator()()
+            {
+                set_current_thread_name("checkpoint");
+
+                m_stopwatch.start();
+
+                while (!m_abort_switch.is_aborted())
+                {
+                    if (m_pause_flag.is_clear() &&
+                        m_stopwatch.measure().get_seconds() >= m_interval)
+                    {
+                        m_renderer.save_checkpoint();
+                        m_stopwatch.start();
+                    }
+
+                    sleep(1000, m_abort_switch);
+                }
+            }
+
+          private:
+            ProgressiveFrameRenderer&           m_renderer;
+            const double                        m_interval;
+            IAbortSwitch&                       m_abort_switch;
+            ThreadFlag                          m_pause_flag;
+            Stopwatch<DefaultWallclockTimer>    m_stopwatch;
+        };
+
         //
         // Progressive frame renderer implementation details.
         //
@@ -710,6 +816,86 @@ namespace
         auto_ptr<StatisticsFunc>            m_statistics_func;
         auto_ptr<boost::thread>             m_statistics_thread;
 
+        auto_ptr<CheckpointFunc>            m_checkpoint_func;
+        auto_ptr<boost::thread>             m_checkpoint_thread;
+        bool                                m_resumed;
+
+        // The accumulation buffer is written before the sequence bound, so that
+        // all the samples of the checkpoint lie below the bound.
+        void save_checkpoint()
+        {
+            const char* path = m_params.m_checkpoint_params.m_path.c_str();
+
+            CheckpointFileWriter writer(path, CheckpointKind);
+            if (!writer.is_open())
+                return;
+
+            BufferedFile& file = writer.file();
+
+            bool success = m_buffer->write_checkpoint(file);
+
+            if (success)
+            {
+                size_t bound = 0;
+                for (size_t i = 0, e = m_sample_generators.size(); i < e; ++i)
+                    bound = max(bound, m_sample_generators[i]->get_sequence_bound());
+
+                const uint64 bound64 = static_cast<uint64>(bound);
+                success = file.write(bound64) == sizeof(bound64);
+            }
+
+            if (!success)
+                writer.set_failed();
+
+            if (writer.commit())
+            {
+                RENDERER_LOG_INFO(
+                    "wrote checkpoint file %s (%s samples).",
+                    path,
+                    pretty_uint(m_buffer->get_sample_count()).c_str());
+            }
+        }
+
+        void restore_checkpoint()
+        {
+            const char* path = m_params.m_checkpoint_params.m_path.c_str();
+
+            CheckpointFileReader reader(path, CheckpointKind);
+            if (!reader.is_open())
+            {
+                RENDERER_LOG_WARNING(
+                    "could not resume from checkpoint file %s, rendering from scratch.",
+                    path);
+                return;
+            }
+
+            BufferedFile& file = reader.file();
+
+            uint64 bound;
+            if (!m_buffer->read_checkpoint(file) ||
+                file.read(bound) != sizeof(bound))
+            {
+                RENDERER_LOG_WARNING(
+                    "checkpoint file %s does not match the frame, rendering from scratch.",
+                    path);
+                m_buffer->clear();
+                return;
+            }
+
+            // Never render again the samples already present in the buffer.
+            for (size_t i = 0, e = m_sample_generators.size(); i < e; ++i)
+                m_sample_generators[i]->skip_sequence(static_cast<size_t>(bound));
+
+            // Samples of the checkpoint count toward the maximum number of samples.
+            const uint64 sample_count = m_buffer->get_sample_count();
+            m_sample_counter.reserve(sample_count);
+
+            RENDERER_LOG_INFO(
+                "resuming render from checkpoint file %s (%s samples).",
+                path,
+                pretty_uint(sample_count).c_str());
+        }
+
         void print_sample_generators_stats() const
         {
             assert(!m_sample_generators.empty());
@@ -789,6 +975,8 @@ Dictionary ProgressiveFrameRendererFactory::get_params_metadata()
             .insert("label", "Max Samples")
             .insert("help", "Maximum number of samples per pixel"));
 
+    metadata.merge(CheckpointParameters::get_params_metadata());
+
     return metadata;
 }
 
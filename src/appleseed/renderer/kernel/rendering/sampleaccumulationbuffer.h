@@ -39,6 +39,7 @@
 #include <cstddef>
 
 // Forward declarations.
+namespace foundation    { class BufferedFile; }
 namespace foundation    { class IAbortSwitch; }
 namespace renderer      { class Frame; }
 namespace renderer      { class Sample; }
@@ -70,6 +71,14 @@ class SampleAccumulationBuffer
         Frame&                      frame,
         foundation::IAbortSwitch&   abort_switch) = 0;
 
+    // Write the content of the buffer to a checkpoint file. Thread-safe.
+    // Return true if successful, false otherwise.
+    virtual bool write_checkpoint(foundation::BufferedFile& file) = 0;
+
+    // Restore the content of the buffer from a checkpoint file. Thread-safe.
+    // Return true if successful, false otherwise, in which case the buffer must be cleared.
+    virtual bool read_checkpoint(foundation::BufferedFile& file) = 0;
+
   protected:
     boost::atomic<foundation::uint64> m_sample_count;
 };
@@ -35,6 +35,7 @@
 #include "renderer/kernel/rendering/sampleaccumulationbuffer.h"
 
 // appleseed.foundation headers.
+#include "foundation/math/scalar.h"
 #include "foundation/utility/job.h"
 #include "foundation/utility/memory.h"
 
@@ -66,10 +67,26 @@ SampleGeneratorBase::SampleGeneratorBase(
 void SampleGeneratorBase::reset()
 {
     m_sequence_index = m_generator_index * SampleBatchSize;
+    m_sequence_bound = 0;
     m_current_batch_size = 0;
     m_invalid_sample_count = 0;
 }
 
+size_t SampleGeneratorBase::get_sequence_bound() const
+{
+    return m_sequence_bound;
+}
+
+void SampleGeneratorBase::skip_sequence(const size_t bound)
+{
+    // Generators interleave batches of SampleBatchSize sequence indices. Restart from
+    // this generator's batch in the first round of batches that begins at or past the bound.
+    const size_t round_size = m_stride + SampleBatchSize;
+    m_sequence_index = next_multiple(bound, round_size) + m_generator_index * SampleBatchSize;
+    m_sequence_bound = m_sequence_index;
+    m_current_batch_size = 0;
+}
+
 void SampleGeneratorBase::generate_samples(
     const size_t                sample_count,
     SampleAccumulationBuffer&   buffer,
@@ -97,6 +114,10 @@ void SampleGeneratorBase::generate_samples(
         }
     }
 
+    // Publish the bound before storing the samples: a checkpoint that contains
+    // these samples is then guaranteed to record a bound that covers them.
+    m_sequence_bound = m_sequence_index;
+
     if (stored > 0)
         buffer.store_samples(stored, &m_samples[0], abort_switch);
 }
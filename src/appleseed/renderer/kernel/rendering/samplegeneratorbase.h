@@ -35,6 +35,7 @@
 #include "renderer/kernel/rendering/sample.h"
 
 // appleseed.foundation headers.
+#include "foundation/platform/atomic.h"
 #include "foundation/platform/types.h"
 
 // Standard headers.
@@ -69,6 +70,12 @@ class SampleGeneratorBase
         SampleAccumulationBuffer&   buffer,
         foundation::IAbortSwitch&   abort_switch);
 
+    // Return a bound on the sequence indices used so far. Thread-safe.
+    virtual size_t get_sequence_bound() const;
+
+    // Continue sample generation past a given sequence index bound.
+    virtual void skip_sequence(const size_t bound);
+
   protected:
     typedef std::vector<Sample> SampleVector;
 
@@ -84,6 +91,7 @@ class SampleGeneratorBase
     const size_t                    m_generator_index;
     const size_t                    m_stride;
     size_t                          m_sequence_index;
+    boost::atomic<size_t>           m_sequence_bound;
     size_t                          m_current_batch_size;
     SampleVector                    m_samples;
     foundation::uint64              m_invalid_sample_count;
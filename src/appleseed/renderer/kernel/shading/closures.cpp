@@ -718,6 +718,7 @@ namespace
             values->m_highlight_falloff = saturate(p->highlight_falloff);
             values->m_anisotropy = clamp(p->anisotropy, -1.0f, 1.0f);
             values->m_ior = max(p->ior, 0.001f);
+            values->m_energy_compensation = 0.0f;
         }
     };
 
@@ -842,6 +843,7 @@ namespace
             values->m_roughness = max(p->roughness, 0.0f);
             values->m_highlight_falloff = saturate(p->highlight_falloff);
             values->m_anisotropy = clamp(p->anisotropy, -1.0f, 1.0f);
+            values->m_energy_compensation = 0.0f;
         }
     };
 
@@ -1031,6 +1033,7 @@ namespace
             values->m_roughness = 0.0f;
             values->m_anisotropy = 0.0f;
             values->m_ior = max(p->ior, 0.001f);
+            values->m_energy_compensation = 0.0f;
         }
     };
 
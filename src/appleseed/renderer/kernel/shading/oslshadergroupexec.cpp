@@ -54,6 +54,7 @@ OSLShaderGroupExec::OSLShaderGroupExec(OSLShadingSystem& shading_system, Arena&
   , m_arena(arena)
   , m_osl_thread_info(shading_system.create_thread_info())
   , m_osl_shading_context(shading_system.get_context(m_osl_thread_info))
+  , m_execution_id(0)
 {
 }
 
@@ -176,6 +177,9 @@ Color3f OSLShaderGroupExec::execute_background(
     sg.renderer = m_osl_shading_system.renderer();
     sg.raytype = VisibilityFlags::CameraRay;
 
+    // The closures of the last shaded point are about to be overwritten.
+    ++m_execution_id;
+
     m_osl_shading_system.execute(
         m_osl_shading_context,
         *reinterpret_cast<OSL::ShaderGroup*>(shader_group.osl_shader_group()),
@@ -192,6 +196,13 @@ void OSLShaderGroupExec::do_execute(
     assert(m_osl_shading_context);
     assert(m_osl_thread_info);
 
+    // Closures live in the shading context's heap and remain valid until the next
+    // execution. If this shading point was the last one shaded by this context, with
+    // the same shader group and the same ray type, and it has not changed since, its
+    // closures are still up-to-date.
+    if (shading_point.has_osl_closures(shader_group, ray_flags, m_execution_id))
+        return;
+
     shading_point.initialize_osl_shader_globals(
         shader_group,
         ray_flags,
@@ -201,6 +212,8 @@ void OSLShaderGroupExec::do_execute(
         m_osl_shading_context,
         *reinterpret_cast<OSL::ShaderGroup*>(shader_group.osl_shader_group()),
         shading_point.get_osl_shader_globals());
+
+    shading_point.set_osl_closures(shader_group, ray_flags, ++m_execution_id);
 }
 
 void OSLShaderGroupExec::choose_bsdf_closure_shading_basis(
@@ -37,6 +37,7 @@
 #include "foundation/core/concepts/noncopyable.h"
 #include "foundation/image/color.h"
 #include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
 
 // OSL headers.
 #include "foundation/platform/_beginoslheaders.h"
@@ -77,6 +78,7 @@ class OSLShaderGroupExec
     char*                               m_osl_mem_pool;
     char*                               m_osl_mem_pool_start;
     mutable size_t                      m_osl_mem_used;
+    mutable foundation::uint64          m_execution_id;     // identifies the closures currently in the context's heap
 
     void execute_shading(
         const ShaderGroup&              shader_group,
@@ -147,6 +147,9 @@ void ShadingPoint::flip_side()
         m_shader_globals.backfacing = 1 - m_shader_globals.backfacing;
     }
 
+    // Closures computed for the other side are no longer valid.
+    m_members &= ~HasOSLClosures;
+
 #endif
 }
 
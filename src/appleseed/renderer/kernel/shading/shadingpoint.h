@@ -54,6 +54,7 @@
 #include "foundation/platform/compiler.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/poison.h"
+#include "foundation/utility/test.h"
 
 // OSL headers.
 #include "foundation/platform/_beginoslheaders.h"
@@ -72,6 +73,12 @@ namespace renderer  { class ShaderGroup; }
 namespace renderer  { class Scene; }
 namespace renderer  { class TextureCache; }
 
+DECLARE_TEST_CASE(Renderer_Kernel_Shading_ShadingPoint, HasOSLClosures_GivenRecordedExecution_ReturnsTrue);
+DECLARE_TEST_CASE(Renderer_Kernel_Shading_ShadingPoint, HasOSLClosures_GivenLaterExecution_ReturnsFalse);
+DECLARE_TEST_CASE(Renderer_Kernel_Shading_ShadingPoint, HasOSLClosures_GivenDifferentShaderGroupOrRayType_ReturnsFalse);
+DECLARE_TEST_CASE(Renderer_Kernel_Shading_ShadingPoint, HasOSLClosures_GivenClearedShadingPoint_ReturnsFalse);
+DECLARE_TEST_CASE(Renderer_Kernel_Shading_ShadingPoint, HasOSLClosures_GivenReassignedShadingPoint_ReturnsFalse);
+
 namespace renderer
 {
 
@@ -267,6 +274,12 @@ class ShadingPoint
     friend class TriangleLeafVisitor;
     friend class foundation::PoisonImpl<ShadingPoint>;
 
+    GRANT_ACCESS_TO_TEST_CASE(Renderer_Kernel_Shading_ShadingPoint, HasOSLClosures_GivenRecordedExecution_ReturnsTrue);
+    GRANT_ACCESS_TO_TEST_CASE(Renderer_Kernel_Shading_ShadingPoint, HasOSLClosures_GivenLaterExecution_ReturnsFalse);
+    GRANT_ACCESS_TO_TEST_CASE(Renderer_Kernel_Shading_ShadingPoint, HasOSLClosures_GivenDifferentShaderGroupOrRayType_ReturnsFalse);
+    GRANT_ACCESS_TO_TEST_CASE(Renderer_Kernel_Shading_ShadingPoint, HasOSLClosures_GivenClearedShadingPoint_ReturnsFalse);
+    GRANT_ACCESS_TO_TEST_CASE(Renderer_Kernel_Shading_ShadingPoint, HasOSLClosures_GivenReassignedShadingPoint_ReturnsFalse);
+
     // Context.
     RegionKitAccessCache*               m_region_kit_cache;
     StaticTriangleTessAccessCache*      m_tess_cache;
@@ -304,7 +317,8 @@ class ShadingPoint
         HasWorldSpacePointVelocity      = 1 << 13,
         HasAlpha                        = 1 << 14,
         HasScreenSpaceDerivatives       = 1 << 15,
-        HasOSLShaderGlobals             = 1 << 16
+        HasOSLShaderGlobals             = 1 << 16,
+        HasOSLClosures                  = 1 << 17
     };
     mutable foundation::uint32          m_members;
 
@@ -350,6 +364,9 @@ class ShadingPoint
     mutable OSLObjectTransformInfo      m_obj_transform_info;
     mutable OSLTraceData                m_osl_trace_data;
     mutable OSL::ShaderGlobals          m_shader_globals;
+    mutable const ShaderGroup*          m_osl_shader_group;             // shader group that produced the closures in m_shader_globals.Ci
+    mutable VisibilityFlags::Type       m_osl_ray_flags;                // ray type the closures in m_shader_globals.Ci were computed for
+    mutable foundation::uint64          m_osl_execution_id;             // shading context execution that produced the closures in m_shader_globals.Ci
 
     // Fetch and cache the source geometry.
     void cache_source_geometry() const;
@@ -382,6 +399,20 @@ class ShadingPoint
         const ShaderGroup&              sg,
         const VisibilityFlags::Type     ray_flags,
         OSL::RendererServices*          renderer) const;
+
+    // Record that the closures in m_shader_globals.Ci were produced by a given execution
+    // of a shader group. The record is dropped whenever the shading point changes.
+    void set_osl_closures(
+        const ShaderGroup&              sg,
+        const VisibilityFlags::Type     ray_flags,
+        const foundation::uint64        execution_id) const;
+
+    // Return true if the closures in m_shader_globals.Ci were produced by a given
+    // execution of a shader group for a given ray type.
+    bool has_osl_closures(
+        const ShaderGroup&              sg,
+        const VisibilityFlags::Type     ray_flags,
+        const foundation::uint64        execution_id) const;
 };
 
 
@@ -880,6 +911,29 @@ inline OSL::ShaderGlobals& ShadingPoint::get_osl_shader_globals() const
     return m_shader_globals;
 }
 
+inline void ShadingPoint::set_osl_closures(
+    const ShaderGroup&                  sg,
+    const VisibilityFlags::Type         ray_flags,
+    const foundation::uint64            execution_id) const
+{
+    m_osl_shader_group = &sg;
+    m_osl_ray_flags = ray_flags;
+    m_osl_execution_id = execution_id;
+    m_members |= HasOSLClosures;
+}
+
+inline bool ShadingPoint::has_osl_closures(
+    const ShaderGroup&                  sg,
+    const VisibilityFlags::Type         ray_flags,
+    const foundation::uint64            execution_id) const
+{
+    return
+        (m_members & HasOSLClosures) &&
+        m_osl_execution_id == execution_id &&
+        m_osl_shader_group == &sg &&
+        m_osl_ray_flags == ray_flags;
+}
+
 inline void ShadingPoint::cache_source_geometry() const
 {
     if (!(m_members & HasSourceGeometry))
@@ -30,6 +30,9 @@
 // Interface header.
 #include "shadingresult.h"
 
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+
 // appleseed.foundation headers.
 #include "foundation/platform/types.h"
 #include "foundation/utility/casts.h"
@@ -45,36 +48,40 @@ namespace renderer
 
 namespace
 {
-    inline bool is_valid_scalar(const float x)
+    inline bool is_valid_scalar(const float x, const bool allow_negative = false)
     {
         const uint32 ix = binary_cast<uint32>(x);
         const uint32 sign = (ix & 0x80000000L) >> 31;
         const uint32 exponent = (ix >> 23) & 255;
         const uint32 mantissa = ix & 0x007FFFFFL;
-        const bool is_neg = sign == 1 && ix != 0x80000000L;
+        const bool is_neg = !allow_negative && sign == 1 && ix != 0x80000000L;
         const bool is_nan = exponent == 255 && mantissa != 0;
         const bool is_inf = (ix & 0x7FFFFFFFL) == 0x7F800000UL;
         return !is_neg && !is_nan && !is_inf;
     }
 
-    inline bool is_valid_color(const Color4f& c)
+    inline bool is_valid_color(const Color4f& c, const bool allow_negative_rgb)
     {
         return
-            is_valid_scalar(c[0]) &&
-            is_valid_scalar(c[1]) &&
-            is_valid_scalar(c[2]) &&
+            is_valid_scalar(c[0], allow_negative_rgb) &&
+            is_valid_scalar(c[1], allow_negative_rgb) &&
+            is_valid_scalar(c[2], allow_negative_rgb) &&
             is_valid_scalar(c[3]);
     }
 }
 
 bool ShadingResult::is_valid() const
 {
-    if (!is_valid_color(m_main))
+    // In hero wavelength mode, a single sample is an unbiased estimate of the
+    // pixel color and may legitimately fall outside of the RGB gamut.
+    const bool allow_negative_rgb = Spectrum::get_mode() == Spectrum::HeroWavelength;
+
+    if (!is_valid_color(m_main, allow_negative_rgb))
         return false;
 
     for (size_t i = 0, e = m_aov_count; i < e; ++i)
     {
-        if (!is_valid_color(m_aovs[i]))
+        if (!is_valid_color(m_aovs[i], allow_negative_rgb))
             return false;
     }
 
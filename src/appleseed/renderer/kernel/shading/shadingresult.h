@@ -65,6 +65,7 @@ class ShadingResult
     explicit ShadingResult(const size_t aov_count = 0);
 
     // Return false if the main output of any of the AOV contains NaN, negative or infinite values.
+    // Negative RGB values are accepted in hero wavelength mode.
     bool is_valid() const;
 
     // Composite this shading result over `background`.
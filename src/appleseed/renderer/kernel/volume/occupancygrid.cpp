@@ -30,7 +30,17 @@
 // Interface header.
 #include "occupancygrid.h"
 
+// appleseed.renderer headers.
+#include "renderer/kernel/volume/sparsevoxelgrid.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/scalar.h"
+
+// Standard headers.
+#include <algorithm>
+
 using namespace foundation;
+using namespace std;
 
 namespace renderer
 {
@@ -48,6 +58,34 @@ OccupancyGrid::OccupancyGrid(
         voxel_grid.get_yres(),
         voxel_grid.get_zres(),
         1)
+  , m_majorants(
+        voxel_grid.get_xres(),
+        voxel_grid.get_yres(),
+        voxel_grid.get_zres(),
+        1)
+  , m_max_majorant(0.0f)
+{
+    initialize(
+        voxel_grid,
+        density_channel_index,
+        occupancy_threshold);
+}
+
+OccupancyGrid::OccupancyGrid(
+    const SparseVoxelGrid&  voxel_grid,
+    const size_t            density_channel_index,
+    const float             occupancy_threshold)
+  : m_grid(
+        voxel_grid.get_brick_xcount(),
+        voxel_grid.get_brick_ycount(),
+        voxel_grid.get_brick_zcount(),
+        1)
+  , m_majorants(
+        voxel_grid.get_brick_xcount(),
+        voxel_grid.get_brick_ycount(),
+        voxel_grid.get_brick_zcount(),
+        1)
+  , m_max_majorant(0.0f)
 {
     initialize(
         voxel_grid,
@@ -66,28 +104,106 @@ void OccupancyGrid::initialize(
         {
             for (size_t x = 0; x < m_grid.get_xres(); ++x)
             {
-                const float density_sum =
-                    get_density_sum(
-                        voxel_grid,
-                        density_channel_index,
-                        x,
-                        y,
-                        z);
+                float density_sum, density_max;
+                get_density_bounds(
+                    voxel_grid,
+                    density_channel_index,
+                    x,
+                    y,
+                    z,
+                    density_sum,
+                    density_max);
 
                 m_grid.voxel(x, y, z)[0] = density_sum > occupancy_threshold ? 1 : 0;
+                m_majorants.voxel(x, y, z)[0] = density_max;
+
+                if (m_max_majorant < density_max)
+                    m_max_majorant = density_max;
             }
         }
     }
 }
 
-float OccupancyGrid::get_density_sum(
+namespace
+{
+    // Compute the range of bricks, along one axis, holding the voxels that lookups
+    // inside a given cell of a grid of 'cell_count' cells may interpolate from.
+    void get_brick_range(
+        const size_t    cell,
+        const size_t    cell_count,
+        const size_t    voxel_count,
+        size_t&         brick_begin,
+        size_t&         brick_end)
+    {
+        const double scale = static_cast<double>(voxel_count - 1) / cell_count;
+
+        // Lookups interpolate between voxels floor(p * (n - 1)) and floor(p * (n - 1)) + 1;
+        // one more voxel on each side accounts for rounding errors during grid traversal.
+        const size_t voxel_begin = truncate<size_t>(cell * scale);
+        const size_t voxel_end = min(truncate<size_t>((cell + 1) * scale) + 2, voxel_count - 1);
+
+        brick_begin = (voxel_begin > 0 ? voxel_begin - 1 : 0) / SparseVoxelGrid::BrickSize;
+        brick_end = voxel_end / SparseVoxelGrid::BrickSize + 1;
+    }
+}
+
+void OccupancyGrid::initialize(
+    const SparseVoxelGrid&  voxel_grid,
+    const size_t            density_channel_index,
+    const float             occupancy_threshold)
+{
+    for (size_t z = 0; z < m_grid.get_zres(); ++z)
+    {
+        size_t bz_begin, bz_end;
+        get_brick_range(z, m_grid.get_zres(), voxel_grid.get_zres(), bz_begin, bz_end);
+
+        for (size_t y = 0; y < m_grid.get_yres(); ++y)
+        {
+            size_t by_begin, by_end;
+            get_brick_range(y, m_grid.get_yres(), voxel_grid.get_yres(), by_begin, by_end);
+
+            for (size_t x = 0; x < m_grid.get_xres(); ++x)
+            {
+                size_t bx_begin, bx_end;
+                get_brick_range(x, m_grid.get_xres(), voxel_grid.get_xres(), bx_begin, bx_end);
+
+                float density_max = 0.0f;
+
+                for (size_t bz = bz_begin; bz < bz_end; ++bz)
+                {
+                    for (size_t by = by_begin; by < by_end; ++by)
+                    {
+                        for (size_t bx = bx_begin; bx < bx_end; ++bx)
+                        {
+                            density_max =
+                                max(
+                                    density_max,
+                                    voxel_grid.get_brick_max(bx, by, bz, density_channel_index));
+                        }
+                    }
+                }
+
+                m_grid.voxel(x, y, z)[0] = density_max > occupancy_threshold ? 1 : 0;
+                m_majorants.voxel(x, y, z)[0] = density_max;
+
+                if (m_max_majorant < density_max)
+                    m_max_majorant = density_max;
+            }
+        }
+    }
+}
+
+void OccupancyGrid::get_density_bounds(
     const VoxelGrid&    voxel_grid,
     const size_t        density_channel_index,
     const size_t        x,
     const size_t        y,
-    const size_t        z) const
+    const size_t        z,
+    float&              density_sum,
+    float&              density_max) const
 {
-    float density_sum = 0.0f;
+    density_sum = 0.0f;
+    density_max = 0.0f;
 
     for (int dx = -1; dx <= +1; ++dx)
     {
@@ -111,11 +227,12 @@ float OccupancyGrid::get_density_sum(
                 assert(voxel[density_channel_index] >= 0.0f);
 
                 density_sum += voxel[density_channel_index];
+
+                if (density_max < voxel[density_channel_index])
+                    density_max = voxel[density_channel_index];
             }
         }
     }
-
-    return density_sum;
 }
 
 }   // namespace renderer
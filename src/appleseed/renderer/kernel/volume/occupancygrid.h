@@ -36,9 +36,24 @@
 // appleseed.foundation headers.
 #include "foundation/math/voxelgrid.h"
 
+// Forward declarations.
+namespace renderer  { class SparseVoxelGrid; }
+
 namespace renderer
 {
 
+//
+// A grid of the same resolution as a voxel grid that records which voxels contain fluid,
+// and an upper bound (majorant) of the density in each of them.
+//
+// Since the density is interpolated from the voxels of a 3x3x3 neighborhood, the majorant
+// of a voxel is the maximum density over its neighborhood. A voxel whose majorant is zero
+// is empty and can be skipped entirely when tracking rays through the grid.
+//
+// The occupancy grid of a sparse voxel grid has one voxel per brick and is built from the
+// brick summaries alone, such that no brick needs to be loaded.
+//
+
 class OccupancyGrid
   : public foundation::NonCopyable
 {
@@ -48,22 +63,49 @@ class OccupancyGrid
         const size_t        density_channel_index,
         const float         occupancy_threshold);
 
+    OccupancyGrid(
+        const SparseVoxelGrid&  voxel_grid,
+        const size_t            density_channel_index,
+        const float             occupancy_threshold);
+
+    size_t get_xres() const;
+    size_t get_yres() const;
+    size_t get_zres() const;
+
     bool has_fluid(const foundation::Vector3d& point) const;
 
+    // Return an upper bound of the density in a given voxel.
+    float get_majorant(
+        const size_t        x,
+        const size_t        y,
+        const size_t        z) const;
+
+    // Return an upper bound of the density in the entire grid.
+    float get_max_majorant() const;
+
   private:
     foundation::VoxelGrid3<unsigned char, double> m_grid;
+    foundation::VoxelGrid3<float, double>   m_majorants;
+    float                                   m_max_majorant;
 
     void initialize(
         const VoxelGrid&    voxel_grid,
         const size_t        density_channel_index,
         const float         occupancy_threshold);
 
-    float get_density_sum(
+    void get_density_bounds(
         const VoxelGrid&    voxel_grid,
         const size_t        density_channel_index,
         const size_t        x,
         const size_t        y,
-        const size_t        z) const;
+        const size_t        z,
+        float&              density_sum,
+        float&              density_max) const;
+
+    void initialize(
+        const SparseVoxelGrid&  voxel_grid,
+        const size_t            density_channel_index,
+        const float             occupancy_threshold);
 };
 
 
@@ -71,6 +113,21 @@ class OccupancyGrid
 // OccupancyGrid class implementation.
 //
 
+inline size_t OccupancyGrid::get_xres() const
+{
+    return m_grid.get_xres();
+}
+
+inline size_t OccupancyGrid::get_yres() const
+{
+    return m_grid.get_yres();
+}
+
+inline size_t OccupancyGrid::get_zres() const
+{
+    return m_grid.get_zres();
+}
+
 inline bool OccupancyGrid::has_fluid(const foundation::Vector3d& point) const
 {
     unsigned char result;
@@ -78,6 +135,19 @@ inline bool OccupancyGrid::has_fluid(const foundation::Vector3d& point) const
     return result == 1;
 }
 
+inline float OccupancyGrid::get_majorant(
+    const size_t        x,
+    const size_t        y,
+    const size_t        z) const
+{
+    return m_majorants.voxel(x, y, z)[0];
+}
+
+inline float OccupancyGrid::get_max_majorant() const
+{
+    return m_max_majorant;
+}
+
 }       // namespace renderer
 
 #endif  // !APPLESEED_RENDERER_KERNEL_VOLUME_OCCUPANCYGRID_H
@@ -0,0 +1,447 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "sparsevoxelgrid.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/scalar.h"
+#include "foundation/utility/statistics.h"
+
+// Standard headers.
+#include <algorithm>
+#include <limits>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+namespace
+{
+    // Largest quantized value.
+    const float MaxQuantizedValue = 65535.0f;
+}
+
+
+//
+// SparseVoxelGrid::BrickAccessor class implementation.
+//
+// Keeps the last brick it fetched a voxel from acquired, such that lookups touching
+// a single brick only need to lock the brick cache once.
+//
+
+class SparseVoxelGrid::BrickAccessor
+  : public NonCopyable
+{
+  public:
+    explicit BrickAccessor(const SparseVoxelGrid& grid)
+      : m_grid(grid)
+      , m_key(~size_t(0))
+      , m_record(nullptr)
+    {
+    }
+
+    ~BrickAccessor()
+    {
+        if (m_record)
+            m_grid.release(*m_record);
+    }
+
+    void fetch(
+        const size_t    x,
+        const size_t    y,
+        const size_t    z,
+        float*          values)
+    {
+        const size_t channel_count = m_grid.m_channel_count;
+        const size_t key =
+            m_grid.brick_index(
+                x / BrickSize,
+                y / BrickSize,
+                z / BrickSize);
+
+        const float* brick_min = &m_grid.m_brick_min[key * channel_count];
+
+        // Constant bricks are never loaded.
+        if (m_grid.m_brick_constant[key])
+        {
+            for (size_t i = 0; i < channel_count; ++i)
+                values[i] = brick_min[i];
+            return;
+        }
+
+        if (key != m_key)
+        {
+            if (m_record)
+                m_grid.release(*m_record);
+
+            m_record = &m_grid.acquire(key);
+            m_key = key;
+        }
+
+        const Brick& brick = *m_record->m_brick;
+        const float* brick_max = &m_grid.m_brick_max[key * channel_count];
+
+        const size_t index =
+            (((z % BrickSize) * BrickSize + (y % BrickSize)) * BrickSize + (x % BrickSize)) * channel_count;
+        const uint16* source = &brick.m_values[index];
+
+        for (size_t i = 0; i < channel_count; ++i)
+            values[i] = min(brick_min[i] + source[i] * brick.m_scales[i], brick_max[i]);
+    }
+
+  private:
+    const SparseVoxelGrid&  m_grid;
+    size_t                  m_key;
+    BrickRecord*            m_record;
+};
+
+
+//
+// SparseVoxelGrid class implementation.
+//
+
+SparseVoxelGrid::SparseVoxelGrid(
+    const size_t                    nx,
+    const size_t                    ny,
+    const size_t                    nz,
+    const size_t                    channel_count,
+    auto_ptr<IVoxelSource>          source,
+    const size_t                    max_cache_size)
+  : m_nx(nx)
+  , m_ny(ny)
+  , m_nz(nz)
+  , m_max_x(static_cast<double>(nx - 1))
+  , m_max_y(static_cast<double>(ny - 1))
+  , m_max_z(static_cast<double>(nz - 1))
+  , m_channel_count(channel_count)
+  , m_brick_nx((nx + BrickSize - 1) / BrickSize)
+  , m_brick_ny((ny + BrickSize - 1) / BrickSize)
+  , m_brick_nz((nz + BrickSize - 1) / BrickSize)
+  , m_source(source)
+  , m_constant_brick_count(0)
+  , m_brick_swapper(*this, max_cache_size)
+  , m_brick_cache(m_brick_key_hasher, m_brick_swapper)
+{
+    assert(m_nx > 0);
+    assert(m_ny > 0);
+    assert(m_nz > 0);
+    assert(m_channel_count > 0);
+    assert(m_channel_count <= MaxChannelCount);
+    assert(m_source.get());
+}
+
+SparseVoxelGrid::~SparseVoxelGrid()
+{
+    m_brick_cache.clear();
+}
+
+bool SparseVoxelGrid::initialize()
+{
+    const size_t brick_count = m_brick_nx * m_brick_ny * m_brick_nz;
+
+    m_brick_min.assign(brick_count * m_channel_count, 0.0f);
+    m_brick_max.assign(brick_count * m_channel_count, 0.0f);
+    m_brick_constant.assign(brick_count, 1);
+    m_constant_brick_count = 0;
+
+    // Scan the source one row of bricks at a time to bound memory usage.
+    vector<float> row(m_nx * BrickSize * BrickSize * m_channel_count);
+
+    for (size_t bz = 0; bz < m_brick_nz; ++bz)
+    {
+        const size_t z0 = bz * BrickSize;
+        const size_t z1 = min(z0 + BrickSize, m_nz);
+
+        for (size_t by = 0; by < m_brick_ny; ++by)
+        {
+            const size_t y0 = by * BrickSize;
+            const size_t y1 = min(y0 + BrickSize, m_ny);
+
+            if (!m_source->read_voxels(0, m_nx, y0, y1, z0, z1, &row[0]))
+                return false;
+
+            for (size_t bx = 0; bx < m_brick_nx; ++bx)
+            {
+                const size_t x0 = bx * BrickSize;
+                const size_t x1 = min(x0 + BrickSize, m_nx);
+
+                const size_t key = brick_index(bx, by, bz);
+                float* brick_min = &m_brick_min[key * m_channel_count];
+                float* brick_max = &m_brick_max[key * m_channel_count];
+
+                for (size_t c = 0; c < m_channel_count; ++c)
+                {
+                    brick_min[c] = +numeric_limits<float>::max();
+                    brick_max[c] = -numeric_limits<float>::max();
+                }
+
+                for (size_t z = z0; z < z1; ++z)
+                {
+                    for (size_t y = y0; y < y1; ++y)
+                    {
+                        const float* source =
+                            &row[(((z - z0) * (y1 - y0) + (y - y0)) * m_nx + x0) * m_channel_count];
+
+                        for (size_t x = x0; x < x1; ++x)
+                        {
+                            for (size_t c = 0; c < m_channel_count; ++c)
+                            {
+                                brick_min[c] = min(brick_min[c], *source);
+                                brick_max[c] = max(brick_max[c], *source);
+                                ++source;
+                            }
+                        }
+                    }
+                }
+
+                for (size_t c = 0; c < m_channel_count; ++c)
+                {
+                    if (brick_min[c] != brick_max[c])
+                        m_brick_constant[key] = 0;
+                }
+
+                if (m_brick_constant[key])
+                    ++m_constant_brick_count;
+            }
+        }
+    }
+
+    return true;
+}
+
+void SparseVoxelGrid::nearest_lookup(
+    const Vector3d&         point,
+    float*                  values) const
+{
+    // Compute the coordinates of the voxel containing the lookup point.
+    const double x = clamp(point.x * m_nx, 0.0, m_max_x);
+    const double y = clamp(point.y * m_ny, 0.0, m_max_y);
+    const double z = clamp(point.z * m_nz, 0.0, m_max_z);
+
+    BrickAccessor accessor(*this);
+    accessor.fetch(
+        truncate<size_t>(x),
+        truncate<size_t>(y),
+        truncate<size_t>(z),
+        values);
+}
+
+void SparseVoxelGrid::linear_lookup(
+    const Vector3d&         point,
+    float*                  values) const
+{
+    // Compute the coordinates of the voxel containing the lookup point.
+    const double x = saturate(point.x) * m_max_x;
+    const double y = saturate(point.y) * m_max_y;
+    const double z = saturate(point.z) * m_max_z;
+    const size_t ix0 = truncate<size_t>(x);
+    const size_t iy0 = truncate<size_t>(y);
+    const size_t iz0 = truncate<size_t>(z);
+    const size_t ix1 = min(ix0 + 1, m_nx - 1);
+    const size_t iy1 = min(iy0 + 1, m_ny - 1);
+    const size_t iz1 = min(iz0 + 1, m_nz - 1);
+
+    // Compute interpolation weights.
+    const float x1 = static_cast<float>(x - ix0);
+    const float y1 = static_cast<float>(y - iy0);
+    const float z1 = static_cast<float>(z - iz0);
+    const float x0 = 1.0f - x1;
+    const float y0 = 1.0f - y1;
+    const float z0 = 1.0f - z1;
+
+    const size_t ix[2] = { ix0, ix1 };
+    const size_t iy[2] = { iy0, iy1 };
+    const size_t iz[2] = { iz0, iz1 };
+    const float wx[2] = { x0, x1 };
+    const float wy[2] = { y0, y1 };
+    const float wz[2] = { z0, z1 };
+
+    for (size_t c = 0; c < m_channel_count; ++c)
+        values[c] = 0.0f;
+
+    // Accumulate the weighted values of the eight neighboring voxels.
+    BrickAccessor accessor(*this);
+    float voxel[MaxChannelCount];
+
+    for (size_t k = 0; k < 2; ++k)
+    {
+        for (size_t j = 0; j < 2; ++j)
+        {
+            for (size_t i = 0; i < 2; ++i)
+            {
+                const float w = wx[i] * wy[j] * wz[k];
+                if (w == 0.0f)
+                    continue;
+
+                accessor.fetch(ix[i], iy[j], iz[k], voxel);
+
+                for (size_t c = 0; c < m_channel_count; ++c)
+                    values[c] += w * voxel[c];
+            }
+        }
+    }
+}
+
+StatisticsVector SparseVoxelGrid::get_statistics() const
+{
+    const size_t brick_count = m_brick_nx * m_brick_ny * m_brick_nz;
+
+    Statistics stats = make_single_stage_cache_stats(m_brick_cache);
+    stats.insert("bricks", brick_count);
+    stats.insert_percent("constant bricks", m_constant_brick_count, brick_count);
+    stats.insert_size("peak size", m_brick_swapper.get_peak_memory_size());
+
+    return StatisticsVector::make("sparse voxel grid statistics", stats);
+}
+
+
+//
+// SparseVoxelGrid::BrickSwapper class implementation.
+//
+
+SparseVoxelGrid::BrickSwapper::BrickSwapper(
+    SparseVoxelGrid&        grid,
+    const size_t            max_cache_size)
+  : m_grid(grid)
+  , m_max_cache_size(max_cache_size)
+  , m_memory_size(0)
+  , m_peak_memory_size(0)
+{
+}
+
+void SparseVoxelGrid::BrickSwapper::load(const size_t key, BrickRecord& record)
+{
+    const size_t channel_count = m_grid.m_channel_count;
+
+    const size_t bx = key % m_grid.m_brick_nx;
+    const size_t by = (key / m_grid.m_brick_nx) % m_grid.m_brick_ny;
+    const size_t bz = key / (m_grid.m_brick_nx * m_grid.m_brick_ny);
+
+    const size_t x0 = bx * BrickSize;
+    const size_t y0 = by * BrickSize;
+    const size_t z0 = bz * BrickSize;
+    const size_t x1 = min(x0 + BrickSize, m_grid.m_nx);
+    const size_t y1 = min(y0 + BrickSize, m_grid.m_ny);
+    const size_t z1 = min(z0 + BrickSize, m_grid.m_nz);
+
+    const float* brick_min = &m_grid.m_brick_min[key * channel_count];
+    const float* brick_max = &m_grid.m_brick_max[key * channel_count];
+
+    // Read the voxels of the brick.
+    m_buffer.resize((x1 - x0) * (y1 - y0) * (z1 - z0) * channel_count);
+    if (!m_grid.m_source->read_voxels(x0, x1, y0, y1, z0, z1, &m_buffer[0]))
+    {
+        RENDERER_LOG_ERROR(
+            "failed to read voxel brick (" FMT_SIZE_T ", " FMT_SIZE_T ", " FMT_SIZE_T ").",
+            bx, by, bz);
+        fill(m_buffer.begin(), m_buffer.end(), 0.0f);
+    }
+
+    // Quantize the voxels relatively to the range of values of the brick.
+    Brick* brick = new Brick();
+    brick->m_values.assign(BrickSize * BrickSize * BrickSize * channel_count, 0);
+    brick->m_scales.resize(channel_count);
+
+    float rcp_scales[MaxChannelCount];
+    for (size_t c = 0; c < channel_count; ++c)
+    {
+        const float range = brick_max[c] - brick_min[c];
+        brick->m_scales[c] = range / MaxQuantizedValue;
+        rcp_scales[c] = range > 0.0f ? MaxQuantizedValue / range : 0.0f;
+    }
+
+    const float* source = &m_buffer[0];
+    for (size_t z = z0; z < z1; ++z)
+    {
+        for (size_t y = y0; y < y1; ++y)
+        {
+            for (size_t x = x0; x < x1; ++x)
+            {
+                uint16* dest =
+                    &brick->m_values[(((z - z0) * BrickSize + (y - y0)) * BrickSize + (x - x0)) * channel_count];
+
+                for (size_t c = 0; c < channel_count; ++c)
+                {
+                    const float q = clamp((*source++ - brick_min[c]) * rcp_scales[c], 0.0f, MaxQuantizedValue);
+                    dest[c] = static_cast<uint16>(q + 0.5f);
+                }
+            }
+        }
+    }
+
+    record.m_brick = brick;
+    record.m_owners = 0;
+
+    // Track the amount of memory used by the brick cache.
+    m_memory_size +=
+          sizeof(Brick)
+        + brick->m_values.size() * sizeof(uint16)
+        + brick->m_scales.size() * sizeof(float);
+    m_peak_memory_size = max(m_peak_memory_size, m_memory_size);
+}
+
+bool SparseVoxelGrid::BrickSwapper::unload(const size_t key, BrickRecord& record)
+{
+    // Cannot unload bricks that are still in use.
+    if (atomic_read(&record.m_owners) > 0)
+        return false;
+
+    // Track the amount of memory used by the brick cache.
+    const size_t brick_memory_size =
+          sizeof(Brick)
+        + record.m_brick->m_values.size() * sizeof(uint16)
+        + record.m_brick->m_scales.size() * sizeof(float);
+    assert(m_memory_size >= brick_memory_size);
+    m_memory_size -= brick_memory_size;
+
+    // Unload the brick.
+    delete record.m_brick;
+    record.m_brick = nullptr;
+
+    // Successfully unloaded the brick.
+    return true;
+}
+
+bool SparseVoxelGrid::BrickSwapper::is_full(const size_t element_count) const
+{
+    return m_memory_size >= m_max_cache_size;
+}
+
+size_t SparseVoxelGrid::BrickSwapper::get_peak_memory_size() const
+{
+    return m_peak_memory_size;
+}
+
+}   // namespace renderer
@@ -0,0 +1,348 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_RENDERER_KERNEL_VOLUME_SPARSEVOXELGRID_H
+#define APPLESEED_RENDERER_KERNEL_VOLUME_SPARSEVOXELGRID_H
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/math/vector.h"
+#include "foundation/platform/atomic.h"
+#include "foundation/platform/thread.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/cache.h"
+
+// Standard headers.
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Forward declarations.
+namespace foundation    { class StatisticsVector; }
+
+namespace renderer
+{
+
+//
+// A source of voxels, from which a sparse voxel grid pages in its bricks.
+//
+
+class IVoxelSource
+  : public foundation::NonCopyable
+{
+  public:
+    // Destructor.
+    virtual ~IVoxelSource() {}
+
+    // Read the voxels of the box [x0, x1) x [y0, y1) x [z0, z1). Voxels are stored in
+    // 'values' with their channels interleaved and with x varying fastest, then y, then z.
+    // This method is never called concurrently. Return true on success, false on error.
+    virtual bool read_voxels(
+        const size_t        x0,
+        const size_t        x1,
+        const size_t        y0,
+        const size_t        y1,
+        const size_t        z0,
+        const size_t        z1,
+        float*              values) = 0;
+};
+
+
+//
+// A voxel grid split into cubic bricks of BrickSize^3 voxels that are loaded on demand.
+//
+// When the grid is initialized, the source is scanned once, one row of bricks at a time,
+// to compute the range of values of each brick. Bricks whose voxels are all identical
+// (empty space in particular) are entirely described by this summary and are never loaded.
+// Other bricks are paged in from the source when a lookup touches them, compressed to
+// 16 bits per value relative to their range, and kept in a bounded LRU brick cache.
+//
+// Lookups follow the conventions of foundation::VoxelGrid3 and are thread-safe.
+//
+
+class SparseVoxelGrid
+  : public foundation::NonCopyable
+{
+  public:
+    // Size of a brick along each axis, in voxels.
+    static const size_t BrickSize = 8;
+
+    // Maximum number of channels per voxel.
+    static const size_t MaxChannelCount = 16;
+
+    // Constructor.
+    SparseVoxelGrid(
+        const size_t                    nx,
+        const size_t                    ny,
+        const size_t                    nz,
+        const size_t                    channel_count,
+        std::auto_ptr<IVoxelSource>     source,
+        const size_t                    max_cache_size);
+
+    // Destructor.
+    ~SparseVoxelGrid();
+
+    // Compute the summaries of all bricks. Must be called once before any lookup.
+    // Return true on success, false if the source could not be read.
+    bool initialize();
+
+    // Get the grid properties.
+    size_t get_xres() const;
+    size_t get_yres() const;
+    size_t get_zres() const;
+    size_t get_channel_count() const;
+
+    // Get the number of bricks along each axis.
+    size_t get_brick_xcount() const;
+    size_t get_brick_ycount() const;
+    size_t get_brick_zcount() const;
+
+    // Return true if all voxels of a given brick share the same values.
+    bool is_constant_brick(
+        const size_t        bx,
+        const size_t        by,
+        const size_t        bz) const;
+
+    // Return the range of values of a given channel in a given brick.
+    float get_brick_min(
+        const size_t        bx,
+        const size_t        by,
+        const size_t        bz,
+        const size_t        channel) const;
+    float get_brick_max(
+        const size_t        bx,
+        const size_t        by,
+        const size_t        bz,
+        const size_t        channel) const;
+
+    // Perform an unfiltered lookup of the voxel grid.
+    // 'point' must be expressed in the unit cube [0,1]^3.
+    void nearest_lookup(
+        const foundation::Vector3d& point,
+        float*                      values) const;
+
+    // Perform a trilinearly interpolated lookup of the voxel grid.
+    // 'point' must be expressed in the unit cube [0,1]^3.
+    void linear_lookup(
+        const foundation::Vector3d& point,
+        float*                      values) const;
+
+    // Retrieve performance statistics.
+    foundation::StatisticsVector get_statistics() const;
+
+  private:
+    class BrickAccessor;
+
+    struct Brick
+    {
+        std::vector<foundation::uint16> m_values;
+        std::vector<float>              m_scales;
+    };
+
+    struct BrickRecord
+    {
+        Brick*                          m_brick;
+        volatile foundation::uint32     m_owners;
+    };
+
+    struct BrickKeyHasher
+    {
+        size_t operator()(const size_t key) const;
+    };
+
+    class BrickSwapper
+      : public foundation::NonCopyable
+    {
+      public:
+        // Constructor.
+        BrickSwapper(
+            SparseVoxelGrid&    grid,
+            const size_t        max_cache_size);
+
+        // Load a cache line.
+        void load(const size_t key, BrickRecord& record);
+
+        // Unload a cache line.
+        bool unload(const size_t key, BrickRecord& record);
+
+        // Return true if the cache is full, false otherwise.
+        bool is_full(const size_t element_count) const;
+
+        // Return the peak memory size in bytes of the brick cache.
+        size_t get_peak_memory_size() const;
+
+      private:
+        SparseVoxelGrid&    m_grid;
+        const size_t        m_max_cache_size;
+        size_t              m_memory_size;
+        size_t              m_peak_memory_size;
+        std::vector<float>  m_buffer;
+    };
+
+    typedef foundation::LRUCache<
+        size_t,
+        BrickKeyHasher,
+        BrickRecord,
+        BrickSwapper
+    > BrickCache;
+
+    const size_t                        m_nx;
+    const size_t                        m_ny;
+    const size_t                        m_nz;
+    const double                        m_max_x;
+    const double                        m_max_y;
+    const double                        m_max_z;
+    const size_t                        m_channel_count;
+    const size_t                        m_brick_nx;
+    const size_t                        m_brick_ny;
+    const size_t                        m_brick_nz;
+    std::auto_ptr<IVoxelSource>         m_source;
+    std::vector<float>                  m_brick_min;        // per brick, per channel
+    std::vector<float>                  m_brick_max;        // per brick, per channel
+    std::vector<foundation::uint8>      m_brick_constant;   // per brick
+    size_t                              m_constant_brick_count;
+
+    mutable boost::mutex                m_mutex;
+    mutable BrickKeyHasher              m_brick_key_hasher;
+    mutable BrickSwapper                m_brick_swapper;
+    mutable BrickCache                  m_brick_cache;
+
+    size_t brick_index(
+        const size_t        bx,
+        const size_t        by,
+        const size_t        bz) const;
+
+    BrickRecord& acquire(const size_t key) const;
+    void release(BrickRecord& record) const;
+};
+
+
+//
+// SparseVoxelGrid class implementation.
+//
+
+inline size_t SparseVoxelGrid::get_xres() const
+{
+    return m_nx;
+}
+
+inline size_t SparseVoxelGrid::get_yres() const
+{
+    return m_ny;
+}
+
+inline size_t SparseVoxelGrid::get_zres() const
+{
+    return m_nz;
+}
+
+inline size_t SparseVoxelGrid::get_channel_count() const
+{
+    return m_channel_count;
+}
+
+inline size_t SparseVoxelGrid::get_brick_xcount() const
+{
+    return m_brick_nx;
+}
+
+inline size_t SparseVoxelGrid::get_brick_ycount() const
+{
+    return m_brick_ny;
+}
+
+inline size_t SparseVoxelGrid::get_brick_zcount() const
+{
+    return m_brick_nz;
+}
+
+inline size_t SparseVoxelGrid::brick_index(
+    const size_t            bx,
+    const size_t            by,
+    const size_t            bz) const
+{
+    assert(bx < m_brick_nx);
+    assert(by < m_brick_ny);
+    assert(bz < m_brick_nz);
+    return (bz * m_brick_ny + by) * m_brick_nx + bx;
+}
+
+inline bool SparseVoxelGrid::is_constant_brick(
+    const size_t            bx,
+    const size_t            by,
+    const size_t            bz) const
+{
+    return m_brick_constant[brick_index(bx, by, bz)] != 0;
+}
+
+inline float SparseVoxelGrid::get_brick_min(
+    const size_t            bx,
+    const size_t            by,
+    const size_t            bz,
+    const size_t            channel) const
+{
+    assert(channel < m_channel_count);
+    return m_brick_min[brick_index(bx, by, bz) * m_channel_count + channel];
+}
+
+inline float SparseVoxelGrid::get_brick_max(
+    const size_t            bx,
+    const size_t            by,
+    const size_t            bz,
+    const size_t            channel) const
+{
+    assert(channel < m_channel_count);
+    return m_brick_max[brick_index(bx, by, bz) * m_channel_count + channel];
+}
+
+inline SparseVoxelGrid::BrickRecord& SparseVoxelGrid::acquire(const size_t key) const
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    BrickRecord& record = m_brick_cache.get(key);
+    foundation::atomic_inc(&record.m_owners);
+
+    return record;
+}
+
+inline void SparseVoxelGrid::release(BrickRecord& record) const
+{
+    assert(foundation::atomic_read(&record.m_owners) > 0);
+    foundation::atomic_dec(&record.m_owners);
+}
+
+inline size_t SparseVoxelGrid::BrickKeyHasher::operator()(const size_t key) const
+{
+    return key;
+}
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_VOLUME_SPARSEVOXELGRID_H
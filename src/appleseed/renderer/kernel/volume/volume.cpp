@@ -30,13 +30,18 @@
 // Interface header.
 #include "volume.h"
 
+// appleseed.renderer headers.
+#include "renderer/kernel/volume/sparsevoxelgrid.h"
+
 // appleseed.foundation headers.
 #include "foundation/platform/types.h"
+#include "foundation/utility/bufferedfile.h"
 #include "foundation/utility/cc.h"
 
 // Standard headers.
 #include <cassert>
 #include <cstdio>
+#include <vector>
 
 using namespace foundation;
 using namespace std;
@@ -114,6 +119,196 @@ namespace
 
         return read;
     }
+
+    // Compute the number of channels of a fluid file, and set channel indices.
+    size_t get_fluid_channels(
+        const FluidFileHeader&  header,
+        FluidChannels&          channels)
+    {
+        size_t channel_count = 0;
+        if (header.m_has_color)
+        {
+            channels.m_color_index = channel_count;
+            channel_count += 3;
+        }
+        if (header.m_has_density)
+        {
+            channels.m_density_index = channel_count;
+            channel_count += 1;
+        }
+        if (header.m_has_temperature)
+        {
+            channels.m_temperature_index = channel_count;
+            channel_count += 1;
+        }
+        if (header.m_has_fuel)
+        {
+            channels.m_fuel_index = channel_count;
+            channel_count += 1;
+        }
+        if (header.m_has_falloff)
+        {
+            channels.m_falloff_index = channel_count;
+            channel_count += 1;
+        }
+        if (header.m_has_pressure)
+        {
+            channels.m_pressure_index = channel_count;
+            channel_count += 1;
+        }
+        if (header.m_has_coordinates)
+        {
+            channels.m_coordinates_index = channel_count;
+            channel_count += 3;
+        }
+        if (header.m_has_velocity)
+        {
+            channels.m_velocity_index = channel_count;
+            channel_count += 3;
+        }
+
+        return channel_count;
+    }
+
+    // Return the widths of the blocks of channels of a fluid file, in storage order.
+    // All voxels of a block are stored contiguously, with interleaved channels.
+    vector<size_t> get_fluid_channel_blocks(const FluidFileHeader& header)
+    {
+        vector<size_t> blocks;
+
+        if (header.m_has_color)
+            blocks.push_back(3);
+        if (header.m_has_density)
+            blocks.push_back(1);
+        if (header.m_has_temperature)
+            blocks.push_back(1);
+        if (header.m_has_fuel)
+            blocks.push_back(1);
+        if (header.m_has_falloff)
+            blocks.push_back(1);
+        if (header.m_has_pressure)
+            blocks.push_back(1);
+        if (header.m_has_coordinates)
+            blocks.push_back(3);
+        if (header.m_has_velocity)
+        {
+            blocks.push_back(1);
+            blocks.push_back(1);
+            blocks.push_back(1);
+        }
+
+        return blocks;
+    }
+
+    // A voxel source reading voxels directly from a fluid file.
+    class FluidFileVoxelSource
+      : public IVoxelSource
+    {
+      public:
+        FluidFileVoxelSource(
+            const FluidFileHeader&  header,
+            const size_t            channel_count)
+          : m_nx(header.m_xres)
+          , m_ny(header.m_yres)
+          , m_nz(header.m_zres)
+          , m_channel_count(channel_count)
+        {
+            const vector<size_t> widths = get_fluid_channel_blocks(header);
+            const int64 voxel_count = static_cast<int64>(m_nx) * m_ny * m_nz;
+
+            int64 offset = sizeof(FluidFileHeader);
+            size_t channel = 0;
+
+            for (size_t i = 0, e = widths.size(); i < e; ++i)
+            {
+                ChannelBlock block;
+                block.m_offset = offset;
+                block.m_width = widths[i];
+                block.m_channel = channel;
+                m_blocks.push_back(block);
+
+                offset += voxel_count * static_cast<int64>(widths[i] * sizeof(float));
+                channel += widths[i];
+            }
+
+            assert(channel == m_channel_count);
+        }
+
+        bool open(const char* filename)
+        {
+            return
+                m_file.open(
+                    filename,
+                    BufferedFile::BinaryType,
+                    BufferedFile::ReadMode);
+        }
+
+        virtual bool read_voxels(
+            const size_t            x0,
+            const size_t            x1,
+            const size_t            y0,
+            const size_t            y1,
+            const size_t            z0,
+            const size_t            z1,
+            float*                  values) override
+        {
+            const size_t row_voxel_count = x1 - x0;
+
+            for (size_t i = 0, e = m_blocks.size(); i < e; ++i)
+            {
+                const ChannelBlock& block = m_blocks[i];
+                const size_t row_size = row_voxel_count * block.m_width * sizeof(float);
+                m_row.resize(row_voxel_count * block.m_width);
+
+                for (size_t z = z0; z < z1; ++z)
+                {
+                    for (size_t y = y0; y < y1; ++y)
+                    {
+                        const int64 voxel_index =
+                            (static_cast<int64>(z) * m_ny + y) * m_nx + x0;
+
+                        if (!m_file.seek(
+                                block.m_offset + voxel_index * static_cast<int64>(block.m_width * sizeof(float)),
+                                BufferedFile::SeekFromBeginning))
+                            return false;
+
+                        if (m_file.read(&m_row[0], row_size) != row_size)
+                            return false;
+
+                        // Interleave the channels of this block with the other channels.
+                        const float* source = &m_row[0];
+                        float* dest =
+                            values + (((z - z0) * (y1 - y0) + (y - y0)) * row_voxel_count) * m_channel_count + block.m_channel;
+
+                        for (size_t x = 0; x < row_voxel_count; ++x)
+                        {
+                            for (size_t c = 0; c < block.m_width; ++c)
+                                dest[c] = *source++;
+                            dest += m_channel_count;
+                        }
+                    }
+                }
+            }
+
+            return true;
+        }
+
+      private:
+        struct ChannelBlock
+        {
+            int64   m_offset;       // offset in bytes of the block in the file
+            size_t  m_width;        // number of channels in the block
+            size_t  m_channel;      // index of the first channel of the block
+        };
+
+        const size_t            m_nx;
+        const size_t            m_ny;
+        const size_t            m_nz;
+        const size_t            m_channel_count;
+        vector<ChannelBlock>    m_blocks;
+        BufferedFile            m_file;
+        vector<float>           m_row;
+    };
 }
 
 auto_ptr<VoxelGrid> read_fluid_file(
@@ -145,47 +340,7 @@ auto_ptr<VoxelGrid> read_fluid_file(
     const size_t voxel_count = header.m_xres * header.m_yres * header.m_zres;
 
     // Compute the number of channels, and set channel indices.
-    size_t channel_count = 0;
-    if (header.m_has_color)
-    {
-        channels.m_color_index = channel_count;
-        channel_count += 3;
-    }
-    if (header.m_has_density)
-    {
-        channels.m_density_index = channel_count;
-        channel_count += 1;
-    }
-    if (header.m_has_temperature)
-    {
-        channels.m_temperature_index = channel_count;
-        channel_count += 1;
-    }
-    if (header.m_has_fuel)
-    {
-        channels.m_fuel_index = channel_count;
-        channel_count += 1;
-    }
-    if (header.m_has_falloff)
-    {
-        channels.m_falloff_index = channel_count;
-        channel_count += 1;
-    }
-    if (header.m_has_pressure)
-    {
-        channels.m_pressure_index = channel_count;
-        channel_count += 1;
-    }
-    if (header.m_has_coordinates)
-    {
-        channels.m_coordinates_index = channel_count;
-        channel_count += 3;
-    }
-    if (header.m_has_velocity)
-    {
-        channels.m_velocity_index = channel_count;
-        channel_count += 3;
-    }
+    const size_t channel_count = get_fluid_channels(header, channels);
 
     auto_ptr<VoxelGrid> grid(
         new VoxelGrid(
@@ -280,6 +435,54 @@ auto_ptr<VoxelGrid> read_fluid_file(
     return read == needed ? grid : auto_ptr<VoxelGrid>(0);
 }
 
+auto_ptr<SparseVoxelGrid> read_sparse_fluid_file(
+    const char*         filename,
+    FluidChannels&      channels,
+    const size_t        max_cache_size)
+{
+    assert(filename);
+
+    // Read the file header.
+    FluidFileHeader header;
+    {
+        BufferedFile file;
+        if (!file.open(filename, BufferedFile::BinaryType, BufferedFile::ReadMode))
+            return auto_ptr<SparseVoxelGrid>(0);
+
+        if (file.read(header) != sizeof(FluidFileHeader))
+            return auto_ptr<SparseVoxelGrid>(0);
+    }
+
+    // Check the validity of the file header.
+    if (header.m_id != CC32('F', 'L', 'D', '3'))
+        return auto_ptr<SparseVoxelGrid>(0);
+
+    // Compute the number of channels, and set channel indices.
+    const size_t channel_count = get_fluid_channels(header, channels);
+    if (channel_count == 0)
+        return auto_ptr<SparseVoxelGrid>(0);
+
+    auto_ptr<FluidFileVoxelSource> source(
+        new FluidFileVoxelSource(header, channel_count));
+    if (!source->open(filename))
+        return auto_ptr<SparseVoxelGrid>(0);
+
+    auto_ptr<SparseVoxelGrid> grid(
+        new SparseVoxelGrid(
+            header.m_xres,
+            header.m_yres,
+            header.m_zres,
+            channel_count,
+            auto_ptr<IVoxelSource>(source),
+            max_cache_size));
+
+    // Scan the file to compute brick summaries.
+    if (!grid->initialize())
+        return auto_ptr<SparseVoxelGrid>(0);
+
+    return grid;
+}
+
 void write_voxel_grid(
     const char*         filename,
     const VoxelGrid&    grid)
@@ -37,6 +37,9 @@
 #include <cstddef>
 #include <memory>
 
+// Forward declarations.
+namespace renderer  { class SparseVoxelGrid; }
+
 namespace renderer
 {
 
@@ -78,6 +81,14 @@ std::auto_ptr<VoxelGrid> read_fluid_file(
     const char*         filename,
     FluidChannels&      channels);
 
+// Read a fluid file created by 3Delight for Maya into a sparse voxel grid.
+// The file is scanned once, then bricks of voxels are read from it on demand
+// and kept in a brick cache of at most 'max_cache_size' bytes.
+std::auto_ptr<SparseVoxelGrid> read_sparse_fluid_file(
+    const char*         filename,
+    FluidChannels&      channels,
+    const size_t        max_cache_size);
+
 // Write a voxel grid to disk in a human-readable format.
 void write_voxel_grid(
     const char*         filename,
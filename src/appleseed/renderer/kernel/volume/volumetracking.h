@@ -0,0 +1,445 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_RENDERER_KERNEL_VOLUME_VOLUMETRACKING_H
+#define APPLESEED_RENDERER_KERNEL_VOLUME_VOLUMETRACKING_H
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/volume/occupancygrid.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+//
+// Unbiased tracking of rays through heterogeneous media whose density is bounded
+// by the per-voxel majorants of an occupancy grid.
+//
+// Rays are expressed in the unit cube [0,1]^3 of the grid, but ray parameters (distances)
+// are left untouched, such that coefficients remain expressed in the units of the scene.
+// Empty voxels are skipped using a 3D DDA; in other voxels, tentative collisions are sampled
+// with the local majorant and then accepted or rejected (delta tracking).
+//
+// References:
+//
+//   A Fast Voxel Traversal Algorithm for Ray Tracing
+//   John Amanatides, Andrew Woo
+//   http://www.cse.yorku.ca/~amana/research/grid.pdf
+//
+//   Spectral and Decomposition Tracking for Rendering Heterogeneous Volumes
+//   Peter Kutz, Ralf Habel, Yining Karl Li, Jan Novák
+//   https://disney-animation.s3.amazonaws.com/uploads/production/publication_asset/156/asset/kutz17.pdf
+//
+
+namespace renderer
+{
+
+//
+// Visit the voxels of an occupancy grid pierced by a ray segment, in front-to-back order.
+// The visitor is called as visitor(t0, t1, majorant) with the extent of the ray segment
+// inside each voxel and the density majorant of that voxel, and returns false to stop.
+//
+
+template <typename Visitor>
+void traverse_occupancy_grid(
+    const OccupancyGrid&            grid,
+    const foundation::Vector3d&     org,
+    const foundation::Vector3d&     dir,
+    const double                    tmin,
+    const double                    tmax,
+    Visitor&                        visitor);
+
+//
+// Estimate the transmission along a ray segment using ratio tracking.
+// The extinction coefficient at a point is `density(t) * extinction`.
+//
+
+template <typename DensityFunction, typename RNG>
+void ratio_tracking(
+    const OccupancyGrid&            grid,
+    const foundation::Vector3d&     org,
+    const foundation::Vector3d&     dir,
+    const double                    tmin,
+    const double                    tmax,
+    const DensityFunction&          density,
+    const Spectrum&                 extinction,
+    RNG&                            rng,
+    Spectrum&                       transmission);
+
+//
+// Sample the distance to the next scattering event along a ray segment using spectral tracking.
+// Return true if a scattering event was sampled, false if the ray left the segment or was absorbed.
+// `weight` is set to the throughput weight of the event: the transmission, multiplied by the
+// scattering coefficient at the scattering point if any, divided by the probability of the event.
+// An absorbed ray gets a weight of zero.
+//
+
+template <typename DensityFunction, typename RNG>
+bool spectral_tracking(
+    const OccupancyGrid&            grid,
+    const foundation::Vector3d&     org,
+    const foundation::Vector3d&     dir,
+    const double                    tmin,
+    const double                    tmax,
+    const DensityFunction&          density,
+    const Spectrum&                 absorption,
+    const Spectrum&                 scattering,
+    RNG&                            rng,
+    double&                         distance,
+    Spectrum&                       weight);
+
+
+//
+// Implementation.
+//
+
+template <typename Visitor>
+void traverse_occupancy_grid(
+    const OccupancyGrid&            grid,
+    const foundation::Vector3d&     org,
+    const foundation::Vector3d&     dir,
+    const double                    tmin,
+    const double                    tmax,
+    Visitor&                        visitor)
+{
+    // Clip the ray segment against the unit cube.
+    double t0 = tmin;
+    double t1 = tmax;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        if (dir[i] == 0.0)
+        {
+            if (org[i] < 0.0 || org[i] > 1.0)
+                return;
+        }
+        else
+        {
+            const double rcp_dir = 1.0 / dir[i];
+            double ta = -org[i] * rcp_dir;
+            double tb = (1.0 - org[i]) * rcp_dir;
+            if (ta > tb)
+                std::swap(ta, tb);
+            t0 = std::max(t0, ta);
+            t1 = std::min(t1, tb);
+        }
+    }
+
+    if (t0 >= t1)
+        return;
+
+    // Initialize the traversal.
+    const int res[3] =
+    {
+        static_cast<int>(grid.get_xres()),
+        static_cast<int>(grid.get_yres()),
+        static_cast<int>(grid.get_zres())
+    };
+    const foundation::Vector3d entry = org + t0 * dir;
+    int cell[3], step[3];
+    double t_next[3], t_delta[3];
+    for (size_t i = 0; i < 3; ++i)
+    {
+        cell[i] = foundation::clamp(static_cast<int>(entry[i] * res[i]), 0, res[i] - 1);
+
+        if (dir[i] > 0.0)
+        {
+            step[i] = 1;
+            t_next[i] = t0 + (static_cast<double>(cell[i] + 1) / res[i] - entry[i]) / dir[i];
+            t_delta[i] = 1.0 / (res[i] * dir[i]);
+        }
+        else if (dir[i] < 0.0)
+        {
+            step[i] = -1;
+            t_next[i] = t0 + (static_cast<double>(cell[i]) / res[i] - entry[i]) / dir[i];
+            t_delta[i] = -1.0 / (res[i] * dir[i]);
+        }
+        else
+        {
+            step[i] = 0;
+            t_next[i] = std::numeric_limits<double>::max();
+            t_delta[i] = std::numeric_limits<double>::max();
+        }
+    }
+
+    // Walk through the voxels.
+    double t = t0;
+    while (t < t1)
+    {
+        const size_t axis =
+            t_next[0] < t_next[1]
+                ? (t_next[0] < t_next[2] ? 0 : 2)
+                : (t_next[1] < t_next[2] ? 1 : 2);
+        const double t_exit = std::min(t_next[axis], t1);
+
+        if (t_exit > t)
+        {
+            const float majorant =
+                grid.get_majorant(
+                    static_cast<size_t>(cell[0]),
+                    static_cast<size_t>(cell[1]),
+                    static_cast<size_t>(cell[2]));
+
+            if (!visitor(t, t_exit, majorant))
+                return;
+        }
+
+        t = t_exit;
+        cell[axis] += step[axis];
+        if (cell[axis] < 0 || cell[axis] >= res[axis])
+            return;
+        t_next[axis] += t_delta[axis];
+    }
+}
+
+namespace impl
+{
+    template <typename DensityFunction, typename RNG>
+    struct RatioTrackingVisitor
+    {
+        const DensityFunction&      m_density;
+        const Spectrum&             m_extinction;
+        const float                 m_max_extinction;
+        RNG&                        m_rng;
+        Spectrum&                   m_transmission;
+
+        RatioTrackingVisitor(
+            const DensityFunction&  density,
+            const Spectrum&         extinction,
+            RNG&                    rng,
+            Spectrum&               transmission)
+          : m_density(density)
+          , m_extinction(extinction)
+          , m_max_extinction(foundation::max_value(extinction))
+          , m_rng(rng)
+          , m_transmission(transmission)
+        {
+        }
+
+        bool operator()(const double t0, const double t1, const float majorant)
+        {
+            const double mu = static_cast<double>(majorant) * m_max_extinction;
+
+            // Skip empty space.
+            if (mu <= 0.0)
+                return true;
+
+            const double rcp_mu = 1.0 / mu;
+            double t = t0;
+
+            while (true)
+            {
+                // Sample a tentative collision with the majorant.
+                t -= std::log(1.0 - foundation::rand_double2(m_rng)) * rcp_mu;
+                if (t >= t1)
+                    return true;
+
+                // Weight the transmission by the probability of a null collision.
+                const float d = m_density(t);
+                for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
+                    m_transmission[i] *= std::max(1.0f - static_cast<float>(d * m_extinction[i] * rcp_mu), 0.0f);
+
+                // Russian Roulette on low transmission.
+                const float max_transmission = foundation::max_value(m_transmission);
+                if (max_transmission < 0.1f)
+                {
+                    if (max_transmission == 0.0f || foundation::rand_float2(m_rng) >= 0.5f)
+                    {
+                        m_transmission.set(0.0f);
+                        return false;
+                    }
+
+                    m_transmission *= 2.0f;
+                }
+            }
+        }
+    };
+
+    template <typename DensityFunction, typename RNG>
+    struct SpectralTrackingVisitor
+    {
+        const DensityFunction&      m_density;
+        const Spectrum&             m_absorption;
+        const Spectrum&             m_scattering;
+        const float                 m_max_extinction;
+        RNG&                        m_rng;
+        Spectrum&                   m_weight;
+        double                      m_distance;
+        bool                        m_scattered;
+
+        SpectralTrackingVisitor(
+            const DensityFunction&  density,
+            const Spectrum&         absorption,
+            const Spectrum&         scattering,
+            RNG&                    rng,
+            Spectrum&               weight)
+          : m_density(density)
+          , m_absorption(absorption)
+          , m_scattering(scattering)
+          , m_max_extinction(foundation::max_value(absorption + scattering))
+          , m_rng(rng)
+          , m_weight(weight)
+          , m_distance(0.0)
+          , m_scattered(false)
+        {
+        }
+
+        bool operator()(const double t0, const double t1, const float majorant)
+        {
+            const float mu = majorant * m_max_extinction;
+
+            // Skip empty space.
+            if (mu <= 0.0f)
+                return true;
+
+            const double rcp_mu = 1.0 / mu;
+            double t = t0;
+
+            while (true)
+            {
+                // Sample a tentative collision with the majorant.
+                t -= std::log(1.0 - foundation::rand_double2(m_rng)) * rcp_mu;
+                if (t >= t1)
+                    return true;
+
+                // Compute the probabilities of absorption, scattering and null collision,
+                // proportionally to the average weighted coefficients (history-aware scheme).
+                const float d = m_density(t);
+                float p_absorption = 0.0f, p_scattering = 0.0f, p_null = 0.0f;
+                for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
+                {
+                    const float sigma_a = d * m_absorption[i];
+                    const float sigma_s = d * m_scattering[i];
+                    const float sigma_n = std::max(mu - sigma_a - sigma_s, 0.0f);
+                    p_absorption += m_weight[i] * sigma_a;
+                    p_scattering += m_weight[i] * sigma_s;
+                    p_null += m_weight[i] * sigma_n;
+                }
+
+                const float p_sum = p_absorption + p_scattering + p_null;
+                if (p_sum <= 0.0f)
+                {
+                    m_weight.set(0.0f);
+                    return false;
+                }
+
+                const float s = foundation::rand_float2(m_rng) * p_sum;
+
+                if (s < p_absorption)
+                {
+                    // Absorption: the path carries no more energy.
+                    m_weight.set(0.0f);
+                    return false;
+                }
+
+                if (s < p_absorption + p_scattering)
+                {
+                    // Scattering.
+                    const float rcp_prob = p_sum / (mu * p_scattering);
+                    for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
+                        m_weight[i] *= d * m_scattering[i] * rcp_prob;
+                    m_distance = t;
+                    m_scattered = true;
+                    return false;
+                }
+
+                // Null collision.
+                const float rcp_prob = p_sum / (mu * p_null);
+                for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
+                {
+                    const float sigma_n = std::max(mu - d * (m_absorption[i] + m_scattering[i]), 0.0f);
+                    m_weight[i] *= sigma_n * rcp_prob;
+                }
+            }
+        }
+    };
+}
+
+template <typename DensityFunction, typename RNG>
+void ratio_tracking(
+    const OccupancyGrid&            grid,
+    const foundation::Vector3d&     org,
+    const foundation::Vector3d&     dir,
+    const double                    tmin,
+    const double                    tmax,
+    const DensityFunction&          density,
+    const Spectrum&                 extinction,
+    RNG&                            rng,
+    Spectrum&                       transmission)
+{
+    transmission.set(1.0f);
+
+    impl::RatioTrackingVisitor<DensityFunction, RNG> visitor(
+        density,
+        extinction,
+        rng,
+        transmission);
+
+    traverse_occupancy_grid(grid, org, dir, tmin, tmax, visitor);
+}
+
+template <typename DensityFunction, typename RNG>
+bool spectral_tracking(
+    const OccupancyGrid&            grid,
+    const foundation::Vector3d&     org,
+    const foundation::Vector3d&     dir,
+    const double                    tmin,
+    const double                    tmax,
+    const DensityFunction&          density,
+    const Spectrum&                 absorption,
+    const Spectrum&                 scattering,
+    RNG&                            rng,
+    double&                         distance,
+    Spectrum&                       weight)
+{
+    weight.set(1.0f);
+
+    impl::SpectralTrackingVisitor<DensityFunction, RNG> visitor(
+        density,
+        absorption,
+        scattering,
+        rng,
+        weight);
+
+    traverse_occupancy_grid(grid, org, dir, tmin, tmax, visitor);
+
+    distance = visitor.m_scattered ? visitor.m_distance : tmax;
+    return visitor.m_scattered;
+}
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_KERNEL_VOLUME_VOLUMETRACKING_H
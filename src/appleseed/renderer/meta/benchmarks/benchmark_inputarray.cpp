@@ -0,0 +1,107 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/texturing/texturecache.h"
+#include "renderer/kernel/texturing/texturestore.h"
+#include "renderer/modeling/input/inputarray.h"
+#include "renderer/modeling/input/scalarsource.h"
+#include "renderer/utility/testutils.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/vector.h"
+#include "foundation/utility/benchmark.h"
+
+using namespace foundation;
+using namespace renderer;
+
+BENCHMARK_SUITE(Renderer_Modeling_Input_InputArray)
+{
+    // Input values of a typical BSDF with uniform inputs only.
+    APPLESEED_DECLARE_INPUT_VALUES(InputValues)
+    {
+        Spectrum    m_reflectance;
+        float       m_reflectance_multiplier;
+        Spectrum    m_specular_reflectance;
+        float       m_specular_reflectance_multiplier;
+        float       m_roughness;
+        float       m_anisotropy;
+        float       m_ior;
+    };
+
+    struct Fixture
+      : public TestFixtureBase
+    {
+        InputArray      m_inputs;
+        TextureStore    m_texture_store;
+        TextureCache    m_texture_cache;
+        InputValues     m_values;
+
+        Fixture()
+          : m_texture_store(m_scene)
+          , m_texture_cache(m_texture_store)
+        {
+            m_inputs.declare("reflectance", InputFormatSpectralReflectance);
+            m_inputs.declare("reflectance_multiplier", InputFormatFloat, "1.0");
+            m_inputs.declare("specular_reflectance", InputFormatSpectralReflectance);
+            m_inputs.declare("specular_reflectance_multiplier", InputFormatFloat, "1.0");
+            m_inputs.declare("roughness", InputFormatFloat, "0.15");
+            m_inputs.declare("anisotropy", InputFormatFloat, "0.0");
+            m_inputs.declare("ior", InputFormatFloat, "1.5");
+
+            m_inputs.find("reflectance").bind(new ScalarSource(0.5f));
+            m_inputs.find("reflectance_multiplier").bind(new ScalarSource(1.0f));
+            m_inputs.find("specular_reflectance").bind(new ScalarSource(0.8f));
+            m_inputs.find("specular_reflectance_multiplier").bind(new ScalarSource(1.0f));
+            m_inputs.find("roughness").bind(new ScalarSource(0.15f));
+            m_inputs.find("anisotropy").bind(new ScalarSource(0.0f));
+            m_inputs.find("ior").bind(new ScalarSource(1.5f));
+        }
+    };
+
+    BENCHMARK_CASE_F(Evaluate, Fixture)
+    {
+        m_inputs.evaluate(m_texture_cache, Vector2f(0.5f), &m_values);
+    }
+
+    struct FixtureWithPreparedUniforms
+      : public Fixture
+    {
+        FixtureWithPreparedUniforms()
+        {
+            m_inputs.prepare_uniforms();
+        }
+    };
+
+    BENCHMARK_CASE_F(Evaluate_WithPreparedUniforms, FixtureWithPreparedUniforms)
+    {
+        m_inputs.evaluate(m_texture_cache, Vector2f(0.5f), &m_values);
+    }
+}
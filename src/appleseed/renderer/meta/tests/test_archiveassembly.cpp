@@ -0,0 +1,162 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/scene/archiveassembly.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/scene/visibilityflags.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Modeling_Scene_ArchiveAssembly)
+{
+    struct SkipInvisibleArchiveScene
+    {
+        auto_release_ptr<Project>   m_project;
+        Scene*                      m_scene;
+
+        SkipInvisibleArchiveScene()
+          : m_project(ProjectFactory::create("project"))
+        {
+            m_project->set_scene(SceneFactory::create());
+            m_scene = m_project->get_scene();
+
+            // Archive instantiated by a visible instance in the scene.
+            m_scene->assemblies().insert(create_skip_invisible_archive("visible_archive"));
+            m_scene->assembly_instances().insert(
+                AssemblyInstanceFactory::create(
+                    "visible_archive_inst",
+                    ParamArray(),
+                    "visible_archive"));
+
+            // Archive only instantiated by an instance invisible to all ray types.
+            m_scene->assemblies().insert(create_skip_invisible_archive("hidden_archive"));
+            m_scene->assembly_instances().insert(
+                AssemblyInstanceFactory::create(
+                    "hidden_archive_inst",
+                    ParamArray().insert("visibility", VisibilityFlags::to_dictionary(0)),
+                    "hidden_archive"));
+
+            // Archive instantiated by both a hidden and a visible instance.
+            m_scene->assemblies().insert(create_skip_invisible_archive("mixed_archive"));
+            m_scene->assembly_instances().insert(
+                AssemblyInstanceFactory::create(
+                    "mixed_archive_hidden_inst",
+                    ParamArray().insert("visibility", VisibilityFlags::to_dictionary(0)),
+                    "mixed_archive"));
+            m_scene->assembly_instances().insert(
+                AssemblyInstanceFactory::create(
+                    "mixed_archive_visible_inst",
+                    ParamArray(),
+                    "mixed_archive"));
+
+            // Archive declared in the scene but instantiated from a child assembly.
+            m_scene->assemblies().insert(create_skip_invisible_archive("nested_archive"));
+
+            auto_release_ptr<Assembly> parent_assembly(
+                AssemblyFactory().create("parent_assembly", ParamArray()));
+            parent_assembly->assembly_instances().insert(
+                AssemblyInstanceFactory::create(
+                    "nested_archive_inst",
+                    ParamArray(),
+                    "nested_archive"));
+            m_scene->assemblies().insert(parent_assembly);
+            m_scene->assembly_instances().insert(
+                AssemblyInstanceFactory::create(
+                    "parent_assembly_inst",
+                    ParamArray(),
+                    "parent_assembly"));
+        }
+
+        static auto_release_ptr<Assembly> create_skip_invisible_archive(const char* name)
+        {
+            return
+                ArchiveAssemblyFactory().create(
+                    name,
+                    ParamArray()
+                        .insert("filename", "unit tests/inputs/test_archiveassembly_archive.appleseed")
+                        .insert("skip_invisible", true));
+        }
+
+        size_t get_color_count(const char* assembly_name) const
+        {
+            return m_scene->assemblies().get_by_name(assembly_name)->colors().size();
+        }
+    };
+
+    TEST_CASE_F(ExpandContents_GivenSkipInvisibleArchiveWithVisibleInstance_LoadsArchive, SkipInvisibleArchiveScene)
+    {
+        ASSERT_TRUE(m_scene->expand_procedural_assemblies(m_project.ref()));
+
+        EXPECT_EQ(1, get_color_count("visible_archive"));
+    }
+
+    TEST_CASE_F(ExpandContents_GivenSkipInvisibleArchiveWithHiddenInstance_DoesNotLoadArchive, SkipInvisibleArchiveScene)
+    {
+        ASSERT_TRUE(m_scene->expand_procedural_assemblies(m_project.ref()));
+
+        EXPECT_EQ(0, get_color_count("hidden_archive"));
+    }
+
+    TEST_CASE_F(ExpandContents_GivenSkipInvisibleArchiveWithHiddenAndVisibleInstances_LoadsArchive, SkipInvisibleArchiveScene)
+    {
+        ASSERT_TRUE(m_scene->expand_procedural_assemblies(m_project.ref()));
+
+        EXPECT_EQ(1, get_color_count("mixed_archive"));
+    }
+
+    TEST_CASE_F(ExpandContents_GivenSkipInvisibleArchiveInstantiatedFromNestedAssembly_LoadsArchive, SkipInvisibleArchiveScene)
+    {
+        ASSERT_TRUE(m_scene->expand_procedural_assemblies(m_project.ref()));
+
+        EXPECT_EQ(1, get_color_count("nested_archive"));
+    }
+
+    TEST_CASE_F(ExpandContents_GivenLoadedSkipInvisibleArchiveThatBecameHidden_UnloadsArchive, SkipInvisibleArchiveScene)
+    {
+        ASSERT_TRUE(m_scene->expand_procedural_assemblies(m_project.ref()));
+
+        m_scene->assembly_instances().remove(
+            m_scene->assembly_instances().get_by_name("visible_archive_inst"));
+
+        ASSERT_TRUE(m_scene->expand_procedural_assemblies(m_project.ref()));
+
+        EXPECT_EQ(0, get_color_count("visible_archive"));
+    }
+}
@@ -32,6 +32,8 @@
 
 // appleseed.foundation headers.
 #include "foundation/image/color.h"
+#include "foundation/image/colorspace.h"
+#include "foundation/image/regularspectrum.h"
 #include "foundation/utility/test.h"
 
 // Standard headers.
@@ -73,6 +75,21 @@ TEST_SUITE(Renderer_Utility_DynamicSpectrum31f)
         }
     };
 
+    struct HeroWavelengthFixture
+    {
+        const DynamicSpectrum31f::Mode m_old_mode;
+
+        HeroWavelengthFixture()
+          : m_old_mode(DynamicSpectrum31f::set_mode(DynamicSpectrum31f::HeroWavelength))
+        {
+        }
+
+        ~HeroWavelengthFixture()
+        {
+            DynamicSpectrum31f::set_mode(m_old_mode);
+        }
+    };
+
     static const float SpectrumValues[31] =
     {
         42.0f, 42.0f, 42.0f, 42.0f, 42.0f, 42.0f, 42.0f, 42.0f,
@@ -216,4 +233,84 @@ TEST_SUITE(Renderer_Utility_DynamicSpectrum31f)
         for (size_t i = 0, e = x.size(); i < e; ++i)
             EXPECT_FEQ(sqrt(Values[i]), result[i]);
     }
+
+    TEST_CASE_F(SetHeroWavelengths_GivenZero_SelectsEquallySpacedBands, HeroWavelengthFixture)
+    {
+        DynamicSpectrum31f::set_hero_wavelengths(0.0f);
+
+        EXPECT_EQ(4, DynamicSpectrum31f::size());
+        EXPECT_EQ(0, DynamicSpectrum31f::get_hero_band(0));
+        EXPECT_EQ(7, DynamicSpectrum31f::get_hero_band(1));
+        EXPECT_EQ(15, DynamicSpectrum31f::get_hero_band(2));
+        EXPECT_EQ(23, DynamicSpectrum31f::get_hero_band(3));
+    }
+
+    TEST_CASE_F(SetFromRegularSpectrum_HeroWavelength_GathersValuesAtHeroWavelengths, HeroWavelengthFixture)
+    {
+        RegularSpectrum31f spectrum;
+        for (size_t i = 0; i < 31; ++i)
+            spectrum[i] = static_cast<float>(i);
+
+        const LightingConditions lighting_conditions(IlluminantCIED65, XYZCMFCIE19312Deg);
+
+        DynamicSpectrum31f::set_hero_wavelengths(0.5f);
+        const DynamicSpectrum31f s(spectrum, lighting_conditions, DynamicSpectrum31f::Reflectance);
+
+        for (size_t i = 0; i < 4; ++i)
+            EXPECT_EQ(static_cast<float>(DynamicSpectrum31f::get_hero_band(i)), s[i]);
+    }
+
+    TEST_CASE_F(GatherHeroWavelengths_GivenFullSpectrum_KeepsValuesAtHeroWavelengths, HeroWavelengthFixture)
+    {
+        DynamicSpectrum31f::set_mode(DynamicSpectrum31f::Spectral);
+        DynamicSpectrum31f s;
+        for (size_t i = 0; i < 31; ++i)
+            s[i] = static_cast<float>(i);
+
+        DynamicSpectrum31f::set_mode(DynamicSpectrum31f::HeroWavelength);
+        DynamicSpectrum31f::set_hero_wavelengths(0.3f);
+        s.gather_hero_wavelengths();
+
+        for (size_t i = 0; i < 4; ++i)
+            EXPECT_EQ(static_cast<float>(DynamicSpectrum31f::get_hero_band(i)), s[i]);
+    }
+
+    TEST_CASE_F(ToCIEXYZ_HeroWavelength_AveragesToSpectralResult, HeroWavelengthFixture)
+    {
+        static const float Values[31] =
+        {
+            0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f,
+            0.9f, 1.0f, 0.9f, 0.8f, 0.7f, 0.6f, 0.5f, 0.4f,
+            0.3f, 0.2f, 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f,
+            0.7f, 0.8f, 0.9f, 1.0f, 0.9f, 0.8f, 0.7f
+        };
+
+        const auto spectrum(RegularSpectrum31f::from_array(Values));
+        const LightingConditions lighting_conditions(IlluminantCIED65, XYZCMFCIE19312Deg);
+        const Color3f expected = spectrum_to_ciexyz<float>(lighting_conditions, spectrum);
+
+        // Each band is carried exactly four times by these 31 choices of hero wavelengths.
+        Color3f average(0.0f);
+        for (size_t i = 0; i < 31; ++i)
+        {
+            DynamicSpectrum31f::set_hero_wavelengths((i + 0.125f) / 31.0f);
+            const DynamicSpectrum31f s(spectrum, lighting_conditions, DynamicSpectrum31f::Reflectance);
+            average += s.to_ciexyz(lighting_conditions);
+        }
+        average /= 31.0f;
+
+        EXPECT_FEQ_EPS(expected, average, 1.0e-4f);
+    }
+
+    TEST_CASE_F(MinAndMaxValues_HeroWavelength, HeroWavelengthFixture)
+    {
+        DynamicSpectrum31f s;
+        s[0] = 3.0f;
+        s[1] = 1.0f;
+        s[2] = 4.0f;
+        s[3] = 2.0f;
+
+        EXPECT_EQ(1.0f, min_value(s));
+        EXPECT_EQ(4.0f, max_value(s));
+    }
 }
@@ -0,0 +1,243 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/modeling/bsdf/energycompensation.h"
+#include "renderer/modeling/bsdf/microfacethelper.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/microfacet.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/countof.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+TEST_SUITE(Renderer_Modeling_BSDF_EnergyCompensation)
+{
+    const size_t N = MicrofacetAlbedoTable::TableSize;
+
+    bool tables_match(
+        const MicrofacetAlbedoTable&    lhs,
+        const MicrofacetAlbedoTable&    rhs,
+        const float                     eps)
+    {
+        for (size_t j = 0; j < N; ++j)
+        {
+            const float roughness = static_cast<float>(j) / (N - 1);
+
+            for (size_t i = 0; i < N; ++i)
+            {
+                const float cos_theta = static_cast<float>(i) / (N - 1);
+
+                if (!feq(
+                        lhs.get_directional_albedo(cos_theta, roughness),
+                        rhs.get_directional_albedo(cos_theta, roughness),
+                        eps))
+                    return false;
+            }
+
+            if (!feq(lhs.get_average_albedo(roughness), rhs.get_average_albedo(roughness), eps))
+                return false;
+        }
+
+        return true;
+    }
+
+    TEST_CASE(GGXAlbedoTable_MatchesNumericalIntegration)
+    {
+        const GGXMDF mdf;
+        const MicrofacetAlbedoTable table(mdf, 256);
+
+        EXPECT_TRUE(tables_match(get_ggx_albedo_table(), table, 0.02f));
+    }
+
+    TEST_CASE(BeckmannAlbedoTable_MatchesNumericalIntegration)
+    {
+        const BeckmannMDF mdf;
+        const MicrofacetAlbedoTable table(mdf, 256);
+
+        EXPECT_TRUE(tables_match(get_beckmann_albedo_table(), table, 0.02f));
+    }
+
+    // Estimate the directional albedo of a microfacet BRDF using the midpoint rule
+    // over (cos theta_i, phi_i), independently of MicrofacetAlbedoTable.
+    float estimate_directional_albedo(
+        const MDF&                      mdf,
+        const float                     cos_theta,
+        const float                     roughness,
+        const size_t                    n)
+    {
+        const float alpha = microfacet_alpha_from_roughness(roughness);
+        const Vector3f wo(sqrt(1.0f - cos_theta * cos_theta), cos_theta, 0.0f);
+
+        double sum = 0.0;
+
+        for (size_t j = 0; j < n; ++j)
+        {
+            const float cos_in = (j + 0.5f) / n;
+            const float sin_in = sqrt(1.0f - cos_in * cos_in);
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                const float phi = TwoPi<float>() * (i + 0.5f) / n;
+                const Vector3f wi(sin_in * cos(phi), cos_in, sin_in * sin(phi));
+                const Vector3f h = normalize(wi + wo);
+
+                sum +=
+                    mdf.D(h, alpha, alpha, 0.0f) *
+                    mdf.G(wi, wo, h, alpha, alpha, 0.0f) / (4.0f * cos_theta);
+            }
+        }
+
+        return static_cast<float>(sum * TwoPi<double>() / (n * n));
+    }
+
+    TEST_CASE(GGXAlbedoTable_SpotCheckedEntries_MatchIndependentEstimate)
+    {
+        const GGXMDF mdf;
+        const MicrofacetAlbedoTable& table = get_ggx_albedo_table();
+
+        const size_t RoughnessIndices[] = { 16, 31 };
+        const size_t CosThetaIndices[] = { 4, 8, 16, 31 };
+
+        for (size_t j = 0; j < countof(RoughnessIndices); ++j)
+        {
+            const float roughness = static_cast<float>(RoughnessIndices[j]) / (N - 1);
+
+            for (size_t i = 0; i < countof(CosThetaIndices); ++i)
+            {
+                const float cos_theta = static_cast<float>(CosThetaIndices[i]) / (N - 1);
+
+                EXPECT_FEQ_EPS(
+                    estimate_directional_albedo(mdf, cos_theta, roughness, 128),
+                    table.get_directional_albedo(cos_theta, roughness),
+                    0.005f);
+            }
+        }
+    }
+
+    TEST_CASE(GetDirectionalAlbedo_SmoothSurfaceAtNormalIncidence_ReturnsOne)
+    {
+        EXPECT_FEQ_EPS(1.0f, get_ggx_albedo_table().get_directional_albedo(1.0f, 0.0f), 1.0e-3f);
+        EXPECT_FEQ_EPS(1.0f, get_beckmann_albedo_table().get_directional_albedo(1.0f, 0.0f), 1.0e-3f);
+    }
+
+    TEST_CASE(GetDirectionalAlbedo_DecreasesWithRoughness)
+    {
+        const MicrofacetAlbedoTable& table = get_ggx_albedo_table();
+
+        EXPECT_TRUE(table.get_directional_albedo(0.5f, 0.5f) < table.get_directional_albedo(0.5f, 0.1f));
+        EXPECT_TRUE(table.get_directional_albedo(0.5f, 1.0f) < table.get_directional_albedo(0.5f, 0.5f));
+    }
+
+    TEST_CASE(GetDirectionalAlbedos_MatchesGetDirectionalAlbedo)
+    {
+        const MicrofacetAlbedoTable& table = get_ggx_albedo_table();
+
+        float albedo_o, albedo_i;
+        table.get_directional_albedos(0.37f, 0.81f, 0.55f, albedo_o, albedo_i);
+
+        EXPECT_FEQ(table.get_directional_albedo(0.37f, 0.55f), albedo_o);
+        EXPECT_FEQ(table.get_directional_albedo(0.81f, 0.55f), albedo_i);
+    }
+
+    TEST_CASE(AddEnergyCompensationTerm_WhiteFurnace_RestoresLostEnergy)
+    {
+        const MicrofacetAlbedoTable& table = get_ggx_albedo_table();
+        const float Roughness = 0.8f;
+        const float CosOn = 0.6f;
+
+        // Integrate the compensation lobe against the cosine over the hemisphere.
+        const size_t SampleCount = 1024;
+        float energy = 0.0f;
+
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            const float cos_in = (i + 0.5f) / SampleCount;
+
+            Spectrum value(0.0f);
+            add_energy_compensation_term(
+                table,
+                Roughness,
+                cos_in,
+                CosOn,
+                Spectrum(1.0f),
+                1.0f,
+                value);
+
+            energy += value[0] * cos_in;
+        }
+
+        energy *= TwoPi<float>() / SampleCount;
+
+        const float lost_energy = 1.0f - table.get_directional_albedo(CosOn, Roughness);
+
+        EXPECT_FEQ_EPS(lost_energy, energy, 0.01f);
+    }
+
+    TEST_CASE(AverageFresnelReflectanceDielectric_IndexMatched_ReturnsZero)
+    {
+        EXPECT_FEQ_EPS(0.0f, average_fresnel_reflectance_dielectric(1.0f), 1.0e-6f);
+    }
+
+#if 0
+
+    // Regenerate the tables embedded in energycompensationtables.cpp.
+    // Disabled by default since it integrates 4096 samples per table entry.
+    TEST_CASE(GenerateAlbedoTables)
+    {
+        const size_t SampleCount = 4096;
+
+        const GGXMDF ggx_mdf;
+        const MicrofacetAlbedoTable ggx_table(ggx_mdf, SampleCount);
+
+        const BeckmannMDF beckmann_mdf;
+        const MicrofacetAlbedoTable beckmann_table(beckmann_mdf, SampleCount);
+
+        ofstream file("unit tests/outputs/test_energycompensation_tables.txt");
+
+        file << "GGX (version " << MicrofacetAlbedoTable::Version << "):\n";
+        ggx_table.write_cpp_array(file);
+
+        file << "\nBeckmann (version " << MicrofacetAlbedoTable::Version << "):\n";
+        beckmann_table.write_cpp_array(file);
+    }
+
+#endif
+}
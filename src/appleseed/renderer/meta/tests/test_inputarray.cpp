@@ -28,16 +28,23 @@
 //
 
 // appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/texturing/texturecache.h"
+#include "renderer/kernel/texturing/texturestore.h"
 #include "renderer/modeling/input/inputarray.h"
 #include "renderer/modeling/input/scalarsource.h"
 #include "renderer/modeling/input/source.h"
+#include "renderer/utility/testutils.h"
 
 // appleseed.foundation headers.
+#include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
 #include "foundation/utility/test.h"
 
 // Standard headers.
 #include <string>
 
+using namespace foundation;
 using namespace renderer;
 using namespace std;
 
@@ -95,4 +102,101 @@ TEST_SUITE(Renderer_Modeling_Input_InputArray)
 
         EXPECT_EQ(expected_source, source);
     }
+
+    class VaryingSource
+      : public Source
+    {
+      public:
+        VaryingSource()
+          : Source(false)
+        {
+        }
+
+        virtual uint64 compute_signature() const override
+        {
+            return 0;
+        }
+
+        virtual void evaluate(
+            TextureCache&       texture_cache,
+            const Vector2f&     uv,
+            float&              scalar) const override
+        {
+            scalar = uv[0];
+        }
+    };
+
+    APPLESEED_DECLARE_INPUT_VALUES(InputValues)
+    {
+        float       m_x;
+        Spectrum    m_y;
+        float       m_z;
+        float       m_w;
+    };
+
+    struct Fixture
+      : public TestFixtureBase
+    {
+        InputArray  m_inputs;
+
+        Fixture()
+        {
+            m_inputs.declare("x", InputFormatFloat);
+            m_inputs.declare("y", InputFormatSpectralReflectance);
+            m_inputs.declare("z", InputFormatFloat);
+            m_inputs.declare("w", InputFormatFloat, "0.0");
+            m_inputs.find("x").bind(new ScalarSource(2.0f));
+            m_inputs.find("y").bind(new ScalarSource(3.0f));
+            m_inputs.find("z").bind(new VaryingSource());
+        }
+
+        void evaluate(InputValues& values, const Vector2f& uv)
+        {
+            TextureStore texture_store(m_scene);
+            TextureCache texture_cache(texture_store);
+            m_inputs.evaluate(texture_cache, uv, &values);
+        }
+    };
+
+    TEST_CASE_F(Evaluate_GivenPreparedUniforms_MatchesFullEvaluation, Fixture)
+    {
+        InputValues expected;
+        evaluate(expected, Vector2f(0.25f, 0.5f));
+
+        m_inputs.prepare_uniforms();
+        ASSERT_TRUE(m_inputs.has_prepared_uniforms());
+
+        InputValues values;
+        evaluate(values, Vector2f(0.25f, 0.5f));
+
+        EXPECT_EQ(expected.m_x, values.m_x);
+        EXPECT_TRUE(expected.m_y == values.m_y);
+        EXPECT_EQ(expected.m_z, values.m_z);
+        EXPECT_EQ(expected.m_w, values.m_w);
+    }
+
+    TEST_CASE_F(Evaluate_GivenPreparedUniforms_EvaluatesVaryingInputs, Fixture)
+    {
+        m_inputs.prepare_uniforms();
+
+        InputValues values;
+        evaluate(values, Vector2f(0.25f, 0.5f));
+        EXPECT_EQ(0.25f, values.m_z);
+
+        evaluate(values, Vector2f(0.75f, 0.5f));
+        EXPECT_EQ(0.75f, values.m_z);
+    }
+
+    TEST_CASE_F(Bind_GivenPreparedUniforms_ReleasesPreparedUniforms, Fixture)
+    {
+        m_inputs.prepare_uniforms();
+
+        m_inputs.find("x").bind(new ScalarSource(4.0f));
+
+        EXPECT_FALSE(m_inputs.has_prepared_uniforms());
+
+        InputValues values;
+        evaluate(values, Vector2f(0.25f, 0.5f));
+        EXPECT_EQ(4.0f, values.m_x);
+    }
 }
@@ -0,0 +1,155 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/kernel/intersection/intersectionfilter.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/vector.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+TEST_SUITE(Renderer_Kernel_Intersection_IntersectionFilter)
+{
+    // Alpha masks used in these tests are two tiles wide and one tile high.
+    const size_t MaskWidth = 16;
+    const size_t MaskHeight = 8;
+
+    // Make the texels of the first 'opaque_width' columns of an alpha mask opaque,
+    // and the others transparent.
+    template <typename AlphaMask>
+    void init_alpha_mask(AlphaMask& mask, const size_t opaque_width)
+    {
+        const size_t tile_count = MaskWidth / AlphaMask::TileSize;
+        vector<bool> full_tiles(tile_count, true);
+        vector<bool> empty_tiles(tile_count, true);
+
+        for (size_t y = 0; y < MaskHeight; ++y)
+        {
+            for (size_t x = 0; x < MaskWidth; ++x)
+            {
+                const bool opaque = x < opaque_width;
+                mask.set_opaque(x, y, opaque);
+
+                if (opaque)
+                    empty_tiles[x / AlphaMask::TileSize] = false;
+                else full_tiles[x / AlphaMask::TileSize] = false;
+            }
+        }
+
+        mask.set_tile_opacities(full_tiles, empty_tiles);
+    }
+
+    // UV bounding box covering the whole mask.
+    const Vector2f WholeMin(0.0f, 0.0f);
+    const Vector2f WholeMax(1.0f, 1.0f);
+
+    // UV bounding box well within the first tile of the mask.
+    const Vector2f LeftMin(0.05f, 0.1f);
+    const Vector2f LeftMax(0.25f, 0.9f);
+
+    TEST_CASE(ClassifyTriangle_GivenOpaqueMasks_ReturnsOpaque)
+    {
+        IntersectionFilter::AlphaMask obj_mask(MaskWidth, MaskHeight);
+        IntersectionFilter::AlphaMask mtl_mask(MaskWidth, MaskHeight);
+        init_alpha_mask(obj_mask, MaskWidth);
+        init_alpha_mask(mtl_mask, MaskWidth);
+
+        const IntersectionFilter::Opacity opacity =
+            IntersectionFilter::classify_triangle(&obj_mask, true, &mtl_mask, true, WholeMin, WholeMax);
+
+        EXPECT_EQ(IntersectionFilter::Opaque, opacity);
+    }
+
+    TEST_CASE(ClassifyTriangle_GivenTransparentMask_ReturnsTransparent)
+    {
+        IntersectionFilter::AlphaMask obj_mask(MaskWidth, MaskHeight);
+        IntersectionFilter::AlphaMask mtl_mask(MaskWidth, MaskHeight);
+        init_alpha_mask(obj_mask, MaskWidth);
+        init_alpha_mask(mtl_mask, 0);
+
+        const IntersectionFilter::Opacity opacity =
+            IntersectionFilter::classify_triangle(&obj_mask, true, &mtl_mask, true, WholeMin, WholeMax);
+
+        EXPECT_EQ(IntersectionFilter::Transparent, opacity);
+    }
+
+    TEST_CASE(ClassifyTriangle_GivenPartiallyTransparentMask_ReturnsMixed)
+    {
+        IntersectionFilter::AlphaMask mtl_mask(MaskWidth, MaskHeight);
+        init_alpha_mask(mtl_mask, MaskWidth / 2);
+
+        const IntersectionFilter::Opacity opacity =
+            IntersectionFilter::classify_triangle(0, false, &mtl_mask, true, WholeMin, WholeMax);
+
+        EXPECT_EQ(IntersectionFilter::Mixed, opacity);
+    }
+
+    TEST_CASE(ClassifyTriangle_GivenTriangleOverOpaqueTileOfPartialMask_ReturnsOpaque)
+    {
+        IntersectionFilter::AlphaMask mtl_mask(MaskWidth, MaskHeight);
+        init_alpha_mask(mtl_mask, MaskWidth / 2);
+
+        const IntersectionFilter::Opacity opacity =
+            IntersectionFilter::classify_triangle(0, false, &mtl_mask, true, LeftMin, LeftMax);
+
+        EXPECT_EQ(IntersectionFilter::Opaque, opacity);
+    }
+
+    TEST_CASE(ClassifyTriangle_GivenAlphaMapWithoutMask_ReturnsMixed)
+    {
+        // The object has an alpha map but its mask was discarded (mostly opaque map,
+        // or shading of alpha cutouts enabled): the alpha map must still be evaluated.
+        IntersectionFilter::AlphaMask mtl_mask(MaskWidth, MaskHeight);
+        init_alpha_mask(mtl_mask, MaskWidth);
+
+        const IntersectionFilter::Opacity opacity =
+            IntersectionFilter::classify_triangle(0, true, &mtl_mask, true, WholeMin, WholeMax);
+
+        EXPECT_EQ(IntersectionFilter::Mixed, opacity);
+    }
+
+    TEST_CASE(ClassifyTriangle_GivenNoAlphaMap_ReturnsOpaque)
+    {
+        IntersectionFilter::AlphaMask obj_mask(MaskWidth, MaskHeight);
+        init_alpha_mask(obj_mask, MaskWidth);
+
+        const IntersectionFilter::Opacity opacity =
+            IntersectionFilter::classify_triangle(&obj_mask, true, 0, false, WholeMin, WholeMax);
+
+        EXPECT_EQ(IntersectionFilter::Opaque, opacity);
+    }
+}
@@ -0,0 +1,150 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/rendering/pixelrendererbase.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/image.h"
+#include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+TEST_SUITE(Renderer_Kernel_Rendering_PixelRendererBase)
+{
+    // Expose the protected method under test.
+    struct PixelRendererBaseAccess
+      : public PixelRendererBase
+    {
+        using PixelRendererBase::compute_pixel_instance;
+    };
+
+    vector<uint64> compute_frame_instances(
+        const char*                 resolution,
+        const SamplingContext::Mode sampling_mode,
+        const size_t                max_sample_count)
+    {
+        auto_release_ptr<Frame> frame(
+            FrameFactory::create("frame", ParamArray().insert("resolution", resolution)));
+
+        const CanvasProperties& props = frame->image().properties();
+        vector<uint64> instances;
+
+        for (size_t y = 0; y < props.m_canvas_height; ++y)
+        {
+            for (size_t x = 0; x < props.m_canvas_width; ++x)
+            {
+                instances.push_back(
+                    PixelRendererBaseAccess::compute_pixel_instance(
+                        frame.ref(),
+                        0x12345678,
+                        Vector2i(static_cast<int>(x), static_cast<int>(y)),
+                        sampling_mode,
+                        max_sample_count));
+            }
+        }
+
+        sort(instances.begin(), instances.end());
+
+        return instances;
+    }
+
+    bool are_aligned_and_in_sequence(const vector<uint64>& instances, const uint64 block_size)
+    {
+        for (size_t i = 0; i < instances.size(); ++i)
+        {
+            if (instances[i] % block_size != 0)
+                return false;
+
+            if (instances[i] + block_size > (uint64(1) << 32))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool are_disjoint(const vector<uint64>& sorted_instances, const uint64 block_size)
+    {
+        for (size_t i = 1; i < sorted_instances.size(); ++i)
+        {
+            if (sorted_instances[i] - sorted_instances[i - 1] < block_size)
+                return false;
+        }
+
+        return true;
+    }
+
+    TEST_CASE(ComputePixelInstance_SobolMode_ReturnsAlignedBlocks)
+    {
+        const vector<uint64> instances =
+            compute_frame_instances("37 23", SamplingContext::SobolMode, 6);
+
+        EXPECT_TRUE(are_aligned_and_in_sequence(instances, 8));
+    }
+
+    TEST_CASE(ComputePixelInstance_BlueNoiseSobolMode_ReturnsDisjointAlignedBlocks)
+    {
+        const vector<uint64> instances =
+            compute_frame_instances("37 23", SamplingContext::BlueNoiseSobolMode, 6);
+
+        EXPECT_TRUE(are_aligned_and_in_sequence(instances, 8));
+        EXPECT_TRUE(are_disjoint(instances, 8));
+    }
+
+    TEST_CASE(ComputePixelInstance_BlueNoiseSobolModeWithHighSampleCount_ReturnsDisjointAlignedBlocks)
+    {
+        // 64 x 64 pixels with 2^20 samples each exactly fill the 2^32 sample numbers.
+        const vector<uint64> instances =
+            compute_frame_instances("64 40", SamplingContext::BlueNoiseSobolMode, 1 << 20);
+
+        EXPECT_TRUE(are_aligned_and_in_sequence(instances, 1 << 20));
+        EXPECT_TRUE(are_disjoint(instances, 1 << 20));
+    }
+
+    TEST_CASE(ComputePixelInstance_BlueNoiseSobolModeWithTooManySamples_ReturnsAlignedBlocks)
+    {
+        const vector<uint64> instances =
+            compute_frame_instances("37 23", SamplingContext::BlueNoiseSobolMode, 1 << 24);
+
+        EXPECT_TRUE(are_aligned_and_in_sequence(instances, 1 << 24));
+    }
+}
@@ -28,12 +28,25 @@
 //
 
 // appleseed.renderer headers.
+#include "renderer/modeling/object/meshobject.h"
+#include "renderer/modeling/object/object.h"
+#include "renderer/modeling/object/triangle.h"
 #include "renderer/modeling/project/project.h"
 #include "renderer/modeling/project/projectfilereader.h"
 #include "renderer/modeling/project/projectfilewriter.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/modeling/scene/scene.h"
 
 // appleseed.foundation headers.
+#include "foundation/math/transform.h"
+#include "foundation/math/vector.h"
 #include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/containers/dictionary.h"
+#include "foundation/utility/foreach.h"
+#include "foundation/utility/iostreamop.h"
 #include "foundation/utility/test.h"
 #include "foundation/utility/testutils.h"
 
@@ -41,7 +54,10 @@
 #include "boost/filesystem.hpp"
 
 // Standard headers.
+#include <cstddef>
 #include <exception>
+#include <string>
+#include <vector>
 
 using namespace foundation;
 using namespace renderer;
@@ -75,6 +91,203 @@ TEST_SUITE(Renderer_Modeling_Project_ProjectFileReader)
         EXPECT_TRUE(identical);
     }
 
+    TEST_CASE(ReadWrittenBinaryProject)
+    {
+        ProjectFileReader reader;
+        auto_release_ptr<Project> project =
+            reader.read(
+                "unit tests/inputs/test_projectfilereader_configurationblocks.appleseed",
+                "../../../schemas/project.xsd");    // path relative to input file
+
+        ASSERT_NEQ(0, project.get());
+
+        const bool binary_success =
+            ProjectFileWriter::write(
+                project.ref(),
+                "unit tests/outputs/test_projectfilereader_configurationblocks.appleseedb");
+
+        ASSERT_TRUE(binary_success);
+
+        auto_release_ptr<Project> binary_project =
+            reader.read(
+                "unit tests/outputs/test_projectfilereader_configurationblocks.appleseedb",
+                "../../../schemas/project.xsd");
+
+        ASSERT_NEQ(0, binary_project.get());
+
+        const bool success =
+            ProjectFileWriter::write(
+                binary_project.ref(),
+                "unit tests/outputs/test_projectfilereader_configurationblocks_frombinary.appleseed",
+                ProjectFileWriter::OmitHeaderComment);
+
+        ASSERT_TRUE(success);
+
+        const bool identical =
+            compare_text_files(
+                "unit tests/inputs/test_projectfilereader_configurationblocks.appleseed",
+                "unit tests/outputs/test_projectfilereader_configurationblocks_frombinary.appleseed");
+
+        EXPECT_TRUE(identical);
+    }
+
+    auto_release_ptr<Project> create_project_with_inline_mesh()
+    {
+        ProjectFileReader reader;
+        auto_release_ptr<Project> project =
+            reader.read(
+                "unit tests/inputs/test_projectfilereader_configurationblocks.appleseed",
+                "../../../schemas/project.xsd");    // path relative to input file
+
+        if (project.get() == 0)
+            return project;
+
+        auto_release_ptr<Assembly> assembly(AssemblyFactory().create("assembly", ParamArray()));
+
+        auto_release_ptr<MeshObject> mesh_object(MeshObjectFactory::create("mesh", ParamArray()));
+        mesh_object->push_vertex(GVector3(0.0f, 0.0f, 0.0f));
+        mesh_object->push_vertex(GVector3(1.0f, 0.0f, 0.0f));
+        mesh_object->push_vertex(GVector3(1.0f, 1.0f, 0.0f));
+        mesh_object->push_vertex(GVector3(0.0f, 1.0f, 0.0f));
+        mesh_object->push_vertex_normal(GVector3(0.0f, 0.0f, 1.0f));
+        mesh_object->push_tex_coords(GVector2(0.0f, 0.0f));
+        mesh_object->push_tex_coords(GVector2(1.0f, 0.0f));
+        mesh_object->push_tex_coords(GVector2(1.0f, 1.0f));
+        mesh_object->push_tex_coords(GVector2(0.0f, 1.0f));
+        mesh_object->push_triangle(Triangle(0, 1, 2, 0, 0, 0, 0, 1, 2, 0));
+        mesh_object->push_triangle(Triangle(2, 3, 0, 0, 0, 0, 2, 3, 0, 0));
+        mesh_object->push_material_slot("default");
+        assembly->objects().insert(auto_release_ptr<Object>(mesh_object));
+
+        assembly->object_instances().insert(
+            ObjectInstanceFactory::create(
+                "mesh_inst",
+                ParamArray(),
+                "mesh",
+                Transformd::from_local_to_parent(Matrix4d::make_translation(Vector3d(1.0, 2.0, 3.0))),
+                StringDictionary()));
+
+        project->get_scene()->assemblies().insert(assembly);
+
+        project->get_scene()->assembly_instances().insert(
+            AssemblyInstanceFactory::create(
+                "assembly_inst",
+                ParamArray(),
+                "assembly"));
+
+        return project;
+    }
+
+    TEST_CASE(ReadWrittenBinaryProject_PreservesInlineMeshesAndInstances)
+    {
+        auto_release_ptr<Project> project = create_project_with_inline_mesh();
+
+        ASSERT_NEQ(0, project.get());
+
+        const bool binary_success =
+            ProjectFileWriter::write(
+                project.ref(),
+                "unit tests/outputs/test_projectfilereader_inlinemesh.appleseedb");
+
+        ASSERT_TRUE(binary_success);
+
+        ProjectFileReader reader;
+        auto_release_ptr<Project> binary_project =
+            reader.read(
+                "unit tests/outputs/test_projectfilereader_inlinemesh.appleseedb",
+                "../../../schemas/project.xsd");
+
+        ASSERT_NEQ(0, binary_project.get());
+
+        const Scene* scene = binary_project->get_scene();
+        ASSERT_NEQ(0, scene);
+        ASSERT_EQ(1, scene->assembly_instances().size());
+        EXPECT_EQ("assembly", std::string(scene->assembly_instances().get_by_name("assembly_inst")->get_assembly_name()));
+
+        const Assembly* assembly = scene->assemblies().get_by_name("assembly");
+        ASSERT_NEQ(0, assembly);
+        ASSERT_EQ(1, assembly->object_instances().size());
+
+        const ObjectInstance* object_instance = assembly->object_instances().get_by_name("mesh_inst");
+        ASSERT_NEQ(0, object_instance);
+        EXPECT_EQ("mesh", std::string(object_instance->get_object_name()));
+        EXPECT_EQ(
+            Vector3d(1.0, 2.0, 3.0),
+            object_instance->get_transform().get_local_to_parent().extract_translation());
+
+        const Object* object = assembly->objects().get_by_name("mesh");
+        ASSERT_NEQ(0, object);
+        ASSERT_EQ(std::string(MeshObjectFactory::get_model()), std::string(object->get_model()));
+
+        const MeshObject* mesh_object = static_cast<const MeshObject*>(object);
+        const MeshObject* original_mesh_object =
+            static_cast<const MeshObject*>(
+                project->get_scene()->assemblies().get_by_name("assembly")->objects().get_by_name("mesh"));
+
+        ASSERT_EQ(original_mesh_object->get_vertex_count(), mesh_object->get_vertex_count());
+        ASSERT_EQ(original_mesh_object->get_vertex_normal_count(), mesh_object->get_vertex_normal_count());
+        ASSERT_EQ(original_mesh_object->get_tex_coords_count(), mesh_object->get_tex_coords_count());
+        ASSERT_EQ(original_mesh_object->get_triangle_count(), mesh_object->get_triangle_count());
+        ASSERT_EQ(1, mesh_object->get_material_slot_count());
+        EXPECT_EQ("default", std::string(mesh_object->get_material_slot(0)));
+
+        for (size_t i = 0; i < mesh_object->get_vertex_count(); ++i)
+            EXPECT_EQ(original_mesh_object->get_vertex(i), mesh_object->get_vertex(i));
+
+        for (size_t i = 0; i < mesh_object->get_tex_coords_count(); ++i)
+            EXPECT_EQ(original_mesh_object->get_tex_coords(i), mesh_object->get_tex_coords(i));
+
+        for (size_t i = 0; i < mesh_object->get_triangle_count(); ++i)
+        {
+            const Triangle& expected = original_mesh_object->get_triangle(i);
+            const Triangle& triangle = mesh_object->get_triangle(i);
+
+            EXPECT_EQ(expected.m_v0, triangle.m_v0);
+            EXPECT_EQ(expected.m_v1, triangle.m_v1);
+            EXPECT_EQ(expected.m_v2, triangle.m_v2);
+            EXPECT_EQ(expected.m_n0, triangle.m_n0);
+            EXPECT_EQ(expected.m_a1, triangle.m_a1);
+            EXPECT_EQ(expected.m_pa, triangle.m_pa);
+        }
+    }
+
+    std::vector<std::string> read_object_names(const int options)
+    {
+        ProjectFileReader reader;
+        auto_release_ptr<Project> project =
+            reader.read(
+                "unit tests/inputs/test_projectfilereader_parallelmeshloading.appleseed",
+                "../../../schemas/project.xsd",     // path relative to input file
+                options);
+
+        std::vector<std::string> names;
+
+        if (project.get())
+        {
+            const Assembly* assembly = project->get_scene()->assemblies().get_by_name("assembly");
+
+            if (assembly)
+            {
+                for (const_each<ObjectContainer> i = assembly->objects(); i; ++i)
+                    names.push_back(i->get_name());
+            }
+        }
+
+        return names;
+    }
+
+    TEST_CASE(ParallelMeshLoading_PreservesObjectOrder)
+    {
+        const std::vector<std::string> expected = read_object_names(ProjectFileReader::OmitParallelLoading);
+        const std::vector<std::string> names = read_object_names(ProjectFileReader::Defaults);
+
+        ASSERT_EQ(4, expected.size());
+        ASSERT_EQ(expected.size(), names.size());
+
+        for (size_t i = 0; i < names.size(); ++i)
+            EXPECT_EQ(expected[i], names[i]);
+    }
+
     TEST_CASE(ReadValidPackedProject)
     {
         const char* UnpackDirectory = "unit tests/inputs/test_projectfilereader_validpackedproject.unpacked/";
@@ -0,0 +1,380 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/intersection/intersector.h"
+#include "renderer/kernel/intersection/tracecontext.h"
+#include "renderer/kernel/lighting/backwardlightsampler.h"
+#include "renderer/kernel/lighting/ilightingengine.h"
+#include "renderer/kernel/lighting/pt/ptlightingengine.h"
+#include "renderer/kernel/lighting/radiancecache.h"
+#include "renderer/kernel/lighting/tracer.h"
+#include "renderer/kernel/rendering/pixelcontext.h"
+#include "renderer/kernel/rendering/rendererservices.h"
+#include "renderer/kernel/shading/oslshadergroupexec.h"
+#include "renderer/kernel/shading/oslshadingsystem.h"
+#include "renderer/kernel/shading/shadingcomponents.h"
+#include "renderer/kernel/shading/shadingcontext.h"
+#include "renderer/kernel/shading/shadingpoint.h"
+#include "renderer/kernel/shading/shadingray.h"
+#include "renderer/kernel/texturing/oiiotexturesystem.h"
+#include "renderer/kernel/texturing/texturecache.h"
+#include "renderer/kernel/texturing/texturestore.h"
+#include "renderer/modeling/bsdf/bsdf.h"
+#include "renderer/modeling/bsdf/lambertianbrdf.h"
+#include "renderer/modeling/bsdf/specularbrdf.h"
+#include "renderer/modeling/camera/pinholecamera.h"
+#include "renderer/modeling/color/colorentity.h"
+#include "renderer/modeling/entity/onframebeginrecorder.h"
+#include "renderer/modeling/environment/environment.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/modeling/material/genericmaterial.h"
+#include "renderer/modeling/object/meshobject.h"
+#include "renderer/modeling/object/triangle.h"
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/scene/visibilityflags.h"
+#include "renderer/utility/paramarray.h"
+#include "renderer/utility/testutils.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/color.h"
+#include "foundation/math/matrix.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/transform.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/arena.h"
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/containers/dictionary.h"
+#include "foundation/utility/test.h"
+
+// OpenImageIO headers.
+#include "foundation/platform/_beginoiioheaders.h"
+#include "OpenImageIO/texture.h"
+#include "foundation/platform/_endoiioheaders.h"
+
+// Standard headers.
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+TEST_SUITE(Renderer_Kernel_Lighting_PT_PTLightingEngine)
+{
+    //
+    // Two large parallel planes facing each other on either side of the origin.
+    // Paths starting on one plane bounce back and forth between the two planes.
+    //
+
+    struct SceneBase
+    {
+        auto_release_ptr<Project>       m_project;
+        Scene*                          m_scene;
+        Assembly*                       m_assembly;
+
+        SceneBase()
+          : m_project(ProjectFactory::create("project"))
+        {
+            m_project->set_scene(SceneFactory::create());
+            m_scene = m_project->get_scene();
+            m_scene->cameras().insert(
+                PinholeCameraFactory().create(
+                    "camera",
+                    ParamArray()
+                        .insert("film_width", "0.025")
+                        .insert("film_height", "0.025")
+                        .insert("focal_length", "0.035")));
+            m_scene->set_environment(
+                EnvironmentFactory().create("environment", ParamArray()));
+
+            m_project->set_frame(
+                FrameFactory::create(
+                    "frame",
+                    ParamArray()
+                        .insert("resolution", "32 32")
+                        .insert("camera", "camera")));
+
+            m_scene->assemblies().insert(
+                AssemblyFactory().create("assembly", ParamArray()));
+            m_assembly = m_scene->assemblies().get_by_name("assembly");
+
+            m_scene->assembly_instances().insert(
+                AssemblyInstanceFactory::create(
+                    "assembly_inst",
+                    ParamArray(),
+                    "assembly"));
+
+            create_color("white", Color4f(1.0f));
+            create_plane_object();
+        }
+
+        void create_color(const char* name, const Color4f& color)
+        {
+            ParamArray params;
+            params.insert("color_space", "linear_rgb");
+
+            const ColorValueArray color_values(3, &color[0]);
+            const ColorValueArray alpha_values(1, &color[3]);
+
+            m_assembly->colors().insert(
+                ColorEntityFactory::create(name, params, color_values, alpha_values));
+        }
+
+        void create_material(const char* material_name, auto_release_ptr<BSDF> bsdf)
+        {
+            const string bsdf_name = bsdf->get_name();
+            m_assembly->bsdfs().insert(bsdf);
+
+            m_assembly->materials().insert(
+                GenericMaterialFactory().create(
+                    material_name,
+                    ParamArray().insert("bsdf", bsdf_name)));
+        }
+
+        void create_plane_object()
+        {
+            auto_release_ptr<MeshObject> mesh_object =
+                MeshObjectFactory::create("plane", ParamArray());
+
+            mesh_object->push_vertex(GVector3(0.0f, -0.5f, -0.5f));
+            mesh_object->push_vertex(GVector3(0.0f, +0.5f, -0.5f));
+            mesh_object->push_vertex(GVector3(0.0f, +0.5f, +0.5f));
+            mesh_object->push_vertex(GVector3(0.0f, -0.5f, +0.5f));
+
+            mesh_object->push_vertex_normal(GVector3(-1.0f, 0.0f, 0.0f));
+
+            mesh_object->push_triangle(Triangle(0, 1, 2, 0, 0, 0, 0));
+            mesh_object->push_triangle(Triangle(2, 3, 0, 0, 0, 0, 0));
+
+            mesh_object->push_material_slot("material");
+
+            auto_release_ptr<Object> object(mesh_object.release());
+            m_assembly->objects().insert(object);
+        }
+
+        void create_facing_plane_instances(const char* material_name)
+        {
+            StringDictionary material_mappings;
+            material_mappings.insert("material", material_name);
+
+            const Matrix4d scaling = Matrix4d::make_scaling(Vector3d(1.0, 100.0, 100.0));
+
+            // Plane at x = +2 facing the origin.
+            m_assembly->object_instances().insert(
+                ObjectInstanceFactory::create(
+                    "plane_inst1",
+                    ParamArray(),
+                    "plane",
+                    Transformd::from_local_to_parent(
+                        Matrix4d::make_translation(Vector3d(2.0, 0.0, 0.0)) * scaling),
+                    material_mappings,
+                    material_mappings));
+
+            // Plane at x = -2 facing the origin.
+            m_assembly->object_instances().insert(
+                ObjectInstanceFactory::create(
+                    "plane_inst2",
+                    ParamArray(),
+                    "plane",
+                    Transformd::from_local_to_parent(
+                          Matrix4d::make_translation(Vector3d(-2.0, 0.0, 0.0))
+                        * Matrix4d::make_rotation_y(Pi<double>())
+                        * scaling),
+                    material_mappings,
+                    material_mappings));
+        }
+    };
+
+    struct DiffuseScene
+      : public SceneBase
+    {
+        DiffuseScene()
+        {
+            create_material(
+                "diffuse_material",
+                LambertianBRDFFactory().create(
+                    "diffuse_brdf",
+                    ParamArray().insert("reflectance", "white")));
+
+            create_facing_plane_instances("diffuse_material");
+        }
+    };
+
+    struct SpecularScene
+      : public SceneBase
+    {
+        SpecularScene()
+        {
+            create_material(
+                "specular_material",
+                SpecularBRDFFactory().create(
+                    "specular_brdf",
+                    ParamArray().insert("reflectance", "white")));
+
+            create_facing_plane_instances("specular_material");
+        }
+    };
+
+    template <typename Base>
+    struct Fixture
+      : public BindInputs<Base>
+    {
+        TraceContext                            m_trace_context;
+        TextureStore                            m_texture_store;
+        TextureCache                            m_texture_cache;
+        Intersector                             m_intersector;
+        std::shared_ptr<OIIOTextureSystem>      m_texture_system;
+        std::shared_ptr<RendererServices>       m_renderer_services;
+        std::shared_ptr<OSLShadingSystem>       m_shading_system;
+        Arena                                   m_arena;
+        std::shared_ptr<OSLShaderGroupExec>     m_shading_group_exec;
+        OnFrameBeginRecorder                    m_recorder;
+        std::shared_ptr<ShadingContext>         m_shading_context;
+        std::shared_ptr<Tracer>                 m_tracer;
+        std::shared_ptr<BackwardLightSampler>   m_light_sampler;
+
+        Fixture()
+          : m_trace_context(*Base::m_scene)
+          , m_texture_store(*Base::m_scene)
+          , m_texture_cache(m_texture_store)
+          , m_intersector(m_trace_context, m_texture_cache)
+        {
+            m_texture_system.reset(
+                OIIOTextureSystemFactory::create(),
+                [](OIIOTextureSystem* object) { object->release(); });
+            m_renderer_services.reset(
+                new RendererServices(
+                    *Base::m_project,
+                    reinterpret_cast<OIIO::TextureSystem&>(*m_texture_system)));
+            m_shading_system.reset(
+                OSLShadingSystemFactory::create(m_renderer_services.get(), m_texture_system.get()),
+                [](OSLShadingSystem* object) { object->release(); });
+            m_shading_group_exec.reset(new OSLShaderGroupExec(*m_shading_system, m_arena));
+            m_tracer.reset(new Tracer(*Base::m_scene, m_intersector, m_texture_cache, *m_shading_group_exec));
+            m_shading_context.reset(
+                new ShadingContext(
+                    m_intersector,
+                    *m_tracer,
+                    m_texture_cache,
+                    *m_texture_system,
+                    *m_shading_group_exec,
+                    m_arena,
+                    0));
+
+            Base::m_scene->on_frame_begin(Base::m_project.ref(), 0, m_recorder);
+
+            m_light_sampler.reset(new BackwardLightSampler(*Base::m_scene));
+        }
+
+        ~Fixture()
+        {
+            m_recorder.on_frame_end(Base::m_project.ref());
+        }
+
+        // Trace a number of paths starting at the plane at x = +2.
+        void render(ILightingEngine& lighting_engine, const size_t path_count)
+        {
+            SamplingContext::RNGType rng;
+            SamplingContext sampling_context(
+                rng,
+                SamplingContext::RNGMode,
+                0,                          // number of dimensions
+                0,                          // number of samples -- unknown
+                0);                         // initial instance number
+
+            const ShadingRay ray(
+                Vector3d(0.0, 0.0, 0.0),
+                Vector3d(1.0, 0.0, 0.0),
+                ShadingRay::Time(),
+                VisibilityFlags::CameraRay,
+                0);                         // depth
+
+            for (size_t i = 0; i < path_count; ++i)
+            {
+                m_arena.clear();
+
+                ShadingPoint shading_point;
+                m_intersector.trace(ray, shading_point);
+                assert(shading_point.hit());
+
+                ShadingComponents radiance;
+                lighting_engine.compute_lighting(
+                    sampling_context,
+                    PixelContext(Vector2i(0, 0), Vector2d(0.5, 0.5)),
+                    *m_shading_context,
+                    shading_point,
+                    radiance);
+            }
+        }
+    };
+
+    ParamArray make_radiance_cache_params()
+    {
+        return
+            ParamArray()
+                .insert("enable_dl", false)
+                .insert("enable_ibl", false)
+                .insert("enable_radiance_cache", true)
+                .insert("radiance_cache_cell_size", 0.1f)
+                .insert("radiance_cache_min_samples", 1);
+    }
+
+    TEST_CASE_F(ComputeLighting_GivenDiffuseSceneAndRadianceCache_TerminatesPathsIntoRadianceCache, Fixture<DiffuseScene>)
+    {
+        PTLightingEngineFactory factory(*m_light_sampler, make_radiance_cache_params());
+        auto_release_ptr<ILightingEngine> lighting_engine(factory.create());
+
+        render(*lighting_engine, 64);
+
+        const RadianceCache* radiance_cache = factory.get_radiance_cache();
+        ASSERT_TRUE(radiance_cache != nullptr);
+        EXPECT_GT(0, radiance_cache->get_entry_count());
+        EXPECT_GT(0, radiance_cache->get_hit_count());
+    }
+
+    TEST_CASE_F(ComputeLighting_GivenSpecularSceneAndRadianceCache_NeverUsesRadianceCache, Fixture<SpecularScene>)
+    {
+        PTLightingEngineFactory factory(*m_light_sampler, make_radiance_cache_params());
+        auto_release_ptr<ILightingEngine> lighting_engine(factory.create());
+
+        render(*lighting_engine, 64);
+
+        const RadianceCache* radiance_cache = factory.get_radiance_cache();
+        ASSERT_TRUE(radiance_cache != nullptr);
+        EXPECT_EQ(0, radiance_cache->get_entry_count());
+        EXPECT_EQ(0, radiance_cache->get_hit_count());
+    }
+}
@@ -0,0 +1,103 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/lighting/radiancecache.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Lighting_RadianceCache)
+{
+    TEST_CASE(MakeKey_GivenPointsInSameCell_ReturnsSameKey)
+    {
+        const Vector3f n(0.0f, 1.0f, 0.0f);
+
+        EXPECT_EQ(
+            RadianceCache::make_key(Vector3f(0.1f, 0.2f, 0.3f), n, 1.0f),
+            RadianceCache::make_key(Vector3f(0.9f, 0.8f, 0.7f), n, 1.0f));
+    }
+
+    TEST_CASE(MakeKey_GivenPointsInDifferentCells_ReturnsDifferentKeys)
+    {
+        const Vector3f n(0.0f, 1.0f, 0.0f);
+
+        EXPECT_NEQ(
+            RadianceCache::make_key(Vector3f(0.5f, 0.5f, 0.5f), n, 1.0f),
+            RadianceCache::make_key(Vector3f(-0.5f, 0.5f, 0.5f), n, 1.0f));
+    }
+
+    TEST_CASE(MakeKey_GivenOppositeNormals_ReturnsDifferentKeys)
+    {
+        const Vector3f p(0.5f, 0.5f, 0.5f);
+
+        EXPECT_NEQ(
+            RadianceCache::make_key(p, Vector3f(0.0f, 1.0f, 0.0f), 1.0f),
+            RadianceCache::make_key(p, Vector3f(0.0f, -1.0f, 0.0f), 1.0f));
+    }
+
+    TEST_CASE(Lookup_GivenEmptyCache_ReturnsFalse)
+    {
+        const RadianceCache cache(64, 1);
+        const uint64 key = RadianceCache::make_key(Vector3f(0.0f), Vector3f(0.0f, 1.0f, 0.0f), 1.0f);
+
+        Spectrum radiance;
+        EXPECT_FALSE(cache.lookup(key, radiance));
+    }
+
+    TEST_CASE(Lookup_GivenTooFewSamples_ReturnsFalse)
+    {
+        RadianceCache cache(64, 2);
+        const uint64 key = RadianceCache::make_key(Vector3f(0.0f), Vector3f(0.0f, 1.0f, 0.0f), 1.0f);
+        cache.record(key, Spectrum(1.0f));
+
+        Spectrum radiance;
+        EXPECT_FALSE(cache.lookup(key, radiance));
+    }
+
+    TEST_CASE(Lookup_GivenEnoughSamples_ReturnsAverageRadiance)
+    {
+        RadianceCache cache(64, 2);
+        const uint64 key = RadianceCache::make_key(Vector3f(0.0f), Vector3f(0.0f, 1.0f, 0.0f), 1.0f);
+        cache.record(key, Spectrum(1.0f));
+        cache.record(key, Spectrum(3.0f));
+
+        Spectrum radiance;
+        ASSERT_TRUE(cache.lookup(key, radiance));
+        EXPECT_FEQ(2.0f, radiance[0]);
+        EXPECT_EQ(1, cache.get_entry_count());
+        EXPECT_EQ(1, cache.get_hit_count());
+    }
+}
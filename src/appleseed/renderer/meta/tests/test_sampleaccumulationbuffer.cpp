@@ -0,0 +1,201 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/kernel/rendering/globalsampleaccumulationbuffer.h"
+#include "renderer/kernel/rendering/localsampleaccumulationbuffer.h"
+#include "renderer/kernel/rendering/sample.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/color.h"
+#include "foundation/image/image.h"
+#include "foundation/math/filter.h"
+#include "foundation/math/rng/distribution.h"
+#include "foundation/math/rng/mersennetwister.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/bufferedfile.h"
+#include "foundation/utility/job/abortswitch.h"
+#include "foundation/utility/test.h"
+#include "foundation/utility/testutils.h"
+
+// Boost headers.
+#include "boost/filesystem.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+namespace bf = boost::filesystem;
+
+TEST_SUITE(Renderer_Kernel_Rendering_SampleAccumulationBuffer)
+{
+    const char* CheckpointPath = "unit tests/outputs/test_sampleaccumulationbuffer.checkpoint";
+
+    void store_random_samples(SampleAccumulationBuffer& buffer, const size_t sample_count)
+    {
+        MersenneTwister rng;
+        vector<Sample> samples(sample_count);
+
+        for (size_t i = 0; i < sample_count; ++i)
+        {
+            samples[i].m_position = Vector2f(rand_float1(rng), rand_float1(rng));
+            samples[i].m_color = Color4f(rand_float1(rng), rand_float1(rng), rand_float1(rng), 1.0f);
+        }
+
+        AbortSwitch abort_switch;
+        buffer.store_samples(sample_count, &samples[0], abort_switch);
+    }
+
+    bool write_checkpoint(SampleAccumulationBuffer& buffer)
+    {
+        BufferedFile file;
+        if (!file.open(CheckpointPath, BufferedFile::BinaryType, BufferedFile::WriteMode))
+            return false;
+
+        const bool success = buffer.write_checkpoint(file);
+        return file.close() && success;
+    }
+
+    bool read_checkpoint(SampleAccumulationBuffer& buffer)
+    {
+        BufferedFile file;
+        if (!file.open(CheckpointPath, BufferedFile::BinaryType, BufferedFile::ReadMode))
+            return false;
+
+        return buffer.read_checkpoint(file);
+    }
+
+    auto_release_ptr<Frame> develop(SampleAccumulationBuffer& buffer)
+    {
+        auto_release_ptr<Frame> frame(
+            FrameFactory::create("frame", ParamArray().insert("resolution", "32 32")));
+
+        AbortSwitch abort_switch;
+        buffer.develop_to_frame(frame.ref(), abort_switch);
+
+        return frame;
+    }
+
+    bool develop_to_same_image(
+        SampleAccumulationBuffer&   buffer1,
+        SampleAccumulationBuffer&   buffer2)
+    {
+        auto_release_ptr<Frame> frame1 = develop(buffer1);
+        auto_release_ptr<Frame> frame2 = develop(buffer2);
+
+        return are_images_feq(frame1->image(), frame2->image(), 1.0e-6f);
+    }
+
+    TEST_CASE(GlobalBuffer_CheckpointRoundTrip_PreservesContent)
+    {
+        const BoxFilter2<float> filter(0.5f, 0.5f);
+
+        GlobalSampleAccumulationBuffer buffer(32, 32, filter);
+        store_random_samples(buffer, 5000);
+        ASSERT_TRUE(write_checkpoint(buffer));
+
+        GlobalSampleAccumulationBuffer restored_buffer(32, 32, filter);
+        ASSERT_TRUE(read_checkpoint(restored_buffer));
+
+        EXPECT_EQ(buffer.get_sample_count(), restored_buffer.get_sample_count());
+        EXPECT_TRUE(develop_to_same_image(buffer, restored_buffer));
+    }
+
+    TEST_CASE(GlobalBuffer_ReadCheckpoint_GivenDifferentSize_ReturnsFalse)
+    {
+        const BoxFilter2<float> filter(0.5f, 0.5f);
+
+        GlobalSampleAccumulationBuffer buffer(32, 32, filter);
+        store_random_samples(buffer, 100);
+        ASSERT_TRUE(write_checkpoint(buffer));
+
+        GlobalSampleAccumulationBuffer restored_buffer(16, 32, filter);
+        EXPECT_FALSE(read_checkpoint(restored_buffer));
+    }
+
+    TEST_CASE(GlobalBuffer_ReadCheckpoint_GivenTruncatedFile_ReturnsFalse)
+    {
+        const BoxFilter2<float> filter(0.5f, 0.5f);
+
+        GlobalSampleAccumulationBuffer buffer(32, 32, filter);
+        store_random_samples(buffer, 100);
+        ASSERT_TRUE(write_checkpoint(buffer));
+
+        bf::resize_file(CheckpointPath, bf::file_size(CheckpointPath) - 1);
+
+        GlobalSampleAccumulationBuffer restored_buffer(32, 32, filter);
+        EXPECT_FALSE(read_checkpoint(restored_buffer));
+    }
+
+    TEST_CASE(LocalBuffer_CheckpointRoundTrip_PreservesContent)
+    {
+        const BoxFilter2<float> filter(0.5f, 0.5f);
+
+        LocalSampleAccumulationBuffer buffer(32, 32, filter);
+        store_random_samples(buffer, 5000);
+        ASSERT_TRUE(write_checkpoint(buffer));
+
+        LocalSampleAccumulationBuffer restored_buffer(32, 32, filter);
+        ASSERT_TRUE(read_checkpoint(restored_buffer));
+
+        EXPECT_EQ(buffer.get_sample_count(), restored_buffer.get_sample_count());
+        EXPECT_TRUE(develop_to_same_image(buffer, restored_buffer));
+    }
+
+    TEST_CASE(LocalBuffer_ReadCheckpoint_GivenDifferentSize_ReturnsFalse)
+    {
+        const BoxFilter2<float> filter(0.5f, 0.5f);
+
+        LocalSampleAccumulationBuffer buffer(32, 32, filter);
+        store_random_samples(buffer, 100);
+        ASSERT_TRUE(write_checkpoint(buffer));
+
+        LocalSampleAccumulationBuffer restored_buffer(16, 32, filter);
+        EXPECT_FALSE(read_checkpoint(restored_buffer));
+    }
+
+    TEST_CASE(LocalBuffer_ReadCheckpoint_GivenTruncatedFile_ReturnsFalse)
+    {
+        const BoxFilter2<float> filter(0.5f, 0.5f);
+
+        LocalSampleAccumulationBuffer buffer(32, 32, filter);
+        store_random_samples(buffer, 100);
+        ASSERT_TRUE(write_checkpoint(buffer));
+
+        bf::resize_file(CheckpointPath, bf::file_size(CheckpointPath) - 1);
+
+        LocalSampleAccumulationBuffer restored_buffer(32, 32, filter);
+        EXPECT_FALSE(read_checkpoint(restored_buffer));
+    }
+}
@@ -0,0 +1,191 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/kernel/rendering/sample.h"
+#include "renderer/kernel/rendering/sampleaccumulationbuffer.h"
+#include "renderer/kernel/rendering/samplegeneratorbase.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/job/abortswitch.h"
+#include "foundation/utility/statistics.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cstddef>
+#include <set>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+TEST_SUITE(Renderer_Kernel_Rendering_SampleGeneratorBase)
+{
+    class NullSampleAccumulationBuffer
+      : public SampleAccumulationBuffer
+    {
+      public:
+        virtual void clear() override
+        {
+        }
+
+        virtual void store_samples(
+            const size_t                sample_count,
+            const Sample                samples[],
+            IAbortSwitch&               abort_switch) override
+        {
+        }
+
+        virtual void develop_to_frame(
+            Frame&                      frame,
+            IAbortSwitch&               abort_switch) override
+        {
+        }
+
+        virtual bool write_checkpoint(BufferedFile& file) override
+        {
+            return true;
+        }
+
+        virtual bool read_checkpoint(BufferedFile& file) override
+        {
+            return true;
+        }
+    };
+
+    // A sample generator that records the sequence indices it is asked to use.
+    class RecordingSampleGenerator
+      : public SampleGeneratorBase
+    {
+      public:
+        RecordingSampleGenerator(
+            const size_t                generator_index,
+            const size_t                generator_count)
+          : SampleGeneratorBase(generator_index, generator_count)
+        {
+        }
+
+        using SampleGeneratorBase::generate_samples;
+
+        virtual void release() override
+        {
+            delete this;
+        }
+
+        virtual StatisticsVector get_statistics() const override
+        {
+            return StatisticsVector();
+        }
+
+        vector<size_t> m_sequence_indices;
+
+      private:
+        virtual size_t generate_samples(
+            const size_t                sequence_index,
+            SampleVector&               samples) override
+        {
+            m_sequence_indices.push_back(sequence_index);
+            samples.push_back(Sample());
+            return 1;
+        }
+    };
+
+    // Render with a given number of generators, restart all generators past the
+    // bound reported by the first run, render again and check that no sequence
+    // index is used twice across both runs.
+    bool skip_sequence_never_reissues_indices(const size_t generator_count)
+    {
+        NullSampleAccumulationBuffer buffer;
+        AbortSwitch abort_switch;
+
+        vector<RecordingSampleGenerator*> generators;
+        for (size_t i = 0; i < generator_count; ++i)
+            generators.push_back(new RecordingSampleGenerator(i, generator_count));
+
+        // Generators progress at different paces, and stop in the middle of batches.
+        for (size_t i = 0; i < generator_count; ++i)
+            generators[i]->generate_samples(50 + 97 * i, buffer, abort_switch);
+
+        size_t bound = 0;
+        for (size_t i = 0; i < generator_count; ++i)
+            bound = max(bound, generators[i]->get_sequence_bound());
+
+        set<size_t> used;
+        bool success = true;
+
+        for (size_t i = 0; i < generator_count; ++i)
+        {
+            for (size_t j = 0; j < generators[i]->m_sequence_indices.size(); ++j)
+            {
+                const size_t index = generators[i]->m_sequence_indices[j];
+                success = success && index < bound && used.insert(index).second;
+            }
+
+            generators[i]->m_sequence_indices.clear();
+            generators[i]->skip_sequence(bound);
+        }
+
+        for (size_t i = 0; i < generator_count; ++i)
+            generators[i]->generate_samples(300, buffer, abort_switch);
+
+        for (size_t i = 0; i < generator_count; ++i)
+        {
+            for (size_t j = 0; j < generators[i]->m_sequence_indices.size(); ++j)
+            {
+                const size_t index = generators[i]->m_sequence_indices[j];
+                success = success && index >= bound && used.insert(index).second;
+            }
+
+            generators[i]->release();
+        }
+
+        return success;
+    }
+
+    TEST_CASE(SkipSequence_GivenSingleGenerator_NeverReissuesIndices)
+    {
+        EXPECT_TRUE(skip_sequence_never_reissues_indices(1));
+    }
+
+    TEST_CASE(SkipSequence_GivenTwoGenerators_NeverReissuesIndices)
+    {
+        EXPECT_TRUE(skip_sequence_never_reissues_indices(2));
+    }
+
+    TEST_CASE(SkipSequence_GivenThreeGenerators_NeverReissuesIndices)
+    {
+        EXPECT_TRUE(skip_sequence_never_reissues_indices(3));
+    }
+
+    TEST_CASE(SkipSequence_GivenEightGenerators_NeverReissuesIndices)
+    {
+        EXPECT_TRUE(skip_sequence_never_reissues_indices(8));
+    }
+}
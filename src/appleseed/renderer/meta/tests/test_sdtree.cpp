@@ -0,0 +1,116 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/kernel/lighting/sdtree.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/aabb.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Lighting_SDTree)
+{
+    TEST_CASE(DTreePdf_GivenEmptyTree_ReturnsZero)
+    {
+        const DTree dtree;
+
+        EXPECT_EQ(0.0f, dtree.pdf(Vector3f(0.0f, 1.0f, 0.0f)));
+    }
+
+    TEST_CASE(DTreePdf_GivenSingleRecordedDirection_ReturnsPdfOfQuadrant)
+    {
+        const Vector3f direction = normalize(Vector3f(1.0f, 0.5f, 1.0f));
+
+        DTree dtree;
+        dtree.record(direction, 1.0f);
+
+        // The whole distribution is concentrated in one quadrant, i.e. one quarter of the sphere.
+        EXPECT_FEQ(RcpPi<float>(), dtree.pdf(direction));
+        EXPECT_EQ(0.0f, dtree.pdf(-direction));
+    }
+
+    TEST_CASE(DTreeSample_GivenRefinedTree_ReturnsPdfConsistentWithPdfMethod)
+    {
+        const Vector3f direction = normalize(Vector3f(1.0f, 0.5f, 1.0f));
+
+        DTree dtree;
+        dtree.record(direction, 3.0f);
+        dtree.record(-direction, 1.0f);
+
+        DTree refined;
+        dtree.build_refined(refined, 0.01f, 20);
+        refined.record(direction, 3.0f);
+        refined.record(-direction, 1.0f);
+
+        for (size_t i = 0; i < 16; ++i)
+        {
+            const Vector2f s(
+                (i % 4 + 0.5f) / 4.0f,
+                (i / 4 + 0.5f) / 4.0f);
+
+            float pdf;
+            const Vector3f sampled = refined.sample(s, pdf);
+
+            EXPECT_FEQ_EPS(pdf, refined.pdf(sampled), 1.0e-3f);
+        }
+    }
+
+    TEST_CASE(DTreeRecord_CountsSamples)
+    {
+        DTree dtree;
+        dtree.record(Vector3f(0.0f, 1.0f, 0.0f), 1.0f);
+        dtree.record(Vector3f(0.0f, -1.0f, 0.0f), 2.0f);
+
+        EXPECT_EQ(2, dtree.get_sample_count());
+        EXPECT_FEQ(3.0f, dtree.get_sum());
+    }
+
+    TEST_CASE(DTreeRecord_IgnoresZeroRadiance)
+    {
+        DTree dtree;
+        dtree.record(Vector3f(0.0f, 1.0f, 0.0f), 0.0f);
+
+        EXPECT_EQ(0, dtree.get_sample_count());
+    }
+
+    TEST_CASE(STreeGetDTreeWrapper_GivenSingleLeaf_ReturnsSameWrapperForAllPoints)
+    {
+        STree stree(AABB3f(Vector3f(0.0f), Vector3f(1.0f)));
+
+        EXPECT_EQ(1, stree.get_leaf_count());
+        EXPECT_EQ(
+            stree.get_dtree_wrapper(Vector3f(0.1f)),
+            stree.get_dtree_wrapper(Vector3f(0.9f)));
+    }
+}
@@ -0,0 +1,102 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/kernel/shading/shadingpoint.h"
+#include "renderer/modeling/scene/visibilityflags.h"
+#include "renderer/modeling/shadergroup/shadergroup.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/test.h"
+
+using namespace foundation;
+using namespace renderer;
+
+TEST_SUITE(Renderer_Kernel_Shading_ShadingPoint)
+{
+    TEST_CASE(HasOSLClosures_GivenRecordedExecution_ReturnsTrue)
+    {
+        auto_release_ptr<ShaderGroup> shader_group(ShaderGroupFactory::create("shader_group"));
+        ShadingPoint shading_point;
+
+        shading_point.set_osl_closures(shader_group.ref(), VisibilityFlags::CameraRay, 1);
+
+        EXPECT_TRUE(shading_point.has_osl_closures(shader_group.ref(), VisibilityFlags::CameraRay, 1));
+    }
+
+    TEST_CASE(HasOSLClosures_GivenLaterExecution_ReturnsFalse)
+    {
+        auto_release_ptr<ShaderGroup> shader_group(ShaderGroupFactory::create("shader_group"));
+        ShadingPoint shading_point;
+
+        shading_point.set_osl_closures(shader_group.ref(), VisibilityFlags::CameraRay, 1);
+
+        // Another shading point was shaded since, overwriting the closures.
+        EXPECT_FALSE(shading_point.has_osl_closures(shader_group.ref(), VisibilityFlags::CameraRay, 2));
+    }
+
+    TEST_CASE(HasOSLClosures_GivenDifferentShaderGroupOrRayType_ReturnsFalse)
+    {
+        auto_release_ptr<ShaderGroup> shader_group(ShaderGroupFactory::create("shader_group"));
+        auto_release_ptr<ShaderGroup> other_shader_group(ShaderGroupFactory::create("other_shader_group"));
+        ShadingPoint shading_point;
+
+        shading_point.set_osl_closures(shader_group.ref(), VisibilityFlags::CameraRay, 1);
+
+        EXPECT_FALSE(shading_point.has_osl_closures(other_shader_group.ref(), VisibilityFlags::CameraRay, 1));
+        EXPECT_FALSE(shading_point.has_osl_closures(shader_group.ref(), VisibilityFlags::ShadowRay, 1));
+    }
+
+    TEST_CASE(HasOSLClosures_GivenClearedShadingPoint_ReturnsFalse)
+    {
+        auto_release_ptr<ShaderGroup> shader_group(ShaderGroupFactory::create("shader_group"));
+        ShadingPoint shading_point;
+
+        shading_point.set_osl_closures(shader_group.ref(), VisibilityFlags::CameraRay, 1);
+
+        // The same shading point object is reused for a new intersection.
+        shading_point.clear();
+
+        EXPECT_FALSE(shading_point.has_osl_closures(shader_group.ref(), VisibilityFlags::CameraRay, 1));
+    }
+
+    TEST_CASE(HasOSLClosures_GivenReassignedShadingPoint_ReturnsFalse)
+    {
+        auto_release_ptr<ShaderGroup> shader_group(ShaderGroupFactory::create("shader_group"));
+        ShadingPoint shading_point;
+        const ShadingPoint other_shading_point;
+
+        shading_point.set_osl_closures(shader_group.ref(), VisibilityFlags::CameraRay, 1);
+
+        shading_point = other_shading_point;
+
+        EXPECT_FALSE(shading_point.has_osl_closures(shader_group.ref(), VisibilityFlags::CameraRay, 1));
+    }
+}
@@ -0,0 +1,195 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/kernel/volume/occupancygrid.h"
+#include "renderer/kernel/volume/sparsevoxelgrid.h"
+#include "renderer/kernel/volume/volume.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/vector.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cstddef>
+#include <memory>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+TEST_SUITE(Renderer_Kernel_Volume_SparseVoxelGrid)
+{
+    // A voxel source backed by a dense voxel grid, counting the voxels read from it.
+    class DenseVoxelSource
+      : public IVoxelSource
+    {
+      public:
+        DenseVoxelSource(
+            const VoxelGrid&    grid,
+            size_t&             read_voxel_count)
+          : m_grid(grid)
+          , m_read_voxel_count(read_voxel_count)
+        {
+        }
+
+        virtual bool read_voxels(
+            const size_t        x0,
+            const size_t        x1,
+            const size_t        y0,
+            const size_t        y1,
+            const size_t        z0,
+            const size_t        z1,
+            float*              values) override
+        {
+            const size_t channel_count = m_grid.get_channel_count();
+
+            for (size_t z = z0; z < z1; ++z)
+            {
+                for (size_t y = y0; y < y1; ++y)
+                {
+                    for (size_t x = x0; x < x1; ++x)
+                    {
+                        const float* voxel = m_grid.voxel(x, y, z);
+                        for (size_t c = 0; c < channel_count; ++c)
+                            *values++ = voxel[c];
+                        ++m_read_voxel_count;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+      private:
+        const VoxelGrid&    m_grid;
+        size_t&             m_read_voxel_count;
+    };
+
+    // A 20^3 grid with two channels, empty except for a small blob in one corner.
+    struct Fixture
+    {
+        VoxelGrid   m_dense_grid;
+        size_t      m_read_voxel_count;
+
+        Fixture()
+          : m_dense_grid(20, 20, 20, 2)
+          , m_read_voxel_count(0)
+        {
+            for (size_t z = 0; z < 6; ++z)
+            {
+                for (size_t y = 0; y < 6; ++y)
+                {
+                    for (size_t x = 0; x < 6; ++x)
+                    {
+                        float* voxel = m_dense_grid.voxel(x, y, z);
+                        voxel[0] = 1.0f;
+                        voxel[1] = static_cast<float>(x + y + z);
+                    }
+                }
+            }
+        }
+
+        auto_ptr<SparseVoxelGrid> make_sparse_grid()
+        {
+            auto_ptr<SparseVoxelGrid> grid(
+                new SparseVoxelGrid(
+                    20, 20, 20, 2,
+                    auto_ptr<IVoxelSource>(new DenseVoxelSource(m_dense_grid, m_read_voxel_count)),
+                    1024 * 1024));
+
+            grid->initialize();
+            m_read_voxel_count = 0;
+
+            return grid;
+        }
+    };
+
+    TEST_CASE_F(Initialize_ComputesBrickSummaries, Fixture)
+    {
+        const auto_ptr<SparseVoxelGrid> grid = make_sparse_grid();
+
+        ASSERT_EQ(3, grid->get_brick_xcount());
+        EXPECT_FALSE(grid->is_constant_brick(0, 0, 0));
+        EXPECT_TRUE(grid->is_constant_brick(1, 0, 0));
+        EXPECT_TRUE(grid->is_constant_brick(2, 2, 2));
+        EXPECT_EQ(0.0f, grid->get_brick_min(0, 0, 0, 1));
+        EXPECT_EQ(15.0f, grid->get_brick_max(0, 0, 0, 1));
+        EXPECT_EQ(0.0f, grid->get_brick_max(2, 2, 2, 0));
+    }
+
+    TEST_CASE_F(LinearLookup_InEmptyRegion_DoesNotLoadAnyBrick, Fixture)
+    {
+        const auto_ptr<SparseVoxelGrid> grid = make_sparse_grid();
+
+        float values[2];
+        grid->linear_lookup(Vector3d(0.8, 0.8, 0.8), values);
+
+        EXPECT_EQ(0.0f, values[0]);
+        EXPECT_EQ(0.0f, values[1]);
+        EXPECT_EQ(0, m_read_voxel_count);
+    }
+
+    TEST_CASE_F(LinearLookup_MatchesDenseGrid, Fixture)
+    {
+        const auto_ptr<SparseVoxelGrid> grid = make_sparse_grid();
+
+        const Vector3d points[] =
+        {
+            Vector3d(0.0, 0.0, 0.0),
+            Vector3d(0.1, 0.15, 0.2),
+            Vector3d(0.26, 0.3, 0.21),
+            Vector3d(0.5, 0.5, 0.5)
+        };
+
+        for (size_t i = 0; i < 4; ++i)
+        {
+            float expected[2], values[2];
+            m_dense_grid.linear_lookup(points[i], expected);
+            grid->linear_lookup(points[i], values);
+
+            EXPECT_FEQ_EPS(expected[0], values[0], 1.0e-3f);
+            EXPECT_FEQ_EPS(expected[1], values[1], 1.0e-3f);
+        }
+
+        EXPECT_NEQ(0, m_read_voxel_count);
+    }
+
+    TEST_CASE_F(OccupancyGrid_BuiltFromBrickSummaries_BoundsDensity, Fixture)
+    {
+        const auto_ptr<SparseVoxelGrid> grid = make_sparse_grid();
+        const OccupancyGrid occupancy_grid(*grid, 0, 0.0f);
+
+        ASSERT_EQ(3, occupancy_grid.get_xres());
+        EXPECT_EQ(1.0f, occupancy_grid.get_majorant(0, 0, 0));
+        EXPECT_EQ(0.0f, occupancy_grid.get_majorant(2, 2, 2));
+        EXPECT_EQ(1.0f, occupancy_grid.get_max_majorant());
+        EXPECT_EQ(0, m_read_voxel_count);
+    }
+}
@@ -311,6 +311,19 @@ TEST_SUITE(Renderer_Modeling_BSSRDF_SSS)
         }
     }
 
+    TEST_CASE(BSSRDFReparam_AlphaPrimeTable_MatchesNumericalSolution)
+    {
+        for (size_t i = 0, e = countof(RDs); i < e; ++i)
+        {
+            const ComputeRdBetterDipole f(IORs[i]);
+            AlphaPrimeTable table;
+            table.initialize(f);
+
+            const float rd = RDs[i];
+            EXPECT_FEQ_EPS(compute_alpha_prime(f, rd), compute_alpha_prime(table, rd), 1.0e-4f);
+        }
+    }
+
     TEST_CASE(BSSRDFReparam_StandardDipole_SigmasRdMfpSigmasRoundTrip)
     {
         //
@@ -694,6 +707,19 @@ TEST_SUITE(Renderer_Modeling_BSSRDF_SSS)
         plotfile.write("unit tests/outputs/test_sss_normalized_diffusion_cdf.gnuplot");
     }
 
+    TEST_CASE(NormalizedDiffusion_Sample_InvertsCDF)
+    {
+        const float l = 0.7f;
+        const float s = normalized_diffusion_s_mfp(0.5f);
+
+        for (size_t i = 0; i < 10; ++i)
+        {
+            const float u = static_cast<float>(i) / 10;
+            const float r = normalized_diffusion_sample(u, l, s);
+            EXPECT_FEQ_EPS(u, normalized_diffusion_cdf(r, l, s), 1.0e-5f);
+        }
+    }
+
     TEST_CASE(NormalizedDiffusion_MaxRadius)
     {
         MersenneTwister rng;
@@ -0,0 +1,214 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+// appleseed.renderer headers.
+#include "renderer/kernel/rendering/checkpoint.h"
+#include "renderer/kernel/rendering/generic/tilecheckpoint.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/image/canvasproperties.h"
+#include "foundation/image/color.h"
+#include "foundation/image/image.h"
+#include "foundation/image/tile.h"
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/test.h"
+
+// Boost headers.
+#include "boost/filesystem.hpp"
+
+// Standard headers.
+#include <cstddef>
+
+using namespace foundation;
+using namespace renderer;
+namespace bf = boost::filesystem;
+
+TEST_SUITE(Renderer_Kernel_Rendering_Generic_TileCheckpoint)
+{
+    const char* CheckpointPath = "unit tests/outputs/test_tilecheckpoint.checkpoint";
+
+    auto_release_ptr<Frame> create_frame(const char* tile_size)
+    {
+        return
+            FrameFactory::create(
+                "frame",
+                ParamArray()
+                    .insert("resolution", "64 32")
+                    .insert("tile_size", tile_size));
+    }
+
+    CheckpointParameters make_params(const bool resume)
+    {
+        return
+            CheckpointParameters(
+                ParamArray()
+                    .insert("checkpoint_path", CheckpointPath)
+                    .insert("checkpoint_resume", resume)
+                    .insert("checkpoint_interval", 1000.0));
+    }
+
+    Color4f get_tile_color(const size_t tile_x, const size_t tile_y)
+    {
+        return Color4f(static_cast<float>(tile_x + 1), static_cast<float>(tile_y + 1), 0.5f, 1.0f);
+    }
+
+    void fill_tile(Frame& frame, const size_t tile_x, const size_t tile_y)
+    {
+        Tile& tile = frame.image().tile(tile_x, tile_y);
+
+        for (size_t y = 0; y < tile.get_height(); ++y)
+        {
+            for (size_t x = 0; x < tile.get_width(); ++x)
+                tile.set_pixel(x, y, get_tile_color(tile_x, tile_y));
+        }
+    }
+
+    bool is_tile_restored(const Frame& frame, const size_t tile_x, const size_t tile_y)
+    {
+        const Tile& tile = frame.image().tile(tile_x, tile_y);
+
+        for (size_t y = 0; y < tile.get_height(); ++y)
+        {
+            for (size_t x = 0; x < tile.get_width(); ++x)
+            {
+                Color4f color;
+                tile.get_pixel(x, y, color);
+
+                if (color != get_tile_color(tile_x, tile_y))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Render tiles (0, 0), (2, 0) and (1, 1) of a 4x2 tiles frame and save a checkpoint.
+    void write_checkpoint()
+    {
+        auto_release_ptr<Frame> frame(create_frame("16 16"));
+        frame->image().clear(Color4f(0.0f));
+
+        TileCheckpoint checkpoint(frame.ref(), make_params(false));
+        checkpoint.on_render_begin();
+
+        fill_tile(frame.ref(), 0, 0);
+        checkpoint.on_tile_complete(0, 0);
+
+        fill_tile(frame.ref(), 2, 0);
+        checkpoint.on_tile_complete(2, 0);
+
+        fill_tile(frame.ref(), 1, 1);
+        checkpoint.on_tile_complete(1, 1);
+
+        checkpoint.save();
+    }
+
+    size_t count_complete_tiles(const Frame& frame, const TileCheckpoint& checkpoint)
+    {
+        const CanvasProperties& props = frame.image().properties();
+        size_t count = 0;
+
+        for (size_t y = 0; y < props.m_tile_count_y; ++y)
+        {
+            for (size_t x = 0; x < props.m_tile_count_x; ++x)
+            {
+                if (checkpoint.is_tile_complete(x, y))
+                    ++count;
+            }
+        }
+
+        return count;
+    }
+
+    TEST_CASE(Resume_RestoresCompleteTiles)
+    {
+        write_checkpoint();
+
+        auto_release_ptr<Frame> frame(create_frame("16 16"));
+        frame->image().clear(Color4f(0.0f));
+
+        TileCheckpoint checkpoint(frame.ref(), make_params(true));
+        checkpoint.on_render_begin();
+
+        EXPECT_EQ(3, count_complete_tiles(frame.ref(), checkpoint));
+        EXPECT_TRUE(checkpoint.is_tile_complete(0, 0));
+        EXPECT_TRUE(checkpoint.is_tile_complete(2, 0));
+        EXPECT_TRUE(checkpoint.is_tile_complete(1, 1));
+
+        EXPECT_TRUE(is_tile_restored(frame.ref(), 0, 0));
+        EXPECT_TRUE(is_tile_restored(frame.ref(), 2, 0));
+        EXPECT_TRUE(is_tile_restored(frame.ref(), 1, 1));
+        EXPECT_FALSE(is_tile_restored(frame.ref(), 1, 0));
+    }
+
+    TEST_CASE(Resume_GivenDifferentTileLayout_RestoresNothing)
+    {
+        write_checkpoint();
+
+        auto_release_ptr<Frame> frame(create_frame("32 32"));
+        frame->image().clear(Color4f(0.0f));
+
+        TileCheckpoint checkpoint(frame.ref(), make_params(true));
+        checkpoint.on_render_begin();
+
+        EXPECT_EQ(0, count_complete_tiles(frame.ref(), checkpoint));
+    }
+
+    TEST_CASE(Resume_GivenTruncatedFile_RestoresTilesBeforeTruncation)
+    {
+        write_checkpoint();
+
+        // Cut the last saved tile short.
+        bf::resize_file(CheckpointPath, bf::file_size(CheckpointPath) - 1);
+
+        auto_release_ptr<Frame> frame(create_frame("16 16"));
+        frame->image().clear(Color4f(0.0f));
+
+        TileCheckpoint checkpoint(frame.ref(), make_params(true));
+        checkpoint.on_render_begin();
+
+        EXPECT_EQ(2, count_complete_tiles(frame.ref(), checkpoint));
+        EXPECT_TRUE(checkpoint.is_tile_complete(0, 0));
+        EXPECT_TRUE(checkpoint.is_tile_complete(2, 0));
+        EXPECT_FALSE(checkpoint.is_tile_complete(1, 1));
+    }
+
+    TEST_CASE(Resume_GivenMissingFile_RestoresNothing)
+    {
+        bf::remove(CheckpointPath);
+
+        auto_release_ptr<Frame> frame(create_frame("16 16"));
+
+        TileCheckpoint checkpoint(frame.ref(), make_params(true));
+        checkpoint.on_render_begin();
+
+        EXPECT_EQ(0, count_complete_tiles(frame.ref(), checkpoint));
+    }
+}
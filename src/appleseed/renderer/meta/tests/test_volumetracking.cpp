@@ -0,0 +1,188 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/volume/occupancygrid.h"
+#include "renderer/kernel/volume/volume.h"
+#include "renderer/kernel/volume/volumetracking.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/rng/xoroshiro128plus.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/test.h"
+
+// Standard headers.
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using namespace foundation;
+using namespace renderer;
+using namespace std;
+
+TEST_SUITE(Renderer_Kernel_Volume_VolumeTracking)
+{
+    struct ConstantDensity
+    {
+        float operator()(const double t) const
+        {
+            return 1.0f;
+        }
+    };
+
+    struct Fixture
+    {
+        VoxelGrid       m_voxel_grid;
+
+        Fixture()
+          : m_voxel_grid(4, 4, 4, 1)
+        {
+            for (size_t z = 0; z < 4; ++z)
+            {
+                for (size_t y = 0; y < 4; ++y)
+                {
+                    for (size_t x = 0; x < 4; ++x)
+                        m_voxel_grid.voxel(x, y, z)[0] = 1.0f;
+                }
+            }
+        }
+    };
+
+    struct RecordingVisitor
+    {
+        vector<double>  m_t0;
+        vector<double>  m_t1;
+
+        bool operator()(const double t0, const double t1, const float majorant)
+        {
+            m_t0.push_back(t0);
+            m_t1.push_back(t1);
+            return true;
+        }
+    };
+
+    TEST_CASE_F(TraverseOccupancyGrid_GivenAxisAlignedRay_VisitsAllPiercedVoxelsInOrder, Fixture)
+    {
+        const OccupancyGrid grid(m_voxel_grid, 0, 0.0f);
+
+        RecordingVisitor visitor;
+        traverse_occupancy_grid(
+            grid,
+            Vector3d(0.0, 0.6, 0.6),
+            Vector3d(1.0, 0.0, 0.0),
+            0.0,
+            1.0,
+            visitor);
+
+        ASSERT_EQ(4, visitor.m_t0.size());
+        EXPECT_FEQ(0.0, visitor.m_t0[0]);
+        EXPECT_FEQ(0.25, visitor.m_t1[0]);
+        EXPECT_FEQ(0.25, visitor.m_t0[1]);
+        EXPECT_FEQ(1.0, visitor.m_t1[3]);
+    }
+
+    TEST_CASE_F(RatioTracking_GivenConstantDensity_ConvergesToBeerLambertLaw, Fixture)
+    {
+        const OccupancyGrid grid(m_voxel_grid, 0, 0.0f);
+
+        Spectrum extinction;
+        extinction.set(2.0f);
+
+        Xoroshiro128plus rng;
+        const size_t SampleCount = 10000;
+        float transmission_sum = 0.0f;
+
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            Spectrum transmission;
+            ratio_tracking(
+                grid,
+                Vector3d(0.0, 0.6, 0.6),
+                Vector3d(1.0, 0.0, 0.0),
+                0.0,
+                1.0,
+                ConstantDensity(),
+                extinction,
+                rng,
+                transmission);
+            transmission_sum += transmission[0];
+        }
+
+        EXPECT_FEQ_EPS(exp(-2.0f), transmission_sum / SampleCount, 0.01f);
+    }
+
+    TEST_CASE_F(SpectralTracking_GivenPurelyAbsorbingMedium_GivesZeroWeightToAbsorbedRays, Fixture)
+    {
+        const OccupancyGrid grid(m_voxel_grid, 0, 0.0f);
+
+        Spectrum absorption;
+        absorption.set(2.0f);
+
+        Spectrum scattering;
+        scattering.set(0.0f);
+
+        Xoroshiro128plus rng;
+        const size_t SampleCount = 10000;
+        size_t scattered_count = 0;
+        size_t absorbed_count = 0;
+        float weight_sum = 0.0f;
+
+        for (size_t i = 0; i < SampleCount; ++i)
+        {
+            double distance;
+            Spectrum weight;
+            const bool scattered =
+                spectral_tracking(
+                    grid,
+                    Vector3d(0.0, 0.6, 0.6),
+                    Vector3d(1.0, 0.0, 0.0),
+                    0.0,
+                    1.0,
+                    ConstantDensity(),
+                    absorption,
+                    scattering,
+                    rng,
+                    distance,
+                    weight);
+
+            if (scattered)
+                ++scattered_count;
+
+            if (is_zero(weight))
+                ++absorbed_count;
+
+            weight_sum += weight[0];
+        }
+
+        EXPECT_EQ(0, scattered_count);
+        EXPECT_FEQ_EPS(1.0f - exp(-2.0f), static_cast<float>(absorbed_count) / SampleCount, 0.02f);
+        EXPECT_FEQ_EPS(exp(-2.0f), weight_sum / SampleCount, 0.1f);
+    }
+}
@@ -0,0 +1,304 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "energycompensation.h"
+
+// appleseed.renderer headers.
+#include "renderer/modeling/bsdf/microfacethelper.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/microfacet.h"
+#include "foundation/math/qmc.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#ifdef APPLESEED_USE_SSE
+#include "foundation/platform/sse.h"
+#endif
+
+// Standard headers.
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+// Defined in energycompensationtables.cpp.
+extern const size_t GGXAlbedoTableVersion;
+extern const float GGXAlbedoTableValues[];
+extern const size_t BeckmannAlbedoTableVersion;
+extern const float BeckmannAlbedoTableValues[];
+
+namespace
+{
+    const size_t N = MicrofacetAlbedoTable::TableSize;
+
+    // Map a value in [0, 1] to the index of the lower table entry and an interpolation weight.
+    inline void table_coordinates(const float x, size_t& index, float& weight)
+    {
+        const float p = saturate(x) * (N - 1);
+        index = min(truncate<size_t>(p), N - 2);
+        weight = p - index;
+    }
+
+    float compute_directional_albedo(
+        const MDF&          mdf,
+        const float         alpha,
+        const float         cos_theta,
+        const size_t        sample_count)
+    {
+        // Avoid the singularity at exactly grazing angles.
+        const float cos_theta_o = max(cos_theta, 1.0e-3f);
+        const Vector3f wo(sqrt(1.0f - square(cos_theta_o)), cos_theta_o, 0.0f);
+
+        float albedo = 0.0f;
+
+        for (size_t i = 0; i < sample_count; ++i)
+        {
+            static const size_t Bases[] = { 2, 3 };
+            const Vector3f s = hammersley_sequence<float, 3>(Bases, sample_count, i);
+
+            const Vector3f m = mdf.sample(wo, s, alpha, alpha, 0.0f);
+            const Vector3f wi = reflect(wo, m);
+
+            if (wi.y <= 0.0f)
+                continue;
+
+            // With visible normals sampling and a perfectly reflective Fresnel term,
+            // the weight of a sample reduces to G / G1(wo).
+            albedo +=
+                mdf.G(wi, wo, m, alpha, alpha, 0.0f) /
+                mdf.G1(wo, m, alpha, alpha, 0.0f);
+        }
+
+        return albedo / sample_count;
+    }
+}
+
+
+//
+// MicrofacetAlbedoTable class implementation.
+//
+
+MicrofacetAlbedoTable::MicrofacetAlbedoTable(const float* values)
+{
+    memcpy(m_values, values, sizeof(m_values));
+}
+
+MicrofacetAlbedoTable::MicrofacetAlbedoTable(
+    const MDF&              mdf,
+    const size_t            sample_count)
+{
+    for (size_t j = 0; j < N; ++j)
+    {
+        const float roughness = static_cast<float>(j) / (N - 1);
+        const float alpha = microfacet_alpha_from_roughness(roughness);
+
+        for (size_t i = 0; i < N; ++i)
+        {
+            const float cos_theta = static_cast<float>(i) / (N - 1);
+            m_values[j * N + i] = compute_directional_albedo(mdf, alpha, cos_theta, sample_count);
+        }
+
+        // E_avg = 2 * integral of E(mu) * mu over [0, 1], using the midpoint rule.
+        float average = 0.0f;
+        for (size_t i = 0; i < N; ++i)
+        {
+            const float cos_theta = (i + 0.5f) / N;
+            average += compute_directional_albedo(mdf, alpha, cos_theta, sample_count) * cos_theta;
+        }
+        m_values[N * N + j] = 2.0f * average / N;
+    }
+}
+
+float MicrofacetAlbedoTable::get_directional_albedo(
+    const float             cos_theta,
+    const float             roughness) const
+{
+    size_t i, j;
+    float fx, fy;
+    table_coordinates(cos_theta, i, fx);
+    table_coordinates(roughness, j, fy);
+
+    const float* row0 = m_values + j * N + i;
+    const float* row1 = row0 + N;
+
+    return
+        lerp(
+            lerp(row0[0], row0[1], fx),
+            lerp(row1[0], row1[1], fx),
+            fy);
+}
+
+void MicrofacetAlbedoTable::get_directional_albedos(
+    const float             cos_theta_o,
+    const float             cos_theta_i,
+    const float             roughness,
+    float&                  albedo_o,
+    float&                  albedo_i) const
+{
+#ifdef APPLESEED_USE_SSE
+
+    size_t io, ii, j;
+    float fxo, fxi, fy;
+    table_coordinates(cos_theta_o, io, fxo);
+    table_coordinates(cos_theta_i, ii, fxi);
+    table_coordinates(roughness, j, fy);
+
+    const float* row = m_values + j * N;
+
+    // Gather the four corners of each lookup: (x0, y0), (x1, y0), (x0, y1), (x1, y1).
+    __m128 vo = _mm_setzero_ps();
+    vo = _mm_loadl_pi(vo, reinterpret_cast<const __m64*>(row + io));
+    vo = _mm_loadh_pi(vo, reinterpret_cast<const __m64*>(row + N + io));
+
+    __m128 vi = _mm_setzero_ps();
+    vi = _mm_loadl_pi(vi, reinterpret_cast<const __m64*>(row + ii));
+    vi = _mm_loadh_pi(vi, reinterpret_cast<const __m64*>(row + N + ii));
+
+    // Bilinear weights of the four corners.
+    const __m128 wy = _mm_set_ps(fy, fy, 1.0f - fy, 1.0f - fy);
+    const __m128 wo = _mm_mul_ps(wy, _mm_set_ps(fxo, 1.0f - fxo, fxo, 1.0f - fxo));
+    const __m128 wi = _mm_mul_ps(wy, _mm_set_ps(fxi, 1.0f - fxi, fxi, 1.0f - fxi));
+
+    // Weighted sums: lane 0 holds the result for o, lane 1 the result for i.
+    const __m128 po = _mm_mul_ps(vo, wo);
+    const __m128 pi = _mm_mul_ps(vi, wi);
+    const __m128 t = _mm_add_ps(_mm_unpacklo_ps(po, pi), _mm_unpackhi_ps(po, pi));
+    const __m128 r = _mm_add_ps(t, _mm_movehl_ps(t, t));
+
+    APPLESEED_SIMD4_ALIGN float result[4];
+    _mm_store_ps(result, r);
+
+    albedo_o = result[0];
+    albedo_i = result[1];
+
+#else
+
+    albedo_o = get_directional_albedo(cos_theta_o, roughness);
+    albedo_i = get_directional_albedo(cos_theta_i, roughness);
+
+#endif
+}
+
+float MicrofacetAlbedoTable::get_average_albedo(const float roughness) const
+{
+    size_t j;
+    float fy;
+    table_coordinates(roughness, j, fy);
+
+    const float* average = m_values + N * N;
+    return lerp(average[j], average[j + 1], fy);
+}
+
+void MicrofacetAlbedoTable::write_cpp_array(ostream& s) const
+{
+    for (size_t i = 0; i < ValueCount; ++i)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.6ff", m_values[i]);
+
+        s << (i % 8 == 0 ? "    " : " ") << buf;
+
+        if (i + 1 < ValueCount)
+            s << ",";
+
+        if (i % 8 == 7 || i + 1 == ValueCount)
+            s << "\n";
+    }
+}
+
+const MicrofacetAlbedoTable& get_ggx_albedo_table()
+{
+    assert(GGXAlbedoTableVersion == MicrofacetAlbedoTable::Version);
+    static const MicrofacetAlbedoTable table(GGXAlbedoTableValues);
+    return table;
+}
+
+const MicrofacetAlbedoTable& get_beckmann_albedo_table()
+{
+    assert(BeckmannAlbedoTableVersion == MicrofacetAlbedoTable::Version);
+    static const MicrofacetAlbedoTable table(BeckmannAlbedoTableValues);
+    return table;
+}
+
+
+//
+// Energy compensation functions implementation.
+//
+
+float average_fresnel_reflectance_dielectric(const float eta)
+{
+    // Polynomial fits from the reference.
+    return
+        eta >= 1.0f
+            ? (eta - 1.0f) / (4.08567f + 1.00071f * eta)
+            : 0.997118f + eta * (0.1014f + eta * (-0.965241f - 0.130607f * eta));
+}
+
+void add_energy_compensation_term(
+    const MicrofacetAlbedoTable&    table,
+    const float                     roughness,
+    const float                     cos_in,
+    const float                     cos_on,
+    const Spectrum&                 average_fresnel,
+    const float                     amount,
+    Spectrum&                       value)
+{
+    if (amount <= 0.0f)
+        return;
+
+    float albedo_o, albedo_i;
+    table.get_directional_albedos(cos_on, cos_in, roughness, albedo_o, albedo_i);
+
+    const float average_albedo = table.get_average_albedo(roughness);
+
+    // Shape of the multiple-scattering lobe, normalized so that the lobe and the
+    // single-scattering lobe together reflect all incoming energy.
+    const float fms =
+        amount * (1.0f - albedo_o) * (1.0f - albedo_i) /
+        (Pi<float>() * max(1.0f - average_albedo, 1.0e-4f));
+
+    // Fresnel term of the multiple-scattering lobe, accounting for the energy
+    // absorbed at each bounce: F_avg^2 * E_avg / (1 - F_avg * (1 - E_avg)).
+    for (size_t i = 0, e = Spectrum::size(); i < e; ++i)
+    {
+        const float f = average_fresnel[i];
+        value[i] += fms * square(f) * average_albedo / (1.0f - f * (1.0f - average_albedo));
+    }
+}
+
+}   // namespace renderer
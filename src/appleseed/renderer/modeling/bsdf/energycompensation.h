@@ -0,0 +1,140 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_RENDERER_MODELING_BSDF_ENERGYCOMPENSATION_H
+#define APPLESEED_RENDERER_MODELING_BSDF_ENERGYCOMPENSATION_H
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/concepts/noncopyable.h"
+#include "foundation/platform/compiler.h"
+
+// Standard headers.
+#include <cstddef>
+#include <iosfwd>
+
+// Forward declarations.
+namespace foundation    { class MDF; }
+
+namespace renderer
+{
+
+//
+// Multiple-scattering energy compensation for microfacet BRDFs.
+//
+// Single-scattering microfacet models lose energy at high roughness. The lost energy is
+// added back with an extra diffuse-like lobe whose shape is derived from the directional
+// albedo E(mu) of the lobe and from its average albedo E_avg over the hemisphere.
+//
+// Reference:
+//
+//   Revisiting Physically Based Shading at Imageworks
+//   https://blog.selfshadow.com/publications/s2017-shading-course/imageworks/s2017_pbs_imageworks_slides.pdf
+//
+
+//
+// Directional and average albedo of a microfacet lobe with a perfectly reflective
+// Fresnel term, tabulated as a function of the cosine of the view angle and of the
+// roughness (alpha = roughness^2).
+//
+// Tables for the GGX and Beckmann distributions are computed offline and embedded in
+// the library, see energycompensationtables.cpp. The embedded data can be regenerated
+// by enabling the GenerateAlbedoTables test case (disabled by default) of the
+// Renderer_Modeling_BSDF_EnergyCompensation unit test suite.
+//
+
+class MicrofacetAlbedoTable
+  : public foundation::NonCopyable
+{
+  public:
+    // Version of the table layout and of the integration method.
+    // Bump it whenever the embedded tables need to be regenerated.
+    static const size_t Version = 1;
+
+    // Number of table entries along each dimension.
+    static const size_t TableSize = 32;
+
+    // Number of values in a serialized table: the directional albedo, one row of
+    // TableSize values per roughness value, followed by the average albedo.
+    static const size_t ValueCount = TableSize * TableSize + TableSize;
+
+    // Construct a table from serialized values.
+    explicit MicrofacetAlbedoTable(const float* values);
+
+    // Compute a table by numerical integration.
+    MicrofacetAlbedoTable(
+        const foundation::MDF&  mdf,
+        const size_t            sample_count);
+
+    // Return the directional albedo for a given view angle and roughness.
+    float get_directional_albedo(
+        const float             cos_theta,
+        const float             roughness) const;
+
+    // Return the directional albedos for two view angles and a given roughness at once.
+    void get_directional_albedos(
+        const float             cos_theta_o,
+        const float             cos_theta_i,
+        const float             roughness,
+        float&                  albedo_o,
+        float&                  albedo_i) const;
+
+    // Return the average albedo for a given roughness.
+    float get_average_albedo(const float roughness) const;
+
+    // Write the table as a C++ array initializer.
+    void write_cpp_array(std::ostream& s) const;
+
+  private:
+    APPLESEED_SIMD4_ALIGN float m_values[ValueCount];
+};
+
+// Return the embedded albedo tables.
+const MicrofacetAlbedoTable& get_ggx_albedo_table();
+const MicrofacetAlbedoTable& get_beckmann_albedo_table();
+
+// Return the average Fresnel reflectance of a dielectric interface.
+float average_fresnel_reflectance_dielectric(const float eta);
+
+// Add the multiple-scattering lobe to a microfacet BRDF value.
+// `average_fresnel` is the average Fresnel reflectance of the lobe, per channel.
+void add_energy_compensation_term(
+    const MicrofacetAlbedoTable&    table,
+    const float                     roughness,
+    const float                     cos_in,
+    const float                     cos_on,
+    const Spectrum&                 average_fresnel,
+    const float                     amount,
+    Spectrum&                       value);
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_MODELING_BSDF_ENERGYCOMPENSATION_H
@@ -0,0 +1,321 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+//
+// This file is generated, do not edit it by hand.
+//
+// The tables are regenerated by enabling the GenerateAlbedoTables test case of the
+// Renderer_Modeling_BSDF_EnergyCompensation unit test suite, see energycompensation.h.
+// Each table has MicrofacetAlbedoTable::ValueCount entries and was computed with 4096
+// samples per entry.
+//
+
+// Standard headers.
+#include <cstddef>
+
+namespace renderer
+{
+
+extern const size_t GGXAlbedoTableVersion = 1;
+
+extern const float GGXAlbedoTableValues[] =
+{
+    0.892162f, 0.999513f, 0.999905f, 0.999996f, 0.999978f, 0.999989f, 0.999995f, 0.999997f,
+    0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f,
+    0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f,
+    0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 1.000000f, 1.000000f,
+    0.892730f, 0.999505f, 0.999710f, 0.999996f, 0.999755f, 0.999755f, 0.999756f, 0.999756f,
+    0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f,
+    0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f,
+    0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 0.999756f, 1.000000f, 1.000000f,
+    0.954224f, 0.990215f, 0.997803f, 0.999150f, 0.999506f, 0.999326f, 0.999422f, 0.999464f,
+    0.999497f, 0.999499f, 0.999500f, 0.999508f, 0.999844f, 0.999723f, 0.999739f, 0.999747f,
+    0.999750f, 0.999752f, 0.999753f, 0.999754f, 0.999754f, 0.999754f, 0.999755f, 0.999755f,
+    0.999755f, 0.999755f, 0.999755f, 0.999755f, 0.999755f, 0.999755f, 0.999756f, 1.000000f,
+    0.978332f, 0.954888f, 0.987509f, 0.994703f, 0.997178f, 0.998298f, 0.998887f, 0.999254f,
+    0.999224f, 0.999514f, 0.999301f, 0.999571f, 0.999574f, 0.999683f, 0.999461f, 0.999465f,
+    0.999497f, 0.999498f, 0.999500f, 0.999500f, 0.999508f, 0.999746f, 0.999509f, 0.999509f,
+    0.999511f, 0.999511f, 0.999511f, 0.999512f, 0.999512f, 0.999512f, 0.999512f, 1.000000f,
+    0.987581f, 0.911489f, 0.962672f, 0.982358f, 0.990182f, 0.993928f, 0.995891f, 0.997116f,
+    0.997802f, 0.998378f, 0.998435f, 0.998724f, 0.999148f, 0.999394f, 0.999486f, 0.999271f,
+    0.999540f, 0.999565f, 0.999570f, 0.999624f, 0.999690f, 0.999460f, 0.999464f, 0.999496f,
+    0.999499f, 0.999500f, 0.999508f, 0.999509f, 0.999511f, 0.999511f, 0.999512f, 0.999756f,
+    0.991967f, 0.892125f, 0.929641f, 0.959921f, 0.975948f, 0.984427f, 0.989350f, 0.992251f,
+    0.994228f, 0.995476f, 0.996417f, 0.997191f, 0.997380f, 0.997956f, 0.998396f, 0.998620f,
+    0.998741f, 0.998967f, 0.999112f, 0.999260f, 0.999195f, 0.999254f, 0.999309f, 0.999544f,
+    0.999606f, 0.999676f, 0.999694f, 0.999490f, 0.999497f, 0.999504f, 0.999506f, 0.999487f,
+    0.994358f, 0.894399f, 0.903511f, 0.932391f, 0.954332f, 0.968388f, 0.977429f, 0.983231f,
+    0.986892f, 0.989943f, 0.991894f, 0.993281f, 0.994469f, 0.995313f, 0.995960f, 0.996456f,
+    0.996946f, 0.997319f, 0.997355f, 0.997861f, 0.998106f, 0.997997f, 0.998353f, 0.998327f,
+    0.998429f, 0.998754f, 0.998546f, 0.998735f, 0.998868f, 0.999083f, 0.999187f, 0.998678f,
+    0.995683f, 0.905577f, 0.890974f, 0.908231f, 0.929817f, 0.947229f, 0.960041f, 0.969163f,
+    0.975694f, 0.980509f, 0.984079f, 0.986472f, 0.988541f, 0.990396f, 0.991679f, 0.992654f,
+    0.993469f, 0.994281f, 0.994875f, 0.995351f, 0.995681f, 0.996026f, 0.996401f, 0.996417f,
+    0.996837f, 0.996984f, 0.996991f, 0.997446f, 0.997326f, 0.997438f, 0.997564f, 0.997335f,
+    0.996644f, 0.918080f, 0.889400f, 0.893011f, 0.907981f, 0.924579f, 0.939279f, 0.950883f,
+    0.960018f, 0.966809f, 0.972461f, 0.976633f, 0.980083f, 0.982799f, 0.984968f, 0.986433f,
+    0.988015f, 0.989309f, 0.990142f, 0.991257f, 0.991716f, 0.992476f, 0.992949f, 0.993488f,
+    0.993992f, 0.994358f, 0.994393f, 0.994837f, 0.994790f, 0.995102f, 0.995359f, 0.995202f,
+    0.997209f, 0.928861f, 0.893634f, 0.886033f, 0.892438f, 0.904979f, 0.918295f, 0.930334f,
+    0.941127f, 0.949885f, 0.957101f, 0.962790f, 0.967915f, 0.971670f, 0.974893f, 0.977801f,
+    0.980037f, 0.982032f, 0.983717f, 0.985145f, 0.986265f, 0.987251f, 0.987863f, 0.988875f,
+    0.989602f, 0.990260f, 0.990814f, 0.991003f, 0.991632f, 0.992002f, 0.992087f, 0.992021f,
+    0.997568f, 0.937434f, 0.900418f, 0.884798f, 0.883429f, 0.889848f, 0.899482f, 0.910558f,
+    0.921072f, 0.930623f, 0.939010f, 0.946259f, 0.952168f, 0.957655f, 0.962075f, 0.965856f,
+    0.969113f, 0.971699f, 0.974334f, 0.976432f, 0.978191f, 0.979721f, 0.981082f, 0.982089f,
+    0.983185f, 0.984310f, 0.984920f, 0.985655f, 0.986498f, 0.987093f, 0.987437f, 0.987373f,
+    0.997793f, 0.943776f, 0.906998f, 0.886705f, 0.878924f, 0.879474f, 0.884950f, 0.892939f,
+    0.901873f, 0.910830f, 0.919103f, 0.927123f, 0.934126f, 0.940325f, 0.945812f, 0.950645f,
+    0.954857f, 0.958554f, 0.961552f, 0.964598f, 0.967057f, 0.969241f, 0.971221f, 0.972982f,
+    0.974543f, 0.975930f, 0.977169f, 0.977973f, 0.978968f, 0.980102f, 0.980899f, 0.980905f,
+    0.997917f, 0.948069f, 0.912508f, 0.889618f, 0.877026f, 0.872743f, 0.873661f, 0.878024f,
+    0.884389f, 0.891747f, 0.899397f, 0.906921f, 0.913826f, 0.920487f, 0.926818f, 0.932358f,
+    0.937315f, 0.941770f, 0.945793f, 0.949375f, 0.952371f, 0.955535f, 0.958138f, 0.960503f,
+    0.962360f, 0.964471f, 0.966168f, 0.967467f, 0.969137f, 0.970405f, 0.971310f, 0.972104f,
+    0.997964f, 0.951120f, 0.916492f, 0.892278f, 0.876796f, 0.868321f, 0.865146f, 0.865912f,
+    0.869069f, 0.874302f, 0.880262f, 0.886693f, 0.893250f, 0.899694f, 0.905853f, 0.911448f,
+    0.917135f, 0.921931f, 0.926801f, 0.931041f, 0.934897f, 0.938221f, 0.941692f, 0.944620f,
+    0.947055f, 0.949775f, 0.952028f, 0.954061f, 0.955946f, 0.957661f, 0.959238f, 0.960476f,
+    0.997826f, 0.952551f, 0.918894f, 0.893969f, 0.876430f, 0.865027f, 0.858552f, 0.855928f,
+    0.856282f, 0.858473f, 0.862537f, 0.867105f, 0.872704f, 0.878122f, 0.883813f, 0.889456f,
+    0.895148f, 0.900347f, 0.905293f, 0.909929f, 0.914255f, 0.918358f, 0.922131f, 0.925376f,
+    0.928586f, 0.931820f, 0.934619f, 0.937199f, 0.939579f, 0.941743f, 0.943716f, 0.945529f,
+    0.997881f, 0.953037f, 0.919854f, 0.894457f, 0.875384f, 0.861853f, 0.852802f, 0.847434f,
+    0.844985f, 0.844765f, 0.846272f, 0.849071f, 0.852759f, 0.856832f, 0.861523f, 0.866674f,
+    0.871441f, 0.876636f, 0.881267f, 0.885972f, 0.890737f, 0.895058f, 0.899176f, 0.902833f,
+    0.906702f, 0.910124f, 0.913330f, 0.916356f, 0.919217f, 0.921862f, 0.924316f, 0.926816f,
+    0.997773f, 0.952704f, 0.919373f, 0.893485f, 0.873487f, 0.858194f, 0.847024f, 0.839283f,
+    0.834355f, 0.831778f, 0.830820f, 0.831755f, 0.833589f, 0.836279f, 0.839657f, 0.843515f,
+    0.847670f, 0.852009f, 0.856192f, 0.860612f, 0.865255f, 0.869559f, 0.873739f, 0.877777f,
+    0.881413f, 0.885360f, 0.888638f, 0.892250f, 0.895485f, 0.898549f, 0.901452f, 0.903995f,
+    0.997629f, 0.951468f, 0.917723f, 0.891343f, 0.870216f, 0.853668f, 0.840716f, 0.830989f,
+    0.823978f, 0.819163f, 0.816211f, 0.814909f, 0.814930f, 0.815939f, 0.817753f, 0.820217f,
+    0.822933f, 0.826463f, 0.829799f, 0.833770f, 0.837631f, 0.841547f, 0.845468f, 0.849359f,
+    0.853199f, 0.856950f, 0.860363f, 0.864146f, 0.867348f, 0.870658f, 0.874113f, 0.876878f,
+    0.997452f, 0.949520f, 0.914873f, 0.887735f, 0.865758f, 0.847906f, 0.833349f, 0.821953f,
+    0.813203f, 0.806206f, 0.801543f, 0.798283f, 0.796095f, 0.795454f, 0.795595f, 0.796554f,
+    0.798159f, 0.800038f, 0.802777f, 0.805608f, 0.808674f, 0.811904f, 0.815263f, 0.818711f,
+    0.822200f, 0.825706f, 0.829209f, 0.832669f, 0.836061f, 0.839413f, 0.842442f, 0.845472f,
+    0.997243f, 0.947005f, 0.911055f, 0.882988f, 0.859923f, 0.840965f, 0.825039f, 0.812218f,
+    0.801629f, 0.793239f, 0.786570f, 0.781451f, 0.777657f, 0.775056f, 0.773522f, 0.772822f,
+    0.772845f, 0.773468f, 0.774646f, 0.776274f, 0.778284f, 0.780372f, 0.783168f, 0.785908f,
+    0.788790f, 0.791786f, 0.794859f, 0.797971f, 0.801103f, 0.804236f, 0.807353f, 0.809993f,
+    0.997011f, 0.943909f, 0.906584f, 0.877076f, 0.852765f, 0.832509f, 0.815611f, 0.801282f,
+    0.789049f, 0.779105f, 0.770736f, 0.763795f, 0.758551f, 0.754240f, 0.750994f, 0.748625f,
+    0.747093f, 0.746279f, 0.746073f, 0.746388f, 0.747169f, 0.748324f, 0.749818f, 0.751589f,
+    0.753588f, 0.755781f, 0.758144f, 0.760633f, 0.762975f, 0.765628f, 0.768588f, 0.770879f,
+    0.996770f, 0.940370f, 0.901031f, 0.870220f, 0.844763f, 0.823020f, 0.804882f, 0.789089f,
+    0.775648f, 0.764012f, 0.754138f, 0.745791f, 0.738569f, 0.732691f, 0.727846f, 0.724140f,
+    0.721055f, 0.718699f, 0.716750f, 0.715856f, 0.715264f, 0.715117f, 0.715382f, 0.715767f,
+    0.716691f, 0.718125f, 0.719315f, 0.721189f, 0.722985f, 0.724906f, 0.726931f, 0.728751f,
+    0.996507f, 0.936439f, 0.894983f, 0.862323f, 0.835477f, 0.812440f, 0.792656f, 0.775774f,
+    0.760841f, 0.747900f, 0.736618f, 0.726519f, 0.717986f, 0.710803f, 0.704440f, 0.699008f,
+    0.694239f, 0.690434f, 0.687473f, 0.684890f, 0.682897f, 0.681388f, 0.680101f, 0.679646f,
+    0.679334f, 0.679143f, 0.679467f, 0.680279f, 0.681090f, 0.681842f, 0.683021f, 0.684371f,
+    0.996222f, 0.932082f, 0.888393f, 0.853875f, 0.825311f, 0.800865f, 0.779725f, 0.761299f,
+    0.745008f, 0.730687f, 0.717993f, 0.706542f, 0.696811f, 0.688002f, 0.680197f, 0.673300f,
+    0.667291f, 0.662055f, 0.657499f, 0.653573f, 0.649905f, 0.647275f, 0.644903f, 0.642676f,
+    0.641094f, 0.640114f, 0.639222f, 0.638607f, 0.638292f, 0.638221f, 0.638355f, 0.638577f,
+    0.995915f, 0.927249f, 0.881097f, 0.844548f, 0.814074f, 0.788212f, 0.765633f, 0.745742f,
+    0.728128f, 0.712476f, 0.698438f, 0.685845f, 0.674363f, 0.664245f, 0.655312f, 0.646893f,
+    0.639519f, 0.632905f, 0.627014f, 0.621922f, 0.617181f, 0.613010f, 0.609325f, 0.606080f,
+    0.603180f, 0.600693f, 0.598606f, 0.596583f, 0.595292f, 0.594039f, 0.592800f, 0.592225f,
+    0.995587f, 0.922316f, 0.873214f, 0.834590f, 0.802221f, 0.774713f, 0.750454f, 0.729101f,
+    0.710313f, 0.693301f, 0.677994f, 0.664167f, 0.651592f, 0.640026f, 0.629845f, 0.620409f,
+    0.611784f, 0.603726f, 0.596577f, 0.590018f, 0.584266f, 0.578820f, 0.573855f, 0.569340f,
+    0.565315f, 0.561392f, 0.558271f, 0.555315f, 0.552631f, 0.550224f, 0.548029f, 0.546129f,
+    0.995239f, 0.917256f, 0.865191f, 0.824064f, 0.789857f, 0.760473f, 0.734807f, 0.712003f,
+    0.691682f, 0.673383f, 0.656822f, 0.641752f, 0.627836f, 0.615483f, 0.603714f, 0.593323f,
+    0.583562f, 0.574569f, 0.566260f, 0.558604f, 0.551478f, 0.544915f, 0.538837f, 0.533217f,
+    0.527765f, 0.522961f, 0.518742f, 0.514609f, 0.510814f, 0.507312f, 0.503782f, 0.501015f,
+    0.994872f, 0.911802f, 0.856595f, 0.813041f, 0.776791f, 0.745605f, 0.718362f, 0.694055f,
+    0.672257f, 0.652811f, 0.634882f, 0.618839f, 0.603949f, 0.590109f, 0.577685f, 0.566023f,
+    0.555238f, 0.545187f, 0.535867f, 0.527148f, 0.519063f, 0.511470f, 0.504147f, 0.497749f,
+    0.491299f, 0.485478f, 0.480007f, 0.475131f, 0.470319f, 0.465779f, 0.461573f, 0.457495f,
+    0.994487f, 0.906026f, 0.847661f, 0.801597f, 0.763224f, 0.730215f, 0.701319f, 0.675624f,
+    0.652594f, 0.631605f, 0.612820f, 0.595318f, 0.579580f, 0.564895f, 0.551078f, 0.538689f,
+    0.526717f, 0.515967f, 0.505713f, 0.496141f, 0.487128f, 0.478631f, 0.470694f, 0.462991f,
+    0.456130f, 0.449419f, 0.443125f, 0.437116f, 0.431478f, 0.425863f, 0.421001f, 0.416047f,
+    0.994083f, 0.900195f, 0.838427f, 0.789760f, 0.749244f, 0.714401f, 0.683921f, 0.656567f,
+    0.632418f, 0.610338f, 0.590310f, 0.571914f, 0.554858f, 0.539209f, 0.524888f, 0.511410f,
+    0.498823f, 0.487066f, 0.476026f, 0.465697f, 0.455884f, 0.446726f, 0.438021f, 0.429571f,
+    0.421998f, 0.414576f, 0.407573f, 0.400671f, 0.394538f, 0.388498f, 0.382713f, 0.377016f,
+    0.993692f, 0.894328f, 0.828972f, 0.777635f, 0.734953f, 0.698219f, 0.666124f, 0.637552f,
+    0.611774f, 0.588754f, 0.567645f, 0.548101f, 0.530456f, 0.513985f, 0.498682f, 0.484423f,
+    0.471122f, 0.458480f, 0.446779f, 0.435962f, 0.425575f, 0.415776f, 0.406483f, 0.397490f,
+    0.389101f, 0.381156f, 0.373832f, 0.366381f, 0.359729f, 0.353130f, 0.346858f, 0.340620f,
+    0.993303f, 0.888090f, 0.819253f, 0.765273f, 0.720395f, 0.681872f, 0.648166f, 0.618183f,
+    0.591362f, 0.567067f, 0.544947f, 0.524513f, 0.506034f, 0.488803f, 0.472621f, 0.457877f,
+    0.443965f, 0.430911f, 0.418696f, 0.407121f, 0.396265f, 0.385989f, 0.376266f, 0.367005f,
+    0.358244f, 0.349896f, 0.341953f, 0.334374f, 0.327158f, 0.320226f, 0.313584f, 0.306975f,
+    0.999755f, 0.999760f, 0.999686f, 0.999245f, 0.998718f, 0.997646f, 0.995313f, 0.991626f,
+    0.986449f, 0.979652f, 0.970997f, 0.960130f, 0.946849f, 0.931230f, 0.913474f, 0.893268f,
+    0.871115f, 0.846657f, 0.820220f, 0.791792f, 0.761828f, 0.730439f, 0.698011f, 0.664877f,
+    0.631324f, 0.597686f, 0.564359f, 0.531539f, 0.499426f, 0.468189f, 0.438226f, 0.409426f
+};
+
+extern const size_t BeckmannAlbedoTableVersion = 1;
+
+extern const float BeckmannAlbedoTableValues[] =
+{
+    0.914802f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.920367f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.969802f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.981158f, 0.993274f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.988502f, 0.946103f, 0.996990f, 0.999996f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.992451f, 0.900863f, 0.971469f, 0.995954f, 0.999831f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.994729f, 0.936138f, 0.932054f, 0.975055f, 0.993353f, 0.998835f, 0.999925f, 0.999999f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.996124f, 0.963955f, 0.900828f, 0.943603f, 0.973277f, 0.989399f, 0.996612f, 0.999195f,
+    0.999893f, 0.999993f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.997032f, 0.967316f, 0.918318f, 0.910773f, 0.945921f, 0.969298f, 0.984275f, 0.992885f,
+    0.997211f, 0.999106f, 0.999770f, 0.999966f, 0.999996f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.997652f, 0.967316f, 0.950645f, 0.900733f, 0.916843f, 0.944359f, 0.964111f, 0.978201f,
+    0.987774f, 0.993709f, 0.997077f, 0.998790f, 0.999535f, 0.999871f, 0.999973f, 0.999995f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.998094f, 0.967595f, 0.963888f, 0.923037f, 0.898875f, 0.918227f, 0.941051f, 0.958184f,
+    0.971535f, 0.981559f, 0.988731f, 0.993543f, 0.996560f, 0.998324f, 0.999282f, 0.999630f,
+    0.999880f, 0.999966f, 0.999991f, 0.999998f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.998420f, 0.968637f, 0.966405f, 0.948769f, 0.908497f, 0.899088f, 0.916611f, 0.936232f,
+    0.951754f, 0.964387f, 0.974530f, 0.982558f, 0.988542f, 0.992846f, 0.995766f, 0.997673f,
+    0.998834f, 0.999443f, 0.999664f, 0.999858f, 0.999950f, 0.999983f, 0.999995f, 0.999999f,
+    1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.998664f, 0.970255f, 0.966485f, 0.961471f, 0.932385f, 0.902164f, 0.898503f, 0.913688f,
+    0.930600f, 0.945017f, 0.956915f, 0.967027f, 0.975425f, 0.982328f, 0.987708f, 0.991831f,
+    0.994824f, 0.996877f, 0.998240f, 0.999114f, 0.999524f, 0.999684f, 0.999821f, 0.999929f,
+    0.999972f, 0.999990f, 0.999998f, 1.000000f, 1.000000f, 1.000000f, 1.000000f, 1.000000f,
+    0.998854f, 0.972180f, 0.966192f, 0.964735f, 0.951942f, 0.921134f, 0.898479f, 0.896936f,
+    0.909572f, 0.924794f, 0.937926f, 0.949314f, 0.959119f, 0.967715f, 0.975146f, 0.981357f,
+    0.986497f, 0.990574f, 0.993615f, 0.995895f, 0.997526f, 0.998630f, 0.999298f, 0.999590f,
+    0.999707f, 0.999797f, 0.999916f, 0.999967f, 0.999989f, 0.999998f, 1.000000f, 1.000000f,
+    0.999002f, 0.974172f, 0.966139f, 0.965159f, 0.960478f, 0.941128f, 0.913632f, 0.895894f,
+    0.894621f, 0.905119f, 0.918443f, 0.930584f, 0.941389f, 0.951000f, 0.959546f, 0.967183f,
+    0.974064f, 0.979909f, 0.984968f, 0.989000f, 0.992310f, 0.994873f, 0.996755f, 0.998100f,
+    0.999013f, 0.999468f, 0.999663f, 0.999735f, 0.999835f, 0.999941f, 0.999985f, 0.999961f,
+    0.999121f, 0.976105f, 0.966482f, 0.964709f, 0.962921f, 0.954369f, 0.932616f, 0.908307f,
+    0.893595f, 0.891594f, 0.899888f, 0.911838f, 0.923269f, 0.933264f, 0.942452f, 0.950958f,
+    0.958760f, 0.965866f, 0.972370f, 0.978172f, 0.983165f, 0.987434f, 0.990996f, 0.993816f,
+    0.995994f, 0.997601f, 0.998763f, 0.999374f, 0.999640f, 0.999729f, 0.999811f, 0.999746f,
+    0.999216f, 0.977905f, 0.967137f, 0.964146f, 0.963120f, 0.959315f, 0.947203f, 0.925714f,
+    0.904069f, 0.890821f, 0.888001f, 0.894336f, 0.904669f, 0.915420f, 0.925145f, 0.933762f,
+    0.941965f, 0.949626f, 0.957009f, 0.963922f, 0.970205f, 0.976082f, 0.981235f, 0.985828f,
+    0.989686f, 0.992864f, 0.995385f, 0.997316f, 0.998689f, 0.999349f, 0.999507f, 0.999665f,
+    0.999292f, 0.979526f, 0.967995f, 0.963712f, 0.962446f, 0.960535f, 0.954547f, 0.940013f,
+    0.919870f, 0.900093f, 0.887638f, 0.884319f, 0.888478f, 0.897230f, 0.906918f, 0.916024f,
+    0.924589f, 0.932721f, 0.940142f, 0.947453f, 0.954465f, 0.961331f, 0.967829f, 0.973812f,
+    0.979353f, 0.984298f, 0.988586f, 0.992217f, 0.995131f, 0.997395f, 0.998854f, 0.999460f,
+    0.999354f, 0.980954f, 0.968951f, 0.963463f, 0.961474f, 0.960115f, 0.956877f, 0.948972f,
+    0.933465f, 0.914449f, 0.896093f, 0.884257f, 0.879842f, 0.882261f, 0.889874f, 0.898392f,
+    0.906869f, 0.915062f, 0.922473f, 0.929767f, 0.937026f, 0.944218f, 0.951360f, 0.958270f,
+    0.965063f, 0.971470f, 0.977506f, 0.983016f, 0.988030f, 0.992417f, 0.996182f, 0.998766f,
+    0.999404f, 0.982190f, 0.969923f, 0.963379f, 0.960456f, 0.958933f, 0.956824f, 0.952236f,
+    0.942772f, 0.927103f, 0.908932f, 0.891684f, 0.879797f, 0.874403f, 0.875491f, 0.881339f,
+    0.889227f, 0.897138f, 0.904817f, 0.911746f, 0.918737f, 0.925759f, 0.932787f, 0.939998f,
+    0.947367f, 0.954734f, 0.962109f, 0.969355f, 0.976375f, 0.983089f, 0.989414f, 0.995574f,
+    0.999446f, 0.983243f, 0.970865f, 0.963402f, 0.959478f, 0.957395f, 0.955570f, 0.952536f,
+    0.946699f, 0.936041f, 0.920490f, 0.903110f, 0.886417f, 0.874542f, 0.868112f, 0.867610f,
+    0.872296f, 0.879114f, 0.886260f, 0.893160f, 0.899852f, 0.906395f, 0.912975f, 0.919909f,
+    0.927189f, 0.934858f, 0.942886f, 0.951123f, 0.959627f, 0.968296f, 0.977051f, 0.986066f,
+    0.999477f, 0.984122f, 0.971728f, 0.963496f, 0.958584f, 0.955733f, 0.953665f, 0.951220f,
+    0.947182f, 0.940201f, 0.928632f, 0.913302f, 0.896356f, 0.879987f, 0.867809f, 0.860849f,
+    0.859064f, 0.862247f, 0.867968f, 0.874434f, 0.880628f, 0.886788f, 0.892619f, 0.898798f,
+    0.905386f, 0.912503f, 0.920318f, 0.928676f, 0.937782f, 0.947429f, 0.957677f, 0.968123f,
+    0.999505f, 0.984844f, 0.972462f, 0.963592f, 0.957755f, 0.954020f, 0.951405f, 0.948944f,
+    0.945688f, 0.940666f, 0.932645f, 0.920370f, 0.905121f, 0.888429f, 0.872340f, 0.859552f,
+    0.851905f, 0.848654f, 0.850653f, 0.855542f, 0.860970f, 0.866326f, 0.871562f, 0.876772f,
+    0.882240f, 0.888128f, 0.894919f, 0.902365f, 0.910690f, 0.919936f, 0.929950f, 0.940694f,
+    0.999523f, 0.985413f, 0.973043f, 0.963625f, 0.956926f, 0.952278f, 0.948911f, 0.946049f,
+    0.942950f, 0.938844f, 0.932794f, 0.923775f, 0.910908f, 0.895603f, 0.878929f, 0.862568f,
+    0.849447f, 0.840866f, 0.836598f, 0.837257f, 0.840936f, 0.845436f, 0.849704f, 0.854064f,
+    0.857780f, 0.862017f, 0.866840f, 0.872335f, 0.878783f, 0.885995f, 0.894155f, 0.903377f,
+    0.999538f, 0.985844f, 0.973441f, 0.963545f, 0.956034f, 0.950441f, 0.946202f, 0.942729f,
+    0.939362f, 0.935461f, 0.930400f, 0.923317f, 0.913289f, 0.899814f, 0.884174f, 0.867139f,
+    0.850615f, 0.836933f, 0.827140f, 0.821875f, 0.821085f, 0.823460f, 0.826437f, 0.829526f,
+    0.831742f, 0.833910f, 0.836192f, 0.838946f, 0.842333f, 0.846411f, 0.851249f, 0.856747f,
+    0.999546f, 0.986133f, 0.973644f, 0.963296f, 0.954994f, 0.948485f, 0.943333f, 0.939018f,
+    0.935083f, 0.930986f, 0.926179f, 0.920040f, 0.911823f, 0.900670f, 0.886508f, 0.870233f,
+    0.852822f, 0.835478f, 0.820784f, 0.810077f, 0.803526f, 0.801242f, 0.802348f, 0.803229f,
+    0.803745f, 0.803622f, 0.803017f, 0.802333f, 0.801968f, 0.802117f, 0.802591f, 0.803233f,
+    0.999551f, 0.986284f, 0.973636f, 0.962826f, 0.953759f, 0.946340f, 0.940206f, 0.934973f,
+    0.930233f, 0.925574f, 0.920539f, 0.914578f, 0.907233f, 0.897720f, 0.885317f, 0.870186f,
+    0.853039f, 0.834512f, 0.816318f, 0.800636f, 0.788179f, 0.780168f, 0.776091f, 0.775134f,
+    0.773454f, 0.770910f, 0.767215f, 0.762969f, 0.758541f, 0.754147f, 0.749780f, 0.745337f,
+    0.999551f, 0.986300f, 0.973404f, 0.962091f, 0.952274f, 0.943903f, 0.936727f, 0.930459f,
+    0.924753f, 0.919265f, 0.913572f, 0.907355f, 0.900121f, 0.891311f, 0.880237f, 0.866344f,
+    0.849862f, 0.831344f, 0.811588f, 0.791846f, 0.774360f, 0.760606f, 0.750845f, 0.744525f,
+    0.740501f, 0.735481f, 0.729053f, 0.721211f, 0.712629f, 0.703655f, 0.694693f, 0.685478f,
+    0.999546f, 0.986174f, 0.972927f, 0.961055f, 0.950439f, 0.941101f, 0.932818f, 0.925408f,
+    0.918555f, 0.911970f, 0.905385f, 0.898445f, 0.890790f, 0.881909f, 0.871328f, 0.858361f,
+    0.842581f, 0.824364f, 0.803956f, 0.782274f, 0.760676f, 0.741124f, 0.725510f, 0.713641f,
+    0.705397f, 0.697536f, 0.688446f, 0.677473f, 0.665107f, 0.652129f, 0.639064f, 0.625818f,
+    0.999538f, 0.985902f, 0.972196f, 0.959665f, 0.948188f, 0.937804f, 0.928369f, 0.919675f,
+    0.911531f, 0.903681f, 0.895902f, 0.887904f, 0.879295f, 0.869801f, 0.858945f, 0.846204f,
+    0.831014f, 0.812869f, 0.792452f, 0.769744f, 0.745663f, 0.722102f, 0.700587f, 0.682371f,
+    0.668745f, 0.657691f, 0.646018f, 0.632439f, 0.617076f, 0.600753f, 0.584354f, 0.567927f,
+    0.999521f, 0.985479f, 0.971170f, 0.957877f, 0.945449f, 0.933932f, 0.923237f, 0.913158f,
+    0.903529f, 0.894261f, 0.885054f, 0.875614f, 0.865753f, 0.855169f, 0.843446f, 0.830230f,
+    0.814870f, 0.796892f, 0.776241f, 0.752996f, 0.727585f, 0.700981f, 0.675035f, 0.651574f,
+    0.632062f, 0.616407f, 0.602250f, 0.586831f, 0.569274f, 0.550521f, 0.531582f, 0.512910f,
+    0.999503f, 0.984889f, 0.969835f, 0.955632f, 0.942142f, 0.929383f, 0.917289f, 0.905704f,
+    0.894519f, 0.883577f, 0.872671f, 0.861605f, 0.850181f, 0.838100f, 0.825082f, 0.810763f,
+    0.794750f, 0.776442f, 0.755487f, 0.731794f, 0.705653f, 0.677461f, 0.648391f, 0.620670f,
+    0.595903f, 0.575151f, 0.558297f, 0.541339f, 0.522492f, 0.502155f, 0.481632f, 0.461534f,
+    1.000000f, 1.000000f, 0.999996f, 0.999929f, 0.999870f, 0.999706f, 0.999308f, 0.998766f,
+    0.997901f, 0.996635f, 0.994893f, 0.992544f, 0.989485f, 0.985593f, 0.980777f, 0.974878f,
+    0.967767f, 0.959386f, 0.949561f, 0.938209f, 0.925247f, 0.910723f, 0.894436f, 0.876416f,
+    0.856578f, 0.834964f, 0.811596f, 0.786568f, 0.759970f, 0.732010f, 0.702792f, 0.672667f
+};
+
+}   // namespace renderer
@@ -34,6 +34,7 @@
 #include "renderer/kernel/shading/shadingcomponents.h"
 #include "renderer/modeling/bsdf/bsdf.h"
 #include "renderer/modeling/bsdf/bsdfwrapper.h"
+#include "renderer/modeling/bsdf/energycompensation.h"
 #include "renderer/modeling/bsdf/fresnel.h"
 #include "renderer/modeling/bsdf/microfacethelper.h"
 #include "renderer/modeling/bsdf/specularhelper.h"
@@ -92,6 +93,7 @@ namespace
             const char*             name,
             const ParamArray&       params)
           : BSDF(name, Reflective, ScatteringMode::Glossy | ScatteringMode::Specular, params)
+          , m_albedo_table(0)
         {
             m_inputs.declare("reflectance", InputFormatSpectralReflectance);
             m_inputs.declare("reflectance_multiplier", InputFormatFloat, "1.0");
@@ -99,6 +101,7 @@ namespace
             m_inputs.declare("highlight_falloff", InputFormatFloat, "0.4");
             m_inputs.declare("anisotropy", InputFormatFloat, "0.0");
             m_inputs.declare("ior", InputFormatFloat, "1.5");
+            m_inputs.declare("energy_compensation", InputFormatFloat, "0.0");
         }
 
         virtual void release() override
@@ -151,6 +154,13 @@ namespace
                 m_mdf.reset(new StdMDF());
             else return false;
 
+            // Energy compensation is only available for distributions with precomputed albedo tables.
+            if (mdf == "ggx")
+                m_albedo_table = &get_ggx_albedo_table();
+            else if (mdf == "beckmann")
+                m_albedo_table = &get_beckmann_albedo_table();
+            else m_albedo_table = 0;
+
             return true;
         }
 
@@ -205,6 +215,15 @@ namespace
                     cos_on,
                     sample);
 
+                if (sample.m_mode == ScatteringMode::Glossy)
+                {
+                    add_energy_compensation(
+                        values,
+                        dot(sample.m_incoming.get_value(), n),
+                        cos_on,
+                        sample.m_value.m_glossy);
+                }
+
                 sample.m_value.m_beauty = sample.m_value.m_glossy;
             }
         }
@@ -259,6 +278,7 @@ namespace
                 cos_in,
                 cos_on,
                 value.m_glossy);
+            add_energy_compensation(values, cos_in, cos_on, value.m_glossy);
             value.m_beauty = value.m_glossy;
             return pdf;
         }
@@ -304,7 +324,32 @@ namespace
       private:
         typedef GlossyBRDFInputValues InputValues;
 
-        auto_ptr<MDF> m_mdf;
+        auto_ptr<MDF>                   m_mdf;
+        const MicrofacetAlbedoTable*    m_albedo_table;
+
+        void add_energy_compensation(
+            const InputValues*      values,
+            const float             cos_in,
+            const float             cos_on,
+            Spectrum&               value) const
+        {
+            if (m_albedo_table == 0 || values->m_energy_compensation == 0.0f)
+                return;
+
+            Spectrum average_fresnel(values->m_reflectance);
+            average_fresnel *=
+                values->m_reflectance_multiplier *
+                average_fresnel_reflectance_dielectric(values->m_ior / values->m_precomputed.m_outside_ior);
+
+            add_energy_compensation_term(
+                *m_albedo_table,
+                values->m_roughness,
+                cos_in,
+                cos_on,
+                average_fresnel,
+                values->m_energy_compensation,
+                value);
+        }
     };
 
     typedef BSDFWrapper<GlossyBRDFImpl> GlossyBRDF;
@@ -439,6 +484,22 @@ DictionaryArray GlossyBRDFFactory::get_input_metadata() const
             .insert("use", "required")
             .insert("default", "1.5"));
 
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "energy_compensation")
+            .insert("label", "Energy Compensation")
+            .insert("type", "numeric")
+            .insert("min",
+                Dictionary()
+                    .insert("value", "0.0")
+                    .insert("type", "hard"))
+            .insert("max",
+                Dictionary()
+                    .insert("value", "1.0")
+                    .insert("type", "hard"))
+            .insert("use", "optional")
+            .insert("default", "0.0"));
+
     return metadata;
 }
 
@@ -62,6 +62,7 @@ APPLESEED_DECLARE_INPUT_VALUES(GlossyBRDFInputValues)
     float       m_highlight_falloff;
     float       m_anisotropy;
     float       m_ior;
+    float       m_energy_compensation;
 
     struct Precomputed
     {
@@ -319,7 +319,9 @@ namespace
                 Spectrum matte_comp(1.0f);
                 matte_comp -= specular_albedo_L;
                 matte_comp *= matte_albedo;
-                matte_comp *= m_s;
+                Spectrum s = m_s;
+                s.gather_hero_wavelengths();
+                matte_comp *= s;
                 sample.m_value.m_diffuse = matte_comp;
 
                 // Evaluate the PDF of the incoming direction for the matte component.
@@ -410,7 +412,9 @@ namespace
                 Spectrum matte_comp(1.0f);
                 matte_comp -= specular_albedo_L;
                 matte_comp *= matte_albedo;
-                matte_comp *= m_s;
+                Spectrum s = m_s;
+                s.gather_hero_wavelengths();
+                matte_comp *= s;
                 value.m_diffuse = matte_comp;
 
                 // Evaluate the PDF of the incoming direction for the matte component.
@@ -650,9 +654,10 @@ namespace
             if (i < AlbedoTableSize - 1)
             {
                 // Piecewise linear reconstruction.
-                const Spectrum& prev_a = a_spec[i];
-                const Spectrum& next_a = a_spec[i + 1];
-                result = next_a;
+                Spectrum prev_a = a_spec[i];
+                prev_a.gather_hero_wavelengths();
+                result = a_spec[i + 1];
+                result.gather_hero_wavelengths();
                 result -= prev_a;
                 result *= x;
                 result += prev_a;
@@ -660,6 +665,7 @@ namespace
             else
             {
                 result = a_spec[AlbedoTableSize - 1];
+                result.gather_hero_wavelengths();
             }
         }
 
@@ -34,6 +34,7 @@
 #include "renderer/kernel/shading/shadingcomponents.h"
 #include "renderer/modeling/bsdf/bsdf.h"
 #include "renderer/modeling/bsdf/bsdfwrapper.h"
+#include "renderer/modeling/bsdf/energycompensation.h"
 #include "renderer/modeling/bsdf/fresnel.h"
 #include "renderer/modeling/bsdf/microfacethelper.h"
 #include "renderer/modeling/bsdf/specularhelper.h"
@@ -96,6 +97,7 @@ namespace
             const char*             name,
             const ParamArray&       params)
           : BSDF(name, Reflective, ScatteringMode::Glossy | ScatteringMode::Specular, params)
+          , m_albedo_table(0)
         {
             m_inputs.declare("normal_reflectance", InputFormatSpectralReflectance);
             m_inputs.declare("edge_tint", InputFormatSpectralReflectance);
@@ -103,6 +105,7 @@ namespace
             m_inputs.declare("roughness", InputFormatFloat, "0.15");
             m_inputs.declare("highlight_falloff", InputFormatFloat, "0.4");
             m_inputs.declare("anisotropy", InputFormatFloat, "0.0");
+            m_inputs.declare("energy_compensation", InputFormatFloat, "0.0");
         }
 
         virtual void release() override
@@ -161,6 +164,13 @@ namespace
                 m_mdf.reset(new StdMDF());
             else return false;
 
+            // Energy compensation is only available for distributions with precomputed albedo tables.
+            if (mdf == "ggx")
+                m_albedo_table = &get_ggx_albedo_table();
+            else if (mdf == "beckmann")
+                m_albedo_table = &get_beckmann_albedo_table();
+            else m_albedo_table = 0;
+
             return true;
         }
 
@@ -216,6 +226,15 @@ namespace
                     cos_on,
                     sample);
 
+                if (sample.m_mode == ScatteringMode::Glossy)
+                {
+                    add_energy_compensation(
+                        values,
+                        dot(sample.m_incoming.get_value(), n),
+                        cos_on,
+                        sample.m_value.m_glossy);
+                }
+
                 sample.m_value.m_beauty = sample.m_value.m_glossy;
             }
         }
@@ -271,6 +290,7 @@ namespace
                 cos_in,
                 cos_on,
                 value.m_glossy);
+            add_energy_compensation(values, cos_in, cos_on, value.m_glossy);
             value.m_beauty = value.m_glossy;
             return pdf;
         }
@@ -316,7 +336,34 @@ namespace
       private:
         typedef MetalBRDFInputValues InputValues;
 
-        auto_ptr<MDF> m_mdf;
+        auto_ptr<MDF>                   m_mdf;
+        const MicrofacetAlbedoTable*    m_albedo_table;
+
+        void add_energy_compensation(
+            const InputValues*      values,
+            const float             cos_in,
+            const float             cos_on,
+            Spectrum&               value) const
+        {
+            if (m_albedo_table == 0 || values->m_energy_compensation == 0.0f)
+                return;
+
+            // Approximate the average Fresnel reflectance of the conductor from its
+            // reflectance at normal incidence, ignoring the edge tint.
+            Spectrum average_fresnel(values->m_normal_reflectance);
+            average_fresnel *= 20.0f / 21.0f;
+            average_fresnel += Spectrum(1.0f / 21.0f);
+            average_fresnel *= values->m_reflectance_multiplier;
+
+            add_energy_compensation_term(
+                *m_albedo_table,
+                values->m_roughness,
+                cos_in,
+                cos_on,
+                average_fresnel,
+                values->m_energy_compensation,
+                value);
+        }
     };
 
     typedef BSDFWrapper<MetalBRDFImpl> MetalBRDF;
@@ -447,6 +494,22 @@ DictionaryArray MetalBRDFFactory::get_input_metadata() const
                     .insert("type", "hard"))
             .insert("default", "0.0"));
 
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "energy_compensation")
+            .insert("label", "Energy Compensation")
+            .insert("type", "numeric")
+            .insert("min",
+                Dictionary()
+                    .insert("value", "0.0")
+                    .insert("type", "hard"))
+            .insert("max",
+                Dictionary()
+                    .insert("value", "1.0")
+                    .insert("type", "hard"))
+            .insert("use", "optional")
+            .insert("default", "0.0"));
+
     return metadata;
 }
 
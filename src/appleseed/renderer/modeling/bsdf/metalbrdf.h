@@ -62,6 +62,7 @@ APPLESEED_DECLARE_INPUT_VALUES(MetalBRDFInputValues)
     float       m_roughness;
     float       m_highlight_falloff;
     float       m_anisotropy;
+    float       m_energy_compensation;
 
     struct Precomputed
     {
@@ -119,20 +119,21 @@ class MicrofacetBRDFHelper
         if (cos_in <= 0.0f)
             return;
 
-        const float D = mdf.D(m, alpha_x, alpha_y, gamma);
-
-        const float G =
-            mdf.G(
-                sample.m_shading_basis.transform_to_local(incoming),
-                wo,
-                m,
-                alpha_x,
-                alpha_y,
-                gamma);
+        float D, G, pdf;
+        mdf.evaluate(
+            sample.m_shading_basis.transform_to_local(incoming),
+            wo,
+            m,
+            alpha_x,
+            alpha_y,
+            gamma,
+            D,
+            G,
+            pdf);
 
         f(sample.m_outgoing.get_value(), h, sample.m_shading_basis.get_normal(), sample.m_value.m_glossy);
         sample.m_value.m_glossy *= D * G / (4.0f * cos_on * cos_in);
-        sample.m_probability = mdf.pdf(wo, m, alpha_x, alpha_y, gamma) / (4.0f * cos_oh);
+        sample.m_probability = pdf / (4.0f * cos_oh);
         sample.m_mode = ScatteringMode::Glossy;
         sample.m_incoming = foundation::Dual<foundation::Vector3f>(incoming);
         sample.compute_reflected_differentials();
@@ -154,22 +155,24 @@ class MicrofacetBRDFHelper
     {
         const foundation::Vector3f h = foundation::normalize(incoming + outgoing);
         const foundation::Vector3f m = shading_basis.transform_to_local(h);
-        const float D = mdf.D(m, alpha_x, alpha_y, gamma);
-
         const foundation::Vector3f wo = shading_basis.transform_to_local(outgoing);
-        const float G =
-            mdf.G(
-                shading_basis.transform_to_local(incoming),
-                wo,
-                m,
-                alpha_x,
-                alpha_y,
-                gamma);
+
+        float D, G, pdf;
+        mdf.evaluate(
+            shading_basis.transform_to_local(incoming),
+            wo,
+            m,
+            alpha_x,
+            alpha_y,
+            gamma,
+            D,
+            G,
+            pdf);
 
         const float cos_oh = foundation::dot(outgoing, h);
         f(outgoing, h, shading_basis.get_normal(), value);
         value *= D * G / (4.0f * cos_on * cos_in);
-        return mdf.pdf(wo, m, alpha_x, alpha_y, gamma) / (4.0f * cos_oh);
+        return pdf / (4.0f * cos_oh);
     }
 
     template <typename MDF>
@@ -52,6 +52,7 @@ DipoleBSSRDF::DipoleBSSRDF(
     const ParamArray&       params)
   : SeparableBSSRDF(name, params)
   , m_has_sigma_sources(false)
+  , m_alpha_prime_table_eta(0.0f)
 {
     m_inputs.declare("weight", InputFormatFloat, "1.0");
     m_inputs.declare("reflectance", InputFormatSpectralReflectance);
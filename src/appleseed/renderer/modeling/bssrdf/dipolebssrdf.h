@@ -34,6 +34,7 @@
 #include "renderer/modeling/bssrdf/separablebssrdf.h"
 #include "renderer/modeling/bssrdf/sss.h"
 #include "renderer/modeling/input/inputarray.h"
+#include "renderer/modeling/input/source.h"
 
 // appleseed.foundation headers.
 #include "foundation/math/vector.h"
@@ -133,13 +134,20 @@ class DipoleBSSRDF
         Spectrum&                   value) const override;
 
   protected:
+    // Tabulate the inverse of Rd for the relative index of refraction of the
+    // material against vacuum, if the index of refraction is uniform.
+    template <typename ComputeRdFun>
+    void initialize_alpha_prime_table();
+
     template <typename ComputeRdFun>
     void do_prepare_inputs(
         const ShadingPoint&         shading_point,
         DipoleBSSRDFInputValues*    values) const;
 
   private:
-    bool m_has_sigma_sources;
+    bool            m_has_sigma_sources;
+    AlphaPrimeTable m_alpha_prime_table;
+    float           m_alpha_prime_table_eta;
 };
 
 
@@ -160,6 +168,27 @@ inline bool DipoleBSSRDF::on_frame_begin(
     return true;
 }
 
+template <typename ComputeRdFun>
+void DipoleBSSRDF::initialize_alpha_prime_table()
+{
+    m_alpha_prime_table_eta = 0.0f;
+
+    if (m_has_sigma_sources)
+        return;
+
+    const Source* ior_source = m_inputs.source("ior");
+    if (ior_source == nullptr || !ior_source->is_uniform())
+        return;
+
+    float ior;
+    ior_source->evaluate_uniform(ior);
+    if (ior <= 0.0f)
+        return;
+
+    m_alpha_prime_table_eta = 1.0f / ior;
+    m_alpha_prime_table.initialize(ComputeRdFun(m_alpha_prime_table_eta));
+}
+
 template <typename ComputeRdFun>
 void DipoleBSSRDF::do_prepare_inputs(
     const ShadingPoint&             shading_point,
@@ -189,14 +218,26 @@ void DipoleBSSRDF::do_prepare_inputs(
         foundation::clamp_in_place(values->m_reflectance, 0.001f, 0.999f);
         foundation::clamp_low_in_place(values->m_mfp, 1.0e-6f);
 
-        // Compute sigma_a and sigma_s.
-        const ComputeRdFun rd_fun(values->m_base_values.m_eta);
-        compute_absorption_and_scattering_mfp(
-            rd_fun,
-            values->m_reflectance,
-            values->m_mfp,
-            values->m_sigma_a,
-            values->m_sigma_s);
+        // Compute sigma_a and sigma_s, using the precomputed inverse of Rd if it applies.
+        if (values->m_base_values.m_eta == m_alpha_prime_table_eta)
+        {
+            compute_absorption_and_scattering_mfp(
+                m_alpha_prime_table,
+                values->m_reflectance,
+                values->m_mfp,
+                values->m_sigma_a,
+                values->m_sigma_s);
+        }
+        else
+        {
+            const ComputeRdFun rd_fun(values->m_base_values.m_eta);
+            compute_absorption_and_scattering_mfp(
+                rd_fun,
+                values->m_reflectance,
+                values->m_mfp,
+                values->m_sigma_a,
+                values->m_sigma_s);
+        }
     }
 
     //
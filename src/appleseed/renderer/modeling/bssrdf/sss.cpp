@@ -30,12 +30,12 @@
 #include "sss.h"
 
 // appleseed.foundation headers.
-#include "foundation/math/cdf.h"
 #include "foundation/math/fresnel.h"
 #include "foundation/math/sampling/mappings.h"
 #include "foundation/math/scalar.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cmath>
 
 using namespace foundation;
@@ -188,99 +188,38 @@ float normalized_diffusion_profile(
 
 namespace
 {
-    const size_t NDCDFTableSize = 128;
-    const float NDCDFTableRmax = 55.0f;
-    const float NDCDFTableStep = NDCDFTableRmax / NDCDFTableSize;
-
-    float nd_cdf_table[NDCDFTableSize];
-    float nd_cdf_rmax;
-
-    struct InitializeNDCDFTable
-    {
-        InitializeNDCDFTable()
-        {
-            for (size_t i = 0; i < NDCDFTableSize; ++i)
-            {
-                const float r = fit<size_t, float>(i, 0, NDCDFTableSize - 1, 0.0f, NDCDFTableRmax);
-                nd_cdf_table[i] = normalized_diffusion_cdf(r, 1.0f);
-            }
-
-            // Save the real value of cdf(Rmax, 1).
-            nd_cdf_rmax = nd_cdf_table[NDCDFTableSize - 1];
-
-            // Make sure the last value is exactly 1.
-            nd_cdf_table[NDCDFTableSize - 1] = 1.0f;
-        }
-    };
-
-    InitializeNDCDFTable initialize_nd_cdf_table;
-
-    struct NDCDFFun
-    {
-        const float m_d;
-
-        explicit NDCDFFun(const float d)
-          : m_d(d)
-        {
-        }
-
-        float operator()(const float r) const
-        {
-            return normalized_diffusion_cdf(r, m_d);
-        }
-    };
-
-    struct NDPDFFun
-    {
-        const float m_d;
-
-        explicit NDPDFFun(const float d)
-          : m_d(d)
-        {
-        }
-
-        float operator()(const float r) const
-        {
-            return normalized_diffusion_pdf(r, m_d);
-        }
-    };
+    // Radius, in units of the curve shape d, beyond which we consider R(r) zero.
+    const float NDRmax = 55.0f;
 }
 
 float normalized_diffusion_sample(
     const float     u,
     const float     l,
-    const float     s,
-    const float     eps,
-    const size_t    max_iterations)
+    const float     s)
 {
     assert(u >= 0.0f);
     assert(u < 1.0f);
 
     const float d = l / s;
 
-    // Handle the case where u is greater than the value we consider 1 in our CDF.
-    if (u >= nd_cdf_rmax)
-        return NDCDFTableRmax * d;
-
-    // Use the CDF to find an initial interval for the root of cdf(r, 1) - u = 0.
-    const size_t i = sample_cdf(nd_cdf_table, nd_cdf_table + NDCDFTableSize, u);
-    assert(i > 0);
-    assert(nd_cdf_table[i - 1] <= u);
-    assert(nd_cdf_table[i] > u);
-
-    // Transform the cdf(r, 1) interval to cdf(r, d) using the fact that cdf(r, d) == cdf(r/d, 1).
-    const float rmin = fit<size_t, float>(i - 1, 0, NDCDFTableSize - 1, 0.0f, NDCDFTableRmax) * d;
-    const float rmax = fit<size_t, float>(i,     0, NDCDFTableSize - 1, 0.0f, NDCDFTableRmax) * d;
-
-    return invert_cdf_function(
-        NDCDFFun(d),
-        NDPDFFun(d),
-        u,
-        rmin,
-        rmax,
-        (rmax + rmin) * 0.5f,
-        eps,
-        max_iterations);
+    //
+    // With t = exp(-r / (3 * d)), solving cdf(r, d) = u amounts to finding the unique
+    // real root of the depressed cubic t^3 + 3 * t - 4 * (1 - u) = 0. Cardano's formula
+    // gives t = w - 1 / w with w = cbrt(2 * (1 - u) + sqrt(4 * (1 - u)^2 + 1)).
+    //
+    // Reference:
+    //
+    //   Efficient Screen-Space Subsurface Scattering Using Burley's Normalized Diffusion in Real-Time
+    //   Evgenii Golubev
+    //   http://advances.realtimerendering.com/s2018/Efficient%20screen%20space%20subsurface%20scattering%20Siggraph%202018.pdf
+    //
+
+    const float a = 2.0f * (1.0f - u);
+    const float w = cbrt(a + sqrt(a * a + 1.0f));
+    const float t = w - 1.0f / w;
+
+    // Clamp to the radius at which we consider R(r) zero.
+    return t > 0.0f ? min(-3.0f * d * log(t), NDRmax * d) : NDRmax * d;
 }
 
 float normalized_diffusion_cdf(
@@ -321,7 +260,7 @@ float normalized_diffusion_max_radius(
     // todo: some plots suggest that our estimate
     // for max radius is too conservative.
     // We could probably reduce it a bit.
-    return d * NDCDFTableRmax;
+    return d * NDRmax;
 }
 
 float normalized_diffusion_max_radius(
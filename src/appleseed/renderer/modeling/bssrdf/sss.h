@@ -33,7 +33,9 @@
 #include "renderer/global/globaltypes.h"
 
 // Standard headers.
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 
 namespace renderer
@@ -83,9 +85,40 @@ class ComputeRdBetterDipole
 // Numerically solve for the reduced albedo alpha' given Rd.
 template <typename ComputeRdFun>
 float compute_alpha_prime(
-    const ComputeRdFun  rd_fun,
+    const ComputeRdFun& rd_fun,
     const float         rd);
 
+// A table of the solutions alpha' of Rd(alpha') = rd for regularly spaced values of sqrt(rd),
+// built once for a given Rd function and used in place of the numerical solver.
+class AlphaPrimeTable
+{
+  public:
+    // Constructor, leaves the table uninitialized.
+    AlphaPrimeTable();
+
+    // Build the table for a given Rd function.
+    template <typename ComputeRdFun>
+    void initialize(const ComputeRdFun& rd_fun);
+
+    // Return true if the table was initialized.
+    bool is_initialized() const;
+
+    // Look up alpha' given Rd in [0,1].
+    float lookup(const float rd) const;
+
+  private:
+    enum { Size = 1024 };
+
+    bool    m_initialized;
+    float   m_values[Size + 1];
+};
+
+// Solve for the reduced albedo alpha' given Rd using a precomputed table.
+// Functions below that take an Rd function also accept such a table.
+float compute_alpha_prime(
+    const AlphaPrimeTable&  table,
+    const float             rd);
+
 float diffusion_coefficient(
     const float         sigma_a,
     const float         sigma_t);
@@ -112,7 +145,7 @@ void effective_extinction_coefficient(
 // rd and dmfp must have the same size (both RGB or both spectral).
 template <typename ComputeRdFun>
 void compute_absorption_and_scattering_dmfp(
-    const ComputeRdFun  rd_fun,
+    const ComputeRdFun& rd_fun,
     const Spectrum&     rd,                     // diffuse surface reflectance
     const Spectrum&     dmfp,                   // diffuse mean free path
     const float         g,                      // anisotropy
@@ -122,7 +155,7 @@ void compute_absorption_and_scattering_dmfp(
 // rd and mfp must have the same size (both RGB or both spectral).
 template <typename ComputeRdFun>
 void compute_absorption_and_scattering_mfp(
-    const ComputeRdFun  rd_fun,
+    const ComputeRdFun& rd_fun,
     const Spectrum&     rd,                     // diffuse surface reflectance
     const Spectrum&     mfp,                    // mean free path
     Spectrum&           sigma_a,                // absorption coefficient
@@ -166,13 +199,11 @@ float normalized_diffusion_profile(
     const float         s,                      // scaling factor
     const float         a);                     // surface albedo
 
-// Sample the function r * R(r).
+// Sample the function r * R(r) by analytically inverting its cumulative distribution function.
 float normalized_diffusion_sample(
     const float         u,                      // uniform random sample in [0,1)
     const float         l,                      // mean free path length or diffuse mean free path length
-    const float         s,                      // scaling factor
-    const float         eps = 0.0001f,          // root precision
-    const size_t        max_iterations = 10);   // max root refinement iterations
+    const float         s);                     // scaling factor
 
 // Evaluate the cumulative distribution function of r * R(r).
 float normalized_diffusion_cdf(
@@ -206,7 +237,7 @@ float normalized_diffusion_max_radius(
 
 template <typename ComputeRdFun>
 inline float compute_alpha_prime(
-    const ComputeRdFun  rd_fun,
+    const ComputeRdFun& rd_fun,
     const float         rd)
 {
     float x0 = 0.0f, x1 = 1.0f;
@@ -222,9 +253,52 @@ inline float compute_alpha_prime(
     return 0.5f * (x0 + x1);
 }
 
+inline AlphaPrimeTable::AlphaPrimeTable()
+  : m_initialized(false)
+{
+}
+
+template <typename ComputeRdFun>
+void AlphaPrimeTable::initialize(const ComputeRdFun& rd_fun)
+{
+    for (size_t i = 0; i <= Size; ++i)
+    {
+        const float x = static_cast<float>(i) / Size;
+        m_values[i] = compute_alpha_prime(rd_fun, x * x);
+    }
+
+    m_initialized = true;
+}
+
+inline bool AlphaPrimeTable::is_initialized() const
+{
+    return m_initialized;
+}
+
+inline float AlphaPrimeTable::lookup(const float rd) const
+{
+    assert(m_initialized);
+    assert(rd >= 0.0f);
+    assert(rd <= 1.0f);
+
+    // The table is indexed by sqrt(Rd) since alpha' grows quickly near Rd = 0.
+    const float x = std::sqrt(rd) * Size;
+    const size_t i = std::min(static_cast<size_t>(x), static_cast<size_t>(Size - 1));
+    const float t = x - i;
+
+    return (1.0f - t) * m_values[i] + t * m_values[i + 1];
+}
+
+inline float compute_alpha_prime(
+    const AlphaPrimeTable&  table,
+    const float             rd)
+{
+    return table.lookup(rd);
+}
+
 template <typename ComputeRdFun>
 void compute_absorption_and_scattering_dmfp(
-    const ComputeRdFun  rd_fun,
+    const ComputeRdFun& rd_fun,
     const Spectrum&     rd,
     const Spectrum&     dmfp,
     const float         g,
@@ -241,7 +315,7 @@ void compute_absorption_and_scattering_dmfp(
         assert(rd[i] > 0.0f);
         assert(rd[i] < 1.0f);
 
-        // Find alpha' by numerically inverting Rd(alpha').
+        // Find alpha' by inverting Rd(alpha').
         const float alpha_prime = compute_alpha_prime(rd_fun, rd[i]);
         assert(alpha_prime > 0.0f);
         assert(alpha_prime < 1.0f);
@@ -261,7 +335,7 @@ void compute_absorption_and_scattering_dmfp(
 
 template <typename ComputeRdFun>
 void compute_absorption_and_scattering_mfp(
-    const ComputeRdFun  rd_fun,
+    const ComputeRdFun& rd_fun,
     const Spectrum&     rd,
     const Spectrum&     mfp,
     Spectrum&           sigma_a,
@@ -273,7 +347,7 @@ void compute_absorption_and_scattering_mfp(
         assert(rd[i] < 1.0f);
         assert(mfp[i] > 0.0f);
 
-        // Find alpha by numerically inverting Rd(alpha).
+        // Find alpha by inverting Rd(alpha).
         const float alpha = compute_alpha_prime(rd_fun, rd[i]);
         assert(alpha > 0.0f);
         assert(alpha < 1.0f);
@@ -91,6 +91,20 @@ namespace
             return Model;
         }
 
+        virtual bool on_frame_begin(
+            const Project&          project,
+            const BaseGroup*        parent,
+            OnFrameBeginRecorder&   recorder,
+            IAbortSwitch*           abort_switch) override
+        {
+            if (!DipoleBSSRDF::on_frame_begin(project, parent, recorder, abort_switch))
+                return false;
+
+            initialize_alpha_prime_table<ComputeRdStandardDipole>();
+
+            return true;
+        }
+
         virtual void prepare_inputs(
             Arena&                  arena,
             const ShadingPoint&     shading_point,
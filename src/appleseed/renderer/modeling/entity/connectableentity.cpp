@@ -46,6 +46,29 @@ using namespace foundation;
 namespace renderer
 {
 
+bool ConnectableEntity::on_frame_begin(
+    const Project&          project,
+    const BaseGroup*        parent,
+    OnFrameBeginRecorder&   recorder,
+    IAbortSwitch*           abort_switch)
+{
+    if (!Entity::on_frame_begin(project, parent, recorder, abort_switch))
+        return false;
+
+    m_inputs.prepare_uniforms();
+
+    return true;
+}
+
+void ConnectableEntity::on_frame_end(
+    const Project&          project,
+    const BaseGroup*        parent)
+{
+    m_inputs.release_uniforms();
+
+    Entity::on_frame_end(project, parent);
+}
+
 bool ConnectableEntity::is_uniform_zero_scalar(const Source* source)
 {
     assert(source);
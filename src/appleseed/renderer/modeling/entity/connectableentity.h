@@ -66,6 +66,17 @@ class APPLESEED_DLLSYMBOL ConnectableEntity
     InputArray& get_inputs();
     const InputArray& get_inputs() const;
 
+    // Prepare the values of uniform inputs for the duration of the frame.
+    virtual bool on_frame_begin(
+        const Project&              project,
+        const BaseGroup*            parent,
+        OnFrameBeginRecorder&       recorder,
+        foundation::IAbortSwitch*   abort_switch = 0) override;
+
+    virtual void on_frame_end(
+        const Project&              project,
+        const BaseGroup*            parent) override;
+
   protected:
     InputArray m_inputs;
 
@@ -115,6 +115,7 @@ namespace
         {
             outgoing = sample_sphere_uniform(s);
             value = m_values.m_radiance;
+            value.gather_hero_wavelengths();
             probability = RcpFourPi<float>();
         }
 
@@ -125,6 +126,7 @@ namespace
         {
             assert(is_normalized(outgoing));
             value = m_values.m_radiance;
+            value.gather_hero_wavelengths();
         }
 
         virtual void evaluate(
@@ -135,6 +137,7 @@ namespace
         {
             assert(is_normalized(outgoing));
             value = m_values.m_radiance;
+            value.gather_hero_wavelengths();
             probability = RcpFourPi<float>();
         }
 
@@ -128,6 +128,8 @@ namespace
                 local_outgoing.y >= 0.0f
                     ? m_values.m_upper_hemi_radiance
                     : m_values.m_lower_hemi_radiance;
+
+            value.gather_hero_wavelengths();
         }
 
         virtual void evaluate(
@@ -149,6 +151,8 @@ namespace
                 local_outgoing_y >= 0.0f
                     ? m_values.m_upper_hemi_radiance
                     : m_values.m_lower_hemi_radiance;
+
+            value.gather_hero_wavelengths();
         }
 
         virtual void evaluate(
@@ -172,6 +176,8 @@ namespace
                     ? m_values.m_upper_hemi_radiance
                     : m_values.m_lower_hemi_radiance;
 
+            value.gather_hero_wavelengths();
+
             probability = RcpFourPi<float>();
         }
 
@@ -191,8 +191,10 @@ namespace
 
             // Blend the horizon and zenith radiances.
             Spectrum horizon_radiance = m_values.m_horizon_radiance;
+            horizon_radiance.gather_hero_wavelengths();
             horizon_radiance *= blend;
             output = m_values.m_zenith_radiance;
+            output.gather_hero_wavelengths();
             output *= 1.0f - blend;
             output += horizon_radiance;
         }
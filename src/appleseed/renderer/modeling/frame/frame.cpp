@@ -53,6 +53,7 @@
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/api/specializedapiarrays.h"
 #include "foundation/utility/iostreamop.h"
+#include "foundation/utility/job/parallelfor.h"
 #include "foundation/utility/otherwise.h"
 #include "foundation/utility/stopwatch.h"
 #include "foundation/utility/string.h"
@@ -596,11 +597,15 @@ namespace
     {
         const CanvasProperties& image_props = image.properties();
 
-        for (size_t ty = 0; ty < image_props.m_tile_count_y; ++ty)
-        {
-            for (size_t tx = 0; tx < image_props.m_tile_count_x; ++tx)
-                transform_to_srgb(image.tile(tx, ty));
-        }
+        parallel_for(
+            image_props.m_tile_count,
+            [&](const size_t tile_index)
+            {
+                transform_to_srgb(
+                    image.tile(
+                        tile_index % image_props.m_tile_count_x,
+                        tile_index / image_props.m_tile_count_x));
+            });
     }
 }
 
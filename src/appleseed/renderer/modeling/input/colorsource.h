@@ -115,6 +115,7 @@ inline void ColorSource::evaluate_uniform(
     Spectrum&                       spectrum) const
 {
     spectrum = m_spectrum;
+    spectrum.gather_hero_wavelengths();
 }
 
 inline void ColorSource::evaluate_uniform(
@@ -136,6 +137,7 @@ inline void ColorSource::evaluate_uniform(
     Alpha&                          alpha) const
 {
     spectrum = m_spectrum;
+    spectrum.gather_hero_wavelengths();
     alpha = m_alpha;
 }
 
@@ -332,7 +332,39 @@ namespace
 
 struct InputArray::Impl
 {
-    InputVector m_inputs;
+    InputVector     m_inputs;
+
+    // Prepared uniform values.
+    uint8*          m_uniform_values;
+    size_t          m_uniform_values_size;
+    vector<size_t>  m_varying_inputs;           // indices of the inputs that must be evaluated at every call
+    vector<size_t>  m_varying_input_offsets;    // offsets of these inputs in the block of input values
+    vector<size_t>  m_uniform_spectra_offsets;  // offsets of the prepared spectra in the block of input values
+
+    Impl()
+      : m_uniform_values(0)
+      , m_uniform_values_size(0)
+    {
+    }
+
+    ~Impl()
+    {
+        release_uniforms();
+    }
+
+    void release_uniforms()
+    {
+        if (m_uniform_values)
+        {
+            aligned_free(m_uniform_values);
+            m_uniform_values = 0;
+            m_uniform_values_size = 0;
+        }
+
+        clear_release_memory(m_varying_inputs);
+        clear_release_memory(m_varying_input_offsets);
+        clear_release_memory(m_uniform_spectra_offsets);
+    }
 };
 
 InputArray::InputArray()
@@ -367,6 +399,7 @@ void InputArray::declare(
     input.m_entity = 0;
 
     impl->m_inputs.push_back(input);
+    impl->release_uniforms();
 }
 
 InputArray::iterator InputArray::begin()
@@ -470,6 +503,34 @@ void InputArray::evaluate(
     assert(is_aligned(ptr, 16));
 #endif
 
+    if (impl->m_uniform_values)
+    {
+        // Fast path: copy the prepared uniform values and only evaluate the varying inputs.
+        memcpy(ptr, impl->m_uniform_values, impl->m_uniform_values_size);
+
+        // Spectra were prepared in full and must be sampled at the wavelengths of the current path.
+        if (Spectrum::get_mode() == Spectrum::HeroWavelength)
+        {
+            const size_t uniform_spectrum_count = impl->m_uniform_spectra_offsets.size();
+            for (size_t i = 0; i < uniform_spectrum_count; ++i)
+            {
+                Spectrum* spectrum = reinterpret_cast<Spectrum*>(ptr + impl->m_uniform_spectra_offsets[i]);
+                spectrum->gather_hero_wavelengths();
+            }
+        }
+
+        const size_t varying_input_count = impl->m_varying_inputs.size();
+        for (size_t i = 0; i < varying_input_count; ++i)
+        {
+            impl->m_inputs[impl->m_varying_inputs[i]].evaluate(
+                texture_cache,
+                uv,
+                ptr + impl->m_varying_input_offsets[i]);
+        }
+
+        return;
+    }
+
     for (const_each<InputVector> i = impl->m_inputs; i; ++i)
         ptr = i->evaluate(texture_cache, uv, ptr);
 }
@@ -489,6 +550,52 @@ void InputArray::evaluate_uniforms(
         ptr = i->evaluate_uniform(ptr);
 }
 
+void InputArray::prepare_uniforms()
+{
+    impl->release_uniforms();
+
+    const size_t size = compute_data_size();
+    if (size == 0)
+        return;
+
+    // Evaluate all uniform inputs; varying inputs are set to zero.
+    uint8* values = static_cast<uint8*>(aligned_malloc(size, 16));
+    memset(values, 0, size);
+
+    uint8* ptr = values;
+    const size_t input_count = impl->m_inputs.size();
+
+    for (size_t i = 0; i < input_count; ++i)
+    {
+        const Input& input = impl->m_inputs[i];
+
+        if (input.m_source && !input.m_source->is_uniform())
+        {
+            // Record the unaligned offset: Input::evaluate() applies the same
+            // alignment since both blocks of values are 16-byte aligned.
+            impl->m_varying_inputs.push_back(i);
+            impl->m_varying_input_offsets.push_back(ptr - values);
+        }
+        else if (input.m_format != InputFormatFloat && input.m_format != InputFormatEntity)
+            impl->m_uniform_spectra_offsets.push_back(align_to<Spectrum>(ptr) - values);
+
+        ptr = input.evaluate_uniform(ptr);
+    }
+
+    impl->m_uniform_values = values;
+    impl->m_uniform_values_size = size;
+}
+
+void InputArray::release_uniforms()
+{
+    impl->release_uniforms();
+}
+
+bool InputArray::has_prepared_uniforms() const
+{
+    return impl->m_uniform_values != 0;
+}
+
 
 //
 // InputArray::const_iterator class implementation.
@@ -621,6 +728,9 @@ void InputArray::iterator::bind(Source* source)
     Input& input = m_input_array->impl->m_inputs[m_input_index];
     delete input.m_source;
     input.m_source = source;
+
+    // The prepared uniform values may no longer match the bound sources.
+    m_input_array->impl->release_uniforms();
 }
 
 void InputArray::iterator::bind(Entity* entity)
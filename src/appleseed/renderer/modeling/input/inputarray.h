@@ -226,6 +226,15 @@ class APPLESEED_DLLSYMBOL InputArray
     void evaluate_uniforms(
         void*                       values) const;
 
+    // Evaluate all uniform inputs once and keep the result. Until the next call to
+    // release_uniforms() or the next binding change, evaluate() copies the cached
+    // uniform values and only evaluates the varying inputs.
+    void prepare_uniforms();
+    void release_uniforms();
+
+    // Return true if uniform input values have been prepared.
+    bool has_prepared_uniforms() const;
+
   private:
     struct Impl;
     Impl* impl;
@@ -135,6 +135,7 @@ namespace
             outgoing = -normalize(light_transform.get_parent_z());
             position = target_point - m_safe_scene_diameter * outgoing;
             value = m_values.m_irradiance;
+            value.gather_hero_wavelengths();
             probability = 1.0f;
         }
 
@@ -244,6 +245,7 @@ namespace
                 + disk_radius * p[1] * basis.get_tangent_v();
 
             value = m_values.m_irradiance;
+            value.gather_hero_wavelengths();
 
             probability = 1.0f / (Pi<float>() * square(static_cast<float>(disk_radius)));
         }
@@ -125,6 +125,7 @@ namespace
             position = light_transform.get_parent_origin();
             outgoing = normalize(target_point - position);
             value = m_values.m_intensity;
+            value.gather_hero_wavelengths();
             probability = 1.0f;
         }
 
@@ -140,6 +141,7 @@ namespace
             position = light_transform.get_parent_origin();
             outgoing = sample_sphere_uniform(s);
             value = m_values.m_intensity;
+            value.gather_hero_wavelengths();
 
             // todo: only correct if m_decay_exponent == 2.
             probability = RcpFourPi<float>();
@@ -130,6 +130,7 @@ namespace
             position = light_transform.get_parent_origin();
             outgoing = normalize(target_point - position);
             value = m_values.m_intensity;
+            value.gather_hero_wavelengths();
             probability = 1.0f;
         }
 
@@ -145,6 +146,7 @@ namespace
             position = light_transform.get_parent_origin();
             outgoing = sample_sphere_uniform(s);
             value = m_values.m_intensity;
+            value.gather_hero_wavelengths();
             probability = RcpFourPi<float>();
         }
 
@@ -176,26 +176,46 @@ namespace
 
         virtual size_t push_vertex_normal(const Vector3d& v) override
         {
-            GVector3 n(v);
+            return insert_vertex_normal(GVector3(v));
+        }
 
-            const GScalar norm_n = norm(n);
+        virtual size_t push_tex_coords(const Vector2d& v) override
+        {
+            return m_objects.back()->push_tex_coords(GVector2(v));
+        }
 
-            if (norm_n > GScalar(0.0))
-                n /= norm_n;
-            else
-            {
-                ++m_null_normal_vector_count;
-                n = GVector3(GScalar(1.0), GScalar(0.0), GScalar(0.0));
-            }
+        virtual void push_vertex_array(const Vector3f vertices[], const size_t count) override
+        {
+            MeshObject* object = m_objects.back();
+            object->reserve_vertices(object->get_vertex_count() + count);
 
-            ++m_normal_count;
+            for (size_t i = 0; i < count; ++i)
+                object->push_vertex(GVector3(vertices[i]));
+        }
 
-            return m_objects.back()->push_vertex_normal(n);
+        virtual void push_vertex_normal_array(const Vector3f vertex_normals[], const size_t count) override
+        {
+            MeshObject* object = m_objects.back();
+            object->reserve_vertex_normals(object->get_vertex_normal_count() + count);
+
+            for (size_t i = 0; i < count; ++i)
+                insert_vertex_normal(GVector3(vertex_normals[i]));
         }
 
-        virtual size_t push_tex_coords(const Vector2d& v) override
+        virtual void push_tex_coords_array(const Vector2f tex_coords[], const size_t count) override
         {
-            return m_objects.back()->push_tex_coords(GVector2(v));
+            MeshObject* object = m_objects.back();
+            object->reserve_tex_coords(object->get_tex_coords_count() + count);
+
+            for (size_t i = 0; i < count; ++i)
+                object->push_tex_coords(GVector2(tex_coords[i]));
+        }
+
+        virtual void reserve_faces(const size_t count) override
+        {
+            // Faces with more than three vertices will cause additional reallocations.
+            MeshObject* object = m_objects.back();
+            object->reserve_triangles(object->get_triangle_count() + count);
         }
 
         virtual size_t push_material_slot(const char* name) override
@@ -329,6 +349,23 @@ namespace
         size_t                  m_total_vertex_count;
         size_t                  m_total_triangle_count;
 
+        size_t insert_vertex_normal(GVector3 n)
+        {
+            const GScalar norm_n = norm(n);
+
+            if (norm_n > GScalar(0.0))
+                n /= norm_n;
+            else
+            {
+                ++m_null_normal_vector_count;
+                n = GVector3(GScalar(1.0), GScalar(0.0), GScalar(0.0));
+            }
+
+            ++m_normal_count;
+
+            return m_objects.back()->push_vertex_normal(n);
+        }
+
         void reset_mesh_stats()
         {
             m_normal_count = 0;
@@ -403,10 +440,17 @@ namespace
         const char*             filename,
         const char*             base_object_name,
         const ParamArray&       params,
-        MeshObjectArray&        objects)
+        MeshObjectArray&        objects,
+        const int               options)
     {
         GenericMeshFileReader reader(filename);
 
+        if (options & MeshObjectReader::SingleThreaded)
+        {
+            reader.set_obj_options(
+                reader.get_obj_options() | OBJMeshFileReader::SingleThreaded);
+        }
+
         const string obj_parsing_mode = params.get_optional<string>("obj_parsing_mode", "fast");
 
         if (obj_parsing_mode == "fast")
@@ -714,7 +758,8 @@ namespace
         const StringDictionary& filenames,
         const char*             base_object_name,
         const ParamArray&       params,
-        MeshObjectArray&        objects)
+        MeshObjectArray&        objects,
+        const int               options)
     {
         assert(filenames.size() >= 2);
 
@@ -734,7 +779,8 @@ namespace
                 search_paths.qualify(key_frames[0].m_filename).c_str(),
                 base_object_name,
                 params,
-                objects))
+                objects,
+                options))
             return false;
 
         for (size_t i = 0; i < objects.size(); ++i)
@@ -756,7 +802,8 @@ namespace
                     search_paths.qualify(filename).c_str(),
                     base_object_name,
                     params,
-                    poses))
+                    poses,
+                    options))
                 return false;
 
             for (size_t j = 0; j < poses.size(); ++j)
@@ -823,7 +870,8 @@ bool MeshObjectReader::read(
     const SearchPaths&  search_paths,
     const char*         base_object_name,
     const ParamArray&   params,
-    MeshObjectArray&    objects)
+    MeshObjectArray&    objects,
+    const int           options)
 {
     assert(base_object_name);
 
@@ -859,7 +907,8 @@ bool MeshObjectReader::read(
                 search_paths.qualify(params.strings().get<string>("filename")).c_str(),
                 base_object_name,
                 completed_params,
-                objects))
+                objects,
+                options))
             return false;
     }
     else if (params.dictionaries().exist("filename"))
@@ -884,7 +933,8 @@ bool MeshObjectReader::read(
                         search_paths.qualify(filenames.begin().value()).c_str(),
                         base_object_name,
                         completed_params,
-                        objects))
+                        objects,
+                        options))
                     return false;
             }
             break;
@@ -907,7 +957,8 @@ bool MeshObjectReader::read(
                         filenames,
                         base_object_name,
                         completed_params,
-                        objects))
+                        objects,
+                        options))
                     return false;
             }
             break;
@@ -58,6 +58,12 @@ APPLESEED_DECLARE_APIARRAY(MeshObjectArray, MeshObject*);
 class APPLESEED_DLLSYMBOL MeshObjectReader
 {
   public:
+    enum Options
+    {
+        Defaults                = 0,        // none of the flags below
+        SingleThreaded          = 1 << 0    // read mesh files on the calling thread only
+    };
+
     // Read mesh objects from disk. The filenames are defined in params.
     // Returns true on success, false otherwise. When false is returned,
     // nothing should be assumed on the state of the objects parameter.
@@ -65,7 +71,8 @@ class APPLESEED_DLLSYMBOL MeshObjectReader
         const foundation::SearchPaths&  search_paths,
         const char*                     base_object_name,
         const ParamArray&               params,
-        MeshObjectArray&                objects);
+        MeshObjectArray&                objects,
+        const int                       options = Defaults);
 };
 
 }       // namespace renderer
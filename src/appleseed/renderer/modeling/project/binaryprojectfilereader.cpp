@@ -0,0 +1,1067 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "binaryprojectfilereader.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/global/globaltypes.h"
+#include "renderer/modeling/aov/aov.h"
+#include "renderer/modeling/aov/aovfactoryregistrar.h"
+#include "renderer/modeling/aov/iaovfactory.h"
+#include "renderer/modeling/bsdf/bsdf.h"
+#include "renderer/modeling/bsdf/bsdffactoryregistrar.h"
+#include "renderer/modeling/bsdf/ibsdffactory.h"
+#include "renderer/modeling/bssrdf/bssrdf.h"
+#include "renderer/modeling/bssrdf/bssrdffactoryregistrar.h"
+#include "renderer/modeling/bssrdf/ibssrdffactory.h"
+#include "renderer/modeling/camera/camera.h"
+#include "renderer/modeling/camera/camerafactoryregistrar.h"
+#include "renderer/modeling/camera/icamerafactory.h"
+#include "renderer/modeling/color/colorentity.h"
+#include "renderer/modeling/display/display.h"
+#include "renderer/modeling/edf/edf.h"
+#include "renderer/modeling/edf/edffactoryregistrar.h"
+#include "renderer/modeling/edf/iedffactory.h"
+#include "renderer/modeling/environment/environment.h"
+#include "renderer/modeling/environmentedf/environmentedf.h"
+#include "renderer/modeling/environmentedf/environmentedffactoryregistrar.h"
+#include "renderer/modeling/environmentedf/ienvironmentedffactory.h"
+#include "renderer/modeling/environmentshader/environmentshader.h"
+#include "renderer/modeling/environmentshader/environmentshaderfactoryregistrar.h"
+#include "renderer/modeling/environmentshader/ienvironmentshaderfactory.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/modeling/light/ilightfactory.h"
+#include "renderer/modeling/light/light.h"
+#include "renderer/modeling/light/lightfactoryregistrar.h"
+#include "renderer/modeling/material/imaterialfactory.h"
+#include "renderer/modeling/material/material.h"
+#include "renderer/modeling/material/materialfactoryregistrar.h"
+#include "renderer/modeling/object/curveobject.h"
+#include "renderer/modeling/object/curveobjectreader.h"
+#include "renderer/modeling/object/meshobject.h"
+#include "renderer/modeling/object/meshobjectreader.h"
+#include "renderer/modeling/object/object.h"
+#include "renderer/modeling/object/triangle.h"
+#include "renderer/modeling/project/binaryprojectformat.h"
+#include "renderer/modeling/project/configuration.h"
+#include "renderer/modeling/project/configurationcontainer.h"
+#include "renderer/modeling/project/eventcounters.h"
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/project/projectfilereader.h"
+#include "renderer/modeling/project/projectformatrevision.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyfactoryregistrar.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/iassemblyfactory.h"
+#include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/scene/textureinstance.h"
+#include "renderer/modeling/shadergroup/shadergroup.h"
+#include "renderer/modeling/surfaceshader/isurfaceshaderfactory.h"
+#include "renderer/modeling/surfaceshader/surfaceshader.h"
+#include "renderer/modeling/surfaceshader/surfaceshaderfactoryregistrar.h"
+#include "renderer/modeling/texture/itexturefactory.h"
+#include "renderer/modeling/texture/texture.h"
+#include "renderer/modeling/texture/texturefactoryregistrar.h"
+#include "renderer/modeling/volume/ivolumefactory.h"
+#include "renderer/modeling/volume/volume.h"
+#include "renderer/modeling/volume/volumefactoryregistrar.h"
+#include "renderer/utility/paramarray.h"
+#include "renderer/utility/transformsequence.h"
+
+// appleseed.foundation headers.
+#include "foundation/core/exceptions/exceptionioerror.h"
+#include "foundation/math/matrix.h"
+#include "foundation/math/transform.h"
+#include "foundation/math/vector.h"
+#include "foundation/platform/memorymappedfile.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/autoreleaseptr.h"
+#include "foundation/utility/containers/dictionary.h"
+#include "foundation/utility/searchpaths.h"
+
+// Standard headers.
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <string>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+//
+// BinaryProjectFileReader class implementation.
+//
+
+namespace
+{
+    class Reader
+    {
+      public:
+        Reader(
+            Project&            project,
+            const uint8*        data,
+            const size_t        size,
+            const int           options,
+            EventCounters&      event_counters)
+          : m_project(project)
+          , m_ptr(data)
+          , m_end(data + size)
+          , m_options(options)
+          , m_event_counters(event_counters)
+        {
+        }
+
+        // Read the whole project. Throws a foundation::ExceptionIOError if the data is malformed.
+        void read_project()
+        {
+            char signature[sizeof(BinaryProjectSignature)];
+            read_bytes(signature, sizeof(signature));
+            if (memcmp(signature, BinaryProjectSignature, sizeof(signature)) != 0)
+                throw ExceptionIOError("invalid signature");
+
+            const uint16 version = read_value<uint16>();
+            if (version != BinaryProjectFormatVersion)
+                throw ExceptionIOError("unsupported format version");
+
+            const size_t format_revision = read_value<uint32>();
+            if (format_revision > ProjectFormatRevision)
+            {
+                RENDERER_LOG_WARNING(
+                    "this project was created with a newer version of appleseed; it may fail to load with this version.");
+                m_event_counters.signal_warning();
+            }
+            m_project.set_format_revision(format_revision);
+
+            read_search_paths();
+
+            if (read_presence())
+            {
+                const string name = read_string();
+                ParamArray params;
+                read_dictionary(params);
+                m_project.set_display(DisplayFactory::create(name.c_str(), params));
+            }
+
+            if (read_presence())
+                read_scene();
+
+            if (read_presence())
+                read_frame();
+
+            read_configurations();
+        }
+
+      private:
+        Project&                                m_project;
+        const uint8*                            m_ptr;
+        const uint8*                            m_end;
+        const int                               m_options;
+        EventCounters&                          m_event_counters;
+        deque<string>                           m_strings;      // references remain valid as strings are added
+
+        const AOVFactoryRegistrar               m_aov_factories;
+        const AssemblyFactoryRegistrar          m_assembly_factories;
+        const BSDFFactoryRegistrar              m_bsdf_factories;
+        const BSSRDFFactoryRegistrar            m_bssrdf_factories;
+        const CameraFactoryRegistrar            m_camera_factories;
+        const EDFFactoryRegistrar               m_edf_factories;
+        const EnvironmentEDFFactoryRegistrar    m_env_edf_factories;
+        const EnvironmentShaderFactoryRegistrar m_env_shader_factories;
+        const LightFactoryRegistrar             m_light_factories;
+        const MaterialFactoryRegistrar          m_material_factories;
+        const SurfaceShaderFactoryRegistrar     m_surface_shader_factories;
+        const TextureFactoryRegistrar           m_texture_factories;
+        const VolumeFactoryRegistrar            m_volume_factories;
+
+        //
+        // Primitive values.
+        //
+
+        void read_bytes(void* data, const size_t size)
+        {
+            if (static_cast<size_t>(m_end - m_ptr) < size)
+                throw ExceptionIOError("unexpected end of file");
+
+            memcpy(data, m_ptr, size);
+            m_ptr += size;
+        }
+
+        template <typename T>
+        T read_value()
+        {
+            T value;
+            read_bytes(&value, sizeof(T));
+            return value;
+        }
+
+        size_t read_count()
+        {
+            return read_value<uint32>();
+        }
+
+        // Make sure the remaining data can hold a given number of elements, before
+        // memory gets allocated for them based on a count read from the file.
+        void check_remaining(const size_t count, const size_t element_size)
+        {
+            if (count > static_cast<size_t>(m_end - m_ptr) / element_size)
+                throw ExceptionIOError("unexpected end of file");
+        }
+
+        bool read_presence()
+        {
+            return read_value<uint8>() != 0;
+        }
+
+        const string& read_string()
+        {
+            const uint32 index = read_value<uint32>();
+
+            if (index == BinaryProjectNewString)
+            {
+                const size_t length = read_count();
+                if (static_cast<size_t>(m_end - m_ptr) < length)
+                    throw ExceptionIOError("unexpected end of file");
+
+                m_strings.push_back(string(reinterpret_cast<const char*>(m_ptr), length));
+                m_ptr += length;
+
+                return m_strings.back();
+            }
+
+            if (index >= m_strings.size())
+                throw ExceptionIOError("invalid string index");
+
+            return m_strings[index];
+        }
+
+        void read_dictionary(Dictionary& dictionary)
+        {
+            read_dictionary_strings(dictionary.strings());
+
+            const size_t dictionary_count = read_count();
+
+            for (size_t i = 0; i < dictionary_count; ++i)
+            {
+                const string& key = read_string();
+                Dictionary child;
+                read_dictionary(child);
+                dictionary.dictionaries().insert(key, child);
+            }
+        }
+
+        void read_dictionary_strings(StringDictionary& strings)
+        {
+            const size_t string_count = read_count();
+
+            for (size_t i = 0; i < string_count; ++i)
+            {
+                const string& key = read_string();
+                const string& value = read_string();
+                strings.insert(key, value);
+            }
+        }
+
+        Transformd read_transform()
+        {
+            Matrix4d m;
+            read_bytes(&m[0], 16 * sizeof(double));
+
+            try
+            {
+                return Transformd::from_local_to_parent(m);
+            }
+            catch (const ExceptionSingularMatrix&)
+            {
+                RENDERER_LOG_ERROR("while defining transform: the transformation matrix is singular.");
+                m_event_counters.signal_error();
+                return Transformd::identity();
+            }
+        }
+
+        void read_transform_sequence(TransformSequence& transform_sequence)
+        {
+            transform_sequence.clear();
+
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float time = read_value<float>();
+                transform_sequence.set_transform(time, read_transform());
+            }
+        }
+
+        //
+        // Entities.
+        //
+
+        template <typename Container, typename EntityType>
+        void insert(Container& container, auto_release_ptr<EntityType> entity)
+        {
+            if (entity.get() == 0)
+                return;
+
+            if (container.get_by_name(entity->get_name()) != 0)
+            {
+                RENDERER_LOG_ERROR(
+                    "an entity with the path \"%s\" already exists.",
+                    entity->get_path().c_str());
+                m_event_counters.signal_error();
+                return;
+            }
+
+            container.insert(entity);
+        }
+
+        void report_missing_parameter(
+            const char*         type,
+            const string&       name,
+            const ExceptionDictionaryKeyNotFound& e)
+        {
+            RENDERER_LOG_ERROR(
+                "while defining %s \"%s\": required parameter \"%s\" missing.",
+                type,
+                name.c_str(),
+                e.string());
+            m_event_counters.signal_error();
+        }
+
+        // Read the name, the model and the parameters of an entity and create it.
+        template <typename EntityType, typename EntityFactoryRegistrar>
+        auto_release_ptr<EntityType> read_entity(
+            const EntityFactoryRegistrar&   registrar,
+            const char*                     type)
+        {
+            const string name = read_string();
+            const string model = read_string();
+            ParamArray params;
+            read_dictionary(params);
+
+            try
+            {
+                const typename EntityFactoryRegistrar::FactoryType* factory =
+                    registrar.lookup(model.c_str());
+
+                if (factory)
+                    return factory->create(name.c_str(), params);
+
+                RENDERER_LOG_ERROR(
+                    "while defining %s \"%s\": invalid model \"%s\".",
+                    type,
+                    name.c_str(),
+                    model.c_str());
+                m_event_counters.signal_error();
+            }
+            catch (const ExceptionDictionaryKeyNotFound& e)
+            {
+                report_missing_parameter(type, name, e);
+            }
+            catch (const ExceptionUnknownEntity& e)
+            {
+                RENDERER_LOG_ERROR(
+                    "while defining %s \"%s\": unknown entity \"%s\".",
+                    type,
+                    name.c_str(),
+                    e.string());
+                m_event_counters.signal_error();
+            }
+
+            return auto_release_ptr<EntityType>(0);
+        }
+
+        template <typename EntityType, typename EntityFactoryRegistrar, typename Container>
+        void read_entities(
+            const EntityFactoryRegistrar&   registrar,
+            const char*                     type,
+            Container&                      container)
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+                insert(container, read_entity<EntityType>(registrar, type));
+        }
+
+        void read_search_paths()
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const string& path = read_string();
+
+                // Skip search paths if asked to do so.
+                if (!(m_options & ProjectFileReader::OmitSearchPaths) && !path.empty())
+                    m_project.search_paths().push_back(path);
+            }
+        }
+
+        void read_cameras(CameraContainer& cameras)
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto_release_ptr<Camera> camera = read_entity<Camera>(m_camera_factories, "camera");
+
+                TransformSequence transform_sequence;
+                read_transform_sequence(transform_sequence);
+
+                if (camera.get())
+                    camera->transform_sequence() = transform_sequence;
+
+                insert(cameras, camera);
+            }
+        }
+
+        void read_colors(ColorContainer& colors)
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const string name = read_string();
+                ParamArray params;
+                read_dictionary(params);
+
+                ColorValueArray values, alpha;
+                read_value_array(values);
+                read_value_array(alpha);
+
+                try
+                {
+                    insert(
+                        colors,
+                        alpha.empty()
+                            ? ColorEntityFactory::create(name.c_str(), params, values)
+                            : ColorEntityFactory::create(name.c_str(), params, values, alpha));
+                }
+                catch (const ExceptionDictionaryKeyNotFound& e)
+                {
+                    report_missing_parameter("color", name, e);
+                }
+            }
+        }
+
+        void read_value_array(ColorValueArray& values)
+        {
+            const size_t count = read_count();
+            values.reserve(count);
+
+            for (size_t i = 0; i < count; ++i)
+                values.push_back(read_value<float>());
+        }
+
+        void read_textures(TextureContainer& textures)
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const string name = read_string();
+                const string model = read_string();
+                ParamArray params;
+                read_dictionary(params);
+
+                try
+                {
+                    const TextureFactoryRegistrar::FactoryType* factory =
+                        m_texture_factories.lookup(model.c_str());
+
+                    if (factory)
+                    {
+                        insert(
+                            textures,
+                            factory->create(
+                                name.c_str(),
+                                params,
+                                m_project.search_paths()));
+                    }
+                    else
+                    {
+                        RENDERER_LOG_ERROR(
+                            "while defining texture \"%s\": invalid model \"%s\".",
+                            name.c_str(),
+                            model.c_str());
+                        m_event_counters.signal_error();
+                    }
+                }
+                catch (const ExceptionDictionaryKeyNotFound& e)
+                {
+                    report_missing_parameter("texture", name, e);
+                }
+            }
+        }
+
+        void read_texture_instances(TextureInstanceContainer& texture_instances)
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const string name = read_string();
+                ParamArray params;
+                read_dictionary(params);
+                const string texture = read_string();
+                const Transformd transform = read_transform();
+
+                try
+                {
+                    insert(
+                        texture_instances,
+                        TextureInstanceFactory::create(
+                            name.c_str(),
+                            params,
+                            texture.c_str(),
+                            Transformf(
+                                transform.get_local_to_parent(),
+                                transform.get_parent_to_local())));
+                }
+                catch (const ExceptionDictionaryKeyNotFound& e)
+                {
+                    report_missing_parameter("texture instance", name, e);
+                }
+            }
+        }
+
+        void read_environment_edfs(EnvironmentEDFContainer& env_edfs)
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto_release_ptr<EnvironmentEDF> env_edf =
+                    read_entity<EnvironmentEDF>(m_env_edf_factories, "environment edf");
+
+                TransformSequence transform_sequence;
+                read_transform_sequence(transform_sequence);
+
+                if (env_edf.get())
+                    env_edf->transform_sequence() = transform_sequence;
+
+                insert(env_edfs, env_edf);
+            }
+        }
+
+        void read_shader_groups(ShaderGroupContainer& shader_groups)
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto_release_ptr<ShaderGroup> shader_group =
+                    ShaderGroupFactory::create(read_string().c_str());
+
+                const size_t shader_count = read_count();
+
+                for (size_t j = 0; j < shader_count; ++j)
+                {
+                    const string type = read_string();
+                    const string shader = read_string();
+                    const string layer = read_string();
+
+                    ParamArray params;
+                    read_dictionary_strings(params.strings());
+
+                    shader_group->add_shader(type.c_str(), shader.c_str(), layer.c_str(), params);
+                }
+
+                const size_t connection_count = read_count();
+
+                for (size_t j = 0; j < connection_count; ++j)
+                {
+                    const string src_layer = read_string();
+                    const string src_param = read_string();
+                    const string dst_layer = read_string();
+                    const string dst_param = read_string();
+
+                    shader_group->add_connection(
+                        src_layer.c_str(),
+                        src_param.c_str(),
+                        dst_layer.c_str(),
+                        dst_param.c_str());
+                }
+
+                insert(shader_groups, shader_group);
+            }
+        }
+
+        void read_lights(LightContainer& lights)
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto_release_ptr<Light> light = read_entity<Light>(m_light_factories, "light");
+                const Transformd transform = read_transform();
+
+                if (light.get())
+                    light->set_transform(transform);
+
+                insert(lights, light);
+            }
+        }
+
+        void read_objects(ObjectContainer& objects)
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const uint8 kind = read_value<uint8>();
+
+                if (kind == BinaryProjectInlineMeshObject)
+                    insert(objects, read_inline_mesh_object());
+                else if (kind == BinaryProjectObjectEntity)
+                    read_object_entity(objects);
+                else throw ExceptionIOError("invalid object record");
+            }
+        }
+
+        void read_object_entity(ObjectContainer& objects)
+        {
+            const string name = read_string();
+            const string model = read_string();
+            ParamArray params;
+            read_dictionary(params);
+
+            try
+            {
+                if (model == MeshObjectFactory::get_model())
+                {
+                    if (m_options & ProjectFileReader::OmitReadingMeshFiles)
+                    {
+                        insert(
+                            objects,
+                            auto_release_ptr<Object>(
+                                MeshObjectFactory::create(name.c_str(), params).release()));
+                    }
+                    else
+                    {
+                        MeshObjectArray object_array;
+                        if (MeshObjectReader::read(
+                                m_project.search_paths(),
+                                name.c_str(),
+                                params,
+                                object_array))
+                        {
+                            for (size_t j = 0; j < object_array.size(); ++j)
+                                insert(objects, auto_release_ptr<Object>(object_array[j]));
+                        }
+                        else m_event_counters.signal_error();
+                    }
+                }
+                else if (model == CurveObjectFactory::get_model())
+                {
+                    insert(
+                        objects,
+                        auto_release_ptr<Object>(
+                            CurveObjectReader::read(
+                                m_project.search_paths(),
+                                name.c_str(),
+                                params).release()));
+                }
+                else
+                {
+                    RENDERER_LOG_ERROR(
+                        "while defining object \"%s\": invalid model \"%s\".",
+                        name.c_str(),
+                        model.c_str());
+                    m_event_counters.signal_error();
+                }
+            }
+            catch (const ExceptionDictionaryKeyNotFound& e)
+            {
+                report_missing_parameter("object", name, e);
+            }
+        }
+
+        GVector2 read_vector2()
+        {
+            GVector2 v;
+            read_bytes(&v[0], 2 * sizeof(GScalar));
+            return v;
+        }
+
+        GVector3 read_vector3()
+        {
+            GVector3 v;
+            read_bytes(&v[0], 3 * sizeof(GScalar));
+            return v;
+        }
+
+        // Return true if an index read from a triangle is either unset or lower than a given count.
+        static bool is_valid_optional_index(const uint32 index, const size_t count)
+        {
+            return index == Triangle::None || index < count;
+        }
+
+        auto_release_ptr<Object> read_inline_mesh_object()
+        {
+            const string name = read_string();
+            ParamArray params;
+            read_dictionary(params);
+
+            const size_t vertex_count = read_count();
+            const size_t normal_count = read_count();
+            const size_t tangent_count = read_count();
+            const size_t tex_coords_count = read_count();
+            const size_t triangle_count = read_count();
+            const size_t motion_segment_count = read_count();
+            const size_t material_slot_count = read_count();
+
+            auto_release_ptr<MeshObject> object = MeshObjectFactory::create(name.c_str(), params);
+
+            check_remaining(vertex_count, 3 * sizeof(GScalar));
+            object->reserve_vertices(vertex_count);
+            for (size_t i = 0; i < vertex_count; ++i)
+                object->push_vertex(read_vector3());
+
+            check_remaining(normal_count, 3 * sizeof(GScalar));
+            object->reserve_vertex_normals(normal_count);
+            for (size_t i = 0; i < normal_count; ++i)
+                object->push_vertex_normal(read_vector3());
+
+            check_remaining(tangent_count, 3 * sizeof(GScalar));
+            object->reserve_vertex_tangents(tangent_count);
+            for (size_t i = 0; i < tangent_count; ++i)
+                object->push_vertex_tangent(read_vector3());
+
+            check_remaining(tex_coords_count, 2 * sizeof(GScalar));
+            object->reserve_tex_coords(tex_coords_count);
+            for (size_t i = 0; i < tex_coords_count; ++i)
+                object->push_tex_coords(read_vector2());
+
+            check_remaining(triangle_count, 10 * sizeof(uint32));
+            object->reserve_triangles(triangle_count);
+            for (size_t i = 0; i < triangle_count; ++i)
+            {
+                Triangle triangle;
+                triangle.m_v0 = read_value<uint32>();
+                triangle.m_v1 = read_value<uint32>();
+                triangle.m_v2 = read_value<uint32>();
+                triangle.m_n0 = read_value<uint32>();
+                triangle.m_n1 = read_value<uint32>();
+                triangle.m_n2 = read_value<uint32>();
+                triangle.m_a0 = read_value<uint32>();
+                triangle.m_a1 = read_value<uint32>();
+                triangle.m_a2 = read_value<uint32>();
+                triangle.m_pa = read_value<uint32>();
+
+                if (triangle.m_v0 >= vertex_count ||
+                    triangle.m_v1 >= vertex_count ||
+                    triangle.m_v2 >= vertex_count)
+                    throw ExceptionIOError("invalid vertex index");
+
+                if (!is_valid_optional_index(triangle.m_n0, normal_count) ||
+                    !is_valid_optional_index(triangle.m_n1, normal_count) ||
+                    !is_valid_optional_index(triangle.m_n2, normal_count))
+                    throw ExceptionIOError("invalid vertex normal index");
+
+                if (!is_valid_optional_index(triangle.m_a0, tex_coords_count) ||
+                    !is_valid_optional_index(triangle.m_a1, tex_coords_count) ||
+                    !is_valid_optional_index(triangle.m_a2, tex_coords_count))
+                    throw ExceptionIOError("invalid texture coordinates index");
+
+                // Meshes without material slots may still reference the first slot.
+                if (!is_valid_optional_index(triangle.m_pa, max<size_t>(material_slot_count, 1)))
+                    throw ExceptionIOError("invalid material slot index");
+
+                object->push_triangle(triangle);
+            }
+
+            if (motion_segment_count > 0)
+            {
+                const size_t pose_count = vertex_count + normal_count + tangent_count;
+
+                if (pose_count > 0)
+                    check_remaining(motion_segment_count, pose_count * 3 * sizeof(GScalar));
+
+                object->set_motion_segment_count(motion_segment_count);
+
+                for (size_t i = 0; i < vertex_count; ++i)
+                {
+                    for (size_t j = 0; j < motion_segment_count; ++j)
+                        object->set_vertex_pose(i, j, read_vector3());
+                }
+
+                for (size_t i = 0; i < normal_count; ++i)
+                {
+                    for (size_t j = 0; j < motion_segment_count; ++j)
+                        object->set_vertex_normal_pose(i, j, read_vector3());
+                }
+
+                for (size_t i = 0; i < tangent_count; ++i)
+                {
+                    for (size_t j = 0; j < motion_segment_count; ++j)
+                        object->set_vertex_tangent_pose(i, j, read_vector3());
+                }
+            }
+
+            check_remaining(material_slot_count, sizeof(uint32));
+            object->reserve_material_slots(material_slot_count);
+            for (size_t i = 0; i < material_slot_count; ++i)
+                object->push_material_slot(read_string().c_str());
+
+            return auto_release_ptr<Object>(object.release());
+        }
+
+        void read_object_instances(ObjectInstanceContainer& object_instances)
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const string name = read_string();
+                ParamArray params;
+                read_dictionary(params);
+                const string object = read_string();
+                const Transformd transform = read_transform();
+
+                StringDictionary front_material_mappings, back_material_mappings;
+                read_dictionary_strings(front_material_mappings);
+                read_dictionary_strings(back_material_mappings);
+
+                insert(
+                    object_instances,
+                    ObjectInstanceFactory::create(
+                        name.c_str(),
+                        params,
+                        object.c_str(),
+                        transform,
+                        front_material_mappings,
+                        back_material_mappings));
+            }
+        }
+
+        void read_assembly_instances(AssemblyInstanceContainer& assembly_instances)
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const string name = read_string();
+                ParamArray params;
+                read_dictionary(params);
+                const string assembly = read_string();
+
+                auto_release_ptr<AssemblyInstance> assembly_instance =
+                    AssemblyInstanceFactory::create(
+                        name.c_str(),
+                        params,
+                        assembly.c_str());
+
+                read_transform_sequence(assembly_instance->transform_sequence());
+
+                insert(assembly_instances, assembly_instance);
+            }
+        }
+
+        void read_assemblies(AssemblyContainer& assemblies)
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto_release_ptr<Assembly> assembly =
+                    read_entity<Assembly>(m_assembly_factories, "assembly");
+
+                const bool procedural = read_presence();
+
+                if (assembly.get())
+                {
+                    if (!procedural)
+                        read_assembly_contents(assembly.ref());
+
+                    insert(assemblies, assembly);
+                }
+                else if (!procedural)
+                {
+                    // Read the contents of the invalid assembly anyway, then drop them.
+                    auto_release_ptr<Assembly> discarded = AssemblyFactory().create("", ParamArray());
+                    read_assembly_contents(discarded.ref());
+                }
+            }
+        }
+
+        void read_assembly_contents(Assembly& assembly)
+        {
+            read_colors(assembly.colors());
+            read_textures(assembly.textures());
+            read_texture_instances(assembly.texture_instances());
+            read_entities<BSDF>(m_bsdf_factories, "bsdf", assembly.bsdfs());
+            read_entities<BSSRDF>(m_bssrdf_factories, "bssrdf", assembly.bssrdfs());
+            read_entities<EDF>(m_edf_factories, "edf", assembly.edfs());
+            read_shader_groups(assembly.shader_groups());
+            read_entities<SurfaceShader>(m_surface_shader_factories, "surface shader", assembly.surface_shaders());
+            read_entities<Material>(m_material_factories, "material", assembly.materials());
+            read_lights(assembly.lights());
+            read_objects(assembly.objects());
+            read_object_instances(assembly.object_instances());
+            read_entities<Volume>(m_volume_factories, "volume", assembly.volumes());
+            read_assemblies(assembly.assemblies());
+            read_assembly_instances(assembly.assembly_instances());
+        }
+
+        void read_scene()
+        {
+            auto_release_ptr<Scene> scene = SceneFactory::create();
+
+            read_dictionary(scene->get_parameters());
+
+            read_cameras(scene->cameras());
+            read_colors(scene->colors());
+            read_textures(scene->textures());
+            read_texture_instances(scene->texture_instances());
+            read_environment_edfs(scene->environment_edfs());
+            read_entities<EnvironmentShader>(m_env_shader_factories, "environment shader", scene->environment_shaders());
+
+            if (read_presence())
+            {
+                const string name = read_string();
+                read_string();      // model
+                ParamArray params;
+                read_dictionary(params);
+                scene->set_environment(EnvironmentFactory::create(name.c_str(), params));
+            }
+
+            read_shader_groups(scene->shader_groups());
+            read_assemblies(scene->assemblies());
+            read_assembly_instances(scene->assembly_instances());
+
+            m_project.set_scene(scene);
+        }
+
+        void read_frame()
+        {
+            const string name = read_string();
+            ParamArray params;
+            read_dictionary(params);
+
+            AOVContainer aovs;
+            read_entities<AOV>(m_aov_factories, "aov", aovs);
+
+            auto_release_ptr<Frame> frame = FrameFactory::create(name.c_str(), params);
+            frame->transfer_aovs(aovs);
+
+            m_project.set_frame(frame);
+        }
+
+        void read_configurations()
+        {
+            const size_t count = read_count();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const string name = read_string();
+                ParamArray params;
+                read_dictionary(params);
+                const string base_name = read_string();
+
+                auto_release_ptr<Configuration> configuration =
+                    ConfigurationFactory::create(name.c_str(), params);
+
+                // Handle configuration inheritance.
+                if (!base_name.empty())
+                {
+                    const Configuration* base =
+                        m_project.configurations().get_by_name(base_name.c_str());
+
+                    if (base)
+                        configuration->set_base(base);
+                    else
+                    {
+                        RENDERER_LOG_ERROR(
+                            "while defining configuration \"%s\": the configuration \"%s\" does not exist.",
+                            configuration->get_path().c_str(),
+                            base_name.c_str());
+                        m_event_counters.signal_error();
+                    }
+                }
+
+                m_project.configurations().insert(configuration);
+            }
+        }
+    };
+}
+
+bool BinaryProjectFileReader::is_binary_project_file(const char* filepath)
+{
+    FILE* file = fopen(filepath, "rb");
+    if (file == 0)
+        return false;
+
+    char signature[sizeof(BinaryProjectSignature)];
+    const bool is_binary =
+        fread(signature, 1, sizeof(signature), file) == sizeof(signature) &&
+        memcmp(signature, BinaryProjectSignature, sizeof(signature)) == 0;
+
+    fclose(file);
+
+    return is_binary;
+}
+
+bool BinaryProjectFileReader::read(
+    Project&        project,
+    const char*     filepath,
+    const int       options,
+    EventCounters&  event_counters)
+{
+    try
+    {
+        const MemoryMappedFile file(filepath);
+
+        Reader reader(
+            project,
+            file.get_data(),
+            file.get_size(),
+            options,
+            event_counters);
+
+        reader.read_project();
+    }
+    catch (const ExceptionIOError& e)
+    {
+        RENDERER_LOG_ERROR("failed to load project file %s: %s.", filepath, e.what());
+        event_counters.signal_error();
+        return false;
+    }
+
+    return true;
+}
+
+}   // namespace renderer
@@ -0,0 +1,66 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_RENDERER_MODELING_PROJECT_BINARYPROJECTFILEREADER_H
+#define APPLESEED_RENDERER_MODELING_PROJECT_BINARYPROJECTFILEREADER_H
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Forward declarations.
+namespace renderer  { class EventCounters; }
+namespace renderer  { class Project; }
+
+namespace renderer
+{
+
+//
+// Binary project file reader.
+//
+
+class APPLESEED_DLLSYMBOL BinaryProjectFileReader
+{
+  public:
+    // Return true if a file starts with the signature of binary project files.
+    static bool is_binary_project_file(const char* filepath);
+
+    // Read a binary project file into an empty project.
+    // Options are those of renderer::ProjectFileReader.
+    // Errors in entity definitions are reported through the event counters.
+    // Returns false if the file could not be read at all.
+    static bool read(
+        Project&        project,
+        const char*     filepath,
+        const int       options,
+        EventCounters&  event_counters);
+};
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_MODELING_PROJECT_BINARYPROJECTFILEREADER_H
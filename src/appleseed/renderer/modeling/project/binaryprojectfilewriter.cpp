@@ -0,0 +1,659 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "binaryprojectfilewriter.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/modeling/aov/aov.h"
+#include "renderer/modeling/bsdf/bsdf.h"
+#include "renderer/modeling/bssrdf/bssrdf.h"
+#include "renderer/modeling/camera/camera.h"
+#include "renderer/modeling/color/colorentity.h"
+#include "renderer/modeling/display/display.h"
+#include "renderer/modeling/edf/edf.h"
+#include "renderer/modeling/environment/environment.h"
+#include "renderer/modeling/environmentedf/environmentedf.h"
+#include "renderer/modeling/environmentshader/environmentshader.h"
+#include "renderer/modeling/frame/frame.h"
+#include "renderer/modeling/light/light.h"
+#include "renderer/modeling/material/material.h"
+#include "renderer/modeling/object/curveobject.h"
+#include "renderer/modeling/object/curveobjectwriter.h"
+#include "renderer/modeling/object/meshobject.h"
+#include "renderer/modeling/object/object.h"
+#include "renderer/modeling/object/triangle.h"
+#include "renderer/modeling/project/binaryprojectformat.h"
+#include "renderer/modeling/project/configuration.h"
+#include "renderer/modeling/project/configurationcontainer.h"
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/project/projectfilewriter.h"
+#include "renderer/modeling/scene/assembly.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/objectinstance.h"
+#include "renderer/modeling/scene/proceduralassembly.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/modeling/scene/textureinstance.h"
+#include "renderer/modeling/shadergroup/shader.h"
+#include "renderer/modeling/shadergroup/shaderconnection.h"
+#include "renderer/modeling/shadergroup/shadergroup.h"
+#include "renderer/modeling/shadergroup/shaderparam.h"
+#include "renderer/modeling/surfaceshader/surfaceshader.h"
+#include "renderer/modeling/texture/texture.h"
+#include "renderer/modeling/volume/volume.h"
+#include "renderer/utility/paramarray.h"
+#include "renderer/utility/transformsequence.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/matrix.h"
+#include "foundation/math/transform.h"
+#include "foundation/math/vector.h"
+#include "foundation/platform/types.h"
+#include "foundation/utility/bufferedfile.h"
+#include "foundation/utility/containers/dictionary.h"
+#include "foundation/utility/foreach.h"
+#include "foundation/utility/searchpaths.h"
+
+// Boost headers.
+#include "boost/filesystem.hpp"
+
+// Standard headers.
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace foundation;
+using namespace std;
+namespace bf = boost::filesystem;
+
+namespace renderer
+{
+
+//
+// BinaryProjectFileWriter class implementation.
+//
+
+namespace
+{
+    class Writer
+    {
+      public:
+        Writer(
+            const char*         filepath,
+            const int           options)
+          : m_project_new_root_dir(bf::path(filepath).parent_path())
+          , m_options(options)
+          , m_failed(false)
+        {
+            m_file.open(filepath, BufferedFile::BinaryType, BufferedFile::WriteMode);
+        }
+
+        bool is_open() const
+        {
+            return m_file.is_open();
+        }
+
+        // Write the whole project. Return true on success.
+        bool write_project(const Project& project)
+        {
+            write_bytes(BinaryProjectSignature, sizeof(BinaryProjectSignature));
+            write_value(BinaryProjectFormatVersion);
+
+            write_value(static_cast<uint32>(project.get_format_revision()));
+
+            write_search_paths(project.search_paths());
+
+            write_presence(project.get_display());
+            if (project.get_display())
+                write_named_entity(*project.get_display());
+
+            write_presence(project.get_scene());
+            if (project.get_scene())
+                write_scene(*project.get_scene());
+
+            write_presence(project.get_frame());
+            if (project.get_frame())
+                write_frame(*project.get_frame());
+
+            write_configurations(project.configurations());
+
+            return m_file.close() && !m_failed;
+        }
+
+      private:
+        typedef map<string, uint32> StringIndexMap;
+
+        const bf::path          m_project_new_root_dir;
+        const int               m_options;
+        BufferedFile            m_file;
+        StringIndexMap          m_string_indices;
+        bool                    m_failed;
+
+        void write_bytes(const void* data, const size_t size)
+        {
+            if (m_file.write(data, size) != size)
+                m_failed = true;
+        }
+
+        template <typename T>
+        void write_value(const T& value)
+        {
+            write_bytes(&value, sizeof(T));
+        }
+
+        void write_count(const size_t count)
+        {
+            write_value(static_cast<uint32>(count));
+        }
+
+        template <typename T>
+        void write_presence(const T* entity)
+        {
+            write_value(static_cast<uint8>(entity != 0 ? 1 : 0));
+        }
+
+        void write_string(const string& s)
+        {
+            const StringIndexMap::const_iterator i = m_string_indices.find(s);
+
+            if (i != m_string_indices.end())
+            {
+                write_value(i->second);
+                return;
+            }
+
+            const uint32 index = static_cast<uint32>(m_string_indices.size());
+            m_string_indices.insert(make_pair(s, index));
+
+            write_value(BinaryProjectNewString);
+            write_count(s.size());
+            write_bytes(s.data(), s.size());
+        }
+
+        void write_dictionary(const Dictionary& dictionary)
+        {
+            write_count(dictionary.strings().size());
+
+            for (const_each<StringDictionary> i = dictionary.strings(); i; ++i)
+            {
+                write_string(i->key());
+                write_string(i->value());
+            }
+
+            write_count(dictionary.dictionaries().size());
+
+            for (const_each<DictionaryDictionary> i = dictionary.dictionaries(); i; ++i)
+            {
+                write_string(i->key());
+                write_dictionary(i->value());
+            }
+        }
+
+        void write_matrix(const Matrix4d& m)
+        {
+            write_bytes(&m[0], 16 * sizeof(double));
+        }
+
+        void write_transform(const Transformd& transform)
+        {
+            write_matrix(transform.get_local_to_parent());
+        }
+
+        void write_transform(const Transformf& transform)
+        {
+            write_matrix(Matrix4d(transform.get_local_to_parent()));
+        }
+
+        void write_transform_sequence(const TransformSequence& transform_sequence)
+        {
+            write_count(transform_sequence.size());
+
+            for (size_t i = 0, e = transform_sequence.size(); i < e; ++i)
+            {
+                float time;
+                Transformd transform;
+                transform_sequence.get_transform(i, time, transform);
+
+                write_value(time);
+                write_transform(transform);
+            }
+        }
+
+        void write_search_paths(const SearchPaths& search_paths)
+        {
+            write_count(search_paths.size());
+
+            for (size_t i = 0; i < search_paths.size(); ++i)
+                write_string(search_paths[i]);
+        }
+
+        // Write the name and the parameters of an entity.
+        void write_named_entity(const Entity& entity)
+        {
+            write_string(entity.get_name());
+            write_dictionary(entity.get_parameters());
+        }
+
+        // Write the name, the model and the parameters of an entity.
+        template <typename EntityType>
+        void write_entity(const EntityType& entity)
+        {
+            write_string(entity.get_name());
+            write_string(entity.get_model());
+            write_dictionary(entity.get_parameters());
+        }
+
+        template <typename Collection>
+        void write_collection(const Collection& collection)
+        {
+            write_count(collection.size());
+
+            for (const_each<Collection> i = collection; i; ++i)
+                write(*i);
+        }
+
+        void write(const AOV& aov)                          { write_entity(aov); }
+        void write(const BSDF& bsdf)                        { write_entity(bsdf); }
+        void write(const BSSRDF& bssrdf)                    { write_entity(bssrdf); }
+        void write(const EDF& edf)                          { write_entity(edf); }
+        void write(const EnvironmentShader& env_shader)     { write_entity(env_shader); }
+        void write(const Material& material)                { write_entity(material); }
+        void write(const SurfaceShader& surface_shader)     { write_entity(surface_shader); }
+        void write(const Texture& texture)                  { write_entity(texture); }
+        void write(const Volume& volume)                    { write_entity(volume); }
+
+        void write(const Assembly& assembly)
+        {
+            write_entity(assembly);
+
+            // Don't write the content of the assembly if it was generated procedurally.
+            const bool procedural = dynamic_cast<const ProceduralAssembly*>(&assembly) != 0;
+            write_value(static_cast<uint8>(procedural ? 1 : 0));
+            if (procedural)
+                return;
+
+            write_collection(assembly.colors());
+            write_collection(assembly.textures());
+            write_collection(assembly.texture_instances());
+            write_collection(assembly.bsdfs());
+            write_collection(assembly.bssrdfs());
+            write_collection(assembly.edfs());
+            write_collection(assembly.shader_groups());
+            write_collection(assembly.surface_shaders());
+            write_collection(assembly.materials());
+            write_collection(assembly.lights());
+            write_object_collection(assembly.objects());
+            write_collection(assembly.object_instances());
+            write_collection(assembly.volumes());
+            write_collection(assembly.assemblies());
+            write_collection(assembly.assembly_instances());
+        }
+
+        void write(const AssemblyInstance& assembly_instance)
+        {
+            write_named_entity(assembly_instance);
+            write_string(assembly_instance.get_assembly_name());
+            write_transform_sequence(assembly_instance.transform_sequence());
+        }
+
+        void write(const Camera& camera)
+        {
+            write_entity(camera);
+            write_transform_sequence(camera.transform_sequence());
+        }
+
+        void write(const ColorEntity& color_entity)
+        {
+            write_named_entity(color_entity);
+            write_value_array(color_entity.get_values());
+            write_value_array(color_entity.get_alpha());
+        }
+
+        void write_value_array(const ColorValueArray& values)
+        {
+            write_count(values.size());
+
+            for (size_t i = 0, e = values.size(); i < e; ++i)
+                write_value(values[i]);
+        }
+
+        void write(const EnvironmentEDF& env_edf)
+        {
+            write_entity(env_edf);
+            write_transform_sequence(env_edf.transform_sequence());
+        }
+
+        void write(const Light& light)
+        {
+            write_entity(light);
+            write_transform(light.get_transform());
+        }
+
+        void write(const ObjectInstance& object_instance)
+        {
+            write_named_entity(object_instance);
+            write_string(object_instance.get_object_name());
+            write_transform(object_instance.get_transform());
+            write_dictionary_strings(object_instance.get_front_material_mappings());
+            write_dictionary_strings(object_instance.get_back_material_mappings());
+        }
+
+        void write_dictionary_strings(const StringDictionary& strings)
+        {
+            write_count(strings.size());
+
+            for (const_each<StringDictionary> i = strings; i; ++i)
+            {
+                write_string(i->key());
+                write_string(i->value());
+            }
+        }
+
+        void write(const ShaderGroup& shader_group)
+        {
+            write_string(shader_group.get_name());
+
+            write_count(shader_group.shaders().size());
+
+            for (const_each<ShaderContainer> i = shader_group.shaders(); i; ++i)
+            {
+                write_string(i->get_type());
+                write_string(i->get_shader());
+                write_string(i->get_layer());
+
+                write_count(i->shader_params().size());
+
+                for (const_each<ShaderParamContainer> j = i->shader_params(); j; ++j)
+                {
+                    write_string(j->get_name());
+                    write_string(j->get_value_as_string());
+                }
+            }
+
+            write_count(shader_group.shader_connections().size());
+
+            for (const_each<ShaderConnectionContainer> i = shader_group.shader_connections(); i; ++i)
+            {
+                write_string(i->get_src_layer());
+                write_string(i->get_src_param());
+                write_string(i->get_dst_layer());
+                write_string(i->get_dst_param());
+            }
+        }
+
+        void write(const TextureInstance& texture_instance)
+        {
+            write_named_entity(texture_instance);
+            write_string(texture_instance.get_texture_name());
+            write_transform(texture_instance.get_transform());
+        }
+
+        void write_scene(const Scene& scene)
+        {
+            write_dictionary(scene.get_parameters());
+
+            write_collection(scene.cameras());
+            write_collection(scene.colors());
+            write_collection(scene.textures());
+            write_collection(scene.texture_instances());
+            write_collection(scene.environment_edfs());
+            write_collection(scene.environment_shaders());
+
+            write_presence(scene.get_environment());
+            if (scene.get_environment())
+                write_entity(*scene.get_environment());
+
+            write_collection(scene.shader_groups());
+            write_collection(scene.assemblies());
+            write_collection(scene.assembly_instances());
+        }
+
+        void write_frame(const Frame& frame)
+        {
+            write_named_entity(frame);
+            write_collection(frame.aovs());
+        }
+
+        void write_configurations(const ConfigurationContainer& configurations)
+        {
+            vector<const Configuration*> written;
+
+            for (const_each<ConfigurationContainer> i = configurations; i; ++i)
+            {
+                if (!BaseConfigurationFactory::is_base_configuration(i->get_name()))
+                    written.push_back(&*i);
+            }
+
+            write_count(written.size());
+
+            for (const_each<vector<const Configuration*>> i = written; i; ++i)
+            {
+                const Configuration& configuration = **i;
+
+                write_named_entity(configuration);
+                write_string(configuration.get_base() ? configuration.get_base()->get_name() : "");
+            }
+        }
+
+        // Objects that belong to a group read from a single mesh file are written once, under
+        // the name of the group, like in XML project files. Meshes without a backing file are
+        // written inline instead of to separate geometry files.
+        void write_object_collection(const ObjectContainer& objects)
+        {
+            vector<const Object*> written;
+            set<string> groups;
+
+            for (const_each<ObjectContainer> i = objects; i; ++i)
+            {
+                const ParamArray& params = i->get_parameters();
+
+                if (strcmp(i->get_model(), MeshObjectFactory::get_model()) == 0 &&
+                    !params.strings().exist("primitive") &&
+                    params.strings().exist("__base_object_name"))
+                {
+                    if (!groups.insert(params.get<string>("__base_object_name")).second)
+                        continue;
+                }
+
+                written.push_back(&*i);
+            }
+
+            write_count(written.size());
+
+            for (const_each<vector<const Object*>> i = written; i; ++i)
+                write_object(**i);
+        }
+
+        void write_object(const Object& object)
+        {
+            ParamArray params = object.get_parameters();
+
+            if (strcmp(object.get_model(), MeshObjectFactory::get_model()) == 0)
+            {
+                if (params.strings().exist("__base_object_name"))
+                {
+                    // This object stands for its whole group of objects.
+                    const string group_name = params.get<string>("__base_object_name");
+                    params.strings().remove("__base_object_name");
+                    write_object_entity(group_name, object.get_model(), params);
+                    return;
+                }
+
+                if (!params.strings().exist("primitive") &&
+                    !params.strings().exist("filename") &&
+                    !params.dictionaries().exist("filename"))
+                {
+                    write_inline_mesh_object(static_cast<const MeshObject&>(object));
+                    return;
+                }
+            }
+            else if (strcmp(object.get_model(), CurveObjectFactory::get_model()) == 0)
+            {
+                if (!params.strings().exist("filepath"))
+                {
+                    const string filename = string(object.get_name()) + ".txt";
+
+                    if (!(m_options & ProjectFileWriter::OmitWritingGeometryFiles))
+                    {
+                        // Write the curve file to disk.
+                        const string filepath = (m_project_new_root_dir / filename).string();
+                        CurveObjectWriter::write(static_cast<const CurveObject&>(object), filepath.c_str());
+                    }
+
+                    params.insert("filepath", filename);
+                }
+            }
+
+            write_object_entity(object.get_name(), object.get_model(), params);
+        }
+
+        void write_object_entity(
+            const string&       name,
+            const string&       model,
+            const ParamArray&   params)
+        {
+            write_value(static_cast<uint8>(BinaryProjectObjectEntity));
+            write_string(name);
+            write_string(model);
+            write_dictionary(params);
+        }
+
+        void write_vector(const GVector2& v)
+        {
+            write_bytes(&v[0], 2 * sizeof(GScalar));
+        }
+
+        void write_vector(const GVector3& v)
+        {
+            write_bytes(&v[0], 3 * sizeof(GScalar));
+        }
+
+        void write_inline_mesh_object(const MeshObject& object)
+        {
+            write_value(static_cast<uint8>(BinaryProjectInlineMeshObject));
+            write_named_entity(object);
+
+            const size_t vertex_count = object.get_vertex_count();
+            const size_t normal_count = object.get_vertex_normal_count();
+            const size_t tangent_count = object.get_vertex_tangent_count();
+            const size_t tex_coords_count = object.get_tex_coords_count();
+            const size_t triangle_count = object.get_triangle_count();
+            const size_t motion_segment_count = object.get_motion_segment_count();
+            const size_t material_slot_count = object.get_material_slot_count();
+
+            write_count(vertex_count);
+            write_count(normal_count);
+            write_count(tangent_count);
+            write_count(tex_coords_count);
+            write_count(triangle_count);
+            write_count(motion_segment_count);
+            write_count(material_slot_count);
+
+            for (size_t i = 0; i < vertex_count; ++i)
+                write_vector(object.get_vertex(i));
+
+            for (size_t i = 0; i < normal_count; ++i)
+                write_vector(object.get_vertex_normal(i));
+
+            for (size_t i = 0; i < tangent_count; ++i)
+                write_vector(object.get_vertex_tangent(i));
+
+            for (size_t i = 0; i < tex_coords_count; ++i)
+                write_vector(object.get_tex_coords(i));
+
+            for (size_t i = 0; i < triangle_count; ++i)
+            {
+                const Triangle& triangle = object.get_triangle(i);
+                write_value(triangle.m_v0);
+                write_value(triangle.m_v1);
+                write_value(triangle.m_v2);
+                write_value(triangle.m_n0);
+                write_value(triangle.m_n1);
+                write_value(triangle.m_n2);
+                write_value(triangle.m_a0);
+                write_value(triangle.m_a1);
+                write_value(triangle.m_a2);
+                write_value(triangle.m_pa);
+            }
+
+            if (motion_segment_count > 0)
+            {
+                for (size_t i = 0; i < vertex_count; ++i)
+                {
+                    for (size_t j = 0; j < motion_segment_count; ++j)
+                        write_vector(object.get_vertex_pose(i, j));
+                }
+
+                for (size_t i = 0; i < normal_count; ++i)
+                {
+                    for (size_t j = 0; j < motion_segment_count; ++j)
+                        write_vector(object.get_vertex_normal_pose(i, j));
+                }
+
+                for (size_t i = 0; i < tangent_count; ++i)
+                {
+                    for (size_t j = 0; j < motion_segment_count; ++j)
+                        write_vector(object.get_vertex_tangent_pose(i, j));
+                }
+            }
+
+            for (size_t i = 0; i < material_slot_count; ++i)
+                write_string(object.get_material_slot(i));
+        }
+    };
+}
+
+bool BinaryProjectFileWriter::write(
+    const Project&  project,
+    const char*     filepath,
+    const int       options)
+{
+    Writer writer(filepath, options);
+
+    if (!writer.is_open())
+    {
+        RENDERER_LOG_ERROR("failed to write project file %s: i/o error.", filepath);
+        return false;
+    }
+
+    if (!writer.write_project(project))
+    {
+        RENDERER_LOG_ERROR("failed to write project file %s: i/o error.", filepath);
+        return false;
+    }
+
+    return true;
+}
+
+}   // namespace renderer
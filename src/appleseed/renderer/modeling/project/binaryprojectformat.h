@@ -0,0 +1,93 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_RENDERER_MODELING_PROJECT_BINARYPROJECTFORMAT_H
+#define APPLESEED_RENDERER_MODELING_PROJECT_BINARYPROJECTFORMAT_H
+
+// appleseed.foundation headers.
+#include "foundation/platform/types.h"
+
+// Standard headers.
+#include <cstddef>
+
+namespace renderer
+{
+
+//
+// Definitions shared by the reader and the writer of binary project files (*.appleseedb).
+//
+// A binary project file is the signature, the format version (uint16), then a
+// serialization of the project that follows the layout of the XML project format:
+//
+//   project          format revision (uint32), search paths, display, scene, frame, configurations
+//   scene            parameters, cameras, colors, textures, texture instances, environment EDFs,
+//                    environment shaders, environment, shader groups, assemblies, assembly instances
+//   assembly         name, model, parameters, procedural flag (uint8), then unless procedural:
+//                    colors, textures, texture instances, BSDFs, BSSRDFs, EDFs, shader groups,
+//                    surface shaders, materials, lights, objects, object instances, volumes,
+//                    assemblies, assembly instances
+//
+// Collections are a uint32 count followed by their elements, optional entities are
+// a uint8 presence flag followed by the entity. Transforms are stored as 16 float64
+// (local-to-parent matrix, row-major) and transform sequences as a uint32 count of
+// (float32 time, transform) pairs. Dictionaries are a uint32 count of (key, value)
+// strings followed by a uint32 count of (key, dictionary) pairs.
+//
+// Strings are interned: each string is a uint32 index into the table of strings met
+// so far. The special index BinaryProjectNewString introduces a new string, followed
+// by its length (uint32) and its characters; it is appended to the table.
+//
+// Mesh objects without a backing file are stored inline (BinaryProjectInlineMeshObject),
+// other objects by name, model and parameters (BinaryProjectObjectEntity) like in XML.
+// Inline geometry is the uint32 counts of vertices, vertex normals, vertex tangents,
+// texture coordinates, triangles, motion segments and material slots, followed by the
+// float32 vertex, normal, tangent and texture coordinate arrays, the triangles (10 uint32
+// each), the vertex, normal and tangent poses, and the material slot names.
+// All values are stored in the byte order of the machine that wrote the file.
+//
+
+// File signature.
+const char BinaryProjectSignature[] = { 'A', 'P', 'P', 'L', 'E', 'S', 'E', 'E', 'D', 'B' };
+
+// Current version of the format.
+const foundation::uint16 BinaryProjectFormatVersion = 1;
+
+// String index introducing a new string.
+const foundation::uint32 BinaryProjectNewString = ~foundation::uint32(0);
+
+// Kinds of object records.
+enum BinaryProjectObjectKind
+{
+    BinaryProjectObjectEntity = 0,      // name, model, parameters
+    BinaryProjectInlineMeshObject       // name, parameters, geometry
+};
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_MODELING_PROJECT_BINARYPROJECTFORMAT_H
@@ -112,7 +112,7 @@ Dictionary Configuration::get_metadata()
         "spectrum_mode",
         Dictionary()
         .insert("type", "enum")
-        .insert("values", "rgb|spectral")
+        .insert("values", "rgb|spectral|hero_wavelength")
         .insert("default", "rgb")
         .insert("label", "Color Pipeline")
         .insert("help", "Color pipeline used throughout the renderer")
@@ -128,13 +128,18 @@ Dictionary Configuration::get_metadata()
                 "spectral",
                 Dictionary()
                 .insert("label", "Spectral")
-                .insert("help", "Spectral pipeline using 31 equidistant components in the 400-700 nm range"))));
+                .insert("help", "Spectral pipeline using 31 equidistant components in the 400-700 nm range"))
+            .insert(
+                "hero_wavelength",
+                Dictionary()
+                .insert("label", "Hero Wavelength")
+                .insert("help", "Spectral pipeline carrying 4 stochastically chosen wavelengths along each path"))));
 
     metadata.insert(
         "sampling_mode",
         Dictionary()
             .insert("type", "enum")
-            .insert("values", "rng|qmc")
+            .insert("values", "rng|qmc|sobol|sobol_blue_noise")
             .insert("default", "rng")
             .insert("label", "Sampler")
             .insert("help", "Sampling algorithm used in Monte Carlo integration")
@@ -150,7 +155,17 @@ Dictionary Configuration::get_metadata()
                         "qmc",
                         Dictionary()
                             .insert("label", "QMC")
-                            .insert("help", "Quasi Monte Carlo sampler"))));
+                            .insert("help", "Quasi Monte Carlo sampler"))
+                    .insert(
+                        "sobol",
+                        Dictionary()
+                            .insert("label", "Sobol")
+                            .insert("help", "Owen-scrambled Sobol sampler"))
+                    .insert(
+                        "sobol_blue_noise",
+                        Dictionary()
+                            .insert("label", "Sobol (Blue Noise)")
+                            .insert("help", "Owen-scrambled Sobol sampler distributing the error as blue noise in screen space"))));
 
     metadata.insert(
         "lighting_engine",
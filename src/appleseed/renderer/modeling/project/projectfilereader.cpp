@@ -69,6 +69,7 @@
 #include "renderer/modeling/object/meshobject.h"
 #include "renderer/modeling/object/meshobjectreader.h"
 #include "renderer/modeling/object/object.h"
+#include "renderer/modeling/project/binaryprojectfilereader.h"
 #include "renderer/modeling/project/configuration.h"
 #include "renderer/modeling/project/configurationcontainer.h"
 #include "renderer/modeling/project/eventcounters.h"
@@ -107,11 +108,13 @@
 #include "foundation/math/vector.h"
 #include "foundation/platform/compiler.h"
 #include "foundation/platform/defaulttimers.h"
+#include "foundation/platform/system.h"
 #include "foundation/platform/types.h"
 #include "foundation/utility/api/apistring.h"
 #include "foundation/utility/containers/dictionary.h"
 #include "foundation/utility/foreach.h"
 #include "foundation/utility/iterators.h"
+#include "foundation/utility/job.h"
 #include "foundation/utility/log.h"
 #include "foundation/utility/memory.h"
 #include "foundation/utility/otherwise.h"
@@ -203,6 +206,264 @@ namespace
     };
 
 
+    //
+    // A job that reads a mesh file on a worker thread.
+    //
+
+    class MeshObjectLoadJob
+      : public IJob
+    {
+      public:
+        MeshObjectLoadJob(
+            const SearchPaths&  search_paths,
+            const string&       name,
+            const ParamArray&   params)
+          : m_search_paths(search_paths)
+          , m_name(name)
+          , m_params(params)
+          , m_success(false)
+        {
+        }
+
+        ~MeshObjectLoadJob()
+        {
+            release_objects();
+        }
+
+        virtual void execute(const size_t thread_index) override
+        {
+            try
+            {
+                m_success =
+                    MeshObjectReader::read(
+                        m_search_paths,
+                        m_name.c_str(),
+                        m_params,
+                        m_objects,
+                        MeshObjectReader::SingleThreaded);
+            }
+            catch (const ExceptionDictionaryKeyNotFound& e)
+            {
+                RENDERER_LOG_ERROR(
+                    "while defining object \"%s\": required parameter \"%s\" missing.",
+                    m_name.c_str(),
+                    e.string());
+                m_success = false;
+            }
+        }
+
+        bool succeeded() const
+        {
+            return m_success;
+        }
+
+        // Transfer ownership of the objects read from the mesh file to the caller.
+        void take_objects(vector<Object*>& objects)
+        {
+            for (size_t i = 0, e = m_objects.size(); i < e; ++i)
+                objects.push_back(m_objects[i]);
+
+            m_objects.clear();
+        }
+
+        void release_objects()
+        {
+            for (size_t i = 0, e = m_objects.size(); i < e; ++i)
+                m_objects[i]->release();
+
+            m_objects.clear();
+        }
+
+      private:
+        const SearchPaths   m_search_paths;
+        const string        m_name;
+        const ParamArray    m_params;
+        MeshObjectArray     m_objects;
+        bool                m_success;
+    };
+
+
+    //
+    // An object defined in an assembly, or a mesh file that is still being read.
+    // Slots preserve the declaration order of objects when mesh files are read
+    // in parallel.
+    //
+
+    struct ObjectSlot
+    {
+        Object*             m_object;
+        MeshObjectLoadJob*  m_job;
+
+        explicit ObjectSlot(Object* object)
+          : m_object(object)
+          , m_job(0)
+        {
+        }
+
+        explicit ObjectSlot(MeshObjectLoadJob* job)
+          : m_object(0)
+          , m_job(job)
+        {
+        }
+    };
+
+    typedef vector<ObjectSlot> ObjectSlotVector;
+
+
+    //
+    // Reads mesh files on a pool of worker threads while the rest of the
+    // project file is being parsed. Objects are inserted into their assembly
+    // once parsing is complete.
+    //
+
+    class AssetLoader
+      : public NonCopyable
+    {
+      public:
+        explicit AssetLoader(const bool parallel)
+          : m_parallel(parallel)
+        {
+        }
+
+        ~AssetLoader()
+        {
+            // Parsing was interrupted: wait for pending jobs before releasing them.
+            wait_for_jobs();
+
+            for (each<vector<PendingInsertion>> i = m_insertions; i; ++i)
+            {
+                for (const_each<ObjectSlotVector> j = i->m_slots; j; ++j)
+                {
+                    if (j->m_object)
+                        j->m_object->release();
+                }
+            }
+
+            for (each<vector<MeshObjectLoadJob*>> i = m_jobs; i; ++i)
+                delete *i;
+        }
+
+        bool is_parallel() const
+        {
+            return m_parallel;
+        }
+
+        // Start reading a mesh file. The returned job remains owned by the loader.
+        MeshObjectLoadJob* load_mesh_object(
+            const SearchPaths&  search_paths,
+            const string&       name,
+            const ParamArray&   params)
+        {
+            assert(m_parallel);
+
+            if (m_job_manager.get() == 0)
+            {
+                m_job_manager.reset(
+                    new JobManager(
+                        global_logger(),
+                        m_job_queue,
+                        System::get_logical_cpu_core_count(),
+                        JobManager::KeepRunningOnEmptyQueue));
+                m_job_manager->start();
+            }
+
+            MeshObjectLoadJob* job = new MeshObjectLoadJob(search_paths, name, params);
+            m_jobs.push_back(job);
+            m_job_queue.schedule(job, false);
+
+            return job;
+        }
+
+        // Defer the insertion of a sequence of objects into an assembly until
+        // all mesh files are read. A null assembly discards the objects.
+        void defer_insertion(
+            Assembly*           assembly,
+            ObjectSlotVector&   slots)
+        {
+            m_insertions.push_back(PendingInsertion());
+            m_insertions.back().m_assembly = assembly;
+            m_insertions.back().m_slots.swap(slots);
+        }
+
+        // Wait for all mesh files to be read and insert objects into their assembly.
+        void finish(EventCounters& event_counters)
+        {
+            wait_for_jobs();
+
+            for (const_each<vector<MeshObjectLoadJob*>> i = m_jobs; i; ++i)
+            {
+                if (!(*i)->succeeded())
+                    event_counters.signal_error();
+            }
+
+            // Assemblies may have been discarded after a parsing error.
+            if (event_counters.has_errors())
+                return;
+
+            for (each<vector<PendingInsertion>> i = m_insertions; i; ++i)
+            {
+                vector<Object*> objects;
+
+                for (each<ObjectSlotVector> j = i->m_slots; j; ++j)
+                {
+                    if (j->m_object)
+                    {
+                        objects.push_back(j->m_object);
+                        j->m_object = 0;
+                    }
+                    else j->m_job->take_objects(objects);
+                }
+
+                for (const_each<vector<Object*>> j = objects; j; ++j)
+                {
+                    auto_release_ptr<Object> object(*j);
+
+                    if (i->m_assembly == 0)
+                        continue;
+
+                    ObjectContainer& container = i->m_assembly->objects();
+
+                    if (container.get_by_name(object->get_name()) != 0)
+                    {
+                        RENDERER_LOG_ERROR(
+                            "an entity with the path \"%s\" already exists.",
+                            object->get_path().c_str());
+                        event_counters.signal_error();
+                        continue;
+                    }
+
+                    container.insert(object);
+                }
+            }
+
+            m_insertions.clear();
+        }
+
+      private:
+        struct PendingInsertion
+        {
+            Assembly*           m_assembly;
+            ObjectSlotVector    m_slots;
+        };
+
+        const bool                  m_parallel;
+        JobQueue                    m_job_queue;
+        auto_ptr<JobManager>        m_job_manager;
+        vector<MeshObjectLoadJob*>  m_jobs;
+        vector<PendingInsertion>    m_insertions;
+
+        void wait_for_jobs()
+        {
+            if (m_job_manager.get())
+            {
+                m_job_queue.wait_until_completion();
+                m_job_manager->stop();
+                m_job_manager.reset();
+            }
+        }
+    };
+
+
     //
     // A set of objects that is passed to all element handlers.
     //
@@ -217,6 +478,9 @@ namespace
           : m_project(project)
           , m_options(options)
           , m_event_counters(event_counters)
+          , m_asset_loader(
+                !(options & ProjectFileReader::OmitReadingMeshFiles) &&
+                !(options & ProjectFileReader::OmitParallelLoading))
         {
         }
 
@@ -235,10 +499,16 @@ namespace
             return m_event_counters;
         }
 
+        AssetLoader& get_asset_loader()
+        {
+            return m_asset_loader;
+        }
+
       private:
         Project&            m_project;
         const int           m_options;
         EventCounters&      m_event_counters;
+        AssetLoader         m_asset_loader;
     };
 
 
@@ -1590,6 +1860,7 @@ namespace
 
         explicit ObjectElementHandler(ParseContext& context)
           : m_context(context)
+          , m_job(0)
         {
         }
 
@@ -1598,6 +1869,7 @@ namespace
             ParametrizedElementHandler::start_element(attrs);
 
             clear_keep_memory(m_objects);
+            m_job = 0;
 
             m_name = get_value(attrs, "name");
             m_model = get_value(attrs, "model");
@@ -1618,6 +1890,14 @@ namespace
                                 m_name.c_str(),
                                 m_params).release());
                     }
+                    else if (m_context.get_asset_loader().is_parallel())
+                    {
+                        m_job =
+                            m_context.get_asset_loader().load_mesh_object(
+                                m_context.get_project().search_paths(),
+                                m_name,
+                                m_params);
+                    }
                     else
                     {
                         MeshObjectArray object_array;
@@ -1662,11 +1942,18 @@ namespace
             return m_objects;
         }
 
+        // Return the job reading the mesh file, or 0 if objects are already available.
+        MeshObjectLoadJob* get_object_load_job() const
+        {
+            return m_job;
+        }
+
       private:
-        ParseContext&   m_context;
-        ObjectVector    m_objects;
-        string          m_name;
-        string          m_model;
+        ParseContext&       m_context;
+        ObjectVector        m_objects;
+        MeshObjectLoadJob*  m_job;
+        string              m_name;
+        string              m_model;
     };
 
 
@@ -2088,6 +2375,7 @@ namespace
             m_lights.clear();
             m_materials.clear();
             m_objects.clear();
+            m_object_slots.clear();
             m_object_instances.clear();
             m_volumes.clear();
             m_shader_groups.clear();
@@ -2126,7 +2414,15 @@ namespace
                 m_assembly->textures().swap(m_textures);
                 m_assembly->texture_instances().swap(m_texture_instances);
             }
-            else
+
+            if (!m_object_slots.empty())
+            {
+                m_context.get_asset_loader().defer_insertion(
+                    m_assembly.get(),
+                    m_object_slots);
+            }
+
+            if (!factory)
             {
                 RENDERER_LOG_ERROR(
                     "while defining assembly \"%s\": invalid model \"%s\".",
@@ -2191,9 +2487,20 @@ namespace
                 break;
 
               case ElementObject:
-                for (const_each<ObjectElementHandler::ObjectVector> i =
-                        static_cast<ObjectElementHandler*>(handler)->get_objects(); i; ++i)
-                    insert(m_objects, auto_release_ptr<Object>(*i));
+                {
+                    ObjectElementHandler* object_handler = static_cast<ObjectElementHandler*>(handler);
+
+                    if (MeshObjectLoadJob* job = object_handler->get_object_load_job())
+                        m_object_slots.push_back(ObjectSlot(job));
+
+                    for (const_each<ObjectElementHandler::ObjectVector> i = object_handler->get_objects(); i; ++i)
+                    {
+                        // Once a mesh file is pending, later objects must wait their turn too.
+                        if (m_object_slots.empty())
+                            insert(m_objects, auto_release_ptr<Object>(*i));
+                        else m_object_slots.push_back(ObjectSlot(*i));
+                    }
+                }
                 break;
 
               case ElementObjectInstance:
@@ -2256,6 +2563,7 @@ namespace
         LightContainer              m_lights;
         MaterialContainer           m_materials;
         ObjectContainer             m_objects;
+        ObjectSlotVector            m_object_slots;
         ObjectInstanceContainer     m_object_instances;
         VolumeContainer             m_volumes;
         ShaderGroupContainer        m_shader_groups;
@@ -3338,6 +3646,16 @@ auto_release_ptr<Project> ProjectFileReader::load_project_file(
         project->search_paths() = *search_paths;
     }
 
+    // Load binary project files without going through the XML parser.
+    if (BinaryProjectFileReader::is_binary_project_file(project_filepath))
+    {
+        RENDERER_LOG_INFO("loading binary project file %s...", project_filepath);
+        return
+            BinaryProjectFileReader::read(project.ref(), project_filepath, options, event_counters)
+                ? project
+                : auto_release_ptr<Project>(0);
+    }
+
     // Create the error handler.
     auto_ptr<ErrorLogger> error_handler(
         new ErrorLoggerAndCounter(
@@ -3390,6 +3708,9 @@ auto_release_ptr<Project> ProjectFileReader::load_project_file(
         return auto_release_ptr<Project>(0);
     }
 
+    // Wait for mesh files still being read and insert their objects.
+    context.get_asset_loader().finish(event_counters);
+
     // Report a failure in case of warnings or errors.
     if (error_handler->get_warning_count() > 0 ||
         error_handler->get_error_count() > 0 ||
@@ -58,10 +58,12 @@ class APPLESEED_DLLSYMBOL ProjectFileReader
         OmitReadingMeshFiles        = 1 << 0,   // do not read mesh files from disk
         OmitProjectFileUpdate       = 1 << 1,   // do not update the project file format to the latest revision
         OmitSearchPaths             = 1 << 2,   // do not read search paths from the project
-        OmitProjectSchemaValidation = 1 << 3    // do not validate project against schema
+        OmitProjectSchemaValidation = 1 << 3,   // do not validate project against schema
+        OmitParallelLoading         = 1 << 4    // read mesh files sequentially while parsing the project file
     };
 
     // Read a project from disk (or load a built-in project).
+    // Binary project files (*.appleseedb) are recognized by their signature.
     // Return 0 if reading or parsing the file failed.
     foundation::auto_release_ptr<Project> read(
         const char*                     project_filepath,
@@ -50,6 +50,7 @@
 #include "renderer/modeling/object/meshobjectwriter.h"
 #include "renderer/modeling/object/object.h"
 #include "renderer/modeling/project/assethandler.h"
+#include "renderer/modeling/project/binaryprojectfilewriter.h"
 #include "renderer/modeling/project/configuration.h"
 #include "renderer/modeling/project/configurationcontainer.h"
 #include "renderer/modeling/project/project.h"
@@ -887,19 +888,22 @@ bool ProjectFileWriter::write(
     const char*     filepath,
     const int       options)
 {
-    return
-        bf::path(filepath).extension() == ".appleseedz"
-            ? write_packed_project_file(project, filepath, options)
-            : write_plain_project_file(project, filepath, options);
+    const bf::path extension = bf::path(filepath).extension();
+
+    if (extension == ".appleseedz")
+        return write_packed_project_file(project, filepath, options);
+
+    if (extension == ".appleseedb")
+        return write_binary_project_file(project, filepath, options);
+
+    return write_plain_project_file(project, filepath, options);
 }
 
-bool ProjectFileWriter::write_plain_project_file(
+bool ProjectFileWriter::handle_asset_files(
     const Project&  project,
     const char*     filepath,
     const int       options)
 {
-    RENDERER_LOG_INFO("writing project file %s...", filepath);
-
     if (!(options & OmitHandlingAssetFiles))
     {
         // Manage references to external asset files.
@@ -916,6 +920,19 @@ bool ProjectFileWriter::write_plain_project_file(
         }
     }
 
+    return true;
+}
+
+bool ProjectFileWriter::write_plain_project_file(
+    const Project&  project,
+    const char*     filepath,
+    const int       options)
+{
+    RENDERER_LOG_INFO("writing project file %s...", filepath);
+
+    if (!handle_asset_files(project, filepath, options))
+        return false;
+
     // Open the file for writing.
     FILE* file = fopen(filepath, "wt");
     if (file == 0)
@@ -947,6 +964,23 @@ bool ProjectFileWriter::write_plain_project_file(
     return true;
 }
 
+bool ProjectFileWriter::write_binary_project_file(
+    const Project&  project,
+    const char*     filepath,
+    const int       options)
+{
+    RENDERER_LOG_INFO("writing project file %s...", filepath);
+
+    if (!handle_asset_files(project, filepath, options))
+        return false;
+
+    if (!BinaryProjectFileWriter::write(project, filepath, options))
+        return false;
+
+    RENDERER_LOG_INFO("wrote project file %s.", filepath);
+    return true;
+}
+
 bool ProjectFileWriter::write_packed_project_file(
     const Project&  project,
     const char*     filepath,
@@ -56,6 +56,8 @@ class APPLESEED_DLLSYMBOL ProjectFileWriter
     };
 
     // Write a project to disk.
+    // Projects are packed if the file extension is .appleseedz,
+    // and written in binary form if it is .appleseedb.
     // Returns true on success, false otherwise.
     static bool write(
         const Project&  project,
@@ -63,6 +65,13 @@ class APPLESEED_DLLSYMBOL ProjectFileWriter
         const int       options = Defaults);
 
   private:
+    // Update references to external asset files, copying them if necessary.
+    // Returns true on success, false otherwise.
+    static bool handle_asset_files(
+        const Project&  project,
+        const char*     filepath,
+        const int       options);
+
     // Write a project to disk as a plain project file.
     // Returns true on success, false otherwise.
     static bool write_plain_project_file(
@@ -70,6 +79,13 @@ class APPLESEED_DLLSYMBOL ProjectFileWriter
         const char*     filepath,
         const int       options);
 
+    // Write a project to disk as a binary project file.
+    // Returns true on success, false otherwise.
+    static bool write_binary_project_file(
+        const Project&  project,
+        const char*     filepath,
+        const int       options);
+
     // Write a project file to disk as a packed project file.
     // Returns true on success, false otherwise.
     static bool write_packed_project_file(
@@ -98,6 +98,21 @@ bool ArchiveAssembly::expand_contents(
     const Assembly*     parent,
     IAbortSwitch*       abort_switch)
 {
+    // With skip_invisible, the archive is only read if one of its instances is visible,
+    // and its contents are released once none of them is.
+    if (m_params.get_optional<bool>("skip_invisible", false) &&
+        !has_visible_instances(project))
+    {
+        if (m_archive_opened)
+        {
+            unload_contents();
+            m_archive_opened = false;
+            bump_version_id();
+        }
+
+        return true;
+    }
+
     if (!m_archive_opened)
     {
         // Establish and store the qualified path to the archive project.
@@ -131,12 +146,32 @@ bool ArchiveAssembly::expand_contents(
             textures().swap(assembly->textures());
             texture_instances().swap(assembly->texture_instances());
             m_archive_opened = true;
+            bump_version_id();
         }
     }
 
     return true;
 }
 
+void ArchiveAssembly::unload_contents()
+{
+    assemblies().clear();
+    assembly_instances().clear();
+    bsdfs().clear();
+    bssrdfs().clear();
+    colors().clear();
+    edfs().clear();
+    lights().clear();
+    materials().clear();
+    objects().clear();
+    object_instances().clear();
+    volumes().clear();
+    shader_groups().clear();
+    surface_shaders().clear();
+    textures().clear();
+    texture_instances().clear();
+}
+
 
 //
 // ArchiveAssemblyFactory class implementation.
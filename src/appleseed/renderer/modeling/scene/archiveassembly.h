@@ -55,6 +55,13 @@ namespace renderer
 // An archive assembly loads and references geometries, materials and lights
 // from other appleseed projects.
 //
+// When the "skip_invisible" parameter is true, the archive is only read if an
+// assembly instance visible to at least one ray type instantiates it, and its
+// contents are released when no such instance is left. This is not on-demand
+// loading: visibility is checked when procedural assemblies are expanded, before
+// rendering starts. A visible archive is fully loaded even if no ray ever hits
+// it, there is no bounding box proxy and no memory budget.
+//
 
 class APPLESEED_DLLSYMBOL ArchiveAssembly
   : public ProceduralAssembly
@@ -84,6 +91,9 @@ class APPLESEED_DLLSYMBOL ArchiveAssembly
         const ParamArray&           params);
 
     bool m_archive_opened;
+
+    // Release the contents read from the archive.
+    void unload_contents();
 };
 
 
@@ -29,15 +29,48 @@
 // Interface header.
 #include "proceduralassembly.h"
 
+// appleseed.renderer headers.
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/scene/assemblyinstance.h"
+#include "renderer/modeling/scene/basegroup.h"
+#include "renderer/modeling/scene/containers.h"
+#include "renderer/modeling/scene/scene.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/utility/foreach.h"
+
 // Standard headers.
 #include <string>
 
-// appleseed.renderer headers.
-#include "renderer/utility/paramarray.h"
+using namespace foundation;
 
 namespace renderer
 {
 
+namespace
+{
+    bool has_visible_instances_of(
+        const BaseGroup&    group,
+        const Assembly*     assembly)
+    {
+        for (const_each<AssemblyInstanceContainer> i = group.assembly_instances(); i; ++i)
+        {
+            if (i->get_vis_flags() != 0 && i->find_assembly() == assembly)
+                return true;
+        }
+
+        for (const_each<AssemblyContainer> i = group.assemblies(); i; ++i)
+        {
+            if (has_visible_instances_of(*i, assembly))
+                return true;
+        }
+
+        return false;
+    }
+}
+
+
 //
 // ProceduralAssembly class implementation.
 //
@@ -49,4 +82,16 @@ ProceduralAssembly::ProceduralAssembly(
 {
 }
 
+bool ProceduralAssembly::has_visible_instances(const Project& project) const
+{
+    const Scene* scene = project.get_scene();
+
+    if (scene == 0)
+        return false;
+
+    // Assembly instances resolve assembly names by walking up the hierarchy,
+    // so this assembly may be instantiated from any group nested below its parent.
+    return has_visible_instances_of(*scene, this);
+}
+
 }   // namespace renderer
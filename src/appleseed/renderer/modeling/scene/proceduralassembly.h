@@ -65,6 +65,10 @@ class APPLESEED_DLLSYMBOL ProceduralAssembly
     ProceduralAssembly(
         const char*                 name,
         const ParamArray&           params);
+
+    // Return true if at least one assembly instance anywhere in the scene
+    // instantiates this assembly and is visible to at least one type of ray.
+    bool has_visible_instances(const Project& project) const;
 };
 
 }       // namespace renderer
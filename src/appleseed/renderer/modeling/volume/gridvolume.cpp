@@ -0,0 +1,741 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+// Interface header.
+#include "gridvolume.h"
+
+// appleseed.renderer headers.
+#include "renderer/global/globallogger.h"
+#include "renderer/global/globaltypes.h"
+#include "renderer/kernel/shading/shadingray.h"
+#include "renderer/kernel/volume/occupancygrid.h"
+#include "renderer/kernel/volume/sparsevoxelgrid.h"
+#include "renderer/kernel/volume/volume.h"
+#include "renderer/kernel/volume/volumetracking.h"
+#include "renderer/modeling/input/inputarray.h"
+#include "renderer/modeling/project/project.h"
+#include "renderer/modeling/volume/volume.h"
+#include "renderer/utility/paramarray.h"
+
+// appleseed.foundation headers.
+#include "foundation/math/hash.h"
+#include "foundation/math/phasefunction.h"
+#include "foundation/math/rng/xoroshiro128plus.h"
+#include "foundation/math/scalar.h"
+#include "foundation/math/vector.h"
+#include "foundation/utility/api/specializedapiarrays.h"
+#include "foundation/utility/casts.h"
+#include "foundation/utility/containers/dictionary.h"
+#include "foundation/utility/iostreamop.h"
+#include "foundation/utility/makevector.h"
+#include "foundation/utility/searchpaths.h"
+#include "foundation/utility/statistics.h"
+#include "foundation/utility/string.h"
+
+// Standard headers.
+#include <memory>
+#include <string>
+
+using namespace foundation;
+using namespace std;
+
+namespace renderer
+{
+
+namespace
+{
+    const char* Model = "grid_volume";
+
+    // A density grid, stored either densely or sparsely.
+    struct DensityGrid
+    {
+        auto_ptr<VoxelGrid>         m_dense_grid;
+        auto_ptr<SparseVoxelGrid>   m_sparse_grid;
+        size_t                      m_density_index;    // index of the density channel in the sparse grid
+
+        DensityGrid()
+          : m_density_index(0)
+        {
+        }
+
+        bool is_loaded() const
+        {
+            return m_dense_grid.get() != nullptr || m_sparse_grid.get() != nullptr;
+        }
+
+        // 'point' must be expressed in the unit cube [0,1]^3.
+        float linear_lookup(const Vector3d& point) const
+        {
+            if (m_sparse_grid.get())
+            {
+                float values[SparseVoxelGrid::MaxChannelCount];
+                m_sparse_grid->linear_lookup(point, values);
+                return max(values[m_density_index], 0.0f);
+            }
+
+            float density;
+            m_dense_grid->linear_lookup(point, &density);
+            return density;
+        }
+    };
+
+    // Density lookups along a ray expressed in the unit cube of a density grid.
+    struct DensityLookup
+    {
+        const DensityGrid&  m_grid;
+        const Vector3d      m_org;
+        const Vector3d      m_dir;
+
+        DensityLookup(
+            const DensityGrid&  grid,
+            const Vector3d&     org,
+            const Vector3d&     dir)
+          : m_grid(grid)
+          , m_org(org)
+          , m_dir(dir)
+        {
+        }
+
+        float operator()(const double t) const
+        {
+            return m_grid.linear_lookup(m_org + t * m_dir);
+        }
+    };
+
+    // Return a random number generator whose state only depends on a ray and an additional seed.
+    Xoroshiro128plus make_rng(const ShadingRay& ray, const uint64 seed)
+    {
+        const uint64 s0 =
+            mix_uint64(
+                binary_cast<uint64>(ray.m_org.x),
+                binary_cast<uint64>(ray.m_org.y),
+                binary_cast<uint64>(ray.m_org.z));
+        const uint64 s1 =
+            mix_uint64(
+                binary_cast<uint64>(ray.m_dir.x),
+                binary_cast<uint64>(ray.m_dir.y),
+                binary_cast<uint64>(ray.m_dir.z),
+                seed);
+
+        // The state of the generator must not be zero everywhere.
+        return Xoroshiro128plus(s0 | 1, s1);
+    }
+}
+
+
+//
+// Grid volume.
+//
+
+class GridVolume
+  : public Volume
+{
+  public:
+    GridVolume(
+        const char*         name,
+        const ParamArray&   params)
+      : Volume(name, params)
+      , m_sparse(false)
+    {
+        m_inputs.declare("absorption", InputFormatSpectralReflectance);
+        m_inputs.declare("absorption_multiplier", InputFormatFloat, "1.0");
+        m_inputs.declare("scattering", InputFormatSpectralReflectance);
+        m_inputs.declare("scattering_multiplier", InputFormatFloat, "1.0");
+    }
+
+    virtual void release() override
+    {
+        delete this;
+    }
+
+    virtual const char* get_model() const override
+    {
+        return Model;
+    }
+
+    virtual bool on_frame_begin(
+        const Project&          project,
+        const BaseGroup*        parent,
+        OnFrameBeginRecorder&   recorder,
+        IAbortSwitch*           abort_switch) override
+    {
+        if (!Volume::on_frame_begin(project, parent, recorder, abort_switch))
+            return false;
+
+        const EntityDefMessageContext context("volume", this);
+
+        const string phase_function =
+            m_params.get_required<string>(
+                "phase_function_model",
+                "isotropic",
+                make_vector("isotropic", "henyey"),
+                context);
+
+        if (phase_function == "isotropic")
+            m_phase_function.reset(new IsotropicPhaseFunction());
+        else if (phase_function == "henyey")
+        {
+            const float g = clamp(
+                m_params.get_optional<float>("average_cosine", 0.0f),
+                -0.99f, +0.99f);
+            m_phase_function.reset(new HenyeyPhaseFunction(g));
+        }
+        else return false;
+
+        // Map the unit cube of the grid to its bounding box in the scene.
+        const Vector3d bbox_min = m_params.get_optional<Vector3d>("bbox_min", Vector3d(0.0));
+        const Vector3d bbox_max = m_params.get_optional<Vector3d>("bbox_max", Vector3d(1.0));
+        const Vector3d extent = bbox_max - bbox_min;
+        if (min_value(extent) <= 0.0)
+        {
+            RENDERER_LOG_ERROR("while preparing volume \"%s\": invalid bounding box.", get_path().c_str());
+            return false;
+        }
+        m_bbox_min = bbox_min;
+        m_rcp_bbox_extent = Vector3d(1.0 / extent.x, 1.0 / extent.y, 1.0 / extent.z);
+
+        // Load the density grid, unless it was already loaded.
+        const string filename =
+            to_string(project.search_paths().qualify(m_params.get_required<string>("filename", "")));
+        const bool sparse =
+            m_params.get_optional<string>(
+                "voxel_storage",
+                "dense",
+                make_vector("dense", "sparse"),
+                context) == "sparse";
+        if (!m_density_grid.is_loaded() || filename != m_filename || sparse != m_sparse)
+        {
+            const bool success =
+                sparse
+                    ? load_sparse_density_grid(filename)
+                    : load_density_grid(filename);
+            if (!success)
+                return false;
+            m_filename = filename;
+            m_sparse = sparse;
+        }
+
+        return true;
+    }
+
+    virtual void on_frame_end(
+        const Project&          project,
+        const BaseGroup*        parent) override
+    {
+        if (m_density_grid.m_sparse_grid.get())
+            RENDERER_LOG_DEBUG("%s", m_density_grid.m_sparse_grid->get_statistics().to_string().c_str());
+
+        Volume::on_frame_end(project, parent);
+    }
+
+    virtual bool is_homogeneous() const override
+    {
+        return false;
+    }
+
+    virtual size_t compute_input_data_size() const override
+    {
+        return sizeof(InputValues);
+    }
+
+    virtual void prepare_inputs(
+        Arena&              arena,
+        const ShadingRay&   volume_ray,
+        void*               data) const override
+    {
+        InputValues* values = static_cast<InputValues*>(data);
+
+        values->m_absorption *= values->m_absorption_multiplier;
+        values->m_scattering *= values->m_scattering_multiplier;
+
+        // Precompute the coefficients at the origin of the ray.
+        const float density = get_density(volume_ray, 0.0f);
+        values->m_precomputed.m_origin_absorption = values->m_absorption;
+        values->m_precomputed.m_origin_absorption *= density;
+        values->m_precomputed.m_origin_scattering = values->m_scattering;
+        values->m_precomputed.m_origin_scattering *= density;
+        values->m_precomputed.m_origin_extinction = values->m_precomputed.m_origin_absorption;
+        values->m_precomputed.m_origin_extinction += values->m_precomputed.m_origin_scattering;
+    }
+
+    virtual float sample(
+        SamplingContext&    sampling_context,
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        const float         distance,
+        Vector3f&           incoming) const override
+    {
+        sampling_context.split_in_place(2, 1);
+        const Vector2f s = sampling_context.next2<Vector2f>();
+
+        const Vector3f outgoing(normalize(volume_ray.m_dir));
+        return m_phase_function->sample(outgoing, s, incoming);
+    }
+
+    virtual float evaluate(
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        const float         distance,
+        const Vector3f&     incoming) const override
+    {
+        const Vector3f outgoing = Vector3f(normalize(volume_ray.m_dir));
+        return m_phase_function->evaluate(outgoing, incoming);
+    }
+
+    virtual void evaluate_transmission(
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        const float         distance,
+        Spectrum&           spectrum) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+
+        Spectrum extinction = values->m_absorption;
+        extinction += values->m_scattering;
+
+        // The estimate is deterministic for a given ray and distance.
+        Xoroshiro128plus rng = make_rng(volume_ray, binary_cast<uint32>(distance));
+
+        const Vector3d org = to_grid_space(volume_ray.m_org);
+        const Vector3d dir = volume_ray.m_dir * m_rcp_bbox_extent;
+
+        ratio_tracking(
+            *m_occupancy_grid,
+            org,
+            dir,
+            0.0,
+            static_cast<double>(distance),
+            DensityLookup(m_density_grid, org, dir),
+            extinction,
+            rng,
+            spectrum);
+    }
+
+    virtual void evaluate_transmission(
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        Spectrum&           spectrum) const override
+    {
+        // Ray segments of infinite length are clipped against the grid.
+        evaluate_transmission(
+            data,
+            volume_ray,
+            static_cast<float>(min(volume_ray.m_tmax, static_cast<double>(numeric_limits<float>::max()))),
+            spectrum);
+    }
+
+    virtual bool sample_distance(
+        SamplingContext&    sampling_context,
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        float&              distance,
+        Spectrum&           weight) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+
+        // Seed a random number generator for this tracking session.
+        sampling_context.split_in_place(1, 1);
+        const float s = sampling_context.next2<float>();
+        Xoroshiro128plus rng = make_rng(volume_ray, binary_cast<uint32>(s));
+
+        const Vector3d org = to_grid_space(volume_ray.m_org);
+        const Vector3d dir = volume_ray.m_dir * m_rcp_bbox_extent;
+
+        double sampled_distance;
+        const bool scattered =
+            spectral_tracking(
+                *m_occupancy_grid,
+                org,
+                dir,
+                0.0,
+                volume_ray.m_tmax,
+                DensityLookup(m_density_grid, org, dir),
+                values->m_absorption,
+                values->m_scattering,
+                rng,
+                sampled_distance,
+                weight);
+
+        distance = static_cast<float>(sampled_distance);
+        return scattered;
+    }
+
+    virtual void scattering_coefficient(
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        const float         distance,
+        Spectrum&           spectrum) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+        spectrum = values->m_scattering;
+        spectrum *= get_density(volume_ray, distance);
+    }
+
+    virtual const Spectrum& scattering_coefficient(
+        const void*         data,
+        const ShadingRay&   volume_ray) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+        return values->m_precomputed.m_origin_scattering;
+    }
+
+    virtual void absorption_coefficient(
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        const float         distance,
+        Spectrum&           spectrum) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+        spectrum = values->m_absorption;
+        spectrum *= get_density(volume_ray, distance);
+    }
+
+    virtual const Spectrum& absorption_coefficient(
+        const void*         data,
+        const ShadingRay&   volume_ray) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+        return values->m_precomputed.m_origin_absorption;
+    }
+
+    virtual void extinction_coefficient(
+        const void*         data,
+        const ShadingRay&   volume_ray,
+        const float         distance,
+        Spectrum&           spectrum) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+        spectrum = values->m_absorption;
+        spectrum += values->m_scattering;
+        spectrum *= get_density(volume_ray, distance);
+    }
+
+    virtual const Spectrum& extinction_coefficient(
+        const void*         data,
+        const ShadingRay&   volume_ray) const override
+    {
+        const InputValues* values = static_cast<const InputValues*>(data);
+        return values->m_precomputed.m_origin_extinction;
+    }
+
+  private:
+    typedef GridVolumeInputValues InputValues;
+
+    unique_ptr<PhaseFunction>   m_phase_function;
+    string                      m_filename;
+    bool                        m_sparse;
+    DensityGrid                 m_density_grid;
+    auto_ptr<OccupancyGrid>     m_occupancy_grid;
+    Vector3d                    m_bbox_min;
+    Vector3d                    m_rcp_bbox_extent;
+
+    bool load_density_grid(const string& filename)
+    {
+        FluidChannels channels;
+        const auto_ptr<VoxelGrid> grid = read_fluid_file(filename.c_str(), channels);
+
+        if (grid.get() == nullptr)
+        {
+            RENDERER_LOG_ERROR(
+                "while preparing volume \"%s\": failed to load fluid file %s.",
+                get_path().c_str(),
+                filename.c_str());
+            return false;
+        }
+
+        if (channels.m_density_index == FluidChannels::NotPresent)
+        {
+            RENDERER_LOG_ERROR(
+                "while preparing volume \"%s\": fluid file %s has no density channel.",
+                get_path().c_str(),
+                filename.c_str());
+            return false;
+        }
+
+        // Only keep the density channel.
+        m_density_grid.m_sparse_grid.reset();
+        m_density_grid.m_dense_grid.reset(
+            new VoxelGrid(
+                grid->get_xres(),
+                grid->get_yres(),
+                grid->get_zres(),
+                1));
+        for (size_t z = 0; z < grid->get_zres(); ++z)
+        {
+            for (size_t y = 0; y < grid->get_yres(); ++y)
+            {
+                for (size_t x = 0; x < grid->get_xres(); ++x)
+                    m_density_grid.m_dense_grid->voxel(x, y, z)[0] = max(grid->voxel(x, y, z)[channels.m_density_index], 0.0f);
+            }
+        }
+
+        // Compute density majorants.
+        m_occupancy_grid.reset(new OccupancyGrid(*m_density_grid.m_dense_grid, 0, 0.0f));
+
+        RENDERER_LOG_INFO(
+            "volume \"%s\": loaded %s x %s x %s density grid from %s.",
+            get_path().c_str(),
+            pretty_uint(grid->get_xres()).c_str(),
+            pretty_uint(grid->get_yres()).c_str(),
+            pretty_uint(grid->get_zres()).c_str(),
+            filename.c_str());
+
+        return true;
+    }
+
+    bool load_sparse_density_grid(const string& filename)
+    {
+        const size_t max_cache_size =
+            m_params.get_optional<size_t>("brick_cache_size", 256 * 1024 * 1024);
+
+        FluidChannels channels;
+        auto_ptr<SparseVoxelGrid> grid =
+            read_sparse_fluid_file(filename.c_str(), channels, max_cache_size);
+
+        if (grid.get() == nullptr)
+        {
+            RENDERER_LOG_ERROR(
+                "while preparing volume \"%s\": failed to load fluid file %s.",
+                get_path().c_str(),
+                filename.c_str());
+            return false;
+        }
+
+        if (channels.m_density_index == FluidChannels::NotPresent)
+        {
+            RENDERER_LOG_ERROR(
+                "while preparing volume \"%s\": fluid file %s has no density channel.",
+                get_path().c_str(),
+                filename.c_str());
+            return false;
+        }
+
+        // Compute density majorants from the brick summaries.
+        m_occupancy_grid.reset(new OccupancyGrid(*grid, channels.m_density_index, 0.0f));
+
+        RENDERER_LOG_INFO(
+            "volume \"%s\": indexed %s x %s x %s sparse density grid from %s.",
+            get_path().c_str(),
+            pretty_uint(grid->get_xres()).c_str(),
+            pretty_uint(grid->get_yres()).c_str(),
+            pretty_uint(grid->get_zres()).c_str(),
+            filename.c_str());
+
+        m_density_grid.m_dense_grid.reset();
+        m_density_grid.m_sparse_grid = grid;
+        m_density_grid.m_density_index = channels.m_density_index;
+
+        return true;
+    }
+
+    Vector3d to_grid_space(const Vector3d& p) const
+    {
+        return (p - m_bbox_min) * m_rcp_bbox_extent;
+    }
+
+    float get_density(const ShadingRay& volume_ray, const float distance) const
+    {
+        const Vector3d p = to_grid_space(volume_ray.point_at(distance));
+
+        // There is no media outside of the grid.
+        if (min_value(p) < 0.0 || max_value(p) > 1.0)
+            return 0.0f;
+
+        return m_density_grid.linear_lookup(p);
+    }
+};
+
+
+//
+// GridVolumeFactory class implementation.
+//
+
+const char* GridVolumeFactory::get_model() const
+{
+    return Model;
+}
+
+Dictionary GridVolumeFactory::get_model_metadata() const
+{
+    return
+        Dictionary()
+            .insert("name", Model)
+            .insert("label", "Grid Volume");
+}
+
+DictionaryArray GridVolumeFactory::get_input_metadata() const
+{
+    DictionaryArray metadata;
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "filename")
+            .insert("label", "File Path")
+            .insert("type", "file")
+            .insert("file_picker_mode", "open")
+            .insert("use", "required"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "bbox_min")
+            .insert("label", "Bounding Box Min")
+            .insert("type", "text")
+            .insert("use", "optional")
+            .insert("default", "0.0 0.0 0.0"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "bbox_max")
+            .insert("label", "Bounding Box Max")
+            .insert("type", "text")
+            .insert("use", "optional")
+            .insert("default", "1.0 1.0 1.0"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "voxel_storage")
+            .insert("label", "Voxel Storage")
+            .insert("type", "enumeration")
+            .insert("items",
+                Dictionary()
+                    .insert("Dense", "dense")
+                    .insert("Sparse", "sparse"))
+            .insert("use", "optional")
+            .insert("default", "dense")
+            .insert("on_change", "rebuild_form"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "brick_cache_size")
+            .insert("label", "Brick Cache Size")
+            .insert("type", "integer")
+            .insert("min",
+                Dictionary()
+                    .insert("value", "0")
+                    .insert("type", "hard"))
+            .insert("use", "optional")
+            .insert("default", "268435456")
+            .insert("visible_if",
+                Dictionary()
+                    .insert("voxel_storage", "sparse")));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "absorption")
+            .insert("label", "Absorption Coefficient")
+            .insert("type", "colormap")
+            .insert("entity_types",
+                Dictionary().insert("color", "Colors"))
+            .insert("use", "required")
+            .insert("default", "0.5"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "absorption_multiplier")
+            .insert("label", "Absorption Coefficient Multiplier")
+            .insert("type", "numeric")
+            .insert("min",
+                Dictionary()
+                    .insert("value", "0.0")
+                    .insert("type", "hard"))
+            .insert("max",
+                Dictionary()
+                    .insert("value", "200.0")
+                    .insert("type", "soft"))
+            .insert("use", "optional")
+            .insert("default", "1.0"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "scattering")
+            .insert("label", "Scattering Coefficient")
+            .insert("type", "colormap")
+            .insert("entity_types",
+                Dictionary().insert("color", "Colors"))
+            .insert("use", "required")
+            .insert("default", "0.5"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "scattering_multiplier")
+            .insert("label", "Scattering Coefficient Multiplier")
+            .insert("type", "numeric")
+            .insert("min",
+                Dictionary()
+                    .insert("value", "0.0")
+                    .insert("type", "hard"))
+            .insert("max",
+                Dictionary()
+                    .insert("value", "200.0")
+                    .insert("type", "soft"))
+            .insert("use", "optional")
+            .insert("default", "1.0"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "phase_function_model")
+            .insert("label", "Phase Function Model")
+            .insert("type", "enumeration")
+            .insert("items",
+                Dictionary()
+                    .insert("Isotropic", "isotropic")
+                    .insert("Henyey-Greenstein", "henyey"))
+            .insert("use", "required")
+            .insert("default", "isotropic")
+            .insert("on_change", "rebuild_form"));
+
+    metadata.push_back(
+        Dictionary()
+            .insert("name", "average_cosine")
+            .insert("label", "Average Cosine (g)")
+            .insert("type", "numeric")
+            .insert("min",
+                Dictionary()
+                    .insert("value", "-1.0")
+                    .insert("type", "soft"))
+            .insert("max",
+                Dictionary()
+                    .insert("value", "1.0")
+                    .insert("type", "soft"))
+            .insert("use", "optional")
+            .insert("default", "0.0")
+            .insert("visible_if",
+                Dictionary().insert("phase_function_model", "henyey")));
+
+    return metadata;
+}
+
+auto_release_ptr<Volume> GridVolumeFactory::create(
+    const char*         name,
+    const ParamArray&   params) const
+{
+    return auto_release_ptr<Volume>(new GridVolume(name, params));
+}
+
+}   // namespace renderer
@@ -0,0 +1,105 @@
+
+//
+// This source file is part of appleseed.
+// Visit http://appleseedhq.net/ for additional information and resources.
+//
+// This software is released under the MIT license.
+//
+// Copyright (c) 2017 The appleseedhq Organization
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#ifndef APPLESEED_RENDERER_MODELING_VOLUME_GRIDVOLUME_H
+#define APPLESEED_RENDERER_MODELING_VOLUME_GRIDVOLUME_H
+
+// appleseed.renderer headers.
+#include "renderer/global/globaltypes.h"
+#include "renderer/modeling/input/inputarray.h"
+#include "renderer/modeling/volume/ivolumefactory.h"
+
+// appleseed.foundation headers.
+#include "foundation/platform/compiler.h"
+#include "foundation/utility/autoreleaseptr.h"
+
+// appleseed.main headers.
+#include "main/dllsymbol.h"
+
+// Forward declarations.
+namespace foundation    { class Dictionary; }
+namespace foundation    { class DictionaryArray; }
+namespace renderer      { class ParamArray; }
+namespace renderer      { class Volume; }
+
+namespace renderer
+{
+
+//
+// Grid volume input values.
+//
+
+APPLESEED_DECLARE_INPUT_VALUES(GridVolumeInputValues)
+{
+    Spectrum    m_absorption;               // absorption coefficient of the media at unit density
+    float       m_absorption_multiplier;    // absorption coefficient multiplier
+    Spectrum    m_scattering;               // scattering coefficient of the media at unit density
+    float       m_scattering_multiplier;    // scattering coefficient multiplier
+
+    struct Precomputed
+    {
+        Spectrum    m_origin_absorption;    // absorption coefficient at the origin of the volume ray
+        Spectrum    m_origin_scattering;    // scattering coefficient at the origin of the volume ray
+        Spectrum    m_origin_extinction;    // extinction coefficient at the origin of the volume ray
+    };
+
+    Precomputed m_precomputed;
+};
+
+
+//
+// Grid volume factory.
+//
+// A heterogeneous volume whose density is read from a voxel grid file and mapped to an
+// axis-aligned box of the scene. Distances are sampled by delta tracking against the
+// per-voxel density majorants of an occupancy grid, which lets rays skip empty space.
+//
+
+class APPLESEED_DLLSYMBOL GridVolumeFactory
+  : public IVolumeFactory
+{
+  public:
+    // Return a string identifying this volume model.
+    virtual const char* get_model() const override;
+
+    // Return metadata for this volume model.
+    virtual foundation::Dictionary get_model_metadata() const override;
+
+    // Return metadata for the inputs of this volume model.
+    virtual foundation::DictionaryArray get_input_metadata() const override;
+
+    // Create a new volume instance.
+    virtual foundation::auto_release_ptr<Volume> create(
+        const char*         name,
+        const ParamArray&   params) const override;
+};
+
+}       // namespace renderer
+
+#endif  // !APPLESEED_RENDERER_MODELING_VOLUME_GRIDVOLUME_H
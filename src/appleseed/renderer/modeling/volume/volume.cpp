@@ -87,4 +87,16 @@ void Volume::prepare_inputs(
 {
 }
 
+bool Volume::sample_distance(
+    SamplingContext&        sampling_context,
+    const void*             data,
+    const ShadingRay&       volume_ray,
+    float&                  distance,
+    Spectrum&               weight) const
+{
+    distance = static_cast<float>(volume_ray.m_tmax);
+    evaluate_transmission(data, volume_ray, weight);
+    return false;
+}
+
 }   // namespace renderer
@@ -118,6 +118,19 @@ class APPLESEED_DLLSYMBOL Volume
         const ShadingRay&           volume_ray,                 // ray used for marching inside the volume
         Spectrum&                   spectrum) const = 0;        // resulting spectrum
 
+    // Sample the distance to the next scattering event along the ray. This is used for
+    // heterogeneous volumes only. Return true if a scattering event was sampled, false if
+    // the ray left the volume segment or was absorbed. In all cases, `weight` is set to the
+    // transmission (multiplied by the scattering coefficient at the sampled point, if any)
+    // divided by the probability of the event; it is zero if the ray was absorbed, in which
+    // case the path must be terminated. The default implementation never scatters.
+    virtual bool sample_distance(
+        SamplingContext&            sampling_context,
+        const void*                 data,                       // input values
+        const ShadingRay&           volume_ray,                 // ray used for marching inside the volume
+        float&                      distance,                   // distance to the sampled point on this volume segment
+        Spectrum&                   weight) const;              // weight of the sampled event
+
     // Get the scattering coefficient (spectrum) at a given point.
     virtual void scattering_coefficient(
         const void*                 data,                       // input values
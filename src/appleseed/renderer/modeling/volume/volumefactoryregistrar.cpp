@@ -31,6 +31,7 @@
 
 // appleseed.renderer headers.
 #include "renderer/modeling/volume/genericvolume.h"
+#include "renderer/modeling/volume/gridvolume.h"
 
 // appleseed.foundation headers.
 #include "foundation/utility/foreach.h"
@@ -57,6 +58,7 @@ VolumeFactoryRegistrar::VolumeFactoryRegistrar()
   : impl(new Impl())
 {
     register_factory(auto_ptr<FactoryType>(new GenericVolumeFactory()));
+    register_factory(auto_ptr<FactoryType>(new GridVolumeFactory()));
 }
 
 VolumeFactoryRegistrar::~VolumeFactoryRegistrar()
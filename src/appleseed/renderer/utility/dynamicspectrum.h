@@ -52,7 +52,7 @@ namespace renderer
 {
 
 //
-// Internal working spectrum type, either RGB or spectral depending on the thread-local spectrum mode.
+// Internal working spectrum type, either RGB, spectral or hero wavelength depending on the thread-local spectrum mode.
 //
 
 template <typename T, size_t N>
@@ -64,14 +64,20 @@ class DynamicSpectrum
     static const size_t Samples = N;
 
     // Number of stored samples such that the size of the sample array is a multiple of 16 bytes.
+    // The storage is the same in all modes since the mode is only known at runtime; in hero
+    // wavelength mode, only the first HeroWavelengthCount samples are used and operated on.
     static const size_t StoredSamples = (((N * sizeof(T)) + 15) & ~15) / sizeof(T);
 
     enum Mode
     {
         RGB = 0,            // DynamicSpectrum stores and operates on RGB triplets
-        Spectral = 1        // DynamicSpectrum stores and operates on spectra
+        Spectral = 1,       // DynamicSpectrum stores and operates on spectra
+        HeroWavelength = 2  // DynamicSpectrum stores and operates on a few stochastically chosen wavelengths
     };
 
+    // Number of wavelengths carried by spectra in hero wavelength mode.
+    static const size_t HeroWavelengthCount = 4;
+
     enum Intent
     {
         Reflectance = 0,    // this spectrum represents a reflectance in [0, 1]^N
@@ -87,6 +93,14 @@ class DynamicSpectrum
     // Return the number of active color channels for the current spectrum mode.
     static size_t size();
 
+    // Select the thread-local wavelengths carried by spectra in hero wavelength mode, given a
+    // uniform sample in [0, 1). The hero wavelength is chosen according to `s`, the other ones
+    // are equally spaced across the visible range.
+    static void set_hero_wavelengths(const float s);
+
+    // Return the index of the spectral band of the i'th wavelength in hero wavelength mode.
+    static size_t get_hero_band(const size_t i);
+
     // Constructors.
     DynamicSpectrum();                                      // leave all components uninitialized
     explicit DynamicSpectrum(const ValueType val);          // set all components to `val`
@@ -133,9 +147,15 @@ class DynamicSpectrum
     foundation::Color<ValueType, 3> to_ciexyz(
         const foundation::LightingConditions&   lighting_conditions) const;
 
+    // In hero wavelength mode, replace a full spectrum (as computed in spectral mode, for
+    // instance by entities when a frame begins) by its values at the current wavelengths.
+    // Does nothing in other modes.
+    void gather_hero_wavelengths();
+
   private:
     static APPLESEED_TLS Mode       s_mode;
     static APPLESEED_TLS size_t     s_size;
+    static APPLESEED_TLS size_t     s_hero_bands[HeroWavelengthCount];
 
     APPLESEED_SIMD4_ALIGN ValueType m_samples[StoredSamples];
 };
@@ -273,13 +293,22 @@ APPLESEED_TLS typename DynamicSpectrum<T, N>::Mode DynamicSpectrum<T, N>::s_mode
 template <typename T, size_t N>
 APPLESEED_TLS size_t DynamicSpectrum<T, N>::s_size = 3;
 
+template <typename T, size_t N>
+APPLESEED_TLS size_t DynamicSpectrum<T, N>::s_hero_bands[HeroWavelengthCount];
+
 template <typename T, size_t N>
 typename DynamicSpectrum<T, N>::Mode DynamicSpectrum<T, N>::set_mode(const Mode mode)
 {
     const Mode old_mode = s_mode;
 
     s_mode = mode;
-    s_size = mode == RGB ? 3 : N;
+    s_size =
+        mode == RGB ? 3 :
+        mode == HeroWavelength ? HeroWavelengthCount :
+        N;
+
+    if (mode == HeroWavelength)
+        set_hero_wavelengths(0.0f);
 
     return old_mode;
 }
@@ -296,6 +325,30 @@ inline size_t DynamicSpectrum<T, N>::size()
     return s_size;
 }
 
+template <typename T, size_t N>
+inline void DynamicSpectrum<T, N>::set_hero_wavelengths(const float s)
+{
+    assert(s >= 0.0f && s < 1.0f);
+
+    // Each wavelength is uniformly distributed over the visible range, hence each band is
+    // carried with probability HeroWavelengthCount / N by any given path.
+    for (size_t i = 0; i < HeroWavelengthCount; ++i)
+    {
+        float x = s + static_cast<float>(i) / HeroWavelengthCount;
+        if (x >= 1.0f)
+            x -= 1.0f;
+
+        s_hero_bands[i] = std::min(foundation::truncate<size_t>(x * N), N - 1);
+    }
+}
+
+template <typename T, size_t N>
+inline size_t DynamicSpectrum<T, N>::get_hero_band(const size_t i)
+{
+    assert(i < HeroWavelengthCount);
+    return s_hero_bands[i];
+}
+
 template <typename T, size_t N>
 inline DynamicSpectrum<T, N>::DynamicSpectrum()
 {
@@ -381,7 +434,7 @@ APPLESEED_FORCE_INLINE void DynamicSpectrum<float, 31>::set(const float val)
 
     _mm_store_ps(&m_samples[ 0], mval);
 
-    if (s_size > 3)
+    if (s_size > 4)
     {
         _mm_store_ps(&m_samples[ 4], mval);
         _mm_store_ps(&m_samples[ 8], mval);
@@ -407,6 +460,17 @@ void DynamicSpectrum<T, N>::set(
         m_samples[1] = rgb[1];
         m_samples[2] = rgb[2];
     }
+    else if (s_mode == HeroWavelength)
+    {
+        foundation::RegularSpectrum<T, N> spectrum;
+
+        if (intent == Reflectance)
+            foundation::linear_rgb_reflectance_to_spectrum(rgb, spectrum);
+        else foundation::linear_rgb_illuminance_to_spectrum(rgb, spectrum);
+
+        for (size_t i = 0; i < HeroWavelengthCount; ++i)
+            m_samples[i] = spectrum[s_hero_bands[i]];
+    }
     else
     {
         if (intent == Reflectance)
@@ -435,6 +499,11 @@ void DynamicSpectrum<T, N>::set(
         for (size_t i = 0; i < N; ++i)
             m_samples[i] = spectrum[i];
     }
+    else if (s_mode == HeroWavelength)
+    {
+        for (size_t i = 0; i < HeroWavelengthCount; ++i)
+            m_samples[i] = spectrum[s_hero_bands[i]];
+    }
     else
     {
         reinterpret_cast<foundation::Color<T, 3>&>(m_samples[0]) =
@@ -461,22 +530,64 @@ template <typename T, size_t N>
 inline foundation::Color<T, 3> DynamicSpectrum<T, N>::to_rgb(
     const foundation::LightingConditions& lighting_conditions) const
 {
+    if (s_mode == RGB)
+        return foundation::Color<T, 3>(m_samples[0], m_samples[1], m_samples[2]);
+
+    // In hero wavelength mode, individual estimates may fall outside the RGB gamut:
+    // clamping them would bias the average.
     return
-        s_mode == RGB
-            ? foundation::Color<T, 3>(m_samples[0], m_samples[1], m_samples[2])
-            : foundation::ciexyz_to_linear_rgb(
-                  foundation::spectrum_to_ciexyz<T>(lighting_conditions, *this));
+        s_mode == HeroWavelength
+            ? foundation::ciexyz_to_linear_rgb_unclamped(to_ciexyz(lighting_conditions))
+            : foundation::ciexyz_to_linear_rgb(to_ciexyz(lighting_conditions));
 }
 
 template <typename T, size_t N>
 inline foundation::Color<T, 3> DynamicSpectrum<T, N>::to_ciexyz(
     const foundation::LightingConditions& lighting_conditions) const
 {
-    return
-        s_mode == RGB
-            ? linear_rgb_to_ciexyz(
-                  foundation::Color<T, 3>(m_samples[0], m_samples[1], m_samples[2]))
-            : foundation::spectrum_to_ciexyz<T>(lighting_conditions, *this);
+    if (s_mode == RGB)
+    {
+        return
+            linear_rgb_to_ciexyz(
+                foundation::Color<T, 3>(m_samples[0], m_samples[1], m_samples[2]));
+    }
+
+    if (s_mode == Spectral)
+        return foundation::spectrum_to_ciexyz<T>(lighting_conditions, *this);
+
+    // Monte Carlo estimate of the spectral integral from the wavelengths carried by this spectrum.
+    foundation::Color<T, 3> xyz(T(0.0));
+
+    for (size_t i = 0; i < HeroWavelengthCount; ++i)
+    {
+        const foundation::Color4f& cmf = lighting_conditions.m_cmf[s_hero_bands[i]];
+        xyz[0] += static_cast<T>(cmf[0]) * m_samples[i];
+        xyz[1] += static_cast<T>(cmf[1]) * m_samples[i];
+        xyz[2] += static_cast<T>(cmf[2]) * m_samples[i];
+    }
+
+    xyz *= static_cast<T>(N) / HeroWavelengthCount;
+
+    return xyz;
+}
+
+template <typename T, size_t N>
+inline void DynamicSpectrum<T, N>::gather_hero_wavelengths()
+{
+    if (s_mode != HeroWavelength)
+        return;
+
+    ValueType values[HeroWavelengthCount];
+
+    for (size_t i = 0; i < HeroWavelengthCount; ++i)
+        values[i] = m_samples[s_hero_bands[i]];
+
+    for (size_t i = 0; i < HeroWavelengthCount; ++i)
+        m_samples[i] = values[i];
+
+#ifdef APPLESEED_USE_SSE
+    m_samples[HeroWavelengthCount] = T(0.0);
+#endif
 }
 
 template <typename T, size_t N>
@@ -614,7 +725,7 @@ APPLESEED_FORCE_INLINE DynamicSpectrum<float, 31>& operator+=(DynamicSpectrum<fl
 {
     _mm_store_ps(&lhs[ 0], _mm_add_ps(_mm_load_ps(&lhs[ 0]), _mm_load_ps(&rhs[ 0])));
 
-    if (DynamicSpectrum<float, 31>::size() > 3)
+    if (DynamicSpectrum<float, 31>::size() > 4)
     {
         _mm_store_ps(&lhs[ 4], _mm_add_ps(_mm_load_ps(&lhs[ 4]), _mm_load_ps(&rhs[ 4])));
         _mm_store_ps(&lhs[ 8], _mm_add_ps(_mm_load_ps(&lhs[ 8]), _mm_load_ps(&rhs[ 8])));
@@ -657,7 +768,7 @@ APPLESEED_FORCE_INLINE DynamicSpectrum<float, 31>& operator*=(DynamicSpectrum<fl
 
     _mm_store_ps(&lhs[ 0], _mm_mul_ps(_mm_load_ps(&lhs[ 0]), mrhs));
 
-    if (DynamicSpectrum<float, 31>::size() > 3)
+    if (DynamicSpectrum<float, 31>::size() > 4)
     {
         _mm_store_ps(&lhs[ 4], _mm_mul_ps(_mm_load_ps(&lhs[ 4]), mrhs));
         _mm_store_ps(&lhs[ 8], _mm_mul_ps(_mm_load_ps(&lhs[ 8]), mrhs));
@@ -689,7 +800,7 @@ APPLESEED_FORCE_INLINE DynamicSpectrum<float, 31>& operator*=(DynamicSpectrum<fl
 {
     _mm_store_ps(&lhs[ 0], _mm_mul_ps(_mm_load_ps(&lhs[ 0]), _mm_load_ps(&rhs[ 0])));
 
-    if (DynamicSpectrum<float, 31>::size() > 3)
+    if (DynamicSpectrum<float, 31>::size() > 4)
     {
         _mm_store_ps(&lhs[ 4], _mm_mul_ps(_mm_load_ps(&lhs[ 4]), _mm_load_ps(&rhs[ 4])));
         _mm_store_ps(&lhs[ 8], _mm_mul_ps(_mm_load_ps(&lhs[ 8]), _mm_load_ps(&rhs[ 8])));
@@ -771,7 +882,7 @@ APPLESEED_FORCE_INLINE void madd(
 {
     _mm_store_ps(&a[0], _mm_add_ps(_mm_load_ps(&a[0]), _mm_mul_ps(_mm_load_ps(&b[0]), _mm_load_ps(&c[0]))));
 
-    if (DynamicSpectrum<float, 31>::size() > 3)
+    if (DynamicSpectrum<float, 31>::size() > 4)
     {
         _mm_store_ps(&a[ 4], _mm_add_ps(_mm_load_ps(&a[ 4]), _mm_mul_ps(_mm_load_ps(&b[ 4]), _mm_load_ps(&c[ 4]))));
         _mm_store_ps(&a[ 8], _mm_add_ps(_mm_load_ps(&a[ 8]), _mm_mul_ps(_mm_load_ps(&b[ 8]), _mm_load_ps(&c[ 8]))));
@@ -793,7 +904,7 @@ APPLESEED_FORCE_INLINE void madd(
 
     _mm_store_ps(&a[0], _mm_add_ps(_mm_load_ps(&a[0]), _mm_mul_ps(_mm_load_ps(&b[0]), k)));
 
-    if (DynamicSpectrum<float, 31>::size() > 3)
+    if (DynamicSpectrum<float, 31>::size() > 4)
     {
         _mm_store_ps(&a[ 4], _mm_add_ps(_mm_load_ps(&a[ 4]), _mm_mul_ps(_mm_load_ps(&b[ 4]), k)));
         _mm_store_ps(&a[ 8], _mm_add_ps(_mm_load_ps(&a[ 8]), _mm_mul_ps(_mm_load_ps(&b[ 8]), k)));
@@ -1009,7 +1120,7 @@ APPLESEED_FORCE_INLINE renderer::DynamicSpectrum<float, 31> lerp(
     __m128 y = _mm_mul_ps(_mm_load_ps(&b[0]), t4);
     _mm_store_ps(&result[0], _mm_add_ps(x, y));
 
-    if (renderer::DynamicSpectrum<float, 31>::size() > 3)
+    if (renderer::DynamicSpectrum<float, 31>::size() > 4)
     {
         for (size_t i = 4; i < a.StoredSamples; i += 4)
         {
@@ -1048,6 +1159,9 @@ inline float min_value(const renderer::DynamicSpectrum<float, 31>& s)
     if (renderer::DynamicSpectrum<float, 31>::size() == 3)
         return std::min(std::min(s[0], s[1]), s[2]);
 
+    if (renderer::DynamicSpectrum<float, 31>::size() == 4)
+        return std::min(std::min(s[0], s[1]), std::min(s[2], s[3]));
+
     const __m128 m1 = _mm_min_ps(_mm_load_ps(&s[ 0]), _mm_load_ps(&s[ 4]));
     const __m128 m2 = _mm_min_ps(_mm_load_ps(&s[ 8]), _mm_load_ps(&s[12]));
     const __m128 m3 = _mm_min_ps(_mm_load_ps(&s[16]), _mm_load_ps(&s[20]));
@@ -1087,6 +1201,9 @@ inline float max_value(const renderer::DynamicSpectrum<float, 31>& s)
     if (renderer::DynamicSpectrum<float, 31>::size() == 3)
         return std::max(std::max(s[0], s[1]), s[2]);
 
+    if (renderer::DynamicSpectrum<float, 31>::size() == 4)
+        return std::max(std::max(s[0], s[1]), std::max(s[2], s[3]));
+
     const __m128 m1 = _mm_max_ps(_mm_load_ps(&s[ 0]), _mm_load_ps(&s[ 4]));
     const __m128 m2 = _mm_max_ps(_mm_load_ps(&s[ 8]), _mm_load_ps(&s[12]));
     const __m128 m3 = _mm_max_ps(_mm_load_ps(&s[16]), _mm_load_ps(&s[20]));
@@ -1245,7 +1362,7 @@ APPLESEED_FORCE_INLINE renderer::DynamicSpectrum<float, 31> sqrt(const renderer:
 
     _mm_store_ps(&result[ 0], _mm_sqrt_ps(_mm_load_ps(&s[ 0])));
 
-    if (renderer::DynamicSpectrum<float, 31>::size() > 3)
+    if (renderer::DynamicSpectrum<float, 31>::size() > 4)
     {
         _mm_store_ps(&result[ 4], _mm_sqrt_ps(_mm_load_ps(&s[ 4])));
         _mm_store_ps(&result[ 8], _mm_sqrt_ps(_mm_load_ps(&s[ 8])));
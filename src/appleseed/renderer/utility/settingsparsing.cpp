@@ -54,12 +54,12 @@ Spectrum::Mode get_spectrum_mode(const ParamArray& params)
         params.get_required<string>(
             "spectrum_mode",
             "rgb",
-            make_vector("rgb", "spectral"));
+            make_vector("rgb", "spectral", "hero_wavelength"));
 
     return
-        spectrum_mode == "rgb"
-            ? Spectrum::RGB
-            : Spectrum::Spectral;
+        spectrum_mode == "rgb" ? Spectrum::RGB :
+        spectrum_mode == "spectral" ? Spectrum::Spectral :
+        Spectrum::HeroWavelength;
 }
 
 string get_spectrum_mode_name(const Spectrum::Mode mode)
@@ -68,6 +68,7 @@ string get_spectrum_mode_name(const Spectrum::Mode mode)
     {
       case Spectrum::RGB: return "rgb";
       case Spectrum::Spectral: return "spectral";
+      case Spectrum::HeroWavelength: return "hero_wavelength";
       default: return "unknown";
     }
 }
@@ -78,12 +79,13 @@ SamplingContext::Mode get_sampling_context_mode(const ParamArray& params)
         params.get_required<string>(
             "sampling_mode",
             "rng",
-            make_vector("rng", "qmc"));
+            make_vector("rng", "qmc", "sobol", "sobol_blue_noise"));
 
     return
-        sampling_mode == "rng"
-            ? SamplingContext::RNGMode
-            : SamplingContext::QMCMode;
+        sampling_mode == "rng" ? SamplingContext::RNGMode :
+        sampling_mode == "qmc" ? SamplingContext::QMCMode :
+        sampling_mode == "sobol" ? SamplingContext::SobolMode :
+        SamplingContext::BlueNoiseSobolMode;
 }
 
 string get_sampling_context_mode_name(const SamplingContext::Mode mode)
@@ -92,6 +94,8 @@ string get_sampling_context_mode_name(const SamplingContext::Mode mode)
     {
       case SamplingContext::RNGMode: return "rng";
       case SamplingContext::QMCMode: return "qmc";
+      case SamplingContext::SobolMode: return "sobol";
+      case SamplingContext::BlueNoiseSobolMode: return "sobol_blue_noise";
       default: return "unknown";
     }
 }
@@ -92,6 +92,12 @@ CommandLineHandler::CommandLineHandler()
             .set_exact_value_count(1)
             .set_default_value(1));
 
+    parser().add_option_handler(
+        &m_single_project
+            .add_name("--single-project")
+            .add_name("-s")
+            .set_description("write a single project containing the whole animation, to be rendered with appleseed.cli --frames"));
+
     parser().add_option_handler(
         &m_camera_target
             .add_name("--target")
@@ -59,6 +59,7 @@ class CommandLineHandler
     foundation::ValueOptionHandler<std::string>     m_output_format;
     foundation::ValueOptionHandler<int>             m_frame_count;
     foundation::ValueOptionHandler<int>             m_part_count;
+    foundation::FlagOptionHandler                   m_single_project;
     foundation::ValueOptionHandler<double>          m_camera_target;
     foundation::ValueOptionHandler<double>          m_camera_distance;
     foundation::ValueOptionHandler<double>          m_camera_elevation;
@@ -158,6 +158,21 @@ namespace
         {
             const vector<size_t> frames = do_generate();
 
+            if (g_cl.m_single_project.is_set())
+            {
+                const string project_filename = m_base_output_filename + ".appleseed";
+                const string image_filename = m_base_output_filename + ".####." + g_cl.m_output_format.value();
+
+                LOG_INFO(
+                    m_logger,
+                    "render the animation with: appleseed.cli %s --frames 1 " FMT_SIZE_T " -o %s",
+                    project_filename.c_str(),
+                    frames.size(),
+                    image_filename.c_str());
+
+                return;
+            }
+
             LOG_INFO(
                 m_logger,
                 "generating render script%s...",
@@ -192,6 +207,15 @@ namespace
             return sstr.str();
         }
 
+        // In single project mode, the camera transform of the animation time t is stored
+        // at time t of the camera transform sequence, and frame n covers the time interval
+        // [n, n + 1]. The project is written once all frames have been generated.
+        void write_single_project(Project& project) const
+        {
+            const string new_path = m_base_output_filename + ".appleseed";
+            ProjectFileWriter::write(project, new_path.c_str());
+        }
+
         auto_release_ptr<Project> load_master_project()
         {
             // Construct the schema file path.
@@ -383,6 +407,21 @@ namespace
                     ? animation_path.size() - 1
                     : 1;
 
+            if (g_cl.m_single_project.is_set())
+            {
+                Camera* camera = project->get_uncached_active_camera();
+                camera->transform_sequence().clear();
+                for (size_t i = 0; i < animation_path.size(); ++i)
+                    camera->transform_sequence().set_transform(static_cast<float>(i + 1), animation_path[i]);
+
+                write_single_project(project.ref());
+
+                for (size_t i = 0; i < frame_count; ++i)
+                    frames.push_back(i + 1);
+
+                return frames;
+            }
+
             for (size_t i = 0; i < frame_count; ++i)
             {
                 const size_t frame = i + 1;
@@ -485,6 +524,13 @@ namespace
                 Transformd::from_local_to_parent(
                     Matrix4d::make_lookat(position, center, Up)));
 
+            if (g_cl.m_single_project.is_set())
+            {
+                Camera* camera = project->get_uncached_active_camera();
+                camera->transform_sequence().clear();
+                camera->transform_sequence().set_transform(1.0f, previous_transform);
+            }
+
             for (int i = 0; i < frame_count; ++i)
             {
                 // Compute the transform of the camera at this frame.
@@ -494,6 +540,17 @@ namespace
                     Transformd::from_local_to_parent(
                         Matrix4d::make_lookat(position, center, Up)));
 
+                const size_t frame = static_cast<size_t>(i + 1);
+
+                // Append a key to the camera's transform sequence.
+                if (g_cl.m_single_project.is_set())
+                {
+                    Camera* camera = project->get_uncached_active_camera();
+                    camera->transform_sequence().set_transform(static_cast<float>(frame + 1), new_transform);
+                    frames.push_back(frame);
+                    continue;
+                }
+
                 // Set the camera's transform sequence.
                 Camera* camera = project->get_uncached_active_camera();
                 camera->transform_sequence().clear();
@@ -502,7 +559,6 @@ namespace
                 previous_transform = new_transform;
 
                 // Write the project file for this frame.
-                const size_t frame = static_cast<size_t>(i + 1);
                 const string new_path = make_numbered_filename(m_base_output_filename + ".appleseed", frame);
                 ProjectFileWriter::write(
                     project.ref(),
@@ -515,6 +571,9 @@ namespace
 
             assert(frames.size() == static_cast<size_t>(frame_count));
 
+            if (g_cl.m_single_project.is_set())
+                write_single_project(project.ref());
+
             return frames;
         }
     };
@@ -168,6 +168,52 @@ bool unpack_project()
 }
 
 
+//
+// Convert a project to an *.appleseedb file.
+//
+
+bool convert_project_to_binary()
+{
+    // Retrieve the input project path.
+    const string& input_filepath = g_cl.m_positional_args.values()[1];
+
+    // Read the input project from disk.
+    auto_release_ptr<Project> project(load_project(input_filepath));
+    if (project.get() == 0)
+        return false;
+
+    // Build the path of the output project.
+    const string binary_file_path =
+        bf::path(input_filepath).replace_extension(".appleseedb").string();
+
+    // Write the project to disk.
+    return ProjectFileWriter::write(project.ref(), binary_file_path.c_str());
+}
+
+
+//
+// Convert an *.appleseedb file back to an *.appleseed file.
+//
+
+bool convert_project_to_xml()
+{
+    // Retrieve the input project path.
+    const string& input_filepath = g_cl.m_positional_args.values()[1];
+
+    // Read the input project from disk.
+    auto_release_ptr<Project> project(load_project(input_filepath));
+    if (project.get() == 0)
+        return false;
+
+    // Build the path of the output project.
+    const string xml_file_path =
+        bf::path(input_filepath).replace_extension(".appleseed").string();
+
+    // Write the project to disk.
+    return ProjectFileWriter::write(project.ref(), xml_file_path.c_str());
+}
+
+
 //
 // Entry point of projecttool.
 //
@@ -211,6 +257,10 @@ int main(int argc, const char* argv[])
         success = pack_project();
     else if (command == "unpack")
         success = unpack_project();
+    else if (command == "tobinary")
+        success = convert_project_to_binary();
+    else if (command == "toxml")
+        success = convert_project_to_xml();
     else LOG_ERROR(logger, "unknown command: %s", command.c_str());
 
     return success ? 0 : 1;